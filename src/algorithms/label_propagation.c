@@ -0,0 +1,149 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "label_propagation.h"
+#include "../util/rmalloc.h"
+
+#include <string.h>
+
+// each iteration encodes the current labels as an NxN matrix L
+// where L(i, label[i]) = 1, label frequencies among neighbors are then
+// given by C = S plus.pair L, where S = A + I
+// the identity keeps a row's own label in the vote, which dampens the
+// oscillations synchronous propagation is prone to on bipartite structures
+GrB_Info LabelPropagation
+(
+	GrB_Vector *communities,
+	GrB_Matrix A,
+	int max_iterations,
+	int *iterations
+) {
+	ASSERT(A              != NULL);
+	ASSERT(iterations     != NULL);
+	ASSERT(communities    != NULL);
+	ASSERT(max_iterations > 0);
+
+	GrB_Info info;
+	GrB_Index n;
+
+	*iterations = 0;
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_new(communities, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(n == 0) return GrB_SUCCESS;
+
+	GrB_Index *rows  = rm_malloc(sizeof(GrB_Index) * n);  // 0..n-1
+	GrB_Index *label = rm_malloc(sizeof(GrB_Index) * n);  // current labels
+	GrB_Index *best  = rm_malloc(sizeof(GrB_Index) * n);  // next labels
+	uint64_t  *freq  = rm_malloc(sizeof(uint64_t) * n);   // best's frequency
+	bool      *ones  = rm_malloc(sizeof(bool) * n);
+
+	for(GrB_Index i = 0; i < n; i++) {
+		rows[i]  = i;
+		label[i] = i;
+		ones[i]  = true;
+	}
+
+	//--------------------------------------------------------------------------
+	// S = A + I
+	//--------------------------------------------------------------------------
+
+	GrB_Matrix S;
+	GrB_Matrix L;
+	GrB_Matrix C;
+
+	info = GrB_Matrix_new(&L, GrB_BOOL, n, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_build_BOOL(L, rows, rows, ones, n, GrB_LOR);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&S, GrB_BOOL, n, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_eWiseAdd(S, NULL, NULL, GrB_LOR, A, L, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&C, GrB_UINT64, n, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Index  nvals;
+	GrB_Index  cap = 0;
+	GrB_Index *I   = NULL;
+	GrB_Index *J   = NULL;
+	uint64_t  *X   = NULL;
+
+	bool changed = true;
+	while(changed && *iterations < max_iterations) {
+		(*iterations)++;
+
+		// L(i, label[i]) = 1
+		info = GrB_Matrix_clear(L);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_build_BOOL(L, rows, label, ones, n, GrB_LOR);
+		ASSERT(info == GrB_SUCCESS);
+
+		// C(i, l) = number of rows in i's neighborhood labeled l
+		info = GrB_mxm(C, NULL, NULL, GxB_PLUS_PAIR_UINT64, S, L, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_nvals(&nvals, C);
+		ASSERT(info == GrB_SUCCESS);
+
+		if(nvals > cap) {
+			cap = nvals;
+			I = rm_realloc(I, sizeof(GrB_Index) * cap);
+			J = rm_realloc(J, sizeof(GrB_Index) * cap);
+			X = rm_realloc(X, sizeof(uint64_t) * cap);
+		}
+
+		info = GrB_Matrix_extractTuples_UINT64(I, J, X, &nvals, C);
+		ASSERT(info == GrB_SUCCESS);
+
+		// every row votes at least for itself, its row is never empty
+		memset(freq, 0, sizeof(uint64_t) * n);
+		for(GrB_Index k = 0; k < nvals; k++) {
+			GrB_Index i = I[k];
+			if(X[k] > freq[i] || (X[k] == freq[i] && J[k] < best[i])) {
+				freq[i] = X[k];
+				best[i] = J[k];
+			}
+		}
+
+		changed = false;
+		for(GrB_Index i = 0; i < n; i++) {
+			if(best[i] != label[i]) {
+				label[i] = best[i];
+				changed  = true;
+			}
+		}
+	}
+
+	info = GrB_Vector_build_UINT64(*communities, rows, label, n,
+			GrB_FIRST_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&S);
+	GrB_free(&L);
+	GrB_free(&C);
+
+	if(I != NULL) {
+		rm_free(I);
+		rm_free(J);
+		rm_free(X);
+	}
+	rm_free(rows);
+	rm_free(label);
+	rm_free(best);
+	rm_free(freq);
+	rm_free(ones);
+
+	return info;
+}
+
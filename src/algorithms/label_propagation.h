@@ -0,0 +1,23 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "GraphBLAS/Include/GraphBLAS.h"
+
+// detect communities using synchronous label propagation
+// every row starts in its own community and repeatedly adopts the label
+// most frequent among itself and its neighbors, ties are broken in favor
+// of the smallest label
+// stops once labels are stable or 'max_iterations' were performed
+GrB_Info LabelPropagation
+(
+	GrB_Vector *communities,  // [output] community of each row
+	GrB_Matrix A,             // symmetric NxN boolean matrix
+	int max_iterations,       // maximum number of iterations
+	int *iterations           // [output] number of iterations performed
+);
+
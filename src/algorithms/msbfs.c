@@ -0,0 +1,135 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "msbfs.h"
+#include "../util/rmalloc.h"
+
+GrB_Info MSBFS
+(
+	GrB_Matrix *levels,
+	GrB_Matrix A,
+	const GrB_Index *sources,
+	GrB_Index k,
+	GrB_Index max_level
+) {
+	ASSERT(A       != NULL);
+	ASSERT(k       > 0);
+	ASSERT(levels  != NULL);
+	ASSERT(sources != NULL);
+
+	GrB_Info info;
+	GrB_Index n;
+	GrB_Matrix F;  // frontier, F(i, j) set if j is on the frontier of i
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	// row i of both the frontier and the level matrix starts at sources[i]
+	GrB_Index *rows = rm_malloc(sizeof(GrB_Index) * k);
+	uint64_t  *zero = rm_calloc(k, sizeof(uint64_t));
+	for(GrB_Index i = 0; i < k; i++) rows[i] = i;
+
+	info = GrB_Matrix_new(levels, GrB_UINT64, k, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_build_UINT64(*levels, rows, sources, zero, k,
+			GrB_FIRST_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&F, GrB_BOOL, k, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_apply(F, NULL, NULL, GxB_ONE_BOOL, *levels, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	rm_free(rows);
+	rm_free(zero);
+
+	GrB_Index nvals;
+	for(GrB_Index level = 1; max_level == 0 || level <= max_level; level++) {
+		// F<!levels> = F any.pair A
+		// advance every frontier, discarding nodes already visited
+		info = GrB_mxm(F, *levels, NULL, GxB_ANY_PAIR_BOOL, F, A,
+				GrB_DESC_RSC);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_nvals(&nvals, F);
+		ASSERT(info == GrB_SUCCESS);
+
+		// all traversals are done
+		if(nvals == 0) break;
+
+		// levels<F> = level
+		info = GrB_Matrix_assign_UINT64(*levels, F, NULL, level, GrB_ALL, k,
+				GrB_ALL, n, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	GrB_free(&F);
+
+	return info;
+}
+
+
+GrB_Info MSBFS_Distances
+(
+	GrB_Vector *distances,
+	GrB_Matrix A,
+	const GrB_Index *roots,
+	GrB_Index k,
+	GrB_Index max_level
+) {
+	ASSERT(A         != NULL);
+	ASSERT(k         > 0);
+	ASSERT(roots     != NULL);
+	ASSERT(distances != NULL);
+
+	GrB_Info info;
+	GrB_Index n;
+	GrB_Vector q;  // frontier
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	// all roots are at distance 0, duplicate roots are merged
+	uint64_t *zero = rm_calloc(k, sizeof(uint64_t));
+
+	info = GrB_Vector_new(distances, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_build_UINT64(*distances, roots, zero, k,
+			GrB_FIRST_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	rm_free(zero);
+
+	info = GrB_Vector_new(&q, GrB_BOOL, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_apply(q, NULL, NULL, GxB_ONE_BOOL, *distances, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Index nvals;
+	for(GrB_Index level = 1; max_level == 0 || level <= max_level; level++) {
+		// q<!distances> = q any.pair A
+		// advance frontier, discarding nodes already reached
+		info = GrB_vxm(q, *distances, NULL, GxB_ANY_PAIR_BOOL, q, A,
+				GrB_DESC_RSC);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Vector_nvals(&nvals, q);
+		ASSERT(info == GrB_SUCCESS);
+
+		// traversal is done
+		if(nvals == 0) break;
+
+		// distances<q> = level
+		info = GrB_Vector_assign_UINT64(*distances, q, NULL, level, GrB_ALL,
+				n, GrB_DESC_S);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	GrB_free(&q);
+
+	return info;
+}
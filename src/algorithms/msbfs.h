@@ -0,0 +1,40 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "GraphBLAS/Include/GraphBLAS.h"
+
+// multi-source BFS
+// traverses from all sources simultaneously, the frontier is a matrix
+// holding one row per source, advancing all frontiers with a single
+// matrix multiplication per level
+//
+// levels(i, j) is the BFS level of node j when traversing from sources[i]
+// each source is at level 0 of its own traversal
+GrB_Info MSBFS
+(
+	GrB_Matrix *levels,        // [output] KxN level matrix
+	GrB_Matrix A,              // NxN boolean adjacency matrix
+	const GrB_Index *sources,  // K source nodes
+	GrB_Index k,               // number of sources
+	GrB_Index max_level        // maximum level to reach, 0 for unlimited
+);
+
+
+// BFS distances from a set of roots
+// traverses from all roots at once, using a single frontier vector
+//
+// distances(j) is the number of hops from the closest root to node j
+// roots are at distance 0, unreachable nodes have no entry
+GrB_Info MSBFS_Distances
+(
+	GrB_Vector *distances,   // [output] N distance vector
+	GrB_Matrix A,            // NxN boolean adjacency matrix
+	const GrB_Index *roots,  // K root nodes
+	GrB_Index k,             // number of roots
+	GrB_Index max_level      // maximum level to reach, 0 for unlimited
+);
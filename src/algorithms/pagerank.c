@@ -26,14 +26,13 @@
 
 #include "pagerank.h"
 #include "util/rmalloc.h"
+#include <math.h>
 #include <assert.h>
 
 //------------------------------------------------------------------------------
 // scalar operators
 //------------------------------------------------------------------------------
 
-#define DAMPING 0.85
-
 void fdiff(void *z, const void *x, const void *y) {
 	float delta = (* ((float *) x)) - (* ((float *) y)) ;
 	(*((float *) z)) = delta * delta ;
@@ -65,9 +64,9 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 (
 	LAGraph_PageRank **Phandle, // output: array of LAGraph_PageRank structs
 	GrB_Matrix A,               // binary input graph, not modified
-	int itermax,                // max number of iterations
-	double tol,                 // stop when norm (r-rnew,2) < tol
-	int *iters                  // number of iterations taken
+	const PagerankConfig *config, // pagerank configuration
+	int *iters,                 // number of iterations taken
+	double *delta               // norm (r-rnew,2) of the last iteration
 ) {
 
 	//--------------------------------------------------------------------------
@@ -85,16 +84,23 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	GrB_Info rc;
 
 	assert(Phandle);
+	assert(config);
 	(*Phandle) = NULL ;
+	(*iters) = 0 ;
+	if(delta != NULL) (*delta) = 0 ;
+
+	int itermax = config->itermax ;
+	double tol = config->tol ;
+	float damping = config->damping ;
 
 	// n = size (A,1) ;         // number of nodes
 	rc = GrB_Matrix_nrows(&n, A) ;
 	assert(rc == GrB_SUCCESS) ;
 	if(n == 0) return (GrB_SUCCESS) ;
 
-	// teleport = (1 - 0.85) / n
+	// teleport = (1 - damping) / n
 	float one = 1.0 ;
-	float teleport = (one - DAMPING) / ((float) n) ;
+	float teleport = (one - damping) / ((float) n) ;
 
 	// r (i) = 1/n for all nodes i
 	float x = 1.0 / ((float) n) ;
@@ -103,6 +109,24 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	rc = GrB_assign(r, NULL, NULL, x, GrB_ALL, n, NULL) ;
 	assert(rc == GrB_SUCCESS) ;
 
+	// warm start, r (i) = init (i) for all nodes present in init
+	// followed by normalization such that sum (r) = 1
+	if(config->init != NULL) {
+		rc = GrB_Vector_assign(r, NULL, GrB_SECOND_FP32, config->init, GrB_ALL,
+				n, NULL) ;
+		assert(rc == GrB_SUCCESS) ;
+		rc = GrB_reduce(&rsum, NULL, GxB_PLUS_FP32_MONOID, r, NULL) ;
+		assert(rc == GrB_SUCCESS) ;
+		if(rsum > 0) {
+			rc = GrB_Vector_assign_FP32(r, NULL, GrB_TIMES_FP32, 1 / rsum,
+					GrB_ALL, n, NULL) ;
+		} else {
+			// unusable initial ranks, fall back to a uniform distribution
+			rc = GrB_assign(r, NULL, NULL, x, GrB_ALL, n, NULL) ;
+		}
+		assert(rc == GrB_SUCCESS) ;
+	}
+
 	// d (i) = out deg of node i
 	rc = GrB_Vector_new(&d, GrB_FP32, n) ;
 	assert(rc == GrB_SUCCESS) ;
@@ -121,7 +145,7 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 				               &vx_size, &iso, &nvals, &jumbled, NULL) ;
 	assert(rc == GrB_SUCCESS) ;
 
-	for(int64_t k = 0 ; k < nvals ; k++) X [k] = DAMPING / X [k] ;
+	for(int64_t k = 0 ; k < nvals ; k++) X [k] = damping / X [k] ;
 	rc = GrB_Matrix_new(&D, GrB_FP32, n, n) ;
 	assert(rc == GrB_SUCCESS) ;
 	rc = GrB_Matrix_build(D, I, I, X, nvals, GrB_PLUS_FP32) ;
@@ -193,10 +217,20 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 		rc = GrB_mxv(t, NULL, NULL, GxB_PLUS_TIMES_FP32, C, r, NULL) ;
 		assert(rc == GrB_SUCCESS) ;
 
-		// t += teleport_scalar ;
-		float teleport_scalar = teleport * rsum ;
-		rc = GrB_assign(t, NULL, GrB_PLUS_FP32, teleport_scalar, GrB_ALL, n, NULL) ;
-		assert(rc == GrB_SUCCESS) ;
+		if(config->personalization != NULL) {
+			// personalized pagerank, teleport only to the seed nodes
+			// t += personalization * (1 - damping) * sum (r)
+			float teleport_scalar = (one - damping) * rsum ;
+			rc = GrB_Vector_apply_BinaryOp2nd_FP32(t, NULL, GrB_PLUS_FP32,
+					GrB_TIMES_FP32, config->personalization, teleport_scalar,
+					NULL) ;
+			assert(rc == GrB_SUCCESS) ;
+		} else {
+			// t += teleport_scalar ;
+			float teleport_scalar = teleport * rsum ;
+			rc = GrB_assign(t, NULL, GrB_PLUS_FP32, teleport_scalar, GrB_ALL, n, NULL) ;
+			assert(rc == GrB_SUCCESS) ;
+		}
 		//----------------------------------------------------------------------
 		// rdiff = sum ((r-t).^2)
 		//----------------------------------------------------------------------
@@ -220,6 +254,8 @@ GrB_Info Pagerank               // GrB_SUCCESS or error condition
 	rc = GrB_free(&t) ;
 	assert(rc == GrB_SUCCESS) ;
 
+	if(delta != NULL) (*delta) = sqrt(rdiff) ;
+
 	//--------------------------------------------------------------------------
 	// scale the result
 	//--------------------------------------------------------------------------
@@ -30,11 +30,22 @@ typedef struct {
 }
 LAGraph_PageRank ;
 
+#define PAGERANK_DAMPING_DEFAULT 0.85
+
+typedef struct {
+	int itermax ;                // max number of iterations
+	double tol ;                 // stop when norm (r-rnew,2) < tol
+	double damping ;             // damping factor
+	GrB_Vector init ;            // [optional] initial ranks (warm start)
+	GrB_Vector personalization ; // [optional] teleport distribution, sums to 1
+}
+PagerankConfig ;
+
 GrB_Info Pagerank               // GrB_SUCCESS or error condition
 (
 	LAGraph_PageRank **Phandle, // output: array of LAGraph_PageRank structs
 	GrB_Matrix A,               // binary input graph, not modified
-	int itermax,                // max number of iterations
-	double tol,                 // stop when norm (r-rnew,2) < tol
-	int *iters                  // number of iterations taken
+	const PagerankConfig *config, // pagerank configuration
+	int *iters,                 // number of iterations taken
+	double *delta               // norm (r-rnew,2) of the last iteration
 );
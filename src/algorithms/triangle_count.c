@@ -0,0 +1,59 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "triangle_count.h"
+
+// C<A> = A * A counts for every edge (i, j) the number of common
+// neighbors of i and j, each common neighbor closes a triangle
+// row i of C sums to twice the number of triangles i participates in
+// as every triangle is seen from both of i's edges
+// masking by A restricts the multiplication to existing edges
+GrB_Info TriangleCount
+(
+	GrB_Vector *triangles,
+	GrB_Matrix A
+) {
+	ASSERT(A         != NULL);
+	ASSERT(triangles != NULL);
+
+	GrB_Info info;
+	GrB_Index n;
+	GrB_Matrix C;
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Matrix_new(&C, GrB_UINT64, n, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// C<A> = A plus.pair A
+	info = GrB_mxm(C, A, NULL, GxB_PLUS_PAIR_UINT64, A, A, GrB_DESC_S);
+	ASSERT(info == GrB_SUCCESS);
+
+	// every row is reported, including rows without triangles
+	info = GrB_Vector_new(triangles, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_assign_UINT64(*triangles, NULL, NULL, 0, GrB_ALL, n,
+			NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	// t += sum(C, 2)
+	info = GrB_Matrix_reduce_Monoid(*triangles, NULL, GrB_PLUS_UINT64,
+			GrB_PLUS_MONOID_UINT64, C, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	// t = t / 2
+	info = GrB_Vector_apply_BinaryOp2nd_UINT64(*triangles, NULL, NULL,
+			GrB_DIV_UINT64, *triangles, 2, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&C);
+
+	return info;
+}
+
@@ -0,0 +1,18 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "GraphBLAS/Include/GraphBLAS.h"
+
+// count the number of triangles each row participates in
+// 'A' must be symmetric and free of self loops
+GrB_Info TriangleCount
+(
+	GrB_Vector *triangles,  // [output] number of triangles of each row
+	GrB_Matrix A            // symmetric NxN boolean matrix
+);
+
@@ -0,0 +1,124 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "wcc.h"
+#include "../util/rmalloc.h"
+
+#include <string.h>
+
+// FastSV maintains a forest in which every tree is contained in a component
+// each iteration hooks trees onto neighboring trees with a smaller grandparent
+// and shortcuts paths towards the roots
+// once grandparents no longer change every tree is a star spanning
+// an entire component, rooted at the component's smallest row
+//
+// the min-grandparent of each row's neighbors is computed by GraphBLAS
+// using the MIN_SECOND semiring, hooking and shortcutting are linear
+// passes over the parent array
+GrB_Info WCC
+(
+	GrB_Vector *components,
+	GrB_Matrix A
+) {
+	ASSERT(A          != NULL);
+	ASSERT(components != NULL);
+
+	GrB_Info info;
+	GrB_Index n;
+
+	info = GrB_Matrix_nrows(&n, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_new(components, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(n == 0) return GrB_SUCCESS;
+
+	GrB_Index *rows = rm_malloc(sizeof(GrB_Index) * n);  // 0..n-1
+	uint64_t  *f    = rm_malloc(sizeof(uint64_t) * n);   // parent
+	uint64_t  *gp   = rm_malloc(sizeof(uint64_t) * n);   // grandparent
+	uint64_t  *mngp = rm_malloc(sizeof(uint64_t) * n);   // min neighbor gp
+
+	for(GrB_Index i = 0; i < n; i++) {
+		rows[i] = i;
+		f[i]    = i;
+		gp[i]   = i;
+	}
+
+	GrB_Vector v_gp;
+	GrB_Vector v_mngp;
+	info = GrB_Vector_new(&v_gp, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_new(&v_mngp, GrB_UINT64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	bool changed = true;
+	while(changed) {
+		//----------------------------------------------------------------------
+		// mngp = min(gp, min over neighbors gp)
+		//----------------------------------------------------------------------
+
+		GrB_Vector_clear(v_gp);
+		GrB_Vector_clear(v_mngp);
+		info = GrB_Vector_build_UINT64(v_gp, rows, gp, n, GrB_FIRST_UINT64);
+		ASSERT(info == GrB_SUCCESS);
+		info = GrB_Vector_build_UINT64(v_mngp, rows, gp, n, GrB_FIRST_UINT64);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_mxv(v_mngp, NULL, GrB_MIN_UINT64,
+				GrB_MIN_SECOND_SEMIRING_UINT64, A, v_gp, NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Index nvals = n;
+		info = GrB_Vector_extractTuples_UINT64(NULL, mngp, &nvals, v_mngp);
+		ASSERT(info == GrB_SUCCESS && nvals == n);
+
+		//----------------------------------------------------------------------
+		// stochastic hooking, f[f[i]] = min(f[f[i]], mngp[i])
+		//----------------------------------------------------------------------
+
+		for(GrB_Index i = 0; i < n; i++) {
+			uint64_t p = f[i];
+			if(mngp[i] < f[p]) f[p] = mngp[i];
+		}
+
+		//----------------------------------------------------------------------
+		// aggressive hooking and shortcutting, f = min(f, mngp, gp)
+		//----------------------------------------------------------------------
+
+		for(GrB_Index i = 0; i < n; i++) {
+			if(mngp[i] < f[i]) f[i] = mngp[i];
+			if(gp[i]   < f[i]) f[i] = gp[i];
+		}
+
+		//----------------------------------------------------------------------
+		// gp = f[f], stop once grandparents are stable
+		//----------------------------------------------------------------------
+
+		changed = false;
+		for(GrB_Index i = 0; i < n; i++) {
+			uint64_t g = f[f[i]];
+			if(g != gp[i]) {
+				changed = true;
+				gp[i]   = g;
+			}
+		}
+	}
+
+	info = GrB_Vector_build_UINT64(*components, rows, f, n, GrB_FIRST_UINT64);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_free(&v_gp);
+	GrB_free(&v_mngp);
+	rm_free(rows);
+	rm_free(f);
+	rm_free(gp);
+	rm_free(mngp);
+
+	return info;
+}
+
@@ -0,0 +1,19 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "GraphBLAS/Include/GraphBLAS.h"
+
+// compute weakly connected components of an undirected boolean matrix
+// using the FastSV algorithm (Zhang, Azad, Hu 2020)
+// each row is assigned the smallest row index within its component
+GrB_Info WCC
+(
+	GrB_Vector *components,  // [output] component of each row
+	GrB_Matrix A             // symmetric NxN boolean matrix
+);
+
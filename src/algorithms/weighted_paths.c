@@ -0,0 +1,870 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "weighted_paths.h"
+#include "../util/arr.h"
+#include "../util/dict.h"
+#include "../util/heap.h"
+#include "../util/rmalloc.h"
+
+#include <float.h>
+
+// paths are ordered by weight, then cost, then length
+// as long as weights and costs are non-negative this order is preserved
+// when extending a path, which is what both Dijkstra and the best-first
+// enumeration rely on
+typedef struct {
+	double weight;  // accumulated weight
+	double cost;    // accumulated cost
+	uint64_t hops;  // number of edges
+} PathKey;
+
+// path in its internal form
+typedef struct {
+	NodeID *nodes;  // nodes along the path
+	Edge *edges;    // edges along the path
+	PathKey key;    // path key
+} NodePath;
+
+// node discovered by Dijkstra
+typedef struct {
+	NodeID id;      // node ID
+	PathKey key;    // best known key
+	int64_t pred;   // predecessor state, -1 for the source
+	Edge edge;      // edge leading from predecessor
+	int64_t pos;    // position in heap, -1 if not queued
+	bool settled;   // key is final
+} DijkstraState;
+
+// shortest path tree
+typedef struct {
+	DijkstraState *states;  // discovered nodes
+	dict *lookup;           // node ID to state index
+	uint64_t *heap;         // indexed binary min heap of state indices
+} DijkstraTree;
+
+// partial path expanded by the best-first enumeration
+typedef struct {
+	int64_t parent;  // previous step, -1 for the source
+	NodeID node;     // node reached
+	Edge edge;       // edge leading to node
+	PathKey key;     // accumulated key
+} PathStep;
+
+typedef struct {
+	const WeightedTraversal *t;  // traversal specification
+	Edge *edges;                 // reusable edge buffer
+} WeightedPathsCtx;
+
+static const GRAPH_EDGE_DIR _dirs[2] = {GRAPH_EDGE_DIR_OUTGOING,
+	GRAPH_EDGE_DIR_INCOMING};
+
+//------------------------------------------------------------------------------
+// utilities
+//------------------------------------------------------------------------------
+
+static int _PathKey_Cmp
+(
+	const PathKey *a,
+	const PathKey *b
+) {
+	if(a->weight != b->weight) return (a->weight < b->weight) ? -1 : 1;
+	if(a->cost   != b->cost)   return (a->cost   < b->cost)   ? -1 : 1;
+	if(a->hops   != b->hops)   return (a->hops   < b->hops)   ? -1 : 1;
+	return 0;
+}
+
+static int _NodePath_Cmp
+(
+	const void *a,
+	const void *b
+) {
+	return _PathKey_Cmp(&((const NodePath *)a)->key,
+			&((const NodePath *)b)->key);
+}
+
+static void _NodePath_Free
+(
+	NodePath *p
+) {
+	array_free(p->nodes);
+	array_free(p->edges);
+}
+
+// does direction 'dir' traverse edges in direction 'd'
+static inline bool _traverses
+(
+	GRAPH_EDGE_DIR dir,
+	GRAPH_EDGE_DIR d
+) {
+	return (dir == GRAPH_EDGE_DIR_BOTH || dir == d);
+}
+
+// reverse traverse direction
+static inline GRAPH_EDGE_DIR _reverse
+(
+	GRAPH_EDGE_DIR dir
+) {
+	if(dir == GRAPH_EDGE_DIR_OUTGOING) return GRAPH_EDGE_DIR_INCOMING;
+	if(dir == GRAPH_EDGE_DIR_INCOMING) return GRAPH_EDGE_DIR_OUTGOING;
+	return dir;
+}
+
+// node reached by following 'e' in direction 'd'
+static inline NodeID _other
+(
+	Edge *e,
+	GRAPH_EDGE_DIR d
+) {
+	return (d == GRAPH_EDGE_DIR_OUTGOING) ?
+		Edge_GetDestNodeID(e) : Edge_GetSrcNodeID(e);
+}
+
+// get numeric attribute value of an edge otherwise return 1
+static inline double _value_or_default
+(
+	Edge *e,
+	Attribute_ID id
+) {
+	SIValue *v = GraphEntity_GetProperty((GraphEntity *)e, id);
+	if(v == ATTRIBUTE_NOTFOUND || !(SI_TYPE(*v) & SI_NUMERIC)) return 1;
+
+	return SI_GET_NUMERIC(*v);
+}
+
+// extend 'key' by edge 'e'
+// returns false if edge has a negative weight or cost
+static bool _extend
+(
+	const WeightedPathsCtx *ctx,
+	Edge *e,
+	const PathKey *key,
+	PathKey *extended
+) {
+	double w = _value_or_default(e, ctx->t->weight_prop);
+	double c = _value_or_default(e, ctx->t->cost_prop);
+	if(w < 0 || c < 0) return false;
+
+	extended->weight = key->weight + w;
+	extended->cost   = key->cost + c;
+	extended->hops   = key->hops + 1;
+	return true;
+}
+
+// collect edges of node 'id' in direction 'd' into ctx->edges
+static void _node_edges
+(
+	WeightedPathsCtx *ctx,
+	NodeID id,
+	GRAPH_EDGE_DIR d,
+	Edge **edges
+) {
+	const WeightedTraversal *t = ctx->t;
+
+	Node n;
+	array_clear(*edges);
+	Graph_GetNode(t->g, id, &n);
+	for(int i = 0; i < t->relationCount; i++) {
+		Graph_GetNodeEdges(t->g, &n, d, t->relationIDs[i], edges);
+	}
+}
+
+static inline bool _dict_contains
+(
+	dict *d,
+	uint64_t id
+) {
+	return (d != NULL && HashTableFind(d, (void *)id) != NULL);
+}
+
+// convert internal path representation into a weighted path
+static WeightedPath _NodePath_Materialize
+(
+	const WeightedPathsCtx *ctx,
+	const NodePath *p
+) {
+	uint n = array_len(p->nodes);
+	WeightedPath wp = {.path = Path_New(n), .weight = p->key.weight,
+		.cost = p->key.cost};
+
+	for(uint i = 0; i < n; i++) {
+		Node node;
+		Graph_GetNode(ctx->t->g, p->nodes[i], &node);
+		Path_AppendNode(wp.path, node);
+		if(i < n - 1) Path_AppendEdge(wp.path, p->edges[i]);
+	}
+
+	return wp;
+}
+
+//------------------------------------------------------------------------------
+// Dijkstra
+//------------------------------------------------------------------------------
+
+static void _Heap_Swap
+(
+	DijkstraTree *tree,
+	uint64_t i,
+	uint64_t j
+) {
+	uint64_t tmp  = tree->heap[i];
+	tree->heap[i] = tree->heap[j];
+	tree->heap[j] = tmp;
+	tree->states[tree->heap[i]].pos = i;
+	tree->states[tree->heap[j]].pos = j;
+}
+
+static inline int _Heap_Cmp
+(
+	DijkstraTree *tree,
+	uint64_t i,
+	uint64_t j
+) {
+	return _PathKey_Cmp(&tree->states[tree->heap[i]].key,
+			&tree->states[tree->heap[j]].key);
+}
+
+static void _Heap_Up
+(
+	DijkstraTree *tree,
+	uint64_t i
+) {
+	while(i > 0) {
+		uint64_t parent = (i - 1) / 2;
+		if(_Heap_Cmp(tree, i, parent) >= 0) break;
+		_Heap_Swap(tree, i, parent);
+		i = parent;
+	}
+}
+
+static void _Heap_Down
+(
+	DijkstraTree *tree,
+	uint64_t i
+) {
+	uint64_t n = array_len(tree->heap);
+	while(true) {
+		uint64_t smallest = i;
+		uint64_t l = 2 * i + 1;
+		uint64_t r = 2 * i + 2;
+		if(l < n && _Heap_Cmp(tree, l, smallest) < 0) smallest = l;
+		if(r < n && _Heap_Cmp(tree, r, smallest) < 0) smallest = r;
+		if(smallest == i) break;
+		_Heap_Swap(tree, i, smallest);
+		i = smallest;
+	}
+}
+
+static void _Heap_Push
+(
+	DijkstraTree *tree,
+	uint64_t s
+) {
+	array_append(tree->heap, s);
+	tree->states[s].pos = array_len(tree->heap) - 1;
+	_Heap_Up(tree, tree->states[s].pos);
+}
+
+static uint64_t _Heap_Pop
+(
+	DijkstraTree *tree
+) {
+	uint64_t s = tree->heap[0];
+	uint64_t last = array_len(tree->heap) - 1;
+	_Heap_Swap(tree, 0, last);
+	array_pop(tree->heap);
+	if(last > 0) _Heap_Down(tree, 0);
+
+	tree->states[s].pos = -1;
+	return s;
+}
+
+static void _DijkstraTree_Init
+(
+	DijkstraTree *tree
+) {
+	tree->states = array_new(DijkstraState, 64);
+	tree->heap   = array_new(uint64_t, 64);
+	tree->lookup = HashTableCreate(&def_dt);
+}
+
+static void _DijkstraTree_Free
+(
+	DijkstraTree *tree
+) {
+	array_free(tree->states);
+	array_free(tree->heap);
+	HashTableRelease(tree->lookup);
+}
+
+// returns state index of node 'id', -1 if node wasn't discovered
+static int64_t _DijkstraTree_State
+(
+	DijkstraTree *tree,
+	NodeID id
+) {
+	dictEntry *entry = HashTableFind(tree->lookup, (void *)id);
+	return (entry == NULL) ? -1 : (int64_t)(uintptr_t)HashTableGetVal(entry);
+}
+
+static uint64_t _DijkstraTree_AddState
+(
+	DijkstraTree *tree,
+	NodeID id,
+	PathKey key,
+	int64_t pred,
+	Edge *edge
+) {
+	DijkstraState s = {.id = id, .key = key, .pred = pred, .pos = -1,
+		.settled = false};
+	if(edge != NULL) s.edge = *edge;
+
+	uint64_t idx = array_len(tree->states);
+	array_append(tree->states, s);
+	HashTableAdd(tree->lookup, (void *)id, (void *)(uintptr_t)idx);
+	_Heap_Push(tree, idx);
+
+	return idx;
+}
+
+// compute shortest paths from 'src' until 'dst' is settled
+// if 'ties' is set, keep settling nodes as light as 'dst'
+// returns false if a negative weight or cost was encountered
+static bool _Dijkstra
+(
+	WeightedPathsCtx *ctx,
+	DijkstraTree *tree,
+	NodeID src,
+	NodeID dst,
+	dict *banned_nodes,  // [optional] nodes to avoid
+	dict *banned_edges,  // [optional] edges to avoid
+	bool ties
+) {
+	GRAPH_EDGE_DIR dir = ctx->t->dir;
+	int64_t dst_state = -1;
+
+	_DijkstraTree_AddState(tree, src, (PathKey){0}, -1, NULL);
+
+	while(array_len(tree->heap) > 0) {
+		uint64_t s = _Heap_Pop(tree);
+
+		if(dst_state != -1 &&
+		   tree->states[s].key.weight > tree->states[dst_state].key.weight) {
+			break;
+		}
+
+		tree->states[s].settled = true;
+
+		// simple paths can't continue past the destination
+		if(tree->states[s].id == dst) {
+			dst_state = s;
+			if(!ties) break;
+			continue;
+		}
+
+		for(int d = 0; d < 2; d++) {
+			if(!_traverses(dir, _dirs[d])) continue;
+
+			_node_edges(ctx, tree->states[s].id, _dirs[d], &ctx->edges);
+			uint n = array_len(ctx->edges);
+			for(uint i = 0; i < n; i++) {
+				Edge *e = ctx->edges + i;
+				NodeID other = _other(e, _dirs[d]);
+				if(_dict_contains(banned_nodes, other)) continue;
+				if(_dict_contains(banned_edges, ENTITY_GET_ID(e))) continue;
+
+				PathKey key;
+				if(!_extend(ctx, e, &tree->states[s].key, &key)) return false;
+
+				int64_t o = _DijkstraTree_State(tree, other);
+				if(o == -1) {
+					_DijkstraTree_AddState(tree, other, key, s, e);
+				} else if(!tree->states[o].settled &&
+						  _PathKey_Cmp(&key, &tree->states[o].key) < 0) {
+					// decrease key
+					tree->states[o].key  = key;
+					tree->states[o].pred = s;
+					tree->states[o].edge = *e;
+					_Heap_Up(tree, tree->states[o].pos);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+// extract path leading to 'dst' from shortest path tree
+// returns false if 'dst' wasn't reached
+static bool _DijkstraTree_Path
+(
+	DijkstraTree *tree,
+	NodeID dst,
+	NodePath *p
+) {
+	int64_t s = _DijkstraTree_State(tree, dst);
+	if(s == -1 || !tree->states[s].settled) return false;
+
+	p->key   = tree->states[s].key;
+	p->nodes = array_new(NodeID, p->key.hops + 1);
+	p->edges = array_new(Edge, p->key.hops);
+
+	// walk back to the source
+	for(; s != -1; s = tree->states[s].pred) {
+		array_append(p->nodes, tree->states[s].id);
+		if(tree->states[s].pred != -1) array_append(p->edges, tree->states[s].edge);
+	}
+
+	// reverse
+	uint n = array_len(p->nodes);
+	for(uint i = 0; i < n / 2; i++) {
+		NodeID tmp = p->nodes[i];
+		p->nodes[i] = p->nodes[n - 1 - i];
+		p->nodes[n - 1 - i] = tmp;
+	}
+	n = array_len(p->edges);
+	for(uint i = 0; i < n / 2; i++) {
+		Edge tmp = p->edges[i];
+		p->edges[i] = p->edges[n - 1 - i];
+		p->edges[n - 1 - i] = tmp;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// all shortest paths
+//------------------------------------------------------------------------------
+
+// walk back from state 's' to the source over edges which lie on a shortest
+// path, each complete walk is a path of minimal weight
+static void _ShortestPathDAG_Walk
+(
+	WeightedPathsCtx *ctx,
+	DijkstraTree *tree,
+	int64_t s,
+	NodeID src,
+	NodePath *stack,
+	NodePath **paths
+) {
+	NodeID id = tree->states[s].id;
+	array_append(stack->nodes, id);
+
+	if(id == src) {
+		// stack holds the path in reverse
+		NodePath p;
+		uint n = array_len(stack->nodes);
+		p.nodes = array_new(NodeID, n);
+		p.edges = array_new(Edge, n - 1);
+		p.key   = (PathKey){0};
+		for(uint i = n; i > 0; i--) array_append(p.nodes, stack->nodes[i - 1]);
+		for(uint i = n - 1; i > 0; i--) {
+			array_append(p.edges, stack->edges[i - 1]);
+			_extend(ctx, stack->edges + i - 1, &p.key, &p.key);
+		}
+		array_append(*paths, p);
+		array_pop(stack->nodes);
+		return;
+	}
+
+	GRAPH_EDGE_DIR dir = _reverse(ctx->t->dir);
+	Edge *edges = array_new(Edge, 8);
+
+	for(int d = 0; d < 2; d++) {
+		if(!_traverses(dir, _dirs[d])) continue;
+
+		_node_edges(ctx, id, _dirs[d], &edges);
+		uint n = array_len(edges);
+		for(uint i = 0; i < n; i++) {
+			Edge *e = edges + i;
+			NodeID pred = _other(e, _dirs[d]);
+
+			int64_t ps = _DijkstraTree_State(tree, pred);
+			if(ps == -1 || !tree->states[ps].settled) continue;
+
+			// edge must be tight
+			PathKey key;
+			_extend(ctx, e, &tree->states[ps].key, &key);
+			if(key.weight != tree->states[s].key.weight) continue;
+
+			// don't allow cycles, zero weight edges might form one
+			bool on_path = false;
+			for(uint j = 0; j < array_len(stack->nodes) && !on_path; j++) {
+				on_path = (stack->nodes[j] == pred);
+			}
+			if(on_path) continue;
+
+			array_append(stack->edges, *e);
+			_ShortestPathDAG_Walk(ctx, tree, ps, src, stack, paths);
+			array_pop(stack->edges);
+		}
+	}
+
+	array_free(edges);
+	array_pop(stack->nodes);
+}
+
+static bool _AllShortestPaths
+(
+	WeightedPathsCtx *ctx,
+	NodeID src,
+	NodeID dst,
+	NodePath **paths
+) {
+	DijkstraTree tree;
+	_DijkstraTree_Init(&tree);
+
+	bool res = _Dijkstra(ctx, &tree, src, dst, NULL, NULL, true);
+	int64_t s = _DijkstraTree_State(&tree, dst);
+
+	if(res && s != -1 && tree.states[s].settled) {
+		NodePath stack = {.nodes = array_new(NodeID, 8),
+			.edges = array_new(Edge, 8)};
+		_ShortestPathDAG_Walk(ctx, &tree, s, src, &stack, paths);
+		_NodePath_Free(&stack);
+
+		qsort(*paths, array_len(*paths), sizeof(NodePath), _NodePath_Cmp);
+	}
+
+	_DijkstraTree_Free(&tree);
+	return res;
+}
+
+//------------------------------------------------------------------------------
+// Yen's k shortest paths
+//------------------------------------------------------------------------------
+
+static bool _NodePath_Equal
+(
+	const NodePath *a,
+	const NodePath *b
+) {
+	if(array_len(a->edges) != array_len(b->edges)) return false;
+	if(array_len(a->nodes) != array_len(b->nodes)) return false;
+
+	for(uint i = 0; i < array_len(a->edges); i++) {
+		if(ENTITY_GET_ID(a->edges + i) != ENTITY_GET_ID(b->edges + i)) return false;
+	}
+	for(uint i = 0; i < array_len(a->nodes); i++) {
+		if(a->nodes[i] != b->nodes[i]) return false;
+	}
+
+	return true;
+}
+
+// do the first 'len' nodes and edges of 'a' and 'b' agree
+static bool _NodePath_SharesPrefix
+(
+	const NodePath *a,
+	const NodePath *b,
+	uint len
+) {
+	if(array_len(a->nodes) <= len || array_len(b->nodes) <= len) return false;
+
+	for(uint i = 0; i <= len; i++) {
+		if(a->nodes[i] != b->nodes[i]) return false;
+	}
+	for(uint i = 0; i < len; i++) {
+		if(ENTITY_GET_ID(a->edges + i) != ENTITY_GET_ID(b->edges + i)) return false;
+	}
+
+	return true;
+}
+
+static bool _Yen
+(
+	WeightedPathsCtx *ctx,
+	NodeID src,
+	NodeID dst,
+	uint64_t k,
+	NodePath **A
+) {
+	bool res = true;
+	NodePath *B = array_new(NodePath, 0);  // candidates
+
+	// shortest path
+	DijkstraTree tree;
+	NodePath p;
+	_DijkstraTree_Init(&tree);
+	res = _Dijkstra(ctx, &tree, src, dst, NULL, NULL, false);
+	if(res && _DijkstraTree_Path(&tree, dst, &p)) array_append(*A, p);
+	_DijkstraTree_Free(&tree);
+
+	dict *banned_nodes = HashTableCreate(&def_dt);
+	dict *banned_edges = HashTableCreate(&def_dt);
+
+	while(res && array_len(*A) > 0 && array_len(*A) < k) {
+		NodePath *prev = *A + array_len(*A) - 1;
+		PathKey root_key = {0};
+
+		// each node of the previous path, other than the destination
+		// is a spur node deviating from the root path leading to it
+		for(uint i = 0; i < array_len(prev->nodes) - 1; i++) {
+			if(i > 0) _extend(ctx, prev->edges + i - 1, &root_key, &root_key);
+
+			HashTableEmpty(banned_nodes, NULL);
+			HashTableEmpty(banned_edges, NULL);
+
+			// ban edges used by known paths sharing the same root
+			for(uint j = 0; j < array_len(*A); j++) {
+				NodePath *a = *A + j;
+				if(!_NodePath_SharesPrefix(a, prev, i)) continue;
+				HashTableAdd(banned_edges, (void *)ENTITY_GET_ID(a->edges + i), NULL);
+			}
+
+			// root path nodes can't be revisited
+			for(uint j = 0; j < i; j++) {
+				HashTableAdd(banned_nodes, (void *)prev->nodes[j], NULL);
+			}
+
+			NodePath spur;
+			_DijkstraTree_Init(&tree);
+			res = _Dijkstra(ctx, &tree, prev->nodes[i], dst, banned_nodes,
+					banned_edges, false);
+			bool found = res && _DijkstraTree_Path(&tree, dst, &spur);
+			_DijkstraTree_Free(&tree);
+			if(!res) break;
+			if(!found) continue;
+
+			// candidate = root + spur
+			NodePath c;
+			c.nodes = array_new(NodeID, i + array_len(spur.nodes));
+			c.edges = array_new(Edge, i + array_len(spur.edges));
+			c.key   = (PathKey){
+				.weight = root_key.weight + spur.key.weight,
+				.cost   = root_key.cost + spur.key.cost,
+				.hops   = root_key.hops + spur.key.hops
+			};
+			for(uint j = 0; j < i; j++) {
+				array_append(c.nodes, prev->nodes[j]);
+				array_append(c.edges, prev->edges[j]);
+			}
+			for(uint j = 0; j < array_len(spur.nodes); j++) {
+				array_append(c.nodes, spur.nodes[j]);
+			}
+			for(uint j = 0; j < array_len(spur.edges); j++) {
+				array_append(c.edges, spur.edges[j]);
+			}
+			_NodePath_Free(&spur);
+
+			bool known = false;
+			for(uint j = 0; j < array_len(B) && !known; j++) {
+				known = _NodePath_Equal(B + j, &c);
+			}
+
+			if(known) _NodePath_Free(&c);
+			else array_append(B, c);
+		}
+
+		if(!res || array_len(B) == 0) break;
+
+		// promote lightest candidate
+		uint min = 0;
+		for(uint j = 1; j < array_len(B); j++) {
+			if(_PathKey_Cmp(&B[j].key, &B[min].key) < 0) min = j;
+		}
+		array_append(*A, B[min]);
+		array_del_fast(B, min);
+	}
+
+	for(uint i = 0; i < array_len(B); i++) _NodePath_Free(B + i);
+	array_free(B);
+	HashTableRelease(banned_nodes);
+	HashTableRelease(banned_edges);
+
+	return res;
+}
+
+//------------------------------------------------------------------------------
+// best-first enumeration
+//------------------------------------------------------------------------------
+
+// min heap over steps, heap items are step index + 1
+static int _PathStep_Cmp
+(
+	const void *a,
+	const void *b,
+	void *udata
+) {
+	PathStep *steps = *(PathStep **)udata;
+	uint64_t ia = (uintptr_t)a - 1;
+	uint64_t ib = (uintptr_t)b - 1;
+
+	// heap_t keeps its largest item on top
+	return _PathKey_Cmp(&steps[ib].key, &steps[ia].key);
+}
+
+static bool _PathStep_OnPath
+(
+	const PathStep *steps,
+	int64_t s,
+	NodeID id
+) {
+	for(; s != -1; s = steps[s].parent) {
+		if(steps[s].node == id) return true;
+	}
+	return false;
+}
+
+static NodePath _PathStep_ToPath
+(
+	const PathStep *steps,
+	int64_t s
+) {
+	NodePath p;
+	p.key   = steps[s].key;
+	p.nodes = array_new(NodeID, p.key.hops + 1);
+	p.edges = array_new(Edge, p.key.hops);
+
+	// path is built backwards
+	for(int64_t i = s; i != -1; i = steps[i].parent) {
+		array_append(p.nodes, steps[i].node);
+		if(steps[i].parent != -1) array_append(p.edges, steps[i].edge);
+	}
+
+	uint n = array_len(p.nodes);
+	for(uint i = 0; i < n / 2; i++) {
+		NodeID tmp = p.nodes[i];
+		p.nodes[i] = p.nodes[n - 1 - i];
+		p.nodes[n - 1 - i] = tmp;
+	}
+	n = array_len(p.edges);
+	for(uint i = 0; i < n / 2; i++) {
+		Edge tmp = p.edges[i];
+		p.edges[i] = p.edges[n - 1 - i];
+		p.edges[n - 1 - i] = tmp;
+	}
+
+	return p;
+}
+
+static bool _BestFirst
+(
+	WeightedPathsCtx *ctx,
+	NodeID src,
+	const NodeID *dst,
+	uint64_t k,
+	NodePath **paths
+) {
+	bool res = true;
+	const WeightedTraversal *t = ctx->t;
+	PathStep *steps = array_new(PathStep, 64);
+	heap_t *heap = Heap_new(_PathStep_Cmp, &steps);
+
+	PathStep root = {.parent = -1, .node = src, .key = {0}};
+	array_append(steps, root);
+	Heap_offer(&heap, (void *)(uintptr_t)1);
+
+	void *item;
+	while((item = Heap_poll(heap)) != NULL) {
+		int64_t s = (uintptr_t)item - 1;
+		PathStep step = steps[s];
+
+		if(step.key.hops > 0 && (dst == NULL || step.node == *dst)) {
+			// all paths of minimal weight were collected
+			if(k == 0 && array_len(*paths) > 0 &&
+			   step.key.weight > (*paths)[0].key.weight) {
+				break;
+			}
+
+			array_append(*paths, _PathStep_ToPath(steps, s));
+			if(k > 0 && array_len(*paths) == k) break;
+
+			// simple paths can't continue past the destination
+			if(dst != NULL) continue;
+		}
+
+		if(step.key.hops >= t->maxLen) continue;
+
+		for(int d = 0; d < 2 && res; d++) {
+			if(!_traverses(t->dir, _dirs[d])) continue;
+
+			_node_edges(ctx, step.node, _dirs[d], &ctx->edges);
+			uint n = array_len(ctx->edges);
+			for(uint i = 0; i < n; i++) {
+				Edge *e = ctx->edges + i;
+				NodeID other = _other(e, _dirs[d]);
+
+				// don't allow cycles
+				if(_PathStep_OnPath(steps, s, other)) continue;
+
+				PathKey key;
+				if(!_extend(ctx, e, &step.key, &key)) {
+					res = false;
+					break;
+				}
+				if(key.cost > t->max_cost) continue;
+
+				PathStep next = {.parent = s, .node = other, .edge = *e,
+					.key = key};
+				array_append(steps, next);
+				Heap_offer(&heap, (void *)(uintptr_t)array_len(steps));
+			}
+		}
+
+		if(!res) break;
+	}
+
+	Heap_free(heap);
+	array_free(steps);
+
+	return res;
+}
+
+bool WeightedPaths_Collect
+(
+	const WeightedTraversal *t,
+	const Node *src,
+	const Node *dst,
+	uint64_t k,
+	WeightedPath **paths
+) {
+	ASSERT(t     != NULL);
+	ASSERT(src   != NULL);
+	ASSERT(paths != NULL);
+
+	*paths = NULL;
+
+	WeightedPathsCtx ctx = {.t = t, .edges = array_new(Edge, 32)};
+	NodePath *found = array_new(NodePath, 1);
+	NodeID src_id = ENTITY_GET_ID(src);
+	bool res = true;
+
+	// a single pair query which isn't limited by length or cost
+	// a simple path never has more edges than there are nodes
+	bool unconstrained = (t->max_cost == DBL_MAX &&
+			t->maxLen >= Graph_NodeCount(t->g));
+
+	if(dst != NULL && ENTITY_GET_ID(dst) == src_id) {
+		// cycles are not allowed, no path leads back to the source
+	} else if(dst != NULL && unconstrained) {
+		NodeID dst_id = ENTITY_GET_ID(dst);
+		if(k == 0) {
+			res = _AllShortestPaths(&ctx, src_id, dst_id, &found);
+		} else {
+			res = _Yen(&ctx, src_id, dst_id, k, &found);
+		}
+	} else {
+		NodeID dst_id = (dst != NULL) ? ENTITY_GET_ID(dst) : INVALID_ENTITY_ID;
+		res = _BestFirst(&ctx, src_id, (dst != NULL) ? &dst_id : NULL, k,
+				&found);
+	}
+
+	if(res) {
+		*paths = array_new(WeightedPath, array_len(found));
+		for(uint i = 0; i < array_len(found); i++) {
+			array_append(*paths, _NodePath_Materialize(&ctx, found + i));
+		}
+	}
+
+	for(uint i = 0; i < array_len(found); i++) _NodePath_Free(found + i);
+	array_free(found);
+	array_free(ctx.edges);
+
+	return res;
+}
+
@@ -0,0 +1,53 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../graph/graph.h"
+#include "../datatypes/path/path.h"
+
+// weighted path
+typedef struct {
+	Path *path;      // path
+	double weight;   // path weight
+	double cost;     // path cost
+} WeightedPath;
+
+// weighted traversal specification
+// edges missing a numeric weight/cost attribute weigh/cost 1
+typedef struct {
+	Graph *g;                  // graph to traverse
+	int *relationIDs;          // edge type(s) to traverse
+	int relationCount;         // length of relationIDs
+	GRAPH_EDGE_DIR dir;        // traverse direction
+	uint64_t maxLen;           // maximum number of edges in a path
+	Attribute_ID weight_prop;  // weight attribute id
+	Attribute_ID cost_prop;    // cost attribute id
+	double max_cost;           // maximum cost of path
+} WeightedTraversal;
+
+// collect the 'k' lightest simple paths starting at 'src'
+// if 'dst' is NULL paths may end at any node, otherwise only paths
+// ending at 'dst' are collected
+// if 'k' is 0 all paths of minimal weight are collected
+// paths are ordered by weight, then cost, then length
+//
+// single pair queries without length and cost limits are answered using
+// Dijkstra (k <= 1), Yen's k shortest paths (k > 1) or by enumerating the
+// edges of the shortest path DAG (k = 0), all other queries expand partial
+// paths in best-first order, stopping as soon as enough paths were found
+//
+// returns false if a negative weight or cost was encountered
+// in which case no paths are collected and '*paths' is left NULL
+bool WeightedPaths_Collect
+(
+	const WeightedTraversal *t,  // traversal specification
+	const Node *src,             // source node
+	const Node *dst,             // [optional] destination node
+	uint64_t k,                  // number of paths to collect
+	WeightedPath **paths         // [output] array of collected paths
+);
+
@@ -64,6 +64,10 @@ inline bool AR_EXP_IsOperation(const AR_ExpNode *exp) {
 	return exp->type == AR_EXP_OP;
 }
 
+inline bool AR_EXP_IsCached(const AR_ExpNode *exp) {
+	return exp->type == AR_EXP_OPERAND && exp->operand.type == AR_EXP_CACHED;
+}
+
 bool AR_EXP_IsAttribute(const AR_ExpNode *exp, char **attr) {
 	ASSERT(exp != NULL);
 
@@ -126,6 +130,12 @@ static AR_ExpNode *_AR_EXP_CloneOperand
 	case AR_EXP_BORROW_RECORD:
 		clone->operand.type = AR_EXP_BORROW_RECORD;
 		break;
+	case AR_EXP_CACHED:
+		clone->operand.type = AR_EXP_CACHED;
+		clone->operand.cached.alias = rm_strdup(exp->operand.cached.alias);
+		clone->operand.cached.record_idx = IDENTIFIER_NOT_FOUND;
+		clone->operand.cached.exp = AR_EXP_Clone(exp->operand.cached.exp);
+		break;
 	default:
 		ASSERT(false);
 		break;
@@ -271,6 +281,69 @@ AR_ExpNode *AR_EXP_NewRecordNode() {
 	return _AR_EXP_InitializeOperand(AR_EXP_BORROW_RECORD);
 }
 
+void AR_EXP_CacheInRecord
+(
+	AR_ExpNode *exp,
+	const char *alias
+) {
+	ASSERT(exp   != NULL);
+	ASSERT(alias != NULL);
+	ASSERT(AR_EXP_IsOperation(exp));
+
+	// move expression's content into a new node
+	AR_ExpNode *computation = rm_malloc(sizeof(AR_ExpNode));
+	*computation = *exp;
+	computation->resolved_name = NULL;
+
+	// repurpose as cached operand
+	exp->type                        = AR_EXP_OPERAND;
+	exp->operand.type                = AR_EXP_CACHED;
+	exp->operand.cached.exp          = computation;
+	exp->operand.cached.alias        = rm_strdup(alias);
+	exp->operand.cached.record_idx   = IDENTIFIER_NOT_FOUND;
+}
+
+int AR_EXP_CachedRecordIdx
+(
+	AR_ExpNode *exp,
+	const Record r
+) {
+	ASSERT(AR_EXP_IsCached(exp));
+
+	if(r == NULL) return INVALID_INDEX;
+
+	// resolve record index, once known it never changes
+	AR_OperandNode *operand = &exp->operand;
+	if(operand->cached.record_idx == IDENTIFIER_NOT_FOUND) {
+		operand->cached.record_idx = Record_GetEntryIdx(r, operand->cached.alias);
+	}
+
+	return operand->cached.record_idx;
+}
+
+SIValue AR_EXP_CacheValue
+(
+	Record r,
+	int idx,
+	SIValue v
+) {
+	ASSERT(r != NULL);
+	ASSERT(idx != INVALID_INDEX);
+
+	if(SI_TYPE(v) & SI_GRAPHENTITY) {
+		// graph entities are copied into the record
+		Record_Add(r, idx, v);
+		SIValue_Free(v);
+	} else {
+		// record takes ownership over value
+		SIValue_Persist(&v);
+		Record_AddScalar(r, idx, v);
+	}
+
+	// the value is owned by the record; share with the caller
+	return SI_ShareValue(Record_Get(r, idx));
+}
+
 void AR_SetPrivateData
 (
 	AR_ExpNode *node, void *pdata
@@ -407,7 +480,9 @@ void AR_EXP_ResolveVariables(AR_ExpNode *root, const Record r) {
 	AR_EXP_ReduceToScalar(root, true, NULL);
 }
 
-static bool _AR_EXP_ValidateInvocation
+// validate function's arguments types
+// sets a type mismatch error and returns false on failure
+bool AR_EXP_ValidateInvocation
 (
 	AR_FuncDesc *fdesc,
 	SIValue *argv,
@@ -489,7 +564,7 @@ static AR_EXP_Result _AR_EXP_EvaluateFunctionCall
 	if(param_found) res = EVAL_FOUND_PARAM;
 
 	// validate before evaluation
-	if(!_AR_EXP_ValidateInvocation(node->op.f, sub_trees, child_count)) {
+	if(!AR_EXP_ValidateInvocation(node->op.f, sub_trees, child_count)) {
 		// the expression tree failed its validations and set an error message
 		res = EVAL_ERR;
 		goto cleanup;
@@ -577,6 +652,32 @@ static AR_EXP_Result _AR_EXP_EvaluateParam
 	return EVAL_FOUND_PARAM;
 }
 
+static AR_EXP_Result _AR_EXP_EvaluateCached
+(
+	AR_ExpNode *node,
+	const Record r,
+	SIValue *result
+) {
+	AR_ExpNode *exp = node->operand.cached.exp;
+	int idx = AR_EXP_CachedRecordIdx(node, r);
+
+	// record can't hold value, evaluate expression
+	if(idx == INVALID_INDEX) return _AR_EXP_Evaluate(exp, r, result);
+
+	// value already computed for this record
+	if(Record_ContainsEntry(r, idx)) {
+		*result = SI_ShareValue(Record_Get(r, idx));
+		return EVAL_OK;
+	}
+
+	SIValue v;
+	AR_EXP_Result res = _AR_EXP_Evaluate(exp, r, &v);
+	if(res == EVAL_ERR) return res;
+
+	*result = AR_EXP_CacheValue(r, idx, v);
+	return res;
+}
+
 static inline AR_EXP_Result _AR_EXP_EvaluateBorrowRecord(AR_ExpNode *node, const Record r,
 														 SIValue *result) {
 	// Wrap the current Record in an SI pointer.
@@ -611,6 +712,8 @@ static AR_EXP_Result _AR_EXP_Evaluate
 			return _AR_EXP_EvaluateParam(root, result);
 		case AR_EXP_BORROW_RECORD:
 			return _AR_EXP_EvaluateBorrowRecord(root, r, result);
+		case AR_EXP_CACHED:
+			return _AR_EXP_EvaluateCached(root, r, result);
 		default:
 			ASSERT(false && "Invalid expression type");
 		}
@@ -736,6 +839,8 @@ void AR_EXP_CollectEntities(AR_ExpNode *root, rax *aliases) {
 		if(root->operand.type == AR_EXP_VARIADIC) {
 			const char *entity = root->operand.variadic.entity_alias;
 			raxInsert(aliases, (unsigned char *)entity, strlen(entity), NULL, NULL);
+		} else if(root->operand.type == AR_EXP_CACHED) {
+			AR_EXP_CollectEntities(root->operand.cached.exp, aliases);
 		}
 	}
 }
@@ -755,6 +860,8 @@ void AR_EXP_CollectAttributes(AR_ExpNode *root, rax *attributes) {
 		for(int i = 0; i < root->op.child_count; i ++) {
 			AR_EXP_CollectAttributes(root->op.children[i], attributes);
 		}
+	} else if(AR_EXP_IsCached(root)) {
+		AR_EXP_CollectAttributes(root->operand.cached.exp, attributes);
 	}
 }
 
@@ -778,6 +885,8 @@ bool AR_EXP_ContainsFunc(const AR_ExpNode *root, const char *func) {
 		for(int i = 0; i < root->op.child_count; i++) {
 			if(AR_EXP_ContainsFunc(root->op.children[i], func)) return true;
 		}
+	} else if(AR_EXP_IsCached(root)) {
+		return AR_EXP_ContainsFunc(root->operand.cached.exp, func);
 	}
 	return false;
 }
@@ -790,10 +899,62 @@ bool AR_EXP_ContainsVariadic(const AR_ExpNode *root) {
 		}
 	} else if(AR_EXP_IsVariadic(root)) {
 		return true;
+	} else if(AR_EXP_IsCached(root)) {
+		return AR_EXP_ContainsVariadic(root->operand.cached.exp);
 	}
 	return false;
 }
 
+bool AR_EXP_Equal
+(
+	const AR_ExpNode *a,
+	const AR_ExpNode *b
+) {
+	ASSERT(a != NULL && b != NULL);
+
+	if(a->type != b->type) return false;
+
+	if(AR_EXP_IsOperation(a)) {
+		// functions holding private data e.g. aggregations and comprehensions
+		// are never considered equal
+		if(a->op.f != b->op.f                       ||
+		   a->op.child_count != b->op.child_count   ||
+		   a->op.private_data != NULL               ||
+		   b->op.private_data != NULL) {
+			return false;
+		}
+
+		for(int i = 0; i < a->op.child_count; i++) {
+			if(!AR_EXP_Equal(a->op.children[i], b->op.children[i])) return false;
+		}
+
+		return true;
+	}
+
+	if(a->operand.type != b->operand.type) return false;
+
+	switch(a->operand.type) {
+		case AR_EXP_CONSTANT: {
+			SIValue x = a->operand.constant;
+			SIValue y = b->operand.constant;
+			// 1 and 1.0 compare equal but aren't the same constant
+			return SI_TYPE(x) == SI_TYPE(y) &&
+				(SI_TYPE(x) == T_NULL || SIValue_Compare(x, y, NULL) == 0);
+		}
+		case AR_EXP_VARIADIC:
+			return strcmp(a->operand.variadic.entity_alias,
+					b->operand.variadic.entity_alias) == 0;
+		case AR_EXP_PARAM:
+			return strcmp(a->operand.param_name, b->operand.param_name) == 0;
+		case AR_EXP_BORROW_RECORD:
+			return true;
+		case AR_EXP_CACHED:
+			return strcmp(a->operand.cached.alias, b->operand.cached.alias) == 0;
+		default:
+			return false;
+	}
+}
+
 // return type of expression
 // e.g. the expression: `1+3` return type is SI_NUMERIC
 // e.g. the expression : `ToString(4+3)` return type is T_STRING
@@ -816,6 +977,8 @@ SIType AR_EXP_ReturnType
 		// expression is an operand
 		if (exp->operand.type == AR_EXP_CONSTANT) {
 			t = exp->operand.constant.type;
+		} else if(exp->operand.type == AR_EXP_CACHED) {
+			t = AR_EXP_ReturnType(exp->operand.cached.exp);
 		}
 	}
 
@@ -860,7 +1023,20 @@ void _AR_EXP_ToString(const AR_ExpNode *root, char **str, size_t *str_size,
 		else if(strcmp(func_name, "MUL") == 0) binary_op = '*';
 		else if(strcmp(func_name, "DIV") == 0)  binary_op = '/';
 
-		if(binary_op) {
+		char *attr = NULL;
+		if(AR_EXP_IsAttribute(root, &attr)) {
+			/* Attribute access, e.g. n.v */
+			_AR_EXP_ToString(root->op.children[0], str, str_size, bytes_written);
+
+			/* Make sure there's enough room for the attribute name. */
+			size_t attr_len = strlen(attr);
+			if((*str_size - strlen(*str)) < attr_len + 64) {
+				*str_size += attr_len + 128;
+				*str = rm_realloc(*str, sizeof(char) * *str_size);
+			}
+
+			*bytes_written += sprintf((*str + *bytes_written), ".%s", attr);
+		} else if(binary_op) {
 			_AR_EXP_ToString(root->op.children[0], str, str_size, bytes_written);
 
 			/* Make sure there are at least 64 bytes in str. */
@@ -894,6 +1070,8 @@ void _AR_EXP_ToString(const AR_ExpNode *root, char **str, size_t *str_size,
 		// Concat Operand node.
 		if(root->operand.type == AR_EXP_CONSTANT) {
 			SIValue_ToString(root->operand.constant, str, str_size, bytes_written);
+		} else if(root->operand.type == AR_EXP_CACHED) {
+			_AR_EXP_ToString(root->operand.cached.exp, str, str_size, bytes_written);
 		} else {
 			*bytes_written += sprintf((*str + *bytes_written), "%s", root->operand.variadic.entity_alias);
 		}
@@ -966,6 +1144,9 @@ inline void AR_EXP_Free
 		_AR_EXP_FreeOpInternals(root);
 	} else if(AR_EXP_IsConstant(root)) {
 		SIValue_Free(root->operand.constant);
+	} else if(AR_EXP_IsCached(root)) {
+		AR_EXP_Free(root->operand.cached.exp);
+		rm_free(root->operand.cached.alias);
 	}
 
 	rm_free(root);
@@ -27,7 +27,8 @@ typedef enum {
 	AR_EXP_CONSTANT,       // a constant, e.g. 3
 	AR_EXP_VARIADIC,       // a variable, e.g. n
 	AR_EXP_PARAM,          // a parameter, e.g. $p
-	AR_EXP_BORROW_RECORD   // a directive to store the current record
+	AR_EXP_BORROW_RECORD,  // a directive to store the current record
+	AR_EXP_CACHED          // a subexpression computed once per record
 } AR_OperandNodeType;
 
 // success of an evaluation
@@ -54,6 +55,11 @@ typedef struct {
 			const char *entity_alias;
 			int entity_alias_idx;
 		} variadic;
+		struct {
+			char *alias;             // record entry holding computed value
+			int record_idx;          // record index of alias
+			struct AR_ExpNode *exp;  // expression computing the value
+		} cached;
 	};
 	AR_OperandNodeType type;
 } AR_OperandNode;
@@ -93,6 +99,19 @@ AR_ExpNode *AR_EXP_NewRecordNode(void);
 // set node private data
 void AR_SetPrivateData(AR_ExpNode *node, void *pdata);
 
+// repurpose expression as a cached operand
+// the expression's value is computed once per record and stored under alias
+// expression's original content is moved into the cached operand
+void AR_EXP_CacheInRecord(AR_ExpNode *exp, const char *alias);
+
+// returns record index holding cached operand's value
+// INVALID_INDEX if record can't hold the value
+int AR_EXP_CachedRecordIdx(AR_ExpNode *exp, const Record r);
+
+// store value computed for a cached operand at record[idx]
+// returns the stored value, shared with the record
+SIValue AR_EXP_CacheValue(Record r, int idx, SIValue v);
+
 // compact tree by evaluating all contained functions that can be resolved right now
 // the function returns true if it managed to compact the expression
 // the reduce_params flag indicates if parameters should be evaluated
@@ -102,6 +121,10 @@ bool AR_EXP_ReduceToScalar(AR_ExpNode *root, bool reduce_params, SIValue *val);
 // resolve variables to constants
 void AR_EXP_ResolveVariables(AR_ExpNode *root, const Record r);
 
+// validate function's arguments types
+// sets a type mismatch error and returns false on failure
+bool AR_EXP_ValidateInvocation(AR_FuncDesc *fdesc, SIValue *argv, uint argc);
+
 // evaluate arithmetic expression tree
 // this function raise exception
 SIValue AR_EXP_Evaluate(AR_ExpNode *root, const Record r);
@@ -157,6 +180,12 @@ bool AR_EXP_IsParameter(const AR_ExpNode *exp);
 // returns true if an arithmetic expression node is an operation
 bool AR_EXP_IsOperation(const AR_ExpNode *exp);
 
+// returns true if an arithmetic expression node is cached within the record
+bool AR_EXP_IsCached(const AR_ExpNode *exp);
+
+// returns true if both expressions are structurally identical
+bool AR_EXP_Equal(const AR_ExpNode *a, const AR_ExpNode *b);
+
 // returns true if 'exp' represent attribute extraction
 // sets 'attr' to attribute name if provided
 bool AR_EXP_IsAttribute(const AR_ExpNode *exp, char **attr);
@@ -0,0 +1,810 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "arithmetic_expression_compile.h"
+#include "RG.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../errors/errors.h"
+#include "../datatypes/array.h"
+#include "../graph/graphcontext.h"
+
+#include <math.h>
+#include <string.h>
+
+// program instructions
+typedef enum {
+	AR_OP_CONST,          // dst = constant
+	AR_OP_LOAD,           // dst = record[alias]
+	AR_OP_RECORD,         // dst = record
+	AR_OP_PROPERTY,       // dst = a.attr
+	AR_OP_ADD,            // dst = a + b
+	AR_OP_SUB,            // dst = a - b
+	AR_OP_MUL,            // dst = a * b
+	AR_OP_LT,             // dst = a < b
+	AR_OP_LE,             // dst = a <= b
+	AR_OP_GT,             // dst = a > b
+	AR_OP_GE,             // dst = a >= b
+	AR_OP_CALL,           // dst = f(a, a + 1, ..., a + argc - 1)
+	AR_OP_COMPARE,        // dst = a op b, filter semantics
+	AR_OP_TRUTH,          // dst = truth(a)
+	AR_OP_LOGIC,          // dst = dst op b, three-valued logic
+	AR_OP_BRANCH_FALSE,   // if a is false goto target
+	AR_OP_BRANCH_TRUE,    // if a is true goto target
+	AR_OP_BRANCH_NULL,    // if a is null goto target
+	AR_OP_CACHED_LOAD,    // if record holds value: dst = value, goto target
+	AR_OP_CACHED_STORE,   // record[alias] = dst
+} AR_OpCode;
+
+typedef struct {
+	AR_OpCode code;     // instruction
+	int dst;            // destination register
+	int a;              // first operand register
+	int b;              // second operand register
+	uint argc;          // number of arguments, AR_OP_CALL
+	uint target;        // branch target
+	AST_Operator op;    // comparison or logical operator
+	Attribute_ID attr;  // attribute id, AR_OP_PROPERTY
+	SIValue constant;   // constant value, AR_OP_CONST
+	AR_ExpNode *node;   // originating expression node
+} AR_Instruction;
+
+struct AR_Program {
+	AR_Instruction *code;  // instructions
+	SIValue *regs;         // registers
+	int nregs;             // number of registers
+	int result;            // result register
+};
+
+//------------------------------------------------------------------------------
+// compilation
+//------------------------------------------------------------------------------
+
+static inline int _AllocRegs
+(
+	AR_Program *p,
+	int n
+) {
+	int reg = p->nregs;
+	p->nregs += n;
+	return reg;
+}
+
+static inline AR_Instruction *_Emit
+(
+	AR_Program *p,
+	AR_OpCode code,
+	int dst
+) {
+	AR_Instruction i = {0};
+	i.code = code;
+	i.dst  = dst;
+	array_append(p->code, i);
+	return p->code + array_len(p->code) - 1;
+}
+
+// map function name to a type specialized instruction
+// returns AR_OP_CALL if function has no specialized instruction
+static AR_OpCode _SpecializedOp
+(
+	const AR_ExpNode *exp
+) {
+	const char *name = exp->op.f->name;
+
+	if(exp->op.child_count != 2) return AR_OP_CALL;
+
+	if(strcmp(name, "add") == 0) return AR_OP_ADD;
+	if(strcmp(name, "sub") == 0) return AR_OP_SUB;
+	if(strcmp(name, "mul") == 0) return AR_OP_MUL;
+	if(strcmp(name, "lt")  == 0) return AR_OP_LT;
+	if(strcmp(name, "le")  == 0) return AR_OP_LE;
+	if(strcmp(name, "gt")  == 0) return AR_OP_GT;
+	if(strcmp(name, "ge")  == 0) return AR_OP_GE;
+
+	return AR_OP_CALL;
+}
+
+static bool _CompileExp
+(
+	AR_Program *p,
+	AR_ExpNode *exp,
+	int dst
+);
+
+static bool _CompileOperand
+(
+	AR_Program *p,
+	AR_ExpNode *exp,
+	int dst
+) {
+	AR_Instruction *i;
+
+	switch(exp->operand.type) {
+		case AR_EXP_CONSTANT:
+			i = _Emit(p, AR_OP_CONST, dst);
+			i->constant = exp->operand.constant;
+			return true;
+
+		case AR_EXP_VARIADIC:
+			i = _Emit(p, AR_OP_LOAD, dst);
+			i->node = exp;
+			return true;
+
+		case AR_EXP_BORROW_RECORD:
+			_Emit(p, AR_OP_RECORD, dst);
+			return true;
+
+		case AR_EXP_CACHED: {
+			// value is either read from the record
+			// or computed and stored within the record
+			uint load = array_len(p->code);
+			i = _Emit(p, AR_OP_CACHED_LOAD, dst);
+			i->node = exp;
+
+			if(!_CompileExp(p, exp->operand.cached.exp, dst)) return false;
+
+			i = _Emit(p, AR_OP_CACHED_STORE, dst);
+			i->node = exp;
+
+			p->code[load].target = array_len(p->code);
+			return true;
+		}
+
+		case AR_EXP_PARAM: {
+			// parameters are bound at this point, treat as constant
+			// missing parameters are reported by the expression tree
+			rax *params = QueryCtx_GetParams();
+			if(params == NULL) return false;
+
+			const char *name = exp->operand.param_name;
+			SIValue *v = raxFind(params, (unsigned char *)name, strlen(name));
+			if(v == raxNotFound) return false;
+
+			i = _Emit(p, AR_OP_CONST, dst);
+			i->constant = *v;
+			return true;
+		}
+
+		default:
+			return false;
+	}
+}
+
+static bool _CompileOp
+(
+	AR_Program *p,
+	AR_ExpNode *exp,
+	int dst
+) {
+	// aggregations are evaluated by the expression tree
+	if(exp->op.f->aggregate) return false;
+
+	uint argc = exp->op.child_count;
+
+	// property access: entity.attr
+	if(AR_EXP_IsAttribute(exp, NULL)          &&
+	   AR_EXP_IsConstant(exp->op.children[1]) &&
+	   AR_EXP_IsConstant(exp->op.children[2])) {
+		int src = _AllocRegs(p, 1);
+		if(!_CompileExp(p, exp->op.children[0], src)) return false;
+
+		AR_Instruction *i = _Emit(p, AR_OP_PROPERTY, dst);
+		i->a    = src;
+		i->node = exp;
+		i->attr = exp->op.children[2]->operand.constant.longval;
+		return true;
+	}
+
+	// arguments are placed in consecutive registers
+	int args = _AllocRegs(p, argc);
+	for(uint j = 0; j < argc; j++) {
+		if(!_CompileExp(p, exp->op.children[j], args + j)) return false;
+	}
+
+	AR_Instruction *i = _Emit(p, _SpecializedOp(exp), dst);
+	i->a    = args;
+	i->b    = args + 1;
+	i->argc = argc;
+	i->node = exp;
+
+	return true;
+}
+
+static bool _CompileExp
+(
+	AR_Program *p,
+	AR_ExpNode *exp,
+	int dst
+) {
+	if(AR_EXP_IsOperation(exp)) return _CompileOp(p, exp, dst);
+	return _CompileOperand(p, exp, dst);
+}
+
+AR_Program *AR_Program_New(void) {
+	AR_Program *p = rm_calloc(1, sizeof(AR_Program));
+
+	p->code   = array_new(AR_Instruction, 8);
+	p->result = AR_PROGRAM_INVALID_REG;
+
+	return p;
+}
+
+int AR_Program_EmitExp
+(
+	AR_Program *p,
+	AR_ExpNode *exp
+) {
+	ASSERT(p   != NULL);
+	ASSERT(exp != NULL);
+
+	int dst = _AllocRegs(p, 1);
+	return _CompileExp(p, exp, dst) ? dst : AR_PROGRAM_INVALID_REG;
+}
+
+int AR_Program_EmitCompare
+(
+	AR_Program *p,
+	AST_Operator op,
+	int lhs,
+	int rhs
+) {
+	ASSERT(p != NULL);
+
+	int dst = _AllocRegs(p, 1);
+	AR_Instruction *i = _Emit(p, AR_OP_COMPARE, dst);
+	i->a  = lhs;
+	i->b  = rhs;
+	i->op = op;
+
+	return dst;
+}
+
+int AR_Program_EmitTruth
+(
+	AR_Program *p,
+	int reg
+) {
+	ASSERT(p != NULL);
+
+	int dst = _AllocRegs(p, 1);
+	AR_Instruction *i = _Emit(p, AR_OP_TRUTH, dst);
+	i->a = reg;
+
+	return dst;
+}
+
+void AR_Program_EmitLogic
+(
+	AR_Program *p,
+	AST_Operator op,
+	int lhs,
+	int rhs
+) {
+	ASSERT(p != NULL);
+	ASSERT(op == OP_AND || op == OP_OR || op == OP_XOR || op == OP_XNOR ||
+		   op == OP_NOT);
+
+	AR_Instruction *i = _Emit(p, AR_OP_LOGIC, lhs);
+	i->b  = rhs;
+	i->op = op;
+}
+
+uint AR_Program_EmitBranch
+(
+	AR_Program *p,
+	AR_BranchCond cond,
+	int reg
+) {
+	ASSERT(p != NULL);
+
+	AR_OpCode code;
+	switch(cond) {
+		case AR_BRANCH_FALSE:
+			code = AR_OP_BRANCH_FALSE;
+			break;
+		case AR_BRANCH_TRUE:
+			code = AR_OP_BRANCH_TRUE;
+			break;
+		default:
+			code = AR_OP_BRANCH_NULL;
+			break;
+	}
+
+	AR_Instruction *i = _Emit(p, code, AR_PROGRAM_INVALID_REG);
+	i->a = reg;
+
+	return array_len(p->code) - 1;
+}
+
+void AR_Program_PatchBranch
+(
+	AR_Program *p,
+	uint branch
+) {
+	ASSERT(p != NULL);
+	ASSERT(branch < array_len(p->code));
+
+	p->code[branch].target = array_len(p->code);
+}
+
+void AR_Program_Finalize
+(
+	AR_Program *p,
+	int result
+) {
+	ASSERT(p       != NULL);
+	ASSERT(p->regs == NULL);
+	ASSERT(result  >= 0 && result < p->nregs);
+
+	p->result = result;
+	p->regs   = rm_malloc(sizeof(SIValue) * p->nregs);
+	for(int i = 0; i < p->nregs; i++) p->regs[i] = SI_NullVal();
+}
+
+AR_Program *AR_EXP_Compile
+(
+	AR_ExpNode *root
+) {
+	ASSERT(root != NULL);
+
+	AR_Program *p = AR_Program_New();
+	int result = AR_Program_EmitExp(p, root);
+
+	if(result == AR_PROGRAM_INVALID_REG) {
+		AR_Program_Free(p);
+		return NULL;
+	}
+
+	AR_Program_Finalize(p, result);
+	return p;
+}
+
+//------------------------------------------------------------------------------
+// evaluation
+//------------------------------------------------------------------------------
+
+// release register's value
+static inline void _Release
+(
+	SIValue *regs,
+	int reg
+) {
+	SIValue_Free(regs[reg]);
+	regs[reg] = SI_NullVal();
+}
+
+static bool _Load
+(
+	const AR_Instruction *i,
+	const Record r,
+	SIValue *regs
+) {
+	AR_OperandNode *operand = &i->node->operand;
+
+	// make sure entity record index is known
+	if(operand->variadic.entity_alias_idx == IDENTIFIER_NOT_FOUND) {
+		if(r == NULL) {
+			ErrorCtx_SetError(EMSG_MISSING_RECORD,
+					operand->variadic.entity_alias);
+			return false;
+		}
+
+		int idx = Record_GetEntryIdx(r, operand->variadic.entity_alias);
+		if(idx == INVALID_INDEX) {
+			ErrorCtx_SetError(EMSG_MISSING_VALUE,
+					operand->variadic.entity_alias);
+			return false;
+		}
+
+		operand->variadic.entity_alias_idx = idx;
+	}
+
+	// the value was not created here; share with the caller
+	regs[i->dst] =
+		SI_ShareValue(Record_Get(r, operand->variadic.entity_alias_idx));
+
+	return true;
+}
+
+// invoke instruction's function on argv
+static bool _Call
+(
+	const AR_Instruction *i,
+	SIValue *argv,
+	uint argc,
+	SIValue *result
+) {
+	AR_OpNode *op = &i->node->op;
+
+	if(!AR_EXP_ValidateInvocation(op->f, argv, argc)) return false;
+
+	SIValue v = op->f->func(argv, argc, op->private_data);
+	if(SIValue_IsNull(v) && ErrorCtx_EncounteredError()) return false;
+
+	SIValue_Persist(&v);
+	*result = v;
+
+	return true;
+}
+
+static bool _Property
+(
+	AR_Instruction *i,
+	SIValue *regs
+) {
+	SIValue obj = regs[i->a];
+
+	if(likely(SI_TYPE(obj) & SI_GRAPHENTITY)) {
+		// resolve attribute id, once known it never changes
+		if(unlikely(i->attr == ATTRIBUTE_ID_NONE)) {
+			GraphContext *gc = QueryCtx_GetGraphCtx();
+			const char *name = i->node->op.children[1]->operand.constant.stringval;
+			i->attr = GraphContext_GetAttributeID(gc, name);
+		}
+
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)obj.ptrval, i->attr);
+		regs[i->dst] = SI_ConstValue(v);
+		_Release(regs, i->a);
+		return true;
+	}
+
+	// maps, points and null
+	SIValue argv[3] = {
+		obj,
+		i->node->op.children[1]->operand.constant,
+		SI_LongVal(i->attr)
+	};
+
+	bool ok = _Call(i, argv, 3, regs + i->dst);
+	_Release(regs, i->a);
+	return ok;
+}
+
+static bool _Arithmetic
+(
+	const AR_Instruction *i,
+	SIValue *regs
+) {
+	SIValue a = regs[i->a];
+	SIValue b = regs[i->b];
+	SIType  t = SI_TYPE(a) & SI_TYPE(b);
+
+	if(likely(t & T_INT64)) {
+		int64_t x = a.longval;
+		int64_t y = b.longval;
+		int64_t v = (i->code == AR_OP_ADD) ? x + y :
+					(i->code == AR_OP_SUB) ? x - y : x * y;
+		regs[i->dst] = SI_LongVal(v);
+		return true;
+	}
+
+	if((SI_TYPE(a) & SI_NUMERIC) && (SI_TYPE(b) & SI_NUMERIC)) {
+		double x = SI_GET_NUMERIC(a);
+		double y = SI_GET_NUMERIC(b);
+		double v = (i->code == AR_OP_ADD) ? x + y :
+				   (i->code == AR_OP_SUB) ? x - y : x * y;
+		regs[i->dst] = SI_DoubleVal(v);
+		return true;
+	}
+
+	// null, strings, lists, temporal values
+	bool ok = _Call(i, regs + i->a, 2, regs + i->dst);
+	_Release(regs, i->a);
+	_Release(regs, i->b);
+	return ok;
+}
+
+// compare two numeric values, same as SIValue_Compare
+static inline int _CompareNumeric
+(
+	SIValue a,
+	SIValue b,
+	bool *nan
+) {
+	if(SI_TYPE(a) & SI_TYPE(b) & T_INT64) {
+		*nan = false;
+		return SAFE_COMPARISON_RESULT(a.longval - b.longval);
+	}
+
+	double x = SI_GET_NUMERIC(a);
+	double y = SI_GET_NUMERIC(b);
+	*nan = isnan(x) || isnan(y);
+	return SAFE_COMPARISON_RESULT(x - y);
+}
+
+static inline bool _ApplyOperator
+(
+	AST_Operator op,
+	int rel
+) {
+	switch(op) {
+		case OP_EQUAL:
+			return rel == 0;
+		case OP_NEQUAL:
+			return rel != 0;
+		case OP_GT:
+			return rel > 0;
+		case OP_GE:
+			return rel >= 0;
+		case OP_LT:
+			return rel < 0;
+		case OP_LE:
+			return rel <= 0;
+		default:
+			ASSERT(false);
+			return false;
+	}
+}
+
+// comparison functions: a < b, a <= b, a > b, a >= b
+static bool _Relation
+(
+	const AR_Instruction *i,
+	SIValue *regs
+) {
+	SIValue a = regs[i->a];
+	SIValue b = regs[i->b];
+
+	if(likely((SI_TYPE(a) & SI_NUMERIC) && (SI_TYPE(b) & SI_NUMERIC))) {
+		bool nan;
+		int rel = _CompareNumeric(a, b, &nan);
+
+		// comparisons with NaN values always return false
+		AST_Operator op = (i->code == AR_OP_LT) ? OP_LT :
+						  (i->code == AR_OP_LE) ? OP_LE :
+						  (i->code == AR_OP_GT) ? OP_GT : OP_GE;
+		regs[i->dst] = SI_BoolVal(!nan && _ApplyOperator(op, rel));
+		return true;
+	}
+
+	bool ok = _Call(i, regs + i->a, 2, regs + i->dst);
+	_Release(regs, i->a);
+	_Release(regs, i->b);
+	return ok;
+}
+
+// filter comparison, evaluates to either true, false or null
+static void _Compare
+(
+	const AR_Instruction *i,
+	SIValue *regs
+) {
+	SIValue a = regs[i->a];
+	SIValue b = regs[i->b];
+	SIValue res;
+
+	if(likely((SI_TYPE(a) & SI_NUMERIC) && (SI_TYPE(b) & SI_NUMERIC))) {
+		bool nan;
+		int rel = _CompareNumeric(a, b, &nan);
+		// NaN passes only for inequality
+		res = SI_BoolVal(nan ? i->op == OP_NEQUAL : _ApplyOperator(i->op, rel));
+	} else {
+		int disjointOrNull = 0;
+		int rel = SIValue_Compare(a, b, &disjointOrNull);
+
+		if(disjointOrNull == COMPARED_NULL) {
+			res = SI_NullVal();
+		} else if(disjointOrNull == DISJOINT ||
+				  disjointOrNull == COMPARED_NAN) {
+			// values of disjoint types pass only for inequality
+			res = SI_BoolVal(i->op == OP_NEQUAL);
+		} else {
+			res = SI_BoolVal(_ApplyOperator(i->op, rel));
+		}
+
+		_Release(regs, i->a);
+		_Release(regs, i->b);
+	}
+
+	regs[i->dst] = res;
+}
+
+// convert value into a filter's truth value
+static void _Truth
+(
+	const AR_Instruction *i,
+	SIValue *regs
+) {
+	SIValue v = regs[i->a];
+	SIValue res;
+
+	if(SIValue_IsNull(v)) {
+		res = SI_NullVal();
+	} else if(SI_TYPE(v) & T_BOOL) {
+		res = v;
+	} else if(SI_TYPE(v) & T_ARRAY) {
+		// an empty array is falsey, all other arrays are truthy
+		res = SI_BoolVal(SIArray_Length(v) > 0);
+	} else {
+		// numeric, string, node or edge
+		Error_SITypeMismatch(v, T_BOOL);
+		res = SI_BoolVal(false);
+	}
+
+	_Release(regs, i->a);
+	regs[i->dst] = res;
+}
+
+// three-valued logic over true, false and null
+static void _Logic
+(
+	const AR_Instruction *i,
+	SIValue *regs
+) {
+	SIValue a = regs[i->dst];
+	SIValue b = regs[i->b];
+	bool a_null = SIValue_IsNull(a);
+	bool b_null = SIValue_IsNull(b);
+	SIValue res;
+
+	switch(i->op) {
+		case OP_AND:
+			if((!a_null && !a.longval) || (!b_null && !b.longval)) {
+				res = SI_BoolVal(false);
+			} else if(a_null || b_null) {
+				res = SI_NullVal();
+			} else {
+				res = SI_BoolVal(true);
+			}
+			break;
+		case OP_OR:
+			if((!a_null && a.longval) || (!b_null && b.longval)) {
+				res = SI_BoolVal(true);
+			} else if(a_null || b_null) {
+				res = SI_NullVal();
+			} else {
+				res = SI_BoolVal(false);
+			}
+			break;
+		case OP_XOR:
+		case OP_XNOR:
+			if(a_null || b_null) {
+				res = SI_NullVal();
+			} else {
+				bool equal = (a.longval != 0) == (b.longval != 0);
+				res = SI_BoolVal((i->op == OP_XOR) ? !equal : equal);
+			}
+			break;
+		case OP_NOT:
+			res = a_null ? a : SI_BoolVal(!a.longval);
+			break;
+		default:
+			ASSERT(false);
+			res = SI_NullVal();
+			break;
+	}
+
+	regs[i->dst] = res;
+}
+
+SIValue AR_Program_Evaluate
+(
+	AR_Program *p,
+	const Record r
+) {
+	ASSERT(p       != NULL);
+	ASSERT(p->regs != NULL);
+
+	SIValue *regs        = p->regs;
+	AR_Instruction *code = p->code;
+	uint n               = array_len(code);
+	uint pc              = 0;
+
+	while(pc < n) {
+		AR_Instruction *i = code + pc++;
+
+		switch(i->code) {
+			case AR_OP_CONST:
+				// the value is constant, share with caller
+				regs[i->dst] = SI_ShareValue(i->constant);
+				break;
+			case AR_OP_LOAD:
+				if(!_Load(i, r, regs)) goto error;
+				break;
+			case AR_OP_RECORD:
+				regs[i->dst] = SI_PtrVal(r);
+				break;
+			case AR_OP_CACHED_LOAD: {
+				int idx = AR_EXP_CachedRecordIdx(i->node, r);
+				if(idx != INVALID_INDEX && Record_ContainsEntry(r, idx)) {
+					regs[i->dst] = SI_ShareValue(Record_Get(r, idx));
+					pc = i->target;
+				}
+				break;
+			}
+			case AR_OP_CACHED_STORE: {
+				int idx = AR_EXP_CachedRecordIdx(i->node, r);
+				if(idx != INVALID_INDEX) {
+					regs[i->dst] = AR_EXP_CacheValue(r, idx, regs[i->dst]);
+				}
+				break;
+			}
+			case AR_OP_PROPERTY:
+				if(!_Property(i, regs)) goto error;
+				break;
+			case AR_OP_ADD:
+			case AR_OP_SUB:
+			case AR_OP_MUL:
+				if(!_Arithmetic(i, regs)) goto error;
+				break;
+			case AR_OP_LT:
+			case AR_OP_LE:
+			case AR_OP_GT:
+			case AR_OP_GE:
+				if(!_Relation(i, regs)) goto error;
+				break;
+			case AR_OP_CALL: {
+				bool ok = _Call(i, regs + i->a, i->argc, regs + i->dst);
+				for(uint j = 0; j < i->argc; j++) _Release(regs, i->a + j);
+				if(!ok) goto error;
+				break;
+			}
+			case AR_OP_COMPARE:
+				_Compare(i, regs);
+				break;
+			case AR_OP_TRUTH:
+				_Truth(i, regs);
+				break;
+			case AR_OP_LOGIC:
+				_Logic(i, regs);
+				break;
+			case AR_OP_BRANCH_FALSE:
+				if(SI_TYPE(regs[i->a]) == T_BOOL && !regs[i->a].longval) {
+					pc = i->target;
+				}
+				break;
+			case AR_OP_BRANCH_TRUE:
+				if(SI_TYPE(regs[i->a]) == T_BOOL && regs[i->a].longval) {
+					pc = i->target;
+				}
+				break;
+			case AR_OP_BRANCH_NULL:
+				if(SIValue_IsNull(regs[i->a])) pc = i->target;
+				break;
+			default:
+				ASSERT(false && "unknown instruction");
+				break;
+		}
+	}
+
+	// hand result over to the caller
+	SIValue result = regs[p->result];
+	regs[p->result] = SI_NullVal();
+	return result;
+
+error:
+	// release intermediate values
+	for(int j = 0; j < p->nregs; j++) _Release(regs, j);
+
+	ErrorCtx_RaiseRuntimeException(NULL);
+	// otherwise return NULL;
+	// the query-level error will be emitted after cleanup
+	return SI_NullVal();
+}
+
+uint AR_Program_Length
+(
+	const AR_Program *p
+) {
+	ASSERT(p != NULL);
+	return array_len(p->code);
+}
+
+void AR_Program_Free
+(
+	AR_Program *p
+) {
+	ASSERT(p != NULL);
+
+	if(p->regs != NULL) {
+		for(int i = 0; i < p->nregs; i++) SIValue_Free(p->regs[i]);
+		rm_free(p->regs);
+	}
+
+	array_free(p->code);
+	rm_free(p);
+}
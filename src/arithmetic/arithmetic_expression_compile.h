@@ -0,0 +1,129 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "./arithmetic_expression.h"
+#include "../ast/ast_shared.h"
+
+// invalid register, returned when an expression can't be compiled
+#define AR_PROGRAM_INVALID_REG -1
+
+// AR_Program is a flat, register based, representation of arithmetic
+// expressions and filters
+//
+// expression trees are compiled into a sequence of instructions
+// each writing its result into a register, numeric arithmetic, comparisons
+// and property access have type specialized instructions
+// all other functions are invoked directly on their argument registers
+//
+// evaluating a program doesn't recurse nor allocate
+// registers are allocated once, when the program is compiled
+//
+// expressions containing aggregations or unresolved parameters
+// can't be compiled and should be evaluated by walking the expression tree
+typedef struct AR_Program AR_Program;
+
+// branch conditions
+typedef enum {
+	AR_BRANCH_FALSE,  // branch if register holds false
+	AR_BRANCH_TRUE,   // branch if register holds true
+	AR_BRANCH_NULL,   // branch if register holds null
+} AR_BranchCond;
+
+// create a new empty program
+AR_Program *AR_Program_New(void);
+
+// compile expression into program
+// returns the register holding the expression's value
+// or AR_PROGRAM_INVALID_REG if expression can't be compiled
+int AR_Program_EmitExp
+(
+	AR_Program *p,     // program
+	AR_ExpNode *exp    // expression to compile
+);
+
+// emit a filter comparison: lhs op rhs
+// comparing values of disjoint types passes only for inequality
+// returns register holding either true, false or null
+int AR_Program_EmitCompare
+(
+	AR_Program *p,     // program
+	AST_Operator op,   // comparison operator
+	int lhs,           // left hand side register
+	int rhs            // right hand side register
+);
+
+// emit a conversion of reg's value into a filter's truth value
+// null remains null, empty lists are false
+// non boolean values are reported as a type mismatch error
+// returns register holding either true, false or null
+int AR_Program_EmitTruth
+(
+	AR_Program *p,  // program
+	int reg         // register to convert
+);
+
+// emit a three-valued logical operation: lhs = lhs op rhs
+// op is one of: AND, OR, XOR, XNOR, NOT (unary, rhs is ignored)
+void AR_Program_EmitLogic
+(
+	AR_Program *p,    // program
+	AST_Operator op,  // logical operator
+	int lhs,          // left hand side register, holds result
+	int rhs           // right hand side register
+);
+
+// emit a forward branch, taken if cond holds for reg
+// returns branch id, to be patched once its target is emitted
+uint AR_Program_EmitBranch
+(
+	AR_Program *p,       // program
+	AR_BranchCond cond,  // branch condition
+	int reg              // register to test
+);
+
+// set branch target to the next instruction emitted
+void AR_Program_PatchBranch
+(
+	AR_Program *p,  // program
+	uint branch     // branch id returned by AR_Program_EmitBranch
+);
+
+// set the register holding the program's result
+// and allocate program's registers
+void AR_Program_Finalize
+(
+	AR_Program *p,  // program
+	int result      // result register
+);
+
+// compile an expression tree into a program
+// returns NULL if expression can't be compiled
+AR_Program *AR_EXP_Compile
+(
+	AR_ExpNode *root  // expression to compile
+);
+
+// evaluate program
+// same as AR_EXP_Evaluate, raises an exception on error
+SIValue AR_Program_Evaluate
+(
+	AR_Program *p,  // program to evaluate
+	const Record r  // record to evaluate against
+);
+
+// returns number of instructions in program
+uint AR_Program_Length
+(
+	const AR_Program *p  // program
+);
+
+// free program
+void AR_Program_Free
+(
+	AR_Program *p  // program to free
+);
@@ -8,6 +8,7 @@
 #include "../func_desc.h"
 #include "../../util/arr.h"
 #include "../../datatypes/set.h"
+#include "../../execution_plan/ops/shared/join_key_filter.h"
 
 /* Case When
  * Case Value [When Option i Then Result i] Else Default end */
@@ -96,6 +97,13 @@ void *Distinct_Clone(void *orig) {
 	return Set_New();
 }
 
+// JoinKeyFilter - returns false if `X` can't match any of a join's cached keys
+// the filter is owned by the join operation, an unset filter accepts all keys
+SIValue AR_JOIN_KEY_FILTER(SIValue *argv, int argc, void *private_data) {
+	const JoinKeyFilter *filter = private_data;
+	return SI_BoolVal(JoinKeyFilter_MayContain(filter, argv[0]));
+}
+
 void Register_ConditionalFuncs() {
 	SIType *types;
 	SIType ret_type = SI_ALL;
@@ -116,5 +124,11 @@ void Register_ConditionalFuncs() {
 	func_desc = AR_FuncDescNew("distinct", AR_DISTINCT, 1, 1, types, ret_type, true, false);
 	AR_SetPrivateDataRoutines(func_desc, Distinct_Free, Distinct_Clone);
 	AR_RegFunc(func_desc);
+
+	types = array_new(SIType, 1);
+	array_append(types, SI_ALL);
+	ret_type = T_BOOL;
+	func_desc = AR_FuncDescNew("join_key_filter", AR_JOIN_KEY_FILTER, 1, 1, types, ret_type, true, false);
+	AR_RegFunc(func_desc);
 }
 
@@ -21,6 +21,7 @@ void AR_RegisterFuncs() {
 	Register_ListFuncs();
 	Register_TimeFuncs();
 	Register_PointFuncs();
+	Register_VectorFuncs();
 	Register_EntityFuncs();
 	Register_StringFuncs();
 	Register_NumericFuncs();
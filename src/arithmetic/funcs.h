@@ -10,6 +10,7 @@
 #include "list_funcs/list_funcs.h"
 #include "time_funcs/time_funcs.h"
 #include "point_funcs/point_funcs.h"
+#include "vector_funcs/vector_funcs.h"
 #include "entity_funcs/entity_funcs.h"
 #include "string_funcs/string_funcs.h"
 #include "aggregate_funcs/agg_funcs.h"
@@ -9,10 +9,7 @@
 #include "../../util/arr.h"
 #include "../../errors/errors.h"
 #include "../../datatypes/map.h"
-#include <math.h>
-
-#define EARTH_RADIUS 6378140.0
-#define DegreeToRadians(d) ((d) * M_PI / 180.0)
+#include "../../datatypes/point.h"
 
 SIValue AR_TOPOINT(SIValue *argv, int argc, void *private_data) {
 	SIValue map = argv[0];
@@ -65,39 +62,28 @@ SIValue AR_TOPOINT(SIValue *argv, int argc, void *private_data) {
 }
 
 SIValue AR_DISTANCE(SIValue *argv, int argc, void *private_data) {
-	// compute distance between two points
-	// a = sin²(Δφ/2) + cos φ1 ⋅ cos φ2 ⋅ sin²(Δλ/2)
-	// c = 2 * atan2( √a, √(1−a) )
-	// d = R * c
-	// where φ represent the latitudes, and λ represent the longitudes
-
 	SIValue p1 = argv[0];
 	SIValue p2 = argv[1];
 
 	// check inputs
 	if(SI_TYPE(p1) == T_NULL || SI_TYPE(p2) == T_NULL) return SI_NullVal();
 
-	float lat[2] = { DegreeToRadians(p1.point.latitude),
-					 DegreeToRadians(p2.point.latitude)
-				   };
-
-	float lon[2] = { DegreeToRadians(p1.point.longitude),
-					 DegreeToRadians(p2.point.longitude)
-				   };
-
-	float dlat = lat[1] - lat[0];
-	float dlon = lon[1] - lon[0];
-
-	// a = sin²(Δφ/2) + cos φ1 ⋅ cos φ2 ⋅ sin²(Δλ/2)
-	float a = pow(sin(dlat / 2), 2) + cos(lat[0]) * cos(lat[1]) * pow(sin(dlon / 2), 2);
+	return SI_DoubleVal(Point_Distance(p1, p2));
+}
 
-	// c = 2 * atan2( √a, √(1−a) )
-	float c = 2 * atan2(sqrt(a), sqrt(1 - a));
+SIValue AR_WITHINBBOX(SIValue *argv, int argc, void *private_data) {
+	SIValue p           = argv[0];
+	SIValue lower_left  = argv[1];
+	SIValue upper_right = argv[2];
 
-	// d = R * c
-	float d = EARTH_RADIUS * c;
+	// check inputs
+	if(SI_TYPE(p)           == T_NULL ||
+	   SI_TYPE(lower_left)  == T_NULL ||
+	   SI_TYPE(upper_right) == T_NULL) {
+		return SI_NullVal();
+	}
 
-	return SI_DoubleVal(d);
+	return SI_BoolVal(Point_WithinBBox(p, lower_left, upper_right));
 }
 
 void Register_PointFuncs() {
@@ -118,4 +104,12 @@ void Register_PointFuncs() {
 	ret_type = T_NULL | T_DOUBLE;
 	func_desc = AR_FuncDescNew("distance", AR_DISTANCE, 2, 2, types, ret_type, false, true);
 	AR_RegFunc(func_desc);
+
+	types = array_new(SIType, 3);
+	array_append(types, T_NULL | T_POINT);
+	array_append(types, T_NULL | T_POINT);
+	array_append(types, T_NULL | T_POINT);
+	ret_type = T_NULL | T_BOOL;
+	func_desc = AR_FuncDescNew("point.withinBBox", AR_WITHINBBOX, 3, 3, types, ret_type, false, true);
+	AR_RegFunc(func_desc);
 }
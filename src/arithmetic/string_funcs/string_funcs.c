@@ -16,10 +16,10 @@
 #include "../../util/json_encoder.h"
 #include "../deps/oniguruma/src/oniguruma.h"
 
-// toString supports only integer, float, string, boolean, point, duration, 
+// toString supports only integer, float, string, boolean, point, vector, duration, 
 // date, time, localtime, localdatetime or datetime values
 // array for backward compatibility
-#define STRINGABLE (SI_NUMERIC | T_ARRAY | T_POINT | T_DURATION | T_DATETIME | T_STRING | T_BOOL)
+#define STRINGABLE (SI_NUMERIC | T_ARRAY | T_POINT | T_VECTOR_F32 | T_DURATION | T_DATETIME | T_STRING | T_BOOL)
 
 // returns a string containing the specified number of leftmost characters of the original string.
 SIValue AR_LEFT(SIValue *argv, int argc, void *private_data) {
@@ -0,0 +1,110 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../func_desc.h"
+#include "../../util/arr.h"
+#include "../../errors/errors.h"
+#include "../../datatypes/array.h"
+#include "../../datatypes/vector.h"
+
+// create a packed float32 vector from a list of numbers
+// vecf32([0.1, 0.2, 0.3])
+SIValue AR_VECF32(SIValue *argv, int argc, void *private_data) {
+	SIValue list = argv[0];
+	if(SI_TYPE(list) == T_NULL) return SI_NullVal();
+
+	ASSERT(SI_TYPE(list) == T_ARRAY);
+
+	uint32_t dim = SIArray_Length(list);
+	SIValue vector = SI_Vectorf32(dim);
+	float *values = SIVector_Elements(vector);
+
+	for(uint32_t i = 0; i < dim; i++) {
+		SIValue elem = SIArray_Get(list, i);
+		if(!(SI_TYPE(elem) & SI_NUMERIC)) {
+			SIValue_Free(vector);
+			ErrorCtx_RaiseRuntimeException(EMSG_MUST_BE, "Vector elements",
+					"numeric");
+			return SI_NullVal();
+		}
+		values[i] = (float)SI_GET_NUMERIC(elem);
+	}
+
+	return vector;
+}
+
+// validate both vectors share the same dimension
+static bool _validate_dimensions
+(
+	SIValue a,
+	SIValue b
+) {
+	uint32_t a_dim = SIVector_Dim(a);
+	uint32_t b_dim = SIVector_Dim(b);
+
+	if(a_dim != b_dim) {
+		ErrorCtx_RaiseRuntimeException(EMSG_VECTOR_DIMENSION_MISMATCH, a_dim,
+				b_dim);
+		return false;
+	}
+
+	return true;
+}
+
+// cosine distance between two vectors
+// vec.cosine(n.embedding, $query)
+SIValue AR_VEC_COSINE(SIValue *argv, int argc, void *private_data) {
+	SIValue a = argv[0];
+	SIValue b = argv[1];
+	if(SI_TYPE(a) == T_NULL || SI_TYPE(b) == T_NULL) return SI_NullVal();
+	if(!_validate_dimensions(a, b)) return SI_NullVal();
+
+	float d = Vector_CosineDistance(SIVector_Elements(a), SIVector_Elements(b),
+			SIVector_Dim(a));
+
+	return SI_DoubleVal(d);
+}
+
+// euclidean distance between two vectors
+// vec.euclidean(n.embedding, $query)
+SIValue AR_VEC_EUCLIDEAN(SIValue *argv, int argc, void *private_data) {
+	SIValue a = argv[0];
+	SIValue b = argv[1];
+	if(SI_TYPE(a) == T_NULL || SI_TYPE(b) == T_NULL) return SI_NullVal();
+	if(!_validate_dimensions(a, b)) return SI_NullVal();
+
+	float d = Vector_EuclideanDistance(SIVector_Elements(a),
+			SIVector_Elements(b), SIVector_Dim(a));
+
+	return SI_DoubleVal(d);
+}
+
+void Register_VectorFuncs() {
+	SIType *types;
+	SIType ret_type;
+	AR_FuncDesc *func_desc;
+
+	types = array_new(SIType, 1);
+	array_append(types, T_NULL | T_ARRAY);
+	ret_type = T_NULL | T_VECTOR_F32;
+	func_desc = AR_FuncDescNew("vecf32", AR_VECF32, 1, 1, types, ret_type, false, true);
+	AR_RegFunc(func_desc);
+
+	types = array_new(SIType, 2);
+	array_append(types, T_NULL | T_VECTOR_F32);
+	array_append(types, T_NULL | T_VECTOR_F32);
+	ret_type = T_NULL | T_DOUBLE;
+	func_desc = AR_FuncDescNew("vec.cosine", AR_VEC_COSINE, 2, 2, types, ret_type, false, true);
+	AR_RegFunc(func_desc);
+
+	types = array_new(SIType, 2);
+	array_append(types, T_NULL | T_VECTOR_F32);
+	array_append(types, T_NULL | T_VECTOR_F32);
+	ret_type = T_NULL | T_DOUBLE;
+	func_desc = AR_FuncDescNew("vec.euclidean", AR_VEC_EUCLIDEAN, 2, 2, types, ret_type, false, true);
+	AR_RegFunc(func_desc);
+}
@@ -404,6 +404,7 @@ AST *AST_Build
 	ast->parse_result        = parse_result;
 	ast->referenced_entities = NULL;
 	ast->params_parse_result = NULL;
+	ast->query               = NULL;
 	ast->anot_ctx_collection = AST_AnnotationCtxCollection_New();
 
 	*(ast->ref_count) = 1;
@@ -441,6 +442,7 @@ AST *AST_NewSegment
 	ast->ref_count           = rm_malloc(sizeof(uint));
 	ast->parse_result        = NULL;
 	ast->params_parse_result = NULL;
+	ast->query               = NULL;
 	ast->referenced_entities = NULL;
 	ast->anot_ctx_collection = master_ast->anot_ctx_collection;
 
@@ -488,6 +490,16 @@ void AST_SetParamsParseResult
 	ast->params_parse_result = params_parse_result;
 }
 
+void AST_SetQueryText
+(
+	AST *ast,
+	char *query
+) {
+	// setting query text within an AST should only occur once
+	ASSERT(ast->query == NULL);
+	ast->query = query;
+}
+
 AST *AST_ShallowCopy
 (
 	AST *orig
@@ -850,6 +862,7 @@ void AST_Free
 		}
 
 		if(ast->referenced_entities) raxFree(ast->referenced_entities);
+		if(ast->query) rm_free(ast->query);
 
 		rm_free(ast->ref_count);
 	}
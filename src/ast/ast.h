@@ -28,6 +28,7 @@ typedef struct {
 	uint *ref_count;                                    // A pointer to reference counter (for deletion).
 	cypher_parse_result_t *parse_result;                // Query parsing output.
 	cypher_parse_result_t *params_parse_result;         // Parameters parsing output.
+	char *query;                                        // Owned query text, NULL if not owned.
 } AST;
 
 // checks to see if libcypher-parser reported any errors
@@ -167,6 +168,14 @@ void AST_SetParamsParseResult
 	cypher_parse_result_t *params_parse_result
 );
 
+// hands the query text the ast was parsed from over to the ast
+// AST nodes are named after their text, which must outlive all ast copies
+void AST_SetQueryText
+(
+	AST *ast,
+	char *query
+);
+
 // returns a shallow copy of the original AST pointer with ref counter increased
 AST *AST_ShallowCopy
 (
@@ -0,0 +1,355 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "ast_parameterize.h"
+#include "RG.h"
+#include "../value.h"
+#include "../query_ctx.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+// longest numeric literal we're willing to parameterize
+#define MAX_NUMERIC_LITERAL_LEN 64
+
+// query scanner
+typedef struct {
+	const char *p;      // current position within query
+	char *out;          // normalized query
+	size_t len;         // normalized query length
+	size_t cap;         // normalized query capacity
+	SIValue *values;    // extracted literals
+	char prev;          // last non white space character consumed
+	bool after_range;   // last token is either '*' or '..'
+	bool suppress;      // within RETURN, SKIP or LIMIT, literals are kept
+} Scanner;
+
+static void _Scanner_Append
+(
+	Scanner *s,
+	const char *str,
+	size_t len
+) {
+	if(s->len + len + 1 > s->cap) {
+		while(s->len + len + 1 > s->cap) s->cap *= 2;
+		s->out = rm_realloc(s->out, s->cap);
+	}
+
+	memcpy(s->out + s->len, str, len);
+	s->len += len;
+}
+
+// copy query text up to 'end' as is
+static void _Scanner_Copy
+(
+	Scanner *s,
+	const char *end
+) {
+	_Scanner_Append(s, s->p, end - s->p);
+	s->p = end;
+}
+
+// replace the literal ending at 'end' with a parameter
+static void _Scanner_EmitParam
+(
+	Scanner *s,
+	const char *end,
+	SIValue v
+) {
+	char name[32];
+	int n = snprintf(name, sizeof(name), "$" AST_AUTO_PARAM_PREFIX "%u",
+			array_len(s->values));
+
+	_Scanner_Append(s, name, n);
+	array_append(s->values, v);
+	s->p = end;
+}
+
+static inline bool _IsIdentifierChar
+(
+	char c
+) {
+	return isalnum((unsigned char)c) || c == '_' || (unsigned char)c >= 0x80;
+}
+
+// keywords opening a clause, ending RETURN, SKIP and LIMIT suppression
+static bool _IsClauseKeyword
+(
+	const char *word,
+	size_t len
+) {
+	static const char *keywords[] = {"MATCH", "OPTIONAL", "WITH", "UNWIND",
+		"CREATE", "MERGE", "DELETE", "DETACH", "SET", "REMOVE", "CALL",
+		"FOREACH", "UNION", "ORDER"};
+
+	for(int i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++) {
+		if(strlen(keywords[i]) == len &&
+		   strncasecmp(word, keywords[i], len) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool _IsKeyword
+(
+	const char *word,
+	size_t len,
+	const char *keyword
+) {
+	return strlen(keyword) == len && strncasecmp(word, keyword, len) == 0;
+}
+
+static void _Scanner_Identifier
+(
+	Scanner *s
+) {
+	const char *start = s->p;
+	const char *end   = start;
+	while(_IsIdentifierChar(*end)) end++;
+	size_t len = end - start;
+
+	// property keys, labels and map keys aren't keywords
+	const char *next = end;
+	while(isspace((unsigned char)*next)) next++;
+	bool keyword = s->prev != '.' && s->prev != ':' && *next != ':';
+
+	if(keyword) {
+		if(_IsKeyword(start, len, "RETURN") ||
+		   _IsKeyword(start, len, "SKIP")   ||
+		   _IsKeyword(start, len, "LIMIT")) {
+			s->suppress = true;
+		} else if(_IsClauseKeyword(start, len)) {
+			s->suppress = false;
+		}
+	}
+
+	_Scanner_Copy(s, end);
+}
+
+static void _Scanner_Number
+(
+	Scanner *s
+) {
+	const char *start = s->p;
+	const char *end   = start;
+	bool is_float     = false;
+
+	while(isdigit((unsigned char)*end)) end++;
+
+	// fraction, note '1..3' is a range
+	if(end[0] == '.' && isdigit((unsigned char)end[1])) {
+		is_float = true;
+		end++;
+		while(isdigit((unsigned char)*end)) end++;
+	}
+
+	// exponent
+	if((end[0] == 'e' || end[0] == 'E') &&
+	   (isdigit((unsigned char)end[1]) ||
+		((end[1] == '+' || end[1] == '-') && isdigit((unsigned char)end[2])))) {
+		is_float = true;
+		end += 2;
+		while(isdigit((unsigned char)*end)) end++;
+	}
+
+	size_t len = end - start;
+
+	// keep literal as is when:
+	// 1. literals are suppressed
+	// 2. literal is a variable length range bound e.g. [*1..3]
+	// 3. literal is followed by an identifier char e.g. 0x1F
+	// 4. literal is the fraction part of .5
+	// 5. literal is an octal integer e.g. 017
+	// 6. literal is too long
+	bool keep = s->suppress                                 ||
+		s->after_range                                      ||
+		_IsIdentifierChar(*end)                             ||
+		s->prev == '.'                                      ||
+		(!is_float && start[0] == '0' && len > 1)           ||
+		len >= MAX_NUMERIC_LITERAL_LEN;
+
+	if(!keep) {
+		char buf[MAX_NUMERIC_LITERAL_LEN];
+		memcpy(buf, start, len);
+		buf[len] = '\0';
+
+		SIValue v;
+		errno = 0;
+		if(is_float) {
+			v = SI_DoubleVal(strtod(buf, NULL));
+		} else {
+			v = SI_LongVal(strtoll(buf, NULL, 10));
+		}
+
+		// overflow is reported by the parser
+		if(errno != ERANGE) {
+			_Scanner_EmitParam(s, end, v);
+			return;
+		}
+	}
+
+	_Scanner_Copy(s, end);
+}
+
+static void _Scanner_String
+(
+	Scanner *s
+) {
+	const char *start = s->p;
+	const char *end   = start + 1;
+	char quote        = *start;
+	bool escaped      = false;
+
+	while(*end != '\0' && *end != quote) {
+		if(*end == '\\') {
+			escaped = true;
+			if(end[1] != '\0') end++;
+		}
+		end++;
+	}
+
+	// unterminated strings are reported by the parser
+	bool terminated = (*end == quote);
+	if(terminated) end++;
+
+	// escape sequences are left for the parser to decode
+	if(s->suppress || escaped || !terminated) {
+		_Scanner_Copy(s, end);
+		return;
+	}
+
+	char *str = rm_strndup(start + 1, end - start - 2);
+	_Scanner_EmitParam(s, end, SI_TransferStringVal(str));
+}
+
+// copy a comment or a quoted identifier as is
+static void _Scanner_SkipUntil
+(
+	Scanner *s,
+	size_t skip,           // number of opening chars
+	const char *closing    // closing sequence
+) {
+	const char *end = strstr(s->p + skip, closing);
+	end = (end == NULL) ? s->p + strlen(s->p) : end + strlen(closing);
+	_Scanner_Copy(s, end);
+}
+
+// add extracted literals to the query parameters
+// returns false if a literal's name is already in use
+static bool _AddParams
+(
+	SIValue *values
+) {
+	rax *params = QueryCtx_GetParams();
+	uint n = array_len(values);
+	char name[32];
+
+	// make sure none of the synthetic names is used by the caller
+	if(params != NULL) {
+		for(uint i = 0; i < n; i++) {
+			int len = snprintf(name, sizeof(name), AST_AUTO_PARAM_PREFIX "%u", i);
+			if(raxFind(params, (unsigned char *)name, len) != raxNotFound) {
+				return false;
+			}
+		}
+	} else {
+		params = raxNew();
+		QueryCtx_SetParams(params);
+	}
+
+	for(uint i = 0; i < n; i++) {
+		int len = snprintf(name, sizeof(name), AST_AUTO_PARAM_PREFIX "%u", i);
+		SIValue *v = rm_malloc(sizeof(SIValue));
+		*v = values[i];
+		raxInsert(params, (unsigned char *)name, len, v, NULL);
+	}
+
+	return true;
+}
+
+char *AST_ParameterizeLiterals
+(
+	const char *query  // query string, excluding CYPHER parameters prefix
+) {
+	ASSERT(query != NULL);
+
+	size_t len = strlen(query);
+	Scanner s = {
+		.p           = query,
+		.len         = 0,
+		.cap         = len + 64,
+		.prev        = '\0',
+		.values      = array_new(SIValue, 0),
+		.suppress    = false,
+		.after_range = false
+	};
+	s.out = rm_malloc(s.cap);
+
+	while(*s.p != '\0') {
+		char c = *s.p;
+
+		if(isspace((unsigned char)c)) {
+			_Scanner_Copy(&s, s.p + 1);
+			continue;
+		}
+
+		bool after_range = false;
+
+		if(c == '/' && s.p[1] == '/') {
+			_Scanner_SkipUntil(&s, 2, "\n");
+			continue;
+		} else if(c == '/' && s.p[1] == '*') {
+			_Scanner_SkipUntil(&s, 2, "*/");
+			continue;
+		} else if(c == '`') {
+			_Scanner_SkipUntil(&s, 1, "`");
+		} else if(c == '\'' || c == '"') {
+			_Scanner_String(&s);
+		} else if(isdigit((unsigned char)c)) {
+			_Scanner_Number(&s);
+		} else if(_IsIdentifierChar(c)) {
+			_Scanner_Identifier(&s);
+		} else if(c == '$') {
+			// parameter, skip its name
+			const char *end = s.p + 1;
+			if(*end == '`') {
+				end = strchr(end + 1, '`');
+				end = (end == NULL) ? s.p + strlen(s.p) : end + 1;
+			} else {
+				while(_IsIdentifierChar(*end)) end++;
+			}
+			_Scanner_Copy(&s, end);
+		} else if(c == '.' && s.p[1] == '.') {
+			after_range = true;
+			_Scanner_Copy(&s, s.p + 2);
+		} else {
+			after_range = (c == '*');
+			_Scanner_Copy(&s, s.p + 1);
+		}
+
+		s.prev        = s.out[s.len - 1];
+		s.after_range = after_range;
+	}
+
+	uint n = array_len(s.values);
+	if(n == 0 || !_AddParams(s.values)) {
+		for(uint i = 0; i < n; i++) SIValue_Free(s.values[i]);
+		array_free(s.values);
+		rm_free(s.out);
+		return NULL;
+	}
+
+	array_free(s.values);
+	s.out[s.len] = '\0';
+	return s.out;
+}
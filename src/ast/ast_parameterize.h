@@ -0,0 +1,28 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+// prefix of the synthetic parameters introduced by auto-parameterization
+#define AST_AUTO_PARAM_PREFIX "__lit"
+
+// replace literals within query with synthetic parameters
+// e.g. MATCH (n {id: 17}) RETURN n
+// is normalized to:
+// MATCH (n {id: $__lit0}) RETURN n
+// and the parameter __lit0 = 17 is added to the query context parameters
+//
+// literals which affect the query's execution plan or result-set layout
+// are kept as is:
+// SKIP and LIMIT values, variable length traversal ranges
+// and RETURN projections (whose text names unaliased result columns)
+//
+// returns a normalized copy of query, caller is responsible for freeing it
+// returns NULL if no literal was replaced
+char *AST_ParameterizeLiterals
+(
+	const char *query  // query string, excluding CYPHER parameters prefix
+);
@@ -0,0 +1,654 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "ast_params_parser.h"
+#include "RG.h"
+#include "../value.h"
+#include "../query_ctx.h"
+#include "../datatypes/map.h"
+#include "../datatypes/array.h"
+#include "../util/rmalloc.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+// maximum nesting depth of lists and maps
+#define MAX_NESTING_DEPTH 32
+
+// longest numeric literal we're willing to decode
+#define MAX_NUMERIC_LITERAL_LEN 64
+
+static bool _ParseValue(const char **p, int depth, SIValue *v);
+
+static inline void _SkipSpaces
+(
+	const char **p
+) {
+	while(isspace((unsigned char)**p)) (*p)++;
+}
+
+// returns length of the identifier starting at p, 0 if p isn't an identifier
+// quoted and non ASCII identifiers are left for the cypher parser
+static size_t _IdentifierLen
+(
+	const char *p
+) {
+	if(!isalpha((unsigned char)*p) && *p != '_') return 0;
+
+	const char *end = p + 1;
+	while(isalnum((unsigned char)*end) || *end == '_') end++;
+
+	return end - p;
+}
+
+// checks if p starts with keyword, not followed by an identifier char
+static bool _IsKeyword
+(
+	const char *p,
+	const char *keyword
+) {
+	size_t len = strlen(keyword);
+	return strncasecmp(p, keyword, len) == 0 && _IdentifierLen(p) == len;
+}
+
+static bool _ParseNumber
+(
+	const char **p,
+	SIValue *v
+) {
+	const char *start = *p;
+	const char *end   = start;
+	bool negative     = false;
+	bool is_float     = false;
+
+	if(*end == '-') {
+		negative = true;
+		start++;
+		end++;
+	}
+
+	while(isdigit((unsigned char)*end)) end++;
+
+	// fraction
+	if(end[0] == '.' && isdigit((unsigned char)end[1])) {
+		is_float = true;
+		end++;
+		while(isdigit((unsigned char)*end)) end++;
+	}
+
+	// exponent
+	if((end[0] == 'e' || end[0] == 'E') &&
+	   (isdigit((unsigned char)end[1]) ||
+		((end[1] == '+' || end[1] == '-') && isdigit((unsigned char)end[2])))) {
+		is_float = true;
+		end += 2;
+		while(isdigit((unsigned char)*end)) end++;
+	}
+
+	size_t len = end - start;
+
+	// octal and hexadecimal integers are left for the cypher parser
+	if(len == 0 || len >= MAX_NUMERIC_LITERAL_LEN ||
+	   (!is_float && start[0] == '0' && len > 1)) {
+		return false;
+	}
+
+	char buf[MAX_NUMERIC_LITERAL_LEN];
+	memcpy(buf, start, len);
+	buf[len] = '\0';
+
+	// the sign is applied after conversion, same as the unary minus operator
+	errno = 0;
+	if(is_float) {
+		double d = strtod(buf, NULL);
+		*v = SI_DoubleVal(negative ? -d : d);
+	} else {
+		int64_t i = strtoll(buf, NULL, 10);
+		*v = SI_LongVal(negative ? -i : i);
+	}
+
+	// overflow is reported by the cypher parser
+	if(errno == ERANGE) return false;
+
+	*p = end;
+	return true;
+}
+
+static bool _ParseString
+(
+	const char **p,
+	SIValue *v
+) {
+	const char *start = *p + 1;
+	const char *end   = start;
+	char quote        = **p;
+
+	// locate closing quote, validating escape sequences
+	while(*end != quote) {
+		if(*end == '\0') return false;  // unterminated string
+		if(*end == '\\') {
+			end++;
+			// unicode escape sequences are left for the cypher parser
+			if(*end == '\0' || strchr("\\'\"nrtbf", *end) == NULL) {
+				return false;
+			}
+		}
+		end++;
+	}
+
+	// decode string, escape sequences only shorten it
+	char *str = rm_malloc(end - start + 1);
+	char *out = str;
+	for(const char *c = start; c < end; c++) {
+		if(*c != '\\') {
+			*out++ = *c;
+			continue;
+		}
+
+		c++;
+		switch(*c) {
+			case 'n':
+				*out++ = '\n';
+				break;
+			case 'r':
+				*out++ = '\r';
+				break;
+			case 't':
+				*out++ = '\t';
+				break;
+			case 'b':
+				*out++ = '\b';
+				break;
+			case 'f':
+				*out++ = '\f';
+				break;
+			default:
+				*out++ = *c;
+				break;
+		}
+	}
+	*out = '\0';
+
+	*v = SI_TransferStringVal(str);
+	*p = end + 1;
+	return true;
+}
+
+static bool _ParseList
+(
+	const char **p,
+	int depth,
+	SIValue *v
+) {
+	const char *c = *p + 1;
+	SIValue list  = SIArray_New(0);
+
+	_SkipSpaces(&c);
+	if(*c == ']') goto done;
+
+	while(true) {
+		SIValue elem;
+		if(!_ParseValue(&c, depth + 1, &elem)) goto error;
+
+		// list takes ownership over element
+		SIArray_AppendAsOwner(&list, &elem);
+
+		_SkipSpaces(&c);
+		if(*c == ']') break;
+		if(*c != ',') goto error;
+
+		c++;
+		_SkipSpaces(&c);
+	}
+
+done:
+	*v = list;
+	*p = c + 1;
+	return true;
+
+error:
+	SIValue_Free(list);
+	return false;
+}
+
+static bool _ParseMap
+(
+	const char **p,
+	int depth,
+	SIValue *v
+) {
+	const char *c = *p + 1;
+	SIValue map   = Map_New(0);
+
+	_SkipSpaces(&c);
+	if(*c == '}') goto done;
+
+	while(true) {
+		size_t len = _IdentifierLen(c);
+		if(len == 0) goto error;
+
+		SIValue key = SI_TransferStringVal(rm_strndup(c, len));
+		c += len;
+
+		// duplicated keys are left for the cypher parser
+		_SkipSpaces(&c);
+		if(*c != ':' || Map_Contains(map, key)) {
+			SIValue_Free(key);
+			goto error;
+		}
+
+		c++;
+		_SkipSpaces(&c);
+
+		SIValue val;
+		if(!_ParseValue(&c, depth + 1, &val)) {
+			SIValue_Free(key);
+			goto error;
+		}
+
+		// map takes ownership over both key and value
+		Map_AddNoClone(&map, key, val);
+
+		_SkipSpaces(&c);
+		if(*c == '}') break;
+		if(*c != ',') goto error;
+
+		c++;
+		_SkipSpaces(&c);
+	}
+
+done:
+	*v = map;
+	*p = c + 1;
+	return true;
+
+error:
+	SIValue_Free(map);
+	return false;
+}
+
+// parse a single literal value starting at p
+// on success advances p past the value
+static bool _ParseValue
+(
+	const char **p,
+	int depth,
+	SIValue *v
+) {
+	const char *c = *p;
+
+	if(depth > MAX_NESTING_DEPTH) return false;
+
+	if(*c == '\'' || *c == '"') return _ParseString(p, v);
+	if(*c == '[') return _ParseList(p, depth, v);
+	if(*c == '{') return _ParseMap(p, depth, v);
+
+	if(isdigit((unsigned char)*c) ||
+	   (*c == '-' && isdigit((unsigned char)c[1]))) {
+		return _ParseNumber(p, v);
+	}
+
+	if(_IsKeyword(c, "null")) {
+		*v = SI_NullVal();
+		*p = c + 4;
+		return true;
+	}
+
+	if(_IsKeyword(c, "true")) {
+		*v = SI_BoolVal(true);
+		*p = c + 4;
+		return true;
+	}
+
+	if(_IsKeyword(c, "false")) {
+		*v = SI_BoolVal(false);
+		*p = c + 5;
+		return true;
+	}
+
+	// expressions, function calls, parameters etc.
+	return false;
+}
+
+static void _ParamFree
+(
+	void *v
+) {
+	SIValue_Free(*(SIValue *)v);
+	rm_free(v);
+}
+
+bool AST_FastParseParams
+(
+	const char *query,
+	const char **query_body
+) {
+	ASSERT(query      != NULL);
+	ASSERT(query_body != NULL);
+
+	rax *params   = NULL;
+	const char *p = query;
+
+	_SkipSpaces(&p);
+
+	// CYPHER name=value name=value ...
+	while(_IsKeyword(p, "CYPHER")) {
+		p += 6;
+		_SkipSpaces(&p);
+
+		while(true) {
+			const char *name = p;
+			size_t len       = _IdentifierLen(name);
+			if(len == 0) break;
+
+			// not a parameter, query body starts here
+			const char *c = name + len;
+			_SkipSpaces(&c);
+			if(*c != '=') break;
+
+			c++;
+			_SkipSpaces(&c);
+
+			SIValue v;
+			if(!_ParseValue(&c, 0, &v)) goto error;
+
+			// value must be followed by either white space or end of query
+			if(*c != '\0' && !isspace((unsigned char)*c)) {
+				SIValue_Free(v);
+				goto error;
+			}
+
+			if(params == NULL) params = raxNew();
+
+			SIValue *param = rm_malloc(sizeof(SIValue));
+			*param = v;
+
+			// duplicated parameters are reported by the cypher parser
+			if(!raxTryInsert(params, (unsigned char *)name, len, param, NULL)) {
+				_ParamFree(param);
+				goto error;
+			}
+
+			p = c;
+			_SkipSpaces(&p);
+		}
+	}
+
+	// query body must start with a clause, anything else
+	// e.g. comments, version numbers, EXPLAIN or multiple statements
+	// is left for the cypher parser
+	if((*p != '\0' && !isalpha((unsigned char)*p)) ||
+	   _IsKeyword(p, "EXPLAIN") || _IsKeyword(p, "PROFILE") ||
+	   strchr(p, ';') != NULL) {
+		goto error;
+	}
+
+	if(params != NULL) QueryCtx_SetParams(params);
+	*query_body = p;
+	return true;
+
+error:
+	if(params != NULL) raxFreeWithCallback(params, _ParamFree);
+	return false;
+}
+
+//------------------------------------------------------------------------------
+// binary parameters
+//------------------------------------------------------------------------------
+
+// binary value tags
+typedef enum {
+	BIN_PARAM_NULL   = 0,
+	BIN_PARAM_BOOL   = 1,
+	BIN_PARAM_INT    = 2,
+	BIN_PARAM_DOUBLE = 3,
+	BIN_PARAM_STRING = 4,
+	BIN_PARAM_LIST   = 5,
+	BIN_PARAM_MAP    = 6,
+} BinaryParamTag;
+
+// bounded reader over an encoded buffer
+typedef struct {
+	const unsigned char *p;    // current position
+	const unsigned char *end;  // end of buffer
+} BinaryReader;
+
+static bool _DecodeValue(BinaryReader *r, int depth, SIValue *v);
+
+static inline bool _ReadU8
+(
+	BinaryReader *r,
+	uint8_t *v
+) {
+	if(r->end - r->p < 1) return false;
+	*v = *r->p++;
+	return true;
+}
+
+static inline bool _ReadU32
+(
+	BinaryReader *r,
+	uint32_t *v
+) {
+	if(r->end - r->p < 4) return false;
+	*v = 0;
+	for(int i = 3; i >= 0; i--) *v = (*v << 8) | r->p[i];
+	r->p += 4;
+	return true;
+}
+
+static inline bool _ReadU64
+(
+	BinaryReader *r,
+	uint64_t *v
+) {
+	if(r->end - r->p < 8) return false;
+	*v = 0;
+	for(int i = 7; i >= 0; i--) *v = (*v << 8) | r->p[i];
+	r->p += 8;
+	return true;
+}
+
+// read a length prefixed string
+// strings are NULL terminated, embedded NULL bytes are rejected
+static bool _ReadString
+(
+	BinaryReader *r,
+	char **s,
+	uint32_t *len
+) {
+	if(!_ReadU32(r, len)) return false;
+	if((size_t)(r->end - r->p) < *len) return false;
+	if(memchr(r->p, '\0', *len) != NULL) return false;
+
+	*s = rm_strndup((const char *)r->p, *len);
+	r->p += *len;
+	return true;
+}
+
+static bool _DecodeList
+(
+	BinaryReader *r,
+	int depth,
+	SIValue *v
+) {
+	uint32_t n;
+	if(!_ReadU32(r, &n)) return false;
+
+	// every element takes at least a byte, don't trust count blindly
+	if((size_t)(r->end - r->p) < n) return false;
+
+	SIValue list = SIArray_New(n);
+	for(uint32_t i = 0; i < n; i++) {
+		SIValue elem;
+		if(!_DecodeValue(r, depth + 1, &elem)) {
+			SIValue_Free(list);
+			return false;
+		}
+
+		// list takes ownership over element
+		SIArray_AppendAsOwner(&list, &elem);
+	}
+
+	*v = list;
+	return true;
+}
+
+static bool _DecodeMap
+(
+	BinaryReader *r,
+	int depth,
+	SIValue *v
+) {
+	uint32_t n;
+	if(!_ReadU32(r, &n)) return false;
+
+	// every entry takes at least 5 bytes
+	if((size_t)(r->end - r->p) / 5 < n) return false;
+
+	SIValue map = Map_New(n);
+	for(uint32_t i = 0; i < n; i++) {
+		char *k;
+		uint32_t len;
+		if(!_ReadString(r, &k, &len)) goto error;
+
+		SIValue key = SI_TransferStringVal(k);
+		if(Map_Contains(map, key)) {
+			SIValue_Free(key);
+			goto error;
+		}
+
+		SIValue val;
+		if(!_DecodeValue(r, depth + 1, &val)) {
+			SIValue_Free(key);
+			goto error;
+		}
+
+		// map takes ownership over both key and value
+		Map_AddNoClone(&map, key, val);
+	}
+
+	*v = map;
+	return true;
+
+error:
+	SIValue_Free(map);
+	return false;
+}
+
+static bool _DecodeValue
+(
+	BinaryReader *r,
+	int depth,
+	SIValue *v
+) {
+	if(depth > MAX_NESTING_DEPTH) return false;
+
+	uint8_t tag;
+	if(!_ReadU8(r, &tag)) return false;
+
+	switch(tag) {
+		case BIN_PARAM_NULL:
+			*v = SI_NullVal();
+			return true;
+
+		case BIN_PARAM_BOOL: {
+			uint8_t b;
+			if(!_ReadU8(r, &b)) return false;
+			*v = SI_BoolVal(b != 0);
+			return true;
+		}
+
+		case BIN_PARAM_INT: {
+			uint64_t i;
+			if(!_ReadU64(r, &i)) return false;
+			*v = SI_LongVal((int64_t)i);
+			return true;
+		}
+
+		case BIN_PARAM_DOUBLE: {
+			uint64_t bits;
+			if(!_ReadU64(r, &bits)) return false;
+			double d;
+			memcpy(&d, &bits, sizeof(double));
+			*v = SI_DoubleVal(d);
+			return true;
+		}
+
+		case BIN_PARAM_STRING: {
+			char *s;
+			uint32_t len;
+			if(!_ReadString(r, &s, &len)) return false;
+			*v = SI_TransferStringVal(s);
+			return true;
+		}
+
+		case BIN_PARAM_LIST:
+			return _DecodeList(r, depth, v);
+
+		case BIN_PARAM_MAP:
+			return _DecodeMap(r, depth, v);
+
+		default:
+			return false;
+	}
+}
+
+bool AST_DecodeBinaryParams
+(
+	const char *buf,
+	size_t len
+) {
+	ASSERT(buf != NULL || len == 0);
+
+	if(len == 0) return true;
+
+	rax *params    = raxNew();
+	BinaryReader r = {
+		.p   = (const unsigned char *)buf,
+		.end = (const unsigned char *)buf + len
+	};
+
+	uint32_t n;
+	if(!_ReadU32(&r, &n)) goto error;
+
+	for(uint32_t i = 0; i < n; i++) {
+		char *name;
+		uint32_t name_len;
+		if(!_ReadString(&r, &name, &name_len)) goto error;
+
+		SIValue v;
+		if(name_len == 0 || !_DecodeValue(&r, 0, &v)) {
+			rm_free(name);
+			goto error;
+		}
+
+		SIValue *param = rm_malloc(sizeof(SIValue));
+		*param = v;
+
+		bool inserted = raxTryInsert(params, (unsigned char *)name, name_len,
+				param, NULL);
+		rm_free(name);
+
+		if(!inserted) {
+			_ParamFree(param);
+			goto error;
+		}
+	}
+
+	// trailing bytes
+	if(r.p != r.end) goto error;
+
+	QueryCtx_SetParams(params);
+	return true;
+
+error:
+	raxFreeWithCallback(params, _ParamFree);
+	return false;
+}
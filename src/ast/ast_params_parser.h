@@ -0,0 +1,51 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// parse query parameters without invoking the cypher parser
+// handles a 'CYPHER name=value ...' prefix in which every value is a literal:
+// null, booleans, decimal integers, floats, strings, lists and maps
+// values are decoded directly into SIValues
+//
+// on success returns true, sets 'query_body' to point at the query string
+// following the parameters and sets the query context parameters
+//
+// returns false without modifying the query context if the prefix
+// requires the cypher parser e.g. value is an expression or contains
+// a unicode escape sequence, in which case parse_params should be used
+bool AST_FastParseParams
+(
+	const char *query,       // query string, including parameters prefix
+	const char **query_body  // [output] query string excluding parameters
+);
+
+// decode binary encoded query parameters and set them on the query context
+// used by prepared statements, sparing parameters text parsing altogether
+//
+// encoding, all integers are little-endian:
+// params := count:u32 (name value){count}
+// name   := len:u32 byte{len}
+// value  := tag:u8 payload
+//   0 null     -
+//   1 boolean  u8, 0 is false
+//   2 integer  i64
+//   3 float    f64
+//   4 string   len:u32 byte{len}
+//   5 list     count:u32 value{count}
+//   6 map      count:u32 (name value){count}
+//
+// an empty buffer encodes no parameters
+// returns false without modifying the query context if 'buf' is malformed
+bool AST_DecodeBinaryParams
+(
+	const char *buf,  // encoded parameters
+	size_t len        // buffer length
+);
@@ -0,0 +1,153 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "cache_warmup.h"
+#include "execution_ctx.h"
+#include "../query_ctx.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../errors/errors.h"
+#include "../util/thpool/pools.h"
+
+// warm-up task
+typedef struct {
+	GraphContext *gc;        // graph to warm up
+	CacheKeyStats *queries;  // queries to plan, hottest first
+} CacheWarmupTask;
+
+// warm-ups waiting for loading to end
+// only accessed by Redis main thread
+static CacheWarmupTask *pending = NULL;
+
+static void _CacheWarmup_FreeQueries
+(
+	CacheKeyStats *queries
+) {
+	for(uint i = 0; i < array_len(queries); i++) rm_free(queries[i].key);
+	array_free(queries);
+}
+
+char *CacheWarmup_Query
+(
+	GraphContext *gc,
+	const char *query
+) {
+	ASSERT(gc    != NULL);
+	ASSERT(query != NULL);
+
+	// each query gets a fresh query context
+	// auto-parameterization registers the query's literals as parameters
+	QueryCtx_SetGraphCtx(gc);
+
+	char *err = NULL;
+	if(!ExecutionCtx_Warm(query)) {
+		err = ErrorCtx_DetachError();
+		// make sure failures are always reported
+		if(err == NULL) err = strdup(EMSG_COULD_NOT_PARSE_QUERY);
+	}
+
+	QueryCtx_Free();
+	ErrorCtx_Clear();
+
+	return err;
+}
+
+static void _CacheWarmup_Run
+(
+	void *args
+) {
+	CacheWarmupTask *task  = (CacheWarmupTask *)args;
+	GraphContext    *gc    = task->gc;
+	Cache           *cache = GraphContext_GetCache(gc);
+
+	// plan the coldest queries first
+	// such that the hottest queries end up being the most recently used
+	uint n = array_len(task->queries);
+	for(int i = n - 1; i >= 0; i--) {
+		CacheKeyStats *q = task->queries + i;
+
+		char *err = CacheWarmup_Query(gc, q->key);
+		if(err != NULL) {
+			// query is no longer valid, e.g. a procedure is missing
+			free(err);
+		} else {
+			Cache_SetHits(cache, q->key, q->hits);
+		}
+
+		rm_free(q->key);
+	}
+
+	array_free(task->queries);
+	GraphContext_DecreaseRefCount(gc);
+	rm_free(task);
+}
+
+void CacheWarmup_Schedule
+(
+	GraphContext *gc,
+	CacheKeyStats *queries
+) {
+	ASSERT(gc      != NULL);
+	ASSERT(queries != NULL);
+
+	// the task holds a reference to the graph
+	GraphContext_IncreaseRefCount(gc);
+
+	CacheWarmupTask *task = rm_malloc(sizeof(CacheWarmupTask));
+	task->gc      = gc;
+	task->queries = queries;
+
+	// warm-up isn't essential, drop it if the readers queue is full
+	if(ThreadPools_AddWorkReader(_CacheWarmup_Run, task, false) != 0) {
+		_CacheWarmup_FreeQueries(queries);
+		GraphContext_DecreaseRefCount(gc);
+		rm_free(task);
+	}
+}
+
+void CacheWarmup_Defer
+(
+	GraphContext *gc,
+	CacheKeyStats *queries
+) {
+	ASSERT(gc      != NULL);
+	ASSERT(queries != NULL);
+
+	if(pending == NULL) pending = array_new(CacheWarmupTask, 1);
+
+	// the pending task holds a reference to the graph
+	GraphContext_IncreaseRefCount(gc);
+
+	CacheWarmupTask task = {.gc = gc, .queries = queries};
+	array_append(pending, task);
+}
+
+void CacheWarmup_SchedulePending(void) {
+	if(pending == NULL) return;
+
+	uint n = array_len(pending);
+	for(uint i = 0; i < n; i++) {
+		CacheWarmup_Schedule(pending[i].gc, pending[i].queries);
+		GraphContext_DecreaseRefCount(pending[i].gc);
+	}
+
+	array_free(pending);
+	pending = NULL;
+}
+
+void CacheWarmup_DiscardPending(void) {
+	if(pending == NULL) return;
+
+	uint n = array_len(pending);
+	for(uint i = 0; i < n; i++) {
+		_CacheWarmup_FreeQueries(pending[i].queries);
+		GraphContext_DecreaseRefCount(pending[i].gc);
+	}
+
+	array_free(pending);
+	pending = NULL;
+}
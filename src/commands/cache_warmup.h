@@ -0,0 +1,50 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../util/cache/cache.h"
+#include "../graph/graphcontext.h"
+
+// execution plans cache warm-up
+//
+// queries are planned ahead of their execution such that their plans are
+// already cached by the time they're issued, e.g. once a graph is loaded from
+// RDB the hottest queries of the previous incarnation are planned again
+//
+// warming a query doesn't affect the cache's hit and miss statistics
+
+// plan query on the calling thread, caching its execution plan
+// returns NULL on success, otherwise an error message owned by the caller
+char *CacheWarmup_Query
+(
+	GraphContext *gc,  // graph to plan query against
+	const char *query  // query to plan
+);
+
+// plan queries on a reader thread
+// once a query is cached its number of hits is restored
+// takes ownership over 'queries' (arr.h array) and its keys
+void CacheWarmup_Schedule
+(
+	GraphContext *gc,       // graph to warm up
+	CacheKeyStats *queries  // queries to plan, hottest first
+);
+
+// queue queries for warm-up once the server finishes loading
+// the keyspace is still being loaded, e.g. while decoding an RDB aux field
+// takes ownership over 'queries' (arr.h array) and its keys
+void CacheWarmup_Defer
+(
+	GraphContext *gc,       // graph to warm up
+	CacheKeyStats *queries  // queries to plan, hottest first
+);
+
+// schedule all queued warm-ups, invoked once loading ended
+void CacheWarmup_SchedulePending(void);
+
+// drop all queued warm-ups, invoked once loading failed
+void CacheWarmup_DiscardPending(void);
@@ -0,0 +1,127 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "cache_warmup.h"
+#include "../util/arr.h"
+#include "../redismodule.h"
+#include "../util/rmalloc.h"
+#include "../graph/graphcontext.h"
+
+// reply with the cache statistics and the cached queries, hottest first
+static void _Graph_CacheStats
+(
+	RedisModuleCtx *ctx,
+	Cache *cache
+) {
+	uint64_t hits;
+	uint64_t misses;
+	Cache_GetStats(cache, &hits, &misses);
+
+	uint64_t lookups = hits + misses;
+	double hit_rate  = (lookups > 0) ? (double)hits / lookups : 0;
+
+	CacheKeyStats *queries = Cache_HotKeys(cache, cache->cap, true);
+	uint n = array_len(queries);
+
+	RedisModule_ReplyWithArray(ctx, 12);
+
+	RedisModule_ReplyWithCString(ctx, "hits");
+	RedisModule_ReplyWithLongLong(ctx, hits);
+	RedisModule_ReplyWithCString(ctx, "misses");
+	RedisModule_ReplyWithLongLong(ctx, misses);
+	RedisModule_ReplyWithCString(ctx, "hit_rate");
+	RedisModule_ReplyWithDouble(ctx, hit_rate);
+	RedisModule_ReplyWithCString(ctx, "size");
+	RedisModule_ReplyWithLongLong(ctx, n);
+	RedisModule_ReplyWithCString(ctx, "capacity");
+	RedisModule_ReplyWithLongLong(ctx, cache->cap);
+	RedisModule_ReplyWithCString(ctx, "queries");
+
+	RedisModule_ReplyWithArray(ctx, n);
+	for(uint i = 0; i < n; i++) {
+		RedisModule_ReplyWithArray(ctx, 2);
+		RedisModule_ReplyWithCString(ctx, queries[i].key);
+		RedisModule_ReplyWithLongLong(ctx, queries[i].hits);
+		rm_free(queries[i].key);
+	}
+
+	array_free(queries);
+}
+
+// plan each query, reply with OK or the query's error
+static void _Graph_CacheWarmup
+(
+	RedisModuleCtx *ctx,
+	GraphContext *gc,
+	RedisModuleString **queries,
+	int n
+) {
+	RedisModule_ReplyWithArray(ctx, n);
+	for(int i = 0; i < n; i++) {
+		const char *q = RedisModule_StringPtrLen(queries[i], NULL);
+		char *err = CacheWarmup_Query(gc, q);
+		if(err == NULL) {
+			RedisModule_ReplyWithSimpleString(ctx, "OK");
+		} else {
+			RedisModule_ReplyWithError(ctx, err);
+			free(err);
+		}
+	}
+}
+
+// usage:
+// GRAPH.CACHE G STATS
+// GRAPH.CACHE G WARMUP query [query ...]
+int Graph_Cache
+(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+) {
+	//--------------------------------------------------------------------------
+	// validations
+	//--------------------------------------------------------------------------
+
+	ASSERT(ctx  != NULL);
+	ASSERT(argv != NULL);
+	if(argc < 3) {
+		RedisModule_WrongArity(ctx);
+		return REDISMODULE_OK;
+	}
+
+	const char *sub_cmd = RedisModule_StringPtrLen(argv[2], NULL);
+	bool stats  = (strcasecmp(sub_cmd, "stats")  == 0);
+	bool warmup = (strcasecmp(sub_cmd, "warmup") == 0);
+
+	if(!stats && !warmup) {
+		// unknown subcommand
+		RedisModule_ReplyWithError(ctx, "Unknown subcommand");
+		return REDISMODULE_OK;
+	}
+
+	if((stats && argc != 3) || (warmup && argc < 4)) {
+		RedisModule_WrongArity(ctx);
+		return REDISMODULE_OK;
+	}
+
+	// get a hold of the graph key
+	GraphContext *gc = GraphContext_Retrieve(ctx, argv[1], true, false);
+	if(gc == NULL) {
+		// if GraphContext is null, key access failed and an error been emitted
+		return REDISMODULE_OK;
+	}
+
+	if(stats) {
+		_Graph_CacheStats(ctx, GraphContext_GetCache(gc));
+	} else {
+		_Graph_CacheWarmup(ctx, gc, argv + 3, argc - 3);
+	}
+
+	GraphContext_DecreaseRefCount(gc);
+
+	return REDISMODULE_OK;
+}
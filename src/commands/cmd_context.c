@@ -25,6 +25,7 @@ CommandCtx *CommandCtx_New
 	ExecutorThread thread,         // which thread executes this command
 	bool replicated_command,       // whether this instance was spawned by a replication command
 	bool compact,                  // whether this query was issued with the compact flag
+	bool binary,                   // whether this query was issued with the binary flag
 	long long timeout,             // the query timeout, if specified
 	bool timeout_rw,               // apply timeout on both read and write queries
 	uint64_t received_ts,          // command received at this  UNIX timestamp
@@ -36,12 +37,16 @@ CommandCtx *CommandCtx_New
 	context->ctx                = ctx;
 	context->query              = NULL;
 	context->thread             = thread;
+	context->binary             = binary;
 	context->compact            = compact;
 	context->timeout            = timeout;
 	context->ref_count          = ATOMIC_VAR_INIT(1);
 	context->graph_ctx          = graph_ctx;
 	context->timeout_rw         = timeout_rw;
 	context->received_ts        = received_ts;
+	context->params             = NULL;
+	context->statement          = 0;
+	context->params_len         = 0;
 	context->command_name       = NULL;
 	context->replicated_command = replicated_command;
 
@@ -62,6 +67,29 @@ CommandCtx *CommandCtx_New
 	return context;
 }
 
+// associate command context with a prepared statement
+void CommandCtx_SetPreparedStatement
+(
+	CommandCtx *command_ctx,   // command context
+	uint64_t handle,           // prepared statement handle
+	RedisModuleString *params  // binary encoded parameters
+) {
+	ASSERT(handle      != 0);
+	ASSERT(params      != NULL);
+	ASSERT(command_ctx != NULL);
+
+	size_t len;
+	const char *buf = RedisModule_StringPtrLen(params, &len);
+
+	// make a copy of parameters, command might execute on a different thread
+	command_ctx->statement  = handle;
+	command_ctx->params_len = len;
+	if(len > 0) {
+		command_ctx->params = rm_malloc(len);
+		memcpy(command_ctx->params, buf, len);
+	}
+}
+
 // increment command context reference count
 void CommandCtx_Incref
 (
@@ -172,6 +200,7 @@ void CommandCtx_Free
 		ASSERT(command_ctx->bc == NULL);
 
 		if(command_ctx->query != NULL) rm_free(command_ctx->query);
+		if(command_ctx->params != NULL) rm_free(command_ctx->params);
 		rm_free(command_ctx->command_name);
 		rm_free(command_ctx);
 	}
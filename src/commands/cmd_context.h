@@ -30,11 +30,15 @@ typedef struct {
 	RedisModuleBlockedClient *bc;  // blocked client
 	bool replicated_command;       // whether this instance was spawned by a replication command
 	bool compact;                  // whether this query was issued with the compact flag
+	bool binary;                   // whether this query was issued with the binary flag
 	ExecutorThread thread;         // which thread executes this command
 	long long timeout;             // the query timeout, if specified
 	bool timeout_rw;               // apply timeout on both read and write queries
 	uint64_t received_ts;          // command received at this UNIX timestamp
 	simple_timer_t timer;          // stopwatch started upon command received
+	uint64_t statement;            // prepared statement handle, 0 if none
+	char *params;                  // prepared statement binary parameters
+	size_t params_len;             // binary parameters length
 } CommandCtx;
 
 // create a new command context
@@ -48,12 +52,21 @@ CommandCtx *CommandCtx_New
 	ExecutorThread thread,         // which thread executes this command
 	bool replicated_command,       // whether this instance was spawned by a replication command
 	bool compact,                  // whether this query was issued with the compact flag
+	bool binary,                   // whether this query was issued with the binary flag
 	long long timeout,             // the query timeout, if specified
 	bool timeout_rw,               // apply timeout on both read and write queries
 	uint64_t received_ts,          // command received at this  UNIX timestamp
 	simple_timer_t timer           // stopwatch started upon command received
 );
 
+// associate command context with a prepared statement
+void CommandCtx_SetPreparedStatement
+(
+	CommandCtx *command_ctx,   // command context
+	uint64_t handle,           // prepared statement handle
+	RedisModuleString *params  // binary encoded parameters
+);
+
 // increment command context reference count
 void CommandCtx_Incref
 (
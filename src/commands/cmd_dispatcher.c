@@ -23,18 +23,22 @@ static int _read_flags
 (
 	RedisModuleString **argv,   // commands arguments
   	int argc,                   // number of arguments
+	int first,                  // index of the first flag
   	bool *compact,              // compact result-set format
+  	bool *binary,               // binary result-set format
 	long long *timeout,         // query level timeout
   	bool *timeout_rw,           // apply timeout on both read and write queries
   	uint *graph_version,        // graph version [UNUSED]
   	char **errmsg               // reported error message
 ) {
+	ASSERT(binary  != NULL);
 	ASSERT(compact != NULL);
 	ASSERT(timeout != NULL);
 
 	long long max_timeout;
 
 	// set defaults
+	*binary  = false;
 	*compact = false;  // verbose
 	*graph_version = GRAPH_VERSION_MISSING;
 	Config_Option_get(Config_TIMEOUT_DEFAULT, timeout);
@@ -52,16 +56,19 @@ static int _read_flags
 	}
 
 	// GRAPH.QUERY <GRAPH_KEY> <QUERY>
-	// make sure we've got more than 3 arguments
-	if(argc <= 3) return REDISMODULE_OK;
+	// make sure we've got flags
+	if(argc <= first) return REDISMODULE_OK;
 
 	// scan arguments
-	for(int i = 3; i < argc; i++) {
+	for(int i = first; i < argc; i++) {
 		const char *arg = RedisModule_StringPtrLen(argv[i], NULL);
 
 		if(!strcasecmp(arg, "--compact")) {
 			// compact result-set
 			*compact = true;
+		} else if(!strcasecmp(arg, "--binary")) {
+			// binary result-set
+			*binary = true;
 		} else if(!strcasecmp(arg, "timeout")) {
 			// query timeout
 			int err = REDISMODULE_ERR;
@@ -135,6 +142,13 @@ static inline bool _validate_command_arity(GRAPH_Commands cmd, int arity) {
 		case CMD_PROFILE:
 			// Expect a command, graph name, a query, and optional config flags.
 			return arity >= 3 && arity <= 8;
+		case CMD_PREPARE:
+			// Expect a command, graph name and a query.
+			return arity == 3;
+		case CMD_EXECUTE:
+			// Expect a command, graph name, a statement handle, parameters
+			// and optional config flags.
+			return arity >= 4 && arity <= 9;
 		default:
 			ASSERT("encountered unhandled query type" && false);
 			return false;
@@ -151,6 +165,10 @@ static Command_Handler get_command_handler(GRAPH_Commands cmd) {
 			return Graph_Explain;
 		case CMD_PROFILE:
 			return Graph_Profile;
+		case CMD_PREPARE:
+			return Graph_Prepare;
+		case CMD_EXECUTE:
+			return Graph_Execute;
 		default:
 			ASSERT(false);
 	}
@@ -164,6 +182,8 @@ static bool should_command_create_graph(GRAPH_Commands cmd) {
 			return true;
 		case CMD_EXPLAIN:
 		case CMD_RO_QUERY:
+		case CMD_PREPARE:
+		case CMD_EXECUTE:
 			return false;
 		default:
 			ASSERT(false);
@@ -179,6 +199,7 @@ int CommandDispatch
 ) {
 	char *errmsg;
 	uint version;
+	bool binary;
 	bool compact;
 	bool timeout_rw;
 	long long timeout;
@@ -195,9 +216,23 @@ int CommandDispatch
 
 	if(_validate_command_arity(cmd, argc) == false) return RedisModule_WrongArity(ctx);
 
+	// GRAPH.EXECUTE <GRAPH_KEY> <HANDLE> <PARAMS>
+	long long statement = 0;
+	RedisModuleString *params = NULL;
+	if(cmd == CMD_EXECUTE) {
+		if(RedisModule_StringToLongLong(argv[2], &statement) != REDISMODULE_OK ||
+		   statement <= 0) {
+			RedisModule_ReplyWithError(ctx, "Invalid prepared statement handle");
+			return REDISMODULE_OK;
+		}
+		query  = NULL;
+		params = argv[3];
+	}
+
 	// parse additional arguments
-	int res = _read_flags(argv, argc, &compact, &timeout, &timeout_rw, &version,
-			&errmsg);
+	int first_flag = (cmd == CMD_EXECUTE) ? 4 : 3;
+	int res = _read_flags(argv, argc, first_flag, &compact, &binary, &timeout,
+			&timeout_rw, &version, &errmsg);
 	if(res == REDISMODULE_ERR) {
 		// emit error and exit if argument parsing failed
 		RedisModule_ReplyWithError(ctx, errmsg);
@@ -242,15 +277,21 @@ int CommandDispatch
 	if(exec_thread == EXEC_THREAD_MAIN) {
 		// run query on Redis main thread
 		context = CommandCtx_New(ctx, NULL, argv[0], query, gc, exec_thread,
-								 is_replicated, compact, timeout, timeout_rw,
+								 is_replicated, compact, binary, timeout, timeout_rw,
 								 received_ts, timer);
+		if(statement != 0) {
+			CommandCtx_SetPreparedStatement(context, statement, params);
+		}
 		handler(context);
 	} else {
 		// run query on a dedicated thread
 		RedisModuleBlockedClient *bc = RedisGraph_BlockClient(ctx);
 		context = CommandCtx_New(NULL, bc, argv[0], query, gc, exec_thread,
-								 is_replicated, compact, timeout, timeout_rw,
+								 is_replicated, compact, binary, timeout, timeout_rw,
 								 received_ts, timer);
+		if(statement != 0) {
+			CommandCtx_SetPreparedStatement(context, statement, params);
+		}
 
 		if(ThreadPools_AddWorkReader(handler, context, false) ==
 				THPOOL_QUEUE_FULL) {
@@ -5,6 +5,7 @@
  */
 
 #include "RG.h"
+#include "../errors/errors.h"
 #include "../effects/effects.h"
 #include "../graph/graphcontext.h"
 
@@ -32,11 +33,16 @@ int Graph_Effect
 	const char *effects_buff = RedisModule_StringPtrLen(argv[2], &l);
 
 	// apply effects
-	Effects_Apply(gc, effects_buff, l);
+	bool applied = Effects_Apply(gc, effects_buff, l);
 
 	// release GraphContext
 	GraphContext_DecreaseRefCount(gc);
 
+	if(!applied) {
+		RedisModule_ReplyWithError(ctx, EMSG_INVALID_EFFECTS);
+		return REDISMODULE_OK;
+	}
+
 	// replicate effect
 	RedisModule_ReplicateVerbatim(ctx);
 
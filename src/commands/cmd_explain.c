@@ -34,7 +34,9 @@ void Graph_Explain(void *args) {
 	// 2. Whether these items were cached or not
 	bool           cached = false;
 	ExecutionPlan  *plan  = NULL;
-	exec_ctx  =  ExecutionCtx_FromQuery(command_ctx->query);
+	// plan the query as issued, such that reported operations
+	// refer to the query's literals rather than to synthetic parameters
+	exec_ctx  =  ExecutionCtx_FromQueryText(command_ctx->query);
 	if (exec_ctx == NULL) {
 		query_ctx->status = QueryExecutionStatus_FAILURE;
 		goto cleanup;
@@ -9,6 +9,7 @@
 #include "../globals.h"
 #include "redismodule.h"
 #include "cmd_context.h"
+#include "../effects/effects.h"
 #include "../util/thpool/pools.h"
 
 #include <ctype.h>
@@ -20,9 +21,17 @@
 #define WAIT_DURATION_KEY_NAME      "Wait duration"
 #define RECEIVED_TIMESTAMP_KEY_NAME "Received at"
 #define EXECUTION_DURATION_KEY_NAME "Execution duration"
+#define APPLIED_EFFECTS_KEY_NAME    "Applied effects"
+#define APPLY_LAG_KEY_NAME          "Apply lag"
+#define MAX_APPLY_LAG_KEY_NAME      "Max apply lag"
+#define APPLY_DURATION_KEY_NAME     "Apply duration"
+#define CACHE_HITS_KEY_NAME         "Cache hits"
+#define CACHE_MISSES_KEY_NAME       "Cache misses"
 
 #define SUBCOMMAND_NAME_RUNNING_QUERIES "RunningQueries"
 #define SUBCOMMAND_NAME_WAITING_QUERIES "WaitingQueries"
+#define SUBCOMMAND_NAME_REPLICATION     "Replication"
+#define SUBCOMMAND_NAME_PLAN_CACHE      "PlanCache"
 
 //------------------------------------------------------------------------------
 // Info section API
@@ -240,6 +249,89 @@ static void _info_waiting_queries
 	free(cmds);
 }
 
+// handles the "GRAPH.INFO Replication" section
+// "GRAPH.INFO Replication"
+static void _info_replication
+(
+	RedisModuleCtx *ctx  // redis context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO Replication
+	// reply:
+	// "# Replication"
+	//     "Applied effects"
+	//     "Apply lag"
+	//     "Max apply lag"
+	//     "Apply duration"
+
+	ASSERT(ctx != NULL);
+
+	EffectsApplyStats stats;
+	Effects_GetApplyStats(&stats);
+
+	// create a new subsection in the reply
+	Info_AddSection(ctx, "# Replication", 4 * 2);
+
+	// emit number of GRAPH.EFFECT commands applied
+	Info_SectionAddEntryLongLong(ctx, APPLIED_EFFECTS_KEY_NAME, stats.applied);
+
+	// emit last and max apply lag in milliseconds
+	Info_SectionAddEntryLongLong(ctx, APPLY_LAG_KEY_NAME, stats.lag);
+	Info_SectionAddEntryLongLong(ctx, MAX_APPLY_LAG_KEY_NAME, stats.max_lag);
+
+	// emit last apply duration in milliseconds
+	Info_SectionAddEntryDouble(ctx, APPLY_DURATION_KEY_NAME, stats.duration);
+}
+
+// handles the "GRAPH.INFO PlanCache" section
+// "GRAPH.INFO PlanCache"
+static void _info_plan_cache
+(
+	RedisModuleCtx *ctx  // redis context
+) {
+	// an example for a command and reply:
+	// command:
+	// GRAPH.INFO PlanCache
+	// reply:
+	// "# Plan cache"
+	//     "Graph name"
+	//     "Cache hits"
+	//     "Cache misses"
+
+	ASSERT(ctx != NULL);
+
+	// create a new subsection in the reply
+	Info_AddSection(ctx, "# Plan cache", REDISMODULE_POSTPONED_LEN);
+
+	KeySpaceGraphIterator it;
+	Globals_ScanGraphs(&it);
+
+	uint64_t     n   = 0;
+	GraphContext *gc = NULL;
+
+	while((gc = GraphIterator_Next(&it)) != NULL) {
+		uint64_t hits;
+		uint64_t misses;
+		Cache_GetStats(GraphContext_GetCache(gc), &hits, &misses);
+
+		RedisModule_ReplyWithArray(ctx, 3 * 2);
+
+		// emit graph name
+		Info_SectionAddEntryString(ctx, GRAPH_NAME_KEY_NAME,
+				GraphContext_GetName(gc));
+
+		// emit number of plan cache hits and misses
+		Info_SectionAddEntryLongLong(ctx, CACHE_HITS_KEY_NAME, hits);
+		Info_SectionAddEntryLongLong(ctx, CACHE_MISSES_KEY_NAME, misses);
+
+		GraphContext_DecreaseRefCount(gc);
+		n++;
+	}
+
+	RedisModule_ReplySetArrayLength(ctx, n);
+}
+
 // attempts to find the specified sections of "GRAPH.INFO" and dispatch it
 static void _handle_sections
 (
@@ -253,6 +345,8 @@ static void _handle_sections
 	int section_count = 0;
 	bool running_queries = false;
 	bool waiting_queries = false;
+	bool replication     = false;
+	bool plan_cache      = false;
 
 	if(argc == 0) {
 		running_queries = true;
@@ -269,6 +363,14 @@ static void _handle_sections
 					  !strcasecmp(subcmd, SUBCOMMAND_NAME_WAITING_QUERIES)) {
 				waiting_queries = true;
 				section_count++;
+			} else if(!replication &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_REPLICATION)) {
+				replication = true;
+				section_count++;
+			} else if(!plan_cache &&
+					  !strcasecmp(subcmd, SUBCOMMAND_NAME_PLAN_CACHE)) {
+				plan_cache = true;
+				section_count++;
 			}
 		}
 	}
@@ -285,11 +387,17 @@ static void _handle_sections
 	if(waiting_queries) {
 		_info_waiting_queries(ctx);
 	}
+	if(replication) {
+		_info_replication(ctx);
+	}
+	if(plan_cache) {
+		_info_plan_cache(ctx);
+	}
 }
 
 // graph.info command handler
 // GRAPH.INFO [Section [Section ...]]
-// GRAPH.INFO RunningQueries WaitingQueries
+// GRAPH.INFO RunningQueries WaitingQueries Replication PlanCache
 int Graph_Info
 (
 	RedisModuleCtx *ctx,       // redis module context
@@ -0,0 +1,83 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "cmd_context.h"
+#include "../globals.h"
+#include "../query_ctx.h"
+#include "../errors/errors.h"
+#include "prepared_statements.h"
+#include "../graph/graphcontext.h"
+
+// builds and pins an execution plan for later executions via GRAPH.EXECUTE
+// replies with the statement's handle
+// Args:
+// argv[1] graph name
+// argv[2] query
+void Graph_Prepare(void *args) {
+	CommandCtx     *command_ctx = (CommandCtx *)args;
+	RedisModuleCtx *ctx         = CommandCtx_GetRedisCtx(command_ctx);
+	GraphContext   *gc          = CommandCtx_GetGraphContext(command_ctx);
+	QueryCtx       *query_ctx   = QueryCtx_GetQueryCtx();
+
+	QueryCtx_SetGlobalExecutionCtx(command_ctx);
+	Globals_TrackCommandCtx(command_ctx);
+
+	PreparedStatements *ps = GraphContext_GetPreparedStatements(gc);
+	uint64_t handle = PreparedStatements_Add(ps, command_ctx->query,
+			GraphContext_GetVersion(gc));
+
+	if(handle == 0) {
+		query_ctx->status = QueryExecutionStatus_FAILURE;
+		ErrorCtx_EmitException();
+	} else {
+		RedisModule_ReplyWithLongLong(ctx, handle);
+	}
+
+	GraphContext_DecreaseRefCount(gc);
+	Globals_UntrackCommandCtx(command_ctx);
+	CommandCtx_UnblockClient(command_ctx);
+	CommandCtx_Free(command_ctx);
+	QueryCtx_Free(); // reset the QueryCtx and free its allocations
+	ErrorCtx_Clear();
+}
+
+// releases a prepared statement
+// Args:
+// argv[1] graph name
+// argv[2] statement handle
+int Graph_Deallocate
+(
+	RedisModuleCtx *ctx,
+	RedisModuleString **argv,
+	int argc
+) {
+	if(argc != 3) {
+		return RedisModule_WrongArity(ctx);
+	}
+
+	long long handle;
+	if(RedisModule_StringToLongLong(argv[2], &handle) != REDISMODULE_OK ||
+	   handle <= 0) {
+		RedisModule_ReplyWithError(ctx, "Invalid prepared statement handle");
+		return REDISMODULE_OK;
+	}
+
+	GraphContext *gc = GraphContext_Retrieve(ctx, argv[1], true, false);
+	// if GraphContext is null, key access failed and an error been emitted
+	if(gc == NULL) return REDISMODULE_ERR;
+
+	PreparedStatements *ps = GraphContext_GetPreparedStatements(gc);
+	if(PreparedStatements_Remove(ps, handle)) {
+		RedisModule_ReplyWithSimpleString(ctx, "OK");
+	} else {
+		RedisModule_ReplyWithErrorFormat(ctx, EMSG_UNKNOWN_PREPARED_STATEMENT,
+				(unsigned long long)handle);
+	}
+
+	GraphContext_DecreaseRefCount(gc);
+	return REDISMODULE_OK;
+}
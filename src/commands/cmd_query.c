@@ -18,6 +18,7 @@
 #include "../index/indexer.h"
 #include "../effects/effects.h"
 #include "../util/cache/cache.h"
+#include "../ast/ast_params_parser.h"
 #include "../util/thpool/pools.h"
 #include "../configuration/config.h"
 #include "../execution_plan/execution_plan.h"
@@ -30,6 +31,8 @@ typedef struct {
 	ExecutionCtx *exec_ctx;   // execution context
 	CommandCtx *command_ctx;  // command context
 	CronTaskHandle timeout;   // timeout cron task
+	ResultSet *result_set;    // result-set, set once executed as part of a group
+	char *error;              // detached error, set once executed as part of a group
 } GraphQueryCtx;
 
 static GraphQueryCtx *GraphQueryCtx_New
@@ -50,6 +53,8 @@ static GraphQueryCtx *GraphQueryCtx_New
 	ctx->query_ctx->flags = flags;
 	ctx->command_ctx      =  command_ctx;
 	ctx->timeout          =  timeout;
+	ctx->result_set       =  NULL;
+	ctx->error            =  NULL;
 
 	return ctx;
 }
@@ -279,13 +284,53 @@ inline static bool _readonly_cmd_mode(CommandCtx *ctx) {
 	return strcasecmp(CommandCtx_GetCommandName(ctx), "graph.RO_QUERY") == 0;
 }
 
-// _ExecuteQuery accepts a GraphQueryCtx as an argument
-// it may be called directly by a reader thread or the Redis main thread,
-// or dispatched as a worker thread job when used for writing.
-static void _ExecuteQuery(void *args) {
-	ASSERT(args != NULL);
+inline static bool _prepared_cmd_mode(CommandCtx *ctx) {
+	return ctx->statement != 0;
+}
+
+// retrieve the execution context of a prepared statement
+// and decode its binary parameters
+static ExecutionCtx *_ExecutionCtx_FromStatement
+(
+	CommandCtx *command_ctx,  // command context
+	QueryCtx *query_ctx       // query context
+) {
+	GraphContext       *gc = CommandCtx_GetGraphContext(command_ctx);
+	PreparedStatements *ps = GraphContext_GetPreparedStatements(gc);
+
+	// retrieve statement before setting parameters
+	// a statement rebuilt due to a schema change must not observe any
+	char *query;
+	ExecutionCtx *exec_ctx = PreparedStatements_Get(ps, command_ctx->statement,
+			GraphContext_GetVersion(gc), &query);
+	if(exec_ctx == NULL) return NULL;
+
+	// report the statement's query e.g. in the slowlog
+	command_ctx->query                    = query;
+	query_ctx->query_data.query           = query;
+	query_ctx->query_data.query_no_params = query;
+
+	if(!AST_DecodeBinaryParams(command_ctx->params, command_ctx->params_len)) {
+		ErrorCtx_SetError(EMSG_INVALID_BINARY_PARAMS);
+		ExecutionCtx_Free(exec_ctx);
+		return NULL;
+	}
+
+	return exec_ctx;
+}
+
+// forward declaration
+static void _ExecuteQuery(void *args);
+
+// executes the query held by gq_ctx
+// in case of an error, any modification made by the query is rolled back
+// returns the query's result-set
+static ResultSet *_ExecuteQuery_Run
+(
+	GraphQueryCtx *gq_ctx
+) {
+	ASSERT(gq_ctx != NULL);
 
-	GraphQueryCtx  *gq_ctx      = args;
 	QueryCtx       *query_ctx   = gq_ctx->query_ctx;
 	GraphContext   *gc          = gq_ctx->graph_ctx;
 	RedisModuleCtx *rm_ctx      = gq_ctx->rm_ctx;
@@ -307,24 +352,45 @@ static void _ExecuteQuery(void *args) {
 	}
 
 	// instantiate the query ResultSet
+	bool binary  = command_ctx->binary;
 	bool compact = command_ctx->compact;
 	// replicated command don't need to return result
 	ResultSetFormatterType resultset_format =
 		profile || command_ctx->replicated_command
 		? FORMATTER_NOP
-		: (compact)
-			? FORMATTER_COMPACT
-			: FORMATTER_VERBOSE;
+		: (binary)
+			? FORMATTER_BINARY
+			: (compact)
+				? FORMATTER_COMPACT
+				: FORMATTER_VERBOSE;
 	ResultSet *result_set = NewResultSet(rm_ctx, resultset_format);
+
+	// stream read-only results as they're produced
+	// write queries are excluded, a failing write query must not emit rows
+	// as its modifications are rolled back
+	bool streaming = false;
+	Config_Option_get(Config_RESULTSET_STREAMING, &streaming);
+	if(streaming && readonly && resultset_format != FORMATTER_NOP) {
+		ResultSet_EnableStreaming(result_set);
+	}
+
 	if(exec_ctx->cached) {
 		ResultSet_CachedExecution(result_set); // indicate a cached execution
 	}
 
 	QueryCtx_SetResultSet(result_set);
 
+	// a query subject to a timeout might be aborted
+	// after it started modifying the graph
+	QueryCtx_SetAbortable(query_ctx, gq_ctx->timeout != 0);
+
 	// acquire the appropriate lock
 	if(readonly) {
 		Graph_AcquireReadLock(gc->g);
+	} else if(query_ctx->internal_exec_ctx.locked_for_commit) {
+		// commit lock inherited from a previous query in the commit group
+		// GIL is already held
+		GraphContext_MarkWriter(rm_ctx, gc);
 	} else {
 		// if this is a writer query `we need to re-open the graph key with write flag
 		// this notifies Redis that the key is "dirty" any watcher on that key will
@@ -378,30 +444,58 @@ static void _ExecuteQuery(void *args) {
 		if (query_ctx->status != QueryExecutionStatus_TIMEDOUT) {
 			query_ctx->status = QueryExecutionStatus_FAILURE;
 		}
-	} else {
-		// replicate if graph was modified
-		if(ResultSetStat_IndicateModification(&result_set->stats)) {
-			// determine rather or not to replicate via effects
-			if(EffectsBuffer_Length(QueryCtx_GetEffectsBuffer()) > 0 &&
-			   _should_replicate_effects()) {
-				// compute effects buffer
-				size_t effects_len = 0;
-				u_char *effects = EffectsBuffer_Buffer(
-						QueryCtx_GetEffectsBuffer(), &effects_len);
-				ASSERT(effects_len > 0 && effects != NULL);
-
-				// replicate effects
-				RedisModule_Replicate(rm_ctx, "GRAPH.EFFECT", "cb!",
-						GraphContext_GetName(gc), effects, effects_len);
-				rm_free(effects);
-			} else {
-				// replicate original query
-				QueryCtx_Replicate(query_ctx);
-			}
-		}	
 	}
 
-	QueryCtx_UnlockCommit();
+	return result_set;
+}
+
+// replicate the modifications made by a successful query
+static void _ExecuteQuery_Replicate
+(
+	GraphQueryCtx *gq_ctx,
+	ResultSet *result_set
+) {
+	// replicate only if graph was modified
+	if(!ResultSetStat_IndicateModification(&result_set->stats)) {
+		return;
+	}
+
+	// prepared statements are always replicated via effects
+	// replicas hold no statements to execute, graph modifying procedures
+	// which aren't captured by effects can't be prepared
+	bool prepared = _prepared_cmd_mode(gq_ctx->command_ctx);
+
+	// determine rather or not to replicate via effects
+	if(EffectsBuffer_Length(QueryCtx_GetEffectsBuffer()) > 0 &&
+	   (prepared || _should_replicate_effects())) {
+		// compute effects buffer
+		size_t effects_len = 0;
+		u_char *effects = EffectsBuffer_Buffer(
+				QueryCtx_GetEffectsBuffer(), &effects_len);
+		ASSERT(effects_len > 0 && effects != NULL);
+
+		// replicate effects
+		RedisModule_Replicate(gq_ctx->rm_ctx, "GRAPH.EFFECT", "cb!",
+				GraphContext_GetName(gq_ctx->graph_ctx), effects, effects_len);
+		rm_free(effects);
+	} else if(!prepared) {
+		// replicate original query
+		QueryCtx_Replicate(gq_ctx->query_ctx);
+	}
+}
+
+// reply to the client and release the query's resources
+static void _ExecuteQuery_Finalize
+(
+	GraphQueryCtx *gq_ctx,
+	ResultSet *result_set
+) {
+	QueryCtx       *query_ctx   = gq_ctx->query_ctx;
+	GraphContext   *gc          = gq_ctx->graph_ctx;
+	ExecutionCtx   *exec_ctx    = gq_ctx->exec_ctx;
+	CommandCtx     *command_ctx = gq_ctx->command_ctx;
+	const bool     profile      = (query_ctx->flags & QueryExecutionTypeFlag_PROFILE);
+	const bool     readonly     = !(query_ctx->flags & QueryExecutionTypeFlag_WRITE);
 
 	if(!profile || ErrorCtx_EncounteredError()) {
 		// if we encountered an error, ResultSet_Reply will emit the error
@@ -433,6 +527,228 @@ static void _ExecuteQuery(void *args) {
 	GraphQueryCtx_Free(gq_ctx);
 }
 
+//------------------------------------------------------------------------------
+// Group commit
+//------------------------------------------------------------------------------
+
+// group commit batches write queries queued against the same graph
+// members are executed one after the other under a single commit lock
+// acquisition, each member rolls back its own modifications on failure
+// via its undo-log, while the effects of successful members are combined
+// into a single GRAPH.EFFECT replication message
+
+// returns true if query can take part in a commit group
+static inline bool _GroupCommit_Eligible
+(
+	const GraphQueryCtx *gq_ctx
+) {
+	return (gq_ctx->command_ctx->thread == EXEC_THREAD_WRITER &&
+			gq_ctx->exec_ctx->exec_type == EXECUTION_TYPE_QUERY &&
+			!(gq_ctx->query_ctx->flags & QueryExecutionTypeFlag_PROFILE));
+}
+
+// returns true if queued task can join the leader's commit group
+static bool _GroupCommit_Match
+(
+	void *task,   // queued GraphQueryCtx
+	void *pdata   // group leader
+) {
+	GraphQueryCtx *gq_ctx = (GraphQueryCtx *)task;
+	GraphQueryCtx *leader = (GraphQueryCtx *)pdata;
+
+	return (gq_ctx->graph_ctx == leader->graph_ctx &&
+			_GroupCommit_Eligible(gq_ctx));
+}
+
+// replicate accumulated group effects and reset the effects buffer
+// must be called while holding the commit lock
+static void _GroupCommit_FlushEffects
+(
+	RedisModuleCtx *rm_ctx,  // redis module context of lock holder
+	GraphContext *gc,        // graph context
+	EffectsBuffer **effects  // group's effects
+) {
+	if(EffectsBuffer_Length(*effects) == 0) return;
+
+	size_t effects_len = 0;
+	u_char *buffer = EffectsBuffer_Buffer(*effects, &effects_len);
+	ASSERT(effects_len > 0 && buffer != NULL);
+
+	RedisModule_Replicate(rm_ctx, "GRAPH.EFFECT", "cb!",
+			GraphContext_GetName(gc), buffer, effects_len);
+	rm_free(buffer);
+
+	// reset group effects
+	EffectsBuffer_Free(*effects);
+	*effects = EffectsBuffer_New();
+}
+
+// collect the modifications of a successful group member for replication
+static void _GroupCommit_Replicate
+(
+	GraphQueryCtx *gq_ctx,   // group member
+	ResultSet *result_set,   // member's result-set
+	EffectsBuffer **effects  // group's effects
+) {
+	// replicate only if graph was modified
+	if(!ResultSetStat_IndicateModification(&result_set->stats)) {
+		return;
+	}
+
+	// prepared statements are always replicated via effects
+	bool prepared = _prepared_cmd_mode(gq_ctx->command_ctx);
+
+	// same decision as a query executed on its own
+	EffectsBuffer *eb = QueryCtx_GetEffectsBuffer();
+	if(EffectsBuffer_Length(eb) > 0 &&
+	   (prepared || _should_replicate_effects())) {
+		EffectsBuffer_Append(*effects, eb);
+		return;
+	}
+
+	if(prepared) return;
+
+	// replicate the original query
+	// flush pending group effects first, preserving replication order
+	_GroupCommit_FlushEffects(gq_ctx->rm_ctx, gq_ctx->graph_ctx, effects);
+	QueryCtx_Replicate(gq_ctx->query_ctx);
+}
+
+// execute a group of write queries under a single commit
+static void _GroupCommit_Execute
+(
+	GraphQueryCtx **group,  // group members, group[0] is the leader
+	uint32_t n              // number of members
+) {
+	ASSERT(n > 1);
+	ASSERT(group != NULL);
+
+	GraphContext  *gc         =  group[0]->graph_ctx;
+	EffectsBuffer *effects    =  EffectsBuffer_New();  // combined effects
+	GraphQueryCtx *holder     =  NULL;  // member holding the commit lock
+
+	//--------------------------------------------------------------------------
+	// execute members
+	//--------------------------------------------------------------------------
+
+	for(uint32_t i = 0; i < n; i++) {
+		GraphQueryCtx *gq_ctx = group[i];
+
+		// inherit the commit lock acquired by a previous member
+		if(holder != NULL) {
+			QueryCtx_TransferCommitLock(holder->query_ctx, gq_ctx->query_ctx);
+		}
+
+		gq_ctx->result_set = _ExecuteQuery_Run(gq_ctx);
+
+		if(!ErrorCtx_EncounteredError()) {
+			_GroupCommit_Replicate(gq_ctx, gq_ctx->result_set, &effects);
+		}
+
+		holder = (gq_ctx->query_ctx->internal_exec_ctx.locked_for_commit)
+			? gq_ctx
+			: NULL;
+
+		// replies are emitted only once the group is committed
+		// stash member's error
+		gq_ctx->error = ErrorCtx_DetachError();
+		ErrorCtx_Clear();
+	}
+
+	//--------------------------------------------------------------------------
+	// commit
+	//--------------------------------------------------------------------------
+
+	// effects are collected only from members which acquired the lock
+	ASSERT(holder != NULL || EffectsBuffer_Length(effects) == 0);
+
+	if(holder != NULL) {
+		QueryCtx_SetTLS(holder->query_ctx);
+
+		// replicate group effects as a single GRAPH.EFFECT
+		_GroupCommit_FlushEffects(holder->rm_ctx, gc, &effects);
+
+		// sync matrices once for the entire group
+		Graph_ApplyAllPending(gc->g, false);
+
+		QueryCtx_UnlockCommit();
+	}
+
+	EffectsBuffer_Free(effects);
+
+	//--------------------------------------------------------------------------
+	// reply
+	//--------------------------------------------------------------------------
+
+	for(uint32_t i = 0; i < n; i++) {
+		GraphQueryCtx *gq_ctx = group[i];
+
+		QueryCtx_SetTLS(gq_ctx->query_ctx);
+		if(gq_ctx->error != NULL) {
+			ErrorCtx_AttachError(gq_ctx->error);
+			gq_ctx->error = NULL;
+		}
+		_ExecuteQuery_Finalize(gq_ctx, gq_ctx->result_set);
+	}
+}
+
+// try to commit queued write queries together with 'leader'
+// returns true if leader was executed as part of a commit group
+static bool _GroupCommit
+(
+	GraphQueryCtx *leader
+) {
+	ASSERT(leader != NULL);
+
+	if(!_GroupCommit_Eligible(leader)) {
+		return false;
+	}
+
+	uint64_t group_size;
+	Config_Option_get(Config_GROUP_COMMIT_SIZE, &group_size);
+	if(group_size <= 1) {
+		return false;
+	}
+
+	// collect queued write queries against the same graph
+	GraphQueryCtx **group = rm_malloc(sizeof(GraphQueryCtx *) * group_size);
+	group[0] = leader;
+
+	uint32_t n = 1 + ThreadPools_PullTasksWriter(_ExecuteQuery,
+			_GroupCommit_Match, leader, (void **)(group + 1), group_size - 1);
+
+	if(n > 1) {
+		_GroupCommit_Execute(group, n);
+	}
+
+	rm_free(group);
+	return (n > 1);
+}
+
+// _ExecuteQuery accepts a GraphQueryCtx as an argument
+// it may be called directly by a reader thread or the Redis main thread,
+// or dispatched as a worker thread job when used for writing.
+static void _ExecuteQuery(void *args) {
+	ASSERT(args != NULL);
+
+	GraphQueryCtx *gq_ctx = args;
+
+	// try committing queued write queries together with this query
+	if(_GroupCommit(gq_ctx)) {
+		return;
+	}
+
+	ResultSet *result_set = _ExecuteQuery_Run(gq_ctx);
+
+	if(!ErrorCtx_EncounteredError()) {
+		_ExecuteQuery_Replicate(gq_ctx, result_set);
+	}
+
+	QueryCtx_UnlockCommit();
+
+	_ExecuteQuery_Finalize(gq_ctx, result_set);
+}
+
 static void _DelegateWriter(GraphQueryCtx *gq_ctx) {
 	ASSERT(gq_ctx != NULL);
 
@@ -478,7 +794,10 @@ void _query
 
 	// parse query parameters and build an execution plan
 	// or retrieve it from the cache
-	exec_ctx = ExecutionCtx_FromQuery(command_ctx->query);
+	// prepared statements skip both
+	exec_ctx = _prepared_cmd_mode(command_ctx)
+		? _ExecutionCtx_FromStatement(command_ctx, query_ctx)
+		: ExecutionCtx_FromQuery(command_ctx->query);
 	if(exec_ctx == NULL) goto cleanup;
 
 	// update cached flag
@@ -557,3 +876,7 @@ void Graph_Query(void *args) {
 	_query(false, args);
 }
 
+void Graph_Execute(void *args) {
+	_query(false, args);
+}
+
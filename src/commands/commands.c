@@ -17,9 +17,12 @@ GRAPH_Commands CommandFromString(const char *cmd_name) {
 	if (!strcasecmp(cmd_name, "graph.CONFIG"))   return CMD_CONFIG;
 	if (!strcasecmp(cmd_name, "graph.PROFILE"))  return CMD_PROFILE;
 	if (!strcasecmp(cmd_name, "graph.EXPLAIN"))  return CMD_EXPLAIN;
+	if (!strcasecmp(cmd_name, "graph.PREPARE"))  return CMD_PREPARE;
+	if (!strcasecmp(cmd_name, "graph.EXECUTE"))  return CMD_EXECUTE;
 	if (!strcasecmp(cmd_name, "graph.SLOWLOG"))  return CMD_SLOWLOG;
 	if (!strcasecmp(cmd_name, "graph.RO_QUERY")) return CMD_RO_QUERY;
 	if (!strcasecmp(cmd_name, "graph.BULK"))     return CMD_BULK_INSERT;
+	if (!strcasecmp(cmd_name, "graph.CACHE"))    return CMD_CACHE;
 
 	// we shouldn't reach this point
 	ASSERT(false);
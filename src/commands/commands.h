@@ -27,7 +27,10 @@ typedef enum {
 	CMD_LIST        = 9,
 	CMD_DEBUG       = 10,
 	CMD_INFO        = 11,
-	CMD_EFFECT      = 12
+	CMD_EFFECT      = 12,
+	CMD_PREPARE     = 13,
+	CMD_EXECUTE     = 14,
+	CMD_CACHE       = 15
 } GRAPH_Commands;
 
 //------------------------------------------------------------------------------
@@ -39,6 +42,8 @@ GRAPH_Commands CommandFromString(const char *cmd_name);
 void Graph_Query(void *args);
 void Graph_Profile(void *args);
 void Graph_Explain(void *args);
+void Graph_Prepare(void *args);
+void Graph_Execute(void *args);
 
 int Graph_List(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Info(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
@@ -49,3 +54,5 @@ int Graph_Config(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Slowlog(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int CommandDispatch(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
 int Graph_Constraint(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
+int Graph_Deallocate(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
+int Graph_Cache(RedisModuleCtx *ctx, RedisModuleString **argv, int argc);
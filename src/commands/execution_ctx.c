@@ -8,6 +8,10 @@
 #include "RG.h"
 #include "../query_ctx.h"
 #include "../errors/errors.h"
+#include "../configuration/config.h"
+#include "../ast/ast_parameterize.h"
+#include "../ast/ast_params_parser.h"
+#include "../procedures/procedure.h"
 #include "../execution_plan/execution_plan_clone.h"
 
 static ExecutionType _GetExecutionTypeFromAST
@@ -90,13 +94,14 @@ ExecutionCtx *ExecutionCtx_Clone
 }
 
 // returns the objects and information required for query execution
-// if the query contains error, a ExecutionCtx struct with the AST
-// and Execution plan objects will be NULL
-// and EXECUTION_TYPE_INVALID is returned
-// returns ExecutionCtx populated with the current execution relevant objects
-ExecutionCtx *ExecutionCtx_FromQuery
+// cache lookups are accounted for only when 'track' is set
+// literals are replaced with parameters only when 'parameterize' is set
+// and CACHE_PARAMETERIZE is enabled
+static ExecutionCtx *_ExecutionCtx_FromQuery
 (
-	const char *q  // string representing the query
+	const char *q,     // string representing the query
+	bool track,        // account for cache lookup
+	bool parameterize  // replace literals with parameters
 ) {
 	ASSERT(q != NULL);
 
@@ -110,12 +115,16 @@ ExecutionCtx *ExecutionCtx_FromQuery
 
 	// parse and validate parameters only
 	// extract query string
-	// return invalid execution context if failed to parse params
-	cypher_parse_result_t *params_parse_result = parse_params(q, &q_str);
-
-	// parameter parsing failed, return NULL
-	if(params_parse_result == NULL) {
-		return NULL;
+	// literal parameters are decoded without invoking the cypher parser
+	// otherwise, return invalid execution context if failed to parse params
+	cypher_parse_result_t *params_parse_result = NULL;
+	if(!AST_FastParseParams(q, &q_str)) {
+		params_parse_result = parse_params(q, &q_str);
+
+		// parameter parsing failed, return NULL
+		if(params_parse_result == NULL) {
+			return NULL;
+		}
 	}
 
 	// seems like we should be able to free 'params_parse_result'
@@ -133,17 +142,34 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	QueryCtx *ctx = QueryCtx_GetQueryCtx();
 	ctx->query_data.query_no_params = q_str;
 
+	// replace literals with parameters
+	// such that queries which differ only by their literals share a plan
+	char *normalized = NULL;
+	if(parameterize) {
+		Config_Option_get(Config_CACHE_PARAMETERIZE, &parameterize);
+		if(parameterize) normalized = AST_ParameterizeLiterals(q_str);
+	}
+	const char *key = (normalized != NULL) ? normalized : q_str;
+
+	// AST nodes are named after the text they were parsed from
+	ctx->query_data.query_no_params = key;
+
 	// get cache
 	Cache *cache = GraphContext_GetCache(QueryCtx_GetGraphCtx());
 
 	// see if we already have a cached execution-ctx for given query
-	ret = Cache_GetValue(cache, q_str);
+	ret = track ? Cache_GetValue(cache, key) : Cache_PeekValue(cache, key);
 
 	//--------------------------------------------------------------------------
 	// cache hit
 	//--------------------------------------------------------------------------
 
 	if(ret != NULL) {
+		// name nodes after the text the cached AST was parsed from
+		if(ret->ast->query != NULL) {
+			ctx->query_data.query_no_params = ret->ast->query;
+		}
+		rm_free(normalized);
 		parse_result_free(params_parse_result);  // free parsed params
 		ret->cached = true;                      // mark cached execution
 		return ret;
@@ -154,7 +180,18 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	//--------------------------------------------------------------------------
 
 	// try to parse the query
-	AST *ast = _ExecutionCtx_ParseAST(q_str);
+	AST *ast = _ExecutionCtx_ParseAST(key);
+
+	// failed to parse the normalized query, fall back to the original query
+	// such that reported errors refer to the query as it was issued
+	if(ast == NULL && normalized != NULL) {
+		free(ErrorCtx_DetachError());
+		rm_free(normalized);
+		normalized = NULL;
+		key = q_str;
+		ctx->query_data.query_no_params = key;
+		ast = _ExecutionCtx_ParseAST(key);
+	}
 
 	// parser failed
 	if(ast == NULL) {
@@ -170,6 +207,12 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	// associate parameters with AST
 	AST_SetParamsParseResult(ast, params_parse_result);
 
+	// the AST outlives this call (cached), hand it the normalized text
+	if(normalized != NULL) {
+		AST_SetQueryText(ast, normalized);
+		normalized = NULL;
+	}
+
 	ExecutionType exec_type = _GetExecutionTypeFromAST(ast);
 	// in case of valid query
 	// create execution plan, and cache it and the AST
@@ -186,13 +229,15 @@ ExecutionCtx *ExecutionCtx_FromQuery
 		if(ErrorCtx_EncounteredError()) {
 			// failed to construct plan
 			// clean up and return NULL
+			// query text might be owned by the AST, stop referring to it
+			ctx->query_data.query_no_params = q_str;
 			AST_Free(ast);
 			ExecutionPlan_Free(plan);
 			return NULL;
 		}
 
 		ExecutionCtx *exec_ctx = _ExecutionCtx_New(ast, plan, exec_type);
-		ret = Cache_SetGetValue(cache, q_str, exec_ctx);
+		ret = Cache_SetGetValue(cache, key, exec_ctx);
 	} else {
 		ret = _ExecutionCtx_New(ast, NULL, exec_type);
 	}
@@ -200,6 +245,153 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	return ret;
 }
 
+// returns the objects and information required for query execution
+// if the query contains error, a ExecutionCtx struct with the AST
+// and Execution plan objects will be NULL
+// and EXECUTION_TYPE_INVALID is returned
+// returns ExecutionCtx populated with the current execution relevant objects
+ExecutionCtx *ExecutionCtx_FromQuery
+(
+	const char *q  // string representing the query
+) {
+	return _ExecutionCtx_FromQuery(q, true, true);
+}
+
+// returns the objects and information required for query execution
+// the plan is built from the query text as issued, literals aren't replaced
+// with parameters, such that a reported plan refers to the query's literals
+ExecutionCtx *ExecutionCtx_FromQueryText
+(
+	const char *q  // string representing the query
+) {
+	return _ExecutionCtx_FromQuery(q, true, false);
+}
+
+// make sure query's execution plan is cached
+// without affecting the cache's hit and miss statistics
+// expects the graph to be set in the query context
+// returns false and sets an error on failure
+bool ExecutionCtx_Warm
+(
+	const char *q  // string representing the query
+) {
+	ExecutionCtx *ctx = _ExecutionCtx_FromQuery(q, false, true);
+	if(ctx == NULL) return false;
+
+	// only queries are cached
+	bool cached = (ctx->exec_type == EXECUTION_TYPE_QUERY);
+	if(!cached) ErrorCtx_SetError(EMSG_CACHE_WARMUP_TYPE);
+
+	ExecutionCtx_Free(ctx);
+	return cached;
+}
+
+// returns false if query calls a procedure which modifies the graph
+static bool _ExecutionCtx_ReadOnlyProcedures
+(
+	const AST *ast
+) {
+	bool read_only = true;
+	const cypher_astnode_t **calls = AST_GetTypedNodes(ast->root,
+			CYPHER_AST_CALL);
+
+	uint n = array_len(calls);
+	for(uint i = 0; i < n && read_only; i++) {
+		const char *proc_name = cypher_ast_proc_name_get_value(
+				cypher_ast_call_get_proc_name(calls[i]));
+
+		ProcedureCtx *proc = Proc_Get(proc_name);
+		// unknown procedures are reported by the execution plan
+		if(proc == NULL) continue;
+
+		read_only = Procedure_IsReadOnly(proc);
+		Proc_Free(proc);
+
+		if(!read_only) {
+			ErrorCtx_SetError(EMSG_PREPARED_STATEMENT_PROCEDURE, proc_name);
+		}
+	}
+
+	array_free(calls);
+	return read_only;
+}
+
+// build an execution context for a prepared statement
+// the context is neither cached nor are the query's literals parameterized
+// parameters are provided upon execution, a parameters prefix is an error
+// only queries which don't call graph modifying procedures can be prepared
+// returns NULL and sets an error on failure
+ExecutionCtx *ExecutionCtx_Prepare
+(
+	const char *q,     // query string
+	const char **body  // [output] query string the plan was built from
+) {
+	ASSERT(q    != NULL);
+	ASSERT(body != NULL);
+
+	const char *q_str;  // query string excluding query parameters
+
+	if(unlikely(strlen(q) == 0)) {
+		ErrorCtx_SetError(EMSG_EMPTY_QUERY);
+		return NULL;
+	}
+
+	cypher_parse_result_t *params_parse_result = parse_params(q, &q_str);
+	if(params_parse_result == NULL) return NULL;
+
+	if(QueryCtx_GetParams() != NULL) {
+		parse_result_free(params_parse_result);
+		ErrorCtx_SetError(EMSG_PREPARED_STATEMENT_PARAMS);
+		return NULL;
+	}
+
+	if(unlikely(strlen(q_str) == 0)) {
+		parse_result_free(params_parse_result);
+		ErrorCtx_SetError(EMSG_EMPTY_QUERY);
+		return NULL;
+	}
+
+	// AST nodes are named after their text within the query
+	QueryCtx *ctx = QueryCtx_GetQueryCtx();
+	ctx->query_data.query_no_params = q_str;
+
+	AST *ast = _ExecutionCtx_ParseAST(q_str);
+	if(ast == NULL) {
+		parse_result_free(params_parse_result);
+		if(!ErrorCtx_EncounteredError()) {
+			ErrorCtx_SetError(EMSG_COULD_NOT_PARSE_QUERY);
+		}
+		return NULL;
+	}
+
+	// associate parameters with AST
+	AST_SetParamsParseResult(ast, params_parse_result);
+
+	// index operations and graph modifying procedures can't be
+	// replicated via effects, which executions of prepared statements rely on
+	if(_GetExecutionTypeFromAST(ast) != EXECUTION_TYPE_QUERY) {
+		AST_Free(ast);
+		ErrorCtx_SetError(EMSG_PREPARED_STATEMENT_TYPE);
+		return NULL;
+	}
+
+	if(!_ExecutionCtx_ReadOnlyProcedures(ast)) {
+		AST_Free(ast);
+		return NULL;
+	}
+
+	ExecutionPlan *plan = ExecutionPlan_FromTLS_AST();
+	if(ErrorCtx_EncounteredError()) {
+		AST_Free(ast);
+		ExecutionPlan_Free(plan);
+		return NULL;
+	}
+
+	// query body is owned by the AST
+	*body = q_str;
+	return _ExecutionCtx_New(ast, plan, EXECUTION_TYPE_QUERY);
+}
+
 // free an ExecutionCTX struct and its inner fields
 void ExecutionCtx_Free
 (
@@ -17,7 +17,7 @@ typedef enum {
 } ExecutionType;
 
  // a struct for saving execution objects in cache
-typedef struct {
+typedef struct ExecutionCtx {
 	AST *ast;                 // AST
 	bool cached;              // cache hit/miss
 	ExecutionPlan *plan;      // execution plan
@@ -34,6 +34,34 @@ ExecutionCtx *ExecutionCtx_FromQuery
 	const char *q  // string representing the query
 );
 
+// returns the objects and information required for query execution
+// the plan is built from the query text as issued, literals aren't replaced
+// with parameters, such that a reported plan refers to the query's literals
+ExecutionCtx *ExecutionCtx_FromQueryText
+(
+	const char *q  // string representing the query
+);
+
+// make sure query's execution plan is cached
+// without affecting the cache's hit and miss statistics
+// expects the graph to be set in the query context
+// returns false and sets an error on failure
+bool ExecutionCtx_Warm
+(
+	const char *q  // string representing the query
+);
+
+// build an execution context for a prepared statement
+// the context is neither cached nor are the query's literals parameterized
+// parameters are provided upon execution, a parameters prefix is an error
+// only queries which don't call graph modifying procedures can be prepared
+// returns NULL and sets an error on failure
+ExecutionCtx *ExecutionCtx_Prepare
+(
+	const char *q,     // query string
+	const char **body  // [output] query string the plan was built from
+);
+
 // clone the execution ctx and return a shallow copy for the ast
 // deep copy for the execution plan
 ExecutionCtx *ExecutionCtx_Clone
@@ -0,0 +1,218 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "rax.h"
+#include "execution_ctx.h"
+#include "prepared_statements.h"
+#include "../errors/errors.h"
+#include "../util/rmalloc.h"
+
+#include <pthread.h>
+
+// prepared statement
+typedef struct {
+	char *query;           // query string
+	ExecutionCtx *ctx;     // pinned execution context
+	XXH32_hash_t version;  // graph version statement was built against
+} PreparedStatement;
+
+struct PreparedStatements {
+	rax *statements;          // statement handle to statement
+	uint64_t next_handle;     // handle given to the next prepared statement
+	pthread_rwlock_t rwlock;  // protects registry
+};
+
+static PreparedStatement *_Find
+(
+	PreparedStatements *ps,
+	uint64_t handle
+) {
+	void *st = raxFind(ps->statements, (unsigned char *)&handle,
+			sizeof(handle));
+	return (st == raxNotFound) ? NULL : st;
+}
+
+static void _Statement_Free
+(
+	void *st
+) {
+	PreparedStatement *s = st;
+
+	ExecutionCtx_Free(s->ctx);
+	rm_free(s->query);
+	rm_free(s);
+}
+
+PreparedStatements *PreparedStatements_New(void) {
+	PreparedStatements *ps = rm_malloc(sizeof(PreparedStatements));
+
+	ps->statements  = raxNew();
+	ps->next_handle = 1;
+
+	int res = pthread_rwlock_init(&ps->rwlock, NULL);
+	UNUSED(res);
+	ASSERT(res == 0);
+
+	return ps;
+}
+
+uint64_t PreparedStatements_Add
+(
+	PreparedStatements *ps,
+	const char *query,
+	XXH32_hash_t version
+) {
+	ASSERT(ps    != NULL);
+	ASSERT(query != NULL);
+
+	// build outside of the lock
+	const char *body;
+	ExecutionCtx *ctx = ExecutionCtx_Prepare(query, &body);
+	if(ctx == NULL) return 0;
+
+	// keep the query string the plan was built from
+	// rebuilding from it yields the same query string
+	PreparedStatement *st = rm_malloc(sizeof(PreparedStatement));
+	st->ctx     = ctx;
+	st->query   = rm_strdup(body);
+	st->version = version;
+
+	pthread_rwlock_wrlock(&ps->rwlock);
+
+	uint64_t handle = ps->next_handle++;
+	raxInsert(ps->statements, (unsigned char *)&handle, sizeof(handle), st,
+			NULL);
+
+	pthread_rwlock_unlock(&ps->rwlock);
+
+	return handle;
+}
+
+ExecutionCtx *PreparedStatements_Get
+(
+	PreparedStatements *ps,
+	uint64_t handle,
+	XXH32_hash_t version,
+	char **query
+) {
+	ASSERT(ps    != NULL);
+	ASSERT(query != NULL);
+
+	ExecutionCtx *ret = NULL;
+
+	//--------------------------------------------------------------------------
+	// statement is up to date
+	//--------------------------------------------------------------------------
+
+	pthread_rwlock_rdlock(&ps->rwlock);
+
+	PreparedStatement *st = _Find(ps, handle);
+	if(st == NULL) {
+		pthread_rwlock_unlock(&ps->rwlock);
+		ErrorCtx_SetError(EMSG_UNKNOWN_PREPARED_STATEMENT,
+				(unsigned long long)handle);
+		return NULL;
+	}
+
+	*query = rm_strdup(st->query);
+
+	if(st->version == version) {
+		ret = ExecutionCtx_Clone(st->ctx);
+		pthread_rwlock_unlock(&ps->rwlock);
+		ret->cached = true;
+		return ret;
+	}
+
+	pthread_rwlock_unlock(&ps->rwlock);
+
+	//--------------------------------------------------------------------------
+	// graph schema changed, rebuild statement
+	//--------------------------------------------------------------------------
+
+	// build outside of the lock
+	const char *body;
+	ExecutionCtx *ctx = ExecutionCtx_Prepare(*query, &body);
+	if(ctx == NULL) goto error;
+
+	pthread_rwlock_wrlock(&ps->rwlock);
+
+	// statement might have been removed or rebuilt in the meantime
+	st = _Find(ps, handle);
+	if(st == NULL) {
+		pthread_rwlock_unlock(&ps->rwlock);
+		ExecutionCtx_Free(ctx);
+		ErrorCtx_SetError(EMSG_UNKNOWN_PREPARED_STATEMENT,
+				(unsigned long long)handle);
+		goto error;
+	}
+
+	if(st->version != version) {
+		ExecutionCtx_Free(st->ctx);
+		st->ctx     = ctx;
+		st->version = version;
+	} else {
+		ExecutionCtx_Free(ctx);
+	}
+
+	ret = ExecutionCtx_Clone(st->ctx);
+	pthread_rwlock_unlock(&ps->rwlock);
+
+	ret->cached = false;
+	return ret;
+
+error:
+	rm_free(*query);
+	*query = NULL;
+	return NULL;
+}
+
+bool PreparedStatements_Remove
+(
+	PreparedStatements *ps,
+	uint64_t handle
+) {
+	ASSERT(ps != NULL);
+
+	void *st = NULL;
+
+	pthread_rwlock_wrlock(&ps->rwlock);
+	raxRemove(ps->statements, (unsigned char *)&handle, sizeof(handle), &st);
+	pthread_rwlock_unlock(&ps->rwlock);
+
+	if(st == NULL) return false;
+
+	_Statement_Free(st);
+	return true;
+}
+
+uint64_t PreparedStatements_Count
+(
+	PreparedStatements *ps
+) {
+	ASSERT(ps != NULL);
+
+	pthread_rwlock_rdlock(&ps->rwlock);
+	uint64_t n = raxSize(ps->statements);
+	pthread_rwlock_unlock(&ps->rwlock);
+
+	return n;
+}
+
+void PreparedStatements_Free
+(
+	PreparedStatements *ps
+) {
+	ASSERT(ps != NULL);
+
+	raxFreeWithCallback(ps->statements, _Statement_Free);
+
+	int res = pthread_rwlock_destroy(&ps->rwlock);
+	UNUSED(res);
+	ASSERT(res == 0);
+
+	rm_free(ps);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "xxhash.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// forward declaration
+typedef struct ExecutionCtx ExecutionCtx;
+
+// per graph registry of prepared statements
+//
+// a prepared statement pins a validated execution context
+// which is never evicted, executing a statement skips query parsing
+// and the execution plans cache lookup altogether
+//
+// statements are bound to the graph version they were built against
+// once the graph's schema changes a statement is rebuilt upon its next execution
+//
+// statements live in memory only, they're neither persisted nor replicated
+typedef struct PreparedStatements PreparedStatements;
+
+// create a new, empty, registry
+PreparedStatements *PreparedStatements_New(void);
+
+// prepare query
+// returns statement handle, 0 and sets an error if query can't be prepared
+uint64_t PreparedStatements_Add
+(
+	PreparedStatements *ps,  // registry
+	const char *query,       // query to prepare
+	XXH32_hash_t version     // current graph version
+);
+
+// get a copy of statement's execution context
+// statement is rebuilt if it was prepared against a different graph version
+// returns NULL and sets an error if handle is unknown or rebuild failed
+ExecutionCtx *PreparedStatements_Get
+(
+	PreparedStatements *ps,  // registry
+	uint64_t handle,         // statement handle
+	XXH32_hash_t version,    // current graph version
+	char **query             // [output] statement's query, caller owns
+);
+
+// remove statement from registry
+// returns false if handle is unknown
+bool PreparedStatements_Remove
+(
+	PreparedStatements *ps,  // registry
+	uint64_t handle          // statement handle
+);
+
+// returns number of prepared statements
+uint64_t PreparedStatements_Count
+(
+	PreparedStatements *ps  // registry
+);
+
+// free registry and all of its statements
+void PreparedStatements_Free
+(
+	PreparedStatements *ps  // registry to free
+);
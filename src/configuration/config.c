@@ -64,6 +64,16 @@
 // effects replication threshold
 #define EFFECTS_THRESHOLD "EFFECTS_THRESHOLD"
 
+// max number of queued write queries committed under a single lock
+#define GROUP_COMMIT_SIZE "GROUP_COMMIT_SIZE"
+#define RESULTSET_STREAMING "RESULTSET_STREAMING"
+
+// number of hottest cached queries persisted per graph
+#define CACHE_PERSIST_SIZE "CACHE_PERSIST_SIZE"
+
+// replace query literals with parameters before the plan cache lookup
+#define CACHE_PARAMETERIZE "CACHE_PARAMETERIZE"
+
 
 //------------------------------------------------------------------------------
 // Configuration defaults
@@ -94,6 +104,10 @@ typedef struct {
 	bool cmd_info_on;                  // If true, the GRAPH.INFO is enabled.
 	uint64_t effects_threshold;        // replicate via effects when runtime exceeds threshold
 	uint32_t max_info_queries_count;   // Maximum number of query info elements.
+	uint64_t group_commit_size;        // max number of write queries committed together
+	bool resultset_streaming;          // if true, result-set rows are emitted as they're produced
+	uint64_t cache_persist_size;       // number of hot cached queries persisted per graph
+	bool cache_parameterize;           // if true, query literals are replaced with parameters
 } RG_Config;
 
 RG_Config config; // global module configuration
@@ -436,6 +450,66 @@ static uint64_t Config_effects_threshold_get (void) {
 	return config.effects_threshold;
 }
 
+//------------------------------------------------------------------------------
+// group commit size
+//------------------------------------------------------------------------------
+
+static void Config_group_commit_size_set
+(
+	uint64_t size
+) {
+	config.group_commit_size = size;
+}
+
+static uint64_t Config_group_commit_size_get(void) {
+	return config.group_commit_size;
+}
+
+//------------------------------------------------------------------------------
+// resultset streaming
+//------------------------------------------------------------------------------
+
+static void Config_resultset_streaming_set
+(
+	bool streaming
+) {
+	config.resultset_streaming = streaming;
+}
+
+static bool Config_resultset_streaming_get(void) {
+	return config.resultset_streaming;
+}
+
+//------------------------------------------------------------------------------
+// cache persist size
+//------------------------------------------------------------------------------
+
+static void Config_cache_persist_size_set
+(
+	uint64_t size
+) {
+	config.cache_persist_size = size;
+}
+
+static uint64_t Config_cache_persist_size_get(void) {
+	return config.cache_persist_size;
+}
+
+//------------------------------------------------------------------------------
+// cache parameterize
+//------------------------------------------------------------------------------
+
+static void Config_cache_parameterize_set
+(
+	bool parameterize
+) {
+	config.cache_parameterize = parameterize;
+}
+
+static bool Config_cache_parameterize_get(void) {
+	return config.cache_parameterize;
+}
+
 bool Config_Contains_field
 (
 	const char *field_str,
@@ -477,6 +551,14 @@ bool Config_Contains_field
 		f = Config_CMD_INFO_MAX_QUERY_COUNT;
 	} else if (!(strcasecmp(field_str, EFFECTS_THRESHOLD))) {
 		f = Config_EFFECTS_THRESHOLD;
+	} else if (!(strcasecmp(field_str, GROUP_COMMIT_SIZE))) {
+		f = Config_GROUP_COMMIT_SIZE;
+	} else if (!(strcasecmp(field_str, RESULTSET_STREAMING))) {
+		f = Config_RESULTSET_STREAMING;
+	} else if (!(strcasecmp(field_str, CACHE_PERSIST_SIZE))) {
+		f = Config_CACHE_PERSIST_SIZE;
+	} else if (!(strcasecmp(field_str, CACHE_PARAMETERIZE))) {
+		f = Config_CACHE_PARAMETERIZE;
 	} else {
 		return false;
 	}
@@ -555,6 +637,22 @@ const char *Config_Field_name
 			name = EFFECTS_THRESHOLD;
 			break;
 
+		case Config_GROUP_COMMIT_SIZE:
+			name = GROUP_COMMIT_SIZE;
+			break;
+
+		case Config_RESULTSET_STREAMING:
+			name = RESULTSET_STREAMING;
+			break;
+
+		case Config_CACHE_PERSIST_SIZE:
+			name = CACHE_PERSIST_SIZE;
+			break;
+
+		case Config_CACHE_PARAMETERIZE:
+			name = CACHE_PARAMETERIZE;
+			break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -622,6 +720,18 @@ static void _Config_SetToDefaults(void) {
 
 	// replicate effects if avg change time μs > effects_threshold μs
 	config.effects_threshold = 300 ;
+
+	// each write query commits on its own
+	config.group_commit_size = GROUP_COMMIT_SIZE_DEFAULT;
+
+	// result-set is buffered and emitted once the query completes
+	config.resultset_streaming = false;
+
+	// cached queries aren't persisted
+	config.cache_persist_size = 0;
+
+	// queries differing only by their literals share a cached plan
+	config.cache_parameterize = true;
 }
 
 int Config_Init
@@ -930,6 +1040,62 @@ bool Config_Option_get
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// group commit size
+		//----------------------------------------------------------------------
+
+		case Config_GROUP_COMMIT_SIZE: {
+			va_start(ap, field);
+			uint64_t *group_commit_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(group_commit_size != NULL);
+			(*group_commit_size) = Config_group_commit_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// resultset streaming
+		//----------------------------------------------------------------------
+
+		case Config_RESULTSET_STREAMING: {
+			va_start(ap, field);
+			bool *streaming = va_arg(ap, bool *);
+			va_end(ap);
+
+			ASSERT(streaming != NULL);
+			(*streaming) = Config_resultset_streaming_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// cache persist size
+		//----------------------------------------------------------------------
+
+		case Config_CACHE_PERSIST_SIZE: {
+			va_start(ap, field);
+			uint64_t *cache_persist_size = va_arg(ap, uint64_t *);
+			va_end(ap);
+
+			ASSERT(cache_persist_size != NULL);
+			(*cache_persist_size) = Config_cache_persist_size_get();
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// cache parameterize
+		//----------------------------------------------------------------------
+
+		case Config_CACHE_PARAMETERIZE: {
+			va_start(ap, field);
+			bool *parameterize = va_arg(ap, bool *);
+			va_end(ap);
+
+			ASSERT(parameterize != NULL);
+			(*parameterize) = Config_cache_parameterize_get();
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -1169,6 +1335,58 @@ bool Config_Option_set
 		}
 		break;
 
+		//----------------------------------------------------------------------
+		// group commit size
+		//----------------------------------------------------------------------
+
+		case Config_GROUP_COMMIT_SIZE: {
+			long long group_commit_size;
+			if(!_Config_ParsePositiveInteger(val, &group_commit_size)) {
+				return false;
+			}
+			if(group_commit_size > GROUP_COMMIT_SIZE_MAX) {
+				if(err) *err = "GROUP_COMMIT_SIZE can not exceed 1024";
+				return false;
+			}
+			Config_group_commit_size_set(group_commit_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// resultset streaming
+		//----------------------------------------------------------------------
+
+		case Config_RESULTSET_STREAMING: {
+			bool streaming = false;
+			if(!_Config_ParseYesNo(val, &streaming)) return false;
+			Config_resultset_streaming_set(streaming);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// cache persist size
+		//----------------------------------------------------------------------
+
+		case Config_CACHE_PERSIST_SIZE: {
+			long long cache_persist_size;
+			if(!_Config_ParseNonNegativeInteger(val, &cache_persist_size)) {
+				return false;
+			}
+			Config_cache_persist_size_set(cache_persist_size);
+		}
+		break;
+
+		//----------------------------------------------------------------------
+		// cache parameterize
+		//----------------------------------------------------------------------
+
+		case Config_CACHE_PARAMETERIZE: {
+			bool parameterize = true;
+			if(!_Config_ParseYesNo(val, &parameterize)) return false;
+			Config_cache_parameterize_set(parameterize);
+		}
+		break;
+
 		//----------------------------------------------------------------------
 		// invalid option
 		//----------------------------------------------------------------------
@@ -15,6 +15,8 @@
 #define QUERY_MEM_CAPACITY_UNLIMITED       0
 #define NODE_CREATION_BUFFER_DEFAULT       16384
 #define DELTA_MAX_PENDING_CHANGES_DEFAULT  10000
+#define GROUP_COMMIT_SIZE_DEFAULT          1
+#define GROUP_COMMIT_SIZE_MAX              1024
 
 typedef enum {
 	Config_TIMEOUT                   = 0,   // timeout value for queries
@@ -33,7 +35,11 @@ typedef enum {
 	Config_CMD_INFO                  = 13,  // toggle on/off the GRAPH.INFO
 	Config_CMD_INFO_MAX_QUERY_COUNT  = 14,  // the max number of info queries count
 	Config_EFFECTS_THRESHOLD         = 15,  // replicate queries via effects
-	Config_END_MARKER                = 16
+	Config_GROUP_COMMIT_SIZE         = 16,  // max number of write queries committed together
+	Config_RESULTSET_STREAMING       = 17,  // emit result-set rows as they're produced
+	Config_CACHE_PERSIST_SIZE        = 18,  // number of hot cached queries persisted
+	Config_CACHE_PARAMETERIZE        = 19,  // replace query literals with parameters
+	Config_END_MARKER                = 20
 } Config_Option_Field;
 
 // callback function, invoked once configuration changes as a result of
@@ -53,7 +59,11 @@ static const Config_Option_Field RUNTIME_CONFIGS[] = {
 	Config_DELTA_MAX_PENDING_CHANGES,
 	Config_CMD_INFO,
 	Config_CMD_INFO_MAX_QUERY_COUNT,
-	Config_EFFECTS_THRESHOLD
+	Config_EFFECTS_THRESHOLD,
+	Config_GROUP_COMMIT_SIZE,
+	Config_RESULTSET_STREAMING,
+	Config_CACHE_PERSIST_SIZE,
+	Config_CACHE_PARAMETERIZE
 };
 static const size_t RUNTIME_CONFIG_COUNT = sizeof(RUNTIME_CONFIGS) / sizeof(RUNTIME_CONFIGS[0]);
 
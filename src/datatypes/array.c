@@ -25,6 +25,12 @@ void SIArray_Append(SIValue *siarray, SIValue value) {
 	array_append(siarray->array, clone);
 }
 
+void SIArray_AppendAsOwner(SIValue *siarray, SIValue *value) {
+	// append and take ownership
+	array_append(siarray->array, *value);
+	SIValue_MakeVolatile(value);
+}
+
 SIValue SIArray_Get(SIValue siarray, uint32_t index) {
 	// check index
 	if(index >= SIArray_Length(siarray)) return SI_NullVal();
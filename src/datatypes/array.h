@@ -22,6 +22,14 @@ SIValue SIArray_New(u_int32_t initialCapacity);
   */
 void SIArray_Append(SIValue *siarray, SIValue value);
 
+/**
+  * @brief  Appends a new SIValue to a given array, array takes ownership
+  *         over value's allocation
+  * @param  siarray: pointer to array
+  * @param  value: new value, its allocation is set to volatile
+  */
+void SIArray_AppendAsOwner(SIValue *siarray, SIValue *value);
+
 /**
   * @brief  Returns a volatile copy of the SIValue from an array in a given index
   * @note   If index is out of bound, SI_NullVal is returned
@@ -10,6 +10,7 @@
 #include "set.h"
 #include "point.h"
 #include "array.h"
+#include "vector.h"
 #include "path/sipath.h"
 #include "temporal_value.h"
 
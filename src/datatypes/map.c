@@ -112,6 +112,23 @@ void Map_Add
 	array_append(map->map, pair);
 }
 
+// adds key/value to map without cloning them
+// map takes ownership over both key and value
+// caller must make sure key isn't already in map
+void Map_AddNoClone
+(
+	SIValue *map,
+	SIValue key,
+	SIValue value
+) {
+	ASSERT(SI_TYPE(*map) & T_MAP);
+	ASSERT(SI_TYPE(key) & T_STRING);
+	ASSERT(!Map_Contains(*map, key));
+
+	Pair pair = {.key = key, .val = value};
+	array_append(map->map, pair);
+}
+
 // removes key from map
 void Map_Remove
 (
@@ -51,6 +51,16 @@ void Map_Add
 	SIValue value  // value to add under key
 );
 
+// adds key/value to map without cloning them
+// map takes ownership over both key and value
+// caller must make sure key isn't already in map
+void Map_AddNoClone
+(
+	SIValue *map,  // map to add element to
+	SIValue key,   // key under which value is added
+	SIValue value  // value to add under key
+);
+
 // removes key from map
 void Map_Remove
 (
@@ -17,3 +17,12 @@ float Point_lon(SIValue point);
 // returns a coordinate (latitude or longitude) of a given point
 SIValue Point_GetCoordinate(SIValue point, SIValue key);
 
+// returns the distance in meters between two points
+double Point_Distance(SIValue a, SIValue b);
+
+// returns true if 'point' is within the bounding box
+// spanned by 'lower_left' and 'upper_right'
+// a box whose lower left longitude is greater than its upper right
+// longitude crosses the antimeridian
+bool Point_WithinBBox(SIValue point, SIValue lower_left, SIValue upper_right);
+
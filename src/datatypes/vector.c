@@ -0,0 +1,210 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "vector.h"
+#include "../util/rmalloc.h"
+
+#include <math.h>
+
+// number of independent accumulators used by the vector kernels
+// wide enough to fill a 256 bit register with 32 bit floats
+#define VECTOR_LANES 8
+
+SIValue SIVectorf32_New
+(
+	uint32_t dim  // vector dimension
+) {
+	SIVectorf32 *v = rm_calloc(1, sizeof(SIVectorf32) + sizeof(float) * dim);
+	v->dim = dim;
+
+	return (SIValue) {
+		.ptrval = v, .type = T_VECTOR_F32, .allocation = M_SELF
+	};
+}
+
+uint32_t SIVector_Dim
+(
+	SIValue vector
+) {
+	ASSERT(SI_TYPE(vector) == T_VECTOR_F32);
+
+	return ((SIVectorf32 *)vector.ptrval)->dim;
+}
+
+float *SIVector_Elements
+(
+	SIValue vector
+) {
+	ASSERT(SI_TYPE(vector) == T_VECTOR_F32);
+
+	return ((SIVectorf32 *)vector.ptrval)->values;
+}
+
+SIValue SIVector_Clone
+(
+	SIValue vector
+) {
+	ASSERT(SI_TYPE(vector) == T_VECTOR_F32);
+
+	uint32_t dim = SIVector_Dim(vector);
+	SIValue clone = SIVectorf32_New(dim);
+	memcpy(SIVector_Elements(clone), SIVector_Elements(vector),
+			sizeof(float) * dim);
+
+	return clone;
+}
+
+int SIVector_Compare
+(
+	SIValue a,
+	SIValue b
+) {
+	ASSERT(SI_TYPE(a) == T_VECTOR_F32);
+	ASSERT(SI_TYPE(b) == T_VECTOR_F32);
+
+	uint32_t a_dim = SIVector_Dim(a);
+	uint32_t b_dim = SIVector_Dim(b);
+	if(a_dim != b_dim) return (a_dim < b_dim) ? -1 : 1;
+
+	const float *a_values = SIVector_Elements(a);
+	const float *b_values = SIVector_Elements(b);
+	for(uint32_t i = 0; i < a_dim; i++) {
+		if(a_values[i] < b_values[i]) return -1;
+		if(a_values[i] > b_values[i]) return 1;
+	}
+
+	return 0;
+}
+
+XXH64_hash_t SIVector_HashCode
+(
+	SIValue vector
+) {
+	ASSERT(SI_TYPE(vector) == T_VECTOR_F32);
+
+	SIType t = T_VECTOR_F32;
+	XXH64_hash_t hashCode = XXH64(&t, sizeof(t), 0);
+
+	SIVectorf32 *v = (SIVectorf32 *)vector.ptrval;
+	return XXH64(v->values, sizeof(float) * v->dim, hashCode);
+}
+
+void SIVector_ToString
+(
+	SIValue vector,
+	char **buf,
+	size_t *bufferLen,
+	size_t *bytesWritten
+) {
+	ASSERT(SI_TYPE(vector) == T_VECTOR_F32);
+
+	uint32_t dim = SIVector_Dim(vector);
+	const float *values = SIVector_Elements(vector);
+
+	// each element requires at most 32 bytes including its separator
+	size_t required = 32 * (size_t)dim + 3;
+	if(*bufferLen - *bytesWritten < required) {
+		*bufferLen += required;
+		*buf = rm_realloc(*buf, sizeof(char) * *bufferLen);
+	}
+
+	*bytesWritten += sprintf(*buf + *bytesWritten, "<");
+	for(uint32_t i = 0; i < dim; i++) {
+		*bytesWritten += sprintf(*buf + *bytesWritten, (i == 0) ? "%f" : ", %f",
+				values[i]);
+	}
+	*bytesWritten += sprintf(*buf + *bytesWritten, ">");
+}
+
+void SIVector_Free
+(
+	SIValue vector
+) {
+	ASSERT(SI_TYPE(vector) == T_VECTOR_F32);
+
+	rm_free(vector.ptrval);
+}
+
+//------------------------------------------------------------------------------
+// vector kernels
+//------------------------------------------------------------------------------
+
+float Vector_Dot
+(
+	const float *restrict a,
+	const float *restrict b,
+	uint32_t dim
+) {
+	float acc[VECTOR_LANES] = {0};
+
+	uint32_t i = 0;
+	for(; i + VECTOR_LANES <= dim; i += VECTOR_LANES) {
+		for(uint32_t j = 0; j < VECTOR_LANES; j++) {
+			acc[j] += a[i + j] * b[i + j];
+		}
+	}
+
+	float sum = 0;
+	for(uint32_t j = 0; j < VECTOR_LANES; j++) sum += acc[j];
+
+	// remainder
+	for(; i < dim; i++) sum += a[i] * b[i];
+
+	return sum;
+}
+
+float Vector_L2Squared
+(
+	const float *restrict a,
+	const float *restrict b,
+	uint32_t dim
+) {
+	float acc[VECTOR_LANES] = {0};
+
+	uint32_t i = 0;
+	for(; i + VECTOR_LANES <= dim; i += VECTOR_LANES) {
+		for(uint32_t j = 0; j < VECTOR_LANES; j++) {
+			float d = a[i + j] - b[i + j];
+			acc[j] += d * d;
+		}
+	}
+
+	float sum = 0;
+	for(uint32_t j = 0; j < VECTOR_LANES; j++) sum += acc[j];
+
+	// remainder
+	for(; i < dim; i++) {
+		float d = a[i] - b[i];
+		sum += d * d;
+	}
+
+	return sum;
+}
+
+float Vector_EuclideanDistance
+(
+	const float *a,
+	const float *b,
+	uint32_t dim
+) {
+	return sqrtf(Vector_L2Squared(a, b, dim));
+}
+
+float Vector_CosineDistance
+(
+	const float *a,
+	const float *b,
+	uint32_t dim
+) {
+	float ab = Vector_Dot(a, b, dim);
+	float aa = Vector_Dot(a, a, dim);
+	float bb = Vector_Dot(b, b, dim);
+
+	if(aa == 0 || bb == 0) return 1;
+
+	return 1 - ab / (sqrtf(aa) * sqrtf(bb));
+}
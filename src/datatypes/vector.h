@@ -0,0 +1,114 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../value.h"
+#include "xxhash.h"
+
+// packed vector of 32 bit floats
+// elements are stored inline, right after the vector's dimension
+// a 768 dimensional vector occupies 3KB
+// compared to 12KB when represented as an array of doubles
+typedef struct {
+	uint32_t dim;     // number of elements
+	float values[];   // elements
+} SIVectorf32;
+
+// create a new vector of 'dim' zero elements
+SIValue SIVectorf32_New
+(
+	uint32_t dim  // vector dimension
+);
+
+// returns vector's dimension
+uint32_t SIVector_Dim
+(
+	SIValue vector  // vector to query
+);
+
+// returns vector's elements
+float *SIVector_Elements
+(
+	SIValue vector  // vector to query
+);
+
+// clones vector
+SIValue SIVector_Clone
+(
+	SIValue vector  // vector to clone
+);
+
+// compare two vectors
+// vectors are ordered by dimension, then element-wise
+int SIVector_Compare
+(
+	SIValue a,  // first vector
+	SIValue b   // second vector
+);
+
+// hash vector
+XXH64_hash_t SIVector_HashCode
+(
+	SIValue vector  // vector to hash
+);
+
+// writes a string representation of vector to buf
+// e.g. <0.100000, 0.200000>
+void SIVector_ToString
+(
+	SIValue vector,       // vector to represent
+	char **buf,           // buffer
+	size_t *bufferLen,    // buffer length
+	size_t *bytesWritten  // number of bytes written to buffer
+);
+
+// free vector
+void SIVector_Free
+(
+	SIValue vector  // vector to free
+);
+
+//------------------------------------------------------------------------------
+// vector kernels
+//------------------------------------------------------------------------------
+
+// kernels operate on raw float buffers of equal dimension
+// the loops are written over independent accumulator lanes
+// such that the compiler emits SIMD instructions for the target architecture
+
+// dot product of a and b
+float Vector_Dot
+(
+	const float *a,  // first vector
+	const float *b,  // second vector
+	uint32_t dim     // vectors dimension
+);
+
+// squared euclidean distance between a and b
+float Vector_L2Squared
+(
+	const float *a,  // first vector
+	const float *b,  // second vector
+	uint32_t dim     // vectors dimension
+);
+
+// euclidean distance between a and b
+float Vector_EuclideanDistance
+(
+	const float *a,  // first vector
+	const float *b,  // second vector
+	uint32_t dim     // vectors dimension
+);
+
+// cosine distance between a and b, 1 - cosine similarity
+// zero vectors are at distance 1 from every vector
+float Vector_CosineDistance
+(
+	const float *a,  // first vector
+	const float *b,  // second vector
+	uint32_t dim     // vectors dimension
+);
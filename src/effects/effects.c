@@ -6,7 +6,15 @@
 
 #include "RG.h"
 #include "effects.h"
+#include "effects_encoding.h"
 #include "../query_ctx.h"
+#include "../util/arr.h"
+#include "../datatypes/vector.h"
+#include "../util/rax_extensions.h"
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
+
+// payloads smaller than this aren't worth compressing
+#define EFFECTS_COMPRESSION_THRESHOLD 4096
 
 // determine block available space 
 #define BLOCK_AVAILABLE_SPACE(b) (b->cap - BLOCK_USED_SPACE(b))
@@ -22,21 +30,34 @@ struct EffectsBufferBlock {
 	unsigned char buffer[];           // buffer
 };
 
+// a group of consecutive effects sharing the same type and key
+// effects are staged column by column until an effect which can't join the
+// group arrives, at which point the group is encoded into the buffer
+typedef struct {
+	EffectType t;           // type of grouped effects, EFFECT_UNKNOWN if empty
+	uint64_t n;             // number of effects in group
+	RelationID r;           // relation ID of edge groups
+	LabelID *labels;        // label-set of node creation and label groups
+	uint64_t prev_id;       // previous entity ID, delta base
+	uint64_t prev_src;      // previous source node ID, delta base
+	uint64_t prev_dest;     // previous destination node ID, delta base
+	rax *dict;              // string dictionary, maps a string to its index
+	EffectsColumn strings;  // dictionary strings in index order
+	EffectsColumn ids;      // entity IDs column
+	EffectsColumn attrs;    // attribute counts and IDs column
+	EffectsColumn types;    // value types column
+	EffectsColumn values;   // value payloads column
+} EffectsGroup;
+
 // effects buffer is a linked-list of buffers
 struct _EffectsBuffer {
 	size_t block_size;                   // block size
 	struct EffectsBufferBlock *head;     // first block
 	struct EffectsBufferBlock *current;  // current block
 	uint64_t n;                          // number of effects in buffer
+	EffectsGroup group;                  // open group of effects
 };
 
-// forward declarations
-static void EffectsBuffer_WriteSIArray
-(
-	const SIValue *arr,  // array
-	EffectsBuffer *buff  // effect buffer
-);
-
 // create a new effects-buffer block
 static struct EffectsBufferBlock *EffectsBufferBlock_New
 (
@@ -117,132 +138,344 @@ static void EffectsBuffer_WriteBytes
 	}
 }
 
-static void EffectsBuffer_WriteString
+// write an unsigned varint into effects-buffer
+static void EffectsBuffer_WriteVarint
 (
-	const char *str,
-	EffectsBuffer *eb
+	uint64_t v,        // value to write
+	EffectsBuffer *eb  // effects-buffer
 ) {
-	ASSERT(eb  != NULL);
-	ASSERT(str != NULL);
+	unsigned char buff[10];
+	size_t n = 0;
 
-	size_t l = strlen(str) + 1;
-	EffectsBuffer_WriteBytes(&l, sizeof(size_t), eb);
-	EffectsBuffer_WriteBytes(str, l, eb);
+	while(v >= 0x80) {
+		buff[n++] = (uint8_t)(v | 0x80);
+		v >>= 7;
+	}
+	buff[n++] = (uint8_t)v;
+
+	EffectsBuffer_WriteBytes(buff, n, eb);
 }
 
-// writes a binary representation of v into Effect-Buffer
-static void EffectsBuffer_WriteSIValue
+// write a column into effects-buffer, prefixed by its length
+static void EffectsBuffer_WriteColumn
 (
-	const SIValue *v,
-	EffectsBuffer *buff
+	const EffectsColumn *col,  // column to write
+	EffectsBuffer *eb          // effects-buffer
 ) {
-	ASSERT(v != NULL);
-	ASSERT(buff != NULL);
+	EffectsBuffer_WriteVarint(col->len, eb);
+	if(col->len > 0) {
+		EffectsBuffer_WriteBytes(col->data, col->len, eb);
+	}
+}
 
-	// format:
-	//    type
-	//    value
-	bool b;
-	size_t len = 0;
+//------------------------------------------------------------------------------
+// effects group
+//------------------------------------------------------------------------------
 
-	SIType t = v->type;
+// add string to group's dictionary, returns string's index
+static uint64_t EffectsGroup_DictIndex
+(
+	EffectsGroup *g,  // group
+	const char *str   // string to look up
+) {
+	size_t l = strlen(str);
+	void *idx = raxFind(g->dict, (unsigned char *)str, l);
+	if(idx != raxNotFound) return (uint64_t)(uintptr_t)idx;
 
-	// write type
-	EffectsBuffer_WriteBytes(&t, sizeof(SIType), buff);
+	uint64_t i = raxSize(g->dict);
+	raxInsert(g->dict, (unsigned char *)str, l, (void *)(uintptr_t)i, NULL);
+
+	// dictionary strings are stored NULL terminated
+	EffectsColumn_WriteVarint(&g->strings, l + 1);
+	EffectsColumn_WriteBytes(&g->strings, str, l + 1);
+
+	return i;
+}
 
-	// write value
-	switch(t) {
+// write value's type and payload to group's value columns
+static void EffectsGroup_WriteSIValue
+(
+	EffectsGroup *g,  // group
+	const SIValue *v  // value to write
+) {
+	ASSERT(g != NULL);
+	ASSERT(v != NULL);
+
+	SIValue *elements;
+	uint32_t len;
+
+	switch(SI_TYPE(*v)) {
 		case T_POINT:
-			// write value to stream
-			EffectsBuffer_WriteBytes(&v->point, sizeof(Point), buff);
+			EffectsColumn_WriteByte(&g->types, EFFECTS_VAL_POINT);
+			EffectsColumn_WriteBytes(&g->values, &v->point, sizeof(Point));
 			break;
 		case T_ARRAY:
-			// write array to stream
-			EffectsBuffer_WriteSIArray(v, buff);
+			// element count followed by the elements
+			elements = v->array;
+			len = array_len(elements);
+			EffectsColumn_WriteByte(&g->types, EFFECTS_VAL_ARRAY);
+			EffectsColumn_WriteVarint(&g->values, len);
+			for(uint32_t i = 0; i < len; i++) {
+				EffectsGroup_WriteSIValue(g, elements + i);
+			}
+			break;
+		case T_VECTOR_F32:
+			// dimension followed by the packed elements
+			len = SIVector_Dim(*v);
+			EffectsColumn_WriteByte(&g->types, EFFECTS_VAL_VECF32);
+			EffectsColumn_WriteVarint(&g->values, len);
+			EffectsColumn_WriteBytes(&g->values, SIVector_Elements(*v),
+					sizeof(float) * len);
 			break;
 		case T_STRING:
-			EffectsBuffer_WriteString(v->stringval, buff);
+			EffectsColumn_WriteByte(&g->types, EFFECTS_VAL_STRING);
+			EffectsColumn_WriteVarint(&g->values,
+					EffectsGroup_DictIndex(g, v->stringval));
 			break;
 		case T_BOOL:
-			// write bool to stream
-			b = SIValue_IsTrue(*v);
-			EffectsBuffer_WriteBytes(&b, sizeof(bool), buff);
+			EffectsColumn_WriteByte(&g->types, SIValue_IsTrue(*v) ?
+					EFFECTS_VAL_TRUE : EFFECTS_VAL_FALSE);
 			break;
 		case T_INT64:
-			// write int to stream
-			EffectsBuffer_WriteBytes(&v->longval, sizeof(v->longval), buff);
+			EffectsColumn_WriteByte(&g->types, EFFECTS_VAL_INT);
+			EffectsColumn_WriteVarint(&g->values, Effects_ZigZag(v->longval));
 			break;
 		case T_DOUBLE:
-			// write double to stream
-			EffectsBuffer_WriteBytes(&v->doubleval, sizeof(v->doubleval), buff);
+			EffectsColumn_WriteByte(&g->types, EFFECTS_VAL_DOUBLE);
+			EffectsColumn_WriteBytes(&g->values, &v->doubleval,
+					sizeof(v->doubleval));
 			break;
 		case T_NULL:
 			// no additional data is required to represent NULL
+			EffectsColumn_WriteByte(&g->types, EFFECTS_VAL_NULL);
 			break;
 		default:
 			assert(false && "unknown SIValue type");
 	}
 }
 
-// writes a binary representation of arr into Effect-Buffer
-static void EffectsBuffer_WriteSIArray
+// write attribute-set to group's columns
+static void EffectsGroup_WriteAttributeSet
 (
-	const SIValue *arr,  // array
-	EffectsBuffer *buff  // effect buffer
+	EffectsGroup *g,          // group
+	const AttributeSet attrs  // attribute set to write
 ) {
-	// format:
-	// number of elements
-	// elements
-
-	SIValue *elements = arr->array;
-	uint32_t len = array_len(elements);
+	ushort attr_count = AttributeSet_Count(attrs);
+	EffectsColumn_WriteVarint(&g->attrs, attr_count);
 
-	// write number of elements
-	EffectsBuffer_WriteBytes(&len, sizeof(uint32_t), buff);
+	for(ushort i = 0; i < attr_count; i++) {
+		// get current attribute name and value
+		Attribute_ID attr_id;
+		SIValue attr = AttributeSet_GetIdx(attrs, i, &attr_id);
 
-	// write each element
-	for (uint32_t i = 0; i < len; i++) {
-		EffectsBuffer_WriteSIValue(elements + i, buff);
+		EffectsColumn_WriteVarint(&g->attrs, attr_id);
+		EffectsGroup_WriteSIValue(g, &attr);
 	}
 }
 
-// dump attributes to stream
-static void EffectsBuffer_WriteAttributeSet
+// encode group into effects-buffer and reset it
+static void EffectsBuffer_FlushGroup
 (
-	const AttributeSet attrs,  // attribute set to write to stream
-	EffectsBuffer *buff
+	EffectsBuffer *eb  // effects-buffer
 ) {
+	EffectsGroup *g = &eb->group;
+	if(g->n == 0) return;
+
 	//--------------------------------------------------------------------------
-	// write attribute count
+	// group format:
+	//    effect type
+	//    effect count
+	//    group key
+	//    dictionary
+	//    ids, attributes, value types and value payloads columns
 	//--------------------------------------------------------------------------
 
-	ushort attr_count = AttributeSet_Count(attrs);
-	EffectsBuffer_WriteBytes(&attr_count, sizeof(attr_count), buff);
+	uint8_t t = g->t;
+	EffectsBuffer_WriteBytes(&t, sizeof(t), eb);
+	EffectsBuffer_WriteVarint(g->n, eb);
 
-	//--------------------------------------------------------------------------
-	// write attributes
-	//--------------------------------------------------------------------------
+	if(Effects_KeyedByLabels(g->t)) {
+		uint32_t lbl_count = array_len(g->labels);
+		EffectsBuffer_WriteVarint(lbl_count, eb);
+		for(uint32_t i = 0; i < lbl_count; i++) {
+			EffectsBuffer_WriteVarint(g->labels[i], eb);
+		}
+	} else if(Effects_KeyedByRelation(g->t)) {
+		EffectsBuffer_WriteVarint(g->r, eb);
+	}
 
-	for(ushort i = 0; i < attr_count; i++) {
-		// get current attribute name and value
-		Attribute_ID attr_id;
-		SIValue attr = AttributeSet_GetIdx(attrs, i, &attr_id);
+	EffectsBuffer_WriteVarint(raxSize(g->dict), eb);
+	if(g->strings.len > 0) {
+		EffectsBuffer_WriteBytes(g->strings.data, g->strings.len, eb);
+	}
 
-		// write attribute ID
-		EffectsBuffer_WriteBytes(&attr_id, sizeof(Attribute_ID), buff);
+	EffectsBuffer_WriteColumn(&g->ids,    eb);
+	EffectsBuffer_WriteColumn(&g->attrs,  eb);
+	EffectsBuffer_WriteColumn(&g->types,  eb);
+	EffectsBuffer_WriteColumn(&g->values, eb);
 
-		// write attribute value
-		EffectsBuffer_WriteSIValue(&attr, buff);
+	// reset group, keeping column allocations
+	if(raxSize(g->dict) > 0) {
+		raxFree(g->dict);
+		g->dict = raxNew();
 	}
+
+	g->t         = EFFECT_UNKNOWN;
+	g->n         = 0;
+	g->r         = GRAPH_UNKNOWN_RELATION;
+	g->prev_id   = 0;
+	g->prev_src  = 0;
+	g->prev_dest = 0;
+
+	array_clear(g->labels);
+	EffectsColumn_Clear(&g->strings);
+	EffectsColumn_Clear(&g->ids);
+	EffectsColumn_Clear(&g->attrs);
+	EffectsColumn_Clear(&g->types);
+	EffectsColumn_Clear(&g->values);
 }
 
-static inline void EffectsBuffer_IncEffectCount
+// get a group to which an effect of type 't' can be added
+// flushes the open group if it can't accommodate the effect
+static EffectsGroup *EffectsBuffer_GetGroup
 (
-	EffectsBuffer *buff
+	EffectsBuffer *eb,      // effects-buffer
+	EffectType t,           // effect type
+	const LabelID *labels,  // effect's label-set
+	uint lbl_count,         // number of labels
+	RelationID r            // effect's relation ID
 ) {
-	ASSERT(buff != NULL);
-	
-	buff->n++;
+	EffectsGroup *g = &eb->group;
+
+	// check if effect can join the open group
+	bool match = (g->n > 0 && g->t == t);
+	if(match && Effects_KeyedByLabels(t)) {
+		match = (array_len(g->labels) == lbl_count &&
+			(lbl_count == 0 ||
+			 memcmp(g->labels, labels, sizeof(LabelID) * lbl_count) == 0));
+	} else if(match && Effects_KeyedByRelation(t)) {
+		match = (g->r == r);
+	}
+
+	if(!match) {
+		EffectsBuffer_FlushGroup(eb);
+
+		// open a new group
+		g->t = t;
+		g->r = r;
+		for(uint i = 0; i < lbl_count; i++) {
+			array_append(g->labels, labels[i]);
+		}
+	}
+
+	g->n++;
+	eb->n++;
+
+	return g;
+}
+
+static void EffectsGroup_Free
+(
+	EffectsGroup *g
+) {
+	array_free(g->labels);
+	raxFree(g->dict);
+	EffectsColumn_Free(&g->strings);
+	EffectsColumn_Free(&g->ids);
+	EffectsColumn_Free(&g->attrs);
+	EffectsColumn_Free(&g->types);
+	EffectsColumn_Free(&g->values);
+}
+
+//------------------------------------------------------------------------------
+// compression
+//------------------------------------------------------------------------------
+
+// LZ4 compress payload
+// compression is carried out by GraphBLAS which bundles LZ4, 'payload' is
+// wrapped by a dense uint8 vector and serialized using LZ4 compression
+// returns NULL if compression failed
+static void *_Effects_Compress
+(
+	unsigned char **payload,  // payload to compress, ownership is retained
+	size_t n,                 // payload size
+	size_t *compressed_size   // [output] compressed payload size
+) {
+	ASSERT(n > 0);
+	ASSERT(payload != NULL && *payload != NULL);
+
+	GrB_Info info;
+	GrB_Vector v;
+	GrB_Descriptor desc;
+	void *blob = NULL;
+	GrB_Index blob_size = 0;
+
+	info = GrB_Vector_new(&v, GrB_UINT8, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	// move payload into vector, O(1) no copy is performed
+	void *vx = *payload;
+	info = GxB_Vector_pack_Full(v, &vx, n, false, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Descriptor_new(&desc);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Desc_set(desc, GxB_COMPRESSION, GxB_COMPRESSION_LZ4);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_Vector_serialize(&blob, &blob_size, v, desc);
+	if(info != GrB_SUCCESS) blob = NULL;
+
+	// reclaim payload
+	bool iso;
+	GrB_Index vx_size;
+	info = GxB_Vector_unpack_Full(v, &vx, &vx_size, &iso, NULL);
+	ASSERT(info == GrB_SUCCESS);
+	ASSERT(iso == false);
+	*payload = vx;
+
+	GrB_free(&v);
+	GrB_free(&desc);
+
+	*compressed_size = blob_size;
+	return blob;
+}
+
+// encode effects-buffer header followed by payload into a single buffer
+static unsigned char *_Effects_EncodeHeader
+(
+	uint8_t codec,              // payload codec
+	uint64_t raw_size,          // uncompressed payload size
+	const unsigned char *data,  // payload
+	size_t data_size,           // payload size
+	size_t *n                   // [output] size of returned buffer
+) {
+	uint8_t v = EFFECTS_VERSION;
+	uint64_t ts = RedisModule_Milliseconds();  // used to compute replica lag
+	size_t header_size = sizeof(v) + sizeof(ts) + sizeof(codec);
+	if(codec != EFFECTS_CODEC_NONE) header_size += sizeof(raw_size);
+
+	unsigned char *buffer = rm_malloc(header_size + data_size);
+	unsigned char *offset = buffer;
+
+	memcpy(offset, &v, sizeof(v));
+	offset += sizeof(v);
+
+	memcpy(offset, &ts, sizeof(ts));
+	offset += sizeof(ts);
+
+	memcpy(offset, &codec, sizeof(codec));
+	offset += sizeof(codec);
+
+	if(codec != EFFECTS_CODEC_NONE) {
+		memcpy(offset, &raw_size, sizeof(raw_size));
+		offset += sizeof(raw_size);
+	}
+
+	if(data_size > 0) memcpy(offset, data, data_size);
+
+	*n = header_size + data_size;
+	return buffer;
 }
 
 // create a new effects-buffer
@@ -251,7 +484,7 @@ EffectsBuffer *EffectsBuffer_New
 	void
 ) {
 	size_t n = 62500;  // initial size of buffer
-	EffectsBuffer *eb = rm_malloc(sizeof(EffectsBuffer));
+	EffectsBuffer *eb = rm_calloc(1, sizeof(EffectsBuffer));
 
 	struct EffectsBufferBlock *b = EffectsBufferBlock_New(n);
 
@@ -260,9 +493,13 @@ EffectsBuffer *EffectsBuffer_New
 	eb->current    = b;
 	eb->block_size = n;
 
-	// write effects version to newly created buffer
-	uint8_t v = EFFECTS_VERSION;
-	EffectsBuffer_WriteBytes(&v, sizeof(v), eb);
+	eb->group.t      = EFFECT_UNKNOWN;
+	eb->group.r      = GRAPH_UNKNOWN_RELATION;
+	eb->group.dict   = raxNew();
+	eb->group.labels = array_new(LabelID, 0);
+
+	// effects version is written once the buffer is finalized
+	// see: EffectsBuffer_Buffer
 
 	return eb;
 }
@@ -280,11 +517,14 @@ uint64_t EffectsBuffer_Length
 // get a copy of effects-buffer internal buffer
 unsigned char *EffectsBuffer_Buffer
 (
-	const EffectsBuffer *eb,  // effects-buffer
-	size_t *n                 // size of returned buffer
+	EffectsBuffer *eb,  // effects-buffer
+	size_t *n           // size of returned buffer
 ) {
 	ASSERT(eb != NULL);
 
+	// encode pending group
+	EffectsBuffer_FlushGroup(eb);
+
 	//--------------------------------------------------------------------------
 	// determine required buffer size
 	//--------------------------------------------------------------------------
@@ -297,11 +537,11 @@ unsigned char *EffectsBuffer_Buffer
 	}
 
 	//--------------------------------------------------------------------------
-	// allocate buffer and populate
+	// allocate payload and populate
 	//--------------------------------------------------------------------------
 
-	unsigned char *buffer = rm_malloc(sizeof(unsigned char) * l);
-	unsigned char *offset = buffer;
+	unsigned char *payload = rm_malloc(sizeof(unsigned char) * (l + 1));
+	unsigned char *offset = payload;
 
 	b = eb->head;
 	while(b != NULL) {
@@ -314,10 +554,64 @@ unsigned char *EffectsBuffer_Buffer
 		b = b->next;
 	}
 
-	*n = l;
+	//--------------------------------------------------------------------------
+	// compress large payloads
+	//--------------------------------------------------------------------------
+
+	unsigned char *buffer = NULL;
+
+	if(l >= EFFECTS_COMPRESSION_THRESHOLD) {
+		size_t compressed_size;
+		void *compressed = _Effects_Compress(&payload, l, &compressed_size);
+
+		// use compressed payload only if it is actually smaller
+		if(compressed != NULL && compressed_size < l) {
+			buffer = _Effects_EncodeHeader(EFFECTS_CODEC_LZ4, l, compressed,
+					compressed_size, n);
+		}
+
+		if(compressed != NULL) rm_free(compressed);
+	}
+
+	if(buffer == NULL) {
+		buffer = _Effects_EncodeHeader(EFFECTS_CODEC_NONE, l, payload, l, n);
+	}
+
+	rm_free(payload);
 	return buffer;
 }
 
+// append the effects of 'src' to the end of 'dst'
+// used to combine the effects of multiple queries into a single buffer
+void EffectsBuffer_Append
+(
+	EffectsBuffer *dst,  // effects-buffer to extend
+	EffectsBuffer *src   // effects-buffer to copy effects from
+) {
+	ASSERT(dst != NULL);
+	ASSERT(src != NULL);
+	ASSERT(dst != src);
+
+	// groups are self contained, encode both open groups
+	// and concatenate src's groups to dst
+	EffectsBuffer_FlushGroup(dst);
+	EffectsBuffer_FlushGroup(src);
+
+	struct EffectsBufferBlock *b = src->head;
+
+	while(b != NULL) {
+		size_t n = BLOCK_USED_SPACE(b);
+		if(n > 0) {
+			EffectsBuffer_WriteBytes(b->buffer, n, dst);
+		}
+
+		// advance to next block
+		b = b->next;
+	}
+
+	dst->n += src->n;
+}
+
 //------------------------------------------------------------------------------
 // effects creation API
 //------------------------------------------------------------------------------
@@ -332,42 +626,24 @@ void EffectsBuffer_AddCreateNodeEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	// effect type
-	// label count
-	// labels
-	// attribute count
-	// attributes (id,value) pair
+	// group key: labels
+	// attributes column: attribute count, attribute IDs
+	// values columns: attribute values
 	//--------------------------------------------------------------------------
 	
 	ResultSetStatistics *stats = QueryCtx_GetResultSetStatistics();
 	stats->nodes_created++;
 	stats->properties_set += AttributeSet_Count(*n->attributes);
 
-	EffectType t = EFFECT_CREATE_NODE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
-
-	//--------------------------------------------------------------------------
-	// write label count
-	//--------------------------------------------------------------------------
-
-	EffectsBuffer_WriteBytes(&label_count, sizeof(label_count), buff);
-
-	//--------------------------------------------------------------------------
-	// write labels
-	//--------------------------------------------------------------------------
-
-	if(label_count > 0) {
-		EffectsBuffer_WriteBytes(labels, sizeof(LabelID) * label_count, buff);
-	}
+	EffectsGroup *g = EffectsBuffer_GetGroup(buff, EFFECT_CREATE_NODE, labels,
+			label_count, GRAPH_UNKNOWN_RELATION);
 
 	//--------------------------------------------------------------------------
 	// write attribute set
 	//--------------------------------------------------------------------------
 
 	const AttributeSet attrs = GraphEntity_GetAttributes((const GraphEntity*)n);
-	EffectsBuffer_WriteAttributeSet(attrs, buff);
-
-	EffectsBuffer_IncEffectCount(buff);
+	EffectsGroup_WriteAttributeSet(g, attrs);
 }
 
 // add a edge creation effect to buffer
@@ -378,54 +654,33 @@ void EffectsBuffer_AddCreateEdgeEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	// effect type
-	// relationship count
-	// relationships
-	// src node ID
-	// dest node ID
-	// attribute count
-	// attributes (id,value) pair
+	// group key: relationship type
+	// ids column: src node ID, dest node ID
+	// attributes column: attribute count, attribute IDs
+	// values columns: attribute values
 	//--------------------------------------------------------------------------
 	
 	ResultSetStatistics *stats = QueryCtx_GetResultSetStatistics();
 	stats->relationships_created++;
 	stats->properties_set += AttributeSet_Count(*edge->attributes);
 
-	EffectType t = EFFECT_CREATE_EDGE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
-
-	//--------------------------------------------------------------------------
-	// write relationship type
-	//--------------------------------------------------------------------------
-
-	ushort rel_count = 1;
-	EffectsBuffer_WriteBytes(&rel_count, sizeof(rel_count), buff);
-
 	RelationID rel_id = Edge_GetRelationID(edge);
-	EffectsBuffer_WriteBytes(&rel_id, sizeof(RelationID), buff);
+	EffectsGroup *g = EffectsBuffer_GetGroup(buff, EFFECT_CREATE_EDGE, NULL, 0,
+			rel_id);
 
 	//--------------------------------------------------------------------------
-	// write src node ID
+	// write src and dest node IDs
 	//--------------------------------------------------------------------------
 	
-	NodeID src_id = Edge_GetSrcNodeID(edge);
-	EffectsBuffer_WriteBytes(&src_id, sizeof(NodeID), buff);
-
-	//--------------------------------------------------------------------------
-	// write dest node ID
-	//--------------------------------------------------------------------------
-
-	NodeID dest_id = Edge_GetDestNodeID(edge);
-	EffectsBuffer_WriteBytes(&dest_id, sizeof(NodeID), buff);
+	EffectsColumn_WriteDelta(&g->ids, Edge_GetSrcNodeID(edge), &g->prev_src);
+	EffectsColumn_WriteDelta(&g->ids, Edge_GetDestNodeID(edge), &g->prev_dest);
 
 	//--------------------------------------------------------------------------
 	// write attribute set 
 	//--------------------------------------------------------------------------
 
 	const AttributeSet attrs = GraphEntity_GetAttributes((GraphEntity*)edge);
-	EffectsBuffer_WriteAttributeSet(attrs, buff);
-
-	EffectsBuffer_IncEffectCount(buff);
+	EffectsGroup_WriteAttributeSet(g, attrs);
 }
 
 // add a node deletion effect to buffer
@@ -436,19 +691,16 @@ void EffectsBuffer_AddDeleteNodeEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	//    effect type
-	//    node ID
+	//    ids column: node ID
 	//--------------------------------------------------------------------------
 
 	QueryCtx_GetResultSetStatistics()->nodes_deleted++;
 
-	EffectType t = EFFECT_DELETE_NODE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsGroup *g = EffectsBuffer_GetGroup(buff, EFFECT_DELETE_NODE, NULL, 0,
+			GRAPH_UNKNOWN_RELATION);
 
 	// write node ID
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(node), sizeof(EntityID), buff);
-
-	EffectsBuffer_IncEffectCount(buff);
+	EffectsColumn_WriteDelta(&g->ids, ENTITY_GET_ID(node), &g->prev_id);
 }
 
 // add a edge deletion effect to buffer
@@ -459,30 +711,19 @@ void EffectsBuffer_AddDeleteEdgeEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	//    effect type
-	//    edge ID
-	//    relation ID
-	//    src ID
-	//    dest ID
+	//    group key: relation ID
+	//    ids column: edge ID, src ID, dest ID
 	//--------------------------------------------------------------------------
 
 	QueryCtx_GetResultSetStatistics()->relationships_deleted++;
 
-	EffectType t = EFFECT_DELETE_EDGE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), eb);
-
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(edge), sizeof(EntityID), eb);
-
 	RelationID r_id = Edge_GetRelationID(edge);
-	EffectsBuffer_WriteBytes(&r_id, sizeof(RelationID), eb);
+	EffectsGroup *g = EffectsBuffer_GetGroup(eb, EFFECT_DELETE_EDGE, NULL, 0,
+			r_id);
 
-	NodeID src_id = Edge_GetSrcNodeID(edge);
-	EffectsBuffer_WriteBytes(&src_id, sizeof(EntityID), eb);
-
-	NodeID dest_id = Edge_GetDestNodeID(edge);
-	EffectsBuffer_WriteBytes(&dest_id, sizeof(EntityID), eb);
-
-	EffectsBuffer_IncEffectCount(eb);
+	EffectsColumn_WriteDelta(&g->ids, ENTITY_GET_ID(edge), &g->prev_id);
+	EffectsColumn_WriteDelta(&g->ids, Edge_GetSrcNodeID(edge), &g->prev_src);
+	EffectsColumn_WriteDelta(&g->ids, Edge_GetDestNodeID(edge), &g->prev_dest);
 };
 
 // add an entity update effect to buffer
@@ -495,34 +736,17 @@ static void EffectsBuffer_AddNodeUpdateEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	//    effect type
-	//    entity ID
-	//    attribute id
-	//    attribute value
-	//--------------------------------------------------------------------------
-
-	EffectType t = EFFECT_UPDATE_NODE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
-
-	//--------------------------------------------------------------------------
-	// write entity ID
+	//    ids column: entity ID
+	//    attributes column: attribute id
+	//    values columns: attribute value
 	//--------------------------------------------------------------------------
 
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(node), sizeof(EntityID), buff);
+	EffectsGroup *g = EffectsBuffer_GetGroup(buff, EFFECT_UPDATE_NODE, NULL, 0,
+			GRAPH_UNKNOWN_RELATION);
 
-	//--------------------------------------------------------------------------
-	// write attribute ID
-	//--------------------------------------------------------------------------
-	
-	EffectsBuffer_WriteBytes(&attr_id, sizeof(Attribute_ID), buff);
-
-	//--------------------------------------------------------------------------
-	// write attribute value
-	//--------------------------------------------------------------------------
-
-	EffectsBuffer_WriteSIValue(&value, buff);
-
-	EffectsBuffer_IncEffectCount(buff);
+	EffectsColumn_WriteDelta(&g->ids, ENTITY_GET_ID(node), &g->prev_id);
+	EffectsColumn_WriteVarint(&g->attrs, attr_id);
+	EffectsGroup_WriteSIValue(g, &value);
 }
 
 // add an entity update effect to buffer
@@ -535,58 +759,21 @@ static void EffectsBuffer_AddEdgeUpdateEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	//    effect type
-	//    edge ID
-	//    relation ID
-	//    src ID
-	//    dest ID
-	//    attribute count (=n)
-	//    attributes (id,value) pair
-	//--------------------------------------------------------------------------
-
-	EffectType t = EFFECT_UPDATE_EDGE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
-
-	//--------------------------------------------------------------------------
-	// write edge ID
-	//--------------------------------------------------------------------------
-
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(edge), sizeof(EntityID), buff);
-
-	//--------------------------------------------------------------------------
-	// write relation ID
+	//    group key: relation ID
+	//    ids column: edge ID, src ID, dest ID
+	//    attributes column: attribute id
+	//    values columns: attribute value
 	//--------------------------------------------------------------------------
 
 	RelationID r = Edge_GetRelationID(edge);
-	EffectsBuffer_WriteBytes(&r, sizeof(RelationID), buff);
-
-	//--------------------------------------------------------------------------
-	// write src ID
-	//--------------------------------------------------------------------------
-
-	NodeID s = Edge_GetSrcNodeID(edge);
-	EffectsBuffer_WriteBytes(&s, sizeof(NodeID), buff);
-
-	//--------------------------------------------------------------------------
-	// write dest ID
-	//--------------------------------------------------------------------------
-
-	NodeID d = Edge_GetDestNodeID(edge);
-	EffectsBuffer_WriteBytes(&d, sizeof(NodeID), buff);
-
-	//--------------------------------------------------------------------------
-	// write attribute ID
-	//--------------------------------------------------------------------------
-
-	EffectsBuffer_WriteBytes(&attr_id, sizeof(Attribute_ID), buff);
-
-	//--------------------------------------------------------------------------
-	// write attribute value
-	//--------------------------------------------------------------------------
-
-	EffectsBuffer_WriteSIValue(&value, buff);
-
-	EffectsBuffer_IncEffectCount(buff);
+	EffectsGroup *g = EffectsBuffer_GetGroup(buff, EFFECT_UPDATE_EDGE, NULL, 0,
+			r);
+
+	EffectsColumn_WriteDelta(&g->ids, ENTITY_GET_ID(edge), &g->prev_id);
+	EffectsColumn_WriteDelta(&g->ids, Edge_GetSrcNodeID(edge), &g->prev_src);
+	EffectsColumn_WriteDelta(&g->ids, Edge_GetDestNodeID(edge), &g->prev_dest);
+	EffectsColumn_WriteVarint(&g->attrs, attr_id);
+	EffectsGroup_WriteSIValue(g, &value);
 }
 
 // add an entity attribute removal effect to buffer
@@ -653,7 +840,7 @@ void EffectsBuffer_AddEntityUpdateAttributeEffect
 }
 
 // add a node add label effect to buffer
-void EffectsBuffer_AddSetRemoveLabelsEffect
+static void EffectsBuffer_AddSetRemoveLabelsEffect
 (
 	EffectsBuffer *buff,     // effect buffer
 	const Node *node,        // updated node
@@ -663,24 +850,15 @@ void EffectsBuffer_AddSetRemoveLabelsEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	//    effect type
-	//    node ID
-	//    labels count
-	//    label IDs
+	//    group key: label IDs
+	//    ids column: node ID
 	//--------------------------------------------------------------------------
 
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsGroup *g = EffectsBuffer_GetGroup(buff, t, lbl_ids, lbl_count,
+			GRAPH_UNKNOWN_RELATION);
 
 	// write node ID
-	EffectsBuffer_WriteBytes(&ENTITY_GET_ID(node), sizeof(EntityID), buff); 
-	
-	// write labels count
-	EffectsBuffer_WriteBytes(&lbl_count, sizeof(lbl_count), buff); 
-	
-	// write label IDs
-	EffectsBuffer_WriteBytes(lbl_ids, sizeof(LabelID) * lbl_count, buff);
-
-	EffectsBuffer_IncEffectCount(buff);
+	EffectsColumn_WriteDelta(&g->ids, ENTITY_GET_ID(node), &g->prev_id);
 }
 
 // add a node add labels effect to buffer
@@ -691,20 +869,10 @@ void EffectsBuffer_AddLabelsEffect
 	const LabelID *lbl_ids,  // added labels
 	size_t lbl_count         // number of removed labels
 ) {
-	//--------------------------------------------------------------------------
-	// effect format:
-	//    effect type
-	//    node ID
-	//    labels count
-	//    label IDs
-	//--------------------------------------------------------------------------
-
 	QueryCtx_GetResultSetStatistics()->labels_added += lbl_count;
 
 	EffectType t = EFFECT_SET_LABELS;
 	EffectsBuffer_AddSetRemoveLabelsEffect(buff, node, lbl_ids, lbl_count, t);
-
-	EffectsBuffer_IncEffectCount(buff);
 }
 
 // add a node remove labels effect to buffer
@@ -715,20 +883,10 @@ void EffectsBuffer_AddRemoveLabelsEffect
 	const LabelID *lbl_ids,  // removed labels
 	size_t lbl_count         // number of removed labels
 ) {
-	//--------------------------------------------------------------------------
-	// effect format:
-	//    effect type
-	//    node ID
-	//    labels count
-	//    label IDs
-	//--------------------------------------------------------------------------
-
 	QueryCtx_GetResultSetStatistics()->labels_removed += lbl_count;
 
 	EffectType t = EFFECT_REMOVE_LABELS;
 	EffectsBuffer_AddSetRemoveLabelsEffect(buff, node, lbl_ids, lbl_count, t);
-
-	EffectsBuffer_IncEffectCount(buff);
 }
 
 // add a schema addition effect to buffer
@@ -740,27 +898,18 @@ void EffectsBuffer_AddNewSchemaEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	//    effect type
-	//    schema type
-	//    schema name
+	//    attributes column: schema type
+	//    values column: schema name
 	//--------------------------------------------------------------------------
 
-	EffectType t = EFFECT_ADD_SCHEMA;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
+	EffectsGroup *g = EffectsBuffer_GetGroup(buff, EFFECT_ADD_SCHEMA, NULL, 0,
+			GRAPH_UNKNOWN_RELATION);
 
-	//--------------------------------------------------------------------------
-	// write schema type
-	//--------------------------------------------------------------------------
-
-	EffectsBuffer_WriteBytes(&st, sizeof(st), buff);
-
-	//--------------------------------------------------------------------------
-	// write schema name
-	//--------------------------------------------------------------------------
+	EffectsColumn_WriteVarint(&g->attrs, st);
 
-	EffectsBuffer_WriteString(schema_name, buff);
-
-	EffectsBuffer_IncEffectCount(buff);
+	size_t l = strlen(schema_name) + 1;
+	EffectsColumn_WriteVarint(&g->values, l);
+	EffectsColumn_WriteBytes(&g->values, schema_name, l);
 }
 
 // add an attribute addition effect to buffer
@@ -771,20 +920,15 @@ void EffectsBuffer_AddNewAttributeEffect
 ) {
 	//--------------------------------------------------------------------------
 	// effect format:
-	// effect type
-	// attribute name
-	//--------------------------------------------------------------------------
-
-	EffectType t = EFFECT_ADD_ATTRIBUTE;
-	EffectsBuffer_WriteBytes(&t, sizeof(t), buff);
-
-	//--------------------------------------------------------------------------
-	// write attribute name
+	//    values column: attribute name
 	//--------------------------------------------------------------------------
 
-	EffectsBuffer_WriteString(attr, buff);
+	EffectsGroup *g = EffectsBuffer_GetGroup(buff, EFFECT_ADD_ATTRIBUTE, NULL,
+			0, GRAPH_UNKNOWN_RELATION);
 
-	EffectsBuffer_IncEffectCount(buff);
+	size_t l = strlen(attr) + 1;
+	EffectsColumn_WriteVarint(&g->values, l);
+	EffectsColumn_WriteBytes(&g->values, attr, l);
 }
 
 static inline void EffectsBufferBlock_Free
@@ -809,6 +953,8 @@ void EffectsBuffer_Free
 		b = next;
 	}
 
+	EffectsGroup_Free(&eb->group);
+
 	rm_free(eb);
 }
 
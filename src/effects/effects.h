@@ -8,7 +8,7 @@
 
 #include "../graph/graphcontext.h"
 
-#define EFFECTS_VERSION 1  // current effects encoding/decoding version
+#define EFFECTS_VERSION 2  // current effects encoding/decoding version
 
 // EffectsBuffer is an opaque data structure
 typedef struct _EffectsBuffer EffectsBuffer;
@@ -28,18 +28,35 @@ typedef enum {
 	EFFECT_ADD_ATTRIBUTE,  // add attribute
 } EffectType;
 
+// replica side effects apply statistics
+typedef struct {
+	uint64_t applied;   // number of applied effects buffers
+	uint64_t lag;       // last apply lag in ms
+	uint64_t max_lag;   // max apply lag in ms
+	double duration;    // last apply duration in ms
+} EffectsApplyStats;
+
 //------------------------------------------------------------------------------
 // effects API
 //------------------------------------------------------------------------------
 
 // applys effects encoded in buffer
-void Effects_Apply
+// returns false if the buffer is malformed, in which case nothing is applied
+bool Effects_Apply
 (
 	GraphContext *gc,          // graph to operate on
 	const char *effects_buff,  // encoded effects
 	size_t l                   // size of buffer
 );
 
+// get replica side effects apply statistics
+// apply lag is the time between the primary encoding an effects buffer
+// and the replica done applying it
+void Effects_GetApplyStats
+(
+	EffectsApplyStats *stats  // [output] apply statistics
+);
+
 // create a new effects-buffer
 EffectsBuffer *EffectsBuffer_New(void);
 
@@ -50,10 +67,19 @@ uint64_t EffectsBuffer_Length
 );
 
 // get a copy of effectspbuffer internal buffer
+// the returned buffer is encoded in the current effects version
 unsigned char *EffectsBuffer_Buffer
 (
-	const EffectsBuffer *eb,  // effects-buffer
-	size_t *n                 // size of returned buffer
+	EffectsBuffer *eb,  // effects-buffer
+	size_t *n           // size of returned buffer
+);
+
+// append the effects of 'src' to the end of 'dst'
+// used to combine the effects of multiple queries into a single buffer
+void EffectsBuffer_Append
+(
+	EffectsBuffer *dst,  // effects-buffer to extend
+	EffectsBuffer *src   // effects-buffer to copy effects from
 );
 
 // add a node creation effect to buffer
@@ -6,9 +6,26 @@
 
 #include "RG.h"
 #include "effects.h"
+#include "effects_encoding.h"
+#include "../util/arr.h"
+#include "../datatypes/array.h"
+#include "../datatypes/vector.h"
 #include "../graph/graph_hub.h"
+#include "../util/thpool/pools.h"
+#include "../util/simple_timer.h"
+#include "../../deps/GraphBLAS/Include/GraphBLAS.h"
 
 #include <stdio.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// number of created entities decoded by a single decode job
+#define EFFECTS_DECODE_CHUNK_SIZE 1024
+
+// replica side apply statistics
+// effects are applied by the redis main thread
+static EffectsApplyStats _apply_stats = {0};
 
 // read effect type from stream
 static inline EffectType ReadEffectType
@@ -482,48 +499,959 @@ static void ApplyDeleteEdge
 	DeleteEdges(gc, &e, 1, false);
 }
 
-// returns false in case of effect encode/decode version mismatch
-static bool ValidateVersion
+//------------------------------------------------------------------------------
+// effects v2
+//------------------------------------------------------------------------------
+
+// decoded group, columns are consumed as effects are applied
+typedef struct {
+	EffectType t;          // type of grouped effects
+	uint64_t n;            // number of effects in group
+	LabelID *labels;       // group label-set
+	uint lbl_count;        // number of labels
+	RelationID r;          // group relation ID
+	const char **dict;     // string dictionary
+	uint64_t dict_len;     // number of strings in dictionary
+	EffectsReader ids;     // entity IDs column
+	EffectsReader attrs;   // attribute counts and IDs column
+	EffectsReader types;   // value types column
+	EffectsReader values;  // value payloads column
+	AttributeSet *sets;    // pre-decoded attribute-sets of created entities
+} EffectsGroupReader;
+
+// decodes the attribute-sets of a range of created entities
+typedef struct {
+	EffectsGroupReader *grp;  // group the entities belong to
+	EffectsReader attrs;      // attributes column at the range start
+	EffectsReader types;      // value types column at the range start
+	EffectsReader values;     // value payloads column at the range start
+	uint64_t offset;          // index of the first entity in range
+	uint64_t n;               // number of entities in range
+} EffectsDecodeJob;
+
+// decode jobs shared between the main thread and worker threads
+typedef struct {
+	EffectsDecodeJob *jobs;  // decode jobs
+	uint64_t n_jobs;         // number of jobs
+	atomic_uint_fast64_t next;      // next job to claim
+	atomic_uint_fast64_t done;      // number of completed jobs
+	atomic_int           refcount;  // number of threads referencing ctx
+	pthread_mutex_t      lock;      // guards completion notification
+	pthread_cond_t       all_done;  // signaled once all jobs completed
+} EffectsDecodeCtx;
+
+// read a value off of the group's value columns
+static SIValue ReadGroupSIValue
 (
-	FILE *stream  // effects stream
+	EffectsGroupReader *g  // group
 ) {
-	ASSERT(stream != NULL);
+	uint64_t i;
+	double   d;
+	Point    p;
+	SIValue  v;
+
+	uint8_t tag = EffectsReader_ReadByte(&g->types);
+	switch(tag) {
+		case EFFECTS_VAL_NULL:
+			v = SI_NullVal();
+			break;
+		case EFFECTS_VAL_FALSE:
+			v = SI_BoolVal(false);
+			break;
+		case EFFECTS_VAL_TRUE:
+			v = SI_BoolVal(true);
+			break;
+		case EFFECTS_VAL_INT:
+			v = SI_LongVal(Effects_UnZigZag(EffectsReader_ReadVarint(&g->values)));
+			break;
+		case EFFECTS_VAL_DOUBLE:
+			memcpy(&d, EffectsReader_ReadBytes(&g->values, sizeof(d)), sizeof(d));
+			v = SI_DoubleVal(d);
+			break;
+		case EFFECTS_VAL_STRING:
+			i = EffectsReader_ReadVarint(&g->values);
+			ASSERT(i < g->dict_len);
+			v = SI_DuplicateStringVal(g->dict[i]);
+			break;
+		case EFFECTS_VAL_POINT:
+			memcpy(&p, EffectsReader_ReadBytes(&g->values, sizeof(p)), sizeof(p));
+			v = SI_Point(p.latitude, p.longitude);
+			break;
+		case EFFECTS_VAL_ARRAY:
+			i = EffectsReader_ReadVarint(&g->values);
+			v = SIArray_New(i);
+			for(uint64_t j = 0; j < i; j++) {
+				array_append(v.array, ReadGroupSIValue(g));
+			}
+			break;
+		case EFFECTS_VAL_VECF32:
+			i = EffectsReader_ReadVarint(&g->values);
+			v = SI_Vectorf32(i);
+			memcpy(SIVector_Elements(v),
+					EffectsReader_ReadBytes(&g->values, sizeof(float) * i),
+					sizeof(float) * i);
+			break;
+		default:
+			// value types are validated before the group is applied
+			ASSERT(false && "unknown value type");
+			v = SI_NullVal();
+	}
 
-	// read version
-	uint8_t v;
-	fread_assert(&v, sizeof(uint8_t), stream);
+	return v;
+}
 
-	if(v != EFFECTS_VERSION) {
-		// unexpected effects version
-		RedisModule_Log(NULL, "warning",
-				"GRAPH.EFFECT version mismatch expected: %d got: %d",
-				EFFECTS_VERSION, v);
+// read an attribute-set off of the group's columns
+static AttributeSet ReadGroupAttributeSet
+(
+	EffectsGroupReader *g  // group
+) {
+	ushort attr_count = EffectsReader_ReadVarint(&g->attrs);
+	if(attr_count == 0) return NULL;
+
+	SIValue values[attr_count];
+	Attribute_ID ids[attr_count];
+
+	for(ushort i = 0; i < attr_count; i++) {
+		ids[i]    = EffectsReader_ReadVarint(&g->attrs);
+		values[i] = ReadGroupSIValue(g);
+	}
+
+	AttributeSet attr_set = NULL;
+	AttributeSet_AddNoClone(&attr_set, ids, values, attr_count, false);
+
+	return attr_set;
+}
+
+// read a NULL terminated string off of reader
+// returns NULL if the string is malformed
+static const char *ReadGroupString
+(
+	EffectsReader *r  // reader
+) {
+	size_t l = EffectsReader_ReadVarint(r);
+	if(l == 0) return NULL;
+
+	const char *str = (const char *)EffectsReader_ReadBytes(r, l);
+	if(str == NULL || str[l - 1] != '\0') return NULL;
+
+	return str;
+}
+
+// skip a value on the group's value columns
+// returns false if the value is malformed
+static bool SkipGroupSIValue
+(
+	EffectsGroupReader *g  // group
+) {
+	uint64_t n;
+	uint8_t tag = EffectsReader_ReadByte(&g->types);
+
+	switch(tag) {
+		case EFFECTS_VAL_NULL:
+		case EFFECTS_VAL_FALSE:
+		case EFFECTS_VAL_TRUE:
+			// no payload
+			break;
+		case EFFECTS_VAL_INT:
+			EffectsReader_ReadVarint(&g->values);
+			break;
+		case EFFECTS_VAL_STRING:
+			n = EffectsReader_ReadVarint(&g->values);
+			if(n >= g->dict_len) return false;
+			break;
+		case EFFECTS_VAL_DOUBLE:
+			EffectsReader_ReadBytes(&g->values, sizeof(double));
+			break;
+		case EFFECTS_VAL_POINT:
+			EffectsReader_ReadBytes(&g->values, sizeof(Point));
+			break;
+		case EFFECTS_VAL_ARRAY:
+			// each element carries at least a type tag
+			n = EffectsReader_ReadVarint(&g->values);
+			if(n > EffectsReader_Remaining(&g->types)) return false;
+			for(uint64_t i = 0; i < n; i++) {
+				if(!SkipGroupSIValue(g)) return false;
+			}
+			break;
+		case EFFECTS_VAL_VECF32:
+			// dimension is bound by the payload's size
+			n = EffectsReader_ReadVarint(&g->values);
+			if(n > UINT32_MAX ||
+			   n > EffectsReader_Remaining(&g->values) / sizeof(float)) {
+				return false;
+			}
+			EffectsReader_ReadBytes(&g->values, sizeof(float) * n);
+			break;
+		default:
+			// unknown value type
+			return false;
+	}
+
+	return !g->types.err && !g->values.err;
+}
+
+// skip an attribute-set on the group's columns
+// returns false if the attribute-set is malformed
+static bool SkipGroupAttributeSet
+(
+	EffectsGroupReader *g  // group
+) {
+	uint64_t attr_count = EffectsReader_ReadVarint(&g->attrs);
+	if(attr_count > USHRT_MAX) return false;
+
+	for(uint64_t i = 0; i < attr_count; i++) {
+		EffectsReader_ReadVarint(&g->attrs);
+		if(!SkipGroupSIValue(g)) return false;
+	}
+
+	return !g->attrs.err;
+}
+
+// skip an updated attribute on the group's columns
+// returns false if the update is malformed
+static bool SkipGroupUpdate
+(
+	EffectsGroupReader *g  // group
+) {
+	uint64_t attr_id = EffectsReader_ReadVarint(&g->attrs);
+	if(g->attrs.err || attr_id >= ATTRIBUTE_ID_NONE) return false;
+
+	// removing all attributes is encoded as a NULL value
+	if(attr_id == ATTRIBUTE_ID_ALL) {
+		if(EffectsReader_Remaining(&g->types) == 0 ||
+		   *g->types.p != EFFECTS_VAL_NULL) {
+			return false;
+		}
+	}
+
+	return SkipGroupSIValue(g);
+}
+
+// create a group of nodes sharing the same label-set
+static void ApplyCreateNodeGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	Graph *g = gc->g;
+
+	// sync policy should be set to resize to capacity
+	// make sure label matrices are of the right dimensions
+	ASSERT(Graph_GetMatrixPolicy(g) == SYNC_POLICY_RESIZE);
+	for(uint i = 0; i < grp->lbl_count; i++) {
+		Graph_GetLabelMatrix(g, grp->labels[i]);
+	}
+	if(grp->lbl_count > 0) Graph_GetNodeLabelMatrix(g);
+
+	// no need to sync/resize while populating matrices
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_NOP);
+
+	for(uint64_t i = 0; i < grp->n; i++) {
+		// attribute-sets are pre-decoded, ownership moves to the node
+		AttributeSet attr_set = grp->sets[i];
+		grp->sets[i] = NULL;
+
+		Node n = GE_NEW_NODE();
+		CreateNode(gc, &n, grp->labels, grp->lbl_count, attr_set, false);
+	}
+
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
+}
+
+// create a group of edges sharing the same relationship type
+static void ApplyCreateEdgeGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	Graph *g = gc->g;
+
+	// sync policy should be set to resize to capacity
+	// make sure relation and adjacency matrices are of the right dimensions
+	ASSERT(Graph_GetMatrixPolicy(g) == SYNC_POLICY_RESIZE);
+	Graph_GetRelationMatrix(g, grp->r, false);
+	Graph_GetAdjacencyMatrix(g, false);
+
+	// no need to sync/resize while populating matrices
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_NOP);
+
+	uint64_t src_id  = 0;
+	uint64_t dest_id = 0;
+	for(uint64_t i = 0; i < grp->n; i++) {
+		EffectsReader_ReadDelta(&grp->ids, &src_id);
+		EffectsReader_ReadDelta(&grp->ids, &dest_id);
+
+		// attribute-sets are pre-decoded, ownership moves to the edge
+		AttributeSet attr_set = grp->sets[i];
+		grp->sets[i] = NULL;
+
+		Edge e;
+		CreateEdge(gc, &e, src_id, dest_id, grp->r, attr_set, false);
+	}
+
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
+}
+
+// delete a group of nodes
+static void ApplyDeleteNodeGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	Graph *g = gc->g;
+	Node *nodes = rm_malloc(sizeof(Node) * grp->n);
+
+	uint64_t id = 0;
+	for(uint64_t i = 0; i < grp->n; i++) {
+		EffectsReader_ReadDelta(&grp->ids, &id);
+
+		// retrieve node from graph
+		bool found = Graph_GetNode(g, id, nodes + i);
+		UNUSED(found);
+		ASSERT(found == true);
+	}
+
+	// delete all nodes at once
+	DeleteNodes(gc, nodes, grp->n, false);
+
+	rm_free(nodes);
+}
+
+// delete a group of edges sharing the same relationship type
+static void ApplyDeleteEdgeGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	Graph *g = gc->g;
+	Edge *edges = rm_malloc(sizeof(Edge) * grp->n);
+
+	uint64_t id      = 0;
+	uint64_t src_id  = 0;
+	uint64_t dest_id = 0;
+	for(uint64_t i = 0; i < grp->n; i++) {
+		EffectsReader_ReadDelta(&grp->ids, &id);
+		EffectsReader_ReadDelta(&grp->ids, &src_id);
+		EffectsReader_ReadDelta(&grp->ids, &dest_id);
+
+		// get edge from the graph
+		Edge *e = edges + i;
+		bool found = Graph_GetEdge(g, id, e);
+		UNUSED(found);
+		ASSERT(found == true);
+
+		// set edge relation, src and destination node
+		Edge_SetSrcNodeID(e, src_id);
+		Edge_SetDestNodeID(e, dest_id);
+		Edge_SetRelationID(e, grp->r);
+	}
+
+	// delete all edges at once
+	DeleteEdges(gc, edges, grp->n, false);
+
+	rm_free(edges);
+}
+
+// update a group of nodes
+static void ApplyUpdateNodeGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	uint64_t id = 0;
+	for(uint64_t i = 0; i < grp->n; i++) {
+		EffectsReader_ReadDelta(&grp->ids, &id);
+		Attribute_ID attr_id = EffectsReader_ReadVarint(&grp->attrs);
+		SIValue v = ReadGroupSIValue(grp);
+
+		ASSERT(SI_TYPE(v) & (SI_VALID_PROPERTY_VALUE | T_NULL));
+		ASSERT((attr_id != ATTRIBUTE_ID_ALL || SIValue_IsNull(v)) && attr_id != ATTRIBUTE_ID_NONE);
+
+		UpdateNodeProperty(gc, id, attr_id, v);
+	}
+}
+
+// update a group of edges sharing the same relationship type
+static void ApplyUpdateEdgeGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	uint64_t id      = 0;
+	uint64_t src_id  = 0;
+	uint64_t dest_id = 0;
+	for(uint64_t i = 0; i < grp->n; i++) {
+		EffectsReader_ReadDelta(&grp->ids, &id);
+		EffectsReader_ReadDelta(&grp->ids, &src_id);
+		EffectsReader_ReadDelta(&grp->ids, &dest_id);
+		Attribute_ID attr_id = EffectsReader_ReadVarint(&grp->attrs);
+		SIValue v = ReadGroupSIValue(grp);
+
+		ASSERT(SI_TYPE(v) & (SI_VALID_PROPERTY_VALUE | T_NULL));
+		ASSERT((attr_id != ATTRIBUTE_ID_ALL || SIValue_IsNull(v)) && attr_id != ATTRIBUTE_ID_NONE);
+
+		UpdateEdgeProperty(gc, id, grp->r, src_id, dest_id, attr_id, v);
+	}
+}
+
+// set or remove the group's labels from a group of nodes
+static void ApplyLabelsGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc,         // graph to operate on
+	bool add                  // add or remove labels
+) {
+	ASSERT(grp->lbl_count > 0);
+
+	// resolve label names once for the entire group
+	const char *lbl[grp->lbl_count];
+	for(uint i = 0; i < grp->lbl_count; i++) {
+		Schema *s = GraphContext_GetSchemaByID(gc, grp->labels[i], SCHEMA_NODE);
+		ASSERT(s != NULL);
+		lbl[i] = Schema_GetName(s);
+	}
+
+	const char **add_labels    = (add) ? lbl : NULL;
+	const char **remove_labels = (add) ? NULL : lbl;
+	uint n_add_labels          = (add) ? grp->lbl_count : 0;
+	uint n_remove_labels       = (add) ? 0 : grp->lbl_count;
+
+	Graph *g = gc->g;
+	uint64_t id = 0;
+	for(uint64_t i = 0; i < grp->n; i++) {
+		EffectsReader_ReadDelta(&grp->ids, &id);
+
+		Node n;
+		bool found = Graph_GetNode(g, id, &n);
+		UNUSED(found);
+		ASSERT(found == true);
+
+		UpdateNodeLabels(gc, &n, add_labels, remove_labels, n_add_labels,
+				n_remove_labels, false);
+	}
+}
+
+// add a group of schemas
+static void ApplyAddSchemaGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	for(uint64_t i = 0; i < grp->n; i++) {
+		SchemaType t = EffectsReader_ReadVarint(&grp->attrs);
+		const char *schema_name = ReadGroupString(&grp->values);
+		AddSchema(gc, schema_name, t, false);
+	}
+}
+
+// add a group of attributes
+static void ApplyAddAttributeGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	for(uint64_t i = 0; i < grp->n; i++) {
+		const char *attr = ReadGroupString(&grp->values);
+
+		// attr should not exist
+		ASSERT(GraphContext_GetAttributeID(gc, attr) == ATTRIBUTE_ID_NONE);
+
+		FindOrAddAttribute(gc, attr, false);
+	}
+}
+
+// read a single group of effects off of reader
+// the group's columns are sliced out of the reader, but not decoded
+// returns false if the group's header is malformed
+static bool ReadGroup
+(
+	EffectsReader *r,        // effects reader
+	EffectsGroupReader *grp  // [output] group
+) {
+	//--------------------------------------------------------------------------
+	// group format:
+	//    effect type
+	//    effect count
+	//    group key
+	//    dictionary
+	//    ids, attributes, value types and value payloads columns
+	//--------------------------------------------------------------------------
+
+	memset(grp, 0, sizeof(EffectsGroupReader));
+
+	grp->t = EffectsReader_ReadByte(r);
+	grp->n = EffectsReader_ReadVarint(r);
+	grp->r = GRAPH_UNKNOWN_RELATION;
+
+	if(grp->t <= EFFECT_UNKNOWN || grp->t > EFFECT_ADD_ATTRIBUTE ||
+	   grp->n == 0) {
 		return false;
 	}
 
-	return true;
+	//--------------------------------------------------------------------------
+	// read group key
+	//--------------------------------------------------------------------------
+
+	if(Effects_KeyedByLabels(grp->t)) {
+		// each label takes at least a byte
+		uint64_t lbl_count = EffectsReader_ReadVarint(r);
+		if(lbl_count > EffectsReader_Remaining(r)) return false;
+
+		// labels are either set or removed
+		if(lbl_count == 0 && grp->t != EFFECT_CREATE_NODE) return false;
+
+		grp->lbl_count = lbl_count;
+		if(grp->lbl_count > 0) {
+			grp->labels = rm_malloc(sizeof(LabelID) * grp->lbl_count);
+			for(uint i = 0; i < grp->lbl_count; i++) {
+				grp->labels[i] = EffectsReader_ReadVarint(r);
+			}
+		}
+	} else if(Effects_KeyedByRelation(grp->t)) {
+		grp->r = EffectsReader_ReadVarint(r);
+	}
+
+	//--------------------------------------------------------------------------
+	// read dictionary
+	//--------------------------------------------------------------------------
+
+	// each string takes at least two bytes, length and terminator
+	grp->dict_len = EffectsReader_ReadVarint(r);
+	if(grp->dict_len > EffectsReader_Remaining(r) / 2) return false;
+
+	if(grp->dict_len > 0) {
+		grp->dict = rm_malloc(sizeof(char *) * grp->dict_len);
+		for(uint64_t i = 0; i < grp->dict_len; i++) {
+			grp->dict[i] = ReadGroupString(r);
+			if(grp->dict[i] == NULL) return false;
+		}
+	}
+
+	//--------------------------------------------------------------------------
+	// read columns
+	//--------------------------------------------------------------------------
+
+	grp->ids    = EffectsReader_Slice(r, EffectsReader_ReadVarint(r));
+	grp->attrs  = EffectsReader_Slice(r, EffectsReader_ReadVarint(r));
+	grp->types  = EffectsReader_Slice(r, EffectsReader_ReadVarint(r));
+	grp->values = EffectsReader_Slice(r, EffectsReader_ReadVarint(r));
+
+	if(r->err) return false;
+
+	// each effect takes at least a byte of the ids, attributes or values
+	// columns, bounds allocations made on behalf of the group
+	size_t col_size = EffectsReader_Remaining(&grp->ids) +
+		EffectsReader_Remaining(&grp->attrs) +
+		EffectsReader_Remaining(&grp->values);
+
+	return grp->n <= col_size;
 }
 
-// applys effects encoded in buffer
-void Effects_Apply
+// validate a group's columns
+// every effect in the group is skipped over without being applied
+// returns false if any of the group's columns is malformed
+static bool ValidateGroup
 (
-	GraphContext *gc,          // graph to operate on
-	const char *effects_buff,  // encoded effects
-	size_t l                   // size of buffer
+	const EffectsGroupReader *grp  // group
 ) {
-	// validations
-	ASSERT(l > 0);  // buffer can't be empty
-	ASSERT(effects_buff != NULL);  // buffer can't be NULL
+	// validate using private readers
+	// columns are consumed again once the group is decoded and applied
+	EffectsGroupReader g = *grp;
 
-	// read buffer in a stream fashion
-	FILE *stream = fmemopen((void*)effects_buff, l, "r");
+	uint64_t id = 0;
+	for(uint64_t i = 0; i < g.n; i++) {
+		bool valid = true;
 
-	// validate effects version
-	if(ValidateVersion(stream) == false) {
-		// replica/primary out of sync
-		exit(1);
+		switch(g.t) {
+			case EFFECT_DELETE_NODE:
+			case EFFECT_SET_LABELS:
+			case EFFECT_REMOVE_LABELS:
+				EffectsReader_ReadDelta(&g.ids, &id);
+				break;
+			case EFFECT_DELETE_EDGE:
+				EffectsReader_ReadDelta(&g.ids, &id);
+				EffectsReader_ReadDelta(&g.ids, &id);
+				EffectsReader_ReadDelta(&g.ids, &id);
+				break;
+			case EFFECT_UPDATE_NODE:
+				EffectsReader_ReadDelta(&g.ids, &id);
+				valid = SkipGroupUpdate(&g);
+				break;
+			case EFFECT_UPDATE_EDGE:
+				EffectsReader_ReadDelta(&g.ids, &id);
+				EffectsReader_ReadDelta(&g.ids, &id);
+				EffectsReader_ReadDelta(&g.ids, &id);
+				valid = SkipGroupUpdate(&g);
+				break;
+			case EFFECT_CREATE_NODE:
+				valid = SkipGroupAttributeSet(&g);
+				break;
+			case EFFECT_CREATE_EDGE:
+				EffectsReader_ReadDelta(&g.ids, &id);
+				EffectsReader_ReadDelta(&g.ids, &id);
+				valid = SkipGroupAttributeSet(&g);
+				break;
+			case EFFECT_ADD_SCHEMA:
+				EffectsReader_ReadVarint(&g.attrs);
+				valid = ReadGroupString(&g.values) != NULL;
+				break;
+			case EFFECT_ADD_ATTRIBUTE:
+				valid = ReadGroupString(&g.values) != NULL;
+				break;
+			default:
+				valid = false;
+				break;
+		}
+
+		if(!valid || g.ids.err || g.attrs.err) return false;
+	}
+
+	// all columns should be consumed
+	return EffectsReader_Done(&g.ids)   &&
+	       EffectsReader_Done(&g.attrs) &&
+	       EffectsReader_Done(&g.types) &&
+	       EffectsReader_Done(&g.values);
+}
+
+// free group's internal allocations
+static void FreeGroup
+(
+	EffectsGroupReader *grp  // group
+) {
+	if(grp->sets != NULL) {
+		// free attribute-sets which weren't handed to an entity
+		for(uint64_t i = 0; i < grp->n; i++) {
+			AttributeSet_Free(grp->sets + i);
+		}
+		rm_free(grp->sets);
+	}
+
+	if(grp->dict   != NULL) rm_free(grp->dict);
+	if(grp->labels != NULL) rm_free(grp->labels);
+}
+
+// apply a single group of effects
+static void ApplyGroup
+(
+	EffectsGroupReader *grp,  // group
+	GraphContext *gc          // graph to operate on
+) {
+	switch(grp->t) {
+		case EFFECT_DELETE_NODE:
+			ApplyDeleteNodeGroup(grp, gc);
+			break;
+		case EFFECT_DELETE_EDGE:
+			ApplyDeleteEdgeGroup(grp, gc);
+			break;
+		case EFFECT_UPDATE_NODE:
+			ApplyUpdateNodeGroup(grp, gc);
+			break;
+		case EFFECT_UPDATE_EDGE:
+			ApplyUpdateEdgeGroup(grp, gc);
+			break;
+		case EFFECT_CREATE_NODE:
+			ApplyCreateNodeGroup(grp, gc);
+			break;
+		case EFFECT_CREATE_EDGE:
+			ApplyCreateEdgeGroup(grp, gc);
+			break;
+		case EFFECT_SET_LABELS:
+			ApplyLabelsGroup(grp, gc, true);
+			break;
+		case EFFECT_REMOVE_LABELS:
+			ApplyLabelsGroup(grp, gc, false);
+			break;
+		case EFFECT_ADD_SCHEMA:
+			ApplyAddSchemaGroup(grp, gc);
+			break;
+		case EFFECT_ADD_ATTRIBUTE:
+			ApplyAddAttributeGroup(grp, gc);
+			break;
+		default:
+			// effect types are validated before the group is applied
+			ASSERT(false && "unknown effect type");
+			break;
+	}
+
+	// all columns should be consumed
+	ASSERT(EffectsReader_Done(&grp->ids));
+	ASSERT(EffectsReader_Done(&grp->attrs));
+	ASSERT(EffectsReader_Done(&grp->types));
+	ASSERT(EffectsReader_Done(&grp->values));
+}
+
+//------------------------------------------------------------------------------
+// parallel decoding
+//------------------------------------------------------------------------------
+
+// decode the attribute-sets of a single job
+static void _DecodeJob
+(
+	EffectsDecodeJob *job  // job to run
+) {
+	// private readers positioned at the job's first entity
+	EffectsGroupReader grp = *job->grp;
+	grp.attrs  = job->attrs;
+	grp.types  = job->types;
+	grp.values = job->values;
+
+	AttributeSet *sets = job->grp->sets + job->offset;
+	for(uint64_t i = 0; i < job->n; i++) {
+		sets[i] = ReadGroupAttributeSet(&grp);
+	}
+}
+
+// claim and run decode jobs until none are left
+static void _DecodeJobs
+(
+	EffectsDecodeCtx *ctx  // decode context
+) {
+	uint64_t i;
+	while((i = atomic_fetch_add(&ctx->next, 1)) < ctx->n_jobs) {
+		_DecodeJob(ctx->jobs + i);
+
+		// last job to complete wakes up the waiting thread
+		if(atomic_fetch_add(&ctx->done, 1) + 1 == ctx->n_jobs) {
+			pthread_mutex_lock(&ctx->lock);
+			pthread_cond_signal(&ctx->all_done);
+			pthread_mutex_unlock(&ctx->lock);
+		}
+	}
+}
+
+static void _DecodeCtx_DecRef
+(
+	EffectsDecodeCtx *ctx  // decode context
+) {
+	if(atomic_fetch_sub(&ctx->refcount, 1) == 1) {
+		pthread_cond_destroy(&ctx->all_done);
+		pthread_mutex_destroy(&ctx->lock);
+		array_free(ctx->jobs);
+		rm_free(ctx);
+	}
+}
+
+// worker thread entry point
+static void _DecodeWorker
+(
+	void *arg  // decode context
+) {
+	EffectsDecodeCtx *ctx = (EffectsDecodeCtx *)arg;
+	_DecodeJobs(ctx);
+	_DecodeCtx_DecRef(ctx);
+}
+
+// decode the attribute-sets of all created entities
+// the created entities of each group are split into chunks, each decoded
+// independently, chunks are processed by the calling thread and by
+// the readers thread-pool
+static void DecodeAttributeSets
+(
+	EffectsGroupReader *groups,  // groups
+	uint n_groups                // number of groups
+) {
+	EffectsDecodeCtx *ctx = rm_malloc(sizeof(EffectsDecodeCtx));
+	ctx->jobs = array_new(EffectsDecodeJob, 0);
+
+	//--------------------------------------------------------------------------
+	// split created entities into jobs
+	//--------------------------------------------------------------------------
+
+	for(uint i = 0; i < n_groups; i++) {
+		EffectsGroupReader *grp = groups + i;
+		if(grp->t != EFFECT_CREATE_NODE && grp->t != EFFECT_CREATE_EDGE) {
+			continue;
+		}
+
+		grp->sets = rm_calloc(grp->n, sizeof(AttributeSet));
+
+		// locate chunk boundaries by skipping over encoded attribute-sets
+		// this leaves the group's attribute columns fully consumed
+		for(uint64_t offset = 0; offset < grp->n;
+				offset += EFFECTS_DECODE_CHUNK_SIZE) {
+			EffectsDecodeJob job = {
+				.grp    = grp,
+				.attrs  = grp->attrs,
+				.types  = grp->types,
+				.values = grp->values,
+				.offset = offset,
+				.n      = MIN(EFFECTS_DECODE_CHUNK_SIZE, grp->n - offset)
+			};
+
+			// attribute-sets were validated, skipping can't fail
+			for(uint64_t j = 0; j < job.n; j++) {
+				SkipGroupAttributeSet(grp);
+			}
+
+			array_append(ctx->jobs, job);
+		}
+	}
+
+	ctx->n_jobs = array_len(ctx->jobs);
+	atomic_init(&ctx->next, 0);
+	atomic_init(&ctx->done, 0);
+	atomic_init(&ctx->refcount, 1);
+	pthread_mutex_init(&ctx->lock, NULL);
+	pthread_cond_init(&ctx->all_done, NULL);
+
+	//--------------------------------------------------------------------------
+	// fan out
+	//--------------------------------------------------------------------------
+
+	// the calling thread handles a share of the jobs itself
+	// workers which start late find no jobs left and exit
+	uint n_workers = MIN(ThreadPools_ReadersCount(), ctx->n_jobs - 1);
+	if(ctx->n_jobs < 2) n_workers = 0;
+
+	for(uint i = 0; i < n_workers; i++) {
+		atomic_fetch_add(&ctx->refcount, 1);
+		if(ThreadPools_AddWorkReader(_DecodeWorker, ctx, 1) != 0) {
+			atomic_fetch_sub(&ctx->refcount, 1);
+			break;
+		}
+	}
+
+	_DecodeJobs(ctx);
+
+	// wait for jobs claimed by workers to complete
+	pthread_mutex_lock(&ctx->lock);
+	while(atomic_load(&ctx->done) < ctx->n_jobs) {
+		pthread_cond_wait(&ctx->all_done, &ctx->lock);
+	}
+	pthread_mutex_unlock(&ctx->lock);
+
+	_DecodeCtx_DecRef(ctx);
+}
+
+// decompress an LZ4 compressed payload
+// returns the decompressed payload, caller is responsible for freeing it
+// returns NULL if the payload is malformed
+static unsigned char *_Effects_Decompress
+(
+	const unsigned char *blob,  // compressed payload
+	size_t blob_size,           // compressed payload size
+	uint64_t raw_size           // decompressed payload size
+) {
+	GrB_Info info;
+	GrB_Vector v = NULL;
+
+	// payload was compressed as a serialized dense uint8 vector
+	info = GxB_Vector_deserialize(&v, GrB_UINT8, blob, blob_size, NULL);
+	if(info != GrB_SUCCESS) return NULL;
+
+	GrB_Index n;
+	info = GrB_Vector_size(&n, v);
+	if(info != GrB_SUCCESS || n != raw_size || n == 0) {
+		GrB_free(&v);
+		return NULL;
+	}
+
+	bool iso;
+	void *vx;
+	GrB_Index vx_size;
+	info = GxB_Vector_unpack_Full(v, &vx, &vx_size, &iso, NULL);
+	GrB_free(&v);
+
+	if(info != GrB_SUCCESS) return NULL;
+
+	unsigned char *payload = vx;
+	if(iso) {
+		// all bytes are the same, expand
+		unsigned char b = payload[0];
+		rm_free(payload);
+		payload = rm_malloc(raw_size);
+		memset(payload, b, raw_size);
+	}
+
+	return payload;
+}
+
+// applys effects encoded in v2 format
+// effects are applied in stages:
+// 1. groups are read and the attribute-sets of created entities are decoded
+//    in parallel, without holding the graph's lock
+// 2. IDs for all created entities are allocated at once
+// 3. groups are applied under the graph's write lock
+// returns false if the buffer is malformed, in which case nothing is applied
+static bool Effects_ApplyV2
+(
+	GraphContext *gc,           // graph to operate on
+	const unsigned char *buff,  // encoded effects, past version
+	size_t l                    // size of buffer
+) {
+	EffectsReader r = { .p = buff, .end = buff + l };
+
+	//--------------------------------------------------------------------------
+	// read header
+	//--------------------------------------------------------------------------
+
+	const unsigned char *ts_bytes = EffectsReader_ReadBytes(&r, sizeof(uint64_t));
+	uint8_t codec = EffectsReader_ReadByte(&r);
+	if(r.err) return false;
+
+	uint64_t ts;
+	memcpy(&ts, ts_bytes, sizeof(ts));
+
+	unsigned char *payload = NULL;
+
+	if(codec == EFFECTS_CODEC_LZ4) {
+		uint64_t raw_size;
+		const unsigned char *raw_size_bytes =
+			EffectsReader_ReadBytes(&r, sizeof(raw_size));
+		if(raw_size_bytes == NULL) return false;
+		memcpy(&raw_size, raw_size_bytes, sizeof(raw_size));
+
+		payload = _Effects_Decompress(r.p, r.end - r.p, raw_size);
+		if(payload == NULL) return false;
+
+		r.p   = payload;
+		r.end = payload + raw_size;
+	} else if(codec != EFFECTS_CODEC_NONE) {
+		// unknown codec
+		return false;
+	}
+
+	//--------------------------------------------------------------------------
+	// read groups
+	//--------------------------------------------------------------------------
+
+	uint64_t node_count = 0;
+	uint64_t edge_count = 0;
+	EffectsGroupReader *groups = array_new(EffectsGroupReader, 1);
+
+	// groups are validated before any of them is applied
+	bool valid = true;
+	while(valid && !EffectsReader_Done(&r)) {
+		EffectsGroupReader grp;
+		valid = ReadGroup(&r, &grp) && ValidateGroup(&grp);
+		array_append(groups, grp);
+
+		if(grp.t == EFFECT_CREATE_NODE) node_count += grp.n;
+		if(grp.t == EFFECT_CREATE_EDGE) edge_count += grp.n;
+	}
+
+	uint n_groups = array_len(groups);
+
+	if(!valid) {
+		for(uint i = 0; i < n_groups; i++) {
+			FreeGroup(groups + i);
+		}
+		array_free(groups);
+
+		if(payload != NULL) rm_free(payload);
+
+		return false;
+	}
+
+	// decode attribute-sets of created entities
+	if(node_count + edge_count > 0) {
+		DecodeAttributeSets(groups, n_groups);
 	}
 
+	//--------------------------------------------------------------------------
+	// apply groups
+	//--------------------------------------------------------------------------
+
 	// lock graph for writing
 	Graph *g = GraphContext_GetGraph(gc);
 	Graph_AcquireWriteLock(g);
@@ -531,6 +1459,50 @@ void Effects_Apply
 	// update graph sync policy
 	MATRIX_POLICY policy = Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
 
+	// allocate all created entities at once
+	if(node_count > 0) Graph_AllocateNodes(g, node_count);
+	if(edge_count > 0) Graph_AllocateEdges(g, edge_count);
+
+	for(uint i = 0; i < n_groups; i++) {
+		ApplyGroup(groups + i, gc);
+	}
+
+	// restore graph sync policy
+	Graph_SetMatrixPolicy(g, policy);
+
+	// release write lock
+	Graph_ReleaseLock(g);
+
+	//--------------------------------------------------------------------------
+	// update apply lag
+	//--------------------------------------------------------------------------
+
+	uint64_t now = RedisModule_Milliseconds();
+	_apply_stats.lag     = (now > ts) ? now - ts : 0;
+	_apply_stats.max_lag = MAX(_apply_stats.max_lag, _apply_stats.lag);
+
+	// clean up
+	for(uint i = 0; i < n_groups; i++) {
+		FreeGroup(groups + i);
+	}
+	array_free(groups);
+
+	if(payload != NULL) rm_free(payload);
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// effects v1
+//------------------------------------------------------------------------------
+
+// applys effects encoded in v1 format
+static void Effects_ApplyV1
+(
+	GraphContext *gc,  // graph to operate on
+	FILE *stream,      // effects stream, past version
+	size_t l           // size of buffer
+) {
 	// as long as there's data in stream
 	while(ftell(stream) < l) {
 		// read effect type
@@ -571,14 +1543,78 @@ void Effects_Apply
 				break;
 		}
 	}
+}
 
-	// restore graph sync policy
-	Graph_SetMatrixPolicy(g, policy);
+// applys effects encoded in buffer
+// returns false if the buffer is malformed
+bool Effects_Apply
+(
+	GraphContext *gc,          // graph to operate on
+	const char *effects_buff,  // encoded effects
+	size_t l                   // size of buffer
+) {
+	// validations
+	ASSERT(effects_buff != NULL);  // buffer can't be NULL
 
-	// release write lock
-	Graph_ReleaseLock(g);
+	// buffer can't be empty
+	if(l == 0) return false;
+
+	// read version
+	uint8_t v = effects_buff[0];
+
+	if(v != EFFECTS_VERSION && v != 1) {
+		// unexpected effects version
+		// replica/primary out of sync
+		RedisModule_Log(NULL, "warning",
+				"GRAPH.EFFECT version mismatch expected: %d got: %d",
+				EFFECTS_VERSION, v);
+		exit(1);
+	}
+
+	simple_timer_t timer;
+	simple_tic(timer);
+
+	if(v == EFFECTS_VERSION) {
+		if(!Effects_ApplyV2(gc, (const unsigned char *)effects_buff + sizeof(v),
+				l - sizeof(v))) {
+			return false;
+		}
+	} else {
+		// effects encoded by a primary running an older version
+		// read buffer in a stream fashion
+		FILE *stream = fmemopen((void*)effects_buff, l, "r");
+		fseek(stream, sizeof(v), SEEK_SET);
+
+		// lock graph for writing
+		Graph *g = GraphContext_GetGraph(gc);
+		Graph_AcquireWriteLock(g);
+
+		// update graph sync policy
+		MATRIX_POLICY policy = Graph_SetMatrixPolicy(g, SYNC_POLICY_RESIZE);
 
-	// close stream
-	fclose(stream);
+		Effects_ApplyV1(gc, stream, l);
+
+		// restore graph sync policy
+		Graph_SetMatrixPolicy(g, policy);
+
+		// release write lock
+		Graph_ReleaseLock(g);
+
+		fclose(stream);
+	}
+
+	_apply_stats.applied++;
+	_apply_stats.duration = simple_toc(timer) * 1000;
+
+	return true;
 }
 
+// get replica side effects apply statistics
+void Effects_GetApplyStats
+(
+	EffectsApplyStats *stats  // [output] apply statistics
+) {
+	ASSERT(stats != NULL);
+
+	*stats = _apply_stats;
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "RG.h"
+#include "effects.h"
+#include "../util/rmalloc.h"
+
+#include <stdint.h>
+#include <string.h>
+
+//------------------------------------------------------------------------------
+// effects v2 encoding primitives
+//------------------------------------------------------------------------------
+
+// effects v2 stream layout:
+//
+// header:
+//    version      (uint8)
+//    timestamp    (uint64)  primary's wall clock in ms when buffer was encoded
+//    codec        (uint8)   EFFECTS_CODEC_NONE / EFFECTS_CODEC_LZ4
+//    [raw size    (uint64)   only when compressed]
+//    payload      groups, compressed as a single blob when codec != NONE
+//
+// a group holds consecutive effects of the same type (and label-set/relation)
+// group layout:
+//    effect type  (uint8)
+//    effect count (varint)
+//    group key    label-set or relation ID, depending on effect type
+//    dictionary   string count (varint) followed by the strings
+//    columns      4 columns, each prefixed by its length (varint)
+//                 ids, attributes, value types and value payloads
+//
+// entity IDs are delta encoded against the previous ID in the same column
+// attribute values are typed, strings are replaced by their dictionary index
+
+// codecs
+#define EFFECTS_CODEC_NONE 0  // payload isn't compressed
+#define EFFECTS_CODEC_LZ4  1  // payload is LZ4 compressed
+
+// value tags, stored in the value types column
+typedef enum {
+	EFFECTS_VAL_NULL = 0,  // no payload
+	EFFECTS_VAL_FALSE,     // no payload
+	EFFECTS_VAL_TRUE,      // no payload
+	EFFECTS_VAL_INT,       // zigzag varint
+	EFFECTS_VAL_DOUBLE,    // 8 bytes
+	EFFECTS_VAL_STRING,    // dictionary index varint
+	EFFECTS_VAL_POINT,     // sizeof(Point) bytes
+	EFFECTS_VAL_ARRAY,     // element count varint, elements follow
+	EFFECTS_VAL_VECF32,    // dimension varint, dimension * 4 bytes
+} EffectsValueTag;
+
+// growable byte column
+typedef struct {
+	unsigned char *data;  // column bytes
+	size_t len;           // number of bytes used
+	size_t cap;           // column capacity
+} EffectsColumn;
+
+// sequential reader over an encoded buffer
+typedef struct {
+	const unsigned char *p;    // current position
+	const unsigned char *end;  // end of buffer
+	bool err;                  // set once a read ran past the end of buffer
+} EffectsReader;
+
+// group key is the group's label-set
+static inline bool Effects_KeyedByLabels
+(
+	EffectType t  // effect type
+) {
+	return (t == EFFECT_CREATE_NODE || t == EFFECT_SET_LABELS ||
+			t == EFFECT_REMOVE_LABELS);
+}
+
+// group key is the group's relation ID
+static inline bool Effects_KeyedByRelation
+(
+	EffectType t  // effect type
+) {
+	return (t == EFFECT_CREATE_EDGE || t == EFFECT_DELETE_EDGE ||
+			t == EFFECT_UPDATE_EDGE);
+}
+
+// zigzag encode a signed integer
+static inline uint64_t Effects_ZigZag
+(
+	int64_t v
+) {
+	return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+// zigzag decode an unsigned integer
+static inline int64_t Effects_UnZigZag
+(
+	uint64_t v
+) {
+	return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+// make sure column can hold an additional n bytes
+static inline void EffectsColumn_Reserve
+(
+	EffectsColumn *col,  // column
+	size_t n             // number of additional bytes
+) {
+	if(col->len + n <= col->cap) return;
+
+	size_t cap = col->cap * 2;
+	if(cap < col->len + n) cap = col->len + n;
+	if(cap < 64) cap = 64;
+	col->data = rm_realloc(col->data, cap);
+	col->cap  = cap;
+}
+
+// write n bytes to column
+static inline void EffectsColumn_WriteBytes
+(
+	EffectsColumn *col,  // column
+	const void *ptr,     // bytes to write
+	size_t n             // number of bytes
+) {
+	if(n == 0) return;
+
+	EffectsColumn_Reserve(col, n);
+	memcpy(col->data + col->len, ptr, n);
+	col->len += n;
+}
+
+// write a single byte to column
+static inline void EffectsColumn_WriteByte
+(
+	EffectsColumn *col,  // column
+	uint8_t b            // byte to write
+) {
+	EffectsColumn_Reserve(col, 1);
+	col->data[col->len++] = b;
+}
+
+// write an unsigned varint to column
+static inline void EffectsColumn_WriteVarint
+(
+	EffectsColumn *col,  // column
+	uint64_t v           // value to write
+) {
+	EffectsColumn_Reserve(col, 10);
+	while(v >= 0x80) {
+		col->data[col->len++] = (uint8_t)(v | 0x80);
+		v >>= 7;
+	}
+	col->data[col->len++] = (uint8_t)v;
+}
+
+// write delta between 'id' and '*prev' to column and update '*prev'
+static inline void EffectsColumn_WriteDelta
+(
+	EffectsColumn *col,  // column
+	uint64_t id,         // ID to write
+	uint64_t *prev       // previous ID written to column
+) {
+	EffectsColumn_WriteVarint(col, Effects_ZigZag((int64_t)(id - *prev)));
+	*prev = id;
+}
+
+// reset column, keeping its allocation
+static inline void EffectsColumn_Clear
+(
+	EffectsColumn *col  // column
+) {
+	col->len = 0;
+}
+
+// free column's internal buffer
+static inline void EffectsColumn_Free
+(
+	EffectsColumn *col  // column
+) {
+	if(col->data != NULL) rm_free(col->data);
+	col->data = NULL;
+	col->len  = 0;
+	col->cap  = 0;
+}
+
+// mark reader as failed, all subsequent reads fail
+static inline void EffectsReader_Fail
+(
+	EffectsReader *r  // reader
+) {
+	r->err = true;
+	r->p   = r->end;
+}
+
+// returns the number of bytes left to read
+static inline size_t EffectsReader_Remaining
+(
+	const EffectsReader *r  // reader
+) {
+	return r->end - r->p;
+}
+
+// read n bytes from reader
+// returns NULL on a short read
+static inline const unsigned char *EffectsReader_ReadBytes
+(
+	EffectsReader *r,  // reader
+	size_t n           // number of bytes to read
+) {
+	if(unlikely(EffectsReader_Remaining(r) < n)) {
+		EffectsReader_Fail(r);
+		return NULL;
+	}
+
+	const unsigned char *ptr = r->p;
+	r->p += n;
+	return ptr;
+}
+
+// read a single byte from reader
+// returns 0 on a short read
+static inline uint8_t EffectsReader_ReadByte
+(
+	EffectsReader *r  // reader
+) {
+	if(unlikely(r->p >= r->end)) {
+		EffectsReader_Fail(r);
+		return 0;
+	}
+
+	return *r->p++;
+}
+
+// read an unsigned varint from reader
+// returns 0 on a short read or an overlong varint
+static inline uint64_t EffectsReader_ReadVarint
+(
+	EffectsReader *r  // reader
+) {
+	uint64_t v     = 0;
+	uint     shift = 0;
+
+	while(true) {
+		if(unlikely(r->p >= r->end || shift >= 64)) {
+			EffectsReader_Fail(r);
+			return 0;
+		}
+
+		uint8_t b = *r->p++;
+		v |= (uint64_t)(b & 0x7F) << shift;
+		if((b & 0x80) == 0) break;
+		shift += 7;
+	}
+
+	return v;
+}
+
+// read a delta encoded ID from reader, '*prev' is updated
+static inline uint64_t EffectsReader_ReadDelta
+(
+	EffectsReader *r,  // reader
+	uint64_t *prev     // previous ID read from column
+) {
+	*prev += (uint64_t)Effects_UnZigZag(EffectsReader_ReadVarint(r));
+	return *prev;
+}
+
+// carve a sub-reader of n bytes out of reader
+static inline EffectsReader EffectsReader_Slice
+(
+	EffectsReader *r,  // reader
+	size_t n           // sub-reader size
+) {
+	const unsigned char *p = EffectsReader_ReadBytes(r, n);
+	if(unlikely(p == NULL)) {
+		return (EffectsReader) { .p = r->end, .end = r->end, .err = true };
+	}
+
+	return (EffectsReader) { .p = p, .end = p + n };
+}
+
+// returns true if reader has no more data
+static inline bool EffectsReader_Done
+(
+	const EffectsReader *r  // reader
+) {
+	return r->p == r->end;
+}
+
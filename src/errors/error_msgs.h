@@ -117,3 +117,13 @@
 #define EMSG_SSPATH_INVALID_TYPE "sourceNode must be of type Node"
 #define EMSG_INDEX_SUPPORT_CONSTRAINTS "Index supports constraint"
 #define EMSG_QUERY_MEM_CONSUMPTION "Query's mem consumption exceeded capacity"
+#define EMSG_PAGERANK_SOURCE_NODES "sourceNodes must contain at least one ranked node"
+#define EMSG_VECTOR_DIMENSION_MISMATCH "Vector dimension mismatch, expected %u but got %u"
+#define EMSG_VECTOR_DROP_INDEX "ERR Unable to drop vector index on :%s(%s): no such index."
+#define EMSG_PREPARED_STATEMENT_PARAMS "Prepared statements can't specify parameters, parameters are provided upon execution"
+#define EMSG_PREPARED_STATEMENT_TYPE "Only queries can be prepared"
+#define EMSG_PREPARED_STATEMENT_PROCEDURE "Prepared statements can't call procedure '%s' as it modifies the graph"
+#define EMSG_UNKNOWN_PREPARED_STATEMENT "Unknown prepared statement %llu"
+#define EMSG_INVALID_BINARY_PARAMS "Invalid binary encoded parameters"
+#define EMSG_INVALID_EFFECTS "Malformed effects buffer"
+#define EMSG_CACHE_WARMUP_TYPE "Only queries can be cached"
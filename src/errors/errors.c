@@ -117,6 +117,30 @@ inline bool ErrorCtx_EncounteredError(void) {
 	return ctx->error != NULL;
 }
 
+// detach the error message from this thread's ErrorCtx
+// the caller takes ownership of the returned message
+char *ErrorCtx_DetachError(void) {
+	ErrorCtx *ctx = ErrorCtx_Get();
+	ASSERT(ctx != NULL);
+
+	char *err = ctx->error;
+	ctx->error = NULL;
+
+	return err;
+}
+
+// set a previously detached error message as this thread's error
+// the ErrorCtx takes ownership of 'err'
+void ErrorCtx_AttachError(char *err) {
+	ErrorCtx *ctx = ErrorCtx_Get();
+	ASSERT(ctx != NULL);
+
+	// an error is already set - free it
+	if(ctx->error != NULL) free(ctx->error);
+
+	ctx->error = err;
+}
+
 //------------------------------------------------------------------------------
 // Specific error scenarios
 //------------------------------------------------------------------------------
@@ -49,6 +49,14 @@ void ErrorCtx_EmitException(void);
 
 bool ErrorCtx_EncounteredError(void);
 
+// detach the error message from this thread's ErrorCtx
+// the caller takes ownership of the returned message
+char *ErrorCtx_DetachError(void);
+
+// set a previously detached error message as this thread's error
+// the ErrorCtx takes ownership of 'err'
+void ErrorCtx_AttachError(char *err);
+
 //------------------------------------------------------------------------------
 // common errors
 //------------------------------------------------------------------------------
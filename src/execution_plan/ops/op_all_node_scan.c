@@ -25,6 +25,7 @@ OpBase *NewAllNodeScanOp(const ExecutionPlan *plan, const char *alias) {
 	op->iter = NULL;
 	op->alias = alias;
 	op->child_record = NULL;
+	op->prefetch = NULL;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_ALL_NODE_SCAN, "All Node Scan", AllNodeScanInit,
@@ -72,6 +73,7 @@ static Record AllNodeScanConsumeFromChild(OpBase *opBase) {
 
 	// Populate the Record with the graph entity data.
 	Record_AddNode(r, op->nodeRecIdx, n);
+	AttributePrefetch_Apply(op->prefetch, r);
 
 	return r;
 }
@@ -85,6 +87,7 @@ static Record AllNodeScanConsume(OpBase *opBase) {
 
 	Record r = OpBase_CreateRecord((OpBase *)op);
 	Record_AddNode(r, op->nodeRecIdx, n);
+	AttributePrefetch_Apply(op->prefetch, r);
 
 	return r;
 }
@@ -111,5 +114,7 @@ static void AllNodeScanFree(OpBase *ctx) {
 		OpBase_DeleteRecord(op->child_record);
 		op->child_record = NULL;
 	}
+
+	AttributePrefetch_Free(&op->prefetch);
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "op.h"
+#include "shared/prefetch_functions.h"
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
 #include "../../graph/query_graph.h"
@@ -21,6 +22,7 @@ typedef struct {
 	uint nodeRecIdx;
 	DataBlockIterator *iter;
 	Record child_record;        /* The Record this op acts on if it is not a tap. */
+	PrefetchedAttribute *prefetch;  /* Attributes to prefetch into records. */
 } AllNodeScan;
 
 OpBase *NewAllNodeScanOp(const ExecutionPlan *plan, const char *alias);
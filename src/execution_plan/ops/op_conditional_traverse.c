@@ -191,7 +191,10 @@ static Record CondTraverseConsume(OpBase *opBase) {
 		EdgeTraverseCtx_SetEdge(op->edge_ctx, op->r);
 	}
 
-	return OpBase_DeepCloneRecord(op->r);
+	Record r = OpBase_DeepCloneRecord(op->r);
+	AttributePrefetch_Apply(op->prefetch, r);
+
+	return r;
 }
 
 static OpResult CondTraverseReset(OpBase *ctx) {
@@ -252,5 +255,7 @@ static void CondTraverseFree(OpBase *ctx) {
 		rm_free(op->records);
 		op->records = NULL;
 	}
+
+	AttributePrefetch_Free(&op->prefetch);
 }
 
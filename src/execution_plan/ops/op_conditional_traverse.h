@@ -9,6 +9,7 @@
 #include "op.h"
 #include "../execution_plan.h"
 #include "shared/traverse_functions.h"
+#include "shared/prefetch_functions.h"
 #include "../../graph/rg_matrix/rg_matrix_iter.h"
 #include "../../arithmetic/algebraic_expression.h"
 #include "../../../deps/GraphBLAS/Include/GraphBLAS.h"
@@ -28,6 +29,7 @@ typedef struct {
 	uint record_cap;            // Max number of records to process.
 	Record *records;            // Array of records.
 	Record r;                   // Currently selected record.
+	PrefetchedAttribute *prefetch;  // Attributes to prefetch into records.
 } OpCondTraverse;
 
 /* Creates a new Traverse operation */
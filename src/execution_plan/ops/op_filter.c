@@ -6,23 +6,227 @@
 
 #include "op_filter.h"
 #include "RG.h"
+#include "../../util/arr.h"
+#include "../../util/simple_timer.h"
+
+#include <inttypes.h>
+
+// conjuncts evaluation cost is sampled once every FILTER_SAMPLE_INTERVAL records
+#define FILTER_SAMPLE_INTERVAL 16
+
+// conjuncts are reordered once every FILTER_REORDER_INTERVAL records
+#define FILTER_REORDER_INTERVAL 1024
 
 /* Forward declarations. */
+static OpResult FilterInit(OpBase *opBase);
 static Record FilterConsume(OpBase *opBase);
 static OpBase *FilterClone(const ExecutionPlan *plan, const OpBase *opBase);
 static void FilterFree(OpBase *opBase);
 
+// when profiled, report each conjunct's pass rate
+// e.g. Filter | n.v > 1 (passed 40/100), n.name CONTAINS 'a' (passed 4/40)
+static void FilterToString
+(
+	const OpBase *ctx,
+	sds *buf
+) {
+	const OpFilter *op = (const OpFilter *)ctx;
+	*buf = sdscatprintf(*buf, "%s", ctx->name);
+
+	// a single conjunct's pass rate is given by the records produced
+	uint n = (op->conjuncts != NULL) ? array_len(op->conjuncts) : 0;
+	if(ctx->stats == NULL || n < 2) return;
+
+	*buf = sdscat(*buf, " | ");
+	for(uint i = 0; i < n; i++) {
+		const FilterConjunct *c = op->conjuncts + i;
+		if(i > 0) *buf = sdscat(*buf, ", ");
+		FilterTree_ToString(c->tree, buf);
+		*buf = sdscatprintf(*buf, " (passed %" PRIu64 "/%" PRIu64 ")",
+				c->passed, c->evaluated);
+	}
+}
+
 OpBase *NewFilterOp(const ExecutionPlan *plan, FT_FilterNode *filterTree) {
 	OpFilter *op = rm_malloc(sizeof(OpFilter));
-	op->filterTree = filterTree;
+	op->filterTree   = filterTree;
+	op->conjuncts    = NULL;
+	op->record_count = 0;
 
 	// Set our Op operations
-	OpBase_Init((OpBase *)op, OPType_FILTER, "Filter", NULL, FilterConsume,
-				NULL, NULL, FilterClone, FilterFree, false, plan);
+	OpBase_Init((OpBase *)op, OPType_FILTER, "Filter", FilterInit, FilterConsume,
+				NULL, FilterToString, FilterClone, FilterFree, false, plan);
 
 	return (OpBase *)op;
 }
 
+// operand evaluation can't raise an error
+// constants, parameters, variables and attributes of variables
+static bool _safeOperand
+(
+	const AR_ExpNode *exp
+) {
+	if(AR_EXP_IsConstant(exp) || AR_EXP_IsParameter(exp) ||
+	   AR_EXP_IsVariadic(exp)) {
+		return true;
+	}
+
+	return AR_EXP_IsAttribute(exp, NULL) &&
+		AR_EXP_IsVariadic(exp->op.children[0]);
+}
+
+// conjunct evaluation can't raise an error
+// such conjuncts can be evaluated in any order, while a conjunct which might
+// raise an error e.g. 10 / n.x > 2 might be guarded by a preceding conjunct
+// e.g. n.x <> 0 AND 10 / n.x > 2
+static bool _safeConjunct
+(
+	const FT_FilterNode *tree
+) {
+	switch(tree->t) {
+		case FT_N_PRED:
+			// comparisons never fail
+			return _safeOperand(tree->pred.lhs) &&
+				_safeOperand(tree->pred.rhs);
+		case FT_N_COND:
+			return _safeConjunct(tree->cond.left) &&
+				(tree->cond.right == NULL || _safeConjunct(tree->cond.right));
+		default:
+			return false;
+	}
+}
+
+// break filter tree into conjuncts and compile each
+// compilation is deferred to execution time as query parameters
+// are bound per execution while plans are cached and cloned
+static OpResult FilterInit(OpBase *opBase) {
+	OpFilter *filter = (OpFilter *)opBase;
+
+	const FT_FilterNode **sub_trees = FilterTree_SubTrees(filter->filterTree);
+	uint n = array_len(sub_trees);
+
+	filter->conjuncts = array_new(FilterConjunct, n);
+	for(uint i = 0; i < n; i++) {
+		FilterConjunct c = {
+			.tree        = sub_trees[i],
+			// trees which can't be compiled are applied as is
+			.program     = FilterTree_Compile(sub_trees[i]),
+			.evaluated   = 0,
+			.passed      = 0,
+			.timed       = 0,
+			.cost        = 0,
+			.reorderable = _safeConjunct(sub_trees[i])
+		};
+		array_append(filter->conjuncts, c);
+	}
+
+	array_free(sub_trees);
+	return OP_OK;
+}
+
+static inline bool _applyConjunct
+(
+	FilterConjunct *c,
+	Record r
+) {
+	FT_Result res = (c->program != NULL)
+		? FilterTree_applyProgram(c->program, r)
+		: FilterTree_applyFilters(c->tree, r);
+
+	// both false and null fail the filter
+	return res == FILTER_PASS;
+}
+
+// expected cost of evaluating a conjunct per record it discards
+// cheap conjuncts discarding many records should be evaluated first
+static double _conjunctRank
+(
+	const FilterConjunct *c
+) {
+	// conjuncts yet to be timed are tried first
+	if(c->timed == 0) return 0;
+
+	double cost = c->cost / c->timed;
+	double fail_rate = 1.0 - (double)c->passed / c->evaluated;
+
+	// avoid division by zero for conjuncts which never fail
+	return cost / (fail_rate + 1e-3);
+}
+
+// reorder conjuncts by rank, stable in-place insertion sort
+// filters rarely have more than a handful of conjuncts
+// conjuncts which might raise an error keep their position, other conjuncts
+// are never moved across them, such that a guarding conjunct is always
+// evaluated before the conjunct it guards
+static void _reorderConjuncts
+(
+	OpFilter *filter
+) {
+	uint n = array_len(filter->conjuncts);
+	double ranks[n];
+	for(uint i = 0; i < n; i++) ranks[i] = _conjunctRank(filter->conjuncts + i);
+
+	for(uint i = 1; i < n; i++) {
+		FilterConjunct c = filter->conjuncts[i];
+		if(!c.reorderable) continue;
+
+		double rank = ranks[i];
+		int j = i - 1;
+		while(j >= 0 && filter->conjuncts[j].reorderable && ranks[j] > rank) {
+			filter->conjuncts[j + 1] = filter->conjuncts[j];
+			ranks[j + 1] = ranks[j];
+			j--;
+		}
+		filter->conjuncts[j + 1] = c;
+		ranks[j + 1] = rank;
+	}
+}
+
+// evaluate record against all conjuncts, stops at the first failing conjunct
+static bool _applyConjuncts
+(
+	OpFilter *filter,
+	Record r
+) {
+	uint n = array_len(filter->conjuncts);
+
+	// a single conjunct is neither timed nor reordered
+	if(n == 1) {
+		FilterConjunct *c = filter->conjuncts;
+		bool pass = _applyConjunct(c, r);
+		c->evaluated++;
+		c->passed += pass;
+		return pass;
+	}
+
+	filter->record_count++;
+	bool sample = (filter->record_count % FILTER_SAMPLE_INTERVAL) == 0;
+	bool pass = true;
+
+	for(uint i = 0; i < n && pass; i++) {
+		FilterConjunct *c = filter->conjuncts + i;
+
+		if(sample) {
+			double tic[2];
+			simple_tic(tic);
+			pass = _applyConjunct(c, r);
+			c->cost += simple_toc(tic);
+			c->timed++;
+		} else {
+			pass = _applyConjunct(c, r);
+		}
+
+		c->evaluated++;
+		c->passed += pass;
+	}
+
+	if((filter->record_count % FILTER_REORDER_INTERVAL) == 0) {
+		_reorderConjuncts(filter);
+	}
+
+	return pass;
+}
+
 /* FilterConsume next operation
  * returns OP_OK when graph passes filter tree. */
 static Record FilterConsume(OpBase *opBase) {
@@ -35,7 +239,7 @@ static Record FilterConsume(OpBase *opBase) {
 		if(!r) break;
 
 		/* Pass record through filter tree */
-		if(FilterTree_applyFilters(filter->filterTree, r) == FILTER_PASS) break;
+		if(_applyConjuncts(filter, r)) break;
 		else OpBase_DeleteRecord(r);
 	}
 
@@ -51,9 +255,19 @@ static inline OpBase *FilterClone(const ExecutionPlan *plan, const OpBase *opBas
 /* Frees OpFilter*/
 static void FilterFree(OpBase *ctx) {
 	OpFilter *filter = (OpFilter *)ctx;
+	if(filter->conjuncts) {
+		uint n = array_len(filter->conjuncts);
+		for(uint i = 0; i < n; i++) {
+			if(filter->conjuncts[i].program) {
+				AR_Program_Free(filter->conjuncts[i].program);
+			}
+		}
+		array_free(filter->conjuncts);
+		filter->conjuncts = NULL;
+	}
+
 	if(filter->filterTree) {
 		FilterTree_Free(filter->filterTree);
 		filter->filterTree = NULL;
 	}
 }
-
@@ -9,12 +9,28 @@
 #include "op.h"
 #include "../execution_plan.h"
 #include "../../filter_tree/filter_tree.h"
+#include "../../filter_tree/filter_tree_compile.h"
+
+// a component of the filter tree's top level conjunction
+// conjuncts are evaluated one after the other, a record passes the filter
+// only if it passes all conjuncts
+typedef struct {
+	const FT_FilterNode *tree;  // conjunct, refers to a subtree of the filter
+	AR_Program *program;        // compiled conjunct, NULL if it isn't compiled
+	uint64_t evaluated;         // number of records evaluated
+	uint64_t passed;            // number of records passed
+	uint64_t timed;             // number of timed evaluations
+	double cost;                // accumulated time of timed evaluations
+	bool reorderable;           // conjunct can't raise an error
+} FilterConjunct;
 
 /* Filter
  * filters graph according to where cluase */
 typedef struct {
 	OpBase op;
 	FT_FilterNode *filterTree;
+	FilterConjunct *conjuncts;  // conjuncts, ordered by evaluation order
+	uint64_t record_count;      // number of records evaluated
 } OpFilter;
 
 /* Creates a new Filter operation */
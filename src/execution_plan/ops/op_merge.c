@@ -42,6 +42,13 @@ static void freeCallback
 static dictType _dt = { _id_hash, NULL, NULL, NULL, NULL, freeCallback, NULL,
 	NULL, NULL, NULL};
 
+// probe hashtable callbacks, maps key hash to batched record index
+static dictType _probe_dt = { _id_hash, NULL, NULL, NULL, NULL, NULL, NULL,
+	NULL, NULL, NULL};
+
+// max number of input records resolved by a single index probe
+#define MERGE_PROBE_BATCH_SIZE 1024
+
 //------------------------------------------------------------------------------
 // ON MATCH / ON CREATE logic
 //------------------------------------------------------------------------------
@@ -80,6 +87,445 @@ static inline Record _pullFromStream
 	return OpBase_Consume(branch);
 }
 
+// hand an unmatched input record to the Create stream
+static void _CreatePattern
+(
+	OpMerge *op,
+	Record lhs_record
+) {
+	// transfer the LHS record to the Create stream
+	// to build once we finish reading
+	// we don't need to clone the record
+	// as it won't be accessed again outside that stream
+	// but we must make sure its elements are access-safe
+	// as the input stream will be freed
+	// before entities are created
+	if(lhs_record) {
+		Record_PersistScalars(lhs_record);
+		Argument_AddRecord(op->create_argument_tap, lhs_record);
+	}
+	Record r = _pullFromStream(op->create_stream);
+	UNUSED(r);
+	ASSERT(r == NULL); // don't expect returned records
+}
+
+// attempt to resolve the pattern for a single input record
+// using the Match stream, if the pattern isn't found
+// the input record is handed to the Create stream
+// returns the number of matches
+static uint _MatchRecord
+(
+	OpMerge *op,
+	Record lhs_record,         // input record, NULL if there are no bound variables
+	bool *must_create_records  // [output] set if pattern should be created
+) {
+	if(lhs_record) {
+		// propagate record to the top of the Match stream
+		// (must clone the Record, as it will be freed in the Match stream)
+		Argument_AddRecord(op->match_argument_tap, OpBase_CloneRecord(lhs_record));
+	}
+
+	uint match_count = 0;
+	Record rhs_record;
+	// retrieve Records from the Match stream until it's depleted
+	while((rhs_record = _pullFromStream(op->match_stream))) {
+		// pattern was successfully matched
+		array_append(op->output_records, rhs_record);
+		match_count++;
+	}
+
+	if(match_count == 0) {
+		_CreatePattern(op, lhs_record);
+		*must_create_records = true;
+	} else if(lhs_record) {
+		// free the LHS Record as it wasn't transferred to the Create stream
+		OpBase_DeleteRecord(lhs_record);
+	}
+
+	return match_count;
+}
+
+//------------------------------------------------------------------------------
+// Batched index probe
+//------------------------------------------------------------------------------
+
+// the Match stream of a MERGE on indexed attributes e.g.
+// UNWIND $rows AS r MERGE (n:User {id: r.id})
+// is a single index scan fed by an Argument tap, running it once per
+// input record issues an index query per record
+// instead, input records are resolved in batches: the probed values
+// of every record in the batch are combined into a single union index query
+// and the returned nodes are hash matched back to their input records
+// records holding values the index can't answer are resolved by the Match stream
+
+// returns true if 'exp' references 'alias'
+static bool _ReferencesAlias
+(
+	AR_ExpNode *exp,
+	const char *alias
+) {
+	rax *entities = raxNew();
+	AR_EXP_CollectEntities(exp, entities);
+	bool res = raxFind(entities, (unsigned char *)alias, strlen(alias))
+		!= raxNotFound;
+	raxFree(entities);
+	return res;
+}
+
+// create a batched probe if the Match stream is a single index scan
+// fed by the Argument tap, filtering on a conjunction of equality predicates
+// of the form 'n.attr = exp' where exp doesn't reference 'n'
+static MergeProbe *_MergeProbe_New
+(
+	OpMerge *op
+) {
+	OpBase *match = op->match_stream;
+	if(match->type != OPType_NODE_BY_INDEX_SCAN ||
+	   match->childCount != 1 ||
+	   match->children[0] != (OpBase *)op->match_argument_tap) {
+		return NULL;
+	}
+
+	IndexScan *scan = (IndexScan *)match;
+	const char *alias = scan->n->alias;
+	const FT_FilterNode **preds = FilterTree_SubTrees(scan->filter);
+	uint key_count = array_len(preds);
+	MergeProbeKey *keys = array_new(MergeProbeKey, key_count);
+
+	for(uint i = 0; i < key_count; i++) {
+		char *attr;
+		const FT_FilterNode *pred = preds[i];
+		if(pred->t != FT_N_PRED                        ||
+		   pred->pred.op != OP_EQUAL                   ||
+		   !AR_EXP_IsAttribute(pred->pred.lhs, &attr)  ||
+		   !_ReferencesAlias(pred->pred.lhs, alias)    ||
+		   _ReferencesAlias(pred->pred.rhs, alias)) {
+			array_free(keys);
+			array_free(preds);
+			return NULL;
+		}
+
+		MergeProbeKey key = {.attr = attr, .attr_id = ATTRIBUTE_ID_NONE,
+			.exp = pred->pred.rhs};
+		array_append(keys, key);
+	}
+	array_free(preds);
+
+	MergeProbe *probe = rm_calloc(1, sizeof(MergeProbe));
+
+	probe->scan    = scan;
+	probe->keys    = keys;
+	probe->values  = rm_malloc(sizeof(SIValue) * MERGE_PROBE_BATCH_SIZE * key_count);
+	probe->probed  = rm_malloc(sizeof(bool) * MERGE_PROBE_BATCH_SIZE);
+	probe->matches = rm_calloc(MERGE_PROBE_BATCH_SIZE, sizeof(NodeID *));
+	probe->next    = rm_malloc(sizeof(int) * MERGE_PROBE_BATCH_SIZE);
+	probe->rows    = HashTableCreate(&_probe_dt);
+
+	return probe;
+}
+
+// release batch resources
+static void _MergeProbe_Clear
+(
+	MergeProbe *probe
+) {
+	uint key_count = array_len(probe->keys);
+	for(uint i = 0; i < probe->n * key_count; i++) {
+		SIValue_Free(probe->values[i]);
+	}
+
+	for(uint i = 0; i < probe->n; i++) {
+		if(probe->matches[i] != NULL) array_clear(probe->matches[i]);
+	}
+
+	HashTableEmpty(probe->rows, NULL);
+	probe->n = 0;
+}
+
+static void _MergeProbe_Free
+(
+	MergeProbe *probe
+) {
+	_MergeProbe_Clear(probe);
+
+	for(uint i = 0; i < MERGE_PROBE_BATCH_SIZE; i++) {
+		if(probe->matches[i] != NULL) array_free(probe->matches[i]);
+	}
+
+	HashTableRelease(probe->rows);
+	array_free(probe->keys);
+	rm_free(probe->values);
+	rm_free(probe->probed);
+	rm_free(probe->matches);
+	rm_free(probe->next);
+	rm_free(probe);
+}
+
+// returns true if the index can answer an equality query on 'v'
+// see _predicateTreeToRange
+static inline bool _Probeable
+(
+	SIValue v
+) {
+	SIType t = SI_TYPE(v);
+	if(t == T_STRING || t == T_DOUBLE || t == T_BOOL) return true;
+	return (t == T_INT64 && !(v.longval & 0x7FF0000000000000));
+}
+
+// equality as answered by the index
+// strings compare exactly, numerics and booleans are compared as doubles
+static inline bool _ProbeEq
+(
+	SIValue a,
+	SIValue b
+) {
+	SIType ta = SI_TYPE(a);
+	SIType tb = SI_TYPE(b);
+
+	if(ta == T_STRING || tb == T_STRING) {
+		return ta == tb && strcmp(a.stringval, b.stringval) == 0;
+	}
+
+	if(!(ta & (SI_NUMERIC | T_BOOL)) || !(tb & (SI_NUMERIC | T_BOOL))) {
+		return false;
+	}
+
+	return SI_GET_NUMERIC(a) == SI_GET_NUMERIC(b);
+}
+
+// hash a set of probed values consistently with _ProbeEq
+static XXH64_hash_t _ProbeHash
+(
+	const SIValue *values,
+	uint n
+) {
+	XXH64_state_t state;
+	XXH_errorcode res = XXH64_reset(&state, 0);
+	UNUSED(res);
+	ASSERT(res != XXH_ERROR);
+
+	for(uint i = 0; i < n; i++) {
+		SIValue v = values[i];
+		if(SI_TYPE(v) == T_STRING) {
+			XXH64_update(&state, v.stringval, strlen(v.stringval));
+		} else {
+			// normalize -0.0
+			double d = SI_GET_NUMERIC(v);
+			if(d == 0) d = 0;
+			XXH64_update(&state, &d, sizeof(d));
+		}
+	}
+
+	return XXH64_digest(&state);
+}
+
+// build an index query matching the probed values of a single record
+static RSQNode *_ProbeQueryNode
+(
+	MergeProbe *probe,
+	RSIndex *idx,
+	const SIValue *values
+) {
+	uint key_count = array_len(probe->keys);
+	RSQNode *root = (key_count > 1) ?
+		RediSearch_CreateIntersectNode(idx, false) : NULL;
+
+	for(uint i = 0; i < key_count; i++) {
+		RSQNode *node;
+		SIValue v = values[i];
+		const char *field = probe->keys[i].attr;
+
+		if(SI_TYPE(v) == T_STRING) {
+			node = RediSearch_CreateTagNode(idx, field);
+			RediSearch_QueryNodeAddChild(node,
+					RediSearch_CreateTagTokenNode(idx, v.stringval));
+		} else {
+			double d = SI_GET_NUMERIC(v);
+			node = RediSearch_CreateNumericNode(idx, field, d, d, true, true);
+		}
+
+		if(root == NULL) return node;
+		RediSearch_QueryNodeAddChild(root, node);
+	}
+
+	return root;
+}
+
+// probe the index for the last 'n' input records
+// populating the matches of every probed record
+static void _MergeProbe_Batch
+(
+	OpMerge *op,
+	uint n
+) {
+	MergeProbe *probe  = op->probe;
+	IndexScan  *scan   = probe->scan;
+	RSIndex    *idx    = scan->idx;
+	Graph      *g      = scan->g;
+	Record     *inputs = op->input_records;
+	uint key_count     = array_len(probe->keys);
+	uint input_count   = array_len(inputs);
+	uint query_count   = 0;
+	bool distinct[n];  // whether record's values weren't seen in batch
+
+	ASSERT(n <= MERGE_PROBE_BATCH_SIZE);
+	ASSERT(n <= input_count);
+
+	//--------------------------------------------------------------------------
+	// evaluate probed values
+	//--------------------------------------------------------------------------
+
+	for(uint i = 0; i < n; i++) {
+		// records are processed in pop order
+		Record r = inputs[input_count - 1 - i];
+		SIValue *values = probe->values + (i * key_count);
+
+		for(uint j = 0; j < key_count; j++) values[j] = SI_NullVal();
+		probe->n = i + 1;
+
+		bool probeable = true;
+		for(uint j = 0; j < key_count && probeable; j++) {
+			values[j] = AR_EXP_Evaluate(probe->keys[j].exp, r);
+			probeable = _Probeable(values[j]);
+		}
+
+		probe->probed[i] = probeable;
+		probe->next[i]   = -1;
+		distinct[i]      = false;
+		if(!probeable) continue;
+
+		// chain record with previous records sharing the same hash
+		// only records with distinct values contribute to the index query
+		bool dup = false;
+		XXH64_hash_t h = _ProbeHash(values, key_count);
+		dictEntry *entry = HashTableAddOrFind(probe->rows, (void *)h);
+		int head = (int)(intptr_t)HashTableGetVal(entry) - 1;
+
+		for(int k = head; k != -1 && !dup; k = probe->next[k]) {
+			SIValue *other = probe->values + (k * key_count);
+			dup = true;
+			for(uint j = 0; j < key_count && dup; j++) {
+				dup = _ProbeEq(values[j], other[j]);
+			}
+		}
+
+		probe->next[i] = head;
+		HashTableSetVal(probe->rows, entry, (void *)(intptr_t)(i + 1));
+
+		distinct[i] = !dup;
+		query_count += !dup;
+	}
+
+	if(query_count == 0) return;
+
+	//--------------------------------------------------------------------------
+	// probe index
+	//--------------------------------------------------------------------------
+
+	// union the queries of all records holding distinct values
+	RSQNode *U = RediSearch_CreateUnionNode(idx);
+	for(uint i = 0; i < n; i++) {
+		if(!distinct[i]) continue;
+		SIValue *values = probe->values + (i * key_count);
+		RediSearch_QueryNodeAddChild(U, _ProbeQueryNode(probe, idx, values));
+	}
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	for(uint j = 0; j < key_count; j++) {
+		probe->keys[j].attr_id = GraphContext_GetAttributeID(gc,
+				probe->keys[j].attr);
+	}
+
+	SIValue node_values[key_count];
+	const EntityID *id;
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(U, idx);
+
+	while((id = RediSearch_ResultsIteratorNext(iter, idx, NULL)) != NULL) {
+		Node node = GE_NEW_NODE();
+		int res = Graph_GetNode(g, *id, &node);
+		UNUSED(res);
+		ASSERT(res != 0);
+
+		for(uint j = 0; j < key_count; j++) {
+			SIValue *v = GraphEntity_GetProperty((GraphEntity *)&node,
+					probe->keys[j].attr_id);
+			node_values[j] = (v == ATTRIBUTE_NOTFOUND) ? SI_NullVal() : *v;
+		}
+
+		// hash match node against batched records
+		XXH64_hash_t h = _ProbeHash(node_values, key_count);
+		int head = (int)(intptr_t)HashTableFetchValue(probe->rows, (void *)h) - 1;
+
+		for(int k = head; k != -1; k = probe->next[k]) {
+			SIValue *values = probe->values + (k * key_count);
+			bool match = true;
+			for(uint j = 0; j < key_count && match; j++) {
+				match = _ProbeEq(values[j], node_values[j]);
+			}
+			if(!match) continue;
+
+			if(probe->matches[k] == NULL) {
+				probe->matches[k] = array_new(NodeID, 1);
+			}
+			array_append(probe->matches[k], *id);
+		}
+	}
+
+	// free iterator, releasing the index read lock
+	RediSearch_ResultsIteratorFree(iter);
+}
+
+// resolve all input records through the batched index probe
+static uint _MergeProbe_Match
+(
+	OpMerge *op,
+	bool *must_create_records  // [output] set if pattern should be created
+) {
+	MergeProbe *probe = op->probe;
+	IndexScan *scan = probe->scan;
+	uint match_count = 0;
+
+	while(array_len(op->input_records) > 0) {
+		uint n = MIN(array_len(op->input_records), MERGE_PROBE_BATCH_SIZE);
+		_MergeProbe_Batch(op, n);
+
+		// process batched records in the same order the Match stream would
+		for(uint i = 0; i < n; i++) {
+			Record lhs_record = array_pop(op->input_records);
+
+			if(!probe->probed[i]) {
+				match_count += _MatchRecord(op, lhs_record, must_create_records);
+				continue;
+			}
+
+			NodeID *matches = probe->matches[i];
+			uint m = (matches != NULL) ? array_len(matches) : 0;
+			for(uint j = 0; j < m; j++) {
+				// emit the same record the index scan would have
+				Record r = OpBase_CloneRecord(lhs_record);
+				Node node = GE_NEW_NODE();
+				int res = Graph_GetNode(scan->g, matches[j], &node);
+				UNUSED(res);
+				ASSERT(res != 0);
+				Record_AddNode(r, scan->nodeRecIdx, node);
+				array_append(op->output_records, r);
+			}
+			match_count += m;
+
+			if(m == 0) {
+				_CreatePattern(op, lhs_record);
+				*must_create_records = true;
+			} else {
+				OpBase_DeleteRecord(lhs_record);
+			}
+		}
+
+		_MergeProbe_Clear(probe);
+	}
+
+	return match_count;
+}
+
 static void _InitializeUpdates
 (
 	OpMerge *op,
@@ -254,6 +700,9 @@ static OpResult MergeInit
 	// set up an array to store records produced by the bound variable stream
 	op->input_records = array_new(Record, 1);
 
+	// try resolving the Match stream using batched index probes
+	op->probe = _MergeProbe_New(op);
+
 	return OP_OK;
 }
 
@@ -304,6 +753,12 @@ static Record MergeConsume
 	uint match_count         = 0;
 	bool reading_matches     = true;
 	bool must_create_records = false;
+
+	// resolve input records in batches using a single index probe per batch
+	if(op->probe != NULL && op->input_records != NULL) {
+		match_count += _MergeProbe_Match(op, &must_create_records);
+	}
+
 	// match mode: attempt to resolve the pattern for every record from
 	// the bound variable stream, or once if we have no bound variables
 	while(reading_matches) {
@@ -317,48 +772,13 @@ static Record MergeConsume
 
 			// pull a new input record
 			lhs_record = array_pop(op->input_records);
-			// propagate record to the top of the Match stream
-			// (must clone the Record, as it will be freed in the Match stream)
-			Argument_AddRecord(op->match_argument_tap, OpBase_CloneRecord(lhs_record));
 		} else {
 			// this loop only executes once if we don't have input records
 			// resolving bound variables
 			reading_matches = false;
 		}
 
-		Record rhs_record;
-		bool should_create_pattern = true;
-		// retrieve Records from the Match stream until it's depleted
-		while((rhs_record = _pullFromStream(op->match_stream))) {
-			// pattern was successfully matched
-			should_create_pattern = false;
-			array_append(op->output_records, rhs_record);
-			match_count++;
-		}
-
-		if(should_create_pattern) {
-			// transfer the LHS record to the Create stream
-			// to build once we finish reading
-			// we don't need to clone the record
-			// as it won't be accessed again outside that stream
-			// but we must make sure its elements are access-safe
-			// as the input stream will be freed
-			// before entities are created
-			if(lhs_record) {
-				Record_PersistScalars(lhs_record);
-				Argument_AddRecord(op->create_argument_tap, lhs_record);
-				lhs_record = NULL;
-			}
-			Record r = _pullFromStream(op->create_stream);
-			UNUSED(r);
-			ASSERT(r == NULL); // don't expect returned records
-			must_create_records = true;
-		}
-
-		// free the LHS Record if we haven't transferred it to the Create stream
-		if(lhs_record) {
-			OpBase_DeleteRecord(lhs_record);
-		}
+		match_count += _MatchRecord(op, lhs_record, &must_create_records);
 	}
 
 	//--------------------------------------------------------------------------
@@ -479,6 +899,11 @@ static void MergeFree
 
 	_free_pending_updates(op);
 
+	if(op->probe) {
+		_MergeProbe_Free(op->probe);
+		op->probe = NULL;
+	}
+
 	if(op->on_match) {
 		raxFreeWithCallback(op->on_match, (void(*)(void *))UpdateCtx_Free);
 		op->on_match = NULL;
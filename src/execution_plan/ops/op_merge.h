@@ -8,10 +8,32 @@
 
 #include "op.h"
 #include "op_argument.h"
+#include "op_node_by_index_scan.h"
 #include "../execution_plan.h"
 #include "shared/update_functions.h"
 #include "../../resultset/resultset_statistics.h"
 
+// equality predicate 'n.attr = exp' used to probe the match stream's index
+typedef struct {
+	const char *attr;      // probed attribute name
+	Attribute_ID attr_id;  // probed attribute ID
+	AR_ExpNode *exp;       // expression evaluating the probed value per input record
+} MergeProbeKey;
+
+// batched index probe
+// resolves the Match stream for a batch of input records
+// using a single index query
+typedef struct {
+	IndexScan *scan;      // match stream index scan
+	MergeProbeKey *keys;  // equality keys the index scan filters on
+	SIValue *values;      // probed values, one per key for each batched record
+	bool *probed;         // whether a batched record was probed
+	NodeID **matches;     // matching node IDs for each batched record
+	int *next;            // chains batched records sharing a key hash
+	dict *rows;           // key hash to first batched record
+	uint n;               // number of batched records
+} MergeProbe;
+
 /* The Merge operation accepts exactly one path in the query and attempts to match it.
  * If the path is not found, it will be created, making new instances of every path variable
  * not bound in an earlier clause in the query. */
@@ -30,6 +52,7 @@ typedef struct {
 	raxIterator on_create_it;                // Iterator for traversing ON CREATE update contexts.
 	dict *node_pending_updates;              // Pending updates to apply, generated 
 	dict *edge_pending_updates;              // Pending updates to apply, generated 
+	MergeProbe *probe;                       // Batched index probe replacing the Match stream, optional.
 } OpMerge;
 
 OpBase *NewMergeOp(const ExecutionPlan *plan, rax *on_match, rax *on_create);
@@ -35,6 +35,7 @@ OpBase *NewNodeByIdSeekOp(const ExecutionPlan *plan, const char *alias, Unsigned
 	op->g = QueryCtx_GetGraph();
 	op->child_record = NULL;
 	op->alias = alias;
+	op->prefetch = NULL;
 
 	op->minId = id_range->include_min ? id_range->min : id_range->min + 1;
 	/* The largest possible entity ID is the same as Graph_RequiredMatrixDim.
@@ -107,6 +108,7 @@ static Record NodeByIdSeekConsumeFromChild(OpBase *opBase) {
 
 	// Populate the Record with the actual node.
 	Record_AddNode(r, op->nodeRecIdx, n);
+	AttributePrefetch_Apply(op->prefetch, r);
 
 	return r;
 }
@@ -122,6 +124,7 @@ static Record NodeByIdSeekConsume(OpBase *opBase) {
 
 	// Populate the Record with the actual node.
 	Record_AddNode(r, op->nodeRecIdx, n);
+	AttributePrefetch_Apply(op->prefetch, r);
 
 	return r;
 }
@@ -155,5 +158,7 @@ static void NodeByIdSeekFree(OpBase *opBase) {
 		OpBase_DeleteRecord(op->child_record);
 		op->child_record = NULL;
 	}
+
+	AttributePrefetch_Free(&op->prefetch);
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "op.h"
+#include "shared/prefetch_functions.h"
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
 #include "../../util/range/unsigned_range.h"
@@ -23,6 +24,7 @@ typedef struct {
 	NodeID minId;           // Min ID to fetch.
 	NodeID maxId;           // Max ID to fetch.
 	int nodeRecIdx;         // Position of entity within record.
+	PrefetchedAttribute *prefetch;  // Attributes to prefetch into records.
 } NodeByIdSeek;
 
 OpBase *NewNodeByIdSeekOp(const ExecutionPlan *plan, const char *alias, UnsignedRange *id_range);
@@ -7,12 +7,19 @@
 #include "op_node_by_index_scan.h"
 #include "../../query_ctx.h"
 #include "shared/print_functions.h"
+#include "../../datatypes/point.h"
 #include "../../filter_tree/ft_to_rsq.h"
 
+// initial radius of a k nearest neighbors search, in meters
+#define KNN_INITIAL_RADIUS 1000
+// radius covering the entire globe, in meters
+#define KNN_MAX_RADIUS 21000000
+
 // forward declarations
 static OpResult IndexScanInit(OpBase *opBase);
 static Record IndexScanConsume(OpBase *opBase);
 static Record IndexScanConsumeFromChild(OpBase *opBase);
+static Record IndexScanKNNConsume(OpBase *opBase);
 static OpResult IndexScanReset(OpBase *opBase);
 static void IndexScanFree(OpBase *opBase);
 
@@ -36,8 +43,15 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
 	op->iter                 =  NULL;
 	op->filter               =  filter;
 	op->child_record         =  NULL;
+	op->prefetch             =  NULL;
 	op->unresolved_filters   =  NULL;
 	op->rebuild_index_query  =  false;
+	op->knn.k                =  0;
+	op->knn.field            =  NULL;
+	op->knn.origin           =  NULL;
+	op->knn.scan_label       =  false;
+	op->join_key.filter      =  NULL;
+	op->join_key.attr        =  NULL;
 
 	// Set our Op operations
 	OpBase_Init((OpBase *)op, OPType_NODE_BY_INDEX_SCAN, "Node By Index Scan", IndexScanInit, IndexScanConsume,
@@ -47,6 +61,53 @@ OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
 	return (OpBase *)op;
 }
 
+OpBase *NewIndexScanKNNOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
+		RSIndex *idx, const char *field, AR_ExpNode *origin, uint64_t k) {
+	// validate inputs
+	ASSERT(g      != NULL);
+	ASSERT(idx    != NULL);
+	ASSERT(plan   != NULL);
+	ASSERT(field  != NULL);
+	ASSERT(origin != NULL);
+	ASSERT(k      > 0);
+
+	IndexScan *op = rm_malloc(sizeof(IndexScan));
+	op->g                    =  g;
+	op->n                    =  n;
+	op->idx                  =  idx;
+	op->iter                 =  NULL;
+	op->filter               =  NULL;
+	op->child_record         =  NULL;
+	op->prefetch             =  NULL;
+	op->unresolved_filters   =  NULL;
+	op->rebuild_index_query  =  false;
+	op->knn.k                =  k;
+	op->knn.field            =  rm_strdup(field);
+	op->knn.origin           =  origin;
+	op->knn.scan_label       =  false;
+	op->join_key.filter      =  NULL;
+	op->join_key.attr        =  NULL;
+
+	// set our op operations
+	OpBase_Init((OpBase *)op, OPType_NODE_BY_INDEX_SCAN, "Node By Index Scan",
+			IndexScanInit, IndexScanKNNConsume, IndexScanReset,
+			IndexScanToString, NULL, IndexScanFree, false, plan);
+
+	op->nodeRecIdx = OpBase_Modifies((OpBase *)op, n->alias);
+	return (OpBase *)op;
+}
+
+void IndexScanOp_SetJoinKeyFilter(IndexScan *op, const JoinKeyFilter *filter,
+		AR_ExpNode *attr) {
+	ASSERT(op     != NULL);
+	ASSERT(attr   != NULL);
+	ASSERT(filter != NULL);
+	ASSERT(op->join_key.attr == NULL);
+
+	op->join_key.filter = filter;
+	op->join_key.attr   = attr;
+}
+
 static OpResult IndexScanInit(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
@@ -79,6 +140,45 @@ static inline void _UpdateRecord(IndexScan *op, Record r, EntityID node_id) {
 	int res = Graph_GetNode(op->g, node_id, &n);
 	ASSERT(res != 0);
 	Record_AddNode(r, op->nodeRecIdx, n);
+
+	AttributePrefetch_Apply(op->prefetch, r);
+}
+
+// convert filter into a RediSearch query, populating unresolved filters
+// once a join published its key range, the query is narrowed to that range
+static RSQNode *_BuildIndexQuery
+(
+	IndexScan *op,              // index scan operation
+	const FT_FilterNode *filter // filter to convert
+) {
+	double min;
+	double max;
+	if(op->join_key.filter == NULL ||
+	   !JoinKeyFilter_Range(op->join_key.filter, &min, &max)) {
+		return FilterTreeToQueryNode(&op->unresolved_filters, filter, op->idx);
+	}
+
+	// filter AND attr >= min AND attr <= max
+	FT_FilterNode *ge = FilterTree_CreatePredicateFilter(OP_GE,
+			AR_EXP_Clone(op->join_key.attr),
+			AR_EXP_NewConstOperandNode(SI_DoubleVal(min)));
+	FT_FilterNode *le = FilterTree_CreatePredicateFilter(OP_LE,
+			AR_EXP_Clone(op->join_key.attr),
+			AR_EXP_NewConstOperandNode(SI_DoubleVal(max)));
+
+	FT_FilterNode *range = FilterTree_CreateConditionFilter(OP_AND);
+	FilterTree_AppendLeftChild(range, ge);
+	FilterTree_AppendRightChild(range, le);
+
+	FT_FilterNode *root = FilterTree_CreateConditionFilter(OP_AND);
+	FilterTree_AppendLeftChild(root, FilterTree_Clone(filter));
+	FilterTree_AppendRightChild(root, range);
+
+	RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
+			root, op->idx);
+	FilterTree_Free(root);
+
+	return rs_query_node;
 }
 
 static inline bool _PassUnresolvedFilters(const IndexScan *op, Record r) {
@@ -158,8 +258,7 @@ pull_index:
 		#endif
 
 		// convert filter into a RediSearch query
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				filter, op->idx);
+		RSQNode *rs_query_node = _BuildIndexQuery(op, filter);
 		FilterTree_Free(filter);
 
 		// create iterator
@@ -170,7 +269,7 @@ pull_index:
 		// reset it if already initialized
 		if(op->iter == NULL) {
 			// first call to consume, create query and iterator
-			RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters, op->filter, op->idx);
+			RSQNode *rs_query_node = _BuildIndexQuery(op, op->filter);
 			ASSERT(rs_query_node != NULL);
 			op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 		} else {
@@ -188,8 +287,7 @@ static Record IndexScanConsume(OpBase *opBase) {
 
 	// create iterator on first call
 	if(op->iter == NULL) {
-		RSQNode *rs_query_node = FilterTreeToQueryNode(&op->unresolved_filters,
-				op->filter, op->idx);
+		RSQNode *rs_query_node = _BuildIndexQuery(op, op->filter);
 
 		op->iter = RediSearch_GetResultsIterator(rs_query_node, op->idx);
 	}
@@ -213,9 +311,93 @@ static Record IndexScanConsume(OpBase *opBase) {
 	return NULL;
 }
 
+// counts indexed nodes within 'radius' meters of 'origin', stops at 'k'
+static uint64_t _KNNCount(IndexScan *op, SIValue origin, double radius) {
+	RSQNode *q = RediSearch_CreateGeoNode(op->idx, op->knn.field,
+			Point_lat(origin), Point_lon(origin), radius, RS_GEO_DISTANCE_M);
+	RSResultsIterator *iter = RediSearch_GetResultsIterator(q, op->idx);
+
+	uint64_t count = 0;
+	while(count < op->knn.k &&
+		  RediSearch_ResultsIteratorNext(iter, op->idx, NULL) != NULL) {
+		count++;
+	}
+
+	RediSearch_ResultsIteratorFree(iter);
+	return count;
+}
+
+// find the smallest radius, growing geometrically, enclosing at least
+// k indexed nodes and query all nodes within it
+// if the index holds fewer than k nodes every labeled node is produced
+// as nodes lacking a point are ordered last
+static void _KNNQuery(IndexScan *op) {
+	SIValue origin = AR_EXP_Evaluate(op->knn.origin, NULL);
+
+	if(SI_TYPE(origin) == T_POINT) {
+		double radius = KNN_INITIAL_RADIUS;
+		while(true) {
+			if(_KNNCount(op, origin, radius) == op->knn.k) {
+				// pad radius to account for differences between
+				// the index's distance metric and the distance function
+				radius = radius * 1.01 + 10;
+				RSQNode *q = RediSearch_CreateGeoNode(op->idx, op->knn.field,
+						Point_lat(origin), Point_lon(origin), radius,
+						RS_GEO_DISTANCE_M);
+				op->iter = RediSearch_GetResultsIterator(q, op->idx);
+				SIValue_Free(origin);
+				return;
+			}
+
+			if(radius >= KNN_MAX_RADIUS) break;
+			radius *= 4;
+			if(radius > KNN_MAX_RADIUS) radius = KNN_MAX_RADIUS;
+		}
+	}
+
+	SIValue_Free(origin);
+
+	op->knn.scan_label = true;
+	RG_MatrixTupleIter_attach(&op->knn.it,
+			Graph_GetLabelMatrix(op->g, op->n->label_id));
+}
+
+static Record IndexScanKNNConsume(OpBase *opBase) {
+	IndexScan *op = (IndexScan *)opBase;
+
+	// locate nearest neighbors on first call
+	if(op->iter == NULL && !op->knn.scan_label) _KNNQuery(op);
+
+	Record r = OpBase_CreateRecord((OpBase *)op);
+
+	if(op->knn.scan_label) {
+		GrB_Index nodeId;
+		if(RG_MatrixTupleIter_next_BOOL(&op->knn.it, &nodeId, NULL, NULL)
+				== GrB_SUCCESS) {
+			_UpdateRecord(op, r, nodeId);
+			return r;
+		}
+	} else {
+		const EntityID *nodeId = RediSearch_ResultsIteratorNext(op->iter,
+				op->idx, NULL);
+		if(nodeId != NULL) {
+			_UpdateRecord(op, r, *nodeId);
+			return r;
+		}
+	}
+
+	OpBase_DeleteRecord(r);
+	return NULL;
+}
+
 static OpResult IndexScanReset(OpBase *opBase) {
 	IndexScan *op = (IndexScan *)opBase;
 
+	if(op->knn.scan_label) {
+		RG_MatrixTupleIter_detach(&op->knn.it);
+		op->knn.scan_label = false;
+	}
+
 	if(op->iter) {
 		RediSearch_ResultsIteratorFree(op->iter);
 		op->iter = NULL;
@@ -245,16 +427,38 @@ static void IndexScanFree(OpBase *opBase) {
 		op->child_record = NULL;
 	}
 
+	if(op->knn.scan_label) {
+		RG_MatrixTupleIter_detach(&op->knn.it);
+		op->knn.scan_label = false;
+	}
+
+	if(op->knn.origin != NULL) {
+		AR_EXP_Free(op->knn.origin);
+		op->knn.origin = NULL;
+	}
+
+	if(op->knn.field != NULL) {
+		rm_free(op->knn.field);
+		op->knn.field = NULL;
+	}
+
 	if(op->filter != NULL) {
 		FilterTree_Free(op->filter);
 		op->filter = NULL;
 	}
 
+	if(op->join_key.attr != NULL) {
+		AR_EXP_Free(op->join_key.attr);
+		op->join_key.attr = NULL;
+	}
+
 	if(op->unresolved_filters != NULL) {
 		FilterTree_Free(op->unresolved_filters);
 		op->unresolved_filters = NULL;
 	}
 
+	AttributePrefetch_Free(&op->prefetch);
+
 	if(op->n != NULL) {
 		NodeScanCtx_Free(op->n);
 		op->n = NULL;
@@ -11,7 +11,11 @@
 #include "../../graph/graph.h"
 #include "../../index/index.h"
 #include "shared/scan_functions.h"
+#include "shared/prefetch_functions.h"
+#include "shared/join_key_filter.h"
 #include "redisearch_api.h"
+#include "../../graph/rg_matrix/rg_matrix_iter.h"
+#include "../../arithmetic/arithmetic_expression.h"
 
 typedef struct {
 	OpBase op;
@@ -24,9 +28,32 @@ typedef struct {
 	FT_FilterNode *filter;              // filter from which to compose index query
 	FT_FilterNode *unresolved_filters;  // subset of filter, contains filters that couldn't be resolved by index
 	Record child_record;                // the Record this op acts on if it is not a tap
+	PrefetchedAttribute *prefetch;      // attributes to prefetch into records
+	struct {
+		char *field;                    // indexed point attribute
+		AR_ExpNode *origin;             // point distances are measured from
+		uint64_t k;                     // number of nearest nodes required
+		bool scan_label;                // fewer than k nodes are indexed
+		RG_MatrixTupleIter it;          // label matrix iterator
+	} knn;                              // k nearest neighbors search
+	struct {
+		const JoinKeyFilter *filter;    // keys cached by a join's build side
+		AR_ExpNode *attr;               // scanned attribute joined on
+	} join_key;                         // join key range narrowing the index query
 } IndexScan;
 
 // creates a new IndexScan operation
 OpBase *NewIndexScanOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
 		RSIndex *idx, FT_FilterNode *filter);
 
+// creates a new IndexScan operation producing a superset of the 'k' nodes
+// nearest to 'origin', ordered by the distance between 'field' and 'origin'
+// results are not ordered, the operation is expected to feed a sort
+OpBase *NewIndexScanKNNOp(const ExecutionPlan *plan, Graph *g, NodeScanCtx *n,
+		RSIndex *idx, const char *field, AR_ExpNode *origin, uint64_t k);
+
+// narrow index query to the range of keys cached by a join
+// 'attr' is an indexed numeric attribute of the scanned node
+// the range is applied once 'filter' is populated
+void IndexScanOp_SetJoinKeyFilter(IndexScan *op, const JoinKeyFilter *filter,
+		AR_ExpNode *attr);
@@ -146,6 +146,8 @@ static inline void _UpdateRecord
 	Node n = GE_NEW_NODE();
 	Graph_GetNode(op->g, node_id, &n);
 	Record_AddNode(r, op->nodeRecIdx, n);
+
+	AttributePrefetch_Apply(op->prefetch, r);
 }
 
 static inline void _ResetIterator
@@ -269,4 +271,6 @@ static void NodeByLabelScanFree(OpBase *op) {
 		NodeScanCtx_Free(nodeByLabelScan->n);
 		nodeByLabelScan->n = NULL;
 	}
+
+	AttributePrefetch_Free(&nodeByLabelScan->prefetch);
 }
@@ -8,6 +8,7 @@
 
 #include "op.h"
 #include "shared/scan_functions.h"
+#include "shared/prefetch_functions.h"
 #include "../execution_plan.h"
 #include "../../graph/graph.h"
 #include "../../graph/entities/node.h"
@@ -25,6 +26,7 @@ typedef struct {
 	UnsignedRange *id_range;    // ID range to iterate over
 	RG_MatrixTupleIter iter;    // Iterator over label matrix
 	Record child_record;        // The Record this op acts on if it is not a tap
+	PrefetchedAttribute *prefetch;  // attributes to prefetch into records
 } NodeByLabelScan;
 
 /* Creates a new NodeByLabelScan operation */
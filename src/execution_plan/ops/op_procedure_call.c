@@ -123,14 +123,14 @@ static Record ProcCallConsume(OpBase *opBase) {
 		Proc_Free(op->procedure);
 		op->procedure = Proc_Get(op->proc_name);
 
-		// at the moment the only two procedures that can modify the graph are:
-		// proc_fulltext_create_index
-		// proc_fulltext_drop_index
-		// both perform the modification once invoked without returning any
-		// additional data (consume/step) function
+		// procedures which modify the graph e.g.
+		// db.idx.fulltext.createNodeIndex, algo.pageRank.write,
+		// algo.wcc.write and algo.MSBFS.write
+		// perform all of their modifications once invoked, their step
+		// function at most returns a summary of the changes made
 		// this is why acquiring the write lock as we do below works
-		// we will have to revisit this logic once new "write" procedures are
-		// introduced
+		// a write procedure modifying the graph from its step function
+		// would require revisiting this logic
 
 		// lock if procedure can modify the graph
 		if(!Procedure_IsReadOnly(op->procedure)) QueryCtx_LockForCommit();
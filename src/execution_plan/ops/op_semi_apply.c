@@ -7,6 +7,13 @@
 #include "op_semi_apply.h"
 #include "../execution_plan.h"
 #include "../execution_plan_build/execution_plan_util.h"
+#include "../../query_ctx.h"
+
+// number of bound records applied to the match branch
+// before the pattern is evaluated in bulk
+// evaluating a pattern for all nodes is wasteful when only a few
+// bound records are checked
+#define BULK_THRESHOLD 64
 
 // Forward declarations.
 static OpResult SemiApplyInit(OpBase *opBase);
@@ -26,6 +33,11 @@ OpBase *NewSemiApplyOp(const ExecutionPlan *plan, bool anti) {
 	op->op_arg = NULL;
 	op->bound_branch = NULL;
 	op->match_branch = NULL;
+	op->ae = NULL;
+	op->src_idx = -1;
+	op->applied = 0;
+	op->sources = NULL;
+	op->ae_optimized = false;
 	// Set our Op operations
 	if(anti) {
 		OpBase_Init((OpBase *)op, OPType_ANTI_SEMI_APPLY, "Anti Semi Apply", SemiApplyInit,
@@ -53,8 +65,114 @@ static OpResult SemiApplyInit(OpBase *opBase) {
 	return OP_OK;
 }
 
-/* This function pulls a record from the op's bounded branch, set it as an argument for the op match branch
- * and consumes a record from the match branch. If there is a record from the match branch,
+void SemiApplyOp_SetPattern
+(
+	OpSemiApply *op,
+	AlgebraicExpression *ae,
+	int src_idx
+) {
+	ASSERT(op      != NULL);
+	ASSERT(ae      != NULL);
+	ASSERT(op->ae  == NULL);
+	ASSERT(src_idx >= 0);
+
+	op->ae      = ae;
+	op->src_idx = src_idx;
+}
+
+// evaluate pattern for all nodes
+// sources[i] is set if the pattern exists for node i
+static void _evalPattern(OpSemiApply *op) {
+	Graph *g = QueryCtx_GetGraph();
+	GrB_Index dim = Graph_RequiredMatrixDim(g);
+
+	RG_Matrix M;
+	GrB_Info info = RG_Matrix_new(&M, GrB_BOOL, dim, dim);
+	ASSERT(info == GrB_SUCCESS);
+
+	// fetch operands and apply transpositions
+	// deferred to execution as labels and relationships
+	// might be introduced by the query itself
+	if(!op->ae_optimized) {
+		AlgebraicExpression_Optimize(&op->ae);
+		op->ae_optimized = true;
+	}
+
+	// a single operand expression evaluates to the operand itself
+	RG_Matrix res = AlgebraicExpression_Eval(op->ae, M);
+
+	GrB_Matrix A;
+	info = RG_Matrix_export(&A, res);
+	ASSERT(info == GrB_SUCCESS);
+
+	GrB_Index nrows;
+	GrB_Index ncols;
+	info = GrB_Matrix_nrows(&nrows, A);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Matrix_ncols(&ncols, A);
+	ASSERT(info == GrB_SUCCESS);
+
+	// reduce rows using the matrix structure, values might be edge ids
+	// sources = A any.pair ones
+	GrB_Vector ones;
+	info = GrB_Vector_new(&ones, GrB_BOOL, ncols);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_Vector_assign_BOOL(ones, NULL, NULL, true, GrB_ALL, ncols, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GrB_Vector_new(&op->sources, GrB_BOOL, nrows);
+	ASSERT(info == GrB_SUCCESS);
+	info = GrB_mxv(op->sources, NULL, NULL, GxB_ANY_PAIR_BOOL, A, ones, NULL);
+	ASSERT(info == GrB_SUCCESS);
+	UNUSED(info);
+
+	GrB_Vector_free(&ones);
+	GrB_Matrix_free(&A);
+	RG_Matrix_free(&M);
+}
+
+// probe sources vector for the bound record's source node
+static bool _probePattern(OpSemiApply *op) {
+	if(op->sources == NULL) _evalPattern(op);
+
+	// the match branch discards records missing the source node
+	// e.g. a failed OPTIONAL MATCH
+	Node *n = Record_GetNode(op->r, op->src_idx);
+	if(n == NULL) return false;
+
+	bool x;
+	GrB_Info info = GrB_Vector_extractElement_BOOL(&x, op->sources,
+			ENTITY_GET_ID(n));
+	return info == GrB_SUCCESS;
+}
+
+/* This function sets the bound record as an argument for the op match branch
+ * and consumes a record from the match branch.
+ * Returns true if the match branch produced a record. */
+static bool _match(OpSemiApply *op) {
+	if(op->ae != NULL && op->applied >= BULK_THRESHOLD) {
+		return _probePattern(op);
+	}
+	op->applied++;
+
+	// Propagate Record to the top of the Match stream.
+	// (Must clone the Record, as it will be freed in the Match stream.)
+	if(op->op_arg) Argument_AddRecord(op->op_arg, OpBase_CloneRecord(op->r));
+
+	Record rhs_record = _pullFromMatchStream(op);
+	// Reset the match branch to maintain parity with the bound branch.
+	OpBase_PropagateReset(op->match_branch);
+	if(rhs_record) {
+		// Successfully retrieved a Record from the match stream, free it.
+		OpBase_DeleteRecord(rhs_record);
+		return true;
+	}
+
+	return false;
+}
+
+/* This function pulls a record from the op's bounded branch and checks it
+ * against the match branch. If there is a record from the match branch,
  * the bounded branch record is returned. */
 static Record SemiApplyConsume(OpBase *opBase) {
 	OpSemiApply *op = (OpSemiApply *)opBase;
@@ -62,16 +180,8 @@ static Record SemiApplyConsume(OpBase *opBase) {
 		// Try to get a record from bound stream.
 		op->r = OpBase_Consume(op->bound_branch);
 		if(!op->r) return NULL; // Depleted.
-		// Propagate Record to the top of the Match stream.
-		if(op->op_arg) Argument_AddRecord(op->op_arg, OpBase_CloneRecord(op->r));
-
-		Record rhs_record = _pullFromMatchStream(op);
-		// Reset the match branch to maintain parity with the bound branch.
-		OpBase_PropagateReset(op->match_branch);
-		if(rhs_record) {
-			/* Successfully retrieved a Record from the match stream,
-			 * free it and return the bound Record. */
-			OpBase_DeleteRecord(rhs_record);
+
+		if(_match(op)) {
 			Record r = op->r;
 			op->r = NULL;   // Null to avoid double free.
 			return r;
@@ -81,8 +191,8 @@ static Record SemiApplyConsume(OpBase *opBase) {
 	}
 }
 
-/* This function pulls a record from the op's bounded branch, set it as an argument for the op match branch
- * and consumes a record from the match branch. If there is no record from the match branch,
+/* This function pulls a record from the op's bounded branch and checks it
+ * against the match branch. If there is no record from the match branch,
  * the bounded branch record is returned. */
 static Record AntiSemiApplyConsume(OpBase *opBase) {
 	OpSemiApply *op = (OpSemiApply *)opBase;
@@ -91,25 +201,14 @@ static Record AntiSemiApplyConsume(OpBase *opBase) {
 		op->r = OpBase_Consume(op->bound_branch);
 		if(!op->r) return NULL; // Depleted.
 
-		// Propagate record to the top of the Match stream.
-		// (Must clone the Record, as it will be freed in the Match stream.)
-		if(op->op_arg) Argument_AddRecord(op->op_arg, OpBase_CloneRecord(op->r));
-		/* Try to pull data from the right stream,
-		 * returning the bound stream record if unsuccessful. */
-		Record rhs_record = _pullFromMatchStream(op);
-		// Reset the match branch to maintain parity with the bound branch.
-		OpBase_PropagateReset(op->match_branch);
-		if(rhs_record) {
-			/* Successfully retrieved a Record from the match stream,
-			 * free it and pull again from the bound stream. */
-			OpBase_DeleteRecord(rhs_record);
-			OpBase_DeleteRecord(op->r);
-		} else {
+		if(!_match(op)) {
 			// Right stream returned NULL, return left handside record.
 			Record r = op->r;
 			op->r = NULL;   // Null to avoid double free.
 			return r;
 		}
+		// Pattern exists, pull again from the bound stream.
+		OpBase_DeleteRecord(op->r);
 	}
 }
 
@@ -119,6 +218,11 @@ static OpResult SemiApplyReset(OpBase *opBase) {
 		OpBase_DeleteRecord(op->r);
 		op->r = NULL;
 	}
+
+	// the graph might have been modified, re-evaluate pattern if needed
+	op->applied = 0;
+	if(op->sources) GrB_Vector_free(&op->sources);
+
 	return OP_OK;
 }
 
@@ -135,5 +239,15 @@ static void SemiApplyFree(OpBase *opBase) {
 		OpBase_DeleteRecord(op->r);
 		op->r = NULL;
 	}
+
+	if(op->sources) {
+		GrB_Vector_free(&op->sources);
+		op->sources = NULL;
+	}
+
+	if(op->ae) {
+		AlgebraicExpression_Free(op->ae);
+		op->ae = NULL;
+	}
 }
 
@@ -9,6 +9,7 @@
 #include "op.h"
 #include "op_argument.h"
 #include "../execution_plan.h"
+#include "../../arithmetic/algebraic_expression.h"
 
 /* SemiApply operation tests for the presence of a pattern
  * Normal Semi Apply: Starts by pulling on the main execution plan branch,
@@ -18,7 +19,13 @@
  * Anti Semi Apply: Starts by pulling on the main execution plan branch,
  * for each record received it tries to get a record from the match branch
  * if no data is produced the main execution plan branch record is passed onward
- * otherwise it will try to fetch a new data point from the main execution plan branch. */
+ * otherwise it will try to fetch a new data point from the main execution plan branch.
+ *
+ * When the match branch is a single traversal from a bound node, e.g.
+ * WHERE (n)-[:FOLLOWS]->(:Celebrity)
+ * once enough bound records have been processed, the pattern is evaluated
+ * once for all nodes: the rows of FOLLOWS * diag(Celebrity) are reduced into
+ * a vector of qualifying sources, each bound record then probes the vector. */
 
 typedef struct OpSemiApply {
 	OpBase op;
@@ -26,6 +33,21 @@ typedef struct OpSemiApply {
 	OpBase *bound_branch;           // Bound branch root;
 	OpBase *match_branch;           // Match branch root;
 	Argument *op_arg;               // Match branch tap.
+	AlgebraicExpression *ae;        // Pattern evaluated in bulk, NULL if none.
+	int src_idx;                    // Record index of pattern's source node.
+	uint64_t applied;               // Records applied to the match branch.
+	GrB_Vector sources;             // Source nodes for which pattern exists.
+	bool ae_optimized;              // Pattern's operands were fetched.
 } OpSemiApply;
 
 OpBase *NewSemiApplyOp(const ExecutionPlan *plan, bool anti);
+
+// evaluate pattern in bulk
+// 'ae' is a traversal from the node at record[src_idx], equivalent to
+// the op's match branch, the op takes ownership of 'ae'
+void SemiApplyOp_SetPattern
+(
+	OpSemiApply *op,          // semi apply op
+	AlgebraicExpression *ae,  // pattern
+	int src_idx               // record index of pattern's source node
+);
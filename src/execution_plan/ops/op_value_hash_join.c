@@ -242,6 +242,7 @@ OpBase *NewValueHashJoin
 	op->intersect_idx           = -1;
 	op->cached_records          = NULL;
 	op->number_of_intersections = 0;
+	op->key_filter              = JoinKeyFilter_New();
 
 	// set our Op operations
 	OpBase_Init((OpBase *)op, OPType_VALUE_HASH_JOIN, "Value Hash Join",
@@ -268,6 +269,9 @@ static Record ValueHashJoinConsume
 		_cache_records(op);
 		// sort cache on intersect node ID
 		_sort_cached_records(op);
+		// publish cached keys, the right branch is yet to be pulled
+		JoinKeyFilter_Populate(op->key_filter, op->cached_records,
+				array_len(op->cached_records), op->join_value_rec_idx);
 	}
 
 	// try to produce a record:
@@ -347,6 +351,8 @@ static OpResult ValueHashJoinReset
 		op->cached_records = NULL;
 	}
 
+	JoinKeyFilter_Clear(op->key_filter);
+
 	return OP_OK;
 }
 
@@ -389,5 +395,10 @@ static void ValueHashJoinFree(OpBase *ctx) {
 		AR_EXP_Free(op->rhs_exp);
 		op->rhs_exp = NULL;
 	}
+
+	if(op->key_filter) {
+		JoinKeyFilter_Free(op->key_filter);
+		op->key_filter = NULL;
+	}
 }
 
@@ -8,6 +8,7 @@
 
 #include "op.h"
 #include "../execution_plan.h"
+#include "shared/join_key_filter.h"
 #include "../../arithmetic/arithmetic_expression.h"
 
 typedef struct {
@@ -19,6 +20,7 @@ typedef struct {
 	Record *cached_records;             // Cached left hand side records.
 	uint join_value_rec_idx;            // position on joined expression within record.
 	int64_t number_of_intersections;    // Number of intersections located.
+	JoinKeyFilter *key_filter;          // summary of cached keys, consulted by the probe side.
 } OpValueHashJoin;
 
 /* Creates a new ValueHashJoin operation */
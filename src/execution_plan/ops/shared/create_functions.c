@@ -192,6 +192,35 @@ void NewPendingCreationsContainer
 	pending->edge_attributes = array_new(AttributeSet, 0);
 }
 
+// returns true if committing the pending creations can't fail
+// i.e. none of the created entities is subject to a constraint
+static bool _CommitCantFail
+(
+	GraphContext *gc,
+	const PendingCreations *pending
+) {
+	uint node_blueprint_count = array_len(pending->nodes_to_create);
+	for(uint i = 0; i < node_blueprint_count; i++) {
+		NodeCreateCtx *node_ctx = pending->nodes_to_create + i;
+		uint label_count = array_len(node_ctx->labels);
+		for(uint j = 0; j < label_count; j++) {
+			Schema *s = GraphContext_GetSchema(gc, node_ctx->labels[j],
+					SCHEMA_NODE);
+			if(s != NULL && Schema_HasConstraints(s)) return false;
+		}
+	}
+
+	uint edge_blueprint_count = array_len(pending->edges_to_create);
+	for(uint i = 0; i < edge_blueprint_count; i++) {
+		EdgeCreateCtx *edge_ctx = pending->edges_to_create + i;
+		Schema *s = GraphContext_GetSchema(gc, edge_ctx->relation,
+				SCHEMA_EDGE);
+		if(s != NULL && Schema_HasConstraints(s)) return false;
+	}
+
+	return true;
+}
+
 // Lock the graph and commit all changes introduced by the operation.
 void CommitNewEntities
 (
@@ -205,6 +234,13 @@ void CommitNewEntities
 	// lock everything
 	QueryCtx_LockForCommit();
 
+	// the plan's root operation commits the query's final modifications
+	// if the commit can't fail the query can't fail past this point
+	// in which case there's no need to maintain an undo-log
+	if(op->parent == NULL && _CommitCantFail(QueryCtx_GetGraphCtx(), pending)) {
+		QueryCtx_DisableUndoLog();
+	}
+
 	//--------------------------------------------------------------------------
 	// commit nodes
 	//--------------------------------------------------------------------------
@@ -0,0 +1,187 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "join_key_filter.h"
+#include "../../../RG.h"
+#include "../../../util/rmalloc.h"
+
+#include <math.h>
+
+// number of bits set per key
+#define BLOOM_HASH_COUNT 3
+// number of bits allocated per key, ~2% false positive rate
+#define BLOOM_BITS_PER_KEY 10
+// bloom filter size bounds, in bits
+#define BLOOM_MIN_BITS 64
+#define BLOOM_MAX_BITS (1ULL << 30)
+// largest magnitude at which doubles represent integers exactly
+#define EXACT_DOUBLE_LIMIT 9007199254740992.0  // 2^53
+
+// types hashed consistently with SIValue_Compare equality
+#define HASHABLE_TYPES (SI_NUMERIC | T_STRING | T_BOOL)
+
+static inline bool _isNaN
+(
+	SIValue v
+) {
+	return (SI_TYPE(v) == T_DOUBLE && isnan(v.doubleval));
+}
+
+// compute key's bit positions, derived from a single hash
+// using double hashing: h1 + i * h2
+static inline void _bitPositions
+(
+	const JoinKeyFilter *f,         // filter
+	SIValue v,                      // key
+	uint64_t pos[BLOOM_HASH_COUNT]  // [output] bit positions
+) {
+	uint64_t h1 = SIValue_HashCode(v);
+	uint64_t h2 = (h1 >> 32) | 1;
+	for(uint i = 0; i < BLOOM_HASH_COUNT; i++) {
+		pos[i] = (h1 + i * h2) & f->mask;
+	}
+}
+
+JoinKeyFilter *JoinKeyFilter_New(void) {
+	return rm_calloc(1, sizeof(JoinKeyFilter));
+}
+
+void JoinKeyFilter_Populate
+(
+	JoinKeyFilter *f,
+	Record *records,
+	uint n,
+	uint key_idx
+) {
+	ASSERT(f != NULL);
+	ASSERT(f->ready == false);
+	ASSERT(records != NULL || n == 0);
+
+	uint64_t nbits = BLOOM_MIN_BITS;
+	while(nbits < (uint64_t)n * BLOOM_BITS_PER_KEY && nbits < BLOOM_MAX_BITS) {
+		nbits <<= 1;
+	}
+
+	f->bits    = rm_calloc(nbits / 64, sizeof(uint64_t));
+	f->mask    = nbits - 1;
+	f->hashed  = true;
+	f->numeric = (n > 0);
+	f->min     = SI_NullVal();
+	f->max     = SI_NullVal();
+
+	for(uint i = 0; i < n; i++) {
+		SIValue v = Record_Get(records[i], key_idx);
+		SIType  t = SI_TYPE(v);
+
+		if(_isNaN(v)) {
+			// NaN keys can't be ordered nor hashed reliably
+			f->hashed  = false;
+			f->numeric = false;
+			break;
+		}
+
+		// track numeric range
+		if(t & SI_NUMERIC) {
+			if(i == 0 || SIValue_Compare(v, f->min, NULL) < 0) f->min = v;
+			if(i == 0 || SIValue_Compare(v, f->max, NULL) > 0) f->max = v;
+		} else {
+			f->numeric = false;
+		}
+
+		if(!(t & HASHABLE_TYPES)) {
+			f->hashed = false;
+			continue;
+		}
+
+		uint64_t pos[BLOOM_HASH_COUNT];
+		_bitPositions(f, v, pos);
+		for(uint j = 0; j < BLOOM_HASH_COUNT; j++) {
+			f->bits[pos[j] >> 6] |= (1ULL << (pos[j] & 63));
+		}
+	}
+
+	f->ready = true;
+}
+
+bool JoinKeyFilter_MayContain
+(
+	const JoinKeyFilter *f,
+	SIValue v
+) {
+	// filter isn't populated, accept
+	if(f == NULL || !f->ready) return true;
+
+	// null keys never join
+	SIType t = SI_TYPE(v);
+	if(t & T_NULL) return false;
+
+	if(_isNaN(v)) return true;
+
+	if(f->numeric) {
+		// keys are all numeric, non numeric values never compare equal
+		if(!(t & SI_NUMERIC)) return false;
+		if(SIValue_Compare(v, f->min, NULL) < 0) return false;
+		if(SIValue_Compare(v, f->max, NULL) > 0) return false;
+	}
+
+	if(!f->hashed || !(t & HASHABLE_TYPES)) return true;
+
+	uint64_t pos[BLOOM_HASH_COUNT];
+	_bitPositions(f, v, pos);
+	for(uint i = 0; i < BLOOM_HASH_COUNT; i++) {
+		if(!(f->bits[pos[i] >> 6] & (1ULL << (pos[i] & 63)))) return false;
+	}
+
+	return true;
+}
+
+bool JoinKeyFilter_Range
+(
+	const JoinKeyFilter *f,
+	double *min,
+	double *max
+) {
+	ASSERT(f   != NULL);
+	ASSERT(min != NULL);
+	ASSERT(max != NULL);
+
+	if(!f->ready || !f->numeric) return false;
+
+	*min = SI_GET_NUMERIC(f->min);
+	*max = SI_GET_NUMERIC(f->max);
+
+	// integers beyond 2^53 lose precision once converted
+	// such a range might exclude matching values
+	return (fabs(*min) <= EXACT_DOUBLE_LIMIT &&
+			fabs(*max) <= EXACT_DOUBLE_LIMIT);
+}
+
+void JoinKeyFilter_Clear
+(
+	JoinKeyFilter *f
+) {
+	ASSERT(f != NULL);
+
+	if(f->bits != NULL) {
+		rm_free(f->bits);
+		f->bits = NULL;
+	}
+
+	f->ready   = false;
+	f->hashed  = false;
+	f->numeric = false;
+	f->mask    = 0;
+}
+
+void JoinKeyFilter_Free
+(
+	JoinKeyFilter *f
+) {
+	ASSERT(f != NULL);
+
+	JoinKeyFilter_Clear(f);
+	rm_free(f);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../../record.h"
+
+// summary of the keys cached by a join's build side
+// published once the build side is depleted, consulted by the probe side
+// to discard records which can't possibly find a match
+// before they're traversed further or reach the join
+//
+// the summary consists of a bloom filter over the keys' hashes
+// and, when all keys are numeric, the keys' [min, max] range
+typedef struct {
+	bool ready;      // summary been populated
+	bool hashed;     // bloom filter is usable
+	bool numeric;    // all keys are numeric
+	uint64_t *bits;  // bloom filter bit array
+	uint64_t mask;   // number of bits - 1
+	SIValue min;     // smallest key, numeric keys only
+	SIValue max;     // largest key, numeric keys only
+} JoinKeyFilter;
+
+// create a new, unpopulated, key filter
+// an unpopulated filter accepts all keys
+JoinKeyFilter *JoinKeyFilter_New(void);
+
+// populate filter with the keys held by records
+void JoinKeyFilter_Populate
+(
+	JoinKeyFilter *f,  // filter to populate
+	Record *records,   // build side records
+	uint n,            // number of records
+	uint key_idx       // record entry holding the join key
+);
+
+// returns false if 'v' is known not to be one of the filter's keys
+bool JoinKeyFilter_MayContain
+(
+	const JoinKeyFilter *f,  // filter, might be NULL
+	SIValue v                // probed key
+);
+
+// get the numeric range enclosing all keys
+// returns false if keys aren't all numeric or the filter isn't populated
+bool JoinKeyFilter_Range
+(
+	const JoinKeyFilter *f,  // filter
+	double *min,             // [output] range lower bound
+	double *max              // [output] range upper bound
+);
+
+// discard filter's keys, filter accepts all keys until repopulated
+void JoinKeyFilter_Clear
+(
+	JoinKeyFilter *f  // filter to clear
+);
+
+// free filter
+void JoinKeyFilter_Free
+(
+	JoinKeyFilter *f  // filter to free
+);
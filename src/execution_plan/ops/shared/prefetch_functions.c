@@ -0,0 +1,125 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "prefetch_functions.h"
+#include "../../../RG.h"
+#include "../../../util/arr.h"
+#include "../../../graph/entities/graph_entity.h"
+
+void AttributePrefetch_Add
+(
+	PrefetchedAttribute **prefetch,
+	uint entity_idx,
+	Attribute_ID attr_id,
+	uint rec_idx
+) {
+	ASSERT(prefetch != NULL);
+
+	if(*prefetch == NULL) *prefetch = array_new(PrefetchedAttribute, 1);
+
+	PrefetchedAttribute attr = {
+		.entity_idx = entity_idx,
+		.attr_id    = attr_id,
+		.rec_idx    = rec_idx
+	};
+
+	// place attribute right after the last attribute of the same entity
+	uint n = array_len(*prefetch);
+	uint pos = n;
+	for(uint i = 0; i < n; i++) {
+		if((*prefetch)[i].entity_idx == entity_idx) pos = i + 1;
+	}
+
+	array_append(*prefetch, attr);
+	if(pos < n) {
+		memmove(*prefetch + pos + 1, *prefetch + pos,
+				sizeof(PrefetchedAttribute) * (n - pos));
+		(*prefetch)[pos] = attr;
+	}
+}
+
+// retrieve graph entity held at record[idx]
+// returns NULL if entry doesn't hold a graph entity with attributes
+static GraphEntity *_GetEntity
+(
+	Record r,
+	uint idx
+) {
+	GraphEntity *e = NULL;
+
+	switch(Record_GetType(r, idx)) {
+		case REC_TYPE_NODE:
+			e = (GraphEntity *)Record_GetNode(r, idx);
+			break;
+		case REC_TYPE_EDGE:
+			e = (GraphEntity *)Record_GetEdge(r, idx);
+			break;
+		default:
+			return NULL;
+	}
+
+	// intermediate entities don't have an attribute-set
+	return (e->attributes != NULL) ? e : NULL;
+}
+
+void AttributePrefetch_Apply
+(
+	const PrefetchedAttribute *prefetch,
+	Record r
+) {
+	if(prefetch == NULL) return;
+
+	uint n = array_len((PrefetchedAttribute *)prefetch);
+	uint i = 0;
+
+	while(i < n) {
+		// determine range of attributes belonging to the same entity
+		uint entity_idx = prefetch[i].entity_idx;
+		uint end = i + 1;
+		while(end < n && prefetch[end].entity_idx == entity_idx) end++;
+
+		GraphEntity *e = _GetEntity(r, entity_idx);
+		if(e == NULL) {
+			// leave entries unset, attributes are accessed on demand
+			i = end;
+			continue;
+		}
+
+		// attributes missing from the entity evaluate to null
+		for(uint j = i; j < end; j++) {
+			Record_AddScalar(r, prefetch[j].rec_idx, SI_NullVal());
+		}
+
+		// single pass over the entity's attribute-set
+		const AttributeSet set = GraphEntity_GetAttributes(e);
+		uint16_t count = AttributeSet_Count(set);
+		for(uint16_t k = 0; k < count; k++) {
+			Attribute_ID id;
+			SIValue v = AttributeSet_GetIdx(set, k, &id);
+
+			for(uint j = i; j < end; j++) {
+				if(prefetch[j].attr_id == id) {
+					// value is owned by the graph, same as property access
+					Record_AddScalar(r, prefetch[j].rec_idx, SI_ConstValue(&v));
+				}
+			}
+		}
+
+		i = end;
+	}
+}
+
+void AttributePrefetch_Free
+(
+	PrefetchedAttribute **prefetch
+) {
+	ASSERT(prefetch != NULL);
+
+	if(*prefetch != NULL) {
+		array_free(*prefetch);
+		*prefetch = NULL;
+	}
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../../record.h"
+#include "../../../graph/entities/attribute_set.h"
+
+// attribute prefetched from a graph entity into a dedicated record entry
+// operations producing records for filters and projections
+// populate these entries, in a single pass over each entity's attribute-set
+typedef struct {
+	uint entity_idx;       // record entry holding the graph entity
+	Attribute_ID attr_id;  // attribute to prefetch
+	uint rec_idx;          // record entry holding attribute's value
+} PrefetchedAttribute;
+
+// add an attribute to the prefetch list
+// attributes are kept grouped by entity
+void AttributePrefetch_Add
+(
+	PrefetchedAttribute **prefetch,  // prefetch list, created if NULL
+	uint entity_idx,                 // record entry holding the graph entity
+	Attribute_ID attr_id,            // attribute to prefetch
+	uint rec_idx                     // record entry holding attribute's value
+);
+
+// populate record with prefetched attributes
+// entities missing from the record are skipped
+void AttributePrefetch_Apply
+(
+	const PrefetchedAttribute *prefetch,  // prefetch list, might be NULL
+	Record r                              // record to populate
+);
+
+// free prefetch list
+void AttributePrefetch_Free
+(
+	PrefetchedAttribute **prefetch  // prefetch list to free
+);
@@ -66,8 +66,6 @@ void CommitUpdates
 		// if entity has been deleted, perform no updates
 		if(GraphEntity_IsDeleted(update->ge)) continue;
 
-		AttributeSet_PersistValues(update->attributes);
-		
 		// update the attributes on the graph entity
 		UpdateEntityProperties(gc, update->ge, update->attributes,
 				type == ENTITY_NODE ? GETYPE_NODE : GETYPE_EDGE, true);
@@ -9,6 +9,8 @@
 #include "../ops/op_value_hash_join.h"
 #include "../../util/rax_extensions.h"
 #include "../ops/op_cartesian_product.h"
+#include "../ops/op_node_by_index_scan.h"
+#include "../../query_ctx.h"
 #include "../execution_plan_build/execution_plan_util.h"
 #include "../execution_plan_build/execution_plan_modify.h"
 
@@ -97,6 +99,71 @@ static OpBase *_build_hash_join_op(const ExecutionPlan *plan, OpBase *left_branc
 	return value_hash_join;
 }
 
+// the join key is an indexed numeric attribute of the node scanned by 'scan'
+// in which case the range of the join's cached keys can narrow the index query
+static void _push_join_key_range(OpValueHashJoin *join, IndexScan *scan) {
+	// index scan serving a k nearest neighbors search
+	if(scan->filter == NULL) return;
+
+	AR_ExpNode *exp = join->rhs_exp;
+	char *attr = NULL;
+	if(!AR_EXP_IsAttribute(exp, &attr)) return;
+
+	// make sure attribute belongs to the scanned node
+	AR_ExpNode *entity = exp->op.children[0];
+	if(entity->type != AR_EXP_OPERAND ||
+	   entity->operand.type != AR_EXP_VARIADIC ||
+	   strcmp(entity->operand.variadic.entity_alias, scan->n->alias) != 0) {
+		return;
+	}
+
+	// make sure attribute is indexed
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+	if(attr_id == ATTRIBUTE_ID_NONE) return;
+	Index idx = GraphContext_GetIndex(gc, scan->n->label, &attr_id, 1,
+			IDX_EXACT_MATCH, SCHEMA_NODE);
+	if(idx == NULL) return;
+
+	IndexScanOp_SetJoinKeyFilter(scan, join->key_filter, AR_EXP_Clone(exp));
+}
+
+// push a summary of the join's cached keys into its right (probe) branch
+// a filter placed right above the op resolving the probed key
+// discards records which can't match any cached key early on
+static void _push_join_key_filter(OpValueHashJoin *join) {
+	OpBase *probe = join->op.children[1];
+
+	rax *references = raxNew();
+	AR_EXP_CollectEntities(join->rhs_exp, references);
+
+	// constant probed key
+	if(raxSize(references) == 0) {
+		raxFree(references);
+		return;
+	}
+
+	OpBase *op = ExecutionPlan_LocateReferencesExcludingOps(probe, NULL,
+			FILTER_RECURSE_BLACKLIST, BLACKLIST_OP_COUNT, references);
+	raxFree(references);
+	if(op == NULL) return;
+
+	// join_key_filter(rhs_exp)
+	// the key filter is owned by the join operation
+	AR_ExpNode *exp = AR_EXP_NewOpNode("join_key_filter", true, 1);
+	exp->op.children[0] = AR_EXP_Clone(join->rhs_exp);
+	exp->op.private_data = join->key_filter;
+
+	FT_FilterNode *tree = FilterTree_CreateExpressionFilter(exp);
+	OpBase *filter = NewFilterOp(op->plan, tree);
+	ExecutionPlan_PushBelow(op, filter);
+	if(op == op->plan->root) ((ExecutionPlan *)op->plan)->root = filter;
+
+	if(op->type == OPType_NODE_BY_INDEX_SCAN) {
+		_push_join_key_range(join, (IndexScan *)op);
+	}
+}
+
 // Reduces a cartisian product to hash joins operations.
 static void _reduce_cp_to_hashjoin(ExecutionPlan *plan, OpBase *cp) {
 	// Retrieve all equality filter operations located upstream from the Cartesian Product.
@@ -150,6 +217,7 @@ static void _reduce_cp_to_hashjoin(ExecutionPlan *plan, OpBase *cp) {
 		// Build hash join op.
 		OpBase *value_hash_join = _build_hash_join_op
 								  (cp->plan, left_branch, right_branch, lhs, rhs);
+		_push_join_key_filter((OpValueHashJoin *)value_hash_join);
 
 		// The filter will now be resolved by the join operation; remove it.
 		ExecutionPlan_RemoveOp(plan, (OpBase *)filter_op);
@@ -0,0 +1,148 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../../query_ctx.h"
+#include "../ops/op_sort.h"
+#include "../ops/op_project.h"
+#include "../ops/op_node_by_label_scan.h"
+#include "../ops/op_node_by_index_scan.h"
+#include "../../ast/ast_build_op_contexts.h"
+#include "../execution_plan_build/execution_plan_modify.h"
+
+// applyKNN looks for a label scan feeding a sort by distance
+// with a limit, in which case the label scan is replaced by an index scan
+// producing only the nodes nearest to the queried point, e.g.
+//
+// MATCH (n:L)
+// RETURN n
+// ORDER BY distance(n.location, point({latitude: 1, longitude: 2}))
+// LIMIT 10
+//
+// the sort operation remains in place and orders the index results
+
+// returns true if 'exp' is an attribute access 'alias.attr'
+static bool _aliasAttribute
+(
+	const AR_ExpNode *exp,  // expression to inspect
+	const char *alias,      // expected entity alias
+	char **attr             // [output] accessed attribute
+) {
+	if(!AR_EXP_IsAttribute(exp, attr)) return false;
+
+	const AR_ExpNode *entity = exp->op.children[0];
+	return (AR_EXP_IsVariadic(entity) &&
+			strcmp(entity->operand.variadic.entity_alias, alias) == 0);
+}
+
+// returns true if 'exp' does not depend on any entity
+static bool _independent
+(
+	AR_ExpNode *exp  // expression to inspect
+) {
+	rax *entities = raxNew();
+	AR_EXP_CollectEntities(exp, entities);
+	bool independent = (raxSize(entities) == 0);
+	raxFree(entities);
+	return independent;
+}
+
+// locate the projected expression named 'name'
+static AR_ExpNode *_projected_exp
+(
+	const OpProject *project,  // projection op
+	const char *name           // expression name
+) {
+	uint n = array_len(project->exps);
+	for(uint i = 0; i < n; i++) {
+		AR_ExpNode *exp = project->exps[i];
+		if(exp->resolved_name != NULL && strcmp(exp->resolved_name, name) == 0) {
+			return exp;
+		}
+	}
+	return NULL;
+}
+
+static void _applyKNN
+(
+	ExecutionPlan *plan,  // plan to optimize
+	OpSort *sort          // sort operation
+) {
+	// sort must be limited, ascending on its first expression
+	if(sort->limit == UNLIMITED || sort->limit == 0) return;
+	if(sort->directions[0] != DIR_ASC) return;
+
+	// sort -> project -> label scan
+	OpBase *project = sort->op.children[0];
+	if(OpBase_Type(project) != OPType_PROJECT) return;
+	if(project->childCount != 1) return;
+
+	OpBase *child = project->children[0];
+	if(OpBase_Type(child) != OPType_NODE_BY_LABEL_SCAN) return;
+	if(child->childCount != 0) return;
+
+	NodeByLabelScan *scan = (NodeByLabelScan *)child;
+	if(scan->id_range != NULL) return;
+	if(scan->n->label_id == GRAPH_UNKNOWN_LABEL) return;
+
+	// sort expression should be distance(n.attr, origin)
+	AR_ExpNode *exp = _projected_exp((OpProject *)project,
+			sort->exps[0]->resolved_name);
+	if(exp == NULL || !AR_EXP_IsOperation(exp)) return;
+	if(strcasecmp(AR_EXP_GetFuncName(exp), "distance") != 0) return;
+	if(exp->op.child_count != 2) return;
+
+	char        *attr   = NULL;
+	AR_ExpNode  *origin = NULL;
+	const char  *alias  = scan->n->alias;
+	AR_ExpNode  *lhs    = exp->op.children[0];
+	AR_ExpNode  *rhs    = exp->op.children[1];
+
+	if(_aliasAttribute(lhs, alias, &attr) && _independent(rhs)) {
+		origin = rhs;
+	} else if(_aliasAttribute(rhs, alias, &attr) && _independent(lhs)) {
+		origin = lhs;
+	} else {
+		return;
+	}
+
+	// attribute must be indexed
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attr);
+	if(attr_id == ATTRIBUTE_ID_NONE) return;
+
+	Index idx = GraphContext_GetIndexByID(gc, scan->n->label_id, &attr_id, 1,
+			IDX_EXACT_MATCH, GETYPE_NODE);
+	if(idx == NULL || !Index_Enabled(idx)) return;
+
+	// records skipped by the sort must be produced as well
+	uint64_t k = (uint64_t)sort->limit + sort->skip;
+
+	OpBase *knn = NewIndexScanKNNOp(scan->op.plan, scan->g, scan->n,
+			Index_RSIndex(idx), attr, AR_EXP_Clone(origin), k);
+	scan->n = NULL;
+
+	ExecutionPlan_ReplaceOp(plan, (OpBase *)scan, knn);
+	OpBase_Free((OpBase *)scan);
+}
+
+static void _visit
+(
+	ExecutionPlan *plan,
+	OpBase *op
+) {
+	if(OpBase_Type(op) == OPType_SORT) _applyKNN(plan, (OpSort *)op);
+
+	for(uint i = 0; i < op->childCount; i++) {
+		_visit(plan, op->children[i]);
+	}
+}
+
+void applyKNN(ExecutionPlan *plan) {
+	ASSERT(plan != NULL);
+	_visit(plan, plan->root);
+}
+
@@ -0,0 +1,92 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "../ops/op_argument.h"
+#include "../ops/op_semi_apply.h"
+#include "../ops/op_conditional_traverse.h"
+#include "../execution_plan_build/execution_plan_util.h"
+
+// decorrelateSemiApply looks for existence checks of a pattern
+// traversing from a single bound node, e.g.
+//
+// MATCH (n:User) WHERE (n)-[:FOLLOWS]->(:Celebrity) RETURN n
+//
+// the semi apply's match branch consists of an argument followed by
+// a conditional traverse, which is evaluated once per bound record
+// instead, the traversal's algebraic expression FOLLOWS * diag(Celebrity)
+// is handed to the semi apply which evaluates it once for all nodes
+// and probes the qualifying sources for each bound record
+
+// returns true if alias is bound by argument
+static bool _argumentBinds
+(
+	const OpBase *arg,  // argument op
+	const char *alias   // alias to look for
+) {
+	if(alias == NULL || arg->modifies == NULL) return false;
+
+	uint n = array_len(arg->modifies);
+	for(uint i = 0; i < n; i++) {
+		if(strcmp(arg->modifies[i], alias) == 0) return true;
+	}
+
+	return false;
+}
+
+static void _decorrelateSemiApply
+(
+	OpSemiApply *op
+) {
+	OpBase *semi_apply = (OpBase *)op;
+	if(semi_apply->childCount != 2) return;
+
+	// match branch must be a single traversal fed by an argument
+	OpBase *match_branch = semi_apply->children[1];
+	if(match_branch->type != OPType_CONDITIONAL_TRAVERSE) return;
+	if(match_branch->childCount != 1) return;
+
+	OpBase *arg = match_branch->children[0];
+	if(arg->type != OPType_ARGUMENT) return;
+
+	OpCondTraverse *traverse = (OpCondTraverse *)match_branch;
+	const char *src  = AlgebraicExpression_Src(traverse->ae);
+	const char *dest = AlgebraicExpression_Dest(traverse->ae);
+	const char *edge = AlgebraicExpression_Edge(traverse->ae);
+
+	// pattern must be correlated only through its source node
+	// a pattern ending at a bound node e.g. (n)-[:R]->(n)
+	// checks for specific pairs rather than for sources
+	if(!_argumentBinds(arg, src)           ||
+	   strcmp(src, dest) == 0              ||
+	   _argumentBinds(arg, dest)           ||
+	   _argumentBinds(arg, edge)) {
+		return;
+	}
+
+	int src_idx;
+	if(!OpBase_Aware(semi_apply, src, &src_idx)) return;
+
+	SemiApplyOp_SetPattern(op, AlgebraicExpression_Clone(traverse->ae),
+			src_idx);
+}
+
+void decorrelateSemiApply
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	const OPType types[2] = {OPType_SEMI_APPLY, OPType_ANTI_SEMI_APPLY};
+	OpBase **ops = ExecutionPlan_CollectOpsMatchingTypes(plan->root, types, 2);
+
+	uint n = array_len(ops);
+	for(uint i = 0; i < n; i++) {
+		_decorrelateSemiApply((OpSemiApply *)ops[i]);
+	}
+
+	array_free(ops);
+}
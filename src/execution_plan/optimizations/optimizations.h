@@ -19,6 +19,9 @@ void orderExpressions(
 	rax *bound_vars                 // previously-bound variables
 );
 
+void foldExpressions(ExecutionPlan *plan);
+void hoistExpressions(ExecutionPlan *plan);
+void prefetchAttributes(ExecutionPlan *plan);
 void compactFilters(ExecutionPlan *plan);
 void reduceScans(ExecutionPlan *plan);
 void utilizeIndices(ExecutionPlan *plan);
@@ -32,5 +35,7 @@ void reduceDistinct(ExecutionPlan *plan);
 void reduceCount(ExecutionPlan *plan);
 void applyLimit(ExecutionPlan *plan);
 void applySkip(ExecutionPlan *plan);
+void applyKNN(ExecutionPlan *plan);
+void decorrelateSemiApply(ExecutionPlan *plan);
 void optimizeLabelScan(ExecutionPlan *plan);
 
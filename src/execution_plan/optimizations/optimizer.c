@@ -8,6 +8,9 @@
 #include "./optimizations.h"
 
 void optimizePlan(ExecutionPlan *plan) {
+	// fold expressions depending only on constants and parameters
+	foldExpressions(plan);
+
 	// tries to compact filter trees, and remove redundant filters
 	compactFilters(plan);
 
@@ -60,5 +63,21 @@ void optimizePlan(ExecutionPlan *plan) {
 
 	// let operations know about specified skip(s)
 	applySkip(plan);
+
+	// serve limited sorts by distance from a spatial index
+	// relies on sort limit and skip being known
+	applyKNN(plan);
+
+	// evaluate pattern existence checks once for all nodes
+	// relies on traversals being in their final form
+	decorrelateSemiApply(plan);
+
+	// resolve attribute accesses into record entries
+	// populated by the op producing the entities
+	prefetchAttributes(plan);
+
+	// compute repeated subexpressions once per record
+	// relies on filters being in their final position
+	hoistExpressions(plan);
 }
 
@@ -0,0 +1,521 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "../../RG.h"
+#include "../ops/op_filter.h"
+#include "../ops/op_project.h"
+#include "../ops/op_all_node_scan.h"
+#include "../ops/op_node_by_id_seek.h"
+#include "../ops/op_node_by_label_scan.h"
+#include "../ops/op_node_by_index_scan.h"
+#include "../ops/op_conditional_traverse.h"
+#include "../../query_ctx.h"
+#include "../../util/arr.h"
+#include "../../errors/errors.h"
+#include "../../filter_tree/filter_tree.h"
+
+#include <stdio.h>
+
+// the reduce expressions optimizer operates on the expressions evaluated
+// by filter and projection operations
+//
+// foldExpressions
+// parameters are bound by the time a plan is optimized, expressions which
+// depend only on constants and parameters e.g. `n.price * (1 - $discount)`
+// are folded once per execution, rather than evaluated per record
+//
+// hoistExpressions
+// identical subexpressions evaluated against the same record e.g.
+// MATCH (n) WHERE n.price * (1 - n.discount) > 10
+// RETURN n.price * (1 - n.discount) ORDER BY n.price * (1 - n.discount)
+// are computed once per record, the first evaluation stores its value
+// within a dedicated record entry which is shared by all other occurrences
+//
+// prefetchAttributes
+// attribute accesses e.g. `n.price` are resolved into dedicated record entries
+// when the operation producing the records is a scan or a traversal
+// it populates these entries as soon as it sets the entity, in a single pass
+// over the entity's attribute-set, otherwise attributes accessed multiple
+// times are fetched once per record
+
+// maximum length of a hoisted expression record alias
+#define HOISTED_ALIAS_MAX_LEN 32
+
+// introduce a new record entry named after fmt
+static void _introduceRecordEntry
+(
+	rax *mapping,      // record mapping
+	const char *fmt,   // alias format, expects a single unsigned
+	char *alias        // [output] alias, HOISTED_ALIAS_MAX_LEN long
+) {
+	uint id = raxSize(mapping);
+	do {
+		snprintf(alias, HOISTED_ALIAS_MAX_LEN, fmt, id++);
+	} while(raxFind(mapping, (unsigned char *)alias, strlen(alias)) !=
+			raxNotFound);
+
+	raxInsert(mapping, (unsigned char *)alias, strlen(alias),
+			(void *)(intptr_t)raxSize(mapping), NULL);
+}
+
+// callback invoked on each expression of an operation
+typedef void (*ExpCB)(AR_ExpNode **exp, void *pdata);
+
+// callback invoked on each sequence of operations
+// evaluating their expressions against the same record
+typedef void (*ChainCB)
+(
+	OpBase **ops,      // projection and filters, or consecutive filters
+	uint n,            // number of ops
+	OpBase *producer,  // op producing the records, NULL if there's none
+	rax *mapping       // mapping of records evaluated by ops
+);
+
+// invoke cb on each expression within filter tree
+static void _filterTreeExpressions
+(
+	FT_FilterNode *root,  // filter tree
+	ExpCB cb,             // callback
+	void *pdata           // callback private data
+) {
+	if(root == NULL) return;
+
+	switch(root->t) {
+		case FT_N_EXP:
+			cb(&root->exp.exp, pdata);
+			break;
+		case FT_N_PRED:
+			cb(&root->pred.lhs, pdata);
+			cb(&root->pred.rhs, pdata);
+			break;
+		case FT_N_COND:
+			_filterTreeExpressions(root->cond.left, cb, pdata);
+			_filterTreeExpressions(root->cond.right, cb, pdata);
+			break;
+		default:
+			ASSERT(false && "unknown filter tree node");
+			break;
+	}
+}
+
+// invoke cb on each expression evaluated by op
+static void _opExpressions
+(
+	OpBase *op,   // filter or project operation
+	ExpCB cb,     // callback
+	void *pdata   // callback private data
+) {
+	if(op->type == OPType_FILTER) {
+		_filterTreeExpressions(((OpFilter *)op)->filterTree, cb, pdata);
+	} else {
+		ASSERT(op->type == OPType_PROJECT);
+		OpProject *project = (OpProject *)op;
+		for(uint i = 0; i < project->exp_count; i++) {
+			cb(project->exps + i, pdata);
+		}
+	}
+}
+
+// invoke cb on a projection and the filters directly below it
+// or on a sequence of consecutive filters
+static void _visitChain
+(
+	OpBase *op,  // top of the sequence
+	ChainCB cb   // callback
+) {
+	OpBase **ops = array_new(OpBase *, 1);
+	array_append(ops, op);
+
+	OpBase *bottom = op;
+	while(bottom->childCount == 1 && bottom->children[0]->type == OPType_FILTER) {
+		bottom = bottom->children[0];
+		array_append(ops, bottom);
+	}
+
+	// records are created by the op below the sequence
+	// a projection with no child creates its own record
+	OpBase *producer = (bottom->childCount > 0) ? bottom->children[0] : NULL;
+	const ExecutionPlan *plan = (producer != NULL) ? producer->plan :
+		bottom->plan;
+
+	cb(ops, array_len(ops), producer, ExecutionPlan_GetMappings(plan));
+
+	array_free(ops);
+}
+
+static void _visitChains
+(
+	OpBase *op,
+	ChainCB cb
+) {
+	OpBase *parent = op->parent;
+
+	// sequence starts at either a projection or a top most filter
+	if(op->type == OPType_PROJECT ||
+	   (op->type == OPType_FILTER &&
+		(parent == NULL || (parent->type != OPType_FILTER &&
+							parent->type != OPType_PROJECT)))) {
+		_visitChain(op, cb);
+	}
+
+	for(int i = 0; i < op->childCount; i++) {
+		_visitChains(op->children[i], cb);
+	}
+}
+
+//------------------------------------------------------------------------------
+// fold expressions
+//------------------------------------------------------------------------------
+
+static void _foldExpression
+(
+	AR_ExpNode **exp,
+	void *pdata
+) {
+	AR_EXP_ReduceToScalar(*exp, true, NULL);
+
+	// expressions which fail to evaluate are left as is
+	// the error will be reported if and when they're evaluated at runtime
+	if(ErrorCtx_EncounteredError()) free(ErrorCtx_DetachError());
+}
+
+static void _foldExpressions
+(
+	OpBase *op
+) {
+	if(op->type == OPType_FILTER || op->type == OPType_PROJECT) {
+		_opExpressions(op, _foldExpression, NULL);
+	}
+
+	for(int i = 0; i < op->childCount; i++) {
+		_foldExpressions(op->children[i]);
+	}
+}
+
+void foldExpressions
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+
+	// do not mask errors raised prior to optimization
+	if(ErrorCtx_EncounteredError()) return;
+
+	_foldExpressions(plan->root);
+}
+
+//------------------------------------------------------------------------------
+// hoist expressions
+//------------------------------------------------------------------------------
+
+// evaluating a deterministic expression multiple times
+// against the same record yields the same value
+static bool _deterministic
+(
+	const AR_ExpNode *exp
+) {
+	if(AR_EXP_IsOperation(exp)) {
+		// functions holding private data e.g. comprehensions
+		// evaluate nested expressions against their own records
+		if(!exp->op.f->reducible      ||
+		   exp->op.f->aggregate       ||
+		   exp->op.private_data != NULL) {
+			return false;
+		}
+
+		for(int i = 0; i < exp->op.child_count; i++) {
+			if(!_deterministic(exp->op.children[i])) return false;
+		}
+
+		return true;
+	}
+
+	return exp->operand.type != AR_EXP_BORROW_RECORD;
+}
+
+// collect subexpressions which are worth caching within the record
+static void _collectCandidates
+(
+	AR_ExpNode **exp,
+	void *pdata
+) {
+	AR_ExpNode ***candidates = pdata;
+	AR_ExpNode *root = *exp;
+
+	if(!AR_EXP_IsOperation(root)) return;
+
+	// plain attribute access is as cheap as a record lookup
+	if(!AR_EXP_IsAttribute(root, NULL) &&
+	   AR_EXP_ContainsVariadic(root)   &&
+	   _deterministic(root)) {
+		array_append(*candidates, root);
+	}
+
+	for(int i = 0; i < root->op.child_count; i++) {
+		_collectCandidates(root->op.children + i, pdata);
+	}
+}
+
+// number of nodes in expression tree
+static uint _expSize
+(
+	const AR_ExpNode *exp
+) {
+	uint size = 1;
+
+	if(AR_EXP_IsOperation(exp)) {
+		for(int i = 0; i < exp->op.child_count; i++) {
+			size += _expSize(exp->op.children[i]);
+		}
+	} else if(AR_EXP_IsCached(exp)) {
+		size += _expSize(exp->operand.cached.exp);
+	}
+
+	return size;
+}
+
+// hoist repeated subexpressions evaluated by ops
+// all ops evaluate their expressions against the same record
+static void _hoistExpressions
+(
+	OpBase **ops,      // ops evaluating expressions against the same record
+	uint n,            // number of ops
+	OpBase *producer,  // op producing the records
+	rax *mapping       // mapping of records evaluated by ops
+) {
+	AR_ExpNode **candidates = array_new(AR_ExpNode *, 0);
+
+	while(true) {
+		array_clear(candidates);
+		for(uint i = 0; i < n; i++) {
+			_opExpressions(ops[i], _collectCandidates, &candidates);
+		}
+
+		// pick the largest subexpression occurring more than once
+		// occurrences nested within it are hoisted along with it
+		int   best      = -1;
+		uint  best_size = 0;
+		uint  count     = array_len(candidates);
+
+		for(uint i = 0; i < count; i++) {
+			uint size = _expSize(candidates[i]);
+			if(size <= best_size) continue;
+
+			for(uint j = i + 1; j < count; j++) {
+				if(AR_EXP_Equal(candidates[i], candidates[j])) {
+					best      = i;
+					best_size = size;
+					break;
+				}
+			}
+		}
+
+		if(best == -1) break;
+
+		// introduce a record entry to hold the subexpression's value
+		char alias[HOISTED_ALIAS_MAX_LEN];
+		_introduceRecordEntry(mapping, "@hoisted_%u", alias);
+
+		// repurpose all occurrences as cached operands
+		// candidates are collected in pre-order, occurrences of the same
+		// subexpression can't be nested within one another
+		AR_ExpNode *exp = candidates[best];
+		for(uint i = best + 1; i < count; i++) {
+			if(AR_EXP_Equal(exp, candidates[i])) {
+				AR_EXP_CacheInRecord(candidates[i], alias);
+			}
+		}
+		AR_EXP_CacheInRecord(exp, alias);
+	}
+
+	array_free(candidates);
+}
+
+void hoistExpressions
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+	_visitChains(plan->root, _hoistExpressions);
+}
+
+//------------------------------------------------------------------------------
+// prefetch attributes
+//------------------------------------------------------------------------------
+
+// attribute accessed by expressions
+typedef struct {
+	const char *alias;          // accessed entity
+	Attribute_ID id;            // accessed attribute
+	AR_ExpNode **occurrences;   // attribute access expressions
+} AccessedAttribute;
+
+// returns the prefetch list of an op which produces graph entities
+// NULL if op doesn't support attribute prefetching
+static PrefetchedAttribute **_opPrefetch
+(
+	OpBase *op
+) {
+	switch(op->type) {
+		case OPType_ALL_NODE_SCAN:
+			return &((AllNodeScan *)op)->prefetch;
+		case OPType_NODE_BY_LABEL_SCAN:
+		case OPType_NODE_BY_LABEL_AND_ID_SCAN:
+			return &((NodeByLabelScan *)op)->prefetch;
+		case OPType_NODE_BY_INDEX_SCAN:
+			return &((IndexScan *)op)->prefetch;
+		case OPType_NODE_BY_ID_SEEK:
+			return &((NodeByIdSeek *)op)->prefetch;
+		case OPType_CONDITIONAL_TRAVERSE:
+			return &((OpCondTraverse *)op)->prefetch;
+		default:
+			return NULL;
+	}
+}
+
+typedef struct {
+	rax *mapping;                    // mapping of records evaluated by ops
+	AccessedAttribute *attributes;   // accessed attributes
+} CollectCtx;
+
+// collect attribute accesses of the form: alias.attr
+static void _collectAttributes
+(
+	AR_ExpNode **exp,
+	void *pdata
+) {
+	CollectCtx *ctx = pdata;
+	AR_ExpNode *root = *exp;
+
+	if(!AR_EXP_IsOperation(root)) return;
+
+	// functions holding private data e.g. comprehensions
+	// evaluate nested expressions against their own records
+	if(root->op.private_data != NULL) return;
+
+	char *attr;
+	if(AR_EXP_IsAttribute(root, &attr) &&
+	   AR_EXP_IsVariadic(root->op.children[0])) {
+		const char *alias = root->op.children[0]->operand.variadic.entity_alias;
+		if(raxFind(ctx->mapping, (unsigned char *)alias, strlen(alias)) ==
+				raxNotFound) {
+			return;
+		}
+
+		// attributes yet to be introduced might be created at runtime
+		GraphContext *gc = QueryCtx_GetGraphCtx();
+		Attribute_ID id = GraphContext_GetAttributeID(gc, attr);
+		if(id == ATTRIBUTE_ID_NONE) return;
+
+		uint n = array_len(ctx->attributes);
+		for(uint i = 0; i < n; i++) {
+			AccessedAttribute *a = ctx->attributes + i;
+			if(a->id == id && strcmp(a->alias, alias) == 0) {
+				array_append(a->occurrences, root);
+				return;
+			}
+		}
+
+		AccessedAttribute a = {
+			.alias       = alias,
+			.id          = id,
+			.occurrences = array_new(AR_ExpNode *, 1)
+		};
+		array_append(a.occurrences, root);
+		array_append(ctx->attributes, a);
+		return;
+	}
+
+	for(int i = 0; i < root->op.child_count; i++) {
+		_collectAttributes(root->op.children + i, pdata);
+	}
+}
+
+// prefetched attributes refer to the entity's attribute-set
+// records holding them must not be cloned nor outlive modifications made
+// to their entities, determine if ops' records are passed on beyond
+// the first projection or aggregation
+static bool _recordsOutliveOps
+(
+	OpBase *top  // top most op evaluating the records
+) {
+	// a projection creates new records
+	if(top->type == OPType_PROJECT) return false;
+
+	for(OpBase *op = top->parent; op != NULL; op = op->parent) {
+		switch(op->type) {
+			case OPType_PROJECT:
+			case OPType_AGGREGATE:
+				return false;
+			case OPType_SKIP:
+			case OPType_LIMIT:
+				continue;
+			default:
+				return true;
+		}
+	}
+
+	return true;
+}
+
+static void _prefetchAttributes
+(
+	OpBase **ops,      // ops evaluating expressions against the same record
+	uint n,            // number of ops
+	OpBase *producer,  // op producing the records
+	rax *mapping       // mapping of records evaluated by ops
+) {
+	if(producer == NULL || _recordsOutliveOps(ops[0])) return;
+
+	CollectCtx ctx = {
+		.mapping    = mapping,
+		.attributes = array_new(AccessedAttribute, 0)
+	};
+
+	for(uint i = 0; i < n; i++) {
+		_opExpressions(ops[i], _collectAttributes, &ctx);
+	}
+
+	PrefetchedAttribute **prefetch = _opPrefetch(producer);
+
+	uint count = array_len(ctx.attributes);
+	for(uint i = 0; i < count; i++) {
+		AccessedAttribute *a = ctx.attributes + i;
+		uint occurrences = array_len(a->occurrences);
+
+		// without prefetching, a single access gains nothing
+		if(prefetch != NULL || occurrences > 1) {
+			// introduce a record entry to hold the attribute's value
+			char alias[HOISTED_ALIAS_MAX_LEN];
+			_introduceRecordEntry(mapping, "@prefetched_%u", alias);
+
+			for(uint j = 0; j < occurrences; j++) {
+				AR_EXP_CacheInRecord(a->occurrences[j], alias);
+			}
+
+			if(prefetch != NULL) {
+				void *entity_idx = raxFind(mapping, (unsigned char *)a->alias,
+						strlen(a->alias));
+				void *rec_idx = raxFind(mapping, (unsigned char *)alias,
+						strlen(alias));
+				AttributePrefetch_Add(prefetch, (intptr_t)entity_idx, a->id,
+						(intptr_t)rec_idx);
+			}
+		}
+
+		array_free(a->occurrences);
+	}
+
+	array_free(ctx.attributes);
+}
+
+void prefetchAttributes
+(
+	ExecutionPlan *plan
+) {
+	ASSERT(plan != NULL);
+	_visitChains(plan->root, _prefetchAttributes);
+}
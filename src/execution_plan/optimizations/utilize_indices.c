@@ -105,6 +105,9 @@ static bool _applicable_predicate(const char* filtered_entity,
 
 	if(isDistanceFilter(filter)) return true;
 
+	// bounding box is served as a superset, exact filter is retained
+	if(isBBoxFilter(filter)) return true;
+
 	switch(filter->t) {
 	case FT_N_PRED:
 		lhs_exp = filter->pred.lhs;
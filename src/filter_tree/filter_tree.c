@@ -1149,6 +1149,81 @@ void FilterTree_Print
 	_FilterTree_Print(root, 0);
 }
 
+// string representation of filter tree operators
+static const char *_FilterTree_OpToString
+(
+	AST_Operator op
+) {
+	switch(op) {
+		case OP_EQUAL:  return "=";
+		case OP_NEQUAL: return "<>";
+		case OP_LT:     return "<";
+		case OP_GT:     return ">";
+		case OP_LE:     return "<=";
+		case OP_GE:     return ">=";
+		case OP_AND:    return "AND";
+		case OP_OR:     return "OR";
+		case OP_XOR:    return "XOR";
+		case OP_XNOR:   return "XNOR";
+		case OP_NOT:    return "NOT";
+		default:        return "?";
+	}
+}
+
+static void _FilterTree_ToString
+(
+	const FT_FilterNode *root,
+	sds *buf,
+	bool nested  // parenthesize conditions
+) {
+	char *exp   = NULL;
+	char *left  = NULL;
+	char *right = NULL;
+
+	switch(root->t) {
+		case FT_N_EXP:
+			AR_EXP_ToString(root->exp.exp, &exp);
+			*buf = sdscat(*buf, exp);
+			rm_free(exp);
+			break;
+		case FT_N_PRED:
+			AR_EXP_ToString(root->pred.lhs, &left);
+			AR_EXP_ToString(root->pred.rhs, &right);
+			*buf = sdscatprintf(*buf, "%s %s %s", left,
+					_FilterTree_OpToString(root->pred.op), right);
+			rm_free(left);
+			rm_free(right);
+			break;
+		case FT_N_COND:
+			if(nested) *buf = sdscat(*buf, "(");
+			if(root->cond.op == OP_NOT) {
+				*buf = sdscat(*buf, "NOT ");
+				_FilterTree_ToString(LeftChild(root), buf, true);
+			} else {
+				_FilterTree_ToString(LeftChild(root), buf, true);
+				*buf = sdscatprintf(*buf, " %s ",
+						_FilterTree_OpToString(root->cond.op));
+				_FilterTree_ToString(RightChild(root), buf, true);
+			}
+			if(nested) *buf = sdscat(*buf, ")");
+			break;
+		default:
+			ASSERT(false);
+			break;
+	}
+}
+
+void FilterTree_ToString
+(
+	const FT_FilterNode *root,
+	sds *buf
+) {
+	ASSERT(buf  != NULL);
+	ASSERT(root != NULL);
+
+	_FilterTree_ToString(root, buf, false);
+}
+
 void FilterTree_Free
 (
 	FT_FilterNode *root
@@ -10,6 +10,7 @@
 #include "../redismodule.h"
 #include "../ast/ast_shared.h"
 #include "../../deps/rax/rax.h"
+#include "../util/sds/sds.h"
 #include "../execution_plan/record.h"
 #include "../arithmetic/arithmetic_expression.h"
 
@@ -215,6 +216,14 @@ void FilterTree_Print
 	const FT_FilterNode *root
 );
 
+// appends tree's string representation to buf
+// e.g. n.v > 1 AND (n.name CONTAINS 'a' OR n.w IS NULL)
+void FilterTree_ToString
+(
+	const FT_FilterNode *root,  // tree to represent
+	sds *buf                    // string to append to
+);
+
 // free tree
 void FilterTree_Free
 (
@@ -0,0 +1,112 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "filter_tree_compile.h"
+#include "RG.h"
+
+// compile filter tree node
+// returns register holding either true, false or null
+static int _FilterTree_Compile
+(
+	AR_Program *p,
+	const FT_FilterNode *root
+) {
+	switch(root->t) {
+		case FT_N_EXP: {
+			int reg = AR_Program_EmitExp(p, root->exp.exp);
+			if(reg == AR_PROGRAM_INVALID_REG) return reg;
+			return AR_Program_EmitTruth(p, reg);
+		}
+
+		case FT_N_PRED: {
+			int lhs = AR_Program_EmitExp(p, root->pred.lhs);
+			if(lhs == AR_PROGRAM_INVALID_REG) return lhs;
+
+			int rhs = AR_Program_EmitExp(p, root->pred.rhs);
+			if(rhs == AR_PROGRAM_INVALID_REG) return rhs;
+
+			return AR_Program_EmitCompare(p, root->pred.op, lhs, rhs);
+		}
+
+		case FT_N_COND: {
+			AR_BranchCond cond;
+			AST_Operator op = root->cond.op;
+
+			// condition's value is determined by its left hand side when:
+			// false AND ?, true OR ?, null XOR ?, null XNOR ?
+			switch(op) {
+				case OP_AND:
+					cond = AR_BRANCH_FALSE;
+					break;
+				case OP_OR:
+					cond = AR_BRANCH_TRUE;
+					break;
+				case OP_XOR:
+				case OP_XNOR:
+					cond = AR_BRANCH_NULL;
+					break;
+				case OP_NOT:
+					break;
+				default:
+					return AR_PROGRAM_INVALID_REG;
+			}
+
+			int lhs = _FilterTree_Compile(p, root->cond.left);
+			if(lhs == AR_PROGRAM_INVALID_REG) return lhs;
+
+			if(op == OP_NOT) {
+				AR_Program_EmitLogic(p, op, lhs, lhs);
+				return lhs;
+			}
+
+			uint branch = AR_Program_EmitBranch(p, cond, lhs);
+
+			int rhs = _FilterTree_Compile(p, root->cond.right);
+			if(rhs == AR_PROGRAM_INVALID_REG) return rhs;
+
+			AR_Program_EmitLogic(p, op, lhs, rhs);
+			AR_Program_PatchBranch(p, branch);
+
+			return lhs;
+		}
+
+		default:
+			ASSERT(false);
+			return AR_PROGRAM_INVALID_REG;
+	}
+}
+
+AR_Program *FilterTree_Compile
+(
+	const FT_FilterNode *root
+) {
+	ASSERT(root != NULL);
+
+	AR_Program *p = AR_Program_New();
+	int result = _FilterTree_Compile(p, root);
+
+	if(result == AR_PROGRAM_INVALID_REG) {
+		AR_Program_Free(p);
+		return NULL;
+	}
+
+	AR_Program_Finalize(p, result);
+	return p;
+}
+
+FT_Result FilterTree_applyProgram
+(
+	AR_Program *program,
+	const Record r
+) {
+	ASSERT(program != NULL);
+
+	// program evaluates to either true, false or null
+	SIValue res = AR_Program_Evaluate(program, r);
+
+	if(SIValue_IsNull(res)) return FILTER_NULL;
+	return SIValue_IsTrue(res) ? FILTER_PASS : FILTER_FAIL;
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "filter_tree.h"
+#include "../arithmetic/arithmetic_expression_compile.h"
+
+// compile filter tree into a flat program
+// conditions are short-circuited using branches
+// returns NULL if one of the tree's expressions can't be compiled
+// in which case the tree should be applied using FilterTree_applyFilters
+AR_Program *FilterTree_Compile
+(
+	const FT_FilterNode *root  // filter tree to compile
+);
+
+// runs record through a compiled filter tree
+FT_Result FilterTree_applyProgram
+(
+	AR_Program *program,  // compiled filter tree
+	const Record r        // record to filter
+);
@@ -94,3 +94,44 @@ bool isDistanceFilter(const FT_FilterNode *filter) {
 	return res;
 }
 
+// extracts the bounding box corners from a bounding box filter
+// point.withinBBox(n.location, lower_left, upper_right)
+bool extractBBox(const FT_FilterNode *filter, SIValue *lower_left,
+		SIValue *upper_right, char **point) {
+	ASSERT(filter != NULL);
+
+	if(filter->t != FT_N_EXP) return false;
+
+	AR_ExpNode *exp = filter->exp.exp;
+	if(!AR_EXP_IsOperation(exp) ||
+	   strcasecmp(AR_EXP_GetFuncName(exp), "point.withinBBox") != 0) {
+		return false;
+	}
+
+	// first argument should be an attribute access
+	char *p = NULL;
+	if(!AR_EXP_IsAttribute(exp->op.children[0], &p)) return false;
+
+	// both corners should be constant points
+	SIValue ll = SI_NullVal();
+	SIValue ur = SI_NullVal();
+	bool ll_scalar = AR_EXP_ReduceToScalar(exp->op.children[1], true, &ll);
+	bool ur_scalar = AR_EXP_ReduceToScalar(exp->op.children[2], true, &ur);
+
+	bool res = (ll_scalar && SI_TYPE(ll) == T_POINT &&
+				ur_scalar && SI_TYPE(ur) == T_POINT);
+
+	if(res) {
+		if(point)       *point       = p;
+		if(lower_left)  *lower_left  = ll;
+		if(upper_right) *upper_right = ur;
+	}
+
+	return res;
+}
+
+// return true if filter performs bounding box filtering
+// point.withinBBox(n.location, point({...}), point({...}))
+bool isBBoxFilter(const FT_FilterNode *filter) {
+	return extractBBox(filter, NULL, NULL, NULL);
+}
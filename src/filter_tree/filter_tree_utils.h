@@ -15,3 +15,7 @@ bool extractOriginAndRadius(const FT_FilterNode *filter, SIValue *origin,
 
 bool isDistanceFilter(const FT_FilterNode *filter);
 
+bool extractBBox(const FT_FilterNode *filter, SIValue *lower_left,
+		SIValue *upper_right, char **point);
+
+bool isBBoxFilter(const FT_FilterNode *filter);
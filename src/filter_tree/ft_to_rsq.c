@@ -14,6 +14,10 @@
 #include "../util/range/string_range.h"
 #include "../util/range/numeric_range.h"
 
+// number of segments each edge of a bounding box is split into
+// when computing the box's circumscribing circle
+#define BBOX_EDGE_SEGMENTS 16
+
 //------------------------------------------------------------------------------
 // forward declarations
 //------------------------------------------------------------------------------
@@ -86,6 +90,79 @@ static RSQNode *_FilterTreeToDistanceQueryNode
 									Point_lon(origin), SI_GET_NUMERIC(radius), RS_GEO_DISTANCE_M);
 }
 
+// creates a RediSearch query node covering the bounding box of given filter
+// the geo index only supports radius queries, as such the box is
+// approximated by its circumscribing circle, callers are expected to
+// keep the original filter to discard points outside of the box
+static RSQNode *_FilterTreeToBBoxQueryNode
+(
+	const FT_FilterNode *filter,  // filter to convert
+	RSIndex *idx                  // queried index
+) {
+	char    *field = NULL;          // field being filtered
+	SIValue  ll    = SI_NullVal();  // lower left corner
+	SIValue  ur    = SI_NullVal();  // upper right corner
+
+	extractBBox(filter, &ll, &ur, &field);
+
+	float min_lat = Point_lat(ll);
+	float max_lat = Point_lat(ur);
+	float min_lon = Point_lon(ll);
+	float max_lon = Point_lon(ur);
+
+	// box crosses the antimeridian, unwrap upper right longitude
+	if(min_lon > max_lon) max_lon += 360;
+
+	float lat = (min_lat + max_lat) / 2;
+	float lon = (min_lon + max_lon) / 2;
+	if(lon > 180) lon -= 360;
+
+	// radius is the distance from the center to the farthest point on the
+	// box's boundary, for wide boxes that point might be anywhere along an
+	// edge, as such edges are sampled, every point on an edge is within half
+	// a segment of a sample, adding the longest half segment bounds the
+	// distance to any point on the boundary
+	SIValue center = SI_Point(lat, lon);
+
+	double radius       = 0;
+	double max_half_seg = 0;
+
+	for(int e = 0; e < 4; e++) {
+		SIValue prev = SI_NullVal();
+		for(int i = 0; i <= BBOX_EDGE_SEGMENTS; i++) {
+			float t = (float)i / BBOX_EDGE_SEGMENTS;
+			float p_lat;
+			float p_lon;
+
+			if(e < 2) {
+				// bottom and top edges
+				p_lat = (e == 0) ? min_lat : max_lat;
+				p_lon = min_lon + t * (max_lon - min_lon);
+			} else {
+				// left and right edges
+				p_lat = min_lat + t * (max_lat - min_lat);
+				p_lon = (e == 2) ? min_lon : max_lon;
+			}
+			if(p_lon > 180) p_lon -= 360;
+
+			SIValue p = SI_Point(p_lat, p_lon);
+			radius = MAX(radius, Point_Distance(center, p));
+			if(i > 0) {
+				max_half_seg = MAX(max_half_seg, Point_Distance(prev, p) / 2);
+			}
+			prev = p;
+		}
+	}
+
+	radius += max_half_seg;
+
+	// pad radius to account for rounding and geohash precision
+	radius = radius * 1.01 + 10;
+
+	return RediSearch_CreateGeoNode(idx, field, lat, lon, radius,
+			RS_GEO_DISTANCE_M);
+}
+
 // creates a RediSearch query node out of given IN filter
 static RSQNode *_FilterTreeToInQueryNode
 (
@@ -523,6 +600,12 @@ static bool _FilterTreeToQueryNode
 		return true;
 	}
 
+	if(isBBoxFilter(tree)) {
+		// index returns a superset of the box, retain filter
+		*root = _FilterTreeToBBoxQueryNode(tree, idx);
+		return false;
+	}
+
 	FT_FilterNodeType t = tree->t;
 
 	if(t == FT_N_COND) {
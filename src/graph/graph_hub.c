@@ -218,27 +218,95 @@ void DeleteEdges
 	Graph_DeleteEdges(gc->g, edges, n);
 }
 
-// updates a graph entity attribute set. Returns as out params the number
-// of properties set and removed.
+// returns true if both values are the same, e.g. a value shared by
+// a shallow cloned attribute-set
+static inline bool _SameValue
+(
+	SIValue a,
+	SIValue b
+) {
+	return a.type == b.type && a.longval == b.longval;
+}
+
+// replace an attribute's value
+// the original value is moved to the undo-log or freed if not logged
+static inline void _ReplaceAttribute
+(
+	UndoLog undo_log,             // undo-log, NULL if update isn't logged
+	GraphEntity *ge,              // updated entity
+	Attribute_ID attr_id,         // updated attribute
+	SIValue *current,             // attribute current value
+	SIValue v,                    // attribute new value
+	GraphEntityType entity_type   // entity type
+) {
+	if(undo_log != NULL) {
+		UndoLog_UpdateEntity(undo_log, ge, attr_id, *current, entity_type);
+	} else {
+		SIValue_Free(*current);
+	}
+	*current = v;
+}
+
+// updates a graph entity attribute set
+// only modified attributes are applied to the entity's attribute-set
+// each logging its original value, avoiding a copy of the entire set
 void UpdateEntityProperties
 (
 	GraphContext *gc,             // graph context
 	GraphEntity *ge,              // updated entity
-	const AttributeSet set,       // new attributes
+	AttributeSet set,             // new attributes
 	GraphEntityType entity_type,  // entity type
 	bool log                      // log update in undo-log
 ) {
 	ASSERT(gc != NULL);
 	ASSERT(ge != NULL);
 
-	AttributeSet old_set = GraphEntity_GetAttributes(ge);
+	UndoLog undo_log = (log == true) ? QueryCtx_GetUndoLog() : NULL;
 
-	if(log == true) {
-		UndoLog log = QueryCtx_GetUndoLog();
-		UndoLog_UpdateEntity(log, ge, old_set, entity_type);
+	//--------------------------------------------------------------------------
+	// removed attributes
+	//--------------------------------------------------------------------------
+
+	// iterate in reverse, attribute removal moves the last attribute
+	for(int i = AttributeSet_Count(*ge->attributes) - 1; i >= 0; i--) {
+		Attribute_ID attr_id;
+		AttributeSet_GetIdx(*ge->attributes, i, &attr_id);
+		if(AttributeSet_Get(set, attr_id) != ATTRIBUTE_NOTFOUND) continue;
+
+		// setting an attribute to NULL removes it
+		SIValue *current = AttributeSet_Get(*ge->attributes, attr_id);
+		_ReplaceAttribute(undo_log, ge, attr_id, current, SI_NullVal(),
+				entity_type);
+		AttributeSet_UpdateNoClone(ge->attributes, attr_id, SI_NullVal());
+	}
+
+	//--------------------------------------------------------------------------
+	// added and updated attributes
+	//--------------------------------------------------------------------------
+
+	for(uint16_t i = 0; i < AttributeSet_Count(set); i++) {
+		Attribute_ID attr_id;
+		SIValue v = AttributeSet_GetIdx(set, i, &attr_id);
+		SIValue *current = AttributeSet_Get(*ge->attributes, attr_id);
+
+		if(current == ATTRIBUTE_NOTFOUND) {
+			// attribute added
+			SIValue_Persist(&v);
+			AttributeSet_AddNoClone(ge->attributes, &attr_id, &v, 1, false);
+			if(undo_log != NULL) {
+				UndoLog_UpdateEntity(undo_log, ge, attr_id, SI_NullVal(),
+						entity_type);
+			}
+		} else if(!_SameValue(*current, v)) {
+			// attribute updated
+			SIValue_Persist(&v);
+			_ReplaceAttribute(undo_log, ge, attr_id, current, v, entity_type);
+		}
 	}
 
-	*ge->attributes = set;
+	// modified values were moved into the entity's attribute-set
+	// remaining values are shared with the entity, free container only
+	rm_free(set);
 
 	if(entity_type == GETYPE_NODE) {
 		_AddNodeToIndices(gc, (Node *)ge);
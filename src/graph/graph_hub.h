@@ -67,11 +67,14 @@ void DeleteEdges
 // update the entity attributes
 // update the relevant indexes of the entity
 // add entity update operations to undo log
+//
+// 'set' is the entity's new attribute-set, only attributes which differ
+// from the entity's current attributes are applied, 'set' is consumed
 void UpdateEntityProperties
 (
 	GraphContext *gc,             // graph context to update the entity
 	GraphEntity *ge,              // the entity to be updated
-	const AttributeSet set,       // attributes to update
+	AttributeSet set,             // new attribute-set
 	GraphEntityType entity_type,  // the entity type (node/edge)
 	bool log                      // log this operation in undo-log
 );
@@ -131,6 +131,8 @@ GraphContext *GraphContext_New
 	gc->cache = Cache_New(cache_size, (CacheEntryFreeFunc)ExecutionCtx_Free,
 						  (CacheEntryCopyFunc)ExecutionCtx_Clone);
 
+	gc->prepared = PreparedStatements_New();
+
 	Graph_SetMatrixPolicy(gc->g, SYNC_POLICY_FLUSH_RESIZE);
 
 	return gc;
@@ -675,11 +677,13 @@ bool GraphContext_AddExactMatchIndex
 	return index_changed;
 }
 
-// create a full text index for the given label and attribute
+// create a full text index for the given label / relationship type
+// and attributes
 bool GraphContext_AddFullTextIndex
 (
 	Index *idx,             // [input/output] index created
 	GraphContext *gc,        // graph context
+	SchemaType schema_type,  // type of entities to index nodes/edges
 	const char *label,       // label of indexed entities
 	const char **fields,     // fields to index
 	uint fields_count,       // number of fields to index
@@ -698,10 +702,10 @@ bool GraphContext_AddFullTextIndex
 	// retrieve the schema for this label
 	ResultSet *result_set   = QueryCtx_GetResultSet();
 	bool      index_changed = false;
-	Schema    *s            = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+	Schema    *s            = GraphContext_GetSchema(gc, label, schema_type);
 
 	if(s == NULL) {
-		s = GraphContext_AddSchema(gc, label, SCHEMA_NODE);
+		s = GraphContext_AddSchema(gc, label, schema_type);
 	}
 
 	for(uint i = 0; i < fields_count; i++) {
@@ -736,6 +740,45 @@ bool GraphContext_AddFullTextIndex
 	return index_changed;
 }
 
+// create a vector index for the given label and attribute
+bool GraphContext_AddVectorIndex
+(
+	Index *idx,                     // [input/output] index created
+	GraphContext *gc,               // graph context
+	const char *label,              // label of indexed nodes
+	const char *attribute,          // attribute to index
+	const VectorIndexOptions *opts  // vector index configuration
+) {
+	ASSERT(idx       != NULL);
+	ASSERT(gc        != NULL);
+	ASSERT(opts      != NULL);
+	ASSERT(label     != NULL);
+	ASSERT(attribute != NULL);
+
+	// retrieve the schema for this label
+	ResultSet *result_set = QueryCtx_GetResultSet();
+	Schema    *s          = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+
+	if(s == NULL) {
+		s = GraphContext_AddSchema(gc, label, SCHEMA_NODE);
+	}
+
+	IndexField index_field;
+	Attribute_ID f_id = GraphContext_FindOrAddAttribute(gc, attribute, NULL);
+	IndexField_Default(&index_field, f_id, attribute);
+	if(Schema_AddIndex(idx, s, &index_field, IDX_VECTOR) != INDEX_OK) {
+		return false;
+	}
+
+	// update result-set
+	ResultSet_IndexCreated(result_set, INDEX_OK);
+
+	Index_SetVectorOptions(*idx, opts);
+	Index_Disable(*idx);
+
+	return true;
+}
+
 int GraphContext_DeleteIndex
 (
 	GraphContext *gc,
@@ -844,6 +887,15 @@ Cache *GraphContext_GetCache(const GraphContext *gc) {
 	return gc->cache;
 }
 
+// return graph's prepared statements registry
+PreparedStatements *GraphContext_GetPreparedStatements
+(
+	const GraphContext *gc
+) {
+	ASSERT(gc != NULL);
+	return gc->prepared;
+}
+
 //------------------------------------------------------------------------------
 // Free routine
 //------------------------------------------------------------------------------
@@ -965,6 +1017,7 @@ static void _GraphContext_Free(void *arg) {
 	//--------------------------------------------------------------------------
 
 	if(gc->cache) Cache_Free(gc->cache);
+	if(gc->prepared) PreparedStatements_Free(gc->prepared);
 
 	GraphEncodeContext_Free(gc->encoding_context);
 	GraphDecodeContext_Free(gc->decoding_context);
@@ -13,6 +13,7 @@
 #include "../util/cache/cache.h"
 #include "../slow_log/slow_log.h"
 #include "../queries_log/queries_log.h"
+#include "../commands/prepared_statements.h"
 #include "../serializers/encode_context.h"
 #include "../serializers/decode_context.h"
 
@@ -41,6 +42,7 @@ typedef struct {
 	GraphEncodeContext *encoding_context;  // encode context of the graph
 	GraphDecodeContext *decoding_context;  // decode context of the graph
 	Cache *cache;                          // global cache of execution plans
+	PreparedStatements *prepared;          // prepared statements
 	XXH32_hash_t version;                  // graph version
 	RedisModuleString *telemetry_stream;   // telemetry stream name
 } GraphContext;
@@ -289,11 +291,13 @@ bool GraphContext_AddExactMatchIndex
 	bool should_reply           // should reply to client
 );
 
-// create a full text index for the given label and attribute
+// create a full text index for the given label / relationship type
+// and attributes
 bool GraphContext_AddFullTextIndex
 (
 	Index *idx,              // [input/output] index created
 	GraphContext *gc,        // graph context
+	SchemaType schema_type,  // type of entities to index nodes/edges
 	const char *label,       // label of indexed entities
 	const char **fields,     // fields to index
 	uint fields_count,       // number of fields to index
@@ -304,6 +308,16 @@ bool GraphContext_AddFullTextIndex
 	const char *language
 );
 
+// create a vector index for the given label and attribute
+bool GraphContext_AddVectorIndex
+(
+	Index *idx,                     // [input/output] index created
+	GraphContext *gc,               // graph context
+	const char *label,              // label of indexed nodes
+	const char *attribute,          // attribute to index
+	const VectorIndexOptions *opts  // vector index configuration
+);
+
 // remove and free an index
 int GraphContext_DeleteIndex
 (
@@ -380,3 +394,9 @@ Cache *GraphContext_GetCache
 	const GraphContext *gc
 );
 
+// return graph's prepared statements registry
+PreparedStatements *GraphContext_GetPreparedStatements
+(
+	const GraphContext *gc
+);
+
@@ -0,0 +1,666 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "hnsw.h"
+#include "rax.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
+#include "../datatypes/vector.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+// maximum number of layers an element can be linked on
+#define HNSW_MAX_LEVEL 16
+
+// minimal number of removed elements before the graph is rebuilt
+#define HNSW_COMPACT_THRESHOLD 1024
+
+typedef struct {
+	float dist;     // distance from the query
+	uint32_t slot;  // element slot
+} HNSWCandidate;
+
+// visited set, an element is visited if its tag equals the current epoch
+// advancing the epoch clears the set without touching the tags
+typedef struct {
+	uint32_t *tags;  // per slot tag
+	uint32_t cap;    // number of tags
+	uint32_t epoch;  // current epoch
+} HNSWVisited;
+
+// pool of visited sets, reused across searches
+// concurrent searches each borrow a different set
+typedef struct {
+	HNSWVisited **sets;    // available sets
+	pthread_mutex_t lock;  // guards 'sets'
+} HNSWVisitedPool;
+
+typedef struct {
+	EntityID id;       // indexed entity
+	float *vector;     // element's vector, normalized under cosine
+	uint32_t **links;  // per layer neighbors, links[l][0] holds the count
+	uint8_t level;     // element's top layer
+	bool deleted;      // removed elements keep routing searches
+} HNSWElement;
+
+struct HNSW {
+	uint32_t dim;           // vectors dimension
+	VectorSimilarity sim;   // distance function
+	uint M;                 // max links per element on upper layers
+	uint M0;                // max links per element on layer 0
+	uint ef_construction;   // candidate list size on insertion
+	double level_mult;      // level generation factor, 1/ln(M)
+	HNSWElement *elements;  // elements, addressed by slot
+	rax *ids;               // entity id to element slot
+	uint32_t entry;         // entry point slot
+	int max_level;          // entry point level, -1 when the graph is empty
+	uint64_t live;          // number of elements which weren't removed
+	uint64_t seed;          // level generator state
+	HNSWVisitedPool *pool;  // visited sets
+};
+
+//------------------------------------------------------------------------------
+// distance
+//------------------------------------------------------------------------------
+
+// internal distance, cosine operates on normalized vectors
+// euclidean skips the square root as it preserves order
+static inline float _distance
+(
+	const HNSW *h,
+	const float *a,
+	const float *b
+) {
+	if(h->sim == VECSIM_COSINE) return 1 - Vector_Dot(a, b, h->dim);
+	return Vector_L2Squared(a, b, h->dim);
+}
+
+// convert internal distance to the reported distance
+static inline float _reported_distance
+(
+	const HNSW *h,
+	float d
+) {
+	if(h->sim == VECSIM_COSINE) return (d < 0) ? 0 : d;
+	return sqrtf(d);
+}
+
+static void _normalize
+(
+	float *v,
+	uint32_t dim
+) {
+	float norm = sqrtf(Vector_Dot(v, v, dim));
+	if(norm == 0) return;
+
+	for(uint32_t i = 0; i < dim; i++) v[i] /= norm;
+}
+
+//------------------------------------------------------------------------------
+// visited sets
+//------------------------------------------------------------------------------
+
+// borrow a visited set able to hold 'n' slots
+static HNSWVisited *_visited_acquire
+(
+	HNSWVisitedPool *pool,
+	uint32_t n
+) {
+	HNSWVisited *v = NULL;
+
+	pthread_mutex_lock(&pool->lock);
+	if(array_len(pool->sets) > 0) v = array_pop(pool->sets);
+	pthread_mutex_unlock(&pool->lock);
+
+	if(v == NULL) v = rm_calloc(1, sizeof(HNSWVisited));
+
+	// grow set, new tags are older than any epoch
+	if(v->cap < n) {
+		v->tags = rm_realloc(v->tags, sizeof(uint32_t) * n);
+		memset(v->tags + v->cap, 0, sizeof(uint32_t) * (n - v->cap));
+		v->cap = n;
+	}
+
+	return v;
+}
+
+// return a borrowed visited set to the pool
+static void _visited_release
+(
+	HNSWVisitedPool *pool,
+	HNSWVisited *v
+) {
+	pthread_mutex_lock(&pool->lock);
+	array_append(pool->sets, v);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+// empty visited set
+static inline void _visited_clear
+(
+	HNSWVisited *v
+) {
+	// reset tags once the epoch wraps around
+	if(++v->epoch == 0) {
+		memset(v->tags, 0, sizeof(uint32_t) * v->cap);
+		v->epoch = 1;
+	}
+}
+
+// mark slot 's' as visited, returns false if it was already visited
+static inline bool _visited_add
+(
+	HNSWVisited *v,
+	uint32_t s
+) {
+	ASSERT(s < v->cap);
+
+	if(v->tags[s] == v->epoch) return false;
+	v->tags[s] = v->epoch;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// candidates heap
+//------------------------------------------------------------------------------
+
+// returns true if 'a' should be placed above 'b'
+static inline bool _above
+(
+	HNSWCandidate a,
+	HNSWCandidate b,
+	bool max
+) {
+	return max ? a.dist > b.dist : a.dist < b.dist;
+}
+
+static void _heap_push
+(
+	HNSWCandidate **heap,  // min or max heap
+	HNSWCandidate c,       // candidate to add
+	bool max               // heap order
+) {
+	array_append(*heap, c);
+
+	HNSWCandidate *arr = *heap;
+	uint32_t i = array_len(arr) - 1;
+	while(i > 0) {
+		uint32_t parent = (i - 1) / 2;
+		if(!_above(arr[i], arr[parent], max)) break;
+
+		HNSWCandidate tmp = arr[i];
+		arr[i]      = arr[parent];
+		arr[parent] = tmp;
+		i = parent;
+	}
+}
+
+static HNSWCandidate _heap_pop
+(
+	HNSWCandidate *heap,  // min or max heap
+	bool max              // heap order
+) {
+	ASSERT(array_len(heap) > 0);
+
+	HNSWCandidate top  = heap[0];
+	HNSWCandidate last = array_pop(heap);
+	uint32_t n = array_len(heap);
+	if(n == 0) return top;
+
+	heap[0] = last;
+	uint32_t i = 0;
+	while(true) {
+		uint32_t l = 2 * i + 1;
+		uint32_t r = l + 1;
+		uint32_t best = i;
+
+		if(l < n && _above(heap[l], heap[best], max)) best = l;
+		if(r < n && _above(heap[r], heap[best], max)) best = r;
+		if(best == i) break;
+
+		HNSWCandidate tmp = heap[i];
+		heap[i]    = heap[best];
+		heap[best] = tmp;
+		i = best;
+	}
+
+	return top;
+}
+
+static int _candidate_cmp
+(
+	const void *a,
+	const void *b
+) {
+	float da = ((const HNSWCandidate *)a)->dist;
+	float db = ((const HNSWCandidate *)b)->dist;
+	return (da > db) - (da < db);
+}
+
+//------------------------------------------------------------------------------
+// graph construction
+//------------------------------------------------------------------------------
+
+// draw a level from an exponentially decaying distribution
+static int _random_level
+(
+	HNSW *h
+) {
+	// xorshift64*
+	h->seed ^= h->seed >> 12;
+	h->seed ^= h->seed << 25;
+	h->seed ^= h->seed >> 27;
+	uint64_t r = h->seed * 2685821657736338717ULL;
+
+	// uniform in (0, 1]
+	double u = ((r >> 11) + 1) * (1.0 / 9007199254740992.0);
+	int level = (int)(-log(u) * h->level_mult);
+
+	return (level > HNSW_MAX_LEVEL) ? HNSW_MAX_LEVEL : level;
+}
+
+// search layer 'level' for the 'ef' elements closest to 'q'
+// starting from entry points 'eps'
+// on return 'W' is a max-heap holding the closest elements found
+static void _search_layer
+(
+	const HNSW *h,             // graph
+	const float *q,            // query vector
+	const HNSWCandidate *eps,  // entry points
+	uint n_eps,                // number of entry points
+	uint ef,                   // number of elements to collect
+	int level,                 // layer to search
+	HNSWVisited *visited,      // visited set, cleared on entry
+	HNSWCandidate **W          // [output] closest elements
+) {
+	_visited_clear(visited);
+	array_clear(*W);
+
+	// candidates to expand, closest first
+	HNSWCandidate *C = array_new(HNSWCandidate, ef);
+
+	for(uint i = 0; i < n_eps; i++) {
+		_visited_add(visited, eps[i].slot);
+		_heap_push(&C, eps[i], false);
+		_heap_push(W, eps[i], true);
+		if(array_len(*W) > ef) _heap_pop(*W, true);
+	}
+
+	while(array_len(C) > 0) {
+		HNSWCandidate c = _heap_pop(C, false);
+
+		// closest candidate is further than the furthest result
+		if(array_len(*W) >= ef && c.dist > (*W)[0].dist) break;
+
+		const uint32_t *links = h->elements[c.slot].links[level];
+		for(uint32_t i = 1; i <= links[0]; i++) {
+			uint32_t e = links[i];
+			if(!_visited_add(visited, e)) continue;
+
+			float d = _distance(h, q, h->elements[e].vector);
+			if(array_len(*W) < ef || d < (*W)[0].dist) {
+				HNSWCandidate candidate = {.dist = d, .slot = e};
+				_heap_push(&C, candidate, false);
+				_heap_push(W, candidate, true);
+				if(array_len(*W) > ef) _heap_pop(*W, true);
+			}
+		}
+	}
+
+	array_free(C);
+}
+
+// select up to 'M' neighbors out of 'candidates', sorted by ascending distance
+// a candidate is kept only if it is closer to the base element
+// than to any of the already selected neighbors
+// which keeps links spread across clusters
+static uint _select_neighbors
+(
+	const HNSW *h,                    // graph
+	const HNSWCandidate *candidates,  // sorted candidates
+	uint n,                           // number of candidates
+	uint M,                           // max number of neighbors
+	uint32_t *selected                // [output] selected slots
+) {
+	uint count = 0;
+	for(uint i = 0; i < n && count < M; i++) {
+		const float *v = h->elements[candidates[i].slot].vector;
+
+		bool keep = true;
+		for(uint j = 0; j < count; j++) {
+			const float *s = h->elements[selected[j]].vector;
+			if(_distance(h, v, s) < candidates[i].dist) {
+				keep = false;
+				break;
+			}
+		}
+
+		if(keep) selected[count++] = candidates[i].slot;
+	}
+
+	return count;
+}
+
+// link 'src' to 'dest' on layer 'level'
+// shrinking src's neighbors if it exceeded its capacity
+static void _link
+(
+	HNSW *h,
+	uint32_t src,
+	uint32_t dest,
+	int level
+) {
+	uint cap = (level == 0) ? h->M0 : h->M;
+	uint32_t *links = h->elements[src].links[level];
+
+	if(links[0] < cap) {
+		links[++links[0]] = dest;
+		return;
+	}
+
+	// reselect src's neighbors out of its current links and dest
+	const float *v = h->elements[src].vector;
+	HNSWCandidate candidates[cap + 1];
+	for(uint i = 0; i < cap; i++) {
+		uint32_t s = links[i + 1];
+		candidates[i].slot = s;
+		candidates[i].dist = _distance(h, v, h->elements[s].vector);
+	}
+	candidates[cap].slot = dest;
+	candidates[cap].dist = _distance(h, v, h->elements[dest].vector);
+
+	qsort(candidates, cap + 1, sizeof(HNSWCandidate), _candidate_cmp);
+	links[0] = _select_neighbors(h, candidates, cap + 1, cap, links + 1);
+}
+
+static void _element_free
+(
+	HNSWElement *e
+) {
+	for(int l = 0; l <= e->level; l++) rm_free(e->links[l]);
+	rm_free(e->links);
+	rm_free(e->vector);
+}
+
+// rebuild graph out of its live elements
+// removed elements are only marked as deleted, once they outnumber the live
+// elements the graph is rebuilt to restore search quality and reclaim memory
+static void _HNSW_Compact
+(
+	HNSW *h
+) {
+	HNSWElement *elements = h->elements;
+	uint32_t n = array_len(elements);
+
+	h->elements  = array_new(HNSWElement, h->live);
+	h->entry     = 0;
+	h->max_level = -1;
+	h->live      = 0;
+	raxFree(h->ids);
+	h->ids = raxNew();
+
+	for(uint32_t i = 0; i < n; i++) {
+		HNSWElement *e = elements + i;
+		if(!e->deleted) HNSW_Insert(h, e->id, e->vector);
+		_element_free(e);
+	}
+
+	array_free(elements);
+}
+
+//------------------------------------------------------------------------------
+// HNSW API
+//------------------------------------------------------------------------------
+
+HNSW *HNSW_New
+(
+	uint32_t dim,
+	VectorSimilarity sim,
+	uint M,
+	uint ef_construction
+) {
+	ASSERT(dim > 0);
+	ASSERT(M > 1);
+	ASSERT(ef_construction > 0);
+
+	HNSW *h = rm_malloc(sizeof(HNSW));
+
+	h->M               = M;
+	h->M0              = 2 * M;
+	h->dim             = dim;
+	h->sim             = sim;
+	h->ids             = raxNew();
+	h->live            = 0;
+	h->seed            = 0x9E3779B97F4A7C15ULL;
+	h->entry           = 0;
+	h->elements        = array_new(HNSWElement, 0);
+	h->max_level       = -1;
+	h->level_mult      = 1 / log(M);
+	h->ef_construction = ef_construction;
+
+	h->pool = rm_malloc(sizeof(HNSWVisitedPool));
+	h->pool->sets = array_new(HNSWVisited *, 1);
+	pthread_mutex_init(&h->pool->lock, NULL);
+
+	return h;
+}
+
+uint64_t HNSW_Size
+(
+	const HNSW *h
+) {
+	ASSERT(h != NULL);
+
+	return h->live;
+}
+
+void HNSW_Insert
+(
+	HNSW *h,
+	EntityID id,
+	const float *v
+) {
+	ASSERT(h != NULL);
+	ASSERT(v != NULL);
+
+	// replace entity's previous vector
+	HNSW_Remove(h, id);
+
+	//--------------------------------------------------------------------------
+	// create element
+	//--------------------------------------------------------------------------
+
+	uint32_t slot  = array_len(h->elements);
+	int      level = _random_level(h);
+
+	HNSWElement e;
+	e.id      = id;
+	e.level   = level;
+	e.deleted = false;
+	e.vector  = rm_malloc(sizeof(float) * h->dim);
+	e.links   = rm_malloc(sizeof(uint32_t *) * (level + 1));
+
+	memcpy(e.vector, v, sizeof(float) * h->dim);
+	if(h->sim == VECSIM_COSINE) _normalize(e.vector, h->dim);
+
+	for(int l = 0; l <= level; l++) {
+		uint cap = (l == 0) ? h->M0 : h->M;
+		e.links[l] = rm_malloc(sizeof(uint32_t) * (cap + 1));
+		e.links[l][0] = 0;
+	}
+
+	array_append(h->elements, e);
+	raxInsert(h->ids, (unsigned char *)&id, sizeof(id),
+			(void *)(uintptr_t)slot, NULL);
+	h->live++;
+
+	// first element
+	if(h->max_level < 0) {
+		h->entry     = slot;
+		h->max_level = level;
+		return;
+	}
+
+	//--------------------------------------------------------------------------
+	// link element
+	//--------------------------------------------------------------------------
+
+	const float   *q       = e.vector;
+	HNSWVisited   *visited = _visited_acquire(h->pool, slot + 1);
+	HNSWCandidate *W       = array_new(HNSWCandidate, h->ef_construction + 1);
+	HNSWCandidate *eps     = array_new(HNSWCandidate, h->ef_construction + 1);
+	uint32_t      neighbors[h->M0];
+
+	HNSWCandidate ep = {
+		.dist = _distance(h, q, h->elements[h->entry].vector),
+		.slot = h->entry
+	};
+	array_append(eps, ep);
+
+	// greedy descent through the layers above the element's level
+	for(int l = h->max_level; l > level; l--) {
+		_search_layer(h, q, eps, array_len(eps), 1, l, visited, &W);
+		eps[0] = W[0];
+	}
+
+	int top = (level < h->max_level) ? level : h->max_level;
+	for(int l = top; l >= 0; l--) {
+		_search_layer(h, q, eps, array_len(eps), h->ef_construction, l,
+				visited, &W);
+		qsort(W, array_len(W), sizeof(HNSWCandidate), _candidate_cmp);
+
+		uint n = _select_neighbors(h, W, array_len(W), h->M, neighbors);
+
+		uint32_t *links = h->elements[slot].links[l];
+		links[0] = n;
+		memcpy(links + 1, neighbors, sizeof(uint32_t) * n);
+
+		for(uint i = 0; i < n; i++) _link(h, neighbors[i], slot, l);
+
+		// layer's results are the entry points of the next layer
+		array_clear(eps);
+		for(uint i = 0; i < array_len(W); i++) array_append(eps, W[i]);
+	}
+
+	if(level > h->max_level) {
+		h->entry     = slot;
+		h->max_level = level;
+	}
+
+	array_free(W);
+	array_free(eps);
+	_visited_release(h->pool, visited);
+}
+
+void HNSW_Remove
+(
+	HNSW *h,
+	EntityID id
+) {
+	ASSERT(h != NULL);
+
+	void *slot = raxFind(h->ids, (unsigned char *)&id, sizeof(id));
+	if(slot == raxNotFound) return;
+
+	raxRemove(h->ids, (unsigned char *)&id, sizeof(id), NULL);
+	h->elements[(uintptr_t)slot].deleted = true;
+	h->live--;
+
+	uint64_t removed = array_len(h->elements) - h->live;
+	if(removed > HNSW_COMPACT_THRESHOLD && removed > h->live) {
+		_HNSW_Compact(h);
+	}
+}
+
+uint HNSW_Search
+(
+	const HNSW *h,
+	const float *q,
+	uint k,
+	uint ef,
+	EntityID *ids,
+	float *distances
+) {
+	ASSERT(h         != NULL);
+	ASSERT(q         != NULL);
+	ASSERT(ids       != NULL);
+	ASSERT(distances != NULL);
+
+	if(h->live == 0 || k == 0) return 0;
+
+	// normalize query under cosine
+	float *query = NULL;
+	if(h->sim == VECSIM_COSINE) {
+		query = rm_malloc(sizeof(float) * h->dim);
+		memcpy(query, q, sizeof(float) * h->dim);
+		_normalize(query, h->dim);
+		q = query;
+	}
+
+	if(ef < k) ef = k;
+
+	uint32_t      n       = array_len(h->elements);
+	HNSWVisited   *visited = _visited_acquire(h->pool, n);
+	HNSWCandidate *W       = array_new(HNSWCandidate, ef + 1);
+
+	HNSWCandidate ep = {
+		.dist = _distance(h, q, h->elements[h->entry].vector),
+		.slot = h->entry
+	};
+
+	// greedy descent to layer 0
+	for(int l = h->max_level; l > 0; l--) {
+		_search_layer(h, q, &ep, 1, 1, l, visited, &W);
+		ep = W[0];
+	}
+
+	_search_layer(h, q, &ep, 1, ef, 0, visited, &W);
+	qsort(W, array_len(W), sizeof(HNSWCandidate), _candidate_cmp);
+
+	// collect k closest live elements
+	uint found = 0;
+	for(uint i = 0; i < array_len(W) && found < k; i++) {
+		const HNSWElement *e = h->elements + W[i].slot;
+		if(e->deleted) continue;
+
+		ids[found]       = e->id;
+		distances[found] = _reported_distance(h, W[i].dist);
+		found++;
+	}
+
+	array_free(W);
+	_visited_release(h->pool, visited);
+	if(query != NULL) rm_free(query);
+
+	return found;
+}
+
+void HNSW_Free
+(
+	HNSW *h
+) {
+	ASSERT(h != NULL);
+
+	uint32_t n = array_len(h->elements);
+	for(uint32_t i = 0; i < n; i++) _element_free(h->elements + i);
+
+	array_free(h->elements);
+	raxFree(h->ids);
+
+	uint n_sets = array_len(h->pool->sets);
+	for(uint i = 0; i < n_sets; i++) {
+		rm_free(h->pool->sets[i]->tags);
+		rm_free(h->pool->sets[i]);
+	}
+	array_free(h->pool->sets);
+	pthread_mutex_destroy(&h->pool->lock);
+	rm_free(h->pool);
+
+	rm_free(h);
+}
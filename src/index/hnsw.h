@@ -0,0 +1,77 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../graph/entities/graph_entity.h"
+
+#include <stdint.h>
+
+// hierarchical navigable small world graph
+// an approximate nearest neighbors structure over float32 vectors
+// see: Malkov & Yashunin, "Efficient and robust approximate nearest neighbor
+// search using Hierarchical Navigable Small World graphs"
+
+#define HNSW_DEFAULT_M                16   // max links per element per layer
+#define HNSW_DEFAULT_EF_CONSTRUCTION  200  // candidate list size on insertion
+#define HNSW_DEFAULT_EF_RUNTIME       10   // candidate list size on search
+
+typedef enum {
+	VECSIM_EUCLIDEAN = 0,  // euclidean distance
+	VECSIM_COSINE    = 1,  // cosine distance
+} VectorSimilarity;
+
+typedef struct HNSW HNSW;
+
+// create a new empty HNSW graph
+HNSW *HNSW_New
+(
+	uint32_t dim,                // vectors dimension
+	VectorSimilarity sim,        // distance function
+	uint M,                      // max links per element per layer
+	uint ef_construction         // candidate list size on insertion
+);
+
+// returns number of vectors in the graph
+uint64_t HNSW_Size
+(
+	const HNSW *h  // graph to query
+);
+
+// adds vector 'v' associated with entity 'id' to the graph
+// replaces entity's previous vector if one exists
+void HNSW_Insert
+(
+	HNSW *h,         // graph to update
+	EntityID id,     // entity associated with vector
+	const float *v   // vector, of the graph's dimension
+);
+
+// removes entity 'id' from the graph, if present
+void HNSW_Remove
+(
+	HNSW *h,     // graph to update
+	EntityID id  // entity to remove
+);
+
+// searches for the 'k' approximate nearest neighbors of 'q'
+// results are sorted by ascending distance
+// returns number of results written to 'ids' and 'distances'
+uint HNSW_Search
+(
+	const HNSW *h,     // graph to search
+	const float *q,    // query vector, of the graph's dimension
+	uint k,            // number of neighbors to return
+	uint ef,           // candidate list size, larger values improve recall
+	EntityID *ids,     // [output] k entity ids
+	float *distances   // [output] k distances
+);
+
+// free HNSW graph
+void HNSW_Free
+(
+	HNSW *h  // graph to free
+);
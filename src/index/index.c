@@ -24,11 +24,24 @@ struct _Index {
 	char *language;                // language
 	char **stopwords;              // stopwords
 	GraphEntityType entity_type;   // entity type (node/edge) indexed
-	IndexType type;                // index type exact-match / fulltext
+	IndexType type;                // index type exact-match / fulltext / vector
 	RSIndex *rsIdx;                // RediSearch index
+	HNSW *hnsw;                    // vector index graph
+	VectorIndexOptions vec_opts;   // vector index configuration
 	uint _Atomic pending_changes;  // number of pending changes
 };
 
+// introduce edge src and dest node ids as additional index fields
+static void _Index_ConstructEdgeFields
+(
+	RSIndex *rsIdx
+) {
+	ASSERT(rsIdx != NULL);
+
+	RediSearch_CreateField(rsIdx, "_src_id", RSFLDTYPE_NUMERIC, RSFLDOPT_NONE);
+	RediSearch_CreateField(rsIdx, "_dest_id", RSFLDTYPE_NUMERIC, RSFLDOPT_NONE);
+}
+
 static void _Index_ConstructFullTextStructure
 (
 	Index idx,
@@ -55,6 +68,8 @@ static void _Index_ConstructFullTextStructure
 				RSFLDTYPE_FULLTEXT, options);
 		RediSearch_TextFieldSetWeight(rsIdx, fieldID, field->weight);
 	}
+
+	if(idx->entity_type == GETYPE_EDGE) _Index_ConstructEdgeFields(rsIdx);
 }
 
 static void _Index_ConstructExactMatchStructure
@@ -79,12 +94,7 @@ static void _Index_ConstructExactMatchStructure
 	}
 
 	// introduce edge src and dest node ids as additional index fields
-	if(idx->entity_type == GETYPE_EDGE) {
-		RediSearch_CreateField(rsIdx, "_src_id", RSFLDTYPE_NUMERIC,
-				RSFLDOPT_NONE);
-		RediSearch_CreateField(rsIdx, "_dest_id", RSFLDTYPE_NUMERIC,
-				RSFLDOPT_NONE);
-	}
+	if(idx->entity_type == GETYPE_EDGE) _Index_ConstructEdgeFields(rsIdx);
 
 	// for none indexable types e.g. Array introduce an additional field
 	// "none_indexable_fields" which will hold a list of attribute names
@@ -103,6 +113,15 @@ void Index_ConstructStructure
 ) {
 	ASSERT(idx != NULL);
 	ASSERT(idx->rsIdx == NULL);
+	ASSERT(idx->hnsw == NULL);
+
+	// vector indices are maintained outside of RediSearch
+	if(idx->type == IDX_VECTOR) {
+		VectorIndexOptions *opts = &idx->vec_opts;
+		idx->hnsw = HNSW_New(opts->dimension, opts->similarity, opts->M,
+				opts->ef_construction);
+		return;
+	}
 
 	RSIndex *rsIdx = NULL;
 	RSIndexOptions *idx_options = RediSearch_CreateIndexOptions();
@@ -289,8 +308,10 @@ Index Index_New
 	Index idx = rm_malloc(sizeof(_Index));
 
 	idx->type            = type;
+	idx->hnsw            = NULL;
 	idx->label           = rm_strdup(label);
 	idx->rsIdx           = NULL;
+	idx->vec_opts        = (VectorIndexOptions){0};
 	idx->fields          = array_new(IndexField, 1);
 	idx->label_id        = label_id;
 	idx->language        = NULL;
@@ -316,6 +337,7 @@ Index Index_Clone
 	Index clone = rm_malloc(sizeof(_Index));
 	memcpy(clone, idx, sizeof(_Index));
 
+	clone->hnsw            = NULL;
 	clone->rsIdx           = NULL;
 	clone->label           = rm_strdup(idx->label);
 	clone->pending_changes = ATOMIC_VAR_INIT(0);
@@ -366,6 +388,11 @@ void Index_Disable
 		idx->rsIdx = NULL;
 	}
 
+	if(idx->hnsw != NULL) {
+		HNSW_Free(idx->hnsw);
+		idx->hnsw = NULL;
+	}
+
 	// construct index structure
 	Index_ConstructStructure(idx);
 }
@@ -377,7 +404,7 @@ void Index_Enable
 	Index idx
 ) {
 	ASSERT(idx != NULL);
-	ASSERT(idx->rsIdx != NULL);
+	ASSERT(idx->rsIdx != NULL || idx->hnsw != NULL);
 	ASSERT(idx->pending_changes > 0);
 
 	idx->pending_changes--;
@@ -583,6 +610,41 @@ RSIndex *Index_RSIndex
 	return idx->rsIdx;
 }
 
+// set vector index configuration
+void Index_SetVectorOptions
+(
+	Index idx,
+	const VectorIndexOptions *opts
+) {
+	ASSERT(idx  != NULL);
+	ASSERT(opts != NULL);
+	ASSERT(idx->type == IDX_VECTOR);
+	ASSERT(idx->hnsw == NULL);
+
+	idx->vec_opts = *opts;
+}
+
+// returns vector index configuration
+const VectorIndexOptions *Index_GetVectorOptions
+(
+	const Index idx
+) {
+	ASSERT(idx != NULL);
+	ASSERT(idx->type == IDX_VECTOR);
+
+	return &idx->vec_opts;
+}
+
+// returns HNSW graph of a vector index
+HNSW *Index_HNSW
+(
+	const Index idx
+) {
+	ASSERT(idx != NULL);
+
+	return idx->hnsw;
+}
+
 // free index
 void Index_Free
 (
@@ -594,6 +656,10 @@ void Index_Free
 		RediSearch_DropIndex(idx->rsIdx);
 	}
 
+	if(idx->hnsw) {
+		HNSW_Free(idx->hnsw);
+	}
+
 	if(idx->language) {
 		rm_free(idx->language);
 	}
@@ -10,6 +10,7 @@
 #include "../graph/entities/edge.h"
 #include "../graph/entities/graph_entity.h"
 #include "../graph/graph.h"
+#include "hnsw.h"
 #include "redisearch_api.h"
 
 #define INDEX_OK 1
@@ -34,8 +35,17 @@ typedef enum {
 	IDX_ANY          =  0,
 	IDX_EXACT_MATCH  =  1,
 	IDX_FULLTEXT     =  2,
+	IDX_VECTOR       =  3,
 } IndexType;
 
+// vector index configuration
+typedef struct {
+	uint32_t dimension;           // indexed vectors dimension
+	VectorSimilarity similarity;  // distance function
+	uint M;                       // max links per element per layer
+	uint ef_construction;         // candidate list size on insertion
+} VectorIndexOptions;
+
 typedef struct {
 	EntityID src_id;
 	EntityID dest_id;
@@ -248,6 +258,25 @@ void Index_SetStopwords
 	char **stopwords  // stopwords
 );
 
+// set vector index configuration
+void Index_SetVectorOptions
+(
+	Index idx,                       // index modified
+	const VectorIndexOptions *opts   // vector index configuration
+);
+
+// returns vector index configuration
+const VectorIndexOptions *Index_GetVectorOptions
+(
+	const Index idx  // index to query
+);
+
+// returns HNSW graph of a vector index
+HNSW *Index_HNSW
+(
+	const Index idx  // index to get internal HNSW graph from
+);
+
 // free fulltext index
 void Index_Free
 (
@@ -8,12 +8,36 @@
 #include "index.h"
 #include "../value.h"
 #include "../query_ctx.h"
+#include "../datatypes/vector.h"
 #include "../graph/graphcontext.h"
 #include "../graph/rg_matrix/rg_matrix_iter.h"
 
 extern RSDoc *Index_IndexGraphEntity(Index idx, const GraphEntity *e,
 		const void *key, size_t key_len, uint *doc_field_count);
 
+// index node's vector attribute
+// nodes missing the attribute or holding a vector of a different dimension
+// are removed from the index
+static void _Index_IndexNodeVector
+(
+	Index idx,
+	const Node *n
+) {
+	HNSW *hnsw = Index_HNSW(idx);
+	ASSERT(hnsw != NULL);
+
+	const IndexField *field = Index_GetFields(idx);
+	const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+	SIValue *v = GraphEntity_GetProperty((const GraphEntity *)n, field->id);
+
+	if(v != ATTRIBUTE_NOTFOUND && SI_TYPE(*v) == T_VECTOR_F32 &&
+	   SIVector_Dim(*v) == opts->dimension) {
+		HNSW_Insert(hnsw, ENTITY_GET_ID(n), SIVector_Elements(*v));
+	} else {
+		HNSW_Remove(hnsw, ENTITY_GET_ID(n));
+	}
+}
+
 void Index_IndexNode
 (
 	Index idx,
@@ -22,6 +46,11 @@ void Index_IndexNode
 	ASSERT(n    !=  NULL);
 	ASSERT(idx  !=  NULL);
 
+	if(Index_Type(idx) == IDX_VECTOR) {
+		_Index_IndexNodeVector(idx, n);
+		return;
+	}
+
 	EntityID key             = ENTITY_GET_ID(n);
 	RSDoc    *doc            = NULL;
 	RSIndex  *rsIdx          = Index_RSIndex(idx);
@@ -52,8 +81,14 @@ void Index_RemoveNode
 	ASSERT(n   != NULL);
 	ASSERT(idx != NULL);
 
-	EntityID id     = ENTITY_GET_ID(n);
-	RSIndex  *rsIdx = Index_RSIndex(idx);
+	EntityID id = ENTITY_GET_ID(n);
+
+	if(Index_Type(idx) == IDX_VECTOR) {
+		HNSW_Remove(Index_HNSW(idx), id);
+		return;
+	}
+
+	RSIndex *rsIdx = Index_RSIndex(idx);
 
 	RediSearch_DeleteDocument(rsIdx, &id, sizeof(EntityID));
 }
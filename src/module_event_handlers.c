@@ -15,6 +15,7 @@
 #include "util/redis_version.h"
 #include "graph/graphcontext.h"
 #include "configuration/config.h"
+#include "commands/cache_warmup.h"
 #include "serializers/graphmeta_type.h"
 #include "serializers/graphcontext_type.h"
 
@@ -362,6 +363,23 @@ static void _ShutdownEventHandler
 	Globals_Free();
 }
 
+// server loading event handler
+// cached queries restored while loading are planned once loading ends
+// such that warm-up doesn't compete with, nor observe, a partial keyspace
+static void _LoadingEventHandler
+(
+	RedisModuleCtx *ctx,
+	RedisModuleEvent eid,
+	uint64_t subevent,
+	void *data
+) {
+	if(subevent == REDISMODULE_SUBEVENT_LOADING_ENDED) {
+		CacheWarmup_SchedulePending();
+	} else if(subevent == REDISMODULE_SUBEVENT_LOADING_FAILED) {
+		CacheWarmup_DiscardPending();
+	}
+}
+
 static void _ModuleLoadedHandler
 (
 	RedisModuleCtx *ctx,
@@ -396,6 +414,11 @@ static void _RegisterServerEvents(RedisModuleCtx *ctx) {
 			_PersistenceEventHandler);
 	ASSERT(res == REDISMODULE_OK);
 
+	res = RedisModule_SubscribeToServerEvent(ctx,
+			RedisModuleEvent_Loading,
+			_LoadingEventHandler);
+	ASSERT(res == REDISMODULE_OK);
+
 	// TODO: try to use RedisModuleEvent_ModuleChange to start cron
 	//res = RedisModule_SubscribeToServerEvent(ctx,
 	//		RedisModuleEvent_ModuleChange,
@@ -16,7 +16,7 @@
 #include "../datatypes/datatypes.h"
 
 //------------------------------------------------------------------------------
-// fulltext createNodeIndex
+// fulltext createNodeIndex / createRelationshipIndex
 //------------------------------------------------------------------------------
 
 // validate index configuration map
@@ -26,6 +26,7 @@
 // configuration can't change if index exists 
 static ProcedureResult _validateIndexConfigMap
 (
+	SchemaType schema_type,
 	SIValue config
 ) {
 	SIValue sw;
@@ -45,7 +46,7 @@ static ProcedureResult _validateIndexConfigMap
 	if(multi_config) {
 		GraphContext *gc = QueryCtx_GetGraphCtx();
 		Index idx = GraphContext_GetIndex(gc, label.stringval, NULL, 0,
-				IDX_FULLTEXT, SCHEMA_NODE);
+				IDX_FULLTEXT, schema_type);
 		if(idx != NULL) {
 			ErrorCtx_SetError(EMSG_INDEX_ALREADY_EXISTS);
 			return PROCEDURE_ERR;
@@ -98,6 +99,7 @@ static ProcedureResult _validateIndexConfigMap
 // configuration can't change if index exists 
 static ProcedureResult _validateFieldConfigMap
 (
+	SchemaType schema_type,
 	const char *label,
 	SIValue config
 ) {
@@ -151,7 +153,7 @@ static ProcedureResult _validateFieldConfigMap
 		GraphContext *gc = QueryCtx_GetGraphCtx();
 		Attribute_ID fieldID = GraphContext_GetAttributeID(gc, field.stringval);
 		Index idx = GraphContext_GetIndex(gc, label, &fieldID, 1, IDX_FULLTEXT,
-				SCHEMA_NODE);
+				schema_type);
 		if(idx != NULL) {
 			ErrorCtx_SetError(EMSG_INDEX_ALREADY_EXISTS);
 			return PROCEDURE_ERR;
@@ -165,11 +167,11 @@ static ProcedureResult _validateFieldConfigMap
 // CALL db.idx.fulltext.createNodeIndex('book', 'title', 'authors')
 // CALL db.idx.fulltext.createNodeIndex({label:'L', stopwords:['The']}, 'v')
 // CALL db.idx.fulltext.createNodeIndex('L', {field:'v', weight:2.1})
-ProcedureResult Proc_FulltextCreateNodeIdxInvoke
+// CALL db.idx.fulltext.createRelationshipIndex('R', 'v')
+static ProcedureResult _createFulltextIndex
 (
-	ProcedureCtx *ctx,
-	const SIValue *args,
-	const char **yield
+	SchemaType schema_type,
+	const SIValue *args
 ) {
 	uint arg_count = array_len((SIValue *)args);
 	if(arg_count < 2) {
@@ -183,7 +185,7 @@ ProcedureResult Proc_FulltextCreateNodeIdxInvoke
 		return PROCEDURE_ERR;
 	}
 	if(SI_TYPE(args[0]) == T_MAP &&
-			_validateIndexConfigMap(args[0]) == PROCEDURE_ERR) {
+			_validateIndexConfigMap(schema_type, args[0]) == PROCEDURE_ERR) {
 		return PROCEDURE_ERR;
 	}
 
@@ -205,7 +207,7 @@ ProcedureResult Proc_FulltextCreateNodeIdxInvoke
 			return PROCEDURE_ERR;
 		}
 		if(SI_TYPE(args[i]) == T_MAP &&
-			_validateFieldConfigMap(label, args[i]) == PROCEDURE_ERR) {
+			_validateFieldConfigMap(schema_type, label, args[i]) == PROCEDURE_ERR) {
 			return PROCEDURE_ERR;
 		}
 	}
@@ -270,18 +272,36 @@ ProcedureResult Proc_FulltextCreateNodeIdxInvoke
 		}
 	}
 
-	res = GraphContext_AddFullTextIndex(&idx, gc, label, _fields, fields_count,
-			weights, nostems, phonetics, stopwords, language);
+	res = GraphContext_AddFullTextIndex(&idx, gc, schema_type, label, _fields,
+			fields_count, weights, nostems, phonetics, stopwords, language);
 
 	// build index
 	if(res) {
-		Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+		Schema *s = GraphContext_GetSchema(gc, label, schema_type);
 		Indexer_PopulateIndex(gc, s, idx);
 	}
 
 	return PROCEDURE_OK;
 }
 
+ProcedureResult Proc_FulltextCreateNodeIdxInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _createFulltextIndex(SCHEMA_NODE, args);
+}
+
+ProcedureResult Proc_FulltextCreateRelationshipIdxInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _createFulltextIndex(SCHEMA_EDGE, args);
+}
+
 SIValue *Proc_FulltextCreateNodeIdxStep(ProcedureCtx *ctx) {
 	return NULL;
 }
@@ -298,3 +318,11 @@ ProcedureCtx *Proc_FulltextCreateNodeIdxGen() {
 			Proc_FulltextCreateNodeIdxFree, NULL, false);
 }
 
+ProcedureCtx *Proc_FulltextCreateRelationshipIdxGen() {
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	return ProcCtxNew("db.idx.fulltext.createRelationshipIndex",
+			PROCEDURE_VARIABLE_ARG_COUNT, output,
+			Proc_FulltextCreateNodeIdxStep,
+			Proc_FulltextCreateRelationshipIdxInvoke,
+			Proc_FulltextCreateNodeIdxFree, NULL, false);
+}
@@ -9,3 +9,4 @@
 #include "proc_ctx.h"
 
 ProcedureCtx *Proc_FulltextCreateNodeIdxGen();
+ProcedureCtx *Proc_FulltextCreateRelationshipIdxGen();
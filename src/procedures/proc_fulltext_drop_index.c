@@ -19,12 +19,12 @@
 
 // CALL db.idx.fulltext.drop(label)
 // CALL db.idx.fulltext.drop('books')
+// CALL db.idx.fulltext.dropRelationshipIndex(relationType)
 
-ProcedureResult Proc_FulltextDropIndexInvoke
+static ProcedureResult _dropFulltextIndex
 (
-	ProcedureCtx *ctx,
-	const SIValue *args,
-	const char **yield
+	SchemaType schema_type,
+	const SIValue *args
 ) {
 	// argument validations
 	// expecting arg[0] to be a string
@@ -38,7 +38,7 @@ ProcedureResult Proc_FulltextDropIndexInvoke
 
 	const char *l = args[0].stringval;
 	GraphContext *gc = QueryCtx_GetGraphCtx();
-	int res = GraphContext_DeleteIndex(gc, SCHEMA_NODE, l, NULL, IDX_FULLTEXT);
+	int res = GraphContext_DeleteIndex(gc, schema_type, l, NULL, IDX_FULLTEXT);
 
 	if(res != INDEX_OK) {
 		ErrorCtx_SetError(EMSG_FULLTEXT_DROP_INDEX, l);
@@ -47,6 +47,24 @@ ProcedureResult Proc_FulltextDropIndexInvoke
 	return PROCEDURE_OK;
 }
 
+ProcedureResult Proc_FulltextDropIndexInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _dropFulltextIndex(SCHEMA_NODE, args);
+}
+
+ProcedureResult Proc_FulltextDropRelationshipIndexInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _dropFulltextIndex(SCHEMA_EDGE, args);
+}
+
 SIValue *Proc_FulltextDropIndexStep
 (
 	ProcedureCtx *ctx
@@ -77,3 +95,17 @@ ProcedureCtx *Proc_FulltextDropIdxGen() {
 	return ctx;
 }
 
+ProcedureCtx *Proc_FulltextDropRelationshipIdxGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.idx.fulltext.dropRelationshipIndex",
+								   1,
+								   output,
+								   Proc_FulltextDropIndexStep,
+								   Proc_FulltextDropRelationshipIndexInvoke,
+								   Proc_FulltextDropIndexFree,
+								   privateData,
+								   false);
+
+	return ctx;
+}
@@ -9,3 +9,4 @@
 #include "proc_ctx.h"
 
 ProcedureCtx *Proc_FulltextDropIdxGen();
+ProcedureCtx *Proc_FulltextDropRelationshipIdxGen();
@@ -13,35 +13,59 @@
 #include "../util/rmalloc.h"
 #include "../errors/errors.h"
 #include "../graph/graphcontext.h"
+#include "../datatypes/datatypes.h"
+
+#include <stdlib.h>
 
 //------------------------------------------------------------------------------
-// fulltext createNodeIndex
+// fulltext queryNodes / queryRelationships
 //------------------------------------------------------------------------------
 
 // CALL db.idx.fulltext.queryNodes(label, query)
+// CALL db.idx.fulltext.queryNodes(label, query, {limit: 10, offset: 0})
+// CALL db.idx.fulltext.queryRelationships(relationType, query)
+// CALL db.idx.fulltext.queryRelationships(relationType, query, {limit: 10})
+//
+// without a limit or an offset hits are streamed in index order
+// otherwise only the 'offset + limit' highest scoring hits are retained
+// and yielded by descending score, skipping the first 'offset' hits
+
+// a single full-text hit
+typedef struct {
+	EntityID id;       // node / edge id
+	NodeID src_id;     // edge source node id
+	NodeID dest_id;    // edge destination node id
+	double score;      // hit score
+} FulltextHit;
 
 typedef struct {
-	Node n;
-	Graph *g;
-	SIValue *output;
-	Index idx;
-	RSResultsIterator *iter;
-	SIValue *yield_node;     // yield node
-	SIValue *yield_score;    // yield score
-} QueryNodeContext;
+	Node n;                   // yielded node
+	Edge e;                   // yielded edge
+	Graph *g;                 // graph
+	Index idx;                // queried index
+	SchemaType type;          // type of indexed entities
+	SIValue *output;          // procedure output
+	RSResultsIterator *iter;  // index results iterator
+	FulltextHit *hits;        // ranked hits, NULL when streaming
+	uint64_t hit_idx;         // next ranked hit to yield
+	SIValue *yield_entity;    // yield node / relationship
+	SIValue *yield_score;     // yield score
+} FulltextQueryContext;
 
 static void _process_yield
 (
-	QueryNodeContext *ctx,
+	FulltextQueryContext *ctx,
 	const char **yield
 ) {
-	ctx->yield_node   =    NULL;
-	ctx->yield_score  =    NULL;
+	ctx->yield_entity  =  NULL;
+	ctx->yield_score   =  NULL;
+
+	const char *entity = (ctx->type == SCHEMA_NODE) ? "node" : "relationship";
 
 	int idx = 0;
 	for(uint i = 0; i < array_len(yield); i++) {
-		if(strcasecmp("node", yield[i]) == 0) {
-			ctx->yield_node = ctx->output + idx;
+		if(strcasecmp(entity, yield[i]) == 0) {
+			ctx->yield_entity = ctx->output + idx;
 			idx++;
 			continue;
 		}
@@ -54,15 +78,172 @@ static void _process_yield
 	}
 }
 
-ProcedureResult Proc_FulltextQueryNodeInvoke
+// parse query options
+// [optional] limit <non-negative integer>
+// [optional] offset <non-negative integer>
+static bool _parse_options
+(
+	SIValue options,   // options map
+	uint64_t *limit,   // [output] maximum number of hits to yield
+	uint64_t *offset,  // [output] number of top hits to skip
+	bool *ranked       // [output] hits should be ranked
+) {
+	if(SI_TYPE(options) != T_MAP) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "options", "a map");
+		return false;
+	}
+
+	SIValue v;
+	if(MAP_GET(options, "limit", v)) {
+		if(SI_TYPE(v) != T_INT64 || v.longval < 0) {
+			ErrorCtx_SetError(EMSG_MUST_BE_NON_NEGATIVE, "limit");
+			return false;
+		}
+		*limit  = v.longval;
+		*ranked = true;
+	}
+
+	if(MAP_GET(options, "offset", v)) {
+		if(SI_TYPE(v) != T_INT64 || v.longval < 0) {
+			ErrorCtx_SetError(EMSG_MUST_BE_NON_NEGATIVE, "offset");
+			return false;
+		}
+		*offset = v.longval;
+		*ranked = true;
+	}
+
+	return true;
+}
+
+// pull the next hit out of the index results iterator
+// returns false if the iterator is depleted
+static bool _next_hit
+(
+	FulltextQueryContext *pdata,  // procedure context
+	FulltextHit *hit              // [output] hit
+) {
+	const void *key = RediSearch_ResultsIteratorNext(pdata->iter,
+			Index_RSIndex(pdata->idx), NULL);
+
+	// depleted
+	if(key == NULL) return false;
+
+	if(pdata->type == SCHEMA_NODE) {
+		hit->id = *(NodeID *)key;
+	} else {
+		const EdgeIndexKey *edge_key = (const EdgeIndexKey *)key;
+		hit->id      = edge_key->edge_id;
+		hit->src_id  = edge_key->src_id;
+		hit->dest_id = edge_key->dest_id;
+	}
+
+	hit->score = RediSearch_ResultsIteratorGetScore(pdata->iter);
+	return true;
+}
+
+// restore min-heap property, moving hits[i] towards the leaves
+static void _sift_down
+(
+	FulltextHit *hits,  // min-heap ordered by score
+	uint64_t n,         // number of hits in heap
+	uint64_t i          // position to sift
+) {
+	while(true) {
+		uint64_t min   = i;
+		uint64_t left  = 2 * i + 1;
+		uint64_t right = 2 * i + 2;
+
+		if(left  < n && hits[left].score  < hits[min].score) min = left;
+		if(right < n && hits[right].score < hits[min].score) min = right;
+		if(min == i) return;
+
+		FulltextHit tmp = hits[i];
+		hits[i]   = hits[min];
+		hits[min] = tmp;
+		i = min;
+	}
+}
+
+// restore min-heap property, moving hits[i] towards the root
+static void _sift_up
+(
+	FulltextHit *hits,  // min-heap ordered by score
+	uint64_t i          // position to sift
+) {
+	while(i > 0) {
+		uint64_t parent = (i - 1) / 2;
+		if(hits[parent].score <= hits[i].score) return;
+
+		FulltextHit tmp = hits[i];
+		hits[i]      = hits[parent];
+		hits[parent] = tmp;
+		i = parent;
+	}
+}
+
+// order hits by descending score
+static int _hit_cmp
+(
+	const void *a,
+	const void *b
+) {
+	double sa = ((const FulltextHit *)a)->score;
+	double sb = ((const FulltextHit *)b)->score;
+	return (sa < sb) - (sa > sb);
+}
+
+// drain the index results iterator retaining the 'k' highest scoring hits
+// using a bounded min-heap, hits are then ordered by descending score
+static FulltextHit *_rank_hits
+(
+	FulltextQueryContext *pdata,  // procedure context
+	uint64_t k                    // number of hits to retain
+) {
+	FulltextHit hit;
+	FulltextHit *hits = array_new(FulltextHit, 0);
+
+	if(k > 0) {
+		while(_next_hit(pdata, &hit)) {
+			uint64_t n = array_len(hits);
+			if(n < k) {
+				array_append(hits, hit);
+				_sift_up(hits, n);
+			} else if(hit.score > hits[0].score) {
+				// replace lowest scoring hit
+				hits[0] = hit;
+				_sift_down(hits, n, 0);
+			}
+		}
+	}
+
+	qsort(hits, array_len(hits), sizeof(FulltextHit), _hit_cmp);
+
+	return hits;
+}
+
+static ProcedureResult _fulltext_query_invoke
 (
 	ProcedureCtx *ctx,
 	const SIValue *args,
-	const char **yield
+	const char **yield,
+	SchemaType type
 ) {
-	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+	uint argc = array_len((SIValue *)args);
+	if(argc < 2 || argc > 3) {
+		ErrorCtx_SetError(EMSG_PROCEDURE_INVALID_ARGUMENTS, ctx->name,
+				(argc < 2) ? 2 : 3, argc);
+		return PROCEDURE_ERR;
+	}
+
 	if(!(SI_TYPE(args[0]) & SI_TYPE(args[1]) & T_STRING)) return PROCEDURE_ERR;
 
+	bool     ranked = false;
+	uint64_t limit  = UINT64_MAX;
+	uint64_t offset = 0;
+	if(argc == 3 && !_parse_options(args[2], &limit, &offset, &ranked)) {
+		return PROCEDURE_ERR;
+	}
+
 	ctx->privateData = NULL;
 	GraphContext *gc = QueryCtx_GetGraphCtx();
 
@@ -72,17 +253,24 @@ ProcedureResult Proc_FulltextQueryNodeInvoke
 	const char *query = args[1].stringval;
 
 	// get full-text index from schema
-	Index idx = GraphContext_GetIndex(gc, label, NULL, 0, IDX_FULLTEXT,
-			SCHEMA_NODE);
+	Index idx = GraphContext_GetIndex(gc, label, NULL, 0, IDX_FULLTEXT, type);
 	if(!idx) return PROCEDURE_ERR; // TODO: this should cause an error to be emitted
 
-	ctx->privateData = rm_malloc(sizeof(QueryNodeContext));
-	QueryNodeContext *pdata = ctx->privateData;
+	ctx->privateData = rm_malloc(sizeof(FulltextQueryContext));
+	FulltextQueryContext *pdata = ctx->privateData;
+
+	pdata->g       = gc->g;
+	pdata->n       = GE_NEW_NODE();
+	pdata->idx     = idx;
+	pdata->type    = type;
+	pdata->hits    = NULL;
+	pdata->hit_idx = 0;
+	pdata->output  = array_new(SIValue, 2);
 
-	pdata->g      = gc->g;
-	pdata->n      = GE_NEW_NODE();
-	pdata->idx    = idx;
-	pdata->output = array_new(SIValue,  2);
+	if(type == SCHEMA_EDGE) {
+		Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_EDGE);
+		pdata->e = GE_NEW_LABELED_EDGE(Schema_GetName(s), Schema_GetID(s));
+	}
 
 	_process_yield(pdata, yield);
 
@@ -103,48 +291,84 @@ ProcedureResult Proc_FulltextQueryNodeInvoke
 
 	ASSERT(pdata->iter != NULL);
 
+	if(ranked) {
+		// retain top hits, saturate on overflow
+		uint64_t k = (limit > UINT64_MAX - offset) ? UINT64_MAX : limit + offset;
+		pdata->hits    = _rank_hits(pdata, k);
+		pdata->hit_idx = offset;
+
+		// release index iterator as early as possible
+		RediSearch_ResultsIteratorFree(pdata->iter);
+		pdata->iter = NULL;
+	}
+
 	return PROCEDURE_OK;
 }
 
-SIValue *Proc_FulltextQueryNodeStep
+ProcedureResult Proc_FulltextQueryNodeInvoke
 (
-	ProcedureCtx *ctx
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
 ) {
-	if(!ctx->privateData) return NULL; // no index was attached to this procedure
+	return _fulltext_query_invoke(ctx, args, yield, SCHEMA_NODE);
+}
 
-	QueryNodeContext *pdata = (QueryNodeContext *)ctx->privateData;
-	if(!pdata || !pdata->iter) return NULL;
+ProcedureResult Proc_FulltextQueryRelationshipInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _fulltext_query_invoke(ctx, args, yield, SCHEMA_EDGE);
+}
 
-	// try to get a result out of the iterator
-	// NULL is returned if iterator id depleted
-	size_t len = 0;
-	NodeID *id = (NodeID *)RediSearch_ResultsIteratorNext(pdata->iter,
-			Index_RSIndex(pdata->idx), &len);
+SIValue *Proc_FulltextQueryStep
+(
+	ProcedureCtx *ctx
+) {
+	if(!ctx->privateData) return NULL; // no index was attached to this procedure
 
-	// depleted
-	if(!id) return NULL;
+	FulltextQueryContext *pdata = (FulltextQueryContext *)ctx->privateData;
 
-	double score = RediSearch_ResultsIteratorGetScore(pdata->iter);
+	// get next hit, either ranked or streamed from the index
+	FulltextHit hit;
+	if(pdata->hits != NULL) {
+		if(pdata->hit_idx >= array_len(pdata->hits)) return NULL; // depleted
+		hit = pdata->hits[pdata->hit_idx++];
+	} else {
+		if(!pdata->iter || !_next_hit(pdata, &hit)) return NULL; // depleted
+	}
 
-	// get node
-	Node *n = &pdata->n;
-	Graph_GetNode(pdata->g, *id, n);
+	if(pdata->type == SCHEMA_NODE) {
+		// get node
+		Node *n = &pdata->n;
+		Graph_GetNode(pdata->g, hit.id, n);
+		if(pdata->yield_entity) *pdata->yield_entity = SI_Node(n);
+	} else {
+		// get edge
+		Edge *e = &pdata->e;
+		e->src_id  = hit.src_id;
+		e->dest_id = hit.dest_id;
+		Graph_GetEdge(pdata->g, hit.id, e);
+		if(pdata->yield_entity) *pdata->yield_entity = SI_Edge(e);
+	}
 
-	if(pdata->yield_node)  *pdata->yield_node  = SI_Node(n);
-	if(pdata->yield_score) *pdata->yield_score = SI_DoubleVal(score);
+	if(pdata->yield_score) *pdata->yield_score = SI_DoubleVal(hit.score);
 
 	return pdata->output;
 }
 
-ProcedureResult Proc_FulltextQueryNodeFree
+ProcedureResult Proc_FulltextQueryFree
 (
 	ProcedureCtx *ctx
 ) {
 	// Clean up.
 	if(!ctx->privateData) return PROCEDURE_OK;
 
-	QueryNodeContext *pdata = ctx->privateData;
+	FulltextQueryContext *pdata = ctx->privateData;
 	array_free(pdata->output);
+	if(pdata->hits) array_free(pdata->hits);
 	if(pdata->iter) RediSearch_ResultsIteratorFree(pdata->iter);
 	rm_free(pdata);
 
@@ -160,11 +384,30 @@ ProcedureCtx *Proc_FulltextQueryNodeGen() {
 	array_append(output, out_score);
 
 	ProcedureCtx *ctx = ProcCtxNew("db.idx.fulltext.queryNodes",
-								   2,
+								   PROCEDURE_VARIABLE_ARG_COUNT,
 								   output,
-								   Proc_FulltextQueryNodeStep,
+								   Proc_FulltextQueryStep,
 								   Proc_FulltextQueryNodeInvoke,
-								   Proc_FulltextQueryNodeFree,
+								   Proc_FulltextQueryFree,
+								   privateData,
+								   true);
+	return ctx;
+}
+
+ProcedureCtx *Proc_FulltextQueryRelationshipGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output   = array_new(ProcedureOutput, 2);
+	ProcedureOutput out_edge  = {.name = "relationship", .type = T_EDGE};
+	ProcedureOutput out_score = {.name = "score", .type = T_DOUBLE};
+	array_append(output, out_edge);
+	array_append(output, out_score);
+
+	ProcedureCtx *ctx = ProcCtxNew("db.idx.fulltext.queryRelationships",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   output,
+								   Proc_FulltextQueryStep,
+								   Proc_FulltextQueryRelationshipInvoke,
+								   Proc_FulltextQueryFree,
 								   privateData,
 								   true);
 	return ctx;
@@ -0,0 +1,207 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_label_propagation.h"
+#include "../RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../errors/errors.h"
+#include "../datatypes/datatypes.h"
+#include "../algorithms/label_propagation.h"
+#include "shared/projection.h"
+
+// CALL algo.labelPropagation(NULL, NULL) YIELD node, communityId
+// CALL algo.labelPropagation('User', 'FOLLOWS', {maxIterations: 10})
+// YIELD node, communityId
+//
+// detects communities using label propagation, edge direction is ignored
+// labels and relationship types can be specified as a list
+// in which case the graph is the union of the listed labels/relationships
+// each community is identified by the ID of one of its nodes
+
+typedef struct {
+	Node node;                   // current node
+	GrB_Vector communities;      // community of each row
+	GrB_Index *mapping;          // row to node ID mapping
+	ProjectionIterator iter;     // result iterator
+	bool iterating;              // iterator initialized
+	SIValue *output;             // array with up to 2 entries
+	SIValue *yield_node;         // yield node
+	SIValue *yield_community;    // yield community ID
+} LabelPropagationContext;
+
+static void _process_yield
+(
+	LabelPropagationContext *ctx,
+	const char **yield
+) {
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("node", yield[i]) == 0) {
+			ctx->yield_node = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("communityId", yield[i]) == 0) {
+			ctx->yield_community = ctx->output + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+// validate configuration map
+static bool _parse_config
+(
+	SIValue config,      // configuration map
+	int *max_iterations  // [output] maximum number of iterations
+) {
+	if(SI_TYPE(config) != T_MAP) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "configuration", "a map");
+		return false;
+	}
+
+	SIValue v;
+	if(MAP_GET(config, "maxIterations", v)) {
+		if(SI_TYPE(v) != T_INT64 || v.longval <= 0) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "maxIterations",
+					"a positive integer");
+			return false;
+		}
+		*max_iterations = v.longval;
+	}
+
+	return true;
+}
+
+ProcedureResult Proc_LabelPropagationInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	uint argc = array_len((SIValue *)args);
+
+	// expecting 2 or 3 arguments
+	if(argc < 2 || argc > 3) return PROCEDURE_ERR;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	Graph *g = QueryCtx_GetGraph();
+
+	// setup context
+	LabelPropagationContext *pdata = rm_calloc(1, sizeof(LabelPropagationContext));
+	pdata->node   = GE_NEW_NODE();
+	pdata->output = array_new(SIValue, 2);
+	_process_yield(pdata, yield);
+
+	ctx->privateData = pdata;
+
+	int  *labels    = NULL;
+	int  *relations = NULL;
+	bool empty      = false;
+
+	if(!Projection_ResolveSchemas(args[0], SCHEMA_NODE, &labels, &empty) ||
+	   !Projection_ResolveSchemas(args[1], SCHEMA_EDGE, &relations, &empty)) {
+		if(labels) array_free(labels);
+		return PROCEDURE_ERR;
+	}
+
+	int max_iterations = 10;
+	if(argc == 3 && !_parse_config(args[2], &max_iterations)) {
+		if(labels)    array_free(labels);
+		if(relations) array_free(relations);
+		return PROCEDURE_ERR;
+	}
+
+	// unknown label/relation, quickly return
+	if(!empty) {
+		GrB_Index n;
+		GrB_Matrix A = Projection_BuildMatrix(g, labels, relations, &n,
+				&pdata->mapping);
+		Projection_Undirected(A);
+
+		int iterations;
+		info = LabelPropagation(&pdata->communities, A, max_iterations,
+				&iterations);
+		ASSERT(info == GrB_SUCCESS);
+
+		ProjectionIterator_Init(&pdata->iter, g, pdata->communities,
+				pdata->mapping);
+		pdata->iterating = true;
+
+		GrB_free(&A);
+	}
+
+	if(labels)    array_free(labels);
+	if(relations) array_free(relations);
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_LabelPropagationStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData);
+
+	LabelPropagationContext *pdata = (LabelPropagationContext *)ctx->privateData;
+
+	GrB_Index community;
+	if(!pdata->iterating ||
+	   !ProjectionIterator_Next(&pdata->iter, &pdata->node, NULL, &community)) {
+		return NULL;
+	}
+
+	if(pdata->yield_node) *pdata->yield_node = SI_Node(&pdata->node);
+	if(pdata->yield_community) {
+		*pdata->yield_community =
+			SI_LongVal(Projection_RowNode(community, pdata->mapping));
+	}
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_LabelPropagationFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(ctx->privateData) {
+		LabelPropagationContext *pdata = ctx->privateData;
+		if(pdata->iterating)   ProjectionIterator_Free(&pdata->iter);
+		if(pdata->communities) GrB_free(&pdata->communities);
+		if(pdata->output)      array_free(pdata->output);
+		if(pdata->mapping)     rm_free(pdata->mapping);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_LabelPropagationCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
+	ProcedureOutput output_community = {.name = "communityId", .type = T_INT64};
+	array_append(outputs, output_node);
+	array_append(outputs, output_community);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.labelPropagation",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   outputs,
+								   Proc_LabelPropagationStep,
+								   Proc_LabelPropagationInvoke,
+								   Proc_LabelPropagationFree,
+								   privateData,
+								   true);
+	return ctx;
+}
+
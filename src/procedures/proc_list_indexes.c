@@ -126,7 +126,7 @@ ProcedureResult Proc_IndexesInvoke
 	unsigned short n;            // number of schemas
 	Schema         *s;           // current schema
 	unsigned short idx_count;    // number of indicies in schema
-	Index          indicies[4];  // schema indicies
+	Index          indicies[6];  // schema indicies
 
 	// collect indices from node schemas
 	n = GraphContext_SchemaCount(gc, SCHEMA_NODE);
@@ -191,6 +191,8 @@ static bool _EmitIndex
 	if(ctx->yield_type != NULL) {
 		if(Index_Type(idx) == IDX_EXACT_MATCH) {
 			*ctx->yield_type = SI_ConstStringVal("exact-match");
+		} else if(Index_Type(idx) == IDX_VECTOR) {
+			*ctx->yield_type = SI_ConstStringVal("vector");
 		} else {
 			*ctx->yield_type = SI_ConstStringVal("full-text");
 		}
@@ -224,8 +226,13 @@ static bool _EmitIndex
 	//--------------------------------------------------------------------------
 
 	if(ctx->yield_language) {
-		*ctx->yield_language =
-			SI_ConstStringVal((char *)Index_GetLanguage(idx));
+		// vector indices are language agnostic
+		if(Index_Type(idx) == IDX_VECTOR) {
+			*ctx->yield_language = SI_NullVal();
+		} else {
+			*ctx->yield_language =
+				SI_ConstStringVal((char *)Index_GetLanguage(idx));
+		}
 	}
 
 	//--------------------------------------------------------------------------
@@ -234,7 +241,9 @@ static bool _EmitIndex
 
 	if(ctx->yield_stopwords) {
 		size_t stopwords_count;
-		char **stopwords = Index_GetStopwords(idx, &stopwords_count);
+		char **stopwords = (Index_Type(idx) == IDX_VECTOR)
+			? NULL
+			: Index_GetStopwords(idx, &stopwords_count);
 		if(stopwords) {
 			*ctx->yield_stopwords = SI_Array(stopwords_count);
 			for(size_t i = 0; i < stopwords_count; i++) {
@@ -252,7 +261,21 @@ static bool _EmitIndex
 	// index info
 	//--------------------------------------------------------------------------
 
-	if(ctx->yield_info) {
+	if(ctx->yield_info && Index_Type(idx) == IDX_VECTOR) {
+		const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+		const char *similarity = (opts->similarity == VECSIM_COSINE)
+			? "cosine"
+			: "euclidean";
+
+		SIValue map = SI_Map(5);
+		Map_Add(&map, SI_ConstStringVal("dimension"),      SI_LongVal(opts->dimension));
+		Map_Add(&map, SI_ConstStringVal("similarity"),     SI_ConstStringVal(similarity));
+		Map_Add(&map, SI_ConstStringVal("M"),              SI_LongVal(opts->M));
+		Map_Add(&map, SI_ConstStringVal("efConstruction"), SI_LongVal(opts->ef_construction));
+		Map_Add(&map, SI_ConstStringVal("numDocuments"),   SI_LongVal(HNSW_Size(Index_HNSW(idx))));
+
+		*ctx->yield_info = map;
+	} else if(ctx->yield_info) {
 		RSIdxInfo info = { .version = RS_INFO_CURRENT_VERSION };
 
 		RSIndex *rsIdx = Index_RSIndex(idx);
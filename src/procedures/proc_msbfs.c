@@ -0,0 +1,497 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "proc_msbfs.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../errors/errors.h"
+#include "../datatypes/array.h"
+#include "../graph/graph_hub.h"
+#include "../datatypes/datatypes.h"
+#include "../algorithms/msbfs.h"
+#include "shared/projection.h"
+
+// the MSBFS procedure performs a BFS scan from each of multiple sources
+// it's inputs are:
+// 1. list of source nodes to traverse from
+// 2. depth, how deep should the procedure traverse (0 no limit)
+// 3. relationship type(s) to traverse, (NULL for edge type agnostic)
+//
+// output, a row for each (source, reachable node) pair:
+// 1. source - source node
+// 2. node - node reachable from source
+// 3. level - number of hops from source to node
+//
+// MATCH (s:Seed) WITH collect(s) AS seeds
+// CALL algo.MSBFS(seeds, 3, 'R') YIELD source, node, level
+//
+// sources are traversed in batches, all traversals of a batch advance
+// together one level at a time, the relationship matrix is extracted once
+// and shared by all batches
+//
+// algo.MSBFS.write materializes each node's distance from the closest
+// source as a node attribute, returning a single row
+// nodes no longer reachable from any of the sources have the attribute
+// removed, refreshing a previously written attribute only updates nodes
+// whose distance changed
+//
+// MATCH (s:Seed) WITH collect(s) AS seeds
+// CALL algo.MSBFS.write(seeds, 0, 'R', {writeProperty: 'distance'})
+// YIELD nodes, reached
+
+#define MSBFS_BATCH_SIZE 1024
+
+typedef struct {
+	Graph *g;                // graph scanned
+	GrB_Matrix A;            // traversed matrix, shared by all batches
+	GrB_Matrix levels;       // levels of current batch
+	GxB_Iterator it;         // levels iterator
+	bool iterating;          // levels iterator has entries
+	NodeID *sources;         // source node IDs
+	GrB_Index batch;         // first source of current batch
+	GrB_Index next;          // first source of next batch
+	GrB_Index max_level;     // max level to reach, 0 for unlimited
+	Node source;             // current source
+	Node node;               // current node
+	SIValue *output;         // array with up to 3 entries
+	SIValue *yield_source;   // yield source node
+	SIValue *yield_node;     // yield reachable node
+	SIValue *yield_level;    // yield level
+	bool depleted;           // write mode, summary returned
+	uint64_t written;        // write mode, number of nodes updated
+	uint64_t reached;        // write mode, number of reached nodes
+	SIValue *yield_nodes;    // yield number of nodes updated
+	SIValue *yield_reached;  // yield number of reached nodes
+} MSBFSCtx;
+
+static void _process_yield
+(
+	MSBFSCtx *ctx,
+	const char **yield
+) {
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("source", yield[i]) == 0) {
+			ctx->yield_source = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("node", yield[i]) == 0) {
+			ctx->yield_node = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("level", yield[i]) == 0) {
+			ctx->yield_level = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("nodes", yield[i]) == 0) {
+			ctx->yield_nodes = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("reached", yield[i]) == 0) {
+			ctx->yield_reached = ctx->output + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+// traverse from the next batch of sources
+// returns false if all sources were traversed
+static bool _next_batch
+(
+	MSBFSCtx *ctx
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	if(ctx->it != NULL)     GrB_free(&ctx->it);
+	if(ctx->levels != NULL) GrB_free(&ctx->levels);
+
+	uint64_t n = array_len(ctx->sources);
+	if(ctx->next >= n) return false;
+
+	ctx->batch = ctx->next;
+	ctx->next  = ctx->batch + MSBFS_BATCH_SIZE;
+	if(ctx->next > n) ctx->next = n;
+
+	info = MSBFS(&ctx->levels, ctx->A, ctx->sources + ctx->batch,
+			ctx->next - ctx->batch, ctx->max_level);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_Iterator_new(&ctx->it);
+	ASSERT(info == GrB_SUCCESS);
+	info = GxB_Matrix_Iterator_attach(ctx->it, ctx->levels, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	ctx->iterating = (GxB_Matrix_Iterator_seek(ctx->it, 0) != GxB_EXHAUSTED);
+
+	return true;
+}
+
+// validate write mode configuration map
+// returns the attribute to write distances to, NULL on error
+static const char *_parse_write_config
+(
+	SIValue config  // configuration map
+) {
+	SIValue write_prop;
+
+	if(SI_TYPE(config) != T_MAP) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "configuration", "a map");
+		return NULL;
+	}
+
+	if(!MAP_GET(config, "writeProperty", write_prop)) {
+		ErrorCtx_SetError(EMSG_IS_MISSING, "writeProperty");
+		return NULL;
+	}
+
+	if(SI_TYPE(write_prop) != T_STRING) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "writeProperty", "a string");
+		return NULL;
+	}
+
+	return write_prop.stringval;
+}
+
+// write each node's distance from the closest source as attribute 'attr'
+// returns the number of nodes updated
+static uint64_t _write_distances
+(
+	MSBFSCtx *ctx,          // msbfs context
+	GrB_Vector distances,   // distance of each reached node
+	const char *attr,       // attribute name
+	uint64_t *reached       // [output] number of reached nodes
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	Graph *g             = ctx->g;
+	GraphContext *gc     = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = FindOrAddAttribute(gc, attr, true);
+	uint64_t written     = 0;
+
+	info = GrB_Vector_nvals(reached, distances);
+	ASSERT(info == GrB_SUCCESS);
+
+	MATRIX_POLICY policy = Graph_GetMatrixPolicy(g);
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_NOP);
+
+	// visit every node, such that unreachable nodes drop a stale distance
+	Node node = GE_NEW_NODE();
+	DataBlockIterator *it = Graph_ScanNodes(g);
+	while((node.attributes = DataBlockIterator_Next(it, &node.id)) != NULL) {
+		uint64_t d;
+		SIValue v = SI_NullVal();
+		if(GrB_Vector_extractElement_UINT64(&d, distances, node.id) ==
+				GrB_SUCCESS) {
+			v = SI_LongVal(d);
+		}
+
+		if(Projection_WriteAttribute(&node, attr_id, v)) written++;
+	}
+	DataBlockIterator_Free(it);
+
+	Graph_SetMatrixPolicy(g, policy);
+
+	return written;
+}
+
+static ProcedureResult Proc_MSBFS_Invoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// validate inputs
+	ASSERT(ctx   !=  NULL);
+	ASSERT(args  !=  NULL);
+
+	if(array_len((SIValue *)args) != 3) return PROCEDURE_ERR;
+
+	if(SI_TYPE(args[0]) != T_ARRAY || !SIArray_AllOfType(args[0], T_NODE)) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "sources", "an array of nodes");
+		return PROCEDURE_ERR;
+	}
+
+	if(SI_TYPE(args[1]) != T_INT64 || args[1].longval < 0) {
+		ErrorCtx_SetError(EMSG_MUST_BE_NON_NEGATIVE, "max-level");
+		return PROCEDURE_ERR;
+	}
+
+	MSBFSCtx *pdata = ctx->privateData;
+	_process_yield(pdata, yield);
+
+	//--------------------------------------------------------------------------
+	// process inputs
+	//--------------------------------------------------------------------------
+
+	int *relations = NULL;
+	bool empty     = false;
+
+	if(!Projection_ResolveSchemas(args[2], SCHEMA_EDGE, &relations, &empty)) {
+		return PROCEDURE_ERR;
+	}
+
+	// unknown relationship type, first step will return NULL
+	uint32_t source_count = SIArray_Length(args[0]);
+	if(empty || source_count == 0) {
+		if(relations) array_free(relations);
+		return PROCEDURE_OK;
+	}
+
+	pdata->max_level = args[1].longval;
+	pdata->sources = array_new(NodeID, source_count);
+	for(uint32_t i = 0; i < source_count; i++) {
+		SIValue src = SIArray_Get(args[0], i);
+		array_append(pdata->sources, ENTITY_GET_ID((Node *)src.ptrval));
+	}
+
+	// all nodes are traversed, row i is node i
+	GrB_Index n;
+	GrB_Index *mapping;
+	pdata->A = Projection_BuildMatrix(pdata->g, NULL, relations, &n, &mapping);
+	ASSERT(mapping == NULL);
+
+	if(relations) array_free(relations);
+
+	_next_batch(pdata);
+
+	return PROCEDURE_OK;
+}
+
+static SIValue *Proc_MSBFS_Step
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData);
+
+	MSBFSCtx *pdata = (MSBFSCtx *)ctx->privateData;
+
+	// no sources
+	if(pdata->A == NULL) return NULL;
+
+	while(true) {
+		// current batch is exhausted, traverse from the next batch
+		while(!pdata->iterating) {
+			if(!_next_batch(pdata)) return NULL;
+		}
+
+		GrB_Index i;
+		GrB_Index j;
+		GxB_Matrix_Iterator_getIndex(pdata->it, &i, &j);
+		uint64_t level = GxB_Iterator_get_UINT64(pdata->it);
+
+		pdata->iterating =
+			(GxB_Matrix_Iterator_next(pdata->it) != GxB_EXHAUSTED);
+
+		// skip sources
+		if(level == 0) continue;
+
+		if(pdata->yield_source) {
+			Graph_GetNode(pdata->g, pdata->sources[pdata->batch + i],
+					&pdata->source);
+			*pdata->yield_source = SI_Node(&pdata->source);
+		}
+
+		if(pdata->yield_node) {
+			Graph_GetNode(pdata->g, j, &pdata->node);
+			*pdata->yield_node = SI_Node(&pdata->node);
+		}
+
+		if(pdata->yield_level) *pdata->yield_level = SI_LongVal(level);
+
+		return pdata->output;
+	}
+}
+
+static ProcedureResult Proc_MSBFS_WriteInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// validate inputs
+	ASSERT(ctx   !=  NULL);
+	ASSERT(args  !=  NULL);
+
+	if(array_len((SIValue *)args) != 4) return PROCEDURE_ERR;
+
+	if(SI_TYPE(args[0]) != T_ARRAY || !SIArray_AllOfType(args[0], T_NODE)) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "sources", "an array of nodes");
+		return PROCEDURE_ERR;
+	}
+
+	if(SI_TYPE(args[1]) != T_INT64 || args[1].longval < 0) {
+		ErrorCtx_SetError(EMSG_MUST_BE_NON_NEGATIVE, "max-level");
+		return PROCEDURE_ERR;
+	}
+
+	const char *write_prop = _parse_write_config(args[3]);
+	if(write_prop == NULL) return PROCEDURE_ERR;
+
+	MSBFSCtx *pdata = ctx->privateData;
+	_process_yield(pdata, yield);
+
+	int *relations = NULL;
+	bool empty     = false;
+
+	if(!Projection_ResolveSchemas(args[2], SCHEMA_EDGE, &relations, &empty)) {
+		return PROCEDURE_ERR;
+	}
+
+	// no sources or unknown relationship type
+	// nodes are reachable only from the sources themselves
+	uint32_t source_count = SIArray_Length(args[0]);
+	if(empty) {
+		if(relations) array_free(relations);
+		relations = array_new(int, 0);
+	}
+
+	GrB_Index n;
+	GrB_Index *mapping;
+	GrB_Matrix A = Projection_BuildMatrix(pdata->g, NULL, relations, &n,
+			&mapping);
+	ASSERT(mapping == NULL);
+
+	if(relations) array_free(relations);
+
+	GrB_Vector distances;
+	if(source_count > 0) {
+		GrB_Index *sources = rm_malloc(sizeof(GrB_Index) * source_count);
+		for(uint32_t i = 0; i < source_count; i++) {
+			SIValue src = SIArray_Get(args[0], i);
+			sources[i] = ENTITY_GET_ID((Node *)src.ptrval);
+		}
+
+		GrB_Info info = MSBFS_Distances(&distances, A, sources, source_count,
+				args[1].longval);
+		ASSERT(info == GrB_SUCCESS);
+		UNUSED(info);
+
+		rm_free(sources);
+	} else {
+		GrB_Info info = GrB_Vector_new(&distances, GrB_UINT64, n);
+		ASSERT(info == GrB_SUCCESS);
+		UNUSED(info);
+	}
+
+	pdata->written = _write_distances(pdata, distances, write_prop,
+			&pdata->reached);
+
+	GrB_free(&distances);
+	GrB_free(&A);
+
+	return PROCEDURE_OK;
+}
+
+static SIValue *Proc_MSBFS_WriteStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData);
+
+	MSBFSCtx *pdata = (MSBFSCtx *)ctx->privateData;
+
+	// a single summary row
+	if(pdata->depleted) return NULL;
+	pdata->depleted = true;
+
+	if(pdata->yield_nodes)   *pdata->yield_nodes   = SI_LongVal(pdata->written);
+	if(pdata->yield_reached) *pdata->yield_reached = SI_LongVal(pdata->reached);
+
+	return pdata->output;
+}
+
+static ProcedureResult Proc_MSBFS_Free
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx != NULL);
+
+	// free private data
+	MSBFSCtx *pdata = ctx->privateData;
+
+	if(pdata->it      !=  NULL)  GrB_free(&pdata->it);
+	if(pdata->A       !=  NULL)  GrB_Matrix_free(&pdata->A);
+	if(pdata->levels  !=  NULL)  GrB_Matrix_free(&pdata->levels);
+	if(pdata->output  !=  NULL)  array_free(pdata->output);
+	if(pdata->sources !=  NULL)  array_free(pdata->sources);
+
+	rm_free(ctx->privateData);
+
+	return PROCEDURE_OK;
+}
+
+static MSBFSCtx *_Build_Private_Data() {
+	// set up the MSBFS context
+	MSBFSCtx *pdata = rm_calloc(1, sizeof(MSBFSCtx));
+
+	pdata->g       =  QueryCtx_GetGraph();
+	pdata->node    =  GE_NEW_NODE();
+	pdata->source  =  GE_NEW_NODE();
+	pdata->output  =  array_new(SIValue, 3);
+
+	return pdata;
+}
+
+ProcedureCtx *Proc_MSBFS_Ctx() {
+	// construct procedure private data
+	void *privdata = _Build_Private_Data();
+
+	// declare possible outputs
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 3);
+	ProcedureOutput out_source = {.name = "source", .type = T_NODE};
+	ProcedureOutput out_node   = {.name = "node",   .type = T_NODE};
+	ProcedureOutput out_level  = {.name = "level",  .type = T_INT64};
+	array_append(outputs, out_source);
+	array_append(outputs, out_node);
+	array_append(outputs, out_level);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.MSBFS",
+								   3,
+								   outputs,
+								   Proc_MSBFS_Step,
+								   Proc_MSBFS_Invoke,
+								   Proc_MSBFS_Free,
+								   privdata,
+								   true);
+	return ctx;
+}
+
+
+ProcedureCtx *Proc_MSBFS_WriteCtx() {
+	// construct procedure private data
+	void *privdata = _Build_Private_Data();
+
+	// declare possible outputs
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput out_nodes   = {.name = "nodes",   .type = T_INT64};
+	ProcedureOutput out_reached = {.name = "reached", .type = T_INT64};
+	array_append(outputs, out_nodes);
+	array_append(outputs, out_reached);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.MSBFS.write",
+								   4,
+								   outputs,
+								   Proc_MSBFS_WriteStep,
+								   Proc_MSBFS_WriteInvoke,
+								   Proc_MSBFS_Free,
+								   privdata,
+								   false);
+	return ctx;
+}
@@ -10,26 +10,68 @@
 #include "../util/arr.h"
 #include "../query_ctx.h"
 #include "../util/rmalloc.h"
+#include "../errors/errors.h"
+#include "../graph/graph_hub.h"
 #include "../graph/graphcontext.h"
+#include "../datatypes/datatypes.h"
 #include "../algorithms/pagerank.h"
+#include "shared/projection.h"
 
 // CALL algo.pageRank(NULL, NULL)      YIELD node, score
 // CALL algo.pageRank('Page', NULL)    YIELD node, score
 // CALL algo.pageRank(NULL, 'LINKS')   YIELD node, score
 // CALL algo.pageRank('Page', 'LINKS') YIELD node, score
+//
+// labels and relationship types can be specified as a list
+// in which case the graph is the union of the listed labels/relationships
+// an optional configuration map controls the computation
+//
+// MATCH (seed:Page {title: 'Home'})
+// CALL algo.pageRank(['Page', 'Post'], ['LINKS', 'CITES'], {
+//     maxIterations: 50,         // max number of iterations
+//     tolerance:     0.0001,     // convergence tolerance
+//     dampingFactor: 0.85,       // damping factor
+//     sourceNodes:   [seed],     // personalized pagerank seed set
+//     seedProperty:  'rank'      // warm start from a previous ranking
+// }) YIELD node, score, iterations, delta
+//
+// algo.pageRank.write stores each node's score as a node attribute
+// returning a single row
+//
+// CALL algo.pageRank.write('Page', 'LINKS', {writeProperty: 'rank'})
+// YIELD nodes, iterations, delta
 
 typedef struct {
 	int n;                          // number of nodes to rank
 	int i;                          // current node to return
 	Graph *g;                       // graph
 	Node node;                      // node
+	bool write;                     // write scores back to the graph
+	bool depleted;                  // write mode, summary returned
+	int iterations;                 // number of iterations performed
+	double delta;                   // last iteration's delta
+	uint64_t written;               // number of nodes updated
 	GrB_Index *mapping;             // mapping between extracted matrix rows and node ids
 	LAGraph_PageRank *ranking;      // nodes ranking
-	SIValue *output;                // array with up to 2 entries [node, score]
+	SIValue *output;                // array with up to 4 entries
 	SIValue *yield_node;            // yield node
 	SIValue *yield_score;           // yield score
+	SIValue *yield_nodes;           // yield number of nodes written
+	SIValue *yield_iterations;      // yield number of iterations
+	SIValue *yield_delta;           // yield last iteration's delta
 } PagerankContext;
 
+// pagerank arguments
+typedef struct {
+	int *labels;                    // label IDs, NULL for all nodes
+	int *relations;                 // relation IDs, NULL for all relationships
+	bool empty;                     // none of the labels/relationships exist
+	SIValue source_nodes;           // personalization seed set
+	const char *seed_prop;          // warm start attribute
+	const char *write_prop;         // write back attribute
+	PagerankConfig config;          // algorithm configuration
+} PagerankArgs;
+
 static void _process_yield
 (
 	PagerankContext *ctx,
@@ -48,138 +90,361 @@ static void _process_yield
 			idx++;
 			continue;
 		}
+
+		if(strcasecmp("nodes", yield[i]) == 0) {
+			ctx->yield_nodes = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("iterations", yield[i]) == 0) {
+			ctx->yield_iterations = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("delta", yield[i]) == 0) {
+			ctx->yield_delta = ctx->output + idx;
+			idx++;
+			continue;
+		}
 	}
 }
 
-ProcedureResult Proc_PagerankInvoke
+// validate configuration map
+static bool _parse_config
+(
+	SIValue config,     // configuration map
+	PagerankArgs *args  // [output] pagerank arguments
+) {
+	SIValue max_iterations;
+	SIValue tolerance;
+	SIValue damping;
+	SIValue source_nodes;
+	SIValue seed_prop;
+	SIValue write_prop;
+
+	bool max_iterations_exists = MAP_GET(config, "maxIterations", max_iterations);
+	bool tolerance_exists      = MAP_GET(config, "tolerance",     tolerance);
+	bool damping_exists        = MAP_GET(config, "dampingFactor", damping);
+	bool source_nodes_exists   = MAP_GET(config, "sourceNodes",   source_nodes);
+	bool seed_prop_exists      = MAP_GET(config, "seedProperty",  seed_prop);
+	bool write_prop_exists     = MAP_GET(config, "writeProperty", write_prop);
+
+	if(max_iterations_exists) {
+		if(SI_TYPE(max_iterations) != T_INT64 || max_iterations.longval <= 0) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "maxIterations", "a positive integer");
+			return false;
+		}
+		args->config.itermax = max_iterations.longval;
+	}
+
+	if(tolerance_exists) {
+		if(!(SI_TYPE(tolerance) & SI_NUMERIC) ||
+		   SI_GET_NUMERIC(tolerance) <= 0) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "tolerance", "a positive number");
+			return false;
+		}
+		args->config.tol = SI_GET_NUMERIC(tolerance);
+	}
+
+	if(damping_exists) {
+		if(!(SI_TYPE(damping) & SI_NUMERIC) || SI_GET_NUMERIC(damping) <= 0 ||
+		   SI_GET_NUMERIC(damping) >= 1) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "dampingFactor",
+					"a number between 0 and 1");
+			return false;
+		}
+		args->config.damping = SI_GET_NUMERIC(damping);
+	}
+
+	if(source_nodes_exists) {
+		if(SI_TYPE(source_nodes) != T_ARRAY ||
+		   SIArray_Length(source_nodes) == 0 ||
+		   !SIArray_AllOfType(source_nodes, T_NODE)) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "sourceNodes",
+					"a non empty array of nodes");
+			return false;
+		}
+		args->source_nodes = source_nodes;
+	}
+
+	if(seed_prop_exists) {
+		if(SI_TYPE(seed_prop) != T_STRING) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "seedProperty", "a string");
+			return false;
+		}
+		args->seed_prop = seed_prop.stringval;
+	}
+
+	if(write_prop_exists) {
+		if(SI_TYPE(write_prop) != T_STRING) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "writeProperty", "a string");
+			return false;
+		}
+		args->write_prop = write_prop.stringval;
+	}
+
+	return true;
+}
+
+// validate procedure arguments
+static bool _parse_args
+(
+	const SIValue *args,  // procedure arguments
+	bool write,           // write mode
+	PagerankArgs *pargs   // [output] pagerank arguments
+) {
+	uint argc = array_len((SIValue *)args);
+
+	pargs->empty                  = false;
+	pargs->labels                 = NULL;
+	pargs->relations              = NULL;
+	pargs->seed_prop              = NULL;
+	pargs->write_prop             = NULL;
+	pargs->source_nodes           = SI_NullVal();
+	pargs->config.itermax         = 100;
+	pargs->config.tol             = 1e-4;
+	pargs->config.damping         = PAGERANK_DAMPING_DEFAULT;
+	pargs->config.init            = NULL;
+	pargs->config.personalization = NULL;
+
+	// expecting 2 or 3 arguments
+	if(argc < 2 || argc > 3) return false;
+
+	if(!Projection_ResolveSchemas(args[0], SCHEMA_NODE, &pargs->labels,
+				&pargs->empty) ||
+	   !Projection_ResolveSchemas(args[1], SCHEMA_EDGE, &pargs->relations,
+				&pargs->empty)) {
+		return false;
+	}
+
+	if(argc == 3) {
+		if(SI_TYPE(args[2]) != T_MAP) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "configuration", "a map");
+			return false;
+		}
+		if(!_parse_config(args[2], pargs)) return false;
+	}
+
+	if(write && pargs->write_prop == NULL) {
+		ErrorCtx_SetError(EMSG_IS_MISSING, "writeProperty");
+		return false;
+	}
+
+	return true;
+}
+
+// build the warm start vector from each node's 'attr' value
+static GrB_Vector _build_init
+(
+	Graph *g,            // graph
+	Attribute_ID attr,   // attribute holding the previous rank
+	GrB_Index n,         // number of rows
+	GrB_Index *mapping   // row to node ID mapping, NULL for identity
+) {
+	GrB_Info info;
+	GrB_Vector init;
+	UNUSED(info);
+
+	info = GrB_Vector_new(&init, GrB_FP64, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	Node node;
+	for(GrB_Index i = 0; i < n; i++) {
+		NodeID id = (mapping) ? mapping[i] : i;
+		if(!Graph_GetNode(g, id, &node)) continue;
+
+		SIValue *v = GraphEntity_GetProperty((GraphEntity *)&node, attr);
+		if(v == ATTRIBUTE_NOTFOUND || !(SI_TYPE(*v) & SI_NUMERIC)) continue;
+
+		// nodes without a previous positive rank start with the default rank
+		double rank = SI_GET_NUMERIC(*v);
+		if(rank <= 0) continue;
+
+		info = GrB_Vector_setElement_FP64(init, rank, i);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	return init;
+}
+
+// build the personalization vector, uniform over the seed nodes
+// returns NULL if none of the seed nodes are ranked
+static GrB_Vector _build_personalization
+(
+	SIValue seeds,       // array of seed nodes
+	GrB_Index n,         // number of rows
+	GrB_Index *mapping   // row to node ID mapping, NULL for identity
+) {
+	GrB_Info info;
+	GrB_Vector p;
+	UNUSED(info);
+
+	info = GrB_Vector_new(&p, GrB_FP32, n);
+	ASSERT(info == GrB_SUCCESS);
+
+	uint seed_count = SIArray_Length(seeds);
+	for(uint i = 0; i < seed_count; i++) {
+		SIValue seed = SIArray_Get(seeds, i);
+		NodeID id = ENTITY_GET_ID((Node *)seed.ptrval);
+		int64_t row = Projection_NodeRow(id, n, mapping);
+		if(row == -1) continue;
+
+		info = GrB_Vector_setElement_FP32(p, 1, row);
+		ASSERT(info == GrB_SUCCESS);
+	}
+
+	GrB_Index nvals;
+	info = GrB_Vector_nvals(&nvals, p);
+	ASSERT(info == GrB_SUCCESS);
+
+	if(nvals == 0) {
+		GrB_free(&p);
+		return NULL;
+	}
+
+	// p = p / |seeds|
+	info = GrB_Vector_apply_BinaryOp2nd_FP32(p, NULL, NULL, GrB_TIMES_FP32, p,
+			1.0 / nvals, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	return p;
+}
+
+// write each node's score as attribute 'attr'
+// returns the number of nodes whose score changed
+static uint64_t _write_scores
+(
+	PagerankContext *pdata,  // pagerank context
+	const char *attr         // attribute name
+) {
+	GraphContext *gc     = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = FindOrAddAttribute(gc, attr, true);
+	uint64_t written     = 0;
+
+	MATRIX_POLICY policy = Graph_GetMatrixPolicy(pdata->g);
+	Graph_SetMatrixPolicy(pdata->g, SYNC_POLICY_NOP);
+
+	Node node;
+	for(int i = 0; i < pdata->n; i++) {
+		LAGraph_PageRank rank = pdata->ranking[i];
+		NodeID id = Projection_RowNode(rank.page, pdata->mapping);
+		if(!Graph_GetNode(pdata->g, id, &node)) continue;
+
+		SIValue v = SI_DoubleVal(rank.pagerank);
+		if(Projection_WriteAttribute(&node, attr_id, v)) written++;
+	}
+
+	Graph_SetMatrixPolicy(pdata->g, policy);
+
+	return written;
+}
+
+static ProcedureResult _Proc_PagerankInvoke
 (
 	ProcedureCtx *ctx,
 	const SIValue *args,
-	const char **yield
+	const char **yield,
+	bool write
 ) {
-	// expecting 2 arguments
-	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
-
-	// arg0 and arg1 can be either String or NULL
-	SIType arg0_t = SI_TYPE(args[0]);
-	SIType arg1_t = SI_TYPE(args[1]);
-	if(!(arg0_t & (T_STRING | T_NULL))) return PROCEDURE_ERR;
-	if(!(arg1_t & (T_STRING | T_NULL))) return PROCEDURE_ERR;
-
-	// read arguments
-	const char *label = NULL;    // node filter
-	const char *relation = NULL; // edge filter
-	if(arg0_t == T_STRING) label = args[0].stringval;
-	if(arg1_t == T_STRING) relation = args[1].stringval;
-
-	// pagerank config arguments
-	int iters;               // iterations performed
-	const double tol = 1e-4; // tolerance
-	const int itermax = 100; // max iterations
-
 	GrB_Info info;
 	UNUSED(info);
 
-	GrB_Index n = 0;               // node count
-	GrB_Index nvals;               // number of entries in 'r'
-	GrB_Index nrows;               // relation matrix row count
-	Schema *s = NULL;
-	GrB_Matrix l = NULL;           // label matrix
-	GrB_Matrix r = NULL;           // relation matrix
-	GrB_Index *mapping = NULL;     // mapping, array for returning row indices of tuples
 	Graph *g = QueryCtx_GetGraph();
-	LAGraph_PageRank *ranking = NULL;
 	GraphContext *gc = QueryCtx_GetGraphCtx();
 
 	// setup context
-	PagerankContext *pdata = rm_malloc(sizeof(PagerankContext));
-	pdata->n = n;
-	pdata->i = 0;
-	pdata->g = g;
-	pdata->node = GE_NEW_NODE();
-	pdata->mapping = mapping;
-	pdata->ranking = ranking;
-	pdata->output = array_new(SIValue, 2);
+	PagerankContext *pdata = rm_calloc(1, sizeof(PagerankContext));
+	pdata->g       = g;
+	pdata->node    = GE_NEW_NODE();
+	pdata->write   = write;
+	pdata->output  = array_new(SIValue, 4);
 	_process_yield(pdata, yield);
 
 	ctx->privateData = pdata;
 
-	// get label matrix
-	if(label) {
-		s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
-		// unknown label, quickly return
-		if(!s) return PROCEDURE_OK;
-		RG_Matrix_export(&l, Graph_GetLabelMatrix(g, s->id));
+	PagerankArgs pargs;
+	bool valid = _parse_args(args, write, &pargs);
+	if(!valid || pargs.empty) {
+		// unknown label/relation, quickly return
+		if(pargs.labels)    array_free(pargs.labels);
+		if(pargs.relations) array_free(pargs.relations);
+		return valid ? PROCEDURE_OK : PROCEDURE_ERR;
 	}
 
-	// get relation matrix
-	if(relation) {
-		s = GraphContext_GetSchema(gc, relation, SCHEMA_EDGE);
-		// unknown relation, quickly return
-		if(!s) return PROCEDURE_OK;
-		RG_Matrix_export(&r, Graph_GetRelationMatrix(g, s->id, false));
-
-		// convert the values to true
-		info = GrB_Matrix_apply(r, NULL, NULL, GxB_ONE_BOOL, r, GrB_DESC_R);
-		ASSERT(info == GrB_SUCCESS);
-	} else {
-		// relation isn't specified, 'r' is the adjacency matrix
-		RG_Matrix_export(&r, Graph_GetAdjacencyMatrix(g, false));
-	}
-	// if label is specified:
-	// filter 'r' to contain only rows and columns associated with
-	// nodes of type 'l'
-	if(label != NULL) {
-		//----------------------------------------------------------------------
-		// create a NxN matrix, one row for each labeled entity
-		//----------------------------------------------------------------------
-		info = GrB_Matrix_nvals(&n, l);
-		ASSERT(info == GrB_SUCCESS);
-
-		GrB_Matrix reduced; // relation matrix reduced to only 'l' rows/cols
-		info = GrB_Matrix_new(&reduced, GrB_BOOL, n, n);
-		ASSERT(info == GrB_SUCCESS);
+	GrB_Index n       = 0;     // node count
+	GrB_Index nvals   = 0;     // number of entries in 'r'
+	GrB_Index *mapping = NULL; // mapping, array for returning row indices of tuples
+	LAGraph_PageRank *ranking = NULL;
 
-		// discard rows of 'r' associated with nodes of a different type than 'l'
-		// this will also perform casting to boolean
-		mapping = rm_malloc(sizeof(GrB_Index) * n);
-		// extract row indecies from 'l', coresponding to node IDs
-		info = GrB_Matrix_extractTuples_BOOL(mapping, GrB_NULL, GrB_NULL, &n, l);
-		ASSERT(info == GrB_SUCCESS);
+	GrB_Matrix r = Projection_BuildMatrix(g, pargs.labels, pargs.relations, &n,
+			&mapping);
 
-		info = GrB_Matrix_extract(reduced, GrB_NULL, GrB_NULL, r, mapping, n,
-								  mapping, n, GrB_NULL);
-		ASSERT(info == GrB_SUCCESS);
+	// warm start from a previously stored ranking
+	if(pargs.seed_prop != NULL) {
+		Attribute_ID attr = GraphContext_GetAttributeID(gc, pargs.seed_prop);
+		if(attr != ATTRIBUTE_ID_NONE) {
+			pargs.config.init = _build_init(g, attr, n, mapping);
+		}
+	}
 
-		GrB_free(&r);
-		r = reduced;
-	} else {
-		// resize to remove unused rows
-		n = Graph_UncompactedNodeCount(g);
-		GxB_Matrix_resize(r, n, n);
+	// personalized pagerank
+	ProcedureResult res = PROCEDURE_OK;
+	if(!SIValue_IsNull(pargs.source_nodes)) {
+		pargs.config.personalization =
+			_build_personalization(pargs.source_nodes, n, mapping);
+		if(pargs.config.personalization == NULL) {
+			ErrorCtx_SetError(EMSG_PAGERANK_SOURCE_NODES);
+			res = PROCEDURE_ERR;
+		}
 	}
 
 	// invoke Pagerank only if 'r' contains entries
 	info = GrB_Matrix_nvals(&nvals, r);
 	ASSERT(info == GrB_SUCCESS);
 
-	if(nvals > 0) {
-		info = Pagerank(&ranking, r, itermax, tol, &iters);
+	if(nvals > 0 && res == PROCEDURE_OK) {
+		info = Pagerank(&ranking, r, &pargs.config, &pdata->iterations,
+				&pdata->delta);
 		ASSERT(info == GrB_SUCCESS);
 	}
 
-	// clean up
-	GrB_free(&r);
-	if(label) {
-		GrB_free(&l);
-	}
-
 	// update context
-	pdata->n        =  n;
+	pdata->n        =  (ranking != NULL) ? n : 0;
 	pdata->mapping  =  mapping;
 	pdata->ranking  =  ranking;
 
-	return PROCEDURE_OK;
+	if(write && ranking != NULL) {
+		pdata->written = _write_scores(pdata, pargs.write_prop);
+	}
+
+	// clean up
+	GrB_free(&r);
+	if(pargs.config.init)            GrB_free(&pargs.config.init);
+	if(pargs.config.personalization) GrB_free(&pargs.config.personalization);
+	if(pargs.labels)                 array_free(pargs.labels);
+	if(pargs.relations)              array_free(pargs.relations);
+
+	return res;
+}
+
+ProcedureResult Proc_PagerankInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _Proc_PagerankInvoke(ctx, args, yield, false);
+}
+
+ProcedureResult Proc_PagerankWriteInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _Proc_PagerankInvoke(ctx, args, yield, true);
 }
 
 SIValue *Proc_PagerankStep
@@ -197,8 +462,29 @@ SIValue *Proc_PagerankStep
 	NodeID node_id = (pdata->mapping) ? pdata->mapping[rank.page] : rank.page;
 
 	Graph_GetNode(pdata->g, node_id, &pdata->node);
-	if(pdata->yield_node)   *pdata->yield_node   =  SI_Node(&pdata->node);
-	if(pdata->yield_score)  *pdata->yield_score  =  SI_DoubleVal(rank.pagerank);
+	if(pdata->yield_node)       *pdata->yield_node       =  SI_Node(&pdata->node);
+	if(pdata->yield_score)      *pdata->yield_score      =  SI_DoubleVal(rank.pagerank);
+	if(pdata->yield_iterations) *pdata->yield_iterations =  SI_LongVal(pdata->iterations);
+	if(pdata->yield_delta)      *pdata->yield_delta      =  SI_DoubleVal(pdata->delta);
+
+	return pdata->output;
+}
+
+SIValue *Proc_PagerankWriteStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData);
+
+	PagerankContext *pdata = (PagerankContext *)ctx->privateData;
+
+	// a single summary row
+	if(pdata->depleted) return NULL;
+	pdata->depleted = true;
+
+	if(pdata->yield_nodes)      *pdata->yield_nodes      =  SI_LongVal(pdata->written);
+	if(pdata->yield_iterations) *pdata->yield_iterations =  SI_LongVal(pdata->iterations);
+	if(pdata->yield_delta)      *pdata->yield_delta      =  SI_DoubleVal(pdata->delta);
 
 	return pdata->output;
 }
@@ -221,14 +507,18 @@ ProcedureResult Proc_PagerankFree
 
 ProcedureCtx *Proc_PagerankCtx() {
 	void *privateData = NULL;
-	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 4);
 	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
 	ProcedureOutput output_score = {.name = "score", .type = T_DOUBLE};
+	ProcedureOutput output_iterations = {.name = "iterations", .type = T_INT64};
+	ProcedureOutput output_delta = {.name = "delta", .type = T_DOUBLE};
 	array_append(outputs, output_node);
 	array_append(outputs, output_score);
+	array_append(outputs, output_iterations);
+	array_append(outputs, output_delta);
 
 	ProcedureCtx *ctx = ProcCtxNew("algo.pageRank",
-								   2,
+								   PROCEDURE_VARIABLE_ARG_COUNT,
 								   outputs,
 								   Proc_PagerankStep,
 								   Proc_PagerankInvoke,
@@ -238,3 +528,24 @@ ProcedureCtx *Proc_PagerankCtx() {
 	return ctx;
 }
 
+ProcedureCtx *Proc_PagerankWriteCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 3);
+	ProcedureOutput output_nodes = {.name = "nodes", .type = T_INT64};
+	ProcedureOutput output_iterations = {.name = "iterations", .type = T_INT64};
+	ProcedureOutput output_delta = {.name = "delta", .type = T_DOUBLE};
+	array_append(outputs, output_nodes);
+	array_append(outputs, output_iterations);
+	array_append(outputs, output_delta);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.pageRank.write",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   outputs,
+								   Proc_PagerankWriteStep,
+								   Proc_PagerankWriteInvoke,
+								   Proc_PagerankFree,
+								   privateData,
+								   false);
+	return ctx;
+}
+
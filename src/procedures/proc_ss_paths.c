@@ -13,6 +13,7 @@
 #include "../errors/errors.h"
 #include "../graph/graphcontext.h"
 #include "../datatypes/datatypes.h"
+#include "../algorithms/weighted_paths.h"
 
 #include <float.h>
 
@@ -26,12 +27,6 @@
 //					  pathCount: 1}) YIELD path, pathWeight, pathCost
 // RETURN path, pathWeight, pathCost
 
-typedef struct {
-	Path *path;      // path
-	double weight;   // path weight
-	double cost;     // path cost
-} WeightedPath;
-
 typedef struct {
 	Node node;
 	Edge edge;
@@ -56,6 +51,8 @@ typedef struct {
 		heap_t *heap;            // in case path_count > 1
 		WeightedPath *array;     // path_count == 0 return all minimum result
 	};                           // path collection
+	WeightedPath *paths;         // paths collected by WeightedPaths_Collect
+	uint64_t paths_idx;          // next collected path to return
 	SIValue *output;             // result returned
 	SIValue *yield_path;         // yield path
 	SIValue *yield_path_weight;  // yield path weight
@@ -79,6 +76,13 @@ static void SingleSourceCtx_Free
 	}
 	if(ctx->path_count == 0 && ctx->array != NULL) array_free(ctx->array);
 	else if(ctx->path_count > 1 && ctx->heap != NULL) Heap_free(ctx->heap);
+	if(ctx->paths != NULL) {
+		uint32_t count = array_len(ctx->paths);
+		for(uint32_t i = ctx->paths_idx; i < count; i++) {
+			Path_Free(ctx->paths[i].path);
+		}
+		array_free(ctx->paths);
+	}
 	array_free(ctx->output);
 	rm_free(ctx);
 }
@@ -235,6 +239,10 @@ static ProcedureResult validate_config
 			return false;
 		}
 		max_length_val = SI_GET_NUMERIC(max_length);
+		if(max_length_val < 0) {
+			ErrorCtx_SetError(EMSG_MUST_BE_NON_NEGATIVE, "maxLen");
+			return false;
+		}
 	}
 
 	GraphContext *gc = QueryCtx_GetGraphCtx();
@@ -652,6 +660,29 @@ static void SSpaths_k_minimal
 	}
 }
 
+// collect paths using the weighted shortest path engine
+// returns false if the graph contains edges with negative weight or cost
+static bool SSpaths_collect
+(
+	SingleSourceCtx *ctx
+) {
+	WeightedTraversal t = {
+		.g             = ctx->g,
+		.relationIDs   = ctx->relationIDs,
+		.relationCount = ctx->relationCount,
+		.dir           = ctx->dir,
+		.maxLen        = ctx->maxLen - 1,
+		.weight_prop   = ctx->weight_prop,
+		.cost_prop     = ctx->cost_prop,
+		.max_cost      = ctx->max_cost
+	};
+
+	// source node is the single entry at level 0
+	Node *src = &ctx->levels[0][0].node;
+	return WeightedPaths_Collect(&t, src, NULL, ctx->path_count,
+			&ctx->paths);
+}
+
 static ProcedureResult Proc_SSpathsInvoke
 (
 	ProcedureCtx *ctx,
@@ -668,6 +699,10 @@ static ProcedureResult Proc_SSpathsInvoke
 	single_source_ctx->output = array_new(SIValue, 3);
 	_process_yield(single_source_ctx, yield);
 
+	// prefer the weighted shortest path engine, fall back to
+	// enumerating all paths when edges with negative weight or cost exist
+	if(SSpaths_collect(single_source_ctx)) return PROCEDURE_OK;
+
 	if(single_source_ctx->path_count == 0) SSpaths_all_minimal(single_source_ctx);
 	else if(single_source_ctx->path_count == 1) SSpaths_single_minimal(single_source_ctx);
 	else SSpaths_k_minimal(single_source_ctx);
@@ -684,7 +719,11 @@ static SIValue *Proc_SSpathsStep
 	SingleSourceCtx *single_source_ctx = ctx->privateData;
 	WeightedPath p;
 
-	if(single_source_ctx->path_count == 0) {
+	if(single_source_ctx->paths != NULL) {
+		if(single_source_ctx->paths_idx == array_len(single_source_ctx->paths)) return NULL;
+
+		p = single_source_ctx->paths[single_source_ctx->paths_idx++];
+	} else if(single_source_ctx->path_count == 0) {
 		if(array_len(single_source_ctx->array) == 0) return NULL;
 
 		p = array_pop(single_source_ctx->array);
@@ -0,0 +1,166 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_triangle_count.h"
+#include "../RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../algorithms/triangle_count.h"
+#include "shared/projection.h"
+
+// CALL algo.triangleCount(NULL, NULL)        YIELD node, triangles
+// CALL algo.triangleCount('User', 'FOLLOWS') YIELD node, triangles
+//
+// counts the number of triangles each node participates in
+// edge direction, parallel edges and self loops are ignored
+// labels and relationship types can be specified as a list
+// in which case the graph is the union of the listed labels/relationships
+
+typedef struct {
+	Node node;                   // current node
+	GrB_Vector triangles;        // triangles of each row
+	GrB_Index *mapping;          // row to node ID mapping
+	ProjectionIterator iter;     // result iterator
+	bool iterating;              // iterator initialized
+	SIValue *output;             // array with up to 2 entries
+	SIValue *yield_node;         // yield node
+	SIValue *yield_triangles;    // yield triangle count
+} TriangleCountContext;
+
+static void _process_yield
+(
+	TriangleCountContext *ctx,
+	const char **yield
+) {
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("node", yield[i]) == 0) {
+			ctx->yield_node = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("triangles", yield[i]) == 0) {
+			ctx->yield_triangles = ctx->output + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+ProcedureResult Proc_TriangleCountInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// expecting 2 arguments
+	if(array_len((SIValue *)args) != 2) return PROCEDURE_ERR;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	Graph *g = QueryCtx_GetGraph();
+
+	// setup context
+	TriangleCountContext *pdata = rm_calloc(1, sizeof(TriangleCountContext));
+	pdata->node   = GE_NEW_NODE();
+	pdata->output = array_new(SIValue, 2);
+	_process_yield(pdata, yield);
+
+	ctx->privateData = pdata;
+
+	int  *labels    = NULL;
+	int  *relations = NULL;
+	bool empty      = false;
+
+	if(!Projection_ResolveSchemas(args[0], SCHEMA_NODE, &labels, &empty) ||
+	   !Projection_ResolveSchemas(args[1], SCHEMA_EDGE, &relations, &empty)) {
+		if(labels) array_free(labels);
+		return PROCEDURE_ERR;
+	}
+
+	// unknown label/relation, quickly return
+	if(!empty) {
+		GrB_Index n;
+		GrB_Matrix A = Projection_BuildMatrix(g, labels, relations, &n,
+				&pdata->mapping);
+		Projection_Undirected(A);
+
+		info = TriangleCount(&pdata->triangles, A);
+		ASSERT(info == GrB_SUCCESS);
+
+		ProjectionIterator_Init(&pdata->iter, g, pdata->triangles,
+				pdata->mapping);
+		pdata->iterating = true;
+
+		GrB_free(&A);
+	}
+
+	if(labels)    array_free(labels);
+	if(relations) array_free(relations);
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_TriangleCountStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData);
+
+	TriangleCountContext *pdata = (TriangleCountContext *)ctx->privateData;
+
+	uint64_t triangles;
+	if(!pdata->iterating ||
+	   !ProjectionIterator_Next(&pdata->iter, &pdata->node, NULL, &triangles)) {
+		return NULL;
+	}
+
+	if(pdata->yield_node)      *pdata->yield_node      = SI_Node(&pdata->node);
+	if(pdata->yield_triangles) *pdata->yield_triangles = SI_LongVal(triangles);
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_TriangleCountFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(ctx->privateData) {
+		TriangleCountContext *pdata = ctx->privateData;
+		if(pdata->iterating)  ProjectionIterator_Free(&pdata->iter);
+		if(pdata->triangles)  GrB_free(&pdata->triangles);
+		if(pdata->output)     array_free(pdata->output);
+		if(pdata->mapping)    rm_free(pdata->mapping);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_TriangleCountCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
+	ProcedureOutput output_triangles = {.name = "triangles", .type = T_INT64};
+	array_append(outputs, output_node);
+	array_append(outputs, output_triangles);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.triangleCount",
+								   2,
+								   outputs,
+								   Proc_TriangleCountStep,
+								   Proc_TriangleCountInvoke,
+								   Proc_TriangleCountFree,
+								   privateData,
+								   true);
+	return ctx;
+}
+
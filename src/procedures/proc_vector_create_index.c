@@ -0,0 +1,164 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_vector_create_index.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../index/index.h"
+#include "../errors/errors.h"
+#include "../index/indexer.h"
+#include "../graph/graphcontext.h"
+#include "../datatypes/datatypes.h"
+
+// upper bound on the number of links per element per layer
+#define VECTOR_INDEX_MAX_M 512
+
+//------------------------------------------------------------------------------
+// vector createNodeIndex
+//------------------------------------------------------------------------------
+
+// parse index options
+// [optional] similarity <'euclidean' | 'cosine'>
+// [optional] M <integer in range [2, 512]>
+// [optional] efConstruction <positive integer>
+static bool _parse_options
+(
+	SIValue options,          // options map
+	VectorIndexOptions *opts  // [output] index configuration
+) {
+	if(SI_TYPE(options) != T_MAP) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "options", "a map");
+		return false;
+	}
+
+	SIValue v;
+	if(MAP_GET(options, "similarity", v)) {
+		if(SI_TYPE(v) != T_STRING) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "similarity", "a string");
+			return false;
+		}
+
+		if(strcasecmp(v.stringval, "euclidean") == 0) {
+			opts->similarity = VECSIM_EUCLIDEAN;
+		} else if(strcasecmp(v.stringval, "cosine") == 0) {
+			opts->similarity = VECSIM_COSINE;
+		} else {
+			ErrorCtx_SetError(EMSG_MUST_BE, "similarity",
+					"either 'euclidean' or 'cosine'");
+			return false;
+		}
+	}
+
+	if(MAP_GET(options, "M", v)) {
+		if(SI_TYPE(v) != T_INT64 || v.longval < 2 ||
+		   v.longval > VECTOR_INDEX_MAX_M) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "M", "an integer between 2 and 512");
+			return false;
+		}
+		opts->M = v.longval;
+	}
+
+	if(MAP_GET(options, "efConstruction", v)) {
+		if(SI_TYPE(v) != T_INT64 || v.longval <= 0) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "efConstruction",
+					"a positive integer");
+			return false;
+		}
+		opts->ef_construction = v.longval;
+	}
+
+	return true;
+}
+
+// CALL db.idx.vector.createNodeIndex(label, attribute, dimension)
+// CALL db.idx.vector.createNodeIndex(label, attribute, dimension, options)
+// CALL db.idx.vector.createNodeIndex('Doc', 'embedding', 768)
+// CALL db.idx.vector.createNodeIndex('Doc', 'embedding', 768,
+//      {similarity: 'cosine', M: 32, efConstruction: 400})
+static ProcedureResult Proc_VectorCreateNodeIdxInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	uint argc = array_len((SIValue *)args);
+	if(argc < 3 || argc > 4) {
+		ErrorCtx_SetError(EMSG_PROCEDURE_INVALID_ARGUMENTS, ctx->name,
+				(argc < 3) ? 3 : 4, argc);
+		return PROCEDURE_ERR;
+	}
+
+	if(SI_TYPE(args[0]) != T_STRING) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "Label", "string");
+		return PROCEDURE_ERR;
+	}
+
+	if(SI_TYPE(args[1]) != T_STRING) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "Attribute", "string");
+		return PROCEDURE_ERR;
+	}
+
+	if(SI_TYPE(args[2]) != T_INT64 || args[2].longval <= 0 ||
+	   args[2].longval > UINT32_MAX) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "Dimension", "a positive integer");
+		return PROCEDURE_ERR;
+	}
+
+	VectorIndexOptions opts = {
+		.M               = HNSW_DEFAULT_M,
+		.dimension       = args[2].longval,
+		.similarity      = VECSIM_EUCLIDEAN,
+		.ef_construction = HNSW_DEFAULT_EF_CONSTRUCTION
+	};
+
+	if(argc == 4 && !_parse_options(args[3], &opts)) {
+		return PROCEDURE_ERR;
+	}
+
+	const char   *label     = args[0].stringval;
+	const char   *attribute = args[1].stringval;
+	GraphContext *gc        = QueryCtx_GetGraphCtx();
+
+	// a label holds at most a single vector index
+	// whose configuration can't change
+	Index idx = NULL;
+	Schema *s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+	if(s != NULL && Schema_GetIndex(s, NULL, 0, IDX_VECTOR, true) != NULL) {
+		ErrorCtx_SetError(EMSG_INDEX_ALREADY_EXISTS);
+		return PROCEDURE_ERR;
+	}
+
+	// build index
+	if(GraphContext_AddVectorIndex(&idx, gc, label, attribute, &opts)) {
+		s = GraphContext_GetSchema(gc, label, SCHEMA_NODE);
+		Indexer_PopulateIndex(gc, s, idx);
+	}
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_VectorCreateNodeIdxStep
+(
+	ProcedureCtx *ctx
+) {
+	return NULL;
+}
+
+ProcedureResult Proc_VectorCreateNodeIdxFree
+(
+	ProcedureCtx *ctx
+) {
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_VectorCreateNodeIdxGen() {
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	return ProcCtxNew("db.idx.vector.createNodeIndex",
+			PROCEDURE_VARIABLE_ARG_COUNT, output,
+			Proc_VectorCreateNodeIdxStep, Proc_VectorCreateNodeIdxInvoke,
+			Proc_VectorCreateNodeIdxFree, NULL, false);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_vector_drop_index.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../errors/errors.h"
+#include "../graph/graphcontext.h"
+
+//------------------------------------------------------------------------------
+// vector drop
+//------------------------------------------------------------------------------
+
+// CALL db.idx.vector.drop(label, attribute)
+// CALL db.idx.vector.drop('Doc', 'embedding')
+
+ProcedureResult Proc_VectorDropIndexInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	// argument validations
+	// expecting both arguments to be strings
+	if(array_len((SIValue *)args) != 2) {
+		return PROCEDURE_ERR;
+	}
+
+	if(!(SI_TYPE(args[0]) & SI_TYPE(args[1]) & T_STRING)) {
+		return PROCEDURE_ERR;
+	}
+
+	const char   *l   = args[0].stringval;
+	const char   *a   = args[1].stringval;
+	GraphContext *gc  = QueryCtx_GetGraphCtx();
+	int          res  = GraphContext_DeleteIndex(gc, SCHEMA_NODE, l, a,
+			IDX_VECTOR);
+
+	if(res != INDEX_OK) {
+		ErrorCtx_SetError(EMSG_VECTOR_DROP_INDEX, l, a);
+	}
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_VectorDropIndexStep
+(
+	ProcedureCtx *ctx
+) {
+	return NULL;
+}
+
+ProcedureResult Proc_VectorDropIndexFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_VectorDropIdxGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output = array_new(ProcedureOutput, 0);
+	ProcedureCtx *ctx = ProcCtxNew("db.idx.vector.drop",
+								   2,
+								   output,
+								   Proc_VectorDropIndexStep,
+								   Proc_VectorDropIndexInvoke,
+								   Proc_VectorDropIndexFree,
+								   privateData,
+								   false);
+
+	return ctx;
+}
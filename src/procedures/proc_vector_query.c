@@ -0,0 +1,221 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_vector_query.h"
+#include "RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../index/index.h"
+#include "../util/rmalloc.h"
+#include "../errors/errors.h"
+#include "../graph/graphcontext.h"
+#include "../datatypes/datatypes.h"
+
+//------------------------------------------------------------------------------
+// vector queryNodes
+//------------------------------------------------------------------------------
+
+// CALL db.idx.vector.queryNodes(label, attribute, k, query)
+// CALL db.idx.vector.queryNodes(label, attribute, k, query, {efRuntime: 100})
+// CALL db.idx.vector.queryNodes('Doc', 'embedding', 10, vecf32([0.1, 0.2]))
+//
+// yields the k approximate nearest nodes to query, ordered by distance
+// a larger efRuntime trades search speed for recall
+
+typedef struct {
+	Node n;                 // yielded node
+	Graph *g;               // graph
+	EntityID *ids;          // nearest nodes
+	float *distances;       // nearest nodes distances
+	uint count;             // number of results
+	uint idx;               // next result to yield
+	SIValue *output;        // procedure output
+	SIValue *yield_node;    // yield node
+	SIValue *yield_score;   // yield score
+} VectorQueryContext;
+
+static void _process_yield
+(
+	VectorQueryContext *ctx,
+	const char **yield
+) {
+	ctx->yield_node  = NULL;
+	ctx->yield_score = NULL;
+
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("node", yield[i]) == 0) {
+			ctx->yield_node = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("score", yield[i]) == 0) {
+			ctx->yield_score = ctx->output + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+// parse query options
+// [optional] efRuntime <positive integer>
+static bool _parse_options
+(
+	SIValue options,  // options map
+	uint *ef          // [output] candidate list size
+) {
+	if(SI_TYPE(options) != T_MAP) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "options", "a map");
+		return false;
+	}
+
+	SIValue v;
+	if(MAP_GET(options, "efRuntime", v)) {
+		if(SI_TYPE(v) != T_INT64 || v.longval <= 0 || v.longval > UINT32_MAX) {
+			ErrorCtx_SetError(EMSG_MUST_BE, "efRuntime", "a positive integer");
+			return false;
+		}
+		*ef = v.longval;
+	}
+
+	return true;
+}
+
+static ProcedureResult Proc_VectorQueryNodeInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	ctx->privateData = NULL;
+
+	uint argc = array_len((SIValue *)args);
+	if(argc < 4 || argc > 5) {
+		ErrorCtx_SetError(EMSG_PROCEDURE_INVALID_ARGUMENTS, ctx->name,
+				(argc < 4) ? 4 : 5, argc);
+		return PROCEDURE_ERR;
+	}
+
+	if(!(SI_TYPE(args[0]) & SI_TYPE(args[1]) & T_STRING)) return PROCEDURE_ERR;
+
+	if(SI_TYPE(args[2]) != T_INT64 || args[2].longval < 0) {
+		ErrorCtx_SetError(EMSG_MUST_BE_NON_NEGATIVE, "k");
+		return PROCEDURE_ERR;
+	}
+
+	SIValue query = args[3];
+	if(SI_TYPE(query) != T_VECTOR_F32) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "Query", "a vector");
+		return PROCEDURE_ERR;
+	}
+
+	uint ef = HNSW_DEFAULT_EF_RUNTIME;
+	if(argc == 5 && !_parse_options(args[4], &ef)) return PROCEDURE_ERR;
+
+	const char   *label     = args[0].stringval;
+	const char   *attribute = args[1].stringval;
+	GraphContext *gc        = QueryCtx_GetGraphCtx();
+
+	// get vector index from schema
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, attribute);
+	if(attr_id == ATTRIBUTE_ID_NONE) return PROCEDURE_ERR;
+
+	Index idx = GraphContext_GetIndex(gc, label, &attr_id, 1, IDX_VECTOR,
+			SCHEMA_NODE);
+	if(idx == NULL) return PROCEDURE_ERR;
+
+	const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+	if(SIVector_Dim(query) != opts->dimension) {
+		ErrorCtx_SetError(EMSG_VECTOR_DIMENSION_MISMATCH, opts->dimension,
+				SIVector_Dim(query));
+		return PROCEDURE_ERR;
+	}
+
+	// no point in asking for more neighbors than there are vectors
+	HNSW     *hnsw = Index_HNSW(idx);
+	uint64_t k     = args[2].longval;
+	uint64_t size  = HNSW_Size(hnsw);
+	if(k > size) k = size;
+
+	ctx->privateData = rm_malloc(sizeof(VectorQueryContext));
+	VectorQueryContext *pdata = ctx->privateData;
+
+	pdata->g         = gc->g;
+	pdata->n         = GE_NEW_NODE();
+	pdata->idx       = 0;
+	pdata->ids       = rm_malloc(sizeof(EntityID) * k);
+	pdata->output    = array_new(SIValue, 2);
+	pdata->distances = rm_malloc(sizeof(float) * k);
+
+	_process_yield(pdata, yield);
+
+	pdata->count = HNSW_Search(hnsw, SIVector_Elements(query), k, ef,
+			pdata->ids, pdata->distances);
+
+	return PROCEDURE_OK;
+}
+
+SIValue *Proc_VectorQueryStep
+(
+	ProcedureCtx *ctx
+) {
+	if(!ctx->privateData) return NULL; // no index was attached to this procedure
+
+	VectorQueryContext *pdata = (VectorQueryContext *)ctx->privateData;
+
+	// depleted
+	if(pdata->idx >= pdata->count) return NULL;
+
+	uint i = pdata->idx++;
+
+	// get node
+	Node *n = &pdata->n;
+	Graph_GetNode(pdata->g, pdata->ids[i], n);
+
+	if(pdata->yield_node) *pdata->yield_node = SI_Node(n);
+	if(pdata->yield_score) {
+		*pdata->yield_score = SI_DoubleVal(pdata->distances[i]);
+	}
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_VectorQueryFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(!ctx->privateData) return PROCEDURE_OK;
+
+	VectorQueryContext *pdata = ctx->privateData;
+	array_free(pdata->output);
+	rm_free(pdata->ids);
+	rm_free(pdata->distances);
+	rm_free(pdata);
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_VectorQueryNodeGen() {
+	void *privateData = NULL;
+	ProcedureOutput *output   = array_new(ProcedureOutput, 2);
+	ProcedureOutput out_node  = {.name = "node", .type = T_NODE};
+	ProcedureOutput out_score = {.name = "score", .type = T_DOUBLE};
+	array_append(output, out_node);
+	array_append(output, out_score);
+
+	ProcedureCtx *ctx = ProcCtxNew("db.idx.vector.queryNodes",
+								   PROCEDURE_VARIABLE_ARG_COUNT,
+								   output,
+								   Proc_VectorQueryStep,
+								   Proc_VectorQueryNodeInvoke,
+								   Proc_VectorQueryFree,
+								   privateData,
+								   true);
+	return ctx;
+}
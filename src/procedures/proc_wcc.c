@@ -0,0 +1,319 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "proc_wcc.h"
+#include "../RG.h"
+#include "../value.h"
+#include "../util/arr.h"
+#include "../query_ctx.h"
+#include "../util/rmalloc.h"
+#include "../errors/errors.h"
+#include "../graph/graph_hub.h"
+#include "../datatypes/datatypes.h"
+#include "../algorithms/wcc.h"
+#include "shared/projection.h"
+
+// CALL algo.wcc(NULL, NULL)        YIELD node, componentId
+// CALL algo.wcc('User', 'FOLLOWS') YIELD node, componentId
+//
+// computes weakly connected components, edge direction is ignored
+// labels and relationship types can be specified as a list
+// in which case the graph is the union of the listed labels/relationships
+// each component is identified by the ID of its node with the smallest ID
+//
+// algo.wcc.write materializes the component IDs as a node attribute
+// returning a single row, refreshing a previously written attribute only
+// updates nodes whose component changed, as component IDs are stable
+// for components which weren't modified
+//
+// CALL algo.wcc.write('User', 'FOLLOWS', {writeProperty: 'component'})
+// YIELD nodes, components
+
+typedef struct {
+	Node node;                   // current node
+	GrB_Vector components;       // component of each row
+	GrB_Index *mapping;          // row to node ID mapping
+	ProjectionIterator iter;     // result iterator
+	bool iterating;              // iterator initialized
+	bool depleted;               // write mode, summary returned
+	uint64_t written;            // number of nodes updated
+	uint64_t count;              // number of components
+	SIValue *output;             // array with up to 2 entries
+	SIValue *yield_node;         // yield node
+	SIValue *yield_component;    // yield component ID
+	SIValue *yield_nodes;        // yield number of nodes updated
+	SIValue *yield_components;   // yield number of components
+} WCCContext;
+
+static void _process_yield
+(
+	WCCContext *ctx,
+	const char **yield
+) {
+	int idx = 0;
+	for(uint i = 0; i < array_len(yield); i++) {
+		if(strcasecmp("node", yield[i]) == 0) {
+			ctx->yield_node = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("componentId", yield[i]) == 0) {
+			ctx->yield_component = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("nodes", yield[i]) == 0) {
+			ctx->yield_nodes = ctx->output + idx;
+			idx++;
+			continue;
+		}
+
+		if(strcasecmp("components", yield[i]) == 0) {
+			ctx->yield_components = ctx->output + idx;
+			idx++;
+			continue;
+		}
+	}
+}
+
+// validate write mode configuration map
+// returns the attribute to write component IDs to, NULL on error
+static const char *_parse_write_config
+(
+	SIValue config  // configuration map
+) {
+	SIValue write_prop;
+
+	if(SI_TYPE(config) != T_MAP) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "configuration", "a map");
+		return NULL;
+	}
+
+	if(!MAP_GET(config, "writeProperty", write_prop)) {
+		ErrorCtx_SetError(EMSG_IS_MISSING, "writeProperty");
+		return NULL;
+	}
+
+	if(SI_TYPE(write_prop) != T_STRING) {
+		ErrorCtx_SetError(EMSG_MUST_BE, "writeProperty", "a string");
+		return NULL;
+	}
+
+	return write_prop.stringval;
+}
+
+// write each node's component ID as attribute 'attr'
+static void _write_components
+(
+	WCCContext *pdata,  // wcc context
+	Graph *g,           // graph
+	const char *attr    // attribute name
+) {
+	GraphContext *gc     = QueryCtx_GetGraphCtx();
+	Attribute_ID attr_id = FindOrAddAttribute(gc, attr, true);
+
+	MATRIX_POLICY policy = Graph_GetMatrixPolicy(g);
+	Graph_SetMatrixPolicy(g, SYNC_POLICY_NOP);
+
+	GrB_Index row;
+	GrB_Index component;
+	while(ProjectionIterator_Next(&pdata->iter, &pdata->node, &row,
+				&component)) {
+		// every component is rooted at its smallest row
+		if(row == component) pdata->count++;
+
+		SIValue v = SI_LongVal(Projection_RowNode(component, pdata->mapping));
+		if(Projection_WriteAttribute(&pdata->node, attr_id, v)) {
+			pdata->written++;
+		}
+	}
+
+	Graph_SetMatrixPolicy(g, policy);
+}
+
+static ProcedureResult _Proc_WCCInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield,
+	bool write
+) {
+	uint argc = array_len((SIValue *)args);
+
+	// expecting 2 arguments, write mode expects a configuration map
+	if(argc != 2 + write) return PROCEDURE_ERR;
+
+	GrB_Info info;
+	UNUSED(info);
+
+	Graph *g = QueryCtx_GetGraph();
+
+	// setup context
+	WCCContext *pdata = rm_calloc(1, sizeof(WCCContext));
+	pdata->node   = GE_NEW_NODE();
+	pdata->output = array_new(SIValue, 2);
+	_process_yield(pdata, yield);
+
+	ctx->privateData = pdata;
+
+	int  *labels    = NULL;
+	int  *relations = NULL;
+	bool empty      = false;
+
+	if(!Projection_ResolveSchemas(args[0], SCHEMA_NODE, &labels, &empty) ||
+	   !Projection_ResolveSchemas(args[1], SCHEMA_EDGE, &relations, &empty)) {
+		if(labels) array_free(labels);
+		return PROCEDURE_ERR;
+	}
+
+	const char *write_prop = NULL;
+	if(write && (write_prop = _parse_write_config(args[2])) == NULL) {
+		if(labels)    array_free(labels);
+		if(relations) array_free(relations);
+		return PROCEDURE_ERR;
+	}
+
+	// unknown label/relation, quickly return
+	if(!empty) {
+		GrB_Index n;
+		GrB_Matrix A = Projection_BuildMatrix(g, labels, relations, &n,
+				&pdata->mapping);
+		Projection_Undirected(A);
+
+		info = WCC(&pdata->components, A);
+		ASSERT(info == GrB_SUCCESS);
+
+		ProjectionIterator_Init(&pdata->iter, g, pdata->components,
+				pdata->mapping);
+		pdata->iterating = true;
+
+		if(write) _write_components(pdata, g, write_prop);
+
+		GrB_free(&A);
+	}
+
+	if(labels)    array_free(labels);
+	if(relations) array_free(relations);
+
+	return PROCEDURE_OK;
+}
+
+ProcedureResult Proc_WCCInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _Proc_WCCInvoke(ctx, args, yield, false);
+}
+
+ProcedureResult Proc_WCCWriteInvoke
+(
+	ProcedureCtx *ctx,
+	const SIValue *args,
+	const char **yield
+) {
+	return _Proc_WCCInvoke(ctx, args, yield, true);
+}
+
+SIValue *Proc_WCCStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData);
+
+	WCCContext *pdata = (WCCContext *)ctx->privateData;
+
+	GrB_Index component;
+	if(!pdata->iterating ||
+	   !ProjectionIterator_Next(&pdata->iter, &pdata->node, NULL, &component)) {
+		return NULL;
+	}
+
+	if(pdata->yield_node) *pdata->yield_node = SI_Node(&pdata->node);
+	if(pdata->yield_component) {
+		*pdata->yield_component =
+			SI_LongVal(Projection_RowNode(component, pdata->mapping));
+	}
+
+	return pdata->output;
+}
+
+SIValue *Proc_WCCWriteStep
+(
+	ProcedureCtx *ctx
+) {
+	ASSERT(ctx->privateData);
+
+	WCCContext *pdata = (WCCContext *)ctx->privateData;
+
+	// a single summary row
+	if(pdata->depleted) return NULL;
+	pdata->depleted = true;
+
+	if(pdata->yield_nodes)      *pdata->yield_nodes      = SI_LongVal(pdata->written);
+	if(pdata->yield_components) *pdata->yield_components = SI_LongVal(pdata->count);
+
+	return pdata->output;
+}
+
+ProcedureResult Proc_WCCFree
+(
+	ProcedureCtx *ctx
+) {
+	// clean up
+	if(ctx->privateData) {
+		WCCContext *pdata = ctx->privateData;
+		if(pdata->iterating)  ProjectionIterator_Free(&pdata->iter);
+		if(pdata->components) GrB_free(&pdata->components);
+		if(pdata->output)     array_free(pdata->output);
+		if(pdata->mapping)    rm_free(pdata->mapping);
+		rm_free(ctx->privateData);
+	}
+
+	return PROCEDURE_OK;
+}
+
+ProcedureCtx *Proc_WCCCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_node = {.name = "node", .type = T_NODE};
+	ProcedureOutput output_component = {.name = "componentId", .type = T_INT64};
+	array_append(outputs, output_node);
+	array_append(outputs, output_component);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.wcc",
+								   2,
+								   outputs,
+								   Proc_WCCStep,
+								   Proc_WCCInvoke,
+								   Proc_WCCFree,
+								   privateData,
+								   true);
+	return ctx;
+}
+
+ProcedureCtx *Proc_WCCWriteCtx() {
+	void *privateData = NULL;
+	ProcedureOutput *outputs = array_new(ProcedureOutput, 2);
+	ProcedureOutput output_nodes = {.name = "nodes", .type = T_INT64};
+	ProcedureOutput output_components = {.name = "components", .type = T_INT64};
+	array_append(outputs, output_nodes);
+	array_append(outputs, output_components);
+
+	ProcedureCtx *ctx = ProcCtxNew("algo.wcc.write",
+								   3,
+								   outputs,
+								   Proc_WCCWriteStep,
+								   Proc_WCCWriteInvoke,
+								   Proc_WCCFree,
+								   privateData,
+								   false);
+	return ctx;
+}
+
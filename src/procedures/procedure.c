@@ -35,14 +35,29 @@ void Proc_Register() {
 
 	// Register graph algorithms.
 	_procRegister("algo.BFS", Proc_BFS_Ctx);
+	_procRegister("algo.MSBFS", Proc_MSBFS_Ctx);
+	_procRegister("algo.MSBFS.write", Proc_MSBFS_WriteCtx);
 	_procRegister("algo.pageRank", Proc_PagerankCtx);
+	_procRegister("algo.pageRank.write", Proc_PagerankWriteCtx);
 	_procRegister("algo.SPpaths", Proc_SPpathCtx);
 	_procRegister("algo.SSpaths", Proc_SSpathCtx);
+	_procRegister("algo.wcc", Proc_WCCCtx);
+	_procRegister("algo.wcc.write", Proc_WCCWriteCtx);
+	_procRegister("algo.triangleCount", Proc_TriangleCountCtx);
+	_procRegister("algo.labelPropagation", Proc_LabelPropagationCtx);
 
 	// Register FullText Search generator.
 	_procRegister("db.idx.fulltext.drop", Proc_FulltextDropIdxGen);
 	_procRegister("db.idx.fulltext.queryNodes", Proc_FulltextQueryNodeGen);
 	_procRegister("db.idx.fulltext.createNodeIndex", Proc_FulltextCreateNodeIdxGen);
+	_procRegister("db.idx.fulltext.dropRelationshipIndex", Proc_FulltextDropRelationshipIdxGen);
+	_procRegister("db.idx.fulltext.queryRelationships", Proc_FulltextQueryRelationshipGen);
+	_procRegister("db.idx.fulltext.createRelationshipIndex", Proc_FulltextCreateRelationshipIdxGen);
+
+	// Register vector index generators.
+	_procRegister("db.idx.vector.drop", Proc_VectorDropIdxGen);
+	_procRegister("db.idx.vector.queryNodes", Proc_VectorQueryNodeGen);
+	_procRegister("db.idx.vector.createNodeIndex", Proc_VectorCreateNodeIdxGen);
 }
 
 ProcedureCtx *ProcCtxNew(const char *name,
@@ -0,0 +1,291 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "RG.h"
+#include "projection.h"
+#include "../../util/arr.h"
+#include "../../query_ctx.h"
+#include "../../util/rmalloc.h"
+#include "../../graph/graph_hub.h"
+#include "../../graph/graphcontext.h"
+#include "../../datatypes/datatypes.h"
+
+bool Projection_ResolveSchemas
+(
+	SIValue arg,
+	SchemaType t,
+	int **ids,
+	bool *empty
+) {
+	*ids = NULL;
+
+	SIType arg_t = SI_TYPE(arg);
+	if(arg_t == T_NULL) return true;
+
+	if(arg_t == T_ARRAY && !SIArray_AllOfType(arg, T_STRING)) return false;
+	if(!(arg_t & (T_STRING | T_ARRAY))) return false;
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+	uint n = (arg_t == T_STRING) ? 1 : SIArray_Length(arg);
+
+	*ids = array_new(int, n);
+	for(uint i = 0; i < n; i++) {
+		SIValue name = (arg_t == T_STRING) ? arg : SIArray_Get(arg, i);
+		Schema *s = GraphContext_GetSchema(gc, name.stringval, t);
+		if(s != NULL) array_append(*ids, s->id);
+	}
+
+	if(array_len(*ids) == 0) *empty = true;
+	return true;
+}
+
+GrB_Matrix Projection_BuildMatrix
+(
+	Graph *g,
+	const int *labels,
+	const int *relations,
+	GrB_Index *n,
+	GrB_Index **mapping
+) {
+	GrB_Info info;
+	UNUSED(info);
+
+	GrB_Matrix l = NULL;  // label matrix
+	GrB_Matrix r = NULL;  // relation matrix
+
+	*mapping = NULL;
+
+	// get relation matrix
+	if(relations != NULL) {
+		// union of all relationship types, converted to boolean
+		// multiple edges between two nodes are a single connection
+		for(uint i = 0; i < array_len((int *)relations); i++) {
+			GrB_Matrix m;
+			RG_Matrix_export(&m, Graph_GetRelationMatrix(g, relations[i],
+						false));
+
+			if(r == NULL) {
+				GrB_Index nrows;
+				GrB_Index ncols;
+				GrB_Matrix_nrows(&nrows, m);
+				GrB_Matrix_ncols(&ncols, m);
+				info = GrB_Matrix_new(&r, GrB_BOOL, nrows, ncols);
+				ASSERT(info == GrB_SUCCESS);
+			}
+
+			info = GrB_Matrix_apply(r, NULL, GrB_LOR, GxB_ONE_BOOL, m, NULL);
+			ASSERT(info == GrB_SUCCESS);
+			GrB_free(&m);
+		}
+
+		// no relationship types, nodes are disconnected
+		if(r == NULL) {
+			GrB_Index dim = Graph_RequiredMatrixDim(g);
+			info = GrB_Matrix_new(&r, GrB_BOOL, dim, dim);
+			ASSERT(info == GrB_SUCCESS);
+		}
+	} else {
+		// relation isn't specified, 'r' is the adjacency matrix
+		RG_Matrix_export(&r, Graph_GetAdjacencyMatrix(g, false));
+	}
+
+	// if labels are specified:
+	// filter 'r' to contain only rows and columns associated with
+	// nodes of any of the labels
+	if(labels != NULL) {
+		for(uint i = 0; i < array_len((int *)labels); i++) {
+			GrB_Matrix m;
+			RG_Matrix_export(&m, Graph_GetLabelMatrix(g, labels[i]));
+			if(l == NULL) {
+				l = m;
+				continue;
+			}
+
+			info = GrB_eWiseAdd(l, NULL, NULL, GrB_LOR, l, m, NULL);
+			ASSERT(info == GrB_SUCCESS);
+			GrB_free(&m);
+		}
+
+		//----------------------------------------------------------------------
+		// create a NxN matrix, one row for each labeled entity
+		//----------------------------------------------------------------------
+		info = GrB_Matrix_nvals(n, l);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_Matrix reduced; // relation matrix reduced to only 'l' rows/cols
+		info = GrB_Matrix_new(&reduced, GrB_BOOL, *n, *n);
+		ASSERT(info == GrB_SUCCESS);
+
+		// discard rows of 'r' associated with nodes of a different type than 'l'
+		// this will also perform casting to boolean
+		*mapping = rm_malloc(sizeof(GrB_Index) * (*n));
+		// extract row indecies from 'l', coresponding to node IDs
+		info = GrB_Matrix_extractTuples_BOOL(*mapping, GrB_NULL, GrB_NULL, n, l);
+		ASSERT(info == GrB_SUCCESS);
+
+		info = GrB_Matrix_extract(reduced, GrB_NULL, GrB_NULL, r, *mapping, *n,
+								  *mapping, *n, GrB_NULL);
+		ASSERT(info == GrB_SUCCESS);
+
+		GrB_free(&l);
+		GrB_free(&r);
+		r = reduced;
+	} else {
+		// resize to remove unused rows
+		*n = Graph_UncompactedNodeCount(g);
+		GxB_Matrix_resize(r, *n, *n);
+	}
+
+	return r;
+}
+
+void Projection_Undirected
+(
+	GrB_Matrix A
+) {
+	ASSERT(A != NULL);
+
+	GrB_Info info;
+	UNUSED(info);
+
+	// A = A + A'
+	info = GrB_eWiseAdd(A, NULL, NULL, GrB_LOR, A, A, GrB_DESC_T1);
+	ASSERT(info == GrB_SUCCESS);
+
+	// drop self loops
+	info = GrB_Matrix_select_INT64(A, NULL, NULL, GrB_OFFDIAG, A, 0, NULL);
+	ASSERT(info == GrB_SUCCESS);
+}
+
+static int _cmp_index
+(
+	const void *a,
+	const void *b
+) {
+	GrB_Index x = *(const GrB_Index *)a;
+	GrB_Index y = *(const GrB_Index *)b;
+	return (x > y) - (x < y);
+}
+
+// label matrices are diagonal, extracted row indices are sorted
+int64_t Projection_NodeRow
+(
+	GrB_Index id,
+	GrB_Index n,
+	const GrB_Index *mapping
+) {
+	if(mapping == NULL) return (id < n) ? (int64_t)id : -1;
+
+	GrB_Index *row = bsearch(&id, mapping, n, sizeof(GrB_Index), _cmp_index);
+	return (row == NULL) ? -1 : row - mapping;
+}
+
+bool Projection_WriteAttribute
+(
+	Node *node,
+	Attribute_ID attr,
+	SIValue v
+) {
+	ASSERT(node != NULL);
+	ASSERT(attr != ATTRIBUTE_ID_NONE);
+
+	// value is up to date
+	SIValue *current = GraphEntity_GetProperty((GraphEntity *)node, attr);
+	if(current == ATTRIBUTE_NOTFOUND && SIValue_IsNull(v)) return false;
+	if(current != ATTRIBUTE_NOTFOUND && SI_TYPE(*current) == SI_TYPE(v) &&
+	   SIValue_Compare(*current, v, NULL) == 0) {
+		return false;
+	}
+
+	GraphContext *gc  = QueryCtx_GetGraphCtx();
+	EffectsBuffer *eb = QueryCtx_GetEffectsBuffer();
+	AttributeSet set  = AttributeSet_ShallowClone(*node->attributes);
+
+	switch(AttributeSet_Set_Allow_Null(&set, attr, v)) {
+		case CT_ADD:
+			EffectsBuffer_AddEntityAddAttributeEffect(eb,
+					(GraphEntity *)node, attr, v, GETYPE_NODE);
+			break;
+		case CT_UPDATE:
+			EffectsBuffer_AddEntityUpdateAttributeEffect(eb,
+					(GraphEntity *)node, attr, v, GETYPE_NODE);
+			break;
+		case CT_DEL:
+			EffectsBuffer_AddEntityRemoveAttributeEffect(eb,
+					(GraphEntity *)node, attr, GETYPE_NODE);
+			break;
+		default:
+			break;
+	}
+
+	UpdateEntityProperties(gc, (GraphEntity *)node, set, GETYPE_NODE, true);
+
+	return true;
+}
+
+void ProjectionIterator_Init
+(
+	ProjectionIterator *iter,
+	Graph *g,
+	GrB_Vector v,
+	const GrB_Index *mapping
+) {
+	ASSERT(g    != NULL);
+	ASSERT(v    != NULL);
+	ASSERT(iter != NULL);
+
+	GrB_Info info;
+	UNUSED(info);
+
+	iter->g       = g;
+	iter->mapping = mapping;
+
+	info = GxB_Iterator_new(&iter->it);
+	ASSERT(info == GrB_SUCCESS);
+
+	info = GxB_Vector_Iterator_attach(iter->it, v, NULL);
+	ASSERT(info == GrB_SUCCESS);
+
+	iter->depleted = (GxB_Vector_Iterator_seek(iter->it, 0) == GxB_EXHAUSTED);
+}
+
+bool ProjectionIterator_Next
+(
+	ProjectionIterator *iter,
+	Node *node,
+	GrB_Index *row,
+	uint64_t *value
+) {
+	ASSERT(iter  != NULL);
+	ASSERT(node  != NULL);
+	ASSERT(value != NULL);
+
+	while(!iter->depleted) {
+		GrB_Index i = GxB_Vector_Iterator_getIndex(iter->it);
+		*value = GxB_Iterator_get_UINT64(iter->it);
+
+		iter->depleted =
+			(GxB_Vector_Iterator_next(iter->it) == GxB_EXHAUSTED);
+
+		// skip rows of deleted nodes
+		if(Graph_GetNode(iter->g, Projection_RowNode(i, iter->mapping),
+					node)) {
+			if(row != NULL) *row = i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ProjectionIterator_Free
+(
+	ProjectionIterator *iter
+) {
+	ASSERT(iter != NULL);
+
+	if(iter->it != NULL) GrB_free(&iter->it);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+#include "../../value.h"
+#include "../../graph/graph.h"
+#include "../../schema/schema.h"
+#include "../../graph/entities/node.h"
+
+// graph algorithms run over a projection of the graph:
+// the nodes carrying any of the specified labels
+// connected by edges of any of the specified relationship types
+// the projection is a boolean NxN matrix, one row for each projected node
+
+// resolve a label/relationship argument into schema IDs
+// the argument is either NULL, a string or an array of strings
+// unknown schemas are skipped, '*empty' is set if none of them exist
+// returns false on invalid argument
+bool Projection_ResolveSchemas
+(
+	SIValue arg,      // procedure argument
+	SchemaType t,     // schema type
+	int **ids,        // [output] schema IDs, NULL if argument is NULL
+	bool *empty       // [output] set if none of the schemas exist
+);
+
+// build projection matrix
+// when 'labels' is NULL all nodes are projected and row i is node i
+// otherwise '*mapping' maps each row to its node ID
+// an empty 'relations' array yields a matrix with no entries
+GrB_Matrix Projection_BuildMatrix
+(
+	Graph *g,             // graph
+	const int *labels,    // [optional] label IDs
+	const int *relations, // [optional] relationship type IDs
+	GrB_Index *n,         // [output] number of rows
+	GrB_Index **mapping   // [output] row to node ID mapping
+);
+
+// make projection undirected, A = A + A' and remove self loops
+void Projection_Undirected
+(
+	GrB_Matrix A  // projection matrix
+);
+
+// returns the row of node 'id', or -1 if node isn't projected
+int64_t Projection_NodeRow
+(
+	GrB_Index id,              // node ID
+	GrB_Index n,               // number of rows
+	const GrB_Index *mapping   // row to node ID mapping, NULL for identity
+);
+
+// returns node ID of row 'row'
+static inline NodeID Projection_RowNode
+(
+	GrB_Index row,            // projection row
+	const GrB_Index *mapping  // row to node ID mapping, NULL for identity
+) {
+	return (mapping != NULL) ? mapping[row] : row;
+}
+
+// set 'node's attribute 'attr' to 'v', a null 'v' removes the attribute
+// nodes already holding 'v' are left untouched, such that refreshing
+// a materialized result only updates nodes whose value changed
+// returns true if node was updated
+bool Projection_WriteAttribute
+(
+	Node *node,         // node to update
+	Attribute_ID attr,  // attribute to set
+	SIValue v           // value
+);
+
+// iterates over an algorithm's result vector, one entry per projected row
+// rows associated with deleted nodes are skipped
+typedef struct {
+	Graph *g;                  // graph
+	GxB_Iterator it;           // result vector iterator
+	const GrB_Index *mapping;  // row to node ID mapping, NULL for identity
+	bool depleted;             // iterator depleted
+} ProjectionIterator;
+
+// attach iterator to result vector 'v'
+void ProjectionIterator_Init
+(
+	ProjectionIterator *iter,  // iterator to initialize
+	Graph *g,                  // graph
+	GrB_Vector v,              // UINT64 result vector
+	const GrB_Index *mapping   // row to node ID mapping, NULL for identity
+);
+
+// advance iterator, returns false once depleted
+bool ProjectionIterator_Next
+(
+	ProjectionIterator *iter,  // iterator
+	Node *node,                // [output] node of current row
+	GrB_Index *row,            // [optional output] current row
+	uint64_t *value            // [output] current row's value
+);
+
+// free iterator, the vector is not freed
+void ProjectionIterator_Free
+(
+	ProjectionIterator *iter  // iterator to free
+);
+
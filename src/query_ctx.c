@@ -11,6 +11,7 @@
 #include "arithmetic/arithmetic_expression.h"
 #include "serializers/graphcontext_type.h"
 #include "undo_log/undo_log.h"
+#include "configuration/config.h"
 
 // GraphContext type as it is registered at Redis
 extern RedisModuleType *GraphContextRedisModuleType;
@@ -254,16 +255,56 @@ Graph *QueryCtx_GetGraph(void) {
 }
 
 // retrieve undo log
+// returns NULL if undo-logging is disabled
 UndoLog QueryCtx_GetUndoLog(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
 	ASSERT(ctx != NULL);
-	
+
+	if(ctx->internal_exec_ctx.undo_log_disabled) return NULL;
+
 	if(ctx->undo_log == NULL) {
 		ctx->undo_log = UndoLog_New();
 	}
 	return ctx->undo_log;
 }
 
+// mark query as abortable e.g. it is subject to a timeout
+// memory capped queries are considered abortable regardless
+void QueryCtx_SetAbortable
+(
+	QueryCtx *ctx,  // query context
+	bool abortable  // query may be aborted
+) {
+	ASSERT(ctx != NULL);
+
+	ctx->internal_exec_ctx.abortable = abortable;
+}
+
+// disable undo-logging for the remainder of the query
+// should be called once the query can no longer fail
+// returns false if undo-logging remains enabled
+bool QueryCtx_DisableUndoLog(void) {
+	QueryCtx *ctx = _QueryCtx_GetCtx();
+	ASSERT(ctx != NULL);
+
+	// an abortable query might still fail
+	if(ctx->internal_exec_ctx.abortable) return false;
+
+	// a memory capped query fails once it exceeds its capacity
+	// which might happen while or after the query commits
+	int64_t mem_capacity;
+	Config_Option_get(Config_QUERY_MEM_CAPACITY, &mem_capacity);
+	if(mem_capacity != QUERY_MEM_CAPACITY_UNLIMITED) return false;
+
+	ctx->internal_exec_ctx.undo_log_disabled = true;
+
+	// the query can't fail, modifications logged thus far
+	// will never be rolled back
+	UndoLog_Free(&ctx->undo_log);
+
+	return true;
+}
+
 // rollback the current command
 void QueryCtx_Rollback(void) {
 	QueryCtx *ctx = _QueryCtx_GetCtx();
@@ -425,6 +466,27 @@ void QueryCtx_UnlockCommit() {
 	_QueryCtx_UnlockCommit(ctx);
 }
 
+// hand over an acquired commit lock from one query to another
+// used by group commit, where consecutive write queries share a single
+// lock acquisition, 'to' becomes responsible for releasing the lock
+void QueryCtx_TransferCommitLock
+(
+	QueryCtx *from,  // query currently holding the commit lock
+	QueryCtx *to     // query taking over the commit lock
+) {
+	ASSERT(to   != NULL);
+	ASSERT(from != NULL);
+	ASSERT(from->gc == to->gc);
+	ASSERT(from->internal_exec_ctx.locked_for_commit  == true);
+	ASSERT(to->internal_exec_ctx.locked_for_commit    == false);
+
+	to->internal_exec_ctx.key                 = from->internal_exec_ctx.key;
+	to->internal_exec_ctx.locked_for_commit   = true;
+
+	from->internal_exec_ctx.key               = NULL;
+	from->internal_exec_ctx.locked_for_commit = false;
+}
+
 // replicate command to AOF/Replicas
 void QueryCtx_Replicate
 (
@@ -58,6 +58,8 @@ typedef struct {
 	RedisModuleKey *key;     // graph open key, for later extraction and closing
 	ResultSet *result_set;   // execution result set
 	bool locked_for_commit;  // indicates if QueryCtx_LockForCommit been called
+	bool abortable;          // query may be aborted e.g. due to a timeout
+	bool undo_log_disabled;  // modifications are not undo-logged
 } QueryCtx_InternalExecCtx;
 
 typedef struct {
@@ -181,8 +183,23 @@ GraphContext *QueryCtx_GetGraphCtx(void);
 Graph *QueryCtx_GetGraph(void);
 
 // retrieve undo log
+// returns NULL if undo-logging is disabled
 UndoLog QueryCtx_GetUndoLog(void);
 
+// mark query as abortable e.g. it is subject to a timeout
+// memory capped queries are considered abortable regardless
+// abortable queries must undo-log all of their modifications
+void QueryCtx_SetAbortable
+(
+	QueryCtx *ctx,  // query context
+	bool abortable  // query may be aborted
+);
+
+// disable undo-logging for the remainder of the query
+// should be called once the query can no longer fail
+// returns false if undo-logging remains enabled
+bool QueryCtx_DisableUndoLog(void);
+
 // rollback the current command
 void QueryCtx_Rollback(void);
 
@@ -224,6 +241,15 @@ bool QueryCtx_LockForCommit(void);
 // 4. unlock GIL
 void QueryCtx_UnlockCommit(void);
 
+// hand over an acquired commit lock from one query to another
+// used by group commit, where consecutive write queries share a single
+// lock acquisition, 'to' becomes responsible for releasing the lock
+void QueryCtx_TransferCommitLock
+(
+	QueryCtx *from,  // query currently holding the commit lock
+	QueryCtx *to     // query taking over the commit lock
+);
+
 // replicate command to AOF/Replicas
 void QueryCtx_Replicate
 (
@@ -29,9 +29,42 @@ typedef enum {
 	VALUE_NODE = 8,
 	VALUE_PATH = 9,
 	VALUE_MAP = 10,
-	VALUE_POINT = 11
+	VALUE_POINT = 11,
+	VALUE_VECTORF32 = 12
 } ValueType;
 
+// map SIValue type to its reply value type
+static inline ValueType _mapValueType(const SIValue v) {
+	switch(SI_TYPE(v)) {
+	case T_NULL:
+		return VALUE_NULL;
+	case T_STRING:
+		return VALUE_STRING;
+	case T_INT64:
+		return VALUE_INTEGER;
+	case T_BOOL:
+		return VALUE_BOOLEAN;
+	case T_DOUBLE:
+		return VALUE_DOUBLE;
+	case T_ARRAY:
+		return VALUE_ARRAY;
+	case T_NODE:
+		return VALUE_NODE;
+	case T_EDGE:
+		return VALUE_EDGE;
+	case T_PATH:
+		return VALUE_PATH;
+	case T_MAP:
+		return VALUE_MAP;
+	case T_POINT:
+		return VALUE_POINT;
+	case T_VECTOR_F32:
+		return VALUE_VECTORF32;
+	default:
+		return VALUE_UNKNOWN;
+	}
+}
+
 // Typedef for header formatters.
 typedef void (*EmitHeaderFunc)(RedisModuleCtx *ctx, const char **columns,
 							   uint *col_rec_map);
@@ -10,11 +10,13 @@
 #include "resultset_replynop.h"
 #include "resultset_replycompact.h"
 #include "resultset_replyverbose.h"
+#include "resultset_replybinary.h"
 
 typedef enum {
 	FORMATTER_NOP = 0,
 	FORMATTER_VERBOSE = 1,
 	FORMATTER_COMPACT = 2,
+	FORMATTER_BINARY = 3,
 } ResultSetFormatterType;
 
 /* Retrieves result-set formatter.
@@ -40,3 +42,10 @@ static ResultSetFormatter ResultSetFormatterVerbose __attribute__((used)) = {
 	.EmitHeader = ResultSet_ReplyWithVerboseHeader
 };
 
+/* Binary reply formatter, rows are packed into chunks by ResultSetChunk
+ * there's no per row formatting. */
+static ResultSetFormatter ResultSetFormatterBinary __attribute__((used)) = {
+	.EmitRow = NULL,
+	.EmitHeader = ResultSet_ReplyWithBinaryHeader
+};
+
@@ -0,0 +1,428 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "resultset_formatters.h"
+#include "RG.h"
+#include "../../util/arr.h"
+#include "../../util/rmalloc.h"
+#include "../../datatypes/datatypes.h"
+
+#include <string.h>
+
+// binary chunk layout, all fields are little-endian and packed
+//
+//    version       (uint32)
+//    row count     (uint32)  R
+//    column count  (uint32)  C
+//    heap size     (uint32)  H
+//    slots         C x R x (uint64)  column-major value slots
+//    types         C x R x (uint8)   column-major ValueType
+//    heap          H bytes
+//
+// slot content by value type:
+//    NULL          0
+//    BOOLEAN       0 / 1
+//    INTEGER       int64
+//    DOUBLE        IEEE 754 double
+//    POINT         latitude float in the low 4 bytes, longitude in the high 4
+//    all others    heap offset in the low 4 bytes, length in the high 4
+//
+// heap holds strings as raw bytes (no NUL terminator) and nested values
+// using the tagged encoding: ValueType (uint8) followed by its payload
+//    NULL          -
+//    BOOLEAN       uint8
+//    INTEGER       int64
+//    DOUBLE        double
+//    POINT         float latitude, float longitude
+//    STRING        length (uint32), bytes
+//    ARRAY         count (uint32), tagged values
+//    MAP           count (uint32), [key length (uint32), key bytes, tagged value]
+//    NODE          id (uint64), label count (uint32), label IDs (uint32),
+//                  attribute count (uint32), [attribute ID (uint32), tagged value]
+//    EDGE          id (uint64), relationship type ID (uint32), src ID (uint64),
+//                  dest ID (uint64),
+//                  attribute count (uint32), [attribute ID (uint32), tagged value]
+//    PATH          node count (uint32), nodes (NODE payload),
+//                  edge count (uint32), edges (EDGE payload)
+
+#define BINARY_CHUNK_HEADER_SIZE (4 * sizeof(uint32_t))
+
+// growable byte buffer
+typedef struct {
+	unsigned char *data;  // buffer bytes
+	size_t len;           // number of bytes used
+	size_t cap;           // buffer capacity
+} BinaryBuffer;
+
+struct ResultSetChunk {
+	uint ncols;         // number of columns
+	uint nrows;         // number of rows in chunk
+	uint64_t *slots;    // column-major value slots
+	uint8_t *types;     // column-major value types
+	BinaryBuffer heap;  // strings and nested values
+};
+
+static void _BinaryBuffer_Write
+(
+	BinaryBuffer *buf,  // buffer
+	const void *ptr,    // bytes to write
+	size_t n            // number of bytes
+) {
+	if(buf->len + n > buf->cap) {
+		size_t cap = buf->cap * 2;
+		if(cap < buf->len + n) cap = buf->len + n;
+		if(cap < 1024) cap = 1024;
+		buf->data = rm_realloc(buf->data, cap);
+		buf->cap  = cap;
+	}
+
+	memcpy(buf->data + buf->len, ptr, n);
+	buf->len += n;
+}
+
+static inline void _BinaryBuffer_WriteU8
+(
+	BinaryBuffer *buf,
+	uint8_t v
+) {
+	_BinaryBuffer_Write(buf, &v, sizeof(v));
+}
+
+static inline void _BinaryBuffer_WriteU32
+(
+	BinaryBuffer *buf,
+	uint32_t v
+) {
+	_BinaryBuffer_Write(buf, &v, sizeof(v));
+}
+
+static inline void _BinaryBuffer_WriteU64
+(
+	BinaryBuffer *buf,
+	uint64_t v
+) {
+	_BinaryBuffer_Write(buf, &v, sizeof(v));
+}
+
+// forward declaration
+static void _Binary_WriteValue(BinaryBuffer *heap, GraphContext *gc,
+		SIValue v);
+
+static void _Binary_WriteAttributes
+(
+	BinaryBuffer *heap,   // heap to write to
+	GraphContext *gc,     // graph context
+	const GraphEntity *e  // entity
+) {
+	const AttributeSet set = GraphEntity_GetAttributes(e);
+	uint16_t attr_count = AttributeSet_Count(set);
+
+	_BinaryBuffer_WriteU32(heap, attr_count);
+	for(uint16_t i = 0; i < attr_count; i++) {
+		Attribute_ID attr_id;
+		SIValue value = AttributeSet_GetIdx(set, i, &attr_id);
+		_BinaryBuffer_WriteU32(heap, attr_id);
+		_Binary_WriteValue(heap, gc, value);
+	}
+}
+
+static void _Binary_WriteNode
+(
+	BinaryBuffer *heap,  // heap to write to
+	GraphContext *gc,    // graph context
+	Node *n              // node
+) {
+	_BinaryBuffer_WriteU64(heap, ENTITY_GET_ID(n));
+
+	uint lbls_count;
+	NODE_GET_LABELS(gc->g, n, lbls_count);
+	_BinaryBuffer_WriteU32(heap, lbls_count);
+	for(uint i = 0; i < lbls_count; i++) {
+		_BinaryBuffer_WriteU32(heap, labels[i]);
+	}
+
+	_Binary_WriteAttributes(heap, gc, (GraphEntity *)n);
+}
+
+static void _Binary_WriteEdge
+(
+	BinaryBuffer *heap,  // heap to write to
+	GraphContext *gc,    // graph context
+	Edge *e              // edge
+) {
+	int reltype_id = Edge_GetRelationID(e);
+	ASSERT(reltype_id != GRAPH_NO_RELATION);
+
+	_BinaryBuffer_WriteU64(heap, ENTITY_GET_ID(e));
+	_BinaryBuffer_WriteU32(heap, reltype_id);
+	_BinaryBuffer_WriteU64(heap, Edge_GetSrcNodeID(e));
+	_BinaryBuffer_WriteU64(heap, Edge_GetDestNodeID(e));
+
+	_Binary_WriteAttributes(heap, gc, (GraphEntity *)e);
+}
+
+static void _Binary_WritePath
+(
+	BinaryBuffer *heap,  // heap to write to
+	GraphContext *gc,    // graph context
+	SIValue path         // path
+) {
+	size_t node_count = SIPath_NodeCount(path);
+	_BinaryBuffer_WriteU32(heap, node_count);
+	for(size_t i = 0; i < node_count; i++) {
+		SIValue n = SIPath_GetNode(path, i);
+		_Binary_WriteNode(heap, gc, n.ptrval);
+	}
+
+	size_t edge_count = SIPath_Length(path);
+	_BinaryBuffer_WriteU32(heap, edge_count);
+	for(size_t i = 0; i < edge_count; i++) {
+		SIValue e = SIPath_GetRelationship(path, i);
+		_Binary_WriteEdge(heap, gc, e.ptrval);
+	}
+}
+
+// write value's payload, without its tag
+static void _Binary_WritePayload
+(
+	BinaryBuffer *heap,  // heap to write to
+	GraphContext *gc,    // graph context
+	SIValue v            // value to write
+) {
+	switch(SI_TYPE(v)) {
+	case T_NULL:
+		return;
+	case T_BOOL:
+		_BinaryBuffer_WriteU8(heap, v.longval != 0);
+		return;
+	case T_INT64:
+		_BinaryBuffer_WriteU64(heap, (uint64_t)v.longval);
+		return;
+	case T_DOUBLE:
+		_BinaryBuffer_Write(heap, &v.doubleval, sizeof(double));
+		return;
+	case T_POINT:
+		_BinaryBuffer_Write(heap, &v.point.latitude, sizeof(float));
+		_BinaryBuffer_Write(heap, &v.point.longitude, sizeof(float));
+		return;
+	case T_VECTOR_F32: {
+		uint32_t dim = SIVector_Dim(v);
+		_BinaryBuffer_WriteU32(heap, dim);
+		_BinaryBuffer_Write(heap, SIVector_Elements(v), sizeof(float) * dim);
+		return;
+	}
+	case T_STRING: {
+		uint32_t len = strlen(v.stringval);
+		_BinaryBuffer_WriteU32(heap, len);
+		_BinaryBuffer_Write(heap, v.stringval, len);
+		return;
+	}
+	case T_ARRAY: {
+		uint32_t len = SIArray_Length(v);
+		_BinaryBuffer_WriteU32(heap, len);
+		for(uint32_t i = 0; i < len; i++) {
+			_Binary_WriteValue(heap, gc, SIArray_Get(v, i));
+		}
+		return;
+	}
+	case T_MAP: {
+		uint32_t key_count = Map_KeyCount(v);
+		_BinaryBuffer_WriteU32(heap, key_count);
+		for(uint32_t i = 0; i < key_count; i++) {
+			Pair p = v.map[i];
+			uint32_t len = strlen(p.key.stringval);
+			_BinaryBuffer_WriteU32(heap, len);
+			_BinaryBuffer_Write(heap, p.key.stringval, len);
+			_Binary_WriteValue(heap, gc, p.val);
+		}
+		return;
+	}
+	case T_NODE:
+		_Binary_WriteNode(heap, gc, v.ptrval);
+		return;
+	case T_EDGE:
+		_Binary_WriteEdge(heap, gc, v.ptrval);
+		return;
+	case T_PATH:
+		_Binary_WritePath(heap, gc, v);
+		return;
+	default:
+		RedisModule_Assert("Unhandled value type" && false);
+		break;
+	}
+}
+
+// write tagged value
+static void _Binary_WriteValue
+(
+	BinaryBuffer *heap,  // heap to write to
+	GraphContext *gc,    // graph context
+	SIValue v            // value to write
+) {
+	_BinaryBuffer_WriteU8(heap, _mapValueType(v));
+	_Binary_WritePayload(heap, gc, v);
+}
+
+// compute value's slot, heap allocated values are written to the heap
+static uint64_t _Binary_Slot
+(
+	BinaryBuffer *heap,  // heap to write to
+	GraphContext *gc,    // graph context
+	SIValue v            // value
+) {
+	uint64_t slot   = 0;
+	size_t   offset = heap->len;
+
+	switch(SI_TYPE(v)) {
+	case T_NULL:
+		return 0;
+	case T_BOOL:
+		return v.longval != 0;
+	case T_INT64:
+		return (uint64_t)v.longval;
+	case T_DOUBLE:
+		memcpy(&slot, &v.doubleval, sizeof(double));
+		return slot;
+	case T_POINT:
+		memcpy(&slot, &v.point.latitude, sizeof(float));
+		memcpy((unsigned char *)&slot + sizeof(float), &v.point.longitude,
+				sizeof(float));
+		return slot;
+	case T_STRING:
+		_BinaryBuffer_Write(heap, v.stringval, strlen(v.stringval));
+		break;
+	default:
+		// nested values are written without their tag
+		// as the tag is already present in the types section
+		_Binary_WritePayload(heap, gc, v);
+		break;
+	}
+
+	uint64_t len = heap->len - offset;
+	ASSERT(heap->len <= UINT32_MAX);
+	return (len << 32) | (uint64_t)offset;
+}
+
+// create a new binary chunk
+ResultSetChunk *ResultSetChunk_New
+(
+	uint ncols  // number of columns in each row
+) {
+	ASSERT(ncols > 0);
+
+	ResultSetChunk *chunk = rm_calloc(1, sizeof(ResultSetChunk));
+
+	chunk->ncols = ncols;
+	chunk->slots = rm_malloc(sizeof(uint64_t) * ncols * BINARY_CHUNK_ROWS);
+	chunk->types = rm_malloc(sizeof(uint8_t)  * ncols * BINARY_CHUNK_ROWS);
+
+	return chunk;
+}
+
+// add row to chunk
+// returns true if chunk is full and should be emitted
+bool ResultSetChunk_AddRow
+(
+	ResultSetChunk *chunk,  // chunk to add row to
+	GraphContext *gc,       // graph context
+	SIValue **row           // row to add
+) {
+	ASSERT(row   != NULL);
+	ASSERT(chunk != NULL);
+	ASSERT(chunk->nrows < BINARY_CHUNK_ROWS);
+
+	uint r = chunk->nrows;
+	for(uint c = 0; c < chunk->ncols; c++) {
+		size_t  idx = (size_t)c * BINARY_CHUNK_ROWS + r;
+		SIValue v   = *row[c];
+
+		chunk->types[idx] = _mapValueType(v);
+		chunk->slots[idx] = _Binary_Slot(&chunk->heap, gc, v);
+	}
+
+	chunk->nrows++;
+
+	return (chunk->nrows == BINARY_CHUNK_ROWS ||
+			chunk->heap.len >= BINARY_CHUNK_HEAP_SIZE);
+}
+
+// returns number of rows in chunk
+uint ResultSetChunk_RowCount
+(
+	const ResultSetChunk *chunk  // chunk
+) {
+	ASSERT(chunk != NULL);
+	return chunk->nrows;
+}
+
+// emit chunk as a single bulk string and reset it
+void ResultSetChunk_Emit
+(
+	RedisModuleCtx *ctx,   // redis module context
+	ResultSetChunk *chunk  // chunk to emit
+) {
+	ASSERT(ctx   != NULL);
+	ASSERT(chunk != NULL);
+
+	uint   nrows = chunk->nrows;
+	uint   ncols = chunk->ncols;
+	size_t heap  = chunk->heap.len;
+	size_t size  = BINARY_CHUNK_HEADER_SIZE +
+		(size_t)nrows * ncols * (sizeof(uint64_t) + sizeof(uint8_t)) + heap;
+
+	unsigned char *buf = rm_malloc(size);
+	unsigned char *p   = buf;
+
+	uint32_t header[4] = {BINARY_CHUNK_VERSION, nrows, ncols, heap};
+	memcpy(p, header, sizeof(header));
+	p += sizeof(header);
+
+	// columns are allocated for a full chunk, copy only used rows
+	for(uint c = 0; c < ncols; c++) {
+		size_t n = sizeof(uint64_t) * nrows;
+		memcpy(p, chunk->slots + (size_t)c * BINARY_CHUNK_ROWS, n);
+		p += n;
+	}
+
+	for(uint c = 0; c < ncols; c++) {
+		size_t n = sizeof(uint8_t) * nrows;
+		memcpy(p, chunk->types + (size_t)c * BINARY_CHUNK_ROWS, n);
+		p += n;
+	}
+
+	if(heap > 0) {
+		memcpy(p, chunk->heap.data, heap);
+		p += heap;
+	}
+
+	ASSERT((size_t)(p - buf) == size);
+	RedisModule_ReplyWithStringBuffer(ctx, (const char *)buf, size);
+	rm_free(buf);
+
+	// reset chunk
+	chunk->nrows    = 0;
+	chunk->heap.len = 0;
+}
+
+// free chunk
+void ResultSetChunk_Free
+(
+	ResultSetChunk *chunk  // chunk to free
+) {
+	ASSERT(chunk != NULL);
+
+	rm_free(chunk->slots);
+	rm_free(chunk->types);
+	if(chunk->heap.data != NULL) rm_free(chunk->heap.data);
+	rm_free(chunk);
+}
+
+// the binary header is identical to the compact header
+void ResultSet_ReplyWithBinaryHeader(RedisModuleCtx *ctx, const char **columns,
+		uint *col_rec_map) {
+	ResultSet_ReplyWithCompactHeader(ctx, columns, col_rec_map);
+}
+
@@ -0,0 +1,60 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#pragma once
+
+// max number of rows packed into a single chunk
+#define BINARY_CHUNK_ROWS 4096
+
+// a chunk is emitted once its string heap exceeds this size
+#define BINARY_CHUNK_HEAP_SIZE (1 << 20)
+
+// binary chunk layout version
+#define BINARY_CHUNK_VERSION 1
+
+// binary result-set chunk
+// packs multiple rows into a single bulk string
+typedef struct ResultSetChunk ResultSetChunk;
+
+// formatter for binary (client-parsed) replies
+// the header is identical to the compact header
+void ResultSet_ReplyWithBinaryHeader(RedisModuleCtx *ctx, const char **columns,
+		uint *col_rec_map);
+
+// create a new binary chunk
+ResultSetChunk *ResultSetChunk_New
+(
+	uint ncols  // number of columns in each row
+);
+
+// add row to chunk
+// returns true if chunk is full and should be emitted
+bool ResultSetChunk_AddRow
+(
+	ResultSetChunk *chunk,  // chunk to add row to
+	GraphContext *gc,       // graph context
+	SIValue **row           // row to add
+);
+
+// returns number of rows in chunk
+uint ResultSetChunk_RowCount
+(
+	const ResultSetChunk *chunk  // chunk
+);
+
+// emit chunk as a single bulk string and reset it
+void ResultSetChunk_Emit
+(
+	RedisModuleCtx *ctx,   // redis module context
+	ResultSetChunk *chunk  // chunk to emit
+);
+
+// free chunk
+void ResultSetChunk_Free
+(
+	ResultSetChunk *chunk  // chunk to free
+);
+
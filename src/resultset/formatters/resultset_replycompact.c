@@ -16,35 +16,7 @@ static void _ResultSet_CompactReplyWithSIArray(RedisModuleCtx *ctx, GraphContext
 static void _ResultSet_CompactReplyWithPath(RedisModuleCtx *ctx, GraphContext *gc, SIValue path);
 static void _ResultSet_CompactReplyWithMap(RedisModuleCtx *ctx, GraphContext *gc, SIValue v);
 static void _ResultSet_CompactReplyWithPoint(RedisModuleCtx *ctx, GraphContext *gc, SIValue v);
-
-static inline ValueType _mapValueType(const SIValue v) {
-	switch(SI_TYPE(v)) {
-	case T_NULL:
-		return VALUE_NULL;
-	case T_STRING:
-		return VALUE_STRING;
-	case T_INT64:
-		return VALUE_INTEGER;
-	case T_BOOL:
-		return VALUE_BOOLEAN;
-	case T_DOUBLE:
-		return VALUE_DOUBLE;
-	case T_ARRAY:
-		return VALUE_ARRAY;
-	case T_NODE:
-		return VALUE_NODE;
-	case T_EDGE:
-		return VALUE_EDGE;
-	case T_PATH:
-		return VALUE_PATH;
-	case T_MAP:
-		return VALUE_MAP;
-	case T_POINT:
-		return VALUE_POINT;
-	default:
-		return VALUE_UNKNOWN;
-	}
-}
+static void _ResultSet_CompactReplyWithVector(RedisModuleCtx *ctx, GraphContext *gc, SIValue v);
 
 static inline void _ResultSet_ReplyWithValueType(RedisModuleCtx *ctx, const SIValue v) {
 	RedisModule_ReplyWithLongLong(ctx, _mapValueType(v));
@@ -90,6 +62,9 @@ static void _ResultSet_CompactReplyWithSIValue(RedisModuleCtx *ctx, GraphContext
 	case T_POINT:
 		_ResultSet_CompactReplyWithPoint(ctx, gc, v);
 		return;
+	case T_VECTOR_F32:
+		_ResultSet_CompactReplyWithVector(ctx, gc, v);
+		return;
 	default:
 		RedisModule_Assert("Unhandled value type" && false);
 		break;
@@ -275,6 +250,18 @@ static void _ResultSet_CompactReplyWithPoint(RedisModuleCtx *ctx, GraphContext *
 	_ResultSet_ReplyWithRoundedDouble(ctx, Point_lon(v));
 }
 
+static void _ResultSet_CompactReplyWithVector(RedisModuleCtx *ctx, GraphContext *gc, SIValue v) {
+	ASSERT(SI_TYPE(v) == T_VECTOR_F32);
+
+	uint32_t dim = SIVector_Dim(v);
+	const float *values = SIVector_Elements(v);
+
+	RedisModule_ReplyWithArray(ctx, dim);
+	for(uint32_t i = 0; i < dim; i++) {
+		_ResultSet_ReplyWithRoundedDouble(ctx, values[i]);
+	}
+}
+
 void ResultSet_EmitCompactRow(RedisModuleCtx *ctx, GraphContext *gc,
 							  SIValue **row, uint numcols) {
 	// Prepare return array sized to the number of RETURN entities
@@ -12,6 +12,7 @@
 static void _ResultSet_VerboseReplyWithMap(RedisModuleCtx *ctx, SIValue map);
 static void _ResultSet_VerboseReplyWithPath(RedisModuleCtx *ctx, SIValue path);
 static void _ResultSet_VerboseReplyWithPoint(RedisModuleCtx *ctx, SIValue point);
+static void _ResultSet_VerboseReplyWithVector(RedisModuleCtx *ctx, SIValue vector);
 static void _ResultSet_VerboseReplyWithArray(RedisModuleCtx *ctx, SIValue array);
 static void _ResultSet_VerboseReplyWithNode(RedisModuleCtx *ctx, GraphContext *gc, Node *n);
 static void _ResultSet_VerboseReplyWithEdge(RedisModuleCtx *ctx, GraphContext *gc, Edge *e);
@@ -56,6 +57,9 @@ static void _ResultSet_VerboseReplyWithSIValue(RedisModuleCtx *ctx, GraphContext
 	case T_POINT:
 		_ResultSet_VerboseReplyWithPoint(ctx, v);
 		return;
+	case T_VECTOR_F32:
+		_ResultSet_VerboseReplyWithVector(ctx, v);
+		return;
 	default:
 		RedisModule_Assert("Unhandled value type" && false);
 	}
@@ -194,6 +198,17 @@ static void _ResultSet_VerboseReplyWithPoint(RedisModuleCtx *ctx, SIValue point)
 	RedisModule_ReplyWithStringBuffer(ctx, buffer, bytes_written);
 }
 
+static void _ResultSet_VerboseReplyWithVector(RedisModuleCtx *ctx, SIValue vector) {
+	// vectors are emitted as a list of floats
+	uint32_t dim = SIVector_Dim(vector);
+	const float *values = SIVector_Elements(vector);
+
+	RedisModule_ReplyWithArray(ctx, dim);
+	for(uint32_t i = 0; i < dim; i++) {
+		_ResultSet_ReplyWithRoundedDouble(ctx, values[i]);
+	}
+}
+
 void ResultSet_EmitVerboseRow(RedisModuleCtx *ctx, GraphContext *gc,
 							  SIValue **row, uint numcols) {
 	// Prepare return array sized to the number of RETURN entities
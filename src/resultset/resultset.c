@@ -73,6 +73,11 @@ ResultSet *NewResultSet
 	set->column_count        =  0;
 	set->cells_allocation    =  M_NONE;
 	set->columns_record_map  =  NULL;
+	set->streaming           =  false;
+	set->streamed            =  false;
+	set->streamed_rows       =  0;
+	set->chunk               =  NULL;
+	set->chunk_count         =  0;
 
 	// init resultset statistics
 	ResultSetStat_init(&set->stats);
@@ -88,6 +93,11 @@ ResultSet *NewResultSet
 		// allocate enough space for at least 10 rows
 		uint64_t nrows = set->column_count * 10;
 		set->cells = DataBlock_New(16384, nrows, sizeof(SIValue), NULL);
+
+		// binary rows are packed into chunks
+		if(set->format == FORMATTER_BINARY) {
+			set->chunk = ResultSetChunk_New(set->column_count);
+		}
 	}
 
 	return set;
@@ -116,6 +126,26 @@ void ResultSet_MapProjection
 	}
 }
 
+// switch resultset to streaming mode
+// rows are formatted into the reply as they're added
+// instead of being accumulated until the query completes
+void ResultSet_EnableStreaming
+(
+	ResultSet *set  // resultset to stream
+) {
+	ASSERT(set != NULL);
+	ASSERT(set->streamed == false);
+
+	// nothing to stream
+	if(set->column_count == 0) return;
+
+	set->streaming = true;
+
+	// rows are never accumulated
+	DataBlock_Free(set->cells);
+	set->cells = NULL;
+}
+
 // returns number of rows in result-set
 uint64_t ResultSet_RowCount
 (
@@ -124,9 +154,82 @@ uint64_t ResultSet_RowCount
 	ASSERT(set != NULL);
 
 	if(set->column_count == 0) return 0;
+	if(set->streaming) return set->streamed_rows;
 	return DataBlock_ItemCount(set->cells) / set->column_count;
 }
 
+// open the rows array
+// binary replies emit a chunk per multiple rows, the number of chunks
+// isn't known upfront
+static void _ResultSet_OpenRows
+(
+	ResultSet *set,  // resultset
+	uint64_t nrows   // number of rows, REDISMODULE_POSTPONED_LEN if unknown
+) {
+	if(set->chunk != NULL) nrows = REDISMODULE_POSTPONED_LEN;
+	RedisModule_ReplyWithArray(set->ctx, nrows);
+}
+
+// emit a single row
+static void _ResultSet_EmitRow
+(
+	ResultSet *set,  // resultset
+	SIValue **row    // row to emit
+) {
+	if(set->chunk == NULL) {
+		set->formatter->EmitRow(set->ctx, set->gc, row, set->column_count);
+		return;
+	}
+
+	// emit chunk once it's full
+	if(ResultSetChunk_AddRow(set->chunk, set->gc, row)) {
+		ResultSetChunk_Emit(set->ctx, set->chunk);
+		set->chunk_count++;
+	}
+}
+
+// close the rows array, emitting any pending binary rows
+static void _ResultSet_CloseRows
+(
+	ResultSet *set  // resultset
+) {
+	if(set->chunk != NULL) {
+		if(ResultSetChunk_RowCount(set->chunk) > 0) {
+			ResultSetChunk_Emit(set->ctx, set->chunk);
+			set->chunk_count++;
+		}
+		RedisModule_ReplySetArrayLength(set->ctx, set->chunk_count);
+	} else if(set->streamed) {
+		RedisModule_ReplySetArrayLength(set->ctx, set->streamed_rows);
+	}
+}
+
+// format record's projected values directly into the reply
+static void _ResultSet_StreamRecord
+(
+	ResultSet *set,  // resultset to stream to
+	Record r         // record containing projected data
+) {
+	// open reply on first row
+	// the number of rows isn't known upfront, rows array length is
+	// set once the query completes
+	if(!set->streamed) {
+		_ResultSet_ReplyWithPreamble(set);
+		_ResultSet_OpenRows(set, REDISMODULE_POSTPONED_LEN);
+		set->streamed = true;
+	}
+
+	SIValue  vals[set->column_count];
+	SIValue *row[set->column_count];
+	for(uint i = 0; i < set->column_count; i++) {
+		vals[i] = Record_Get(r, set->columns_record_map[i]);
+		row[i]  = vals + i;
+	}
+
+	_ResultSet_EmitRow(set, row);
+	set->streamed_rows++;
+}
+
 // add a new row to resultset
 int ResultSet_AddRecord
 (
@@ -136,6 +239,14 @@ int ResultSet_AddRecord
 	ASSERT(r   != NULL);
 	ASSERT(set != NULL);
 
+	if(set->streaming) {
+		_ResultSet_StreamRecord(set, r);
+		for(int i = 0; i < set->column_count; i++) {
+			Record_Remove(r, set->columns_record_map[i]);
+		}
+		return RESULTSET_OK;
+	}
+
 	// copy projected values from record to resultset
 	for(int i = 0; i < set->column_count; i++) {
 		int idx = set->columns_record_map[i];
@@ -230,6 +341,19 @@ void ResultSet_Reply
 
 	uint64_t row_count = ResultSet_RowCount(set);
 
+	// streamed rows are already part of the reply
+	// close the rows array and emit either the error or the statistics
+	// as the trailing record
+	if(set->streamed) {
+		_ResultSet_CloseRows(set);
+		if(ErrorCtx_EncounteredError()) {
+			ErrorCtx_EmitException();
+		} else {
+			ResultSetStat_emit(set->ctx, &set->stats);
+		}
+		return;
+	}
+
 	// check to see if we've encountered a run-time error
 	// if so, emit it as the only response
 	if(ErrorCtx_EncounteredError()) {
@@ -241,8 +365,11 @@ void ResultSet_Reply
 	_ResultSet_ReplyWithPreamble(set);
 
 	// emit resultset
-	if(set->column_count > 0) {
-		RedisModule_ReplyWithArray(set->ctx, row_count);
+	if(set->streaming) {
+		// streaming query which didn't produce any rows
+		RedisModule_ReplyWithArray(set->ctx, 0);
+	} else if(set->column_count > 0) {
+		_ResultSet_OpenRows(set, row_count);
 		SIValue *row[set->column_count];
 		uint64_t cells = DataBlock_ItemCount(set->cells);
 		// for each row
@@ -252,8 +379,9 @@ void ResultSet_Reply
 				row[j] = DataBlock_GetItem(set->cells, i + j);
 			}
 
-			set->formatter->EmitRow(set->ctx, set->gc, row, set->column_count);
+			_ResultSet_EmitRow(set, row);
 		}
+		_ResultSet_CloseRows(set);
 	}
 
 	ResultSetStat_emit(set->ctx, &set->stats); // response with statistics
@@ -296,5 +424,9 @@ void ResultSet_Free
 		DataBlock_Free(set->cells);
 	}
 
+	if(set->chunk) {
+		ResultSetChunk_Free(set->chunk);
+	}
+
 	rm_free(set);
 }
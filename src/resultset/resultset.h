@@ -27,6 +27,11 @@ typedef struct {
 	ResultSetFormatterType format;  // result set format; compact/verbose/nop
 	ResultSetFormatter *formatter;  // result set data formatter
 	SIAllocation cells_allocation;  // encountered values allocation
+	bool streaming;                 // emit rows as they're added
+	bool streamed;                  // streaming reply has been opened
+	uint64_t streamed_rows;         // number of rows emitted by streaming
+	ResultSetChunk *chunk;          // pending rows, binary format only
+	uint64_t chunk_count;           // number of binary chunks emitted
 } ResultSet;
 
 // map each column to a record index
@@ -45,6 +50,14 @@ ResultSet *NewResultSet
 	ResultSetFormatterType format  // resultset format
 );
 
+// switch resultset to streaming mode
+// rows are formatted into the reply as they're added
+// instead of being accumulated until the query completes
+void ResultSet_EnableStreaming
+(
+	ResultSet *set  // resultset to stream
+);
+
 // returns number of rows in result-set
 uint64_t ResultSet_RowCount
 (
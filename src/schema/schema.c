@@ -103,7 +103,8 @@ static int Schema_AddFullTextIndex
 		if(active != NULL) {
 			_idx = Index_Clone(active);
 		} else {
-			_idx = Index_New(s->name, s->id, IDX_FULLTEXT, GETYPE_NODE);
+			GraphEntityType et = (s->type == SCHEMA_NODE) ? GETYPE_NODE : GETYPE_EDGE;
+			_idx = Index_New(s->name, s->id, IDX_FULLTEXT, et);
 		}
 	}
 	PENDING_FULLTEXT_IDX(s) = _idx;  // set pending full-text index
@@ -114,6 +115,34 @@ static int Schema_AddFullTextIndex
 	return INDEX_OK;
 }
 
+// add a vector index to schema
+// a schema holds at most one vector index, over a single attribute
+static int Schema_AddVectorIndex
+(
+	Index *idx,        // [input/output] index to create
+	Schema *s,         // schema holding the index
+	IndexField *field  // field to index
+) {
+	ASSERT(s != NULL);
+	ASSERT(idx != NULL);
+	ASSERT(field != NULL);
+
+	// vector index already exists
+	if(ACTIVE_VECTOR_IDX(s) != NULL || PENDING_VECTOR_IDX(s) != NULL) {
+		IndexField_Free(field);
+		return INDEX_FAIL;
+	}
+
+	GraphEntityType et = (s->type == SCHEMA_NODE) ? GETYPE_NODE : GETYPE_EDGE;
+	Index _idx = Index_New(s->name, s->id, IDX_VECTOR, et);
+	PENDING_VECTOR_IDX(s) = _idx;  // set pending vector index
+
+	Index_AddField(_idx, field);
+
+	*idx = _idx;
+	return INDEX_OK;
+}
+
 static int _Schema_RemoveExactMatchIndex
 (
 	Schema *s,
@@ -229,6 +258,52 @@ static int _Schema_RemoveFullTextIndex
 	return INDEX_OK;
 }
 
+static int _Schema_RemoveVectorIndex
+(
+	Schema *s,
+	const char *field
+) {
+	ASSERT(s != NULL);
+	ASSERT(field != NULL);
+
+	GraphContext *gc = QueryCtx_GetGraphCtx();
+
+	Index active  = ACTIVE_VECTOR_IDX(s);
+	Index pending = PENDING_VECTOR_IDX(s);
+	Index idx     = (pending != NULL) ? pending : active;
+
+	// vector index doesn't exists
+	if(idx == NULL) {
+		return INDEX_FAIL;
+	}
+
+	// index doesn't containts attribute
+	Attribute_ID attr_id = GraphContext_GetAttributeID(gc, field);
+	if(!Index_ContainsAttribute(idx, attr_id)) {
+		return INDEX_FAIL;
+	}
+
+	// disconnect both active and pending indicies from schema
+	ACTIVE_VECTOR_IDX(s)  = NULL;
+	PENDING_VECTOR_IDX(s) = NULL;
+
+	//--------------------------------------------------------------------------
+	// disable and async drop
+	//--------------------------------------------------------------------------
+
+	if(active != NULL) {
+		Index_Disable(active);
+		Indexer_DropIndex(active, gc);
+	}
+
+	if(pending != NULL) {
+		Index_Disable(pending);
+		Indexer_DropIndex(pending, gc);
+	}
+
+	return INDEX_OK;
+}
+
 static void Schema_ActivateExactMatchIndex
 (
 	Schema *s   // schema to activate index on
@@ -284,6 +359,25 @@ static void Schema_ActivateFullTextIdx
 	PENDING_FULLTEXT_IDX(s) = NULL;
 }
 
+static void Schema_ActivateVectorIdx
+(
+	Schema *s   // schema to activate index on
+) {
+	Index active  = ACTIVE_VECTOR_IDX(s);
+	Index pending = PENDING_VECTOR_IDX(s);
+
+	// drop active if exists
+	if(active != NULL) {
+		Index_Free(active);
+	}
+
+	// set pending index as active
+	ACTIVE_VECTOR_IDX(s) = pending;
+
+	// clear pending index
+	PENDING_VECTOR_IDX(s) = NULL;
+}
+
 Schema *Schema_New
 (
 	SchemaType type,
@@ -345,7 +439,9 @@ bool Schema_HasIndices
 	return (ACTIVE_FULLTEXT_IDX(s)   ||
 			PENDING_FULLTEXT_IDX(s)  ||
 			ACTIVE_EXACTMATCH_IDX(s) ||
-			PENDING_EXACTMATCH_IDX(s));
+			PENDING_EXACTMATCH_IDX(s) ||
+			ACTIVE_VECTOR_IDX(s)      ||
+			PENDING_VECTOR_IDX(s));
 }
 
 unsigned short Schema_IndexCount
@@ -357,6 +453,7 @@ unsigned short Schema_IndexCount
 
 	if(ACTIVE_FULLTEXT_IDX(s) || PENDING_FULLTEXT_IDX(s)) n += 1;
 	if(ACTIVE_EXACTMATCH_IDX(s) || PENDING_EXACTMATCH_IDX(s)) n += 1;
+	if(ACTIVE_VECTOR_IDX(s) || PENDING_VECTOR_IDX(s)) n += 1;
 
 	return n;
 }
@@ -366,11 +463,13 @@ unsigned short Schema_IndexCount
 // pending exact-match index
 // active fulltext index
 // pending fulltext index
+// active vector index
+// pending vector index
 // returns number of indicies set
 unsigned short Schema_GetIndicies
 (
 	const Schema *s,
-	Index indicies[4]
+	Index indicies[6]
 ) {
 	int i = 0;
 
@@ -390,6 +489,14 @@ unsigned short Schema_GetIndicies
 		indicies[i++] = PENDING_FULLTEXT_IDX(s);
 	}
 
+	if(ACTIVE_VECTOR_IDX(s) != NULL) {
+		indicies[i++] = ACTIVE_VECTOR_IDX(s);
+	}
+
+	if(PENDING_VECTOR_IDX(s) != NULL) {
+		indicies[i++] = PENDING_VECTOR_IDX(s);
+	}
+
 	return i;
 }
 
@@ -417,6 +524,9 @@ Index Schema_GetIndex
 		if(type == IDX_FULLTEXT) {
 			indicies[0] = ACTIVE_FULLTEXT_IDX(s);
 			if(include_pending) indicies[1] = PENDING_FULLTEXT_IDX(s);
+		} else if(type == IDX_VECTOR) {
+			indicies[0] = ACTIVE_VECTOR_IDX(s);
+			if(include_pending) indicies[1] = PENDING_VECTOR_IDX(s);
 		} else {
 			indicies[0] = ACTIVE_EXACTMATCH_IDX(s);
 			if(include_pending) indicies[1] = PENDING_EXACTMATCH_IDX(s);
@@ -480,6 +590,8 @@ int Schema_AddIndex
 
 	if(type == IDX_FULLTEXT) {
 		res = Schema_AddFullTextIndex(idx, s, field);
+	} else if(type == IDX_VECTOR) {
+		res = Schema_AddVectorIndex(idx, s, field);
 	} else {
 		res = Schema_AddExactMatchIndex(idx, s, field);
 	}
@@ -500,6 +612,8 @@ int Schema_RemoveIndex
 			return _Schema_RemoveFullTextIndex(s);
 		case IDX_EXACT_MATCH:
 			return _Schema_RemoveExactMatchIndex(s, field);
+		case IDX_VECTOR:
+			return _Schema_RemoveVectorIndex(s, field);
 		default:
 			return INDEX_FAIL;
 	}
@@ -519,12 +633,17 @@ void Schema_ActivateIndex
 
 	Index pending_full_text   = PENDING_FULLTEXT_IDX(s);
 	Index pending_exact_match = PENDING_EXACTMATCH_IDX(s);
+	Index pending_vector      = PENDING_VECTOR_IDX(s);
 
 	// index to activate must be a pending index
-	ASSERT(idx == pending_exact_match || idx == pending_full_text);
+	ASSERT(idx == pending_exact_match ||
+		   idx == pending_full_text   ||
+		   idx == pending_vector);
 
 	if(idx == pending_exact_match) {
 		Schema_ActivateExactMatchIndex(s);
+	} else if(idx == pending_vector) {
+		Schema_ActivateVectorIdx(s);
 	} else {
 		Schema_ActivateFullTextIdx(s);
 	}
@@ -552,6 +671,12 @@ void Schema_AddNodeToIndices
 
 	idx = PENDING_FULLTEXT_IDX(s);
 	if(idx != NULL) Index_IndexNode(idx, n);
+
+	idx = ACTIVE_VECTOR_IDX(s);
+	if(idx != NULL) Index_IndexNode(idx, n);
+
+	idx = PENDING_VECTOR_IDX(s);
+	if(idx != NULL) Index_IndexNode(idx, n);
 }
 
 // index edge under all schema indices
@@ -570,6 +695,12 @@ void Schema_AddEdgeToIndices
 
 	idx = PENDING_EXACTMATCH_IDX(s);
 	if(idx != NULL) Index_IndexEdge(idx, e);
+
+	idx = ACTIVE_FULLTEXT_IDX(s);
+	if(idx != NULL) Index_IndexEdge(idx, e);
+
+	idx = PENDING_FULLTEXT_IDX(s);
+	if(idx != NULL) Index_IndexEdge(idx, e);
 }
 
 // remove node from schema indicies
@@ -594,6 +725,12 @@ void Schema_RemoveNodeFromIndices
 
 	idx = PENDING_FULLTEXT_IDX(s);
 	if(idx != NULL) Index_RemoveNode(idx, n);
+
+	idx = ACTIVE_VECTOR_IDX(s);
+	if(idx != NULL) Index_RemoveNode(idx, n);
+
+	idx = PENDING_VECTOR_IDX(s);
+	if(idx != NULL) Index_RemoveNode(idx, n);
 }
 
 // remove edge from schema indicies
@@ -612,6 +749,12 @@ void Schema_RemoveEdgeFromIndices
 
 	idx = PENDING_EXACTMATCH_IDX(s);
 	if(idx != NULL) Index_RemoveEdge(idx, e);
+
+	idx = ACTIVE_FULLTEXT_IDX(s);
+	if(idx != NULL) Index_RemoveEdge(idx, e);
+
+	idx = PENDING_FULLTEXT_IDX(s);
+	if(idx != NULL) Index_RemoveEdge(idx, e);
 }
 
 //------------------------------------------------------------------------------
@@ -801,6 +944,14 @@ void Schema_Free
 		Index_Free(ACTIVE_EXACTMATCH_IDX(s));
 	}
 
+	if(PENDING_VECTOR_IDX(s) != NULL) {
+		Index_Free(PENDING_VECTOR_IDX(s));
+	}
+
+	if(ACTIVE_VECTOR_IDX(s) != NULL) {
+		Index_Free(ACTIVE_VECTOR_IDX(s));
+	}
+
 	rm_free(s);
 }
 
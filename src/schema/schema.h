@@ -16,6 +16,8 @@
 #define PENDING_FULLTEXT_IDX(s)   s->fulltextIdx[1]
 #define ACTIVE_EXACTMATCH_IDX(s)  s->exactmatchIdx[0]
 #define PENDING_EXACTMATCH_IDX(s) s->exactmatchIdx[1]
+#define ACTIVE_VECTOR_IDX(s)      s->vectorIdx[0]
+#define PENDING_VECTOR_IDX(s)     s->vectorIdx[1]
 
 typedef enum {
 	SCHEMA_NODE,
@@ -31,6 +33,7 @@ typedef struct {
 	SchemaType type;            // schema type (node/edge)
 	Index fulltextIdx[2];       // full-text index
 	Index exactmatchIdx[2];     // active/pending exact-match index
+	Index vectorIdx[2];         // active/pending vector index
 	Constraint *constraints;    // constraints array
 } Schema;
 
@@ -65,7 +68,7 @@ SchemaType Schema_GetType
 	const Schema *s
 );
 
-// returns true if schema has either a full-text or exact-match index
+// returns true if schema has either a full-text, exact-match or vector index
 bool Schema_HasIndices
 (
 	const Schema *s
@@ -82,11 +85,13 @@ unsigned short Schema_IndexCount
 // pending exact-match index
 // active fulltext index
 // pending fulltext index
+// active vector index
+// pending vector index
 // returns number of indicies set
 unsigned short Schema_GetIndicies
 (
 	const Schema *s,
-	Index indicies[4]
+	Index indicies[6]
 );
 
 // get index from schema
@@ -251,6 +251,12 @@ GraphContext *RdbLoadGraphContext_v13
 				Index_Enable(idx);
 				Schema_ActivateIndex(s, idx);
 			}
+
+			idx = PENDING_FULLTEXT_IDX(s);
+			if(idx != NULL) {
+				Index_Enable(idx);
+				Schema_ActivateIndex(s, idx);
+			}
 		}
 
 		// make sure graph doesn't contains may pending changes
@@ -179,6 +179,7 @@ void RdbLoadEdges_v13
 		Schema *s = GraphContext_GetSchemaByID(gc, relation, SCHEMA_EDGE);
 		ASSERT(s != NULL);
 
+		if(PENDING_FULLTEXT_IDX(s)) Index_IndexEdge(PENDING_FULLTEXT_IDX(s), &e);
 		if(PENDING_EXACTMATCH_IDX(s)) Index_IndexEdge(PENDING_EXACTMATCH_IDX(s), &e);
 	}
 }
@@ -4,7 +4,7 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
-#include "encode_v13.h"
+#include "encode_v14.h"
 #include "../../../globals.h"
 
 // Determine whether we are in the context of a bgsave, in which case
@@ -65,7 +65,7 @@ static void _RdbSaveHeader
 	RedisModule_SaveUnsigned(rdb, header->key_count);
 
 	// save graph schemas
-	RdbSaveGraphSchema_v13(rdb, gc);
+	RdbSaveGraphSchema_v14(rdb, gc);
 }
 
 // returns a state information regarding the number of entities required
@@ -168,7 +168,7 @@ static PayloadInfo *_RdbSaveKeySchema
 	return payloads;
 }
 
-void RdbSaveGraph_v13
+void RdbSaveGraph_v14
 (
 	RedisModuleIO *rdb,
 	void *value
@@ -221,16 +221,16 @@ void RdbSaveGraph_v13
 		PayloadInfo payload = key_schema[i];
 		switch(payload.state) {
 		case ENCODE_STATE_NODES:
-			RdbSaveNodes_v13(rdb, gc, payload.entities_count);
+			RdbSaveNodes_v14(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_DELETED_NODES:
-			RdbSaveDeletedNodes_v13(rdb, gc, payload.entities_count);
+			RdbSaveDeletedNodes_v14(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_EDGES:
-			RdbSaveEdges_v13(rdb, gc, payload.entities_count);
+			RdbSaveEdges_v14(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_DELETED_EDGES:
-			RdbSaveDeletedEdges_v13(rdb, gc, payload.entities_count);
+			RdbSaveDeletedEdges_v14(rdb, gc, payload.entities_count);
 			break;
 		case ENCODE_STATE_GRAPH_SCHEMA:
 			// skip, handled in _RdbSaveHeader
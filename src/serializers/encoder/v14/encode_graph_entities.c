@@ -4,7 +4,7 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
-#include "encode_v13.h"
+#include "encode_v14.h"
 #include "../../../datatypes/datatypes.h"
 
 // forword decleration
@@ -58,6 +58,12 @@ static void _RdbSaveSIValue
 		case T_ARRAY:
 			_RdbSaveSIArray(rdb, *v);
 			return;
+		case T_VECTOR_F32:
+			// vector elements are saved as a single binary buffer
+			RedisModule_SaveUnsigned(rdb, SIVector_Dim(*v));
+			RedisModule_SaveStringBuffer(rdb, (const char *)SIVector_Elements(*v),
+					sizeof(float) * SIVector_Dim(*v));
+			return;
 		case T_POINT:
 			RedisModule_SaveDouble(rdb, Point_lat(*v));
 			RedisModule_SaveDouble(rdb, Point_lon(*v));
@@ -120,7 +126,7 @@ static void _RdbSaveEdge
 	_RdbSaveEntity(rdb, (GraphEntity *)e);
 }
 
-static void _RdbSaveNode_v13
+static void _RdbSaveNode_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -150,7 +156,7 @@ static void _RdbSaveNode_v13
 	_RdbSaveEntity(rdb, (GraphEntity *)n);
 }
 
-static void _RdbSaveDeletedEntities_v13
+static void _RdbSaveDeletedEntities_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -166,7 +172,7 @@ static void _RdbSaveDeletedEntities_v13
 	}
 }
 
-void RdbSaveDeletedNodes_v13
+void RdbSaveDeletedNodes_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -178,10 +184,10 @@ void RdbSaveDeletedNodes_v13
 	if(deleted_nodes_to_encode == 0) return;
 	// get deleted nodes list
 	uint64_t *deleted_nodes_list = Serializer_Graph_GetDeletedNodesList(gc->g);
-	_RdbSaveDeletedEntities_v13(rdb, gc, deleted_nodes_to_encode, deleted_nodes_list);
+	_RdbSaveDeletedEntities_v14(rdb, gc, deleted_nodes_to_encode, deleted_nodes_list);
 }
 
-void RdbSaveDeletedEdges_v13
+void RdbSaveDeletedEdges_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -194,10 +200,10 @@ void RdbSaveDeletedEdges_v13
 
 	// get deleted edges list
 	uint64_t *deleted_edges_list = Serializer_Graph_GetDeletedEdgesList(gc->g);
-	_RdbSaveDeletedEntities_v13(rdb, gc, deleted_edges_to_encode, deleted_edges_list);
+	_RdbSaveDeletedEntities_v14(rdb, gc, deleted_edges_to_encode, deleted_edges_list);
 }
 
-void RdbSaveNodes_v13
+void RdbSaveNodes_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
@@ -228,7 +234,7 @@ void RdbSaveNodes_v13
 	for(uint64_t i = 0; i < nodes_to_encode; i++) {
 		GraphEntity e;
 		e.attributes = (AttributeSet *)DataBlockIterator_Next(iter, &e.id);
-		_RdbSaveNode_v13(rdb, gc, &e);
+		_RdbSaveNode_v14(rdb, gc, &e);
 	}
 
 	// check if done encodeing nodes
@@ -277,7 +283,7 @@ static void _RdbSaveMultipleEdges
 	*multiple_edges_current_index = i;
 }
 
-void RdbSaveEdges_v13
+void RdbSaveEdges_v14
 (
 	RedisModuleIO *rdb,
 	GraphContext *gc,
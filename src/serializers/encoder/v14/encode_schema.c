@@ -4,7 +4,7 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
-#include "encode_v13.h"
+#include "encode_v14.h"
 #include "../../../util/arr.h"
 
 static void _RdbSaveAttributeKeys
@@ -90,6 +90,30 @@ static inline void _RdbSaveExactMatchIndex
 	}
 }
 
+static inline void _RdbSaveVectorIndex
+(
+	RedisModuleIO *rdb,
+	Index idx
+) {
+	/* Format:
+	 * property
+	 * dimension
+	 * similarity
+	 * M
+	 * efConstruction */
+
+	ASSERT(Index_FieldsCount(idx) == 1);
+
+	const IndexField *field = Index_GetFields(idx);
+	const VectorIndexOptions *opts = Index_GetVectorOptions(idx);
+
+	RedisModule_SaveStringBuffer(rdb, field->name, strlen(field->name) + 1);
+	RedisModule_SaveUnsigned(rdb, opts->dimension);
+	RedisModule_SaveUnsigned(rdb, opts->similarity);
+	RedisModule_SaveUnsigned(rdb, opts->M);
+	RedisModule_SaveUnsigned(rdb, opts->ef_construction);
+}
+
 static inline void _RdbSaveIndexData
 (
 	RedisModuleIO *rdb,
@@ -104,12 +128,14 @@ static inline void _RdbSaveIndexData
 
 	// index type
 	IndexType t = Index_Type(idx);
-	ASSERT(t == IDX_EXACT_MATCH || t == IDX_FULLTEXT);
+	ASSERT(t == IDX_EXACT_MATCH || t == IDX_FULLTEXT || t == IDX_VECTOR);
 
 	RedisModule_SaveUnsigned(rdb, t);
 
 	if(t == IDX_FULLTEXT) {
 		_RdbSaveFullTextIndexData(rdb, idx);
+	} else if(t == IDX_VECTOR) {
+		_RdbSaveVectorIndex(rdb, idx);
 	} else {
 		_RdbSaveExactMatchIndex(rdb, type, idx);
 	}
@@ -215,11 +241,17 @@ static void _RdbSaveSchema(RedisModuleIO *rdb, Schema *s) {
 		: ACTIVE_FULLTEXT_IDX(s);
 	_RdbSaveIndexData(rdb, s->type, idx);
 
+	// Vector index.
+	idx = PENDING_VECTOR_IDX(s)
+		? PENDING_VECTOR_IDX(s)
+		: ACTIVE_VECTOR_IDX(s);
+	_RdbSaveIndexData(rdb, s->type, idx);
+
 	// Constraints.
 	_RdbSaveConstraintsData(rdb, s->constraints);
 }
 
-void RdbSaveGraphSchema_v13(RedisModuleIO *rdb, GraphContext *gc) {
+void RdbSaveGraphSchema_v14(RedisModuleIO *rdb, GraphContext *gc) {
 	/* Format:
 	 * attribute keys (unified schema)
 	 * #node schemas
@@ -11,7 +11,17 @@
 #include "encoder/encode_graph.h"
 #include "decoders/decode_graph.h"
 #include "decoders/decode_previous.h"
+#include "../util/arr.h"
+#include "../util/rmalloc.h"
 #include "../util/redis_version.h"
+#include "../configuration/config.h"
+#include "../commands/cache_warmup.h"
+
+#include <inttypes.h>
+
+// version of the cached queries aux payload
+// 0 indicates nothing was persisted, as saved by previous versions
+#define CACHES_PAYLOAD_VERSION 1
 
 // forward declerations of the module event handler functions
 void ModuleEventHandler_AUXBeforeKeyspaceEvent(void);
@@ -55,16 +65,159 @@ static void _GraphContextType_RdbSave(RedisModuleIO *rdb, void *value) {
 	RdbSaveGraph(rdb, value);
 }
 
-// save an unsigned placeholder before and after the keyspace encoding
+// persist the hottest cached queries of each graph
+// format:
+// payload version
+// number of graphs N
+// N * (graph name, number of queries M, M * (query, number of hits))
+//
+// when there's nothing to persist only version 0 is saved
+// which is identical to the placeholder saved by previous versions
+static void _GraphContextType_SaveCaches
+(
+	RedisModuleIO *rdb
+) {
+	uint64_t persist_size;
+	Config_Option_get(Config_CACHE_PERSIST_SIZE, &persist_size);
+
+	// collect hot queries
+	// a forked process mustn't wait on locks it doesn't own
+	bool wait = !Globals_Get_ProcessIsChild();
+	GraphContext  **graphs  = array_new(GraphContext *, 0);
+	CacheKeyStats **queries = array_new(CacheKeyStats *, 0);
+
+	if(persist_size > 0) {
+		KeySpaceGraphIterator it;
+		GraphContext *gc = NULL;
+		Globals_ScanGraphs(&it);
+		while((gc = GraphIterator_Next(&it)) != NULL) {
+			CacheKeyStats *stats = Cache_HotKeys(GraphContext_GetCache(gc),
+					persist_size, wait);
+
+			if(stats == NULL || array_len(stats) == 0) {
+				if(stats != NULL) array_free(stats);
+				GraphContext_DecreaseRefCount(gc);
+				continue;
+			}
+
+			array_append(graphs, gc);
+			array_append(queries, stats);
+		}
+	}
+
+	uint n = array_len(graphs);
+	if(n == 0) {
+		RedisModule_SaveUnsigned(rdb, 0);
+		array_free(graphs);
+		array_free(queries);
+		return;
+	}
+
+	RedisModule_SaveUnsigned(rdb, CACHES_PAYLOAD_VERSION);
+	RedisModule_SaveUnsigned(rdb, n);
+
+	for(uint i = 0; i < n; i++) {
+		const char *name = GraphContext_GetName(graphs[i]);
+		RedisModule_SaveStringBuffer(rdb, name, strlen(name));
+
+		CacheKeyStats *stats = queries[i];
+		uint m = array_len(stats);
+		RedisModule_SaveUnsigned(rdb, m);
+
+		for(uint j = 0; j < m; j++) {
+			RedisModule_SaveStringBuffer(rdb, stats[j].key,
+					strlen(stats[j].key));
+			RedisModule_SaveUnsigned(rdb, stats[j].hits);
+			rm_free(stats[j].key);
+		}
+
+		array_free(stats);
+		GraphContext_DecreaseRefCount(graphs[i]);
+	}
+
+	array_free(graphs);
+	array_free(queries);
+}
+
+// load persisted cached queries
+// warm-up is deferred until the server finishes loading
+// returns false if the payload's version isn't supported
+static bool _GraphContextType_LoadCaches
+(
+	RedisModuleIO *rdb
+) {
+	uint64_t version = RedisModule_LoadUnsigned(rdb);
+
+	// nothing was persisted
+	if(version == 0) return true;
+
+	if(version > CACHES_PAYLOAD_VERSION) {
+		RedisModule_LogIOError(rdb, "warning",
+				"unsupported cached queries payload version %" PRIu64, version);
+		return false;
+	}
+
+	uint64_t n = RedisModule_LoadUnsigned(rdb);
+
+	for(uint64_t i = 0; i < n; i++) {
+		size_t len;
+		char *name = RedisModule_LoadStringBuffer(rdb, &len);
+
+		// locate graph, all keys have been loaded by now
+		KeySpaceGraphIterator it;
+		GraphContext *gc = NULL;
+		Globals_ScanGraphs(&it);
+		while((gc = GraphIterator_Next(&it)) != NULL) {
+			const char *gc_name = GraphContext_GetName(gc);
+			if(strlen(gc_name) == len && strncmp(gc_name, name, len) == 0) {
+				break;
+			}
+			GraphContext_DecreaseRefCount(gc);
+		}
+		RedisModule_Free(name);
+
+		// load queries, keeping no more than the cache can hold
+		uint cap = (gc != NULL) ? GraphContext_GetCache(gc)->cap : 0;
+		uint64_t m = RedisModule_LoadUnsigned(rdb);
+		CacheKeyStats *queries = array_new(CacheKeyStats, 0);
+
+		for(uint64_t j = 0; j < m; j++) {
+			char *q = RedisModule_LoadStringBuffer(rdb, &len);
+			uint64_t hits = RedisModule_LoadUnsigned(rdb);
+
+			if(array_len(queries) < cap) {
+				CacheKeyStats stats = {.key = rm_strndup(q, len), .hits = hits};
+				array_append(queries, stats);
+			}
+
+			RedisModule_Free(q);
+		}
+
+		if(gc != NULL) {
+			CacheWarmup_Defer(gc, queries);
+			GraphContext_DecreaseRefCount(gc);
+		} else {
+			// graph is gone
+			array_free(queries);
+		}
+	}
+
+	return true;
+}
+
+// save an unsigned placeholder before the keyspace encoding
+// and the hottest cached queries after it
 static void _GraphContextType_AuxSave
 (
 	RedisModuleIO *rdb,
 	int when
 ) {
-	RedisModule_SaveUnsigned(rdb, 0);
+	if(when == REDISMODULE_AUX_BEFORE_RDB) RedisModule_SaveUnsigned(rdb, 0);
+	else _GraphContextType_SaveCaches(rdb);
 }
 
-// save an unsigned placeholder before and after the keyspace encoding
+// save an unsigned placeholder before the keyspace encoding
+// and the hottest cached queries after it
 static void _GraphContextType_AuxSave2
 (
 	RedisModuleIO *rdb,
@@ -72,16 +225,20 @@ static void _GraphContextType_AuxSave2
 ) {
 	// only write AUX field if there are graphs in the keyspace
 	if(Globals_GetGraphCount() > 0) {
-		RedisModule_SaveUnsigned(rdb, 0);
+		_GraphContextType_AuxSave(rdb, when);
 	}
 }
 
-// decode the unsigned placeholders saved before and after the keyspace values
+// decode the fields saved before and after the keyspace values
 // and call the module event handler
 static int _GraphContextType_AuxLoad(RedisModuleIO *rdb, int encver, int when) {
-	RedisModule_LoadUnsigned(rdb);
-	if(when == REDISMODULE_AUX_BEFORE_RDB) ModuleEventHandler_AUXBeforeKeyspaceEvent();
-	else ModuleEventHandler_AUXAfterKeyspaceEvent();
+	if(when == REDISMODULE_AUX_BEFORE_RDB) {
+		RedisModule_LoadUnsigned(rdb);
+		ModuleEventHandler_AUXBeforeKeyspaceEvent();
+	} else {
+		if(!_GraphContextType_LoadCaches(rdb)) return REDISMODULE_ERR;
+		ModuleEventHandler_AUXAfterKeyspaceEvent();
+	}
 	return REDISMODULE_OK;
 }
 
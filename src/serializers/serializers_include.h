@@ -21,6 +21,7 @@
 #include "../util/rmalloc.h"
 // Non primitive data types.
 #include "../datatypes/array.h"
+#include "../datatypes/vector.h"
 // Graph extentions.
 #include "graph_extensions.h"
 // Module configuration
@@ -11,12 +11,75 @@
 #include "../execution_plan/ops/shared/create_functions.h"
 #include "../graph/entities/attribute_set.h"
 
-// initial number of entries in undo-log
+// number of entries in the first undo-log block
 #define UNDOLOG_INIT_SIZE 32
 
-#define UNDOLOG_GET_ITEM(log, i) DataBlock_GetItem(log, i)
+// max number of undo-log blocks
+#define UNDOLOG_MAX_BLOCKS 32
+
+#define UNDOLOG_GET_ITEM(log, i) _UndoLog_GetOp(log, i)
 #define UNDOLOG_ADD_OP(log, op) \
-	*(UndoOp*)DataBlock_AllocateItem((log), NULL) = op;
+	*_UndoLog_AllocateOp(log) = op;
+
+// undo-log arena
+// operations are appended to geometrically growing blocks
+// block i holds (UNDOLOG_INIT_SIZE << i) operations
+// blocks are never reallocated, as such operations are never moved
+struct _UndoLog {
+	UndoOp *blocks[UNDOLOG_MAX_BLOCKS];  // arena blocks
+	uint64_t count;                      // number of operations in log
+};
+
+// locate the block holding the ith operation
+static inline uint _UndoLog_BlockIdx
+(
+	uint64_t i
+) {
+	return 63 - __builtin_clzll((i / UNDOLOG_INIT_SIZE) + 1);
+}
+
+// get the ith operation
+static inline UndoOp *_UndoLog_GetOp
+(
+	const UndoLog log,
+	uint64_t i
+) {
+	ASSERT(i < log->count);
+
+	uint block = _UndoLog_BlockIdx(i);
+	uint64_t offset = i - UNDOLOG_INIT_SIZE * ((1ULL << block) - 1);
+	return log->blocks[block] + offset;
+}
+
+// allocate a new operation at the end of the log
+static inline UndoOp *_UndoLog_AllocateOp
+(
+	UndoLog log
+) {
+	uint64_t i = log->count;
+	uint block = _UndoLog_BlockIdx(i);
+	ASSERT(block < UNDOLOG_MAX_BLOCKS);
+
+	// allocate block on first use
+	if(unlikely(log->blocks[block] == NULL)) {
+		log->blocks[block] =
+			rm_malloc(sizeof(UndoOp) * (UNDOLOG_INIT_SIZE << block));
+	}
+
+	log->count++;
+	return _UndoLog_GetOp(log, i);
+}
+
+// free undo-log arena
+static void _UndoLog_FreeArena
+(
+	UndoLog log
+) {
+	for(uint i = 0; i < UNDOLOG_MAX_BLOCKS && log->blocks[i] != NULL; i++) {
+		rm_free(log->blocks[i]);
+	}
+	rm_free(log);
+}
 
 static void _index_node
 (
@@ -120,7 +183,7 @@ static void _UndoLog_Restore_Entity_Property
 			AttributeSet_AddNoClone(ge->attributes, &attr_id, &value, 1, false);
 		}
 	} else {
-		// update attribute
+		// update attribute, a NULL value removes the attribute
 		AttributeSet_UpdateNoClone(ge->attributes, attr_id, value);
 	}
 }
@@ -136,16 +199,25 @@ static void _UndoLog_Rollback_Update_Entity
 		UndoOp *op = UNDOLOG_GET_ITEM(ctx->undo_log, i);
 		UndoUpdateOp *update_op = &op->update_op;
 
+		// restore attribute original value
+		// the entity takes ownership over the logged value
+		_UndoLog_Restore_Entity_Property((GraphEntity *)&update_op->n,
+				update_op->attr_id, update_op->orig_value);
+
+		// attributes of the same entity are logged consecutively
+		// update indices once all of the entity's attributes are restored
+		if(i - 1 > seq_end) {
+			UndoUpdateOp *next = &UNDOLOG_GET_ITEM(ctx->undo_log, i - 1)->update_op;
+			if(next->entity_type == update_op->entity_type &&
+			   next->n.id == update_op->n.id) {
+				continue;
+			}
+		}
+
 		// update indices
 		if(update_op->entity_type == GETYPE_NODE) {
-			// free current entity attribute-set
-			AttributeSet_Free(update_op->n.attributes);
-			// restore entity original attribute-set
-			*update_op->n.attributes = update_op->set;
 			_index_node(ctx, &update_op->n);
 		} else {
-			AttributeSet_Free(update_op->e.attributes);
-			*update_op->e.attributes = update_op->set;
 			_index_edge(ctx, &update_op->e);
 		}
 	}
@@ -326,11 +398,7 @@ static void _UndoLog_Rollback_Add_Attribute
 }
 
 UndoLog UndoLog_New(void) {
-	return (UndoLog)DataBlock_New(
-		UNDOLOG_INIT_SIZE,
-		UNDOLOG_INIT_SIZE,
-		sizeof(UndoOp),
-		NULL);
+	return rm_calloc(1, sizeof(struct _UndoLog));
 }
 
 // returns number of entries in log
@@ -339,7 +407,7 @@ uint UndoLog_Length
 	const UndoLog log  // log to query
 ) {
 	ASSERT(log != NULL);
-	return DataBlock_ItemCount(log);
+	return log->count;
 }
 
 //------------------------------------------------------------------------------
@@ -352,7 +420,8 @@ void UndoLog_CreateNode
 	UndoLog log,           // undo log
 	Node *node             // node created
 ) {
-	ASSERT(log != NULL);
+	// undo-logging is disabled
+	if(log == NULL) return;
 
 	UndoOp op;
 
@@ -368,7 +437,8 @@ void UndoLog_CreateEdge
 	UndoLog log,           // undo log
 	Edge *edge             // edge created
 ) {
-	ASSERT(log != NULL);
+	// undo-logging is disabled
+	if(log == NULL) return;
 
 	UndoOp op;
 
@@ -384,7 +454,8 @@ void UndoLog_DeleteNode
 	UndoLog log,       // undo log
 	Node *node         // node deleted
 ) {
-	ASSERT(log != NULL);
+	// undo-logging is disabled
+	if(log == NULL) return;
 	ASSERT(node != NULL);
 
 	UndoOp op;
@@ -418,7 +489,8 @@ void UndoLog_DeleteEdge
 	UndoLog log,   // undo log
 	Edge *edge     // edge deleted
 ) {
-	ASSERT(log != NULL);
+	// undo-logging is disabled
+	if(log == NULL) return;
 	ASSERT(edge != NULL);
 
 	UndoOp op;
@@ -439,21 +511,25 @@ void UndoLog_DeleteEdge
 	UNDOLOG_ADD_OP(log, op);
 }
 
-// undo entity update
+// undo entity attribute update
+// the undo-log takes ownership over 'orig_value'
 void UndoLog_UpdateEntity
 (
 	UndoLog log,                 // undo log
 	GraphEntity *ge,             // updated entity
-	AttributeSet set,            // old attribute set
+	Attribute_ID attr_id,        // updated attribute
+	SIValue orig_value,          // attribute original value, NULL if added
 	GraphEntityType entity_type  // entity type
 ) {
-	ASSERT(log != NULL);
+	// undo-logging is disabled
+	if(log == NULL) return;
 	ASSERT(ge != NULL);
 
 	UndoOp op;
 
 	op.type                  = UNDO_UPDATE;
-	op.update_op.set         = set;
+	op.update_op.attr_id     = attr_id;
+	op.update_op.orig_value  = orig_value;
 	op.update_op.entity_type = entity_type;
 
 	if(entity_type == GETYPE_NODE) {
@@ -473,6 +549,9 @@ void UndoLog_AddLabels
 	LabelID *label_ids,          // added labels
 	size_t labels_count          // number of removed labels
 ) {
+	// undo-logging is disabled
+	if(log == NULL) return;
+
 	ASSERT(node != NULL);
 	ASSERT(label_ids != NULL);
 
@@ -494,6 +573,9 @@ void UndoLog_RemoveLabels
 	LabelID *label_ids,          // removed labels
 	size_t labels_count          // number of removed labels
 ) {
+	// undo-logging is disabled
+	if(log == NULL) return;
+
 	ASSERT(node != NULL);
 	ASSERT(label_ids != NULL);
 
@@ -514,7 +596,8 @@ void UndoLog_AddSchema
 	int schema_id,  // id of the schema
 	SchemaType t    // type of the schema
 ) {
-	ASSERT(log != NULL);
+	// undo-logging is disabled
+	if(log == NULL) return;
 	UndoOp op;
 
 	op.type = UNDO_ADD_SCHEMA;
@@ -528,7 +611,8 @@ void UndoLog_AddAttribute
 	UndoLog log,              // undo log
 	Attribute_ID attribute_id // id of the attribute
 ) {
-	ASSERT(log != NULL);
+	// undo-logging is disabled
+	if(log == NULL) return;
 	UndoOp op;
 
 	op.type = UNDO_ADD_ATTRIBUTE;
@@ -550,7 +634,7 @@ void UndoLog_Rollback
 	if(_log == NULL) return;
 
 	QueryCtx *ctx  = QueryCtx_GetQueryCtx();
-	uint64_t count = DataBlock_ItemCount(_log);
+	uint64_t count = _log->count;
 
 	// apply undo operations in reverse order for rollback correctness
 	// find sequences of the same operation and rollback them as a bulk
@@ -599,7 +683,7 @@ void UndoLog_Rollback
 		}
  	}
 
-	DataBlock_Free(_log);
+	_UndoLog_FreeArena(_log);
 	*log = NULL;
 }
 
@@ -611,7 +695,7 @@ static void UndoLog_FreeOp
 
 	switch(op->type) {
 		case UNDO_UPDATE:
-			AttributeSet_Free(&op->update_op.set);
+			SIValue_Free(op->update_op.orig_value);
 			break;
 		case UNDO_CREATE_NODE:
 			break;
@@ -645,13 +729,11 @@ void UndoLog_Free
 	UndoLog _log = *log;
 	if(_log == NULL) return;
 
-	DataBlockIterator *iter = DataBlock_Scan(_log);
-	UndoOp *op;
-	while((op = DataBlockIterator_Next(iter, NULL))) {
-		UndoLog_FreeOp(op);
+	for(uint64_t i = 0; i < _log->count; i++) {
+		UndoLog_FreeOp(UNDOLOG_GET_ITEM(_log, i));
 	}
-	DataBlockIterator_Free(iter);
-	DataBlock_Free(_log);
+
+	_UndoLog_FreeArena(_log);
 	*log = NULL;
 }
 
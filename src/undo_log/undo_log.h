@@ -19,6 +19,9 @@
 // upon failure for which ever reason we can apply the
 // operations within the undo log to rollback the graph to its
 // original state
+//
+// a NULL undo-log indicates undo-logging is disabled
+// in which case all UndoLog add operations are no-ops
 
 // UndoLog operation types
 typedef enum {
@@ -65,15 +68,17 @@ struct UndoDeleteEdgeOp {
 	AttributeSet set;
 };
 
-// undo graph entity update
+// undo graph entity attribute update
+// a single record is logged for each modified attribute
 typedef struct UndoUpdateOp UndoUpdateOp;
 struct UndoUpdateOp {
 	union {
 		Node n;
 		Edge e;
 	};
+	SIValue orig_value;           // attribute original value, NULL if added
+	Attribute_ID attr_id;         // updated attribute
 	GraphEntityType entity_type;  // node/edge
-	AttributeSet set;             // old attribute set
 };
 
 typedef struct UndoLabelsOp UndoLabelsOp;
@@ -108,8 +113,8 @@ typedef struct {
 	UndoOpType type;  // type of undo operation
 } UndoOp;
 
-// container for undo_list
-typedef DataBlock *UndoLog;
+// undo-log, an append-only arena of undo operations
+typedef struct _UndoLog *UndoLog;
 
 // create a new undo-log
 UndoLog UndoLog_New(void);
@@ -152,12 +157,14 @@ void UndoLog_DeleteEdge
 	Edge *edge     // edge deleted
 );
 
-// undo entity update
+// undo entity attribute update
+// the undo-log takes ownership over 'orig_value'
 void UndoLog_UpdateEntity
 (
 	UndoLog log,                 // undo log
 	GraphEntity *ge,             // updated entity
-	AttributeSet set,            // old attribute set
+	Attribute_ID attr_id,        // updated attribute
+	SIValue orig_value,          // attribute original value, NULL if added
 	GraphEntityType entity_type  // entity type
 );
 
@@ -8,6 +8,7 @@
 #include "RG.h"
 #include "../rmalloc.h"
 #include "cache_array.h"
+#include "../arr.h"
 #include <pthread.h>
 
 static CacheEntry *_CacheEvictLRU(Cache *cache) {
@@ -63,6 +64,8 @@ Cache *Cache_New(uint cap, CacheEntryFreeFunc freeFunc, CacheEntryCopyFunc copyF
 	cache->size      = 0;
 	cache->lookup    = raxNew();       // Instantiate key entry mapping.
 	cache->counter   = 0;             // Initialize counter to zero.
+	cache->hits      = 0;
+	cache->misses    = 0;
 	cache->copy_item = copyFunc;
 	cache->free_item = freeFunc;
 	cache->arr = rm_calloc(cap, sizeof(CacheEntry)); // Array of cached values.
@@ -75,7 +78,9 @@ Cache *Cache_New(uint cap, CacheEntryFreeFunc freeFunc, CacheEntryCopyFunc copyF
 	return cache;
 }
 
-void *Cache_GetValue(Cache *cache, const char *key) {
+// look up key, returns a copy of its value
+// lookups are tracked unless peeking
+static void *_Cache_GetValue(Cache *cache, const char *key, bool peek) {
 	void *item = NULL;
 
 	ASSERT(cache != NULL);
@@ -87,12 +92,20 @@ void *Cache_GetValue(Cache *cache, const char *key) {
 	size_t key_len = strlen(key);
 	CacheEntry *entry = raxFind(cache->lookup, (unsigned char *)key, key_len);
 
-	if(entry == raxNotFound) goto cleanup;
+	if(entry == raxNotFound) {
+		if(!peek) __atomic_fetch_add(&cache->misses, 1, __ATOMIC_RELAXED);
+		goto cleanup;
+	}
 
-	// element is now the most recently used; update its LRU
-	// note that multiple threads can be here simultaneously
-	cache->counter++;
-	entry->LRU = cache->counter;
+	if(!peek) {
+		__atomic_fetch_add(&cache->hits, 1, __ATOMIC_RELAXED);
+		__atomic_fetch_add(&entry->hits, 1, __ATOMIC_RELAXED);
+
+		// element is now the most recently used; update its LRU
+		// note that multiple threads can be here simultaneously
+		cache->counter++;
+		entry->LRU = cache->counter;
+	}
 
 	// return a copy of element
 	item = cache->copy_item(entry->value);
@@ -103,6 +116,14 @@ cleanup:
 	return item;
 }
 
+void *Cache_GetValue(Cache *cache, const char *key) {
+	return _Cache_GetValue(cache, key, false);
+}
+
+void *Cache_PeekValue(Cache *cache, const char *key) {
+	return _Cache_GetValue(cache, key, true);
+}
+
 void Cache_SetValue(Cache *cache, const char *key, void *value) {
 	ASSERT(key != NULL);
 	ASSERT(cache != NULL);
@@ -145,6 +166,81 @@ void *Cache_SetGetValue(Cache *cache, const char *key, void *value) {
 	return value_to_return;
 }
 
+void Cache_GetStats(Cache *cache, uint64_t *hits, uint64_t *misses) {
+	ASSERT(cache  != NULL);
+	ASSERT(hits   != NULL);
+	ASSERT(misses != NULL);
+
+	*hits   = __atomic_load_n(&cache->hits, __ATOMIC_RELAXED);
+	*misses = __atomic_load_n(&cache->misses, __ATOMIC_RELAXED);
+}
+
+// order entries by descending hits, then by descending recency
+static int _CacheEntry_HotterCmp(const void *a, const void *b) {
+	const CacheEntry *ea = *(const CacheEntry **)a;
+	const CacheEntry *eb = *(const CacheEntry **)b;
+
+	uint64_t ha = __atomic_load_n(&ea->hits, __ATOMIC_RELAXED);
+	uint64_t hb = __atomic_load_n(&eb->hits, __ATOMIC_RELAXED);
+
+	if(ha != hb) return (ha > hb) ? -1 : 1;
+	if(ea->LRU != eb->LRU) return (ea->LRU > eb->LRU) ? -1 : 1;
+	return 0;
+}
+
+CacheKeyStats *Cache_HotKeys(Cache *cache, uint n, bool wait) {
+	ASSERT(cache != NULL);
+
+	int res;
+	UNUSED(res);
+	if(wait) {
+		res = pthread_rwlock_rdlock(&cache->_cache_rwlock);
+		ASSERT(res == 0);
+	} else if(pthread_rwlock_tryrdlock(&cache->_cache_rwlock) != 0) {
+		return NULL;
+	}
+
+	uint size = cache->size;
+	CacheEntry **entries = rm_malloc(sizeof(CacheEntry *) * (size + 1));
+	for(uint i = 0; i < size; i++) entries[i] = cache->arr + i;
+
+	qsort(entries, size, sizeof(CacheEntry *), _CacheEntry_HotterCmp);
+
+	if(n > size) n = size;
+	CacheKeyStats *stats = array_new(CacheKeyStats, n);
+	for(uint i = 0; i < n; i++) {
+		CacheKeyStats s = {
+			.key  = rm_strdup(entries[i]->key),
+			.hits = __atomic_load_n(&entries[i]->hits, __ATOMIC_RELAXED)
+		};
+		array_append(stats, s);
+	}
+
+	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
+	ASSERT(res == 0);
+
+	rm_free(entries);
+	return stats;
+}
+
+void Cache_SetHits(Cache *cache, const char *key, uint64_t hits) {
+	ASSERT(key != NULL);
+	ASSERT(cache != NULL);
+
+	int res = pthread_rwlock_rdlock(&cache->_cache_rwlock);
+	UNUSED(res);
+	ASSERT(res == 0);
+
+	CacheEntry *entry = raxFind(cache->lookup, (unsigned char *)key,
+			strlen(key));
+	if(entry != raxNotFound) {
+		__atomic_store_n(&entry->hits, hits, __ATOMIC_RELAXED);
+	}
+
+	res = pthread_rwlock_unlock(&cache->_cache_rwlock);
+	ASSERT(res == 0);
+}
+
 void Cache_Free(Cache *cache) {
 	ASSERT(cache != NULL);
 
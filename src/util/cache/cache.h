@@ -17,6 +17,8 @@ typedef struct Cache {
 	uint cap;                          // Cache capacity.
 	uint size;                         // Cache current size.
 	long long counter;                 // Atomic counter for number of reads.
+	uint64_t hits;                     // Number of lookups which found their key.
+	uint64_t misses;                   // Number of lookups which missed their key.
 	rax *lookup;                       // Mapping between keys to entries, for fast lookups.
 	CacheEntry *arr;                   // Array of cache elements.
 	CacheEntryFreeFunc free_item;      // Callback function that free cached value.
@@ -24,6 +26,14 @@ typedef struct Cache {
 	pthread_rwlock_t _cache_rwlock;    // Read-write lock to protect access to the cache.
 } Cache;
 
+/**
+ * @brief  A cached key and the number of lookups which found it.
+ */
+typedef struct {
+	char *key;      // Cached key.
+	uint64_t hits;  // Number of lookups which found the key.
+} CacheKeyStats;
+
 /**
  * @brief  Initialize a cache.
  * @param  size: Number of entries.
@@ -60,6 +70,43 @@ void Cache_SetValue(Cache *cache, const char *key, void *item);
  */
 void *Cache_SetGetValue(Cache *cache, const char *key, void *value);
 
+/**
+ * @brief  Reports the number of cache hits and misses.
+ * @param  *cache: cache pointer.
+ * @param  *hits: [output] number of lookups which found their key.
+ * @param  *misses: [output] number of lookups which missed their key.
+ */
+void Cache_GetStats(Cache *cache, uint64_t *hits, uint64_t *misses);
+
+/**
+ * @brief  Returns a copy of value if it is cached, NULL otherwise.
+ * @note   Unlike Cache_GetValue, statistics and LRU are left untouched.
+ * @param  *cache: cache pointer.
+ * @param  *key: Key to look for.
+ * @retval  pointer with the cached answer, NULL if the key isn't cached.
+ */
+void *Cache_PeekValue(Cache *cache, const char *key);
+
+/**
+ * @brief  Reports the most frequently hit keys, hottest first.
+ * @note   Keys with an equal number of hits are ordered by recency.
+ * @param  *cache: cache pointer.
+ * @param  n: maximum number of keys to report.
+ * @param  wait: block while the cache is being modified, otherwise give up.
+ * @retval array (arr.h) of key statistics, caller owns both array and keys.
+ *         NULL if the cache is being modified and wait is false.
+ */
+CacheKeyStats *Cache_HotKeys(Cache *cache, uint n, bool wait);
+
+/**
+ * @brief  Sets the number of hits of a cached key.
+ * @note   Used to restore persisted statistics, no-op if key isn't cached.
+ * @param  *cache: cache pointer.
+ * @param  *key: cached key.
+ * @param  hits: number of hits.
+ */
+void Cache_SetHits(Cache *cache, const char *key, uint64_t hits);
+
 /**
  * @brief  Destroys the cache and free all stored items.
  * @param  *cache: cache pointer
@@ -29,6 +29,7 @@ CacheEntry *CacheArray_PopulateEntry(long long counter, CacheEntry *entry, char
 	entry->key   = key;
 	entry->value = value;
 	entry->LRU   = counter;
+	entry->hits  = 0;
 
 	return entry;
 }
@@ -47,6 +48,7 @@ void CacheArray_CleanEntry(CacheEntry *entry, CacheEntryFreeFunc free_entry) {
 		entry->value = NULL;
 	}
 
-	entry->LRU = 0;
+	entry->LRU  = 0;
+	entry->hits = 0;
 }
 
@@ -28,6 +28,7 @@ typedef struct CacheEntry_t {
 	char *key;      // Entry key.
 	void *value;    // Entry stored value.
 	long long LRU;  // Indicates the time when the entry was last recently used.
+	uint64_t hits;  // Number of lookups which found this entry.
 } CacheEntry;
 
 
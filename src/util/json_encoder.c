@@ -131,6 +131,22 @@ static sds _JsonEncoder_Path(SIValue p, sds s) {
 	return s;
 }
 
+static sds _JsonEncoder_Vector(SIValue vector, sds s) {
+	ASSERT(SI_TYPE(vector) & T_VECTOR_F32);
+
+	// vectors are encoded as a list of floats
+	uint32_t dim = SIVector_Dim(vector);
+	const float *values = SIVector_Elements(vector);
+
+	s = sdscat(s, "[");
+	for(uint32_t i = 0; i < dim; i++) {
+		if(i > 0) s = sdscat(s, ", ");
+		s = sdscatprintf(s, "%f", values[i]);
+	}
+	s = sdscat(s, "]");
+	return s;
+}
+
 static sds _JsonEncoder_Point(SIValue point, sds s) {
 	ASSERT(SI_TYPE(point) & T_POINT);
 
@@ -221,6 +237,9 @@ sds _JsonEncoder_SIValue(SIValue v, sds s) {
 	case T_POINT:
 		s = _JsonEncoder_Point(v, s);
 		break;		
+	case T_VECTOR_F32:
+		s = _JsonEncoder_Vector(v, s);
+		break;
 	default:
 		// unrecognized type
 		ErrorCtx_RaiseRuntimeException("JSON encoder encountered unrecognized type: %d\n", v.type);
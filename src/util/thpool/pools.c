@@ -206,6 +206,27 @@ void **ThreadPools_GetTasksByHandler
 	return tasks;
 }
 
+// removes queued write tasks from the front of the writers queue
+// for as long as they match the given handler and predicate
+// returns number of tasks removed
+uint32_t ThreadPools_PullTasksWriter
+(
+	void (*handler)(void *),        // task handler to match
+	bool (*match)(void *, void *),  // [optional] predicate on task argument
+	void *pdata,                    // [optional] predicate private data
+	void **tasks,                   // [output] removed tasks
+	uint32_t cap                    // max number of tasks to remove
+) {
+	ASSERT(tasks           != NULL);
+	ASSERT(handler         != NULL);
+	ASSERT(_writers_thpool != NULL);
+
+	uint32_t n = cap;
+	thpool_pull_tasks(_writers_thpool, tasks, &n, handler, match, pdata);
+
+	return n;
+}
+
 void ThreadPools_Destroy
 (
 	void
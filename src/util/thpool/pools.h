@@ -74,6 +74,18 @@ void **ThreadPools_GetTasksByHandler
 	uint32_t *n               // number of tasks returned
 );
 
+// removes queued write tasks from the front of the writers queue
+// for as long as they match the given handler and predicate
+// returns number of tasks removed
+uint32_t ThreadPools_PullTasksWriter
+(
+	void (*handler)(void *),        // task handler to match
+	bool (*match)(void *, void *),  // [optional] predicate on task argument
+	void *pdata,                    // [optional] predicate private data
+	void **tasks,                   // [output] removed tasks
+	uint32_t cap                    // max number of tasks to remove
+);
+
 // destroies all threadpools, allows threads to exit gracefully
 void ThreadPools_Destroy
 (
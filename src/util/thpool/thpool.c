@@ -348,6 +348,55 @@ void thpool_get_tasks
 	*num_tasks = i;
 }
 
+// removes tasks from the front of the job queue for as long as they match
+// the given handler and predicate, stops at the first mismatch
+// such that the relative order of the remaining jobs is preserved
+void thpool_pull_tasks
+(
+	threadpool thpool_p,              // thread pool
+	void **tasks,                     // array of tasks
+	uint32_t *num_tasks,              // [in] capacity [out] tasks collected
+	void (*handler)(void *),          // handler function
+	bool (*match)(void *, void *),    // [optional] predicate on task argument
+	void *pdata                       // [optional] predicate private data
+) {
+	// validations
+	ASSERT(tasks     != NULL);
+	ASSERT(handler   != NULL);
+	ASSERT(thpool_p  != NULL);
+	ASSERT(num_tasks != NULL);
+
+	jobqueue *jobqueue_p = &thpool_p->jobqueue;
+
+	// lock job queue
+	pthread_mutex_lock(&jobqueue_p->rwmutex);
+
+	uint32_t i = 0;
+	while(i < *num_tasks && jobqueue_p->len > 0) {
+		job *job_p = jobqueue_p->front;
+
+		// stop at first job which doesn't match
+		if(job_p->function != handler) break;
+		if(match != NULL && !match(job_p->arg, pdata)) break;
+
+		// detach job from queue
+		jobqueue_p->front = job_p->prev;
+		jobqueue_p->len--;
+		if(jobqueue_p->len == 0) {
+			jobqueue_p->rear = NULL;
+		}
+
+		tasks[i++] = job_p->arg;
+		rm_free(job_p);
+	}
+
+	// release lock
+	pthread_mutex_unlock(&jobqueue_p->rwmutex);
+
+	// set number of tasks collected
+	*num_tasks = i;
+}
+
 /* ============================ THREAD ============================== */
 
 /* Initialize a thread in the thread pool
@@ -254,6 +254,18 @@ void thpool_get_tasks
 	void (*match)(void*)      // [optional] executed on every match task
 );
 
+// removes tasks from the front of the job queue for as long as they match
+// the given handler and predicate
+void thpool_pull_tasks
+(
+	threadpool thpool_p,              // thread pool
+	void **tasks,                     // array of tasks
+	uint32_t *num_tasks,              // [in] capacity [out] tasks collected
+	void (*handler)(void *),          // handler function
+	bool (*match)(void *, void *),    // [optional] predicate on task argument
+	void *pdata                       // [optional] predicate private data
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@
 #include "datatypes/map.h"
 #include "datatypes/array.h"
 #include "datatypes/point.h"
+#include "datatypes/vector.h"
 #include "datatypes/path/sipath.h"
 
 static inline void _SIString_ToString(SIValue str, char **buf, size_t *bufferLen,
@@ -118,6 +119,10 @@ SIValue SI_Point(float latitude, float longitude) {
 	};
 }
 
+SIValue SI_Vectorf32(uint32_t dim) {
+	return SIVectorf32_New(dim);
+}
+
 /* Make an SIValue that reuses the original's allocations, if any.
  * The returned value is not responsible for freeing any allocations,
  * and is not guaranteed that these allocations will remain in scope. */
@@ -151,6 +156,10 @@ SIValue SI_CloneValue(const SIValue v) {
 		return Map_Clone(v);
 	}
 
+	if(v.type == T_VECTOR_F32) {
+		return SIVector_Clone(v);
+	}
+
 	// Copy the memory region for Node and Edge values. This does not modify the
 	// inner Entity pointer to the value's properties.
 	SIValue clone;
@@ -266,6 +275,8 @@ const char *SIType_ToString(SIType t) {
 		return "Duration";
 	} else if(t & T_POINT) {
 		return "Point";
+	} else if(t & T_VECTOR_F32) {
+		return "Vectorf32";
 	} else if(t & T_NULL) {
 		return "Null";
 	} else {
@@ -368,6 +379,9 @@ void SIValue_ToString(SIValue v, char **buf, size_t *bufferLen, size_t *bytesWri
 		// = 52 bytes that already checked in the header of the function
 		*bytesWritten += snprintf(*buf + *bytesWritten, *bufferLen, "point({latitude: %f, longitude: %f})", Point_lat(v), Point_lon(v));
 		break;
+	case T_VECTOR_F32:
+		SIVector_ToString(v, buf, bufferLen, bytesWritten);
+		break;
 	default:
 		// unrecognized type
 		printf("unrecognized type: %d\n", v.type);
@@ -616,6 +630,8 @@ int SIValue_Compare(const SIValue a, const SIValue b, int *disjointOrNull) {
 				return SAFE_COMPARISON_RESULT(Point_lat(a) - Point_lat(b));
 			return lon_diff;
 		}
+		case T_VECTOR_F32:
+			return SIVector_Compare(a, b);
 		default:
 			// Both inputs were of an incomparable type, like a pointer, or not implemented comparison yet.
 			ASSERT(false);
@@ -740,6 +756,10 @@ void SIValue_HashUpdate(SIValue v, XXH64_state_t *state) {
 			inner_hash = SIPath_HashCode(v);
 			XXH64_update(state, &inner_hash, sizeof(inner_hash));
 			return;
+		case T_VECTOR_F32:
+			inner_hash = SIVector_HashCode(v);
+			XXH64_update(state, &inner_hash, sizeof(inner_hash));
+			return;
 			// TODO: Implement for temporal types once we support them.
 		default:
 			ASSERT(false);
@@ -779,6 +799,7 @@ SIValue SIValue_FromBinary
 	double   d;
 	Point    p;
 	char    *s;
+	uint32_t dim;
 	struct SIValue *array;
 
 	fread_assert(&t, sizeof(SIType), stream);
@@ -792,6 +813,12 @@ SIValue SIValue_FromBinary
 			// read array from stream
 			v = SIArray_FromBinary(stream);
 			break;
+		case T_VECTOR_F32:
+			// read vector dimension followed by its elements
+			fread_assert(&dim, sizeof(dim), stream);
+			v = SI_Vectorf32(dim);
+			fread_assert(SIVector_Elements(v), sizeof(float) * dim, stream);
+			break;
 		case T_STRING:
 			// read string length from stream
 			fread_assert(&len, sizeof(len), stream);
@@ -846,6 +873,10 @@ void SIValue_Free(SIValue v) {
 		return;
 	case T_MAP:
 		Map_Free(v);
+		return;
+	case T_VECTOR_F32:
+		SIVector_Free(v);
+		return;
 	default:
 		return;
 	}
@@ -38,6 +38,7 @@ typedef enum {
 	T_NULL = (1 << 15),
 	T_PTR = (1 << 16),
 	T_POINT = (1 << 17), // TODO: verify type order of point
+	T_VECTOR_F32 = (1 << 18),  // packed float32 vector
 } SIType;
 
 typedef enum {
@@ -51,8 +52,8 @@ typedef enum {
 #define SI_ALLOCATION(value) (value)->allocation
 #define SI_NUMERIC (T_INT64 | T_DOUBLE)
 #define SI_GRAPHENTITY (T_NODE | T_EDGE)
-#define SI_ALL (T_MAP | T_NODE | T_EDGE | T_ARRAY | T_PATH | T_DATETIME | T_LOCALDATETIME | T_DATE | T_TIME | T_LOCALTIME | T_DURATION | T_STRING | T_BOOL | T_INT64 | T_DOUBLE | T_NULL | T_PTR | T_POINT)
-#define SI_VALID_PROPERTY_VALUE (T_POINT | T_ARRAY | T_DATETIME | T_LOCALDATETIME | T_DATE | T_TIME | T_LOCALTIME | T_DURATION | T_STRING | T_BOOL | T_INT64 | T_DOUBLE)
+#define SI_ALL (T_MAP | T_NODE | T_EDGE | T_ARRAY | T_PATH | T_DATETIME | T_LOCALDATETIME | T_DATE | T_TIME | T_LOCALTIME | T_DURATION | T_STRING | T_BOOL | T_INT64 | T_DOUBLE | T_NULL | T_PTR | T_POINT | T_VECTOR_F32)
+#define SI_VALID_PROPERTY_VALUE (T_POINT | T_VECTOR_F32 | T_ARRAY | T_DATETIME | T_LOCALDATETIME | T_DATE | T_TIME | T_LOCALTIME | T_DURATION | T_STRING | T_BOOL | T_INT64 | T_DOUBLE)
 #define SI_INDEXABLE (SI_NUMERIC | T_BOOL | T_STRING | T_POINT)
 
 /* Any values (except durations) are comparable with other values of the same type.
@@ -115,6 +116,7 @@ SIValue SI_DoubleVal(double d);
 SIValue SI_Map(u_int64_t initialCapacity);
 SIValue SI_Array(u_int64_t initialCapacity);
 SIValue SI_Point(float latitude, float longitude);
+SIValue SI_Vectorf32(uint32_t dim);
 
 // Duplicate and ultimately free the input string.
 SIValue SI_DuplicateStringVal(const char *s);
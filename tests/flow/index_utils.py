@@ -71,3 +71,14 @@ def wait_for_indices_to_sync(graph):
             break
         time.sleep(0.5) # sleep 500ms
 
+
+def create_vector_index(graph, label, attribute, dim, options=None, sync=False):
+    q = f"CALL db.idx.vector.createNodeIndex('{label}', '{attribute}', {dim}"
+    if options is not None:
+        q += ", {" + ', '.join(f"{k}: {v!r}" for k, v in options.items()) + "}"
+    q += ")"
+    return _create_index(graph, q, label, "vector", sync)
+
+def drop_vector_index(graph, label, attribute):
+    q = f"CALL db.idx.vector.drop('{label}', '{attribute}')"
+    return graph.query(q)
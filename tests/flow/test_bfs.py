@@ -180,3 +180,121 @@ class testBFS(FlowTestsBase):
         actual_result = graph.query(query)
         expected_result = [[['b'], ['e']]]
         self.env.assertEquals(actual_result.result_set, expected_result)
+
+    # test multi-source BFS
+    def test08_msbfs(self):
+        query = """MATCH (a) WHERE a.v IN ['a', 'd'] WITH collect(a) AS sources
+                   CALL algo.MSBFS(sources, 0, NULL) YIELD source, node, level
+                   RETURN source.v, node.v, level ORDER BY source.v, node.v"""
+        actual_result = graph.query(query)
+        expected_result = [['a', 'b', 1], ['a', 'c', 2], ['a', 'd', 2],
+                           ['a', 'e', 3], ['d', 'e', 1]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # restricted relationship type
+        query = """MATCH (a) WHERE a.v IN ['a', 'd'] WITH collect(a) AS sources
+                   CALL algo.MSBFS(sources, 0, 'E1') YIELD source, node, level
+                   RETURN source.v, node.v, level ORDER BY source.v, node.v"""
+        actual_result = graph.query(query)
+        expected_result = [['a', 'b', 1], ['a', 'c', 2], ['d', 'e', 1]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # max depth
+        query = """MATCH (a) WHERE a.v IN ['a', 'd'] WITH collect(a) AS sources
+                   CALL algo.MSBFS(sources, 1, ['E1', 'E2']) YIELD source, node, level
+                   RETURN source.v, node.v, level ORDER BY source.v, node.v"""
+        actual_result = graph.query(query)
+        expected_result = [['a', 'b', 1], ['d', 'e', 1]]
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        # MSBFS agrees with BFS from every source
+        query = """MATCH (a) CALL algo.BFS(a, 0, NULL) YIELD nodes
+                   UNWIND nodes AS n RETURN a.v, n.v ORDER BY a.v, n.v"""
+        expected_result = graph.query(query).result_set
+        query = """MATCH (a) WITH collect(a) AS sources
+                   CALL algo.MSBFS(sources, 0, NULL) YIELD source, node
+                   RETURN source.v, node.v ORDER BY source.v, node.v"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+    def test09_msbfs_no_results(self):
+        # missing relationship type
+        query = """MATCH (a) WITH collect(a) AS sources
+                   CALL algo.MSBFS(sources, 0, 'NONE_EXISTING_RELATION') YIELD node RETURN node"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [])
+
+        # no sources
+        query = """CALL algo.MSBFS([], 0, NULL) YIELD node RETURN node"""
+        actual_result = graph.query(query)
+        self.env.assertEquals(actual_result.result_set, [])
+
+        # invalid sources
+        try:
+            graph.query("CALL algo.MSBFS([1], 0, NULL) YIELD node RETURN node")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("sources must be an array of nodes", str(e))
+
+    def test10_msbfs_write(self):
+        # write to a copy of the graph, keeping 'proc_bfs' intact
+        g = Graph(self.env.getConnection(), "proc_msbfs_write")
+        g.query("""CREATE (a {v: 'a'})-[:E1]->(b {v: 'b'})-[:E1]->(c {v: 'c'}),
+                          (b)-[:E2]->(d {v: 'd'})-[:E1]->(e {v: 'e'}),
+                          (f {v: 'f'})""")
+
+        query = """MATCH (a) WHERE a.v IN ['a', 'd'] WITH collect(a) AS sources
+                   CALL algo.MSBFS.write(sources, 0, NULL, {writeProperty: 'dist'})
+                   YIELD nodes, reached RETURN nodes, reached"""
+        res = g.query(query)
+        self.env.assertEquals(res.result_set, [[5, 5]])
+        self.env.assertEquals(res.properties_set, 5)
+
+        # distance from the closest source, unreachable nodes have no distance
+        res = g.query("MATCH (n) RETURN n.v, n.dist ORDER BY n.v")
+        expected_result = [['a', 0], ['b', 1], ['c', 2], ['d', 0], ['e', 1],
+                           ['f', None]]
+        self.env.assertEquals(res.result_set, expected_result)
+
+        # refreshing an up to date result updates nothing
+        res = g.query(query)
+        self.env.assertEquals(res.result_set, [[0, 5]])
+        self.env.assertEquals(res.properties_set, 0)
+
+        # disconnect 'c', its stale distance is removed
+        g.query("MATCH ({v: 'b'})-[r]->({v: 'c'}) DELETE r")
+        res = g.query(query)
+        self.env.assertEquals(res.result_set, [[1, 4]])
+        self.env.assertEquals(res.properties_removed, 1)
+
+        res = g.query("MATCH (n) WHERE n.dist IS NOT NULL RETURN n.v ORDER BY n.v")
+        self.env.assertEquals(res.result_set, [['a'], ['b'], ['d'], ['e']])
+
+        # max depth
+        query = """MATCH (a) WHERE a.v = 'a' WITH collect(a) AS sources
+                   CALL algo.MSBFS.write(sources, 1, 'E1', {writeProperty: 'd1'})
+                   YIELD nodes RETURN nodes"""
+        g.query(query)
+        res = g.query("MATCH (n) WHERE n.d1 IS NOT NULL RETURN n.v, n.d1 ORDER BY n.v")
+        self.env.assertEquals(res.result_set, [['a', 0], ['b', 1]])
+
+        # missing write property
+        try:
+            g.query("CALL algo.MSBFS.write([], 0, NULL, {}) YIELD nodes RETURN nodes")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("writeProperty is missing", str(e))
+
+    def test11_msbfs_write_unknown_relationship(self):
+        g = Graph(self.env.getConnection(), "proc_msbfs_write_unknown")
+        g.query("CREATE ({v: 'a'})-[:E1]->({v: 'b'})")
+
+        # unknown relationship type, only the sources are reached
+        query = """MATCH (a) WHERE a.v = 'a' WITH collect(a) AS sources
+                   CALL algo.MSBFS.write(sources, 0, 'Unknown', {writeProperty: 'd'})
+                   YIELD nodes, reached RETURN nodes, reached"""
+        res = g.query(query)
+        self.env.assertEquals(res.result_set, [[1, 1]])
+
+        res = g.query("MATCH (n) RETURN n.v, n.d ORDER BY n.v")
+        self.env.assertEquals(res.result_set, [['a', 0], ['b', None]])
@@ -0,0 +1,179 @@
+import struct
+from common import *
+
+GRAPH_ID = "binary_resultset"
+
+VALUE_NULL    = 1
+VALUE_STRING  = 2
+VALUE_INTEGER = 3
+VALUE_BOOLEAN = 4
+VALUE_DOUBLE  = 5
+VALUE_ARRAY   = 6
+VALUE_EDGE    = 7
+VALUE_NODE    = 8
+VALUE_PATH    = 9
+VALUE_MAP     = 10
+VALUE_POINT   = 11
+
+
+class HeapReader():
+    def __init__(self, buf, offset):
+        self.buf = buf
+        self.offset = offset
+
+    def read(self, fmt):
+        v = struct.unpack_from('<' + fmt, self.buf, self.offset)
+        self.offset += struct.calcsize('<' + fmt)
+        return v[0]
+
+    def read_bytes(self, n):
+        v = self.buf[self.offset:self.offset + n]
+        self.offset += n
+        return v.decode()
+
+    def read_attributes(self):
+        return {self.read('I'): self.read_value() for _ in range(self.read('I'))}
+
+    def read_node(self):
+        node_id = self.read('Q')
+        labels = [self.read('I') for _ in range(self.read('I'))]
+        return ('node', node_id, labels, self.read_attributes())
+
+    def read_edge(self):
+        edge_id = self.read('Q')
+        reltype = self.read('I')
+        src = self.read('Q')
+        dest = self.read('Q')
+        return ('edge', edge_id, reltype, src, dest, self.read_attributes())
+
+    def read_payload(self, t):
+        if t == VALUE_NULL:
+            return None
+        if t == VALUE_BOOLEAN:
+            return self.read('B') == 1
+        if t == VALUE_INTEGER:
+            return self.read('q')
+        if t == VALUE_DOUBLE:
+            return self.read('d')
+        if t == VALUE_POINT:
+            return (self.read('f'), self.read('f'))
+        if t == VALUE_STRING:
+            return self.read_bytes(self.read('I'))
+        if t == VALUE_ARRAY:
+            return [self.read_value() for _ in range(self.read('I'))]
+        if t == VALUE_MAP:
+            n = self.read('I')
+            return {self.read_bytes(self.read('I')): self.read_value() for _ in range(n)}
+        if t == VALUE_NODE:
+            return self.read_node()
+        if t == VALUE_EDGE:
+            return self.read_edge()
+        if t == VALUE_PATH:
+            nodes = [self.read_node() for _ in range(self.read('I'))]
+            edges = [self.read_edge() for _ in range(self.read('I'))]
+            return ('path', nodes, edges)
+        assert False
+
+    def read_value(self):
+        return self.read_payload(self.read('B'))
+
+
+def decode_chunk(chunk):
+    version, nrows, ncols, heap_size = struct.unpack_from('<IIII', chunk, 0)
+    assert version == 1
+
+    slots_offset = 16
+    types_offset = slots_offset + ncols * nrows * 8
+    heap_offset = types_offset + ncols * nrows
+    assert heap_offset + heap_size == len(chunk)
+
+    rows = [[None] * ncols for _ in range(nrows)]
+    for c in range(ncols):
+        for r in range(nrows):
+            idx = c * nrows + r
+            t = chunk[types_offset + idx]
+            slot = chunk[slots_offset + idx * 8:slots_offset + (idx + 1) * 8]
+
+            if t == VALUE_NULL:
+                v = None
+            elif t == VALUE_BOOLEAN:
+                v = struct.unpack('<Q', slot)[0] == 1
+            elif t == VALUE_INTEGER:
+                v = struct.unpack('<q', slot)[0]
+            elif t == VALUE_DOUBLE:
+                v = struct.unpack('<d', slot)[0]
+            elif t == VALUE_POINT:
+                v = struct.unpack('<ff', slot)
+            else:
+                offset, length = struct.unpack('<II', slot)
+                reader = HeapReader(chunk, heap_offset + offset)
+                if t == VALUE_STRING:
+                    v = reader.read_bytes(length)
+                else:
+                    v = reader.read_payload(t)
+                assert reader.offset == heap_offset + offset + length
+
+            rows[r][c] = v
+
+    return rows
+
+
+class testBinaryResultSet():
+    def __init__(self):
+        self.env = Env(decodeResponses=False)
+        self.conn = self.env.getConnection()
+        self.conn.execute_command("GRAPH.QUERY", GRAPH_ID,
+            "CREATE (:A {name: 'a', v: 1})-[:R {w: 0.5}]->(:B {name: 'b', v: 2})")
+
+    def binary_query(self, q):
+        res = self.conn.execute_command("GRAPH.QUERY", GRAPH_ID, q, "--binary")
+        self.env.assertEquals(len(res), 3)
+
+        header = [col[1].decode() for col in res[0]]
+        rows = []
+        for chunk in res[1]:
+            rows.extend(decode_chunk(chunk))
+        return header, rows
+
+    def test01_scalars(self):
+        q = """RETURN 1, -2, 2.5, 'str', true, false, null, [1, 'a', [null]],
+               {k: 1, m: {x: 'y'}}, point({latitude: 1.5, longitude: 2.5})"""
+        header, rows = self.binary_query(q)
+        self.env.assertEquals(len(header), 10)
+        self.env.assertEquals(rows, [[1, -2, 2.5, 'str', True, False, None,
+            [1, 'a', [None]], {'k': 1, 'm': {'x': 'y'}}, (1.5, 2.5)]])
+
+    def test02_entities(self):
+        q = "MATCH p=(a:A)-[e:R]->(b:B) RETURN a, e, b, p"
+        header, rows = self.binary_query(q)
+        self.env.assertEquals(header, ['a', 'e', 'b', 'p'])
+        self.env.assertEquals(len(rows), 1)
+
+        a, e, b, p = rows[0]
+        # property key IDs: name = 0, v = 1, w = 2
+        self.env.assertEquals(a, ('node', 0, [0], {0: 'a', 1: 1}))
+        self.env.assertEquals(b, ('node', 1, [1], {0: 'b', 1: 2}))
+        self.env.assertEquals(e, ('edge', 0, 0, 0, 1, {2: 0.5}))
+        self.env.assertEquals(p, ('path', [a, b], [e]))
+
+    def test03_multiple_chunks(self):
+        # 4096 rows per chunk
+        n = 10000
+        q = f"UNWIND range(1, {n}) AS x RETURN x, toString(x)"
+        header, rows = self.binary_query(q)
+        self.env.assertEquals(rows, [[x, str(x)] for x in range(1, n + 1)])
+
+        res = self.conn.execute_command("GRAPH.QUERY", GRAPH_ID, q, "--binary")
+        self.env.assertEquals(len(res[1]), 3)
+
+    def test04_empty(self):
+        header, rows = self.binary_query("MATCH (n:NONE) RETURN n")
+        self.env.assertEquals(header, ['n'])
+        self.env.assertEquals(rows, [])
+
+    def test05_streaming(self):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_STREAMING", "yes")
+        q = "UNWIND range(1, 5000) AS x RETURN x"
+        header, rows = self.binary_query(q)
+        self.env.assertEquals(rows, [[x] for x in range(1, 5001)])
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_STREAMING", "no")
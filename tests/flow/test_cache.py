@@ -24,16 +24,18 @@ class testCache():
         plan_graph.delete()
 
     def test_01_sanity_check(self):
+        # literals are parameterized, vary the attribute name
+        # to produce distinct queries
         graph = Graph(redis_con, 'Cache_Sanity_Check')
         for i in range(CACHE_SIZE + 1):
-            result = graph.query("MATCH (n) WHERE n.value = {val} RETURN n".format(val=i))
+            result = graph.query("MATCH (n) WHERE n.value{val} = 1 RETURN n".format(val=i))
             self.env.assertFalse(result.cached_execution)
         
         for i in range(1, CACHE_SIZE + 1):
-            result = graph.query("MATCH (n) WHERE n.value = {val} RETURN n".format(val=i))
+            result = graph.query("MATCH (n) WHERE n.value{val} = 1 RETURN n".format(val=i))
             self.env.assertTrue(result.cached_execution)
         
-        result = graph.query("MATCH (n) WHERE n.value = 0 RETURN n")
+        result = graph.query("MATCH (n) WHERE n.value0 = 1 RETURN n")
         self.env.assertFalse(result.cached_execution)
 
         graph.delete()
@@ -245,7 +247,99 @@ class testCache():
         self.env.assertEqual(expected_result, cached_result.result_set)
         self.env.assertTrue(cached_result.cached_execution)
 
-    def test_14_cache_eviction(self):
+    def test_14_auto_parameterization(self):
+        graph = Graph(redis_con, 'Cache_Auto_Params')
+        graph.query("UNWIND range(0, 9) AS x CREATE (:N {v: x, s: toString(x)})")
+
+        # queries which differ only by their literals share a plan
+        result = graph.query("MATCH (n:N {v: 3}) RETURN n.s")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual([['3']], result.result_set)
+
+        result = graph.query("MATCH (n:N {v: 4}) RETURN n.s")
+        self.env.assertTrue(result.cached_execution)
+        self.env.assertEqual([['4']], result.result_set)
+
+        result = graph.query("MATCH (n:N) WHERE n.s = '5' OR n.v = 7.0 RETURN n.v ORDER BY n.v")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual([[5], [7]], result.result_set)
+
+        result = graph.query("MATCH (n:N) WHERE n.s = '6' OR n.v = 1.0 RETURN n.v ORDER BY n.v")
+        self.env.assertTrue(result.cached_execution)
+        self.env.assertEqual([[1], [6]], result.result_set)
+
+        # literals are used alongside user parameters
+        result = graph.query("MATCH (n:N) WHERE n.v > $min AND n.v < 3 RETURN count(n)", {'min': 0})
+        self.env.assertEqual([[2]], result.result_set)
+        result = graph.query("MATCH (n:N) WHERE n.v > $min AND n.v < 9 RETURN count(n)", {'min': 5})
+        self.env.assertTrue(result.cached_execution)
+        self.env.assertEqual([[3]], result.result_set)
+
+        # LIMIT and SKIP literals are kept
+        result = graph.query("MATCH (n:N) RETURN n.v ORDER BY n.v SKIP 1 LIMIT 1")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual([[1]], result.result_set)
+
+        result = graph.query("MATCH (n:N) RETURN n.v ORDER BY n.v SKIP 1 LIMIT 2")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual([[1], [2]], result.result_set)
+
+        # variable length ranges are kept
+        graph.query("CREATE (:P {v: 0})-[:R]->(:P {v: 1})-[:R]->(:P {v: 2})")
+        result = graph.query("MATCH (a:P {v: 0})-[*1]->(b) RETURN b.v")
+        self.env.assertEqual([[1]], result.result_set)
+        result = graph.query("MATCH (a:P {v: 0})-[*2]->(b) RETURN b.v")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual([[2]], result.result_set)
+
+        # unaliased RETURN projections name result-set columns
+        result = graph.query("RETURN 1")
+        self.env.assertEqual('1', result.header[0][1])
+        result = graph.query("RETURN 2")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual('2', result.header[0][1])
+        self.env.assertEqual([[2]], result.result_set)
+
+        # errors refer to the issued query
+        try:
+            graph.query("MATCH (n {v: 1}) RETURN n.v +")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertNotIn("__lit", str(e))
+
+        # EXPLAIN reports the query's literals
+        q = "MATCH (a:N), (b:N) WHERE a.v = b.v - 1 RETURN a.v, b.v"
+        graph.query(q)
+        plan = graph.execution_plan(q)
+        self.env.assertIn("b.v - 1", plan)
+        self.env.assertNotIn("__lit", plan)
+
+        graph.delete()
+
+    def test_15_cache_stats(self):
+        graph = Graph(redis_con, 'Cache_Stats')
+
+        def _stats():
+            res = redis_con.execute_command("GRAPH.INFO", "PlanCache")
+            self.env.assertEqual(res[0], "# Plan cache")
+            for entry in res[1]:
+                stats = dict(zip(entry[::2], entry[1::2]))
+                if stats["Graph name"] == 'Cache_Stats':
+                    return stats["Cache hits"], stats["Cache misses"]
+            self.env.assertTrue(False)
+
+        graph.query("RETURN 1")
+        hits, misses = _stats()
+
+        graph.query("MATCH (n {v: 1}) RETURN n")
+        graph.query("MATCH (n {v: 2}) RETURN n")
+        graph.query("MATCH (n {v: 3}) RETURN n")
+
+        self.env.assertEqual(_stats(), (hits + 2, misses + 1))
+
+        graph.delete()
+
+    def test_16_cache_eviction(self):
         # this tests spawns a new graph env` with a query-cache with just
         # a single slot, then multiple clients are issuing a similar query
         # only with a small variation to cause a cache miss which implies
@@ -287,3 +381,53 @@ class testCache():
 
         loop.run_until_complete(asyncio.wait(tasks))
 
+    def test_17_disable_auto_parameterization(self):
+        graph = Graph(redis_con, 'Cache_No_Auto_Params')
+        graph.query("UNWIND range(0, 9) AS x CREATE (:N {v: x})")
+
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "CACHE_PARAMETERIZE", "no")
+        res = redis_con.execute_command("GRAPH.CONFIG", "GET", "CACHE_PARAMETERIZE")
+        self.env.assertEqual(res, ["CACHE_PARAMETERIZE", 0])
+
+        # each literal gets a plan of its own
+        result = graph.query("MATCH (n:N {v: 3}) RETURN n.v")
+        self.env.assertFalse(result.cached_execution)
+        result = graph.query("MATCH (n:N {v: 4}) RETURN n.v")
+        self.env.assertFalse(result.cached_execution)
+        self.env.assertEqual([[4]], result.result_set)
+        result = graph.query("MATCH (n:N {v: 4}) RETURN n.v")
+        self.env.assertTrue(result.cached_execution)
+
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "CACHE_PARAMETERIZE", "yes")
+        result = graph.query("MATCH (n:N {v: 5}) RETURN n.v")
+        self.env.assertFalse(result.cached_execution)
+        result = graph.query("MATCH (n:N {v: 6}) RETURN n.v")
+        self.env.assertTrue(result.cached_execution)
+        self.env.assertEqual([[6]], result.result_set)
+
+        graph.delete()
+
+    def test_18_auto_parameterization_projection_names(self):
+        graph = Graph(redis_con, 'Cache_Auto_Params_Names')
+        graph.query("UNWIND range(0, 9) AS x CREATE (:N {v: x, s: toString(x)})")
+
+        # parameterized literals change the query's length
+        # projections must still be named after their own text
+        queries = [
+            ("MATCH (n:N) WHERE n.s = '5' OR n.v = 7.0 RETURN n.v * 2 ORDER BY n.v * 2", [[10], [14]]),
+            ("MATCH (n:N) WHERE n.s = '6' OR n.v = 1.0 RETURN n.v * 2 ORDER BY n.v * 2", [[2], [12]]),
+            ("MATCH (n:N) WHERE n.s = 'not a number, long enough to shrink the query' OR n.v = 3 RETURN n.v * 2 ORDER BY n.v * 2", [[6]])
+        ]
+
+        for i, (q, expected) in enumerate(queries):
+            result = graph.query(q)
+            self.env.assertEqual(i > 0, result.cached_execution)
+            self.env.assertEqual('n.v * 2', result.header[0][1])
+            self.env.assertEqual(expected, result.result_set)
+
+        # projected expressions referred to by later clauses
+        q = "MATCH (n:N) WHERE n.s = '4' WITH n.v + 1 AS x, [(n)-[]->() | 1] AS p RETURN x, size(p) ORDER BY x"
+        result = graph.query(q)
+        self.env.assertEqual([[5, 0]], result.result_set)
+
+        graph.delete()
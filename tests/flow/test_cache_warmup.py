@@ -0,0 +1,123 @@
+import time
+from common import *
+
+GRAPH_ID = "cache_warmup"
+
+class testCacheWarmup():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, moduleArgs='CACHE_SIZE 4 CACHE_PERSIST_SIZE 3')
+        self.conn = self.env.getConnection()
+        self.graph = Graph(self.conn, GRAPH_ID)
+
+        self.graph.query("UNWIND range(0, 9) AS x CREATE (:N {v: x})")
+
+    def stats(self):
+        res = self.conn.execute_command("GRAPH.CACHE", GRAPH_ID, "STATS")
+        return dict(zip(res[::2], res[1::2]))
+
+    def cached_queries(self):
+        return {q: hits for q, hits in self.stats()['queries']}
+
+    # wait for background warm-up to cache 'n' queries
+    def wait_for_cache_size(self, n):
+        for _ in range(50):
+            if self.stats()['size'] == n:
+                return
+            time.sleep(0.1)
+        self.env.assertEquals(self.stats()['size'], n)
+
+    def test01_stats(self):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "CACHE_PERSIST_SIZE", 0)
+        self.conn.execute_command("DEBUG", "RELOAD")
+
+        # persistence is disabled, nothing is restored
+        stats = self.stats()
+        self.env.assertEquals(stats['size'], 0)
+        self.env.assertEquals(stats['capacity'], 4)
+        self.env.assertEquals(stats['queries'], [])
+
+        q = "MATCH (n:N) RETURN count(n)"
+        for _ in range(4):
+            self.graph.query(q)
+
+        stats = self.stats()
+        self.env.assertEquals(stats['hits'], 3)
+        self.env.assertEquals(stats['misses'], 1)
+        self.env.assertAlmostEqual(float(stats['hit_rate']), 0.75, 1E-5)
+        self.env.assertEquals(stats['queries'], [[q, 3]])
+
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "CACHE_PERSIST_SIZE", 3)
+
+    def test02_persist_and_warm_up(self):
+        hot  = "MATCH (n:N) RETURN count(n)"
+        warm = "MATCH (n:N) RETURN max(n.v)"
+        cold = "MATCH (n:N) RETURN min(n.v)"
+        lit  = "MATCH (n:N) WHERE n.v = 3 RETURN n.v"
+
+        for q, n in [(hot, 4), (warm, 3), (lit, 2), (cold, 1)]:
+            for _ in range(n):
+                self.graph.query(q)
+
+        self.conn.execute_command("DEBUG", "RELOAD")
+
+        # only the 3 hottest queries are persisted, along with their hits
+        self.wait_for_cache_size(3)
+        cached = self.cached_queries()
+        # 'hot' was hit 3 times during test01 as well
+        self.env.assertEquals(cached[hot], 3 + 4)
+        self.env.assertEquals(cached[warm], 2)
+        self.env.assertEquals(len(cached), 3)
+        self.env.assertNotIn(cold, cached)
+
+        # warm-up doesn't count as hits nor misses
+        stats = self.stats()
+        self.env.assertEquals(stats['hits'], 0)
+        self.env.assertEquals(stats['misses'], 0)
+
+        # restored queries are served from cache, literals may differ
+        self.env.assertTrue(self.graph.query(hot).cached_execution)
+        res = self.graph.query("MATCH (n:N) WHERE n.v = 5 RETURN n.v")
+        self.env.assertTrue(res.cached_execution)
+        self.env.assertEquals(res.result_set, [[5]])
+        self.env.assertFalse(self.graph.query(cold).cached_execution)
+
+    def test03_warmup_command(self):
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "CACHE_PERSIST_SIZE", 0)
+        self.conn.execute_command("DEBUG", "RELOAD")
+
+        q = "MATCH (n:N) WHERE n.v > 7 RETURN n.v ORDER BY n.v"
+        res = self.conn.execute_command("GRAPH.CACHE", GRAPH_ID, "WARMUP", q,
+                                        "MATCH (n) RETURN m",
+                                        "CREATE INDEX FOR (n:N) ON (n.v)")
+        self.env.assertEquals(res[0], "OK")
+        self.env.assertIn("'m' not defined", str(res[1]))
+        self.env.assertIn("Only queries can be cached", str(res[2]))
+
+        self.env.assertEquals(self.stats()['size'], 1)
+
+        # planned query is served from cache
+        res = self.graph.query(q)
+        self.env.assertTrue(res.cached_execution)
+        self.env.assertEquals(res.result_set, [[8], [9]])
+
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "CACHE_PERSIST_SIZE", 3)
+
+    def test04_invalid_usage(self):
+        for args in [["STATS", "extra"], ["WARMUP"], []]:
+            try:
+                self.conn.execute_command("GRAPH.CACHE", GRAPH_ID, *args)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("wrong number of arguments", str(e))
+
+        try:
+            self.conn.execute_command("GRAPH.CACHE", GRAPH_ID, "RESET")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Unknown subcommand", str(e))
+
+        try:
+            self.conn.execute_command("GRAPH.CACHE", "missing", "STATS")
+            self.env.assertTrue(False)
+        except ResponseError:
+            pass
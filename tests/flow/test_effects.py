@@ -1,4 +1,5 @@
 import time
+import struct
 import threading
 from common import *
 
@@ -836,3 +837,127 @@ class testEffects():
         self.master.wait(1, 0)
         self.assert_graph_eq()
 
+
+    def test_16_bulk_effects(self):
+        # large modifications are replicated as grouped, compressed effects
+        global GRAPH_ID
+        GRAPH_ID = "bulk_effects"
+
+        self.master_graph = Graph(self.master, GRAPH_ID)
+        self.replica_graph = Graph(self.replica, GRAPH_ID)
+
+        self.effects_enable()
+
+        self.master_graph.query("CREATE INDEX FOR (n:Bulk) ON (n.id)")
+        self.master.wait(1, 0)
+
+        # bulk node creation, repeating strings are dictionary encoded
+        q = """UNWIND range(0, 4999) AS x
+               CREATE (:Bulk {id: x, s: 'v' + toString(x % 10), f: x / 3.0,
+                              b: x % 2 = 0, a: [x, 'a', [-x]],
+                              p: point({latitude: x % 90, longitude: 0})})"""
+        res = self.master_graph.query(q)
+        self.env.assertEquals(res.nodes_created, 5000)
+
+        # bulk edge creation
+        q = """UNWIND range(0, 4998) AS x
+               MATCH (a:Bulk {id: x}), (b:Bulk {id: x + 1})
+               CREATE (a)-[:NEXT {w: -x, s: 'e'}]->(b)"""
+        res = self.master_graph.query(q)
+        self.env.assertEquals(res.relationships_created, 4999)
+
+        # bulk node and edge updates
+        q = "MATCH (n:Bulk) WHERE n.id % 3 = 0 SET n.f = -n.f, n.s = NULL, n.x = 'x'"
+        self.master_graph.query(q)
+
+        q = "MATCH ()-[e:NEXT]->() WHERE e.w % 2 = 0 SET e.w = e.w * 2, e.s = NULL"
+        self.master_graph.query(q)
+
+        # bulk label updates
+        q = "MATCH (n:Bulk) WHERE n.id % 5 = 0 SET n:Five"
+        self.master_graph.query(q)
+
+        q = "MATCH (n:Five) WHERE n.id % 10 = 0 REMOVE n:Five"
+        self.master_graph.query(q)
+
+        # bulk deletion
+        q = "MATCH (n:Bulk) WHERE n.id % 7 = 0 DETACH DELETE n"
+        res = self.master_graph.query(q)
+        self.env.assertGreater(res.nodes_deleted, 0)
+
+        # wait for replica and master to sync
+        self.master.wait(1, 0)
+        self.assert_graph_eq()
+
+    def test_17_replica_apply_stats(self):
+        # replica tracks effects apply statistics
+        res = self.replica.execute_command("GRAPH.INFO", "Replication")
+        self.env.assertEquals(res[0], "# Replication")
+
+        stats = dict(zip(res[1][::2], res[1][1::2]))
+        applied = stats["Applied effects"]
+        self.env.assertGreater(applied, 0)
+        self.env.assertGreaterEqual(stats["Apply lag"], 0)
+        self.env.assertGreaterEqual(stats["Max apply lag"], stats["Apply lag"])
+        self.env.assertGreaterEqual(float(stats["Apply duration"]), 0)
+
+        # a new effect bumps the applied counter
+        self.query_master_and_wait("UNWIND range(0, 10) AS x CREATE (:Stats {v: x})")
+        self.master.wait(1, 0)
+
+        res = self.replica.execute_command("GRAPH.INFO", "Replication")
+        stats = dict(zip(res[1][::2], res[1][1::2]))
+        self.env.assertGreater(stats["Applied effects"], applied)
+
+        # primary didn't apply any effects
+        res = self.master.execute_command("GRAPH.INFO", "Replication")
+        stats = dict(zip(res[1][::2], res[1][1::2]))
+        self.env.assertEquals(stats["Applied effects"], 0)
+
+    def test_18_malformed_effects(self):
+        # malformed effects are rejected without being applied
+        g = Graph(self.master, "malformed_effects")
+        g.query("CREATE (:M {v: 1})")
+
+        def _varint(v):
+            b = b''
+            while v >= 0x80:
+                b += bytes([(v & 0x7F) | 0x80])
+                v >>= 7
+            return b + bytes([v])
+
+        # single node creation group, setting attribute 0
+        def _effects(types, values, t=3):
+            attrs = _varint(1) + _varint(0)
+            col = lambda c: _varint(len(c)) + c
+            return (bytes([2]) + struct.pack('<Q', 0) + bytes([0]) +
+                    bytes([t]) + _varint(1) + _varint(0) + _varint(0) +
+                    col(b'') + col(attrs) + col(types) + col(values))
+
+        vec = bytes([8]), _varint(2) + struct.pack('<2f', 1, 2)
+        malformed = [
+            _effects(bytes([0x7F]), b''),                    # unknown value type
+            _effects(bytes([8]), _varint(1 << 40)),          # vector dimension
+            _effects(bytes([8]), _varint(4) + vec[1][1:]),   # short vector
+            _effects(bytes([5]), _varint(0)),                # missing string
+            _effects(*vec, t=0x7F),                          # unknown effect type
+            _effects(*vec)[:-1],                             # truncated
+            _effects(*vec) + b'\x03',                        # trailing bytes
+        ]
+
+        for buff in malformed:
+            try:
+                self.master.execute_command("GRAPH.EFFECT", "malformed_effects", buff)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertContains("Malformed effects buffer", str(e))
+
+        # nothing was applied
+        self.env.assertEquals(g.query("MATCH (n) RETURN count(n)").result_set, [[1]])
+
+        # well formed effects are applied
+        res = self.master.execute_command("GRAPH.EFFECT", "malformed_effects", _effects(*vec))
+        self.env.assertEquals(res, "OK")
+
+        res = g.query("MATCH (n) WHERE NOT n:M RETURN toString(n.v)")
+        self.env.assertEquals(res.result_set, [["<1.000000, 2.000000>"]])
@@ -92,3 +92,90 @@ class testFulltextIndexQuery():
         result = graph.query("CALL db.idx.fulltext.queryNodes('L5', 'word')")
         self.env.assertEquals(result.result_set, [])
 
+
+    # full-text query with a limit and an offset
+    def test02_fulltext_query_limit_offset(self):
+        # hits are ranked by score
+        q = """CALL db.idx.fulltext.queryNodes('L3', 'redis', {limit: 1})
+               YIELD node RETURN node"""
+        result = graph.query(q).result_set
+        self.env.assertEquals(len(result), 1)
+        self.env.assertEquals(result[0][0].properties["v2"], "hello redis")
+
+        q = """CALL db.idx.fulltext.queryNodes('L3', 'redis', {limit: 1, offset: 1})
+               YIELD node RETURN node"""
+        result = graph.query(q).result_set
+        self.env.assertEquals(len(result), 1)
+        self.env.assertEquals(result[0][0].properties["v1"], "hello redis")
+
+        q = """CALL db.idx.fulltext.queryNodes('L3', 'redis', {offset: 2})
+               YIELD node RETURN node"""
+        self.env.assertEquals(graph.query(q).result_set, [])
+
+        q = """CALL db.idx.fulltext.queryNodes('L3', 'redis', {limit: 0})
+               YIELD node RETURN node"""
+        self.env.assertEquals(graph.query(q).result_set, [])
+
+        # top hits match a full sort by score
+        g = Graph(self.env.getConnection(), 'fulltext_limit')
+        g.query("CALL db.idx.fulltext.createNodeIndex('D', 'v')")
+        wait_for_indices_to_sync(g)
+        g.query("""UNWIND range(1, 50) AS i
+                   CREATE (:D {i: i, v: reduce(s = 'doc', j IN range(1, i % 7) | s + ' redis')
+                   + reduce(s = '', j IN range(1, i % 5) | s + ' graph')})""")
+
+        expected = g.query("""CALL db.idx.fulltext.queryNodes('D', 'redis')
+                              YIELD score RETURN score ORDER BY score DESC""").result_set
+        for (limit, offset) in [(1, 0), (5, 0), (10, 3), (100, 0), (5, 45)]:
+            q = f"""CALL db.idx.fulltext.queryNodes('D', 'redis',
+                    {{limit: {limit}, offset: {offset}}}) YIELD score RETURN score"""
+            actual = g.query(q).result_set
+            self.env.assertEquals(actual, expected[offset:offset + limit])
+
+        # invalid options
+        for options in ["[]", "{limit: -1}", "{offset: 'a'}"]:
+            try:
+                q = f"CALL db.idx.fulltext.queryNodes('D', 'redis', {options})"
+                g.query(q)
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError:
+                pass
+
+    # full-text query over relationships
+    def test03_fulltext_query_relationships(self):
+        g = Graph(self.env.getConnection(), 'fulltext_relationships')
+        g.query("CALL db.idx.fulltext.createRelationshipIndex('R', 'v')")
+        wait_for_indices_to_sync(g)
+
+        g.query("""CREATE (a:A {name: 'a'}), (b:B {name: 'b'}),
+                   (a)-[:R {v: 'hello redis'}]->(b),
+                   (b)-[:R {v: 'hello redis redis'}]->(a),
+                   (a)-[:R {v: 'goodbye'}]->(a)""")
+
+        q = """CALL db.idx.fulltext.queryRelationships('R', 'hello')
+               YIELD relationship
+               RETURN startNode(relationship).name, endNode(relationship).name,
+               relationship.v ORDER BY relationship.v"""
+        result = g.query(q).result_set
+        self.env.assertEquals(result, [['a', 'b', 'hello redis'],
+                                       ['b', 'a', 'hello redis redis']])
+
+        q = """CALL db.idx.fulltext.queryRelationships('R', 'redis', {limit: 1})
+               YIELD relationship, score
+               RETURN relationship.v"""
+        result = g.query(q).result_set
+        self.env.assertEquals(result, [['hello redis redis']])
+
+        # index is kept up to date
+        g.query("MATCH ()-[r:R {v: 'goodbye'}]->() SET r.v = 'hello again'")
+        q = """CALL db.idx.fulltext.queryRelationships('R', 'again')
+               YIELD relationship RETURN relationship.v"""
+        self.env.assertEquals(g.query(q).result_set, [['hello again']])
+
+        g.query("MATCH ()-[r:R {v: 'hello again'}]->() DELETE r")
+        self.env.assertEquals(g.query(q).result_set, [])
+
+        # drop index
+        g.query("CALL db.idx.fulltext.dropRelationshipIndex('R')")
+        indexes = g.query("CALL db.indexes() YIELD label RETURN label").result_set
+        self.env.assertEquals(indexes, [])
@@ -0,0 +1,113 @@
+from common import *
+
+GRAPH_ID = "graph_algorithms"
+redis_graph = None
+
+
+class testGraphAlgorithms(FlowTestsBase):
+    def __init__(self):
+        self.env = Env(decodeResponses=True)
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(redis_con, GRAPH_ID)
+        self.populate_graph()
+
+    def populate_graph(self):
+        # two triangles (0, 1, 2) and (3, 4, 5) connected by a single edge
+        # node 6 is only reachable over an edge of a different type
+        q = """UNWIND range(0, 6) AS x CREATE (:N {v: x})"""
+        redis_graph.query(q)
+
+        q = """UNWIND [[0, 1], [1, 2], [2, 0], [2, 3], [3, 4], [4, 5], [5, 3]] AS e
+               MATCH (a:N {v: e[0]}), (b:N {v: e[1]})
+               CREATE (a)-[:R]->(b)"""
+        redis_graph.query(q)
+
+        # parallel edges and self loops do not form triangles
+        q = """MATCH (a:N {v: 0}), (b:N {v: 1}), (c:N {v: 6})
+               CREATE (b)-[:R]->(a), (a)-[:R]->(a), (a)-[:S]->(c)"""
+        redis_graph.query(q)
+
+    def test01_wcc(self):
+        q = """CALL algo.wcc('N', 'R') YIELD node, componentId
+               RETURN node.v, componentId ORDER BY node.v"""
+        result = redis_graph.query(q).result_set
+        self.env.assertEquals(result, [[0, 0], [1, 0], [2, 0], [3, 0],
+                                       [4, 0], [5, 0], [6, 6]])
+
+        # all relationship types
+        q = """CALL algo.wcc(NULL, NULL) YIELD componentId
+               RETURN collect(DISTINCT componentId)"""
+        result = redis_graph.query(q).result_set
+        self.env.assertEquals(result, [[[0]]])
+
+        # unknown label
+        q = """CALL algo.wcc('NONE', 'R') YIELD node RETURN count(node)"""
+        result = redis_graph.query(q).result_set
+        self.env.assertEquals(result, [[0]])
+
+    def test02_wcc_write(self):
+        q = """CALL algo.wcc.write('N', 'R', {writeProperty: 'component'})
+               YIELD nodes, components RETURN nodes, components"""
+        res = redis_graph.query(q)
+        self.env.assertEquals(res.result_set, [[7, 2]])
+        self.env.assertEquals(res.properties_set, 7)
+
+        q = """MATCH (n:N) RETURN n.v, n.component ORDER BY n.v"""
+        result = redis_graph.query(q).result_set
+        self.env.assertEquals(result, [[0, 0], [1, 0], [2, 0], [3, 0],
+                                       [4, 0], [5, 0], [6, 6]])
+
+        # refreshing only updates nodes whose component changed
+        q = """CALL algo.wcc.write('N', 'R', {writeProperty: 'component'})
+               YIELD nodes, components RETURN nodes, components"""
+        res = redis_graph.query(q)
+        self.env.assertEquals(res.result_set, [[0, 2]])
+
+        redis_graph.query("MATCH (a:N {v: 2})-[e:R]->(b:N {v: 3}) DELETE e")
+        res = redis_graph.query(q)
+        self.env.assertEquals(res.result_set, [[3, 3]])
+
+        q = """MATCH (n:N) RETURN n.v, n.component ORDER BY n.v"""
+        result = redis_graph.query(q).result_set
+        self.env.assertEquals(result, [[0, 0], [1, 0], [2, 0], [3, 3],
+                                       [4, 3], [5, 3], [6, 6]])
+
+        # restore bridge
+        redis_graph.query("""MATCH (a:N {v: 2}), (b:N {v: 3})
+                             CREATE (a)-[:R]->(b)""")
+
+        # writeProperty is required
+        try:
+            redis_graph.query("CALL algo.wcc.write('N', 'R', {})")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("writeProperty is missing", str(e))
+
+    def test03_triangle_count(self):
+        q = """CALL algo.triangleCount('N', 'R') YIELD node, triangles
+               RETURN node.v, triangles ORDER BY node.v"""
+        result = redis_graph.query(q).result_set
+        self.env.assertEquals(result, [[0, 1], [1, 1], [2, 1], [3, 1],
+                                       [4, 1], [5, 1], [6, 0]])
+
+    def test04_label_propagation(self):
+        q = """CALL algo.labelPropagation('N', 'R') YIELD node, communityId
+               RETURN node.v, communityId ORDER BY node.v"""
+        result = redis_graph.query(q).result_set
+        self.env.assertEquals(result, [[0, 0], [1, 0], [2, 0], [3, 3],
+                                       [4, 3], [5, 3], [6, 6]])
+
+        # a single iteration doesn't settle the bridge between the triangles
+        q = """CALL algo.labelPropagation('N', 'R', {maxIterations: 1})
+               YIELD node, communityId
+               RETURN node.v, communityId ORDER BY node.v"""
+        result = redis_graph.query(q).result_set
+        self.env.assertEquals(result, [[0, 0], [1, 0], [2, 0], [3, 2],
+                                       [4, 3], [5, 3], [6, 6]])
+
+        try:
+            redis_graph.query("CALL algo.labelPropagation('N', 'R', {maxIterations: 0})")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("maxIterations must be a positive integer", str(e))
@@ -699,3 +699,58 @@ class testGraphMergeFlow(FlowTestsBase):
         # ensure that only 11 nodes are created and no crash
         res = graph.query("UNWIND range(0, 10) AS i CREATE (:A {id: i}) MERGE (:B {id: i % 10})")
         self.env.assertEquals(res.nodes_created, 11)
+
+    def test34_merge_batched_index_probe(self):
+        # MERGE on indexed attributes resolves input records in batches
+        # make sure results are identical to a per record match
+        redis_con = self.env.getConnection()
+        graph = Graph(redis_con, "merge_batched_index_probe")
+        create_node_exact_match_index(graph, 'User', 'id', sync=True)
+        create_node_exact_match_index(graph, 'Item', 'a', 'b', sync=True)
+
+        # populate more nodes than fit in a single batch
+        res = graph.query("UNWIND range(0, 2999) AS x MERGE (:User {id: x})")
+        self.env.assertEquals(res.nodes_created, 3000)
+
+        # existing entities are matched, duplicates are created once
+        q = """UNWIND range(2000, 4999) AS x
+               MERGE (u:User {id: x % 4000})
+               ON MATCH SET u.matched = true
+               ON CREATE SET u.created = true"""
+        res = graph.query(q)
+        self.env.assertEquals(res.nodes_created, 1000)
+
+        res = graph.query("MATCH (u:User) RETURN count(u), count(u.matched), count(u.created)")
+        self.env.assertEquals(res.result_set[0], [4000, 2000, 1000])
+
+        # every input record matching an existing node is emitted
+        res = graph.query("UNWIND [1, 1, 2] AS x MERGE (u:User {id: x}) RETURN u.id ORDER BY u.id")
+        self.env.assertEquals(res.result_set, [[1], [1], [2]])
+
+        # numeric values match regardless of their type
+        res = graph.query("UNWIND [1.0, 2, 3.0] AS x MERGE (u:User {id: x}) RETURN count(u)")
+        self.env.assertEquals(res.nodes_created, 0)
+        self.env.assertEquals(res.result_set[0][0], 3)
+
+        # strings and multiple keys
+        q = """UNWIND [{a: 'x', b: 1}, {a: 'x', b: 2}, {a: 'X', b: 1}, {a: 'x', b: 1}] AS r
+               MERGE (i:Item {a: r.a, b: r.b})"""
+        res = graph.query(q)
+        self.env.assertEquals(res.nodes_created, 3)
+        res = graph.query(q)
+        self.env.assertEquals(res.nodes_created, 0)
+
+        # none indexable values fall back to a per record match
+        q = "UNWIND [[1], [1], 5000] AS x MERGE (u:User {id: x}) RETURN count(u)"
+        res = graph.query(q)
+        self.env.assertEquals(res.nodes_created, 2)
+        res = graph.query(q)
+        self.env.assertEquals(res.nodes_created, 0)
+        self.env.assertEquals(res.result_set[0][0], 3)
+
+        # null values are still rejected
+        try:
+            graph.query("UNWIND [1, null] AS x MERGE (u:User {id: x})")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("Cannot merge node using null property value", str(e))
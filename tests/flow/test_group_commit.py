@@ -0,0 +1,152 @@
+from common import *
+from pathos.pools import ProcessPool as Pool
+from pathos.helpers import mp as pathos_multiprocess
+
+GRAPH_ID = "group_commit"
+CLIENT_COUNT = 16
+
+
+def run_write_query(query, barrier):
+    env = Env(decodeResponses=True)
+    conn = env.getConnection()
+    graph = Graph(conn, GRAPH_ID)
+
+    barrier.wait()
+
+    try:
+        result = graph.query(query)
+        return result.nodes_created
+    except ResponseError as e:
+        return str(e)
+
+def run_concurrent(queries):
+    pool = Pool(nodes=CLIENT_COUNT)
+    manager = pathos_multiprocess.Manager()
+
+    barrier = manager.Barrier(len(queries))
+    barriers = [barrier] * len(queries)
+
+    results = pool.map(run_write_query, queries, barriers)
+
+    pool.clear()
+
+    return results
+
+class testGroupCommit():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, env='oss', useSlaves=True)
+        # skip test if we're running under Valgrind
+        if VALGRIND:
+            self.env.skip() # valgrind is not working correctly with multi processing
+
+        self.master        = self.env.getConnection()
+        self.replica       = self.env.getSlaveConnection()
+        self.master_graph  = Graph(self.master, GRAPH_ID)
+        self.replica_graph = Graph(self.replica, GRAPH_ID)
+
+        # make sure graph exists
+        self.master_graph.query("RETURN 1")
+
+    def test01_group_commit_config(self):
+        # group commit is disabled by default
+        res = self.master.execute_command("GRAPH.CONFIG", "GET", "GROUP_COMMIT_SIZE")
+        self.env.assertEquals(res, ["GROUP_COMMIT_SIZE", 1])
+
+        # invalid values
+        for v in ["0", "-1", "1025", "a"]:
+            try:
+                self.master.execute_command("GRAPH.CONFIG", "SET", "GROUP_COMMIT_SIZE", v)
+                self.env.assertTrue(False)
+            except ResponseError:
+                pass
+
+        self.master.execute_command("GRAPH.CONFIG", "SET", "GROUP_COMMIT_SIZE", CLIENT_COUNT)
+        res = self.master.execute_command("GRAPH.CONFIG", "GET", "GROUP_COMMIT_SIZE")
+        self.env.assertEquals(res, ["GROUP_COMMIT_SIZE", CLIENT_COUNT])
+
+    def test02_concurrent_writes(self):
+        # every client creates its own node
+        # a single query fails and should be rolled back on its own
+        queries = []
+        for i in range(CLIENT_COUNT):
+            if i == CLIENT_COUNT / 2:
+                queries.append(f"CREATE (:N {{v: {i}}}) WITH 1 AS x RETURN 1 / 0")
+            else:
+                queries.append(f"CREATE (:N {{v: {i}}})")
+
+        results = run_concurrent(queries)
+
+        for i, res in enumerate(results):
+            if i == CLIENT_COUNT / 2:
+                self.env.assertIn("Division by zero", res)
+            else:
+                self.env.assertEquals(res, 1)
+
+        # failed query shouldn't leave any trace
+        res = self.master_graph.query("MATCH (n:N) RETURN count(n)").result_set
+        self.env.assertEquals(res[0][0], CLIENT_COUNT - 1)
+
+        res = self.master_graph.query(f"MATCH (n:N {{v: {CLIENT_COUNT / 2}}}) RETURN count(n)").result_set
+        self.env.assertEquals(res[0][0], 0)
+
+    def test03_group_replication(self):
+        # wait for replica to catch up
+        self.master.wait(1, 0)
+
+        q = "MATCH (n:N) RETURN n.v ORDER BY n.v"
+        master_resultset = self.master_graph.query(q).result_set
+        replica_resultset = self.replica_graph.query(q, read_only=True).result_set
+        self.env.assertEquals(master_resultset, replica_resultset)
+
+    def replicated_commands(self):
+        # wait for replica to catch up
+        self.master.wait(1, 0)
+
+        # number of GRAPH.EFFECT and GRAPH.QUERY commands applied by replica
+        stats = self.replica.info("commandstats")
+        effects = stats.get("cmdstat_graph.effect", {"calls": 0})["calls"]
+        queries = stats.get("cmdstat_graph.query", {"calls": 0})["calls"]
+        return effects, queries
+
+    def test04_grouped_effects(self):
+        # replicate every modification via effects
+        self.master.execute_command("GRAPH.CONFIG", "SET", "EFFECTS_THRESHOLD", 0)
+        self.replica.execute_command("CONFIG", "RESETSTAT")
+
+        queries = [f"CREATE (:G {{v: {i}}})" for i in range(CLIENT_COUNT)]
+        results = run_concurrent(queries)
+        self.env.assertEquals(results, [1] * CLIENT_COUNT)
+
+        # grouped members share a single GRAPH.EFFECT
+        effects, queries = self.replicated_commands()
+        self.env.assertEquals(queries, 0)
+        self.env.assertGreater(effects, 0)
+        self.env.assertLess(effects, CLIENT_COUNT)
+
+        q = "MATCH (n:G) RETURN n.v ORDER BY n.v"
+        master_resultset = self.master_graph.query(q).result_set
+        replica_resultset = self.replica_graph.query(q, read_only=True).result_set
+        self.env.assertEquals(master_resultset, replica_resultset)
+
+    def test05_grouped_verbatim_replication(self):
+        # cheap modifications are replicated via the original query
+        # grouped members honor the effects threshold
+        self.master.execute_command("GRAPH.CONFIG", "SET", "EFFECTS_THRESHOLD", 999999)
+        self.replica.execute_command("CONFIG", "RESETSTAT")
+
+        queries = [f"CREATE (:V {{v: {i}}})" for i in range(CLIENT_COUNT)]
+        results = run_concurrent(queries)
+        self.env.assertEquals(results, [1] * CLIENT_COUNT)
+
+        effects, queries = self.replicated_commands()
+        self.env.assertEquals(effects, 0)
+        self.env.assertEquals(queries, CLIENT_COUNT)
+
+        q = "MATCH (n:V) RETURN n.v ORDER BY n.v"
+        master_resultset = self.master_graph.query(q).result_set
+        replica_resultset = self.replica_graph.query(q, read_only=True).result_set
+        self.env.assertEquals(master_resultset, replica_resultset)
+
+        # restore defaults
+        self.master.execute_command("GRAPH.CONFIG", "SET", "EFFECTS_THRESHOLD", 300)
+        self.master.execute_command("GRAPH.CONFIG", "SET", "GROUP_COMMIT_SIZE", 1)
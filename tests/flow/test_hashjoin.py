@@ -1,4 +1,5 @@
 from common import *
+from index_utils import *
 
 GRAPH_ID = "G"
 
@@ -35,3 +36,40 @@ class testHashJoin(FlowTestsBase):
 
         self.env.assertEquals(actual_result.result_set, expected_result)
 
+
+    def test_join_key_filter(self):
+        # the keys cached by a join are used to discard records
+        # on the join's probe side as soon as their key is resolved
+        con = self.env.getConnection()
+        graph = Graph(con, "join_key_filter")
+        graph.query("UNWIND range(0, 99) AS x CREATE (:L {v: x})")
+        graph.query("UNWIND [10, 20, 30] AS x CREATE (:S {v: x})")
+
+        q = "MATCH (s:S), (l:L) WHERE s.v = l.v RETURN s.v, l.v ORDER BY s.v"
+        expected_result = [[10, 10], [20, 20], [30, 30]]
+        actual_result = graph.query(q)
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        profile = con.execute_command("GRAPH.PROFILE", "join_key_filter", q)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        self.env.assertIn("Node By Label Scan | (l:L) | Records produced: 100", profile)
+        self.env.assertIn("Filter | Records produced: 3", profile)
+
+        # the range of cached keys is pushed into the probe side index query
+        create_node_exact_match_index(graph, "L", "v", sync=True)
+        q = """MATCH (s:S), (l:L)
+               WHERE s.v = l.v AND l.v >= 0
+               RETURN s.v, l.v ORDER BY s.v"""
+        actual_result = graph.query(q)
+        self.env.assertEquals(actual_result.result_set, expected_result)
+
+        profile = con.execute_command("GRAPH.PROFILE", "join_key_filter", q)
+        profile = [x[0:x.index(',')].strip() for x in profile]
+        self.env.assertIn("Node By Index Scan | (l:L) | Records produced: 21", profile)
+        self.env.assertIn("Filter | Records produced: 3", profile)
+
+        # keys of mixed types, cached keys range is unknown
+        graph.query("CREATE (:S {v: '10'}), (:L {v: '10'}), (:L {v: true})")
+        q = "MATCH (s:S), (l:L) WHERE s.v = l.v RETURN s.v, l.v ORDER BY l.v"
+        actual_result = graph.query(q)
+        self.env.assertEquals(len(actual_result.result_set), 4)
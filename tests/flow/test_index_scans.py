@@ -710,3 +710,108 @@ class testIndexScanFlow():
 
         # expecting an no index scan operation
         self.env.assertNotIn('Node By Index Scan', plan)
+
+    def test_24_bbox_index_scan(self):
+        g = Graph(self.env.getConnection(), 'bbox_index_scan')
+        create_node_exact_match_index(g, 'P', 'loc', sync=True)
+
+        # points on a grid, some of them across the antimeridian
+        g.query("""UNWIND range(-20, 20) AS lat
+                   UNWIND [-179.5, -170, -10, 0, 10, 170, 179.5] AS lon
+                   CREATE (:P {lat: lat, lon: lon,
+                   loc: point({latitude: lat, longitude: lon})})""")
+
+        boxes = [((-5, -15), (5, 15)),     # around the origin
+                 ((-10, 175), (10, -175)), # crosses the antimeridian
+                 ((18, -180), (20, 180))]  # narrow band
+
+        for (ll, ur) in boxes:
+            q = f"""MATCH (p:P)
+                    WHERE point.withinBBox(p.loc,
+                    point({{latitude: {ll[0]}, longitude: {ll[1]}}}),
+                    point({{latitude: {ur[0]}, longitude: {ur[1]}}}))
+                    RETURN p.lat, p.lon ORDER BY p.lat, p.lon"""
+
+            # make sure index is used
+            plan = g.execution_plan(q)
+            self.env.assertIn("Node By Index Scan", plan)
+            actual = g.query(q).result_set
+
+            # compare against a label scan
+            expected = g.query(q.replace("MATCH (p:P)", "MATCH (p)")).result_set
+            self.env.assertEquals(actual, expected)
+            self.env.assertGreater(len(actual), 0)
+
+        # index results are a superset of the box
+        q = """MATCH (p:P)
+               WHERE point.withinBBox(p.loc,
+               point({latitude: -10, longitude: 175}),
+               point({latitude: 10, longitude: -175}))
+               RETURN count(p)"""
+        self.env.assertEquals(g.query(q).result_set[0][0], 21 * 2)
+
+    def test_25_knn_index_scan(self):
+        g = Graph(self.env.getConnection(), 'knn_index_scan')
+        create_node_exact_match_index(g, 'P', 'loc', sync=True)
+
+        g.query("""UNWIND range(0, 199) AS i
+                   CREATE (:P {v: i,
+                   loc: point({latitude: (i % 20) * 4 - 40, longitude: (i / 20) * 30 - 150})})""")
+
+        # nodes without a location are ordered last
+        g.query("UNWIND range(200, 204) AS i CREATE (:P {v: i})")
+
+        origin = "point({latitude: 3.5, longitude: -100})"
+        for (skip, limit) in [(0, 1), (0, 10), (5, 20), (0, 200), (190, 20)]:
+            q = f"""MATCH (p:P)
+                    RETURN p.v, distance(p.loc, {origin}) AS d
+                    ORDER BY d SKIP {skip} LIMIT {limit}"""
+
+            # make sure index is used
+            plan = g.execution_plan(q)
+            self.env.assertIn("Node By Index Scan", plan)
+            actual = g.query(q).result_set
+
+            # compare distances against a label scan
+            expected = g.query(q.replace("MATCH (p:P)", "MATCH (p)")).result_set
+            self.env.assertEquals([row[1] for row in actual],
+                                  [row[1] for row in expected])
+
+        # index is not used for descending order or without limit
+        q = f"MATCH (p:P) RETURN p ORDER BY distance({origin}, p.loc) DESC LIMIT 3"
+        self.env.assertNotIn("Node By Index Scan", g.execution_plan(q))
+        q = f"MATCH (p:P) RETURN p ORDER BY distance({origin}, p.loc)"
+        self.env.assertNotIn("Node By Index Scan", g.execution_plan(q))
+
+    def test_26_wide_bbox_index_scan(self):
+        g = Graph(self.env.getConnection(), 'wide_bbox_index_scan')
+        create_node_exact_match_index(g, 'P', 'loc', sync=True)
+
+        # points on a grid spanning high latitudes
+        g.query("""UNWIND range(-60, 85, 5) AS lat
+                   UNWIND [-179, -170, -165, -150, -90, 0, 90, 150, 165, 170, 179] AS lon
+                   CREATE (:P {lat: lat, lon: lon,
+                   loc: point({latitude: lat, longitude: lon})})""")
+
+        # wide boxes, the farthest boundary point from the box center
+        # isn't necessarily a corner or an edge midpoint
+        boxes = [((-50, -170), (80, 170)),  # farthest point along its edges
+                 ((-50, 10), (80, -10)),    # crosses the antimeridian
+                 ((60, -175), (85, 175))]   # high latitude band
+
+        for (ll, ur) in boxes:
+            q = f"""MATCH (p:P)
+                    WHERE point.withinBBox(p.loc,
+                    point({{latitude: {ll[0]}, longitude: {ll[1]}}}),
+                    point({{latitude: {ur[0]}, longitude: {ur[1]}}}))
+                    RETURN p.lat, p.lon ORDER BY p.lat, p.lon"""
+
+            # make sure index is used
+            plan = g.execution_plan(q)
+            self.env.assertIn("Node By Index Scan", plan)
+            actual = g.query(q).result_set
+
+            # compare against a label scan
+            expected = g.query(q.replace("MATCH (p:P)", "MATCH (p)")).result_set
+            self.env.assertEquals(actual, expected)
+            self.env.assertGreater(len(actual), 0)
@@ -542,3 +542,110 @@ class testOptimizationsPlan(FlowTestsBase):
         # labels with label `M`
         self.env.assertIn("Node By Label Scan | (n:N)", plan)
         self.env.assertIn("Conditional Traverse | (n:M)->(n:M)", plan)
+
+    def test32_repeated_subexpressions(self):
+        """Tests that subexpressions repeated across filters, projections and
+        sort are computed correctly once hoisted, and that parameter only
+        expressions are folded"""
+
+        # clean db
+        self.env.flush()
+        graph = Graph(self.env.getConnection(), GRAPH_ID)
+
+        graph.query("UNWIND range(1, 5) AS x CREATE (:P {price: x * 10, discount: x / 10.0})")
+
+        # subexpression shared by filter, projection and order by
+        query = """MATCH (n:P)
+                   WHERE n.price * (1 - n.discount) > 15
+                   RETURN n.price * (1 - n.discount) AS a,
+                          n.price * (1 - n.discount) + 1 AS b
+                   ORDER BY n.price * (1 - n.discount) DESC"""
+        res = graph.query(query).result_set
+        expected = [[25.0, 26.0], [24.0, 25.0], [21.0, 22.0], [16.0, 17.0]]
+        self.env.assertEquals(res, expected)
+
+        # subexpression repeated within a single filter
+        query = """UNWIND range(1, 10) AS x
+                   WITH x WHERE x * x > 10 AND x * x < 50
+                   RETURN x"""
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [[4], [5], [6], [7]])
+
+        # null values are computed once as well
+        query = "UNWIND [1, null] AS x RETURN x + 1 AS a, (x + 1) * 2 AS b, (x + 1) * 2 AS c"
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [[2, 4, 4], [None, None, None]])
+
+        # parameter only expressions
+        query = """MATCH (n:P)
+                   WHERE n.price > $min * 2
+                   RETURN n.price * (1 - $rate) AS a, n.price * (1 - $rate) AS b
+                   ORDER BY n.price"""
+        res = graph.query(query, {'min': 15, 'rate': 0.5}).result_set
+        self.env.assertEquals(res, [[20.0, 20.0], [25.0, 25.0]])
+
+        # a failing parameter only expression which is never evaluated
+        query = "UNWIND [] AS x RETURN x + $s * 2"
+        res = graph.query(query, {'s': 'a'}).result_set
+        self.env.assertEquals(res, [])
+
+        # errors are reported once evaluated
+        try:
+            graph.query("UNWIND [1] AS x RETURN x + $s * 2", {'s': 'a'})
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Type mismatch", str(e))
+
+    def test33_prefetched_attributes(self):
+        """Tests that attributes accessed by filters, projections and sort
+        are resolved correctly once prefetched by scans and traversals"""
+
+        # clean db
+        self.env.flush()
+        graph = Graph(self.env.getConnection(), GRAPH_ID)
+
+        graph.query("""UNWIND range(1, 4) AS x
+                       CREATE (:P {v: x, name: 'p' + toString(x)})-[:R {w: x * 2}]->(:Q {v: x * 10})""")
+        # node missing attribute 'v'
+        graph.query("CREATE (:P {name: 'none'})")
+
+        # same attributes accessed by filter, projection and sort
+        query = """MATCH (n:P)
+                   WHERE n.v > 1 AND n.name <> 'p4'
+                   RETURN n.v AS v, n.name AS name, n.v * 2 AS double
+                   ORDER BY n.v DESC"""
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [[3, 'p3', 6], [2, 'p2', 4]])
+
+        # missing attributes evaluate to null
+        query = "MATCH (n) WHERE n.name = 'none' RETURN n.v AS v, n.v IS NULL AS missing"
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [[None, True]])
+
+        # attributes of traversed entities and of the traversal's source
+        query = """MATCH (a:P)-[e:R]->(b:Q)
+                   WHERE b.v > a.v * 5 AND e.w > 2
+                   RETURN a.v AS a, e.w AS w, b.v AS b
+                   ORDER BY b.v"""
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [[2, 4, 20], [3, 6, 30], [4, 8, 40]])
+
+        # entities missing from optional matches
+        query = """MATCH (n:P)
+                   OPTIONAL MATCH (n)-[:R]->(m:Q)
+                   WITH n, m
+                   WHERE m.v IS NULL OR m.v > 30
+                   RETURN n.name AS name, m.v AS v
+                   ORDER BY n.name"""
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [['none', None], ['p4', 40]])
+
+        # attributes updated between accesses
+        query = """MATCH (n:P)
+                   WHERE n.v = 1
+                   SET n.v = n.v + 100
+                   WITH n
+                   WHERE n.v > 100
+                   RETURN n.v AS v"""
+        res = graph.query(query).result_set
+        self.env.assertEquals(res, [[101]])
@@ -104,3 +104,157 @@ class testPagerankFlow(FlowTestsBase):
             self.env.assertAlmostEqual(resultset[0][1], 0.777813196182251, 0.0001)
             self.env.assertEqual(resultset[1][0], 1)
             self.env.assertAlmostEqual(resultset[1][1], 0.22218681871891, 0.0001)
+
+    def test_pagerank_multiple_labels_and_relations(self):
+        self.env.cmd('flushall')
+        q = """CREATE (a:A {v:0})-[:R0]->(b:B {v:1})-[:R1]->(c:A {v:2}),
+                      (c)-[:R2]->(:C {v:3})"""
+        redis_graph.query(q)
+
+        # union of A and B nodes connected by either R0 or R1
+        q = """CALL algo.pageRank(['A', 'B'], ['R0', 'R1'])
+               YIELD node, score RETURN node.v, score"""
+        resultset = redis_graph.query(q).result_set
+
+        # same as ranking a single label/relation over the 3 nodes chain
+        self.env.assertEqual(len(resultset), 3)
+        self.env.assertEqual(resultset[0][0], 2)
+        self.env.assertAlmostEqual(resultset[0][1], 0.609753012657166, 0.0001)
+        self.env.assertEqual(resultset[1][0], 1)
+        self.env.assertAlmostEqual(resultset[1][1], 0.286585807800293 , 0.0001)
+        self.env.assertEqual(resultset[2][0], 0)
+        self.env.assertAlmostEqual(resultset[2][1], 0.103661172091961, 0.0001)
+
+        # unknown labels/relations are ignored
+        q = """CALL algo.pageRank(['A', 'B', 'Z'], ['R0', 'R1', 'Z'])
+               YIELD node, score RETURN node.v, score"""
+        self.env.assertEqual(redis_graph.query(q).result_set, resultset)
+
+        q = """CALL algo.pageRank(['Z'], NULL) YIELD node RETURN node"""
+        self.env.assertEqual(len(redis_graph.query(q).result_set), 0)
+
+    def test_pagerank_config(self):
+        self.env.cmd('flushall')
+        q = "CREATE (a:L {v:0})-[:R]->(b:L {v:1})-[:R]->(c:L {v:2})"
+        redis_graph.query(q)
+
+        q = """CALL algo.pageRank('L', 'R', {maxIterations: 1})
+               YIELD node, iterations, delta RETURN iterations, delta"""
+        resultset = redis_graph.query(q).result_set
+        self.env.assertEqual(len(resultset), 3)
+        for row in resultset:
+            self.env.assertEqual(row[0], 1)
+            self.env.assertGreater(row[1], 0)
+
+        q = """CALL algo.pageRank('L', 'R', {tolerance: 0.001})
+               YIELD iterations, delta RETURN max(iterations), max(delta)"""
+        iterations, delta = redis_graph.query(q).result_set[0]
+        self.env.assertGreater(iterations, 1)
+        self.env.assertLessEqual(delta, 0.001)
+
+        # lower damping factor flattens the ranking
+        q = """CALL algo.pageRank('L', 'R', {dampingFactor: 0.5})
+               YIELD node, score RETURN max(score) - min(score)"""
+        low = redis_graph.query(q).result_set[0][0]
+        q = """CALL algo.pageRank('L', 'R', {dampingFactor: 0.85})
+               YIELD node, score RETURN max(score) - min(score)"""
+        high = redis_graph.query(q).result_set[0][0]
+        self.env.assertLess(low, high)
+
+        invalid = ["{maxIterations: 0}", "{maxIterations: 'a'}",
+                   "{tolerance: -1}", "{dampingFactor: 1}",
+                   "{sourceNodes: []}", "{seedProperty: 1}", "'config'"]
+        for config in invalid:
+            try:
+                redis_graph.query(f"CALL algo.pageRank('L', 'R', {config})")
+                self.env.assertTrue(False)
+            except redis.exceptions.ResponseError:
+                pass
+
+    def test_pagerank_personalized(self):
+        self.env.cmd('flushall')
+        q = """CREATE (a:L {v:0})-[:R]->(b:L {v:1})-[:R]->(c:L {v:2}),
+                      (c)-[:R]->(a), (d:L {v:3})-[:R]->(c)"""
+        redis_graph.query(q)
+
+        q = """CALL algo.pageRank('L', 'R') YIELD node, score
+               WHERE node.v = 3 RETURN score"""
+        base = redis_graph.query(q).result_set[0][0]
+
+        q = """MATCH (seed:L {v:3})
+               CALL algo.pageRank('L', 'R', {sourceNodes: [seed]})
+               YIELD node, score WITH node, score WHERE node.v = 3
+               RETURN score"""
+        personalized = redis_graph.query(q).result_set[0][0]
+        self.env.assertGreater(personalized, base)
+
+        # seed node outside of the ranked graph
+        redis_graph.query("CREATE (:X)")
+        try:
+            q = """MATCH (seed:X)
+                   CALL algo.pageRank('L', 'R', {sourceNodes: [seed]})
+                   YIELD node RETURN node"""
+            redis_graph.query(q)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("sourceNodes", str(e))
+
+    def test_pagerank_warm_start(self):
+        self.env.cmd('flushall')
+        q = """UNWIND range(0, 49) AS i
+               CREATE (:L {v:i})-[:R]->(:L {v:i + 50})"""
+        redis_graph.query(q)
+        q = """MATCH (a:L), (b:L) WHERE b.v = (a.v * 7) % 100
+               CREATE (a)-[:R]->(b)"""
+        redis_graph.query(q)
+
+        q = """CALL algo.pageRank.write('L', 'R', {writeProperty: 'rank'})
+               YIELD iterations RETURN iterations"""
+        cold = redis_graph.query(q).result_set[0][0]
+
+        q = """CALL algo.pageRank('L', 'R', {seedProperty: 'rank'})
+               YIELD iterations RETURN max(iterations)"""
+        warm = redis_graph.query(q).result_set[0][0]
+        self.env.assertLess(warm, cold)
+
+        # missing seed property falls back to a uniform start
+        q = """CALL algo.pageRank('L', 'R', {seedProperty: 'missing'})
+               YIELD iterations RETURN max(iterations)"""
+        self.env.assertEqual(redis_graph.query(q).result_set[0][0], cold)
+
+    def test_pagerank_write(self):
+        self.env.cmd('flushall')
+        q = "CREATE (a:L {v:0})-[:R]->(b:L {v:1}), (:X {v:2})"
+        redis_graph.query(q)
+
+        q = """CALL algo.pageRank.write('L', 'R', {writeProperty: 'rank'})
+               YIELD nodes, iterations RETURN nodes, iterations"""
+        res = redis_graph.query(q)
+        self.env.assertEqual(res.result_set[0][0], 2)
+        self.env.assertGreater(res.result_set[0][1], 0)
+        self.env.assertEqual(res.properties_set, 2)
+
+        q = "MATCH (n) RETURN n.v, n.rank ORDER BY n.v"
+        resultset = redis_graph.query(q).result_set
+        self.env.assertAlmostEqual(resultset[0][1], 0.22218681871891, 0.0001)
+        self.env.assertAlmostEqual(resultset[1][1], 0.777813196182251, 0.0001)
+        self.env.assertIsNone(resultset[2][1])
+
+        # refreshing an up to date ranking doesn't update any node
+        q = """CALL algo.pageRank.write('L', 'R', {writeProperty: 'rank'})
+               YIELD nodes RETURN nodes"""
+        res = redis_graph.query(q)
+        self.env.assertEqual(res.result_set[0][0], 0)
+        self.env.assertEqual(res.properties_set, 0)
+
+        # refreshing after the graph changed updates the existing attribute
+        redis_graph.query("MATCH (b:L {v:1}) CREATE (b)-[:R]->(:L {v:3})")
+        res = redis_graph.query(q)
+        self.env.assertEqual(res.result_set[0][0], 3)
+
+        # writeProperty is required
+        try:
+            redis_graph.query("CALL algo.pageRank.write('L', 'R')")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("writeProperty", str(e))
@@ -145,3 +145,46 @@ class testParams(FlowTestsBase):
         plan = redis_graph.execution_plan(query, params=params)
         self.env.assertIn('NodeByIdSeek', plan)
 
+
+    def test_literal_params(self):
+        # literal parameters are decoded without invoking the cypher parser
+        q = """CYPHER i=-3 f=2.5e1 s='a\\'b\\n' d="x\\"y" b=TRUE n=null
+               l=[1, [2, 'c'], {k: false}] m={a: 1, b: [null, 'z']}
+               RETURN $i, $f, $s, $d, $b, $n, $l, $m"""
+        actual = redis_graph.query(q).result_set
+        expected = [[-3, 25.0, "a'b\n", 'x"y', True, None,
+                     [1, [2, 'c'], {'k': False}], {'a': 1, 'b': [None, 'z']}]]
+        self.env.assertEquals(actual, expected)
+
+        # multiple CYPHER prefixes
+        q = "CYPHER a=1 CYPHER b=2 RETURN $a + $b"
+        actual = redis_graph.query(q).result_set
+        self.env.assertEquals(actual, [[3]])
+
+        # batch ingest through a large list of maps
+        rows = [{'id': i, 'name': 'n' + str(i)} for i in range(10000)]
+        q = "UNWIND $rows AS row CREATE (:L {id: row.id, name: row.name})"
+        result = redis_graph.query(q, {'rows': rows})
+        self.env.assertEquals(result.nodes_created, 10000)
+
+        q = "MATCH (n:L) WHERE n.id = 9999 RETURN n.name"
+        actual = redis_graph.query(q).result_set
+        self.env.assertEquals(actual, [['n9999']])
+
+        # parameters which require the cypher parser
+        queries = [
+            ("CYPHER p=0x1F RETURN $p", [[31]]),
+            ("CYPHER p=1+2 RETURN $p", [[3]]),
+            ("CYPHER p=[1, abs(-2)] RETURN $p", [[[1, 2]]]),
+            ("CYPHER p={a: {b: toUpper('c')}} RETURN $p", [[{'a': {'b': 'C'}}]])
+        ]
+        for q, expected in queries:
+            actual = redis_graph.query(q).result_set
+            self.env.assertEquals(actual, expected)
+
+        # duplicated parameters are reported as an error
+        try:
+            redis_graph.query("CYPHER a=1 a=2 RETURN $a")
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertIn("Duplicated parameter", str(e))
@@ -175,6 +175,15 @@ class testAllShortestPaths():
         except redis.exceptions.ResponseError as e:
             self.env.assertContains("maxLen must be integer", str(e))
 
+        # negative maxLen isn't treated as unbounded
+        query = """MATCH (n:L {v: 1}), (m:L {v: 5}) CALL algo.SPpaths({sourceNode: n, targetNode: m, maxLen: -1, weightProp: 'weight'})"""
+
+        try:
+            self.graph.query(query)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("maxLen must be a non-negative integer", str(e))
+
         query = """MATCH (n:L {v: 1}), (m:L {v: 5}) CALL algo.SPpaths({sourceNode: n, targetNode: m, weightProp: 1})"""
         try:
             self.graph.query(query)
@@ -264,6 +273,15 @@ class testAllShortestPaths():
         except redis.exceptions.ResponseError as e:
             self.env.assertContains("maxLen must be integer", str(e))
 
+        # negative maxLen isn't treated as unbounded
+        query = """MATCH (n:L {v: 1}), (m:L {v: 5}) CALL algo.SSpaths({sourceNode: n, maxLen: -1, weightProp: 'weight'})"""
+
+        try:
+            self.graph.query(query)
+            self.env.assertTrue(False)
+        except redis.exceptions.ResponseError as e:
+            self.env.assertContains("maxLen must be a non-negative integer", str(e))
+
         query = """MATCH (n:L {v: 1}), (m:L {v: 5}) CALL algo.SSpaths({sourceNode: n, weightProp: 1})"""
         try:
             self.graph.query(query)
@@ -444,3 +462,74 @@ class testAllShortestPaths():
             self.env.assertEquals(len(result.result_set), 5)
             for i in range(0, 5):
                 self.env.assertContains(result.result_set[i], self.ss_paths)
+
+    def test08_sp_weighted_grid(self):
+        # a grid has an exponential number of paths between opposite corners
+        # only the shortest ones should be explored
+        grid = Graph(self.env.getConnection(), "weighted_grid")
+        N = 20
+        weights = {}
+        for i in range(N):
+            for j in range(N):
+                if j + 1 < N:
+                    weights[(i, j, i, j + 1)] = (i * 7 + j * 3) % 10 + 1
+                if i + 1 < N:
+                    weights[(i, j, i + 1, j)] = (i * 5 + j * 11) % 10 + 1
+
+        grid.query(f"UNWIND range(0, {N * N - 1}) AS x CREATE (:C {{v: x}})")
+        create_node_exact_match_index(grid, 'C', 'v', sync=True)
+        edges = [{'a': i * N + j, 'b': k * N + l, 'w': w}
+                 for (i, j, k, l), w in weights.items()]
+        grid.query("""UNWIND $edges AS e
+                      MATCH (a:C {v: e.a}), (b:C {v: e.b})
+                      CREATE (a)-[:R {w: e.w}]->(b)""", {'edges': edges})
+
+        # edges only lead right or down, compute shortest distance
+        dist = [[0] * N for _ in range(N)]
+        for i in range(N):
+            for j in range(N):
+                if i == 0 and j == 0:
+                    continue
+                candidates = []
+                if j > 0:
+                    candidates.append(dist[i][j - 1] + weights[(i, j - 1, i, j)])
+                if i > 0:
+                    candidates.append(dist[i - 1][j] + weights[(i - 1, j, i, j)])
+                dist[i][j] = min(candidates)
+
+        query = f"""MATCH (n:C {{v: 0}}), (m:C {{v: {N * N - 1}}})
+                    CALL algo.SPpaths({{sourceNode: n, targetNode: m,
+                                       weightProp: 'w', pathCount: $k}})
+                    YIELD path, pathWeight
+                    RETURN pathWeight, length(path)"""
+
+        res = grid.query(query, {'k': 1}).result_set
+        self.env.assertEquals(len(res), 1)
+        self.env.assertEquals(res[0][0], dist[N - 1][N - 1])
+        self.env.assertEquals(res[0][1], 2 * (N - 1))
+
+        res = grid.query(query, {'k': 3}).result_set
+        self.env.assertEquals(len(res), 3)
+        self.env.assertEquals(res[0][0], dist[N - 1][N - 1])
+        self.env.assertLessEqual(res[0][0], res[1][0])
+        self.env.assertLessEqual(res[1][0], res[2][0])
+
+        res = grid.query(query, {'k': 0}).result_set
+        self.env.assertGreaterEqual(len(res), 1)
+        for row in res:
+            self.env.assertEquals(row[0], dist[N - 1][N - 1])
+
+        grid.delete()
+
+    def test09_negative_weights(self):
+        # negative weights fall back to enumerating all paths
+        g = Graph(self.env.getConnection(), "negative_weights")
+        g.query("""CREATE (:N {v: 1})-[:R {w: 2}]->(:N {v: 2})-[:R {w: -3}]->(:N {v: 3})""")
+
+        query = """MATCH (n:N {v: 1}), (m:N {v: 3})
+                   CALL algo.SPpaths({sourceNode: n, targetNode: m, weightProp: 'w'})
+                   YIELD pathWeight RETURN pathWeight"""
+        res = g.query(query).result_set
+        self.env.assertEquals(res, [[-1.0]])
+
+        g.delete()
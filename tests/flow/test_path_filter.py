@@ -301,3 +301,43 @@ class testPathFilter(FlowTestsBase):
         # The plan should be identical to the one constructed previously.
         self.env.assertEqual(plan_1, plan_2)
 
+
+    def test15_bulk_evaluated_path_filters(self):
+        # enough bound records for path filters to be evaluated once
+        # for all nodes and probed per record
+        # the first edge created has ID 0
+        redis_graph.query("""UNWIND range(0, 199) AS v
+                             CREATE (u:U {v: v})
+                             FOREACH (x IN CASE WHEN v % 3 = 0 THEN [1] ELSE [] END |
+                                 CREATE (u)-[:F]->(:C))
+                             FOREACH (x IN CASE WHEN v % 5 = 0 THEN [1] ELSE [] END |
+                                 CREATE (u)-[:F]->(:D))""")
+
+        multiples_of_3 = len([v for v in range(200) if v % 3 == 0])
+        multiples_of_3_or_5 = len([v for v in range(200) if v % 3 == 0 or v % 5 == 0])
+
+        query = "MATCH (u:U) WHERE (u)-[:F]->(:C) RETURN count(u)"
+        result_set = redis_graph.query(query).result_set
+        self.env.assertEquals(result_set, [[multiples_of_3]])
+
+        query = "MATCH (u:U) WHERE NOT (u)-[:F]->(:C) RETURN count(u)"
+        result_set = redis_graph.query(query).result_set
+        self.env.assertEquals(result_set, [[200 - multiples_of_3]])
+
+        query = "MATCH (u:U) WHERE (u)-[:F]->(:C) OR (u)-[:F]->(:D) RETURN count(u)"
+        result_set = redis_graph.query(query).result_set
+        self.env.assertEquals(result_set, [[multiples_of_3_or_5]])
+
+        # pattern traversed against edge direction
+        query = "MATCH (c:C) WHERE (c)<-[:F]-(:U) RETURN count(c)"
+        result_set = redis_graph.query(query).result_set
+        self.env.assertEquals(result_set, [[multiples_of_3]])
+
+        # records missing the pattern's source node never match
+        query = """MATCH (u:U)
+                   OPTIONAL MATCH (u)-[:F]->(c:C)
+                   WITH u, c
+                   WHERE NOT (c)<-[:F]-(:U)
+                   RETURN count(u)"""
+        result_set = redis_graph.query(query).result_set
+        self.env.assertEquals(result_set, [[200 - multiples_of_3]])
@@ -0,0 +1,195 @@
+import struct
+from common import *
+
+GRAPH_ID = "prepared_statements"
+
+
+# binary encode a single parameter value
+def encode_value(v):
+    if v is None:
+        return struct.pack("<B", 0)
+    if isinstance(v, bool):
+        return struct.pack("<BB", 1, int(v))
+    if isinstance(v, int):
+        return struct.pack("<Bq", 2, v)
+    if isinstance(v, float):
+        return struct.pack("<Bd", 3, v)
+    if isinstance(v, str):
+        s = v.encode()
+        return struct.pack("<BI", 4, len(s)) + s
+    if isinstance(v, list):
+        return struct.pack("<BI", 5, len(v)) + b"".join(encode_value(e) for e in v)
+    if isinstance(v, dict):
+        return struct.pack("<BI", 6, len(v)) + \
+            b"".join(encode_name(k) + encode_value(e) for k, e in v.items())
+    raise TypeError(v)
+
+def encode_name(name):
+    s = name.encode()
+    return struct.pack("<I", len(s)) + s
+
+# binary encode query parameters
+def encode_params(params):
+    if len(params) == 0:
+        return b""
+    return struct.pack("<I", len(params)) + \
+        b"".join(encode_name(k) + encode_value(v) for k, v in params.items())
+
+class testPreparedStatements():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, env='oss', useSlaves=True)
+        self.master        = self.env.getConnection()
+        self.replica       = self.env.getSlaveConnection()
+        self.master_graph  = Graph(self.master, GRAPH_ID)
+        self.replica_graph = Graph(self.replica, GRAPH_ID)
+
+        self.master_graph.query("UNWIND range(0, 9) AS x CREATE (:N {v: x})")
+
+    def prepare(self, q):
+        return self.master.execute_command("GRAPH.PREPARE", GRAPH_ID, q)
+
+    def execute(self, handle, params={}):
+        return self.master.execute_command("GRAPH.EXECUTE", GRAPH_ID, handle,
+                                           encode_params(params))
+
+    def test01_prepare_execute(self):
+        handle = self.prepare("MATCH (n:N) WHERE n.v = $v RETURN n.v")
+        self.env.assertGreater(handle, 0)
+
+        for v in [2, 7]:
+            res = self.execute(handle, {'v': v})
+            self.env.assertEquals(res[1], [[v]])
+
+        # missing parameter
+        try:
+            self.execute(handle)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Missing parameters", str(e))
+
+        # statements are distinguishable
+        other = self.prepare("MATCH (n:N) RETURN count(n)")
+        self.env.assertNotEqual(handle, other)
+        self.env.assertEquals(self.execute(other)[1], [[10]])
+
+    def test02_parameter_types(self):
+        handle = self.prepare("""RETURN $i + 1, toInteger($f * 2), $s + '!',
+                              size($l), $m.k, coalesce($n, 'null'),
+                              CASE WHEN $b THEN 1 ELSE 0 END""")
+
+        params = {'i': -5, 'f': 2.5, 's': 'abc', 'l': [1, 'a', [None]],
+                  'm': {'k': 'v'}, 'n': None, 'b': True}
+        res = self.execute(handle, params)
+        self.env.assertEquals(res[1], [[-4, 5, 'abc!', 3, 'v', 'null', 1]])
+
+    def test03_invalid_usage(self):
+        handle = self.prepare("RETURN $a")
+
+        # malformed parameters
+        invalid_params = [
+            b"\x01",                                     # truncated count
+            b"\x01\x00\x00\x00\x01\x00\x00\x00a\x09",    # unknown type
+            b"\x01\x00\x00\x00\x01\x00\x00\x00a\x02\x01",  # truncated integer
+            encode_params({'a': 1}) + b"\x00",           # trailing bytes
+        ]
+        for params in invalid_params:
+            try:
+                self.master.execute_command("GRAPH.EXECUTE", GRAPH_ID, handle, params)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("Invalid binary encoded parameters", str(e))
+
+        # invalid handles
+        for h in ["abc", "0", "-1"]:
+            try:
+                self.master.execute_command("GRAPH.EXECUTE", GRAPH_ID, h, b"")
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("Invalid prepared statement handle", str(e))
+
+        try:
+            self.execute(handle + 1000)
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Unknown prepared statement", str(e))
+
+        # statements which can't be prepared
+        queries = [
+            ("CYPHER a=1 RETURN $a", "parameters are provided upon execution"),
+            ("CREATE INDEX FOR (n:N) ON (n.v)", "Only queries can be prepared"),
+            ("CALL db.idx.fulltext.createNodeIndex('N', 'v')", "modifies the graph"),
+            ("MATCH (n) RETURN m", "'m' not defined"),
+        ]
+        for q, err in queries:
+            try:
+                self.prepare(q)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn(err, str(e))
+
+        # statements are bound to an existing graph
+        try:
+            self.master.execute_command("GRAPH.PREPARE", "missing", "RETURN 1")
+            self.env.assertTrue(False)
+        except ResponseError:
+            pass
+
+    def test04_deallocate(self):
+        handle = self.prepare("RETURN 1")
+        self.env.assertEquals(self.execute(handle)[1], [[1]])
+
+        res = self.master.execute_command("GRAPH.DEALLOCATE", GRAPH_ID, handle)
+        self.env.assertEquals(res, "OK")
+
+        for cmd in ["GRAPH.EXECUTE", "GRAPH.DEALLOCATE"]:
+            try:
+                args = [b""] if cmd == "GRAPH.EXECUTE" else []
+                self.master.execute_command(cmd, GRAPH_ID, handle, *args)
+                self.env.assertTrue(False)
+            except ResponseError as e:
+                self.env.assertIn("Unknown prepared statement", str(e))
+
+    def test05_schema_change(self):
+        # statement is rebuilt once the graph's schema changes
+        handle = self.prepare("MATCH (n:M) RETURN n.w ORDER BY n.w")
+        self.env.assertEquals(self.execute(handle)[1], [])
+
+        # introduce both a new label and a new attribute
+        self.master_graph.query("CREATE (:M {w: 1}), (:M {w: 2})")
+        self.env.assertEquals(self.execute(handle)[1], [[1], [2]])
+
+    def test06_replication(self):
+        # modifications made by prepared statements are replicated as effects
+        handle = self.prepare("UNWIND $vs AS v CREATE (:R {v: v}) RETURN count(v)")
+        self.execute(handle, {'vs': [1, 2, 3]})
+        self.execute(handle, {'vs': [4]})
+
+        # wait for replica to catch up
+        self.master.wait(1, 0)
+
+        q = "MATCH (n:R) RETURN n.v ORDER BY n.v"
+        master_resultset = self.master_graph.query(q).result_set
+        replica_resultset = self.replica_graph.query(q, read_only=True).result_set
+        self.env.assertEquals(master_resultset, [[1], [2], [3], [4]])
+        self.env.assertEquals(master_resultset, replica_resultset)
+
+    def test07_flags(self):
+        # flags follow the parameters
+        handle = self.prepare("MATCH (n:N) WHERE n.v < $v RETURN n.v ORDER BY n.v")
+        res = self.master.execute_command("GRAPH.EXECUTE", GRAPH_ID, handle,
+                                          encode_params({'v': 2}), "--compact",
+                                          "timeout", 1000)
+        # n.v < 2 matches two nodes
+        self.env.assertEquals(len(res[1]), 2)
+
+    def test08_prepare_on_replica(self):
+        # PREPARE and DEALLOCATE are read-only, they're accepted by replicas
+        self.master.wait(1, 0)
+
+        handle = self.replica.execute_command("GRAPH.PREPARE", GRAPH_ID,
+                                              "MATCH (n:N) RETURN count(n)")
+        self.env.assertGreater(handle, 0)
+
+        res = self.replica.execute_command("GRAPH.DEALLOCATE", GRAPH_ID, handle)
+        self.env.assertEquals(res, "OK")
+
@@ -362,13 +362,26 @@ class testProcedures(FlowTestsBase):
         actual_resultset = redis_graph.query("CALL dbms.procedures() YIELD mode, name RETURN mode, name ORDER BY name").result_set
 
         expected_result = [["READ", "algo.BFS"],
+                           ["READ", "algo.MSBFS"],
+                           ["WRITE", "algo.MSBFS.write"],
                            ['READ', 'algo.SPpaths'],
                            ['READ', 'algo.SSpaths'],
+                           ["READ", "algo.labelPropagation"],
                            ["READ", "algo.pageRank"],
+                           ["WRITE", "algo.pageRank.write"],
+                           ["READ", "algo.triangleCount"],
+                           ["READ", "algo.wcc"],
+                           ["WRITE", "algo.wcc.write"],
                            ['READ', 'db.constraints'],
                            ["WRITE", "db.idx.fulltext.createNodeIndex"],
+                           ["WRITE", "db.idx.fulltext.createRelationshipIndex"],
                            ["WRITE", "db.idx.fulltext.drop"],
+                           ["WRITE", "db.idx.fulltext.dropRelationshipIndex"],
                            ["READ", "db.idx.fulltext.queryNodes"],
+                           ["READ", "db.idx.fulltext.queryRelationships"],
+                           ["WRITE", "db.idx.vector.createNodeIndex"],
+                           ["WRITE", "db.idx.vector.drop"],
+                           ["READ", "db.idx.vector.queryNodes"],
                            ["READ", "db.indexes"],
                            ["READ", "db.labels"],
                            ["READ", "db.propertyKeys"],
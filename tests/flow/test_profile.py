@@ -39,3 +39,50 @@ class testProfile(FlowTestsBase):
         self.env.assertIn("Update | Records produced: 0", profile)
         self.env.assertIn("Conditional Variable Length Traverse | (a)-[@anon_1*1..INF]->(@anon_0) | Records produced: 0", profile)
         self.env.assertIn("Node By Label Scan | (a:L) | Records produced: 0", profile)
+
+    def test03_profile_filter_conjuncts(self):
+        # validate that profile reports the pass rate of each filter conjunct
+        q = "MATCH (p:Person) WHERE p.v > 1 AND p.v < 3 RETURN p.v"
+        profile = redis_con.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        filter = [x for x in profile if x.startswith("Filter")][0]
+        # conjuncts are listed in evaluation order
+        self.env.assertIn("p.v > 1 (passed ", filter)
+        self.env.assertIn("p.v < 3 (passed ", filter)
+        self.env.assertIn("(passed 2/3)", filter)
+        self.env.assertIn("(passed 1/2)", filter)
+        self.env.assertIn("Records produced: 1", filter)
+
+        # conjuncts are reordered once enough records are evaluated
+        # make sure results are unaffected
+        redis_graph.query("UNWIND range(1, 5000) AS x CREATE (:N {v: x, s: toString(x)})")
+        q = """MATCH (n:N)
+               WHERE n.s CONTAINS '7' AND n.v % 10 = 0 AND n.v > 4000
+               RETURN count(n)"""
+        res = redis_graph.query(q).result_set
+        expected = len([x for x in range(4001, 5001) if '7' in str(x) and x % 10 == 0])
+        self.env.assertEquals(res[0][0], expected)
+
+        profile = redis_con.execute_command("GRAPH.PROFILE", GRAPH_ID, q)
+        filter = [x for x in profile if x.startswith("Filter")][0]
+        self.env.assertIn("Records produced: %d" % expected, filter)
+
+    def test04_filter_guarded_conjuncts(self):
+        # conjuncts which might raise an error are never evaluated
+        # ahead of the conjuncts guarding them
+        redis_graph.query("""UNWIND range(0, 4999) AS v
+                             CREATE (:G {x: v % 500,
+                                         kind: CASE WHEN v % 500 = 0 THEN 'int' ELSE 'str' END,
+                                         s: CASE WHEN v % 500 = 0 THEN v ELSE toString(v) END})""")
+
+        # the guard rarely fails while the division discards most records
+        q = "MATCH (n:G) WHERE n.x <> 0 AND 10 / n.x > 2 RETURN count(n)"
+        res = redis_graph.query(q).result_set
+        expected = len([v for v in range(5000) if v % 500 in range(1, 5)])
+        self.env.assertEquals(res[0][0], expected)
+
+        # STARTS WITH raises a type mismatch on integers
+        q = "MATCH (n:G) WHERE n.kind = 'str' AND n.s STARTS WITH '1' RETURN count(n)"
+        res = redis_graph.query(q).result_set
+        expected = len([v for v in range(5000)
+                        if v % 500 != 0 and str(v).startswith('1')])
+        self.env.assertEquals(res[0][0], expected)
@@ -134,3 +134,22 @@ class testQueryMemoryLimit():
 
         self.stress_server(queries)
 
+
+    def test_06_rollback_root_create(self):
+        # a root CREATE exceeding its memory cap must roll back its creations
+        g = Graph(self.conn, GRAPH_NAME)
+
+        # set query memory limit to 1MB
+        limit = 1024*1024
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_CAPACITY", limit)
+
+        try:
+            g.query("UNWIND range(0, 100000) AS x CREATE (:M {v: x, s: 'value'})")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Query's mem consumption exceeded capacity", str(e))
+
+        # lift memory limit and make sure no node was left behind
+        self.conn.execute_command("GRAPH.CONFIG", "SET", "QUERY_MEM_CAPACITY", 0)
+        res = g.query("MATCH (n:M) RETURN count(n)")
+        self.env.assertEquals(res.result_set[0][0], 0)
@@ -189,3 +189,41 @@ class testResultSetFlow(FlowTestsBase):
         query = """RETURN 'Foo\r\nBar'"""
         result = graph.query(query)
         self.env.assertEqual(result.result_set[0][0], 'Foo\r\nBar')
+
+    def test11_streaming_resultset(self):
+        queries = ["MATCH (a) RETURN a.name, a.val ORDER BY a.val",
+                   "MATCH (a)-[e]->(b) RETURN a, e, b ORDER BY a.val, b.val",
+                   "MATCH (a) WHERE a.val > 100 RETURN a",
+                   "UNWIND range(0, 10000) AS x RETURN x, toString(x)"]
+
+        expected = [graph.query(q).result_set for q in queries]
+
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_STREAMING", "yes")
+        res = redis_con.execute_command("GRAPH.CONFIG", "GET", "RESULTSET_STREAMING")
+        self.env.assertEquals(res, ["RESULTSET_STREAMING", 1])
+
+        # streamed replies are identical to buffered replies
+        for q, e in zip(queries, expected):
+            self.env.assertEquals(graph.query(q).result_set, e)
+            self.env.assertEquals(graph.query(q, read_only=True).result_set, e)
+
+        # result-set size limit is enforced
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_SIZE", 2)
+        result = graph.query("MATCH (a) RETURN a")
+        self.env.assertEquals(len(result.result_set), 2)
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_SIZE", -1)
+
+        # run-time error after rows were streamed replaces the statistics
+        try:
+            graph.query("UNWIND [1, 2, 0] AS x RETURN 1 / x")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertIn("Division by zero", str(e))
+
+        # write queries are not streamed
+        result = graph.query("CREATE (a:streamed {v: 1}) RETURN a.v")
+        self.env.assertEquals(result.result_set, [[1]])
+        self.env.assertEquals(result.nodes_created, 1)
+        graph.query("MATCH (a:streamed) DELETE a")
+
+        redis_con.execute_command("GRAPH.CONFIG", "SET", "RESULTSET_STREAMING", "no")
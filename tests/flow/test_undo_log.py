@@ -493,3 +493,45 @@ class testUndoLog():
         result = self.graph.query("MATCH (n:L4) RETURN labels(n)")
         self.env.assertEquals(len(result.result_set), 1)
         self.env.assertEquals(["L4"], result.result_set[0][0])
+
+    def test20_undo_partial_attribute_updates(self):
+        # only modified attributes are undo-logged
+        # make sure untouched, updated, added and removed attributes
+        # are all restored
+        create_node_exact_match_index(self.graph, 'N', 'v', 'w', sync=True)
+        self.graph.query("CREATE (:N {a: 'keep', v: 1, w: 'x', z: [1, 2]})")
+        try:
+            self.graph.query("""MATCH (n:N)
+                                SET n.v = n.v + 1, n.w = NULL, n.new = 'y'
+                                SET n.v = n.v + 1, n.z = 'str'
+                                WITH n
+                                RETURN 1 * n""")
+            # we're not supposed to be here, expecting query to fail
+            self.env.assertTrue(False)
+        except:
+            pass
+
+        result = self.graph.query("MATCH (n:N) RETURN properties(n)")
+        self.env.assertEquals(result.result_set[0][0],
+                {'a': 'keep', 'v': 1, 'w': 'x', 'z': [1, 2]})
+
+        # index should reflect the original values
+        result = self.graph.query("MATCH (n:N) WHERE n.v = 1 AND n.w = 'x' RETURN count(n)")
+        self.env.assertEquals(result.result_set[0][0], 1)
+        result = self.graph.query("MATCH (n:N) WHERE n.v = 3 RETURN count(n)")
+        self.env.assertEquals(result.result_set[0][0], 0)
+
+    def test21_undo_replace_attribute_set(self):
+        self.graph.query("CREATE (:N {a: 1, b: 'b'})-[:R {c: 2}]->()")
+        try:
+            self.graph.query("""MATCH (n:N)-[r:R]->()
+                                SET n = {x: 1}, r += {c: 3, d: 4}
+                                WITH n
+                                RETURN 1 * n""")
+            # we're not supposed to be here, expecting query to fail
+            self.env.assertTrue(False)
+        except:
+            pass
+
+        result = self.graph.query("MATCH (n:N)-[r:R]->() RETURN properties(n), properties(r)")
+        self.env.assertEquals(result.result_set[0], [{'a': 1, 'b': 'b'}, {'c': 2}])
@@ -0,0 +1,223 @@
+from common import *
+from index_utils import *
+import random
+
+GRAPH_ID = "vector"
+redis_con = None
+redis_graph = None
+
+class testVector():
+    def __init__(self):
+        self.env = Env(decodeResponses=True, enableDebugCommand=True)
+        global redis_con
+        global redis_graph
+        redis_con = self.env.getConnection()
+        redis_graph = Graph(redis_con, GRAPH_ID)
+
+    def setUp(self):
+        self.env.flush()
+
+    def test01_vector_type(self):
+        q = "RETURN toString(vecf32([1, 2.5, -3]))"
+        res = redis_graph.query(q).result_set[0][0]
+        self.env.assertEquals(res, "<1.000000, 2.500000, -3.000000>")
+
+        # vector elements must be numeric
+        try:
+            redis_graph.query("RETURN vecf32([1, 'a'])")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Vector elements must be numeric", str(e))
+
+        # vectors can be stored as properties
+        redis_graph.query("CREATE (:A {v: vecf32([1, 2])})")
+        q = "MATCH (a:A) RETURN typeOf(a.v), toString(a.v)"
+        res = redis_graph.query(q).result_set[0]
+        self.env.assertEquals(res, ["Vectorf32", "<1.000000, 2.000000>"])
+
+        # vectors survive a reload
+        redis_con.execute_command("DEBUG", "RELOAD")
+        res = redis_graph.query(q).result_set[0]
+        self.env.assertEquals(res, ["Vectorf32", "<1.000000, 2.000000>"])
+
+    def test02_vector_distance(self):
+        q = "RETURN vec.euclidean(vecf32([0, 0]), vecf32([3, 4]))"
+        res = redis_graph.query(q).result_set[0][0]
+        self.env.assertAlmostEqual(res, 5, 0.0001)
+
+        # orthogonal vectors
+        q = "RETURN vec.cosine(vecf32([1, 0]), vecf32([0, 1]))"
+        res = redis_graph.query(q).result_set[0][0]
+        self.env.assertAlmostEqual(res, 1, 0.0001)
+
+        # parallel vectors
+        q = "RETURN vec.cosine(vecf32([1, 2, 3, 4, 5, 6, 7, 8, 9]), vecf32([2, 4, 6, 8, 10, 12, 14, 16, 18]))"
+        res = redis_graph.query(q).result_set[0][0]
+        self.env.assertAlmostEqual(res, 0, 0.0001)
+
+        # null propagates
+        q = "RETURN vec.euclidean(null, vecf32([1]))"
+        res = redis_graph.query(q).result_set[0][0]
+        self.env.assertIsNone(res)
+
+        # dimension mismatch
+        try:
+            redis_graph.query("RETURN vec.euclidean(vecf32([1, 2]), vecf32([1]))")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Vector dimension mismatch", str(e))
+
+    def test03_vector_index(self):
+        create_vector_index(redis_graph, 'P', 'v', 2, sync=True)
+
+        # create points on a grid
+        redis_graph.query("""UNWIND range(0, 9) AS x
+                             UNWIND range(0, 9) AS y
+                             CREATE (:P {x: x, y: y, v: vecf32([x, y])})""")
+
+        q = """CALL db.idx.vector.queryNodes('P', 'v', 3, vecf32([2.1, 7.2]))
+               YIELD node, score
+               RETURN node.x, node.y"""
+        res = redis_graph.query(q).result_set
+        self.env.assertEquals(res, [[2, 7], [2, 8], [3, 7]])
+
+        # results are ordered by distance
+        q = """CALL db.idx.vector.queryNodes('P', 'v', 5, vecf32([5, 5]))
+               YIELD node, score
+               RETURN node.x, node.y, score"""
+        res = redis_graph.query(q).result_set
+        self.env.assertEquals(res[0][:2], [5, 5])
+        self.env.assertAlmostEqual(res[0][2], 0, 0.0001)
+        scores = [r[2] for r in res]
+        self.env.assertEquals(scores, sorted(scores))
+
+        # updates are reflected by the index
+        redis_graph.query("MATCH (p:P {x: 5, y: 5}) SET p.v = vecf32([100, 100])")
+        res = redis_graph.query(q).result_set
+        self.env.assertNotEqual(res[0][:2], [5, 5])
+
+        # removed attribute drops node from index
+        redis_graph.query("MATCH (p:P {x: 5, y: 5}) REMOVE p.v")
+        q = """CALL db.idx.vector.queryNodes('P', 'v', 1, vecf32([100, 100]))
+               YIELD node
+               RETURN node.x, node.y"""
+        res = redis_graph.query(q).result_set
+        self.env.assertEquals(res, [[9, 9]])
+
+        # deleted nodes are removed from index
+        redis_graph.query("MATCH (p:P {x: 9, y: 9}) DELETE p")
+        res = redis_graph.query(q).result_set
+        self.env.assertNotEqual(res, [[9, 9]])
+
+        # k larger than the number of indexed vectors
+        q = """CALL db.idx.vector.queryNodes('P', 'v', 1000, vecf32([0, 0]))
+               YIELD node
+               RETURN count(node)"""
+        res = redis_graph.query(q).result_set[0][0]
+        self.env.assertEquals(res, 98)
+
+        # query dimension must match index dimension
+        try:
+            redis_graph.query("CALL db.idx.vector.queryNodes('P', 'v', 1, vecf32([1, 2, 3]))")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Vector dimension mismatch", str(e))
+
+    def test04_vector_index_cosine(self):
+        create_vector_index(redis_graph, 'D', 'e', 3, {'similarity': 'cosine'})
+
+        redis_graph.query("""CREATE (:D {name: 'x', e: vecf32([1, 0, 0])}),
+                                    (:D {name: 'y', e: vecf32([0, 1, 0])}),
+                                    (:D {name: 'z', e: vecf32([0, 0, 1])}),
+                                    (:D {name: 'xy', e: vecf32([1, 1, 0])})""")
+        wait_for_indices_to_sync(redis_graph)
+
+        # magnitude doesn't effect cosine distance
+        q = """CALL db.idx.vector.queryNodes('D', 'e', 2, vecf32([10, 9, 0]))
+               YIELD node
+               RETURN node.name"""
+        res = redis_graph.query(q).result_set
+        self.env.assertEquals(res, [['xy'], ['x']])
+
+        # index info
+        q = """CALL db.indexes() YIELD type, label, properties, language, info
+               WHERE type = 'vector'
+               RETURN label, properties, language, info.dimension,
+               info.similarity, info.numDocuments"""
+        res = redis_graph.query(q).result_set
+        self.env.assertEquals(res, [['D', ['e'], None, 3, 'cosine', 4]])
+
+        # index survives a reload
+        redis_con.execute_command("DEBUG", "RELOAD")
+        res = redis_graph.query(q).result_set
+        self.env.assertEquals(res, [['D', ['e'], None, 3, 'cosine', 4]])
+
+        q = """CALL db.idx.vector.queryNodes('D', 'e', 1, vecf32([0, 0.1, 1]))
+               YIELD node
+               RETURN node.name"""
+        res = redis_graph.query(q).result_set
+        self.env.assertEquals(res, [['z']])
+
+    def test05_vector_index_recall(self):
+        dim = 16
+        n = 2000
+        random.seed(7)
+
+        create_vector_index(redis_graph, 'R', 'v', dim, {'M': 8, 'efConstruction': 100})
+        vectors = [[random.random() for _ in range(dim)] for _ in range(n)]
+        redis_graph.query("UNWIND $vs AS v CREATE (:R {v: vecf32(v)})", {'vs': vectors})
+        wait_for_indices_to_sync(redis_graph)
+
+        # compare index results against a brute force scan
+        hits = 0
+        k = 10
+        for _ in range(10):
+            query = [random.random() for _ in range(dim)]
+            q = """CALL db.idx.vector.queryNodes('R', 'v', $k, vecf32($q), {efRuntime: 100})
+                   YIELD node
+                   RETURN ID(node)"""
+            actual = set(r[0] for r in redis_graph.query(q, {'k': k, 'q': query}).result_set)
+
+            q = """MATCH (r:R)
+                   RETURN ID(r)
+                   ORDER BY vec.euclidean(r.v, vecf32($q))
+                   LIMIT $k"""
+            expected = set(r[0] for r in redis_graph.query(q, {'k': k, 'q': query}).result_set)
+            hits += len(actual & expected)
+
+        # expecting a recall of at least 90%
+        self.env.assertGreater(hits, 90)
+
+    def test06_vector_index_errors(self):
+        # invalid dimension
+        try:
+            redis_graph.query("CALL db.idx.vector.createNodeIndex('E', 'v', 0)")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Dimension must be a positive integer", str(e))
+
+        # invalid similarity
+        try:
+            redis_graph.query("CALL db.idx.vector.createNodeIndex('E', 'v', 2, {similarity: 'manhattan'})")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("similarity must be either 'euclidean' or 'cosine'", str(e))
+
+        # a label holds a single vector index
+        create_vector_index(redis_graph, 'E', 'v', 2)
+        try:
+            redis_graph.query("CALL db.idx.vector.createNodeIndex('E', 'u', 2)")
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Index already exists", str(e))
+
+        # drop index
+        res = drop_vector_index(redis_graph, 'E', 'v')
+        self.env.assertEquals(res.indices_deleted, 1)
+
+        # dropping a none existing index
+        try:
+            drop_vector_index(redis_graph, 'E', 'v')
+            self.env.assertTrue(False)
+        except ResponseError as e:
+            self.env.assertContains("Unable to drop vector index", str(e))
@@ -0,0 +1,135 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/query_ctx.h"
+#include "src/util/rmalloc.h"
+#include "src/ast/ast_parameterize.h"
+
+#include <string.h>
+
+void setup();
+void tearDown();
+
+#define TEST_INIT setup();
+#define TEST_FINI tearDown();
+
+#include "acutest.h"
+
+void setup() {
+	Alloc_Reset();
+	QueryCtx_Init();
+	// make sure a query context exists
+	QueryCtx_GetQueryCtx();
+}
+
+void tearDown() {
+	QueryCtx_Free();
+}
+
+// get synthetic parameter value
+static SIValue _param
+(
+	const char *name
+) {
+	rax *params = QueryCtx_GetParams();
+	TEST_ASSERT(params != NULL);
+
+	SIValue *v = raxFind(params, (unsigned char *)name, strlen(name));
+	TEST_ASSERT(v != raxNotFound);
+
+	return *v;
+}
+
+static void _validate_normalization
+(
+	const char *query,
+	const char *expected
+) {
+	char *normalized = AST_ParameterizeLiterals(query);
+	if(expected == NULL) {
+		TEST_ASSERT(normalized == NULL);
+		return;
+	}
+
+	TEST_ASSERT(normalized != NULL);
+	TEST_CHECK_(strcmp(normalized, expected) == 0, "%s", normalized);
+	rm_free(normalized);
+}
+
+void test_parameterize_literals() {
+	_validate_normalization("MATCH (n {id: 17, name: 'a', v: 2.5}) RETURN n",
+			"MATCH (n {id: $__lit0, name: $__lit1, v: $__lit2}) RETURN n");
+
+	SIValue v = _param("__lit0");
+	TEST_ASSERT(SI_TYPE(v) == T_INT64 && v.longval == 17);
+
+	v = _param("__lit1");
+	TEST_ASSERT(SI_TYPE(v) == T_STRING && strcmp(v.stringval, "a") == 0);
+
+	v = _param("__lit2");
+	TEST_ASSERT(SI_TYPE(v) == T_DOUBLE && v.doubleval == 2.5);
+}
+
+void test_parameterize_no_literals() {
+	_validate_normalization("MATCH (n) WHERE n.v = $v RETURN n", NULL);
+	TEST_ASSERT(QueryCtx_GetParams() == NULL);
+}
+
+void test_parameterize_kept_literals() {
+	// SKIP and LIMIT
+	_validate_normalization("MATCH (n) WITH n SKIP 1 LIMIT 2 RETURN n", NULL);
+
+	// RETURN projections name result-set columns
+	_validate_normalization("MATCH (n) RETURN n.v + 1, 'x'", NULL);
+
+	// variable length ranges
+	_validate_normalization("MATCH (a)-[*1..3]->(b)-[:R * 2]->(c) RETURN c",
+			NULL);
+
+	// escaped strings, hex and octal integers, integer overflow
+	_validate_normalization("MATCH (n) WHERE n.v IN ['a\\'b', 0x1F, 017] "
+			"OR n.v = -9223372036854775808 RETURN n", NULL);
+
+	// literals within comments and quoted identifiers
+	_validate_normalization("MATCH (n:`L 1`) /* 1 */ RETURN n // 'a'", NULL);
+
+	// ORDER BY ends RETURN's projections
+	_validate_normalization("MATCH (n) RETURN n ORDER BY n.v + 1 LIMIT 1",
+			"MATCH (n) RETURN n ORDER BY n.v + $__lit0 LIMIT 1");
+
+	// clear parameters
+	tearDown();
+	setup();
+
+	// property keys and map keys aren't keywords
+	_validate_normalization("MATCH (n) WHERE n.limit = 3 RETURN {match: 1}",
+			"MATCH (n) WHERE n.limit = $__lit0 RETURN {match: 1}");
+}
+
+void test_parameterize_name_collision() {
+	// caller already specified a parameter named __lit0
+	rax *params = raxNew();
+	SIValue *v = rm_malloc(sizeof(SIValue));
+	*v = SI_LongVal(1);
+	raxInsert(params, (unsigned char *)"__lit0", 6, v, NULL);
+	QueryCtx_SetParams(params);
+
+	_validate_normalization("MATCH (n {id: 17}) RETURN n", NULL);
+
+	// caller's parameter is unchanged
+	SIValue p = _param("__lit0");
+	TEST_ASSERT(p.longval == 1);
+	TEST_ASSERT(raxSize(params) == 1);
+}
+
+TEST_LIST = {
+	{"parameterize_literals", test_parameterize_literals},
+	{"parameterize_no_literals", test_parameterize_no_literals},
+	{"parameterize_kept_literals", test_parameterize_kept_literals},
+	{"parameterize_name_collision", test_parameterize_name_collision},
+	{NULL, NULL}
+};
@@ -0,0 +1,221 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/value.h"
+#include "src/query_ctx.h"
+#include "src/datatypes/map.h"
+#include "src/datatypes/array.h"
+#include "src/util/rmalloc.h"
+#include "src/ast/ast_params_parser.h"
+
+#include <string.h>
+
+void setup();
+void tearDown();
+
+#define TEST_INIT setup();
+#define TEST_FINI tearDown();
+
+#include "acutest.h"
+
+void setup() {
+	Alloc_Reset();
+	QueryCtx_Init();
+	// make sure a query context exists
+	QueryCtx_GetQueryCtx();
+}
+
+void tearDown() {
+	QueryCtx_Free();
+}
+
+static SIValue _param
+(
+	const char *name
+) {
+	rax *params = QueryCtx_GetParams();
+	TEST_ASSERT(params != NULL);
+
+	SIValue *v = raxFind(params, (unsigned char *)name, strlen(name));
+	TEST_ASSERT(v != raxNotFound);
+
+	return *v;
+}
+
+void test_params_no_prefix() {
+	const char *body;
+	TEST_ASSERT(AST_FastParseParams("  MATCH (n) RETURN n", &body));
+	TEST_ASSERT(strcmp(body, "MATCH (n) RETURN n") == 0);
+	TEST_ASSERT(QueryCtx_GetParams() == NULL);
+}
+
+void test_params_scalars() {
+	const char *body;
+	const char *q = "CYPHER i=-12 f=2.5e1 s='a\\'b\\n' d=\"c\" t=TRUE n=null "
+		"RETURN $i";
+
+	TEST_ASSERT(AST_FastParseParams(q, &body));
+	TEST_ASSERT(strcmp(body, "RETURN $i") == 0);
+
+	SIValue v = _param("i");
+	TEST_ASSERT(SI_TYPE(v) == T_INT64 && v.longval == -12);
+
+	v = _param("f");
+	TEST_ASSERT(SI_TYPE(v) == T_DOUBLE && v.doubleval == 25.0);
+
+	v = _param("s");
+	TEST_ASSERT(SI_TYPE(v) == T_STRING && strcmp(v.stringval, "a'b\n") == 0);
+
+	v = _param("d");
+	TEST_ASSERT(SI_TYPE(v) == T_STRING && strcmp(v.stringval, "c") == 0);
+
+	v = _param("t");
+	TEST_ASSERT(SI_TYPE(v) == T_BOOL && v.longval == true);
+
+	v = _param("n");
+	TEST_ASSERT(SI_TYPE(v) == T_NULL);
+}
+
+void test_params_containers() {
+	const char *body;
+	const char *q = "CYPHER rows=[{id: 1, tags: ['a', 'b']}, {id: 2, tags: []}] "
+		"UNWIND $rows AS row RETURN row";
+
+	TEST_ASSERT(AST_FastParseParams(q, &body));
+	TEST_ASSERT(strcmp(body, "UNWIND $rows AS row RETURN row") == 0);
+
+	SIValue rows = _param("rows");
+	TEST_ASSERT(SI_TYPE(rows) == T_ARRAY);
+	TEST_ASSERT(SIArray_Length(rows) == 2);
+
+	SIValue row = SIArray_Get(rows, 0);
+	TEST_ASSERT(SI_TYPE(row) == T_MAP);
+	TEST_ASSERT(Map_KeyCount(row) == 2);
+
+	SIValue id;
+	TEST_ASSERT(MAP_GET(row, "id", id));
+	TEST_ASSERT(SI_TYPE(id) == T_INT64 && id.longval == 1);
+
+	SIValue tags;
+	TEST_ASSERT(MAP_GET(row, "tags", tags));
+	TEST_ASSERT(SI_TYPE(tags) == T_ARRAY && SIArray_Length(tags) == 2);
+	TEST_ASSERT(strcmp(SIArray_Get(tags, 1).stringval, "b") == 0);
+
+	row = SIArray_Get(rows, 1);
+	TEST_ASSERT(MAP_GET(row, "tags", tags));
+	TEST_ASSERT(SIArray_Length(tags) == 0);
+}
+
+void test_params_fallback() {
+	const char *body = NULL;
+	const char *queries[] = {
+		"CYPHER a=1+2 RETURN $a",           // expression
+		"CYPHER a=abs(-1) RETURN $a",       // function call
+		"CYPHER a=0x1F RETURN $a",          // hexadecimal integer
+		"CYPHER a=017 RETURN $a",           // octal integer
+		"CYPHER a='\\u0041' RETURN $a",     // unicode escape sequence
+		"CYPHER a=9223372036854775808 RETURN $a",  // overflow
+		"CYPHER a=[1, $b] RETURN $a",       // parameter reference
+		"CYPHER a={k: 1, k: 2} RETURN $a",  // duplicated map key
+		"CYPHER a=1 a=2 RETURN $a",         // duplicated parameter
+		"CYPHER a='b RETURN $a",            // unterminated string
+		"CYPHER a=[1, 2 RETURN $a",         // unterminated list
+		"CYPHER a=1 EXPLAIN RETURN $a",     // EXPLAIN option
+		"CYPHER 2.5 RETURN 1",              // version
+		"// comment\nRETURN 1",             // comment
+		"RETURN 1; RETURN 2",               // multiple statements
+		NULL
+	};
+
+	for(int i = 0; queries[i] != NULL; i++) {
+		TEST_CHECK_(!AST_FastParseParams(queries[i], &body), "%s", queries[i]);
+		// query context is left untouched
+		TEST_ASSERT(QueryCtx_GetParams() == NULL);
+	}
+
+	TEST_ASSERT(body == NULL);
+}
+
+void test_params_binary() {
+	// {i: -2, s: 'ab', l: [true, null], m: {k: 0.5}}
+	const char buf[] =
+		"\x04\x00\x00\x00"
+		"\x01\x00\x00\x00" "i" "\x02" "\xfe\xff\xff\xff\xff\xff\xff\xff"
+		"\x01\x00\x00\x00" "s" "\x04" "\x02\x00\x00\x00" "ab"
+		"\x01\x00\x00\x00" "l" "\x05" "\x02\x00\x00\x00" "\x01\x01" "\x00"
+		"\x01\x00\x00\x00" "m" "\x06" "\x01\x00\x00\x00"
+			"\x01\x00\x00\x00" "k" "\x03" "\x00\x00\x00\x00\x00\x00\xe0\x3f";
+
+	TEST_ASSERT(AST_DecodeBinaryParams(buf, sizeof(buf) - 1));
+
+	SIValue v = _param("i");
+	TEST_ASSERT(SI_TYPE(v) == T_INT64 && v.longval == -2);
+
+	v = _param("s");
+	TEST_ASSERT(SI_TYPE(v) == T_STRING && strcmp(v.stringval, "ab") == 0);
+
+	v = _param("l");
+	TEST_ASSERT(SI_TYPE(v) == T_ARRAY && SIArray_Length(v) == 2);
+	TEST_ASSERT(SI_TYPE(SIArray_Get(v, 0)) == T_BOOL);
+	TEST_ASSERT(SI_TYPE(SIArray_Get(v, 1)) == T_NULL);
+
+	SIValue k;
+	v = _param("m");
+	TEST_ASSERT(MAP_GET(v, "k", k));
+	TEST_ASSERT(SI_TYPE(k) == T_DOUBLE && k.doubleval == 0.5);
+
+	// every truncation of a valid encoding is rejected
+	for(size_t len = 1; len < sizeof(buf) - 1; len++) {
+		TEST_CHECK_(!AST_DecodeBinaryParams(buf, len), "%zu", len);
+	}
+}
+
+void test_params_binary_malformed() {
+	const char *bufs[] = {
+		"\x01\x00\x00\x00\x01\x00\x00\x00" "a" "\x07",  // unknown tag
+		"\x01\x00\x00\x00\x00\x00\x00\x00" "\x00",      // empty name
+		"\x01\x00\x00\x00\x01\x00\x00\x00" "a" "\x00" "\x00",  // trailing
+		"\x01\x00\x00\x00\x01\x00\x00\x00" "a"
+			"\x05\xff\xff\xff\xff",  // oversized list
+		NULL
+	};
+	const size_t lens[] = {10, 9, 11, 14};
+
+	for(int i = 0; bufs[i] != NULL; i++) {
+		TEST_CHECK_(!AST_DecodeBinaryParams(bufs[i], lens[i]), "%d", i);
+		TEST_ASSERT(QueryCtx_GetParams() == NULL);
+	}
+
+	// duplicated parameter
+	const char dup[] = "\x02\x00\x00\x00"
+		"\x01\x00\x00\x00" "a" "\x00"
+		"\x01\x00\x00\x00" "a" "\x00";
+	TEST_ASSERT(!AST_DecodeBinaryParams(dup, sizeof(dup) - 1));
+
+	// excessive nesting
+	char deep[4 + 4 + 1 + 5 * 40 + 1];
+	memcpy(deep, "\x01\x00\x00\x00\x01\x00\x00\x00" "a", 9);
+	for(int i = 0; i < 40; i++) {
+		memcpy(deep + 9 + i * 5, "\x05\x01\x00\x00\x00", 5);
+	}
+	deep[9 + 40 * 5] = 0;
+	TEST_ASSERT(!AST_DecodeBinaryParams(deep, sizeof(deep)));
+	TEST_ASSERT(QueryCtx_GetParams() == NULL);
+
+	// no parameters
+	TEST_ASSERT(AST_DecodeBinaryParams(NULL, 0));
+	TEST_ASSERT(QueryCtx_GetParams() == NULL);
+}
+
+TEST_LIST = {
+	{"params_no_prefix", test_params_no_prefix},
+	{"params_scalars", test_params_scalars},
+	{"params_containers", test_params_containers},
+	{"params_fallback", test_params_fallback},
+	{"params_binary", test_params_binary},
+	{"params_binary_malformed", test_params_binary_malformed},
+	{NULL, NULL}
+};
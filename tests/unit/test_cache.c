@@ -4,6 +4,7 @@
  * the Server Side Public License v1 (SSPLv1).
  */
 
+#include "src/util/arr.h"
 #include "src/util/rmalloc.h"
 #include "src/util/cache/cache.h"
 #include "src/execution_plan/execution_plan.h"
@@ -93,14 +94,73 @@ void test_executionPlanCache() {
 	// Verify that oldest entry do not exists - queue is [ 4 | 3 | 2 ].
 	TEST_ASSERT(Cache_GetValue(cache, key1) == NULL);
 
+	//--------------------------------------------------------------------------
+	// Validate hit and miss counters
+	//--------------------------------------------------------------------------
+
+	uint64_t hits;
+	uint64_t misses;
+	Cache_GetStats(cache, &hits, &misses);
+	TEST_ASSERT(hits == 2);
+	TEST_ASSERT(misses == 2);
+
 	Cache_Free(cache);
 
 	// Expecting CacheObjFree to be called 9 times.
 	TEST_ASSERT(free_count == 9);
 }
 
+void test_hotKeys() {
+	Cache *cache = Cache_New(3, (CacheEntryFreeFunc)CacheObj_Free,
+			(CacheEntryCopyFunc)CacheObj_Dup);
+
+	const char *key1 = "MATCH (a) RETURN a";
+	const char *key2 = "MATCH (b) RETURN b";
+	const char *key3 = "MATCH (c) RETURN c";
+
+	Cache_SetValue(cache, key1, CacheObj_New("1"));
+	Cache_SetValue(cache, key2, CacheObj_New("2"));
+	Cache_SetValue(cache, key3, CacheObj_New("3"));
+
+	// key2 is hit twice, key3 once, key1 never
+	for(int i = 0; i < 2; i++) CacheObj_Free(Cache_GetValue(cache, key2));
+	CacheObj_Free(Cache_GetValue(cache, key3));
+
+	// peeking doesn't count as a hit
+	CacheObj *peeked = (CacheObj *)Cache_PeekValue(cache, key1);
+	TEST_ASSERT(peeked != NULL && strcmp(peeked->str, "1") == 0);
+	CacheObj_Free(peeked);
+	TEST_ASSERT(Cache_PeekValue(cache, "None existing") == NULL);
+
+	uint64_t hits;
+	uint64_t misses;
+	Cache_GetStats(cache, &hits, &misses);
+	TEST_ASSERT(hits == 3);
+	TEST_ASSERT(misses == 0);
+
+	// keys are reported hottest first
+	CacheKeyStats *stats = Cache_HotKeys(cache, 2, true);
+	TEST_ASSERT(array_len(stats) == 2);
+	TEST_ASSERT(strcmp(stats[0].key, key2) == 0 && stats[0].hits == 2);
+	TEST_ASSERT(strcmp(stats[1].key, key3) == 0 && stats[1].hits == 1);
+	for(uint i = 0; i < array_len(stats); i++) rm_free(stats[i].key);
+	array_free(stats);
+
+	// restored hits take effect
+	Cache_SetHits(cache, key1, 10);
+	Cache_SetHits(cache, "None existing", 10);
+	stats = Cache_HotKeys(cache, 10, true);
+	TEST_ASSERT(array_len(stats) == 3);
+	TEST_ASSERT(strcmp(stats[0].key, key1) == 0 && stats[0].hits == 10);
+	for(uint i = 0; i < array_len(stats); i++) rm_free(stats[i].key);
+	array_free(stats);
+
+	Cache_Free(cache);
+}
+
 TEST_LIST = {
 	{"executionPlanCache", test_executionPlanCache},
+	{"hotKeys", test_hotKeys},
 	{NULL, NULL}
 };
 
@@ -9,9 +9,11 @@
 #include "src/util/rmalloc.h"
 #include "src/errors/errors.h"
 #include "src/filter_tree/filter_tree.h"
+#include "src/filter_tree/filter_tree_compile.h"
 #include "src/ast/ast_build_filter_tree.h"
 #include "src/arithmetic/funcs.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -630,6 +632,96 @@ void test_compact() {
 	AST_Free(ast);
 }
 
+void test_compile() {
+	const char *queries[] = {
+		"MATCH (n) WHERE a + 1 > b AND s = 'x' RETURN n",
+		"MATCH (n) WHERE a * 2 = b OR z IS NULL RETURN n",
+		"MATCH (n) WHERE NOT (a < b) XOR s STARTS WITH 'x' RETURN n",
+		"MATCH (n) WHERE a - b <= 0.5 AND size(l) > 1 RETURN n",
+		"MATCH (n) WHERE l AND a <> b RETURN n",
+		"MATCH (n) WHERE a = b XOR z = 1 RETURN n",
+		NULL
+	};
+
+	SIValue a_vals[4] = {SI_LongVal(1), SI_DoubleVal(2.5), SI_NullVal(),
+		SI_DoubleVal(NAN)};
+	SIValue b_vals[3] = {SI_LongVal(2), SI_DoubleVal(3.5), SI_NullVal()};
+	SIValue s_vals[3] = {SI_ConstStringVal("x"), SI_ConstStringVal("y"),
+		SI_NullVal()};
+	SIValue z_vals[2] = {SI_NullVal(), SI_LongVal(1)};
+
+	SIValue l_vals[2] = {SIArray_New(0), SIArray_New(2)};
+	SIArray_Append(&l_vals[1], SI_LongVal(1));
+	SIArray_Append(&l_vals[1], SI_LongVal(2));
+
+	// record layout: a, b, s, l, z
+	rax *mapping = raxNew();
+	const char *aliases[5] = {"a", "b", "s", "l", "z"};
+	for(intptr_t i = 0; i < 5; i++) {
+		raxInsert(mapping, (unsigned char *)aliases[i], 1, (void *)i, NULL);
+	}
+	Record r = Record_New(mapping);
+
+	for(int q = 0; queries[q] != NULL; q++) {
+		FT_FilterNode *tree = build_tree_from_query(queries[q]);
+		AR_Program *program = FilterTree_Compile(tree);
+		TEST_ASSERT(program != NULL);
+
+		// compiled tree must agree with the filter tree for every record
+		for(int a = 0; a < 4; a++) {
+			for(int b = 0; b < 3; b++) {
+				for(int s = 0; s < 3; s++) {
+					for(int l = 0; l < 2; l++) {
+						for(int z = 0; z < 2; z++) {
+							Record_AddScalar(r, 0, a_vals[a]);
+							Record_AddScalar(r, 1, b_vals[b]);
+							Record_AddScalar(r, 2, s_vals[s]);
+							Record_AddScalar(r, 3, SI_ShareValue(l_vals[l]));
+							Record_AddScalar(r, 4, z_vals[z]);
+
+							FT_Result expected = FilterTree_applyFilters(tree, r);
+							FT_Result actual = FilterTree_applyProgram(program, r);
+							TEST_CHECK_(expected == actual, "%s (%d %d %d %d %d)",
+									queries[q], a, b, s, l, z);
+						}
+					}
+				}
+			}
+		}
+
+		AR_Program_Free(program);
+		FilterTree_Free(tree);
+		AST *ast = QueryCtx_GetAST();
+		AST_Free(ast);
+	}
+
+	// unbound parameters can't be compiled
+	FT_FilterNode *tree = build_tree_from_query("MATCH (n) WHERE a = $p RETURN n");
+	TEST_ASSERT(FilterTree_Compile(tree) == NULL);
+	FilterTree_Free(tree);
+	AST *ast = QueryCtx_GetAST();
+	AST_Free(ast);
+
+	Record_Free(r);
+	raxFree(mapping);
+	SIValue_Free(l_vals[0]);
+	SIValue_Free(l_vals[1]);
+}
+
+void test_toString() {
+	const char *q = "MATCH (n) WHERE n.v > 1 AND (n.w = 2 OR n.x <> n.y) RETURN n";
+	FT_FilterNode *tree = build_tree_from_query(q);
+
+	sds buf = sdsempty();
+	FilterTree_ToString(tree, &buf);
+	TEST_ASSERT(strcmp(buf, "n.v > 1 AND (n.w = 2 OR n.x <> n.y)") == 0);
+
+	sdsfree(buf);
+	FilterTree_Free(tree);
+	AST *ast = QueryCtx_GetAST();
+	AST_Free(ast);
+}
+
 TEST_LIST = {
 	{"subTrees", test_subTrees},
 	{"collectModified", test_collectModified},
@@ -637,5 +729,7 @@ TEST_LIST = {
 	{"containsFunc", test_containsFunc},
 	{"clone", test_clone},
 	{"compact", test_compact},
+	{"compile", test_compile},
+	{"toString", test_toString},
 	{NULL, NULL}
 };
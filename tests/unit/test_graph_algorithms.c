@@ -0,0 +1,178 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/algorithms/wcc.h"
+#include "src/algorithms/msbfs.h"
+#include "src/algorithms/triangle_count.h"
+#include "src/algorithms/label_propagation.h"
+
+void setup() {
+	Alloc_Reset();
+	GrB_init(GrB_NONBLOCKING);
+}
+
+void tearDown() {
+	GrB_finalize();
+}
+
+#define TEST_INIT setup();
+#define TEST_FINI tearDown();
+#include "acutest.h"
+
+// undirected graph:
+// two triangles (0, 1, 2) and (3, 4, 5) connected by the edge (2, 3)
+// a path 6 - 7 - 8 and an isolated node 9
+static GrB_Matrix _build_graph(void) {
+	GrB_Matrix A;
+	GrB_Info info;
+
+	GrB_Index edges[10][2] = {
+		{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5}, {5, 3}, {6, 7}, {7, 8}
+	};
+
+	info = GrB_Matrix_new(&A, GrB_BOOL, 10, 10);
+	TEST_ASSERT(info == GrB_SUCCESS);
+
+	for(int i = 0; i < 9; i++) {
+		info = GrB_Matrix_setElement_BOOL(A, true, edges[i][0], edges[i][1]);
+		TEST_ASSERT(info == GrB_SUCCESS);
+		info = GrB_Matrix_setElement_BOOL(A, true, edges[i][1], edges[i][0]);
+		TEST_ASSERT(info == GrB_SUCCESS);
+	}
+
+	return A;
+}
+
+static void _validate
+(
+	GrB_Vector v,
+	const uint64_t *expected,
+	GrB_Index n
+) {
+	GrB_Index nvals;
+	TEST_ASSERT(GrB_Vector_nvals(&nvals, v) == GrB_SUCCESS);
+	TEST_ASSERT(nvals == n);
+
+	for(GrB_Index i = 0; i < n; i++) {
+		uint64_t x;
+		TEST_ASSERT(GrB_Vector_extractElement_UINT64(&x, v, i) == GrB_SUCCESS);
+		TEST_CHECK(x == expected[i]);
+		TEST_MSG("row: %" PRIu64 " expected: %" PRIu64 " got: %" PRIu64, i,
+				expected[i], x);
+	}
+}
+
+void test_wcc() {
+	GrB_Vector components;
+	GrB_Matrix A = _build_graph();
+
+	TEST_ASSERT(WCC(&components, A) == GrB_SUCCESS);
+
+	uint64_t expected[10] = {0, 0, 0, 0, 0, 0, 6, 6, 6, 9};
+	_validate(components, expected, 10);
+
+	GrB_free(&A);
+	GrB_free(&components);
+}
+
+void test_triangleCount() {
+	GrB_Vector triangles;
+	GrB_Matrix A = _build_graph();
+
+	TEST_ASSERT(TriangleCount(&triangles, A) == GrB_SUCCESS);
+
+	uint64_t expected[10] = {1, 1, 1, 1, 1, 1, 0, 0, 0, 0};
+	_validate(triangles, expected, 10);
+
+	GrB_free(&A);
+	GrB_free(&triangles);
+}
+
+void test_labelPropagation() {
+	int iterations;
+	GrB_Vector communities;
+	GrB_Matrix A = _build_graph();
+
+	TEST_ASSERT(LabelPropagation(&communities, A, 10, &iterations)
+			== GrB_SUCCESS);
+
+	// labels settle after two iterations, the third detects convergence
+	uint64_t expected[10] = {0, 0, 0, 3, 3, 3, 6, 6, 6, 9};
+	_validate(communities, expected, 10);
+	TEST_ASSERT(iterations == 3);
+
+	GrB_free(&communities);
+
+	// stop after the first iteration
+	TEST_ASSERT(LabelPropagation(&communities, A, 1, &iterations)
+			== GrB_SUCCESS);
+
+	uint64_t first[10] = {0, 0, 0, 2, 3, 3, 6, 6, 7, 9};
+	_validate(communities, first, 10);
+	TEST_ASSERT(iterations == 1);
+
+	GrB_free(&A);
+	GrB_free(&communities);
+}
+
+// validate row 'i' of the level matrix, -1 marks unreachable nodes
+static void _validate_levels
+(
+	GrB_Matrix levels,
+	GrB_Index i,
+	const int64_t *expected,
+	GrB_Index n
+) {
+	for(GrB_Index j = 0; j < n; j++) {
+		uint64_t x;
+		GrB_Info info = GrB_Matrix_extractElement_UINT64(&x, levels, i, j);
+		if(expected[j] == -1) {
+			TEST_CHECK(info == GrB_NO_VALUE);
+		} else {
+			TEST_CHECK(info == GrB_SUCCESS && x == (uint64_t)expected[j]);
+		}
+		TEST_MSG("source: %" PRIu64 " node: %" PRIu64, i, j);
+	}
+}
+
+void test_msbfs() {
+	GrB_Matrix levels;
+	GrB_Matrix A = _build_graph();
+
+	// the same source may appear multiple times
+	GrB_Index sources[3] = {0, 6, 0};
+
+	TEST_ASSERT(MSBFS(&levels, A, sources, 3, 0) == GrB_SUCCESS);
+
+	int64_t from_0[10] = {0, 1, 1, 2, 3, 3, -1, -1, -1, -1};
+	int64_t from_6[10] = {-1, -1, -1, -1, -1, -1, 0, 1, 2, -1};
+	_validate_levels(levels, 0, from_0, 10);
+	_validate_levels(levels, 1, from_6, 10);
+	_validate_levels(levels, 2, from_0, 10);
+
+	GrB_free(&levels);
+
+	// limit traversal to a single level
+	TEST_ASSERT(MSBFS(&levels, A, sources, 2, 1) == GrB_SUCCESS);
+
+	int64_t level_1_from_0[10] = {0, 1, 1, -1, -1, -1, -1, -1, -1, -1};
+	int64_t level_1_from_6[10] = {-1, -1, -1, -1, -1, -1, 0, 1, -1, -1};
+	_validate_levels(levels, 0, level_1_from_0, 10);
+	_validate_levels(levels, 1, level_1_from_6, 10);
+
+	GrB_free(&A);
+	GrB_free(&levels);
+}
+
+TEST_LIST = {
+	{"wcc", test_wcc},
+	{"triangleCount", test_triangleCount},
+	{"labelPropagation", test_labelPropagation},
+	{"msbfs", test_msbfs},
+	{NULL, NULL}
+};
+
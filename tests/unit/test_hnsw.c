@@ -0,0 +1,136 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/rmalloc.h"
+#include "src/index/hnsw.h"
+#include "src/datatypes/vector.h"
+
+#include <stdlib.h>
+
+void setup() {
+	Alloc_Reset();
+}
+#define TEST_INIT setup();
+#include "acutest.h"
+
+#define DIM 16
+#define N   2000
+#define K   10
+
+static float _rand() {
+	return rand() / (float)RAND_MAX;
+}
+
+// count how many of the index results are among the true k nearest neighbors
+static int _recall
+(
+	HNSW *h,
+	float *data,
+	bool *live,
+	VectorSimilarity sim
+) {
+	float q[DIM];
+	for(int i = 0; i < DIM; i++) q[i] = _rand();
+
+	EntityID ids[K];
+	float distances[K];
+	uint found = HNSW_Search(h, q, K, 100, ids, distances);
+	TEST_ASSERT(found == K);
+
+	// brute force distance to the furthest of the k nearest neighbors
+	float kth[K];
+	int n = 0;
+	for(int i = 0; i < N; i++) {
+		if(!live[i]) continue;
+		float d = (sim == VECSIM_COSINE)
+			? Vector_CosineDistance(q, data + i * DIM, DIM)
+			: Vector_EuclideanDistance(q, data + i * DIM, DIM);
+
+		if(n == K && d >= kth[K - 1]) continue;
+		int j = (n < K) ? n++ : K - 1;
+		while(j > 0 && kth[j - 1] > d) {
+			kth[j] = kth[j - 1];
+			j--;
+		}
+		kth[j] = d;
+	}
+
+	int hits = 0;
+	for(uint i = 0; i < found; i++) {
+		// results are sorted and removed entities aren't reported
+		TEST_ASSERT(i == 0 || distances[i - 1] <= distances[i]);
+		TEST_ASSERT(live[ids[i]]);
+		if(distances[i] <= kth[K - 1] + 1e-5) hits++;
+	}
+
+	return hits;
+}
+
+static void _test_hnsw
+(
+	VectorSimilarity sim
+) {
+	srand(7);
+
+	float *data = malloc(sizeof(float) * N * DIM);
+	bool  *live = calloc(N, sizeof(bool));
+	for(int i = 0; i < N * DIM; i++) data[i] = _rand();
+
+	HNSW *h = HNSW_New(DIM, sim, HNSW_DEFAULT_M, HNSW_DEFAULT_EF_CONSTRUCTION);
+	TEST_ASSERT(HNSW_Size(h) == 0);
+
+	for(int i = 0; i < N; i++) {
+		HNSW_Insert(h, i, data + i * DIM);
+		live[i] = true;
+	}
+	TEST_ASSERT(HNSW_Size(h) == N);
+
+	int hits = 0;
+	for(int i = 0; i < 10; i++) hits += _recall(h, data, live, sim);
+	TEST_ASSERT(hits >= 95);
+
+	// replace vectors
+	for(int i = 0; i < N / 4; i++) {
+		for(int j = 0; j < DIM; j++) data[i * DIM + j] = _rand();
+		HNSW_Insert(h, i, data + i * DIM);
+	}
+	TEST_ASSERT(HNSW_Size(h) == N);
+
+	// remove most vectors, triggering a rebuild
+	for(int i = 0; i < N - 100; i++) {
+		HNSW_Remove(h, i);
+		live[i] = false;
+	}
+	TEST_ASSERT(HNSW_Size(h) == 100);
+
+	hits = 0;
+	for(int i = 0; i < 10; i++) hits += _recall(h, data, live, sim);
+	TEST_ASSERT(hits >= 95);
+
+	// empty graph
+	for(int i = N - 100; i < N; i++) HNSW_Remove(h, i);
+	EntityID id;
+	float d;
+	TEST_ASSERT(HNSW_Search(h, data, 1, 10, &id, &d) == 0);
+
+	HNSW_Free(h);
+	free(data);
+	free(live);
+}
+
+void test_hnsw_euclidean() {
+	_test_hnsw(VECSIM_EUCLIDEAN);
+}
+
+void test_hnsw_cosine() {
+	_test_hnsw(VECSIM_COSINE);
+}
+
+TEST_LIST = {
+	{"hnsw_euclidean", test_hnsw_euclidean},
+	{"hnsw_cosine", test_hnsw_cosine},
+	{NULL, NULL}
+};
@@ -23,12 +23,10 @@ void tearDown() {
 #define TEST_FINI tearDown();
 #include "acutest.h"
 
-void test_pagerank() {
+// graph on the cover of the book
+static GrB_Matrix _cover_graph(void) {
 	GrB_Matrix A;
 	GrB_Info info;
-	double tol = 1e-4 ;
-	int iters, itermax = 100 ;
-	LAGraph_PageRank *ranking = NULL;
 
 	/* Graph on the cover of the book, 'Graph Algorithms in the language of linear algebra'.
 	A = [
@@ -80,7 +78,19 @@ void test_pagerank() {
 	info = GrB_Matrix_setElement_BOOL(A, true, 1, 6);
 	TEST_ASSERT(info == GrB_SUCCESS);
 
-	Pagerank(&ranking, A, itermax, tol, &iters);
+	return A;
+}
+
+void test_pagerank() {
+	GrB_Matrix A = _cover_graph();
+	int iters;
+	LAGraph_PageRank *ranking = NULL;
+	PagerankConfig config = {
+		.itermax = 100, .tol = 1e-4, .damping = PAGERANK_DAMPING_DEFAULT,
+		.init = NULL, .personalization = NULL
+	};
+
+	Pagerank(&ranking, A, &config, &iters, NULL);
 
 	// Page:5, pagerank:0.392289
 	// Page:2, pagerank:0.387241
@@ -106,9 +116,83 @@ void test_pagerank() {
 	}
     
 	rm_free(ranking);
+	GrB_free(&A);
+}
+
+void test_pagerank_warm_start() {
+	GrB_Matrix A = _cover_graph();
+	int iters;
+	int warm_iters;
+	double delta;
+	GrB_Vector init;
+	LAGraph_PageRank *ranking = NULL;
+	LAGraph_PageRank *warm_ranking = NULL;
+	PagerankConfig config = {
+		.itermax = 100, .tol = 1e-4, .damping = PAGERANK_DAMPING_DEFAULT,
+		.init = NULL, .personalization = NULL
+	};
+
+	Pagerank(&ranking, A, &config, &iters, &delta);
+	TEST_ASSERT(delta < config.tol);
+
+	// warm start from the computed ranks
+	GrB_Vector_new(&init, GrB_FP64, 7);
+	for(int i = 0; i < 7; i++) {
+		GrB_Vector_setElement_FP64(init, ranking[i].pagerank, ranking[i].page);
+	}
+
+	config.init = init;
+	Pagerank(&warm_ranking, A, &config, &warm_iters, &delta);
+
+	// converged ranks require fewer iterations and yield the same ranking
+	TEST_ASSERT(warm_iters < iters);
+	for(int i = 0; i < 7; i++) {
+		TEST_ASSERT(warm_ranking[i].page == ranking[i].page);
+		TEST_ASSERT(fabs(warm_ranking[i].pagerank - ranking[i].pagerank) < 0.001);
+	}
+
+	rm_free(ranking);
+	rm_free(warm_ranking);
+	GrB_free(&init);
+	GrB_free(&A);
+}
+
+void test_pagerank_personalized() {
+	GrB_Matrix A = _cover_graph();
+	int iters;
+	GrB_Vector p;
+	LAGraph_PageRank *ranking = NULL;
+	PagerankConfig config = {
+		.itermax = 100, .tol = 1e-4, .damping = PAGERANK_DAMPING_DEFAULT,
+		.init = NULL, .personalization = NULL
+	};
+
+	// teleport only to node 0
+	GrB_Vector_new(&p, GrB_FP32, 7);
+	GrB_Vector_setElement_FP32(p, 1, 0);
+	config.personalization = p;
+
+	Pagerank(&ranking, A, &config, &iters, NULL);
+
+	// node 0 ranks 0.042893 without personalization
+	double sum = 0;
+	double node0 = 0;
+	for(int i = 0; i < 7; i++) {
+		sum += ranking[i].pagerank;
+		if(ranking[i].page == 0) node0 = ranking[i].pagerank;
+	}
+
+	TEST_ASSERT(node0 > 0.15);
+	TEST_ASSERT(fabs(sum - 1) < 0.0001);
+
+	rm_free(ranking);
+	GrB_free(&p);
+	GrB_free(&A);
 }
 
 TEST_LIST = {
 	{"pagerank", test_pagerank},
+	{"pagerank_warm_start", test_pagerank_warm_start},
+	{"pagerank_personalized", test_pagerank_personalized},
 	{NULL, NULL}
 };
@@ -0,0 +1,205 @@
+/*
+ * Copyright Redis Ltd. 2018 - present
+ * Licensed under your choice of the Redis Source Available License 2.0 (RSALv2) or
+ * the Server Side Public License v1 (SSPLv1).
+ */
+
+#include "src/util/arr.h"
+#include "src/util/rmalloc.h"
+#include "src/configuration/config.h"
+#include "src/algorithms/weighted_paths.h"
+
+#include <float.h>
+
+void setup();
+void tearDown();
+
+#define TEST_INIT setup();
+#define TEST_FINI tearDown();
+
+#include "acutest.h"
+
+static int relationships[] = {GRAPH_NO_RELATION};
+
+static Graph *BuildGraph() {
+	Edge e;
+	Node n;
+	size_t nodeCount = 4;
+	Graph *g = Graph_New(nodeCount, nodeCount);
+	int relation = Graph_AddRelationType(g);
+	for(int i = 0; i < 4; i++) {
+		n = GE_NEW_NODE();
+		Graph_CreateNode(g, &n, NULL, 0);
+	}
+
+	// Connections:
+	// 0 -> 1
+	Graph_CreateEdge(g, 0, 1, relation, &e);
+	// 0 -> 2
+	Graph_CreateEdge(g, 0, 2, relation, &e);
+	// 1 -> 0
+	Graph_CreateEdge(g, 1, 0, relation, &e);
+	// 1 -> 2
+	Graph_CreateEdge(g, 1, 2, relation, &e);
+	// 2 -> 1
+	Graph_CreateEdge(g, 2, 1, relation, &e);
+	// 2 -> 3
+	Graph_CreateEdge(g, 2, 3, relation, &e);
+	// 3 -> 0
+	Graph_CreateEdge(g, 3, 0, relation, &e);
+	return g;
+}
+
+// edges have no weight nor cost attributes, each edge weighs 1
+static WeightedTraversal _traversal
+(
+	Graph *g,
+	uint64_t maxLen
+) {
+	WeightedTraversal t = {
+		.g             = g,
+		.relationIDs   = relationships,
+		.relationCount = 1,
+		.dir           = GRAPH_EDGE_DIR_OUTGOING,
+		.maxLen        = maxLen,
+		.weight_prop   = ATTRIBUTE_ID_NONE,
+		.cost_prop     = ATTRIBUTE_ID_NONE,
+		.max_cost      = DBL_MAX
+	};
+	return t;
+}
+
+static bool _path_is
+(
+	Path *p,
+	NodeID *ids,
+	uint n
+) {
+	if(Path_NodeCount(p) != n) return false;
+	for(uint i = 0; i < n; i++) {
+		if(ENTITY_GET_ID(p->nodes + i) != ids[i]) return false;
+	}
+	return true;
+}
+
+static void _free_paths
+(
+	WeightedPath *paths
+) {
+	for(uint i = 0; i < array_len(paths); i++) Path_Free(paths[i].path);
+	array_free(paths);
+}
+
+void setup() {
+	// Use the malloc family for allocations
+	Alloc_Reset();
+
+	// Initialize GraphBLAS.
+	GrB_init(GrB_NONBLOCKING);
+	GxB_Global_Option_set(GxB_FORMAT, GxB_BY_ROW);     // all matrices in CSR format
+	GxB_Global_Option_set(GxB_HYPER_SWITCH, GxB_NEVER_HYPER); // matrices are never hypersparse
+}
+
+void tearDown() {
+	GrB_finalize();
+}
+
+void test_shortestPath() {
+	Graph *g = BuildGraph();
+	WeightedTraversal t = _traversal(g, UINT64_MAX);
+
+	Node src;
+	Node dst;
+	Graph_GetNode(g, 0, &src);
+	Graph_GetNode(g, 3, &dst);
+
+	WeightedPath *paths;
+	TEST_ASSERT(WeightedPaths_Collect(&t, &src, &dst, 1, &paths));
+	TEST_ASSERT(array_len(paths) == 1);
+	TEST_ASSERT(paths[0].weight == 2);
+
+	NodeID expected[3] = {0, 2, 3};
+	TEST_ASSERT(_path_is(paths[0].path, expected, 3));
+
+	_free_paths(paths);
+	Graph_Free(g);
+}
+
+void test_kShortestPaths() {
+	Graph *g = BuildGraph();
+	WeightedTraversal t = _traversal(g, UINT64_MAX);
+
+	Node src;
+	Node dst;
+	Graph_GetNode(g, 0, &src);
+	Graph_GetNode(g, 3, &dst);
+
+	// only two simple paths lead from 0 to 3
+	WeightedPath *paths;
+	TEST_ASSERT(WeightedPaths_Collect(&t, &src, &dst, 5, &paths));
+	TEST_ASSERT(array_len(paths) == 2);
+
+	NodeID first[3]  = {0, 2, 3};
+	NodeID second[4] = {0, 1, 2, 3};
+	TEST_ASSERT(_path_is(paths[0].path, first, 3));
+	TEST_ASSERT(_path_is(paths[1].path, second, 4));
+	TEST_ASSERT(paths[1].weight == 3);
+
+	_free_paths(paths);
+
+	// same paths when expanding partial paths, limited by length
+	t.maxLen = 3;
+	TEST_ASSERT(WeightedPaths_Collect(&t, &src, &dst, 5, &paths));
+	TEST_ASSERT(array_len(paths) == 2);
+	TEST_ASSERT(_path_is(paths[0].path, first, 3));
+	TEST_ASSERT(_path_is(paths[1].path, second, 4));
+	_free_paths(paths);
+
+	t.maxLen = 2;
+	TEST_ASSERT(WeightedPaths_Collect(&t, &src, &dst, 5, &paths));
+	TEST_ASSERT(array_len(paths) == 1);
+	_free_paths(paths);
+
+	Graph_Free(g);
+}
+
+void test_allMinimalPaths() {
+	Graph *g = BuildGraph();
+	WeightedTraversal t = _traversal(g, UINT64_MAX);
+
+	Node src;
+	Node dst;
+	Graph_GetNode(g, 1, &src);
+	Graph_GetNode(g, 3, &dst);
+
+	// 1 -> 2 -> 3
+	WeightedPath *paths;
+	TEST_ASSERT(WeightedPaths_Collect(&t, &src, &dst, 0, &paths));
+	TEST_ASSERT(array_len(paths) == 1);
+	TEST_ASSERT(paths[0].weight == 2);
+	_free_paths(paths);
+
+	// single source, paths of minimal weight are the outgoing edges of 0
+	Graph_GetNode(g, 0, &src);
+	TEST_ASSERT(WeightedPaths_Collect(&t, &src, NULL, 0, &paths));
+	TEST_ASSERT(array_len(paths) == 2);
+	for(uint i = 0; i < array_len(paths); i++) {
+		TEST_ASSERT(paths[i].weight == 1);
+	}
+	_free_paths(paths);
+
+	// no path leads back to the source
+	TEST_ASSERT(WeightedPaths_Collect(&t, &src, &src, 0, &paths));
+	TEST_ASSERT(array_len(paths) == 0);
+	_free_paths(paths);
+
+	Graph_Free(g);
+}
+
+TEST_LIST = {
+	{"shortestPath", test_shortestPath},
+	{"kShortestPaths", test_kShortestPaths},
+	{"allMinimalPaths", test_allMinimalPaths},
+	{NULL, NULL}
+};
+